@@ -4,6 +4,7 @@ dist_pkgdata_DATA += gldcore/unitfile.txt
 GLD_SOURCES_PLACE_HOLDER = 
 GLD_SOURCES_PLACE_HOLDER += gldcore/aggregate.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/aggregate.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/bench.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/build.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/class.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/class.h
@@ -63,6 +64,8 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/list.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/list.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/load.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/load.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/load_bin.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/load_bin.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/loadshape.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/loadshape.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/load_xml.cpp
@@ -85,12 +88,18 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/object.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/output.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/output.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/platform.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/profile.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/profile.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/property.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/property.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/propview.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/propview.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/random.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/random.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/realtime.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/realtime.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/replicate.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/replicate.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/sanitize.cpp
 GLD_SOURCES_PLACE_HOLDER += gldcore/sanitize.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/save.c
@@ -101,6 +110,8 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/server.c
 GLD_SOURCES_PLACE_HOLDER += gldcore/server.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/setup.cpp
 GLD_SOURCES_PLACE_HOLDER += gldcore/setup.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/slab.c
+GLD_SOURCES_PLACE_HOLDER += gldcore/slab.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/stream.cpp
 GLD_SOURCES_PLACE_HOLDER += gldcore/stream.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/stream_type.h
@@ -34,6 +34,39 @@
 #include "aggregate.h"
 #include "output.h"
 #include "find.h"
+#include "propview.h"
+
+/* read the property of a constant group through a property view, so that each run 
+   copies the values of all the members at once instead of finding each one */
+static void aggregate_mkview(AGGREGATION *aggr)
+{
+	OBJECT *obj;
+	size_t n = 0;
+
+	if ( (aggr->group->constflags&CF_CONSTANT)!=CF_CONSTANT || aggr->last==NULL )
+		return;
+	if ( aggr->pinfo->ptype!=PT_double && aggr->pinfo->ptype!=PT_complex )
+		return;
+	obj = find_first(aggr->last);
+	if ( obj==NULL || (aggr->view=propview_create(obj->oclass,aggr->pinfo->name))==NULL )
+		return;
+	aggr->n_members = aggr->last->hit_count;
+	aggr->member = (OBJECT**)malloc(sizeof(OBJECT*)*aggr->n_members);
+	aggr->column = malloc(aggr->view->width[0]*aggr->n_members);
+	if ( aggr->member==NULL || aggr->column==NULL )
+	{
+		free(aggr->member);
+		free(aggr->column);
+		propview_destroy(aggr->view);
+		aggr->view = NULL;
+		aggr->member = NULL;
+		aggr->column = NULL;
+		return;
+	}
+	for ( ; obj!=NULL && n<aggr->n_members ; obj=find_next(aggr->last,obj) )
+		aggr->member[n++] = obj;
+	aggr->n_members = n;
+}
 
 /** This function builds an collection of objects into an aggregation.  
 	The aggregation can be run using aggregate_value(AGGREGATION*)
@@ -313,6 +346,11 @@ AGGREGATION *aggregate_mkgroup(char *aggregator, /**< aggregator (min,max,avg,st
 			result->flags = flags;
 			result->punit = to_unit;
 			result->scale = scale;
+			result->view = NULL;
+			result->member = NULL;
+			result->n_members = 0;
+			result->column = NULL;
+			aggregate_mkview(result);
 		}
 		else
 		{
@@ -343,6 +381,7 @@ double arg(complex *x)
 double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
 {
 	OBJECT *obj;
+	size_t n;
 	double numerator=0, denominator=0, secondary=0, third=0, fourth=0;
 	double scale = (aggr->punit ? aggr->scale : 1.0);
 
@@ -351,7 +390,14 @@ double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
 		aggr->last = find_runpgm(NULL,aggr->group); /** @todo use constant part instead of NULL (ticket #3) */
 	}
 
-	for(obj = find_first(aggr->last); obj != NULL; obj = find_next(aggr->last, obj)){
+	/* constant groups read the values of all the members at once */
+	if (aggr->view!=NULL){
+		void *column[1];
+		column[0] = aggr->column;
+		propview_gather(aggr->view,aggr->member,aggr->n_members,column,1);
+	}
+
+	for(n = 0, obj = find_first(aggr->last); obj != NULL; n++, obj = find_next(aggr->last, obj)){
 		double value=0;
 		double *pdouble = NULL;
 		complex *pcomplex = NULL;
@@ -363,7 +409,10 @@ double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
 		switch (aggr->pinfo->ptype) {
 		case PT_complex:
 		case PT_enduse:
-			pcomplex = object_get_complex(obj,aggr->pinfo);
+			if (aggr->view!=NULL && n<aggr->n_members)
+				pcomplex = (complex*)aggr->column+n;
+			else
+				pcomplex = object_get_complex(obj,aggr->pinfo);
 			if (pcomplex!=NULL)
 			{
 				switch (aggr->part) {
@@ -379,7 +428,10 @@ double aggregate_value(AGGREGATION *aggr) /**< the aggregation to perform */
 		case PT_double:
 		case PT_loadshape:
 		case PT_random:
-			pdouble = object_get_double(obj,aggr->pinfo);
+			if (aggr->view!=NULL && n<aggr->n_members)
+				pdouble = (double*)aggr->column+n;
+			else
+				pdouble = object_get_double(obj,aggr->pinfo);
 			if (pdouble!=NULL){
 				value = *pdouble;
 				if(aggr->pinfo->unit != 0 && aggr->punit != 0){
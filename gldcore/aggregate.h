@@ -25,6 +25,10 @@ typedef struct s_aggregate {
 	AGGRPART part; /**< the property part (complex only) */
 	unsigned char flags; /**< aggregation flags (e.g., AF_ABS) */
 	struct s_findlist *last; /**< the result of the last run */
+	struct s_propview *view; /**< the view used to read the property of a constant group (NULL if none) */
+	struct s_object_list **member; /**< the objects in a constant group, in the order they are found */
+	size_t n_members; /**< the number of objects in a constant group */
+	void *column; /**< the values of the property read by the view, one per member */
 	struct s_aggregate *next; /**< the next aggregation in the core's list of aggregators */
 } AGGREGATION; /**< the aggregation type */
 
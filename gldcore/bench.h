@@ -0,0 +1,74 @@
+/** bench.h
+	Copyright (C) 2008 Battelle Memorial Institute
+
+	Timing harness shared by the module microbenchmarks.  A benchmark is the
+	module's test() export, run with
+
+		gridlabd --modtest <module>
+
+	and it is only built into the module when GridLAB-D is configured with
+	--enable-benchmarks.  Each timed case is a BENCHCALL that does the work a
+	given number of times; bench_best() runs it BENCH_REPEATS times and keeps
+	the fastest, so other load on the machine stays out of the comparison.
+	Results go to the test output file (global testoutputfile, test.txt by default).
+
+ @{
+ **/
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#define BENCH_REPEATS 7		///< Runs of each timing - the fastest is reported
+
+typedef void (*BENCHCALL)(void *data, unsigned int iterations);	///< does the timed work iterations times
+
+/** Wall clock time in seconds */
+static inline double bench_seconds(void)
+{
+#ifdef WIN32
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return (double)now.tv_sec + (double)now.tv_usec*1e-6;
+#endif
+}
+
+/** Keeps a result of the timed work, so the work is not optimized away */
+static inline void bench_keep(double value)
+{
+	static volatile double sink = 0.0;
+	sink += value;
+}
+
+/** Runs a case BENCH_REPEATS times
+	@return the fastest run in seconds
+ **/
+static inline double bench_best(BENCHCALL call, void *data, unsigned int iterations)
+{
+	unsigned int repeat;
+	double t0, t1, best = -1.0;
+
+	for (repeat=0; repeat<BENCH_REPEATS; repeat++)
+	{
+		t0 = bench_seconds();
+		(*call)(data,iterations);
+		t1 = bench_seconds();
+		if (best < 0.0 || t1 - t0 < best)
+			best = t1 - t0;
+	}
+	return best;
+}
+
+#endif
+
+/**@}**/
@@ -820,6 +820,8 @@ int class_define_map(CLASS *oclass, /**< the object class */
 			else if (proptype==PT_FLAGS)
 			{
 				prop->flags |= va_arg(arg,unsigned int);
+				if ( prop->flags&PF_ACTIVATE )
+					oclass->has_activate = true;
 			}
 			else if (proptype==PT_DEPRECATED)
 			{
@@ -1139,13 +1141,20 @@ int class_saveall_xml(FILE *fp) /**< a pointer to the stream FILE structure */
 	return count;
 }
 
+/* sort classes by decreasing profiler time */
+static int class_profile_compare(const void *a, const void *b)
+{
+	int64 ta = (*(CLASS**)a)->profiler.clocks, tb = (*(CLASS**)b)->profiler.clocks;
+	return ta<tb ? 1 : ( ta>tb ? -1 : 0 );
+}
+
 /** Generate profile information for the classes used
  **/
 void class_profiles(void)
 {
 	CLASS *cl;
 	int64 total=0;
-	int count=0, i=0, hits;
+	int count=0, i=0;
 	CLASS **index;
 	output_profile("Model profiler results");
 	output_profile("======================\n");
@@ -1166,30 +1175,16 @@ void class_profiles(void)
 	}
 	for (cl=first_class; cl!=NULL; cl=cl->next)
 		index[i++]=cl;
-	hits=-1;
-	while (hits!=0)
-	{
-		hits=0;
-		for (i=0; i<count-1; i++)
-		{
-			if (index[i]->profiler.clocks<index[i+1]->profiler.clocks)
-			{
-				CLASS *tmp = index[i];
-				index[i]=index[i+1];
-				index[i+1]=tmp;
-				hits++;
-			}
-		}
-	}
+	qsort(index,count,sizeof(CLASS*),class_profile_compare);
 	for (i=0; i<count; i++)
 	{
 		cl = index[i];
 		if (cl->profiler.clocks>0)
 		{
-			double ts = (double)cl->profiler.clocks/CLOCKS_PER_SEC;
+			double ts = (double)cl->profiler.clocks/1e9;
 			double tp = (double)cl->profiler.clocks/total*100;
 			double mt = ts/cl->profiler.numobjs*1000;
-			output_profile("%-16.16s %7.3f %8.1f%% %8.1f", cl->name, ts,tp,mt);
+			output_profile("%-16.16s %7.3f %8.1f%% %8.3f", cl->name, ts,tp,mt);
 		}
 		else
 			break;
@@ -1197,8 +1192,8 @@ void class_profiles(void)
 	free(index);
 	index = NULL;
 	output_profile("================ ======== ======== ========");
-	output_profile("%-16.16s %7.3f %8.1f%% %8.1f\n",
-		"Total", (double)total/CLOCKS_PER_SEC,100.0,1000*(double)total/CLOCKS_PER_SEC/object_get_count());
+	output_profile("%-16.16s %7.3f %8.1f%% %8.3f\n",
+		"Total", (double)total/1e9,100.0,1000*(double)total/1e9/object_get_count());
 
 }
 
@@ -42,6 +42,7 @@ typedef unsigned long PASSCONFIG; /**< the pass configuration */
 #define PC_ABSTRACTONLY 0x100 /**< used to flag that the class should never be instantiated itself, only inherited classes should */
 #define PC_AUTOLOCK 0x200 /**< used to flag that sync operations should not be automatically write locked */
 #define PC_OBSERVER 0x400 /**< used to flag whether commit process needs to be delayed with respect to ordinary "in-the-loop" objects */
+#define PC_CONCURRENT_LOAD 0x800 /**< used to flag that objects can be loaded out of order by the include file loader threads (create and notify do not depend on other objects, ids or random numbers) */
 
 typedef enum {
 	NM_PREUPDATE = 0, /**< notify module before property change */
@@ -87,6 +88,8 @@ typedef enum {
 
 #define _MODULE_DEFINED_
 typedef struct s_module_list MODULE;
+typedef struct s_slab SLAB; /**< object storage of a class (see slab.c) */
+
 struct s_class_list {
 	CLASSMAGIC magic;
 	int id;
@@ -113,12 +116,14 @@ struct s_class_list {
 	struct {
 		unsigned int lock;
 		int32 numobjs;
-		int64 clocks;
+		int64 clocks; ///< total callback time (ns), filled in by the profiler at the end of the run
 		int32 count;
 	} profiler;
 	TECHNOLOGYREADINESSLEVEL trl; // technology readiness level (1-9, 0=unknown)
+	bool has_activate;	///< flag indicating that at least one property has PF_ACTIVATE set
 	bool has_runtime;	///< flag indicating that a runtime dll, so, or dylib is in use
 	char runtime[1024]; ///< name of file containing runtime dll, so, or dylib
+	SLAB *slab; ///< memory in which the objects of this class are allocated
 	struct s_class_list *next;
 }; /* CLASS */
 
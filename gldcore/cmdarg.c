@@ -34,6 +34,7 @@
 #include "setup.h"
 #include "sanitize.h"
 #include "exec.h"
+#include "save.h"
 
 clock_t loader_time = 0;
 
@@ -847,6 +848,34 @@ static int output(int argc, char *argv[])
 		return CMDERR;
 	}
 }
+static int save(int argc, char *argv[])
+{
+	if (argc>1)
+	{
+		char *file = (argc--,*++argv);
+		if (saveall(file)==FAILED)
+		{
+			output_fatal("unable to save model to '%s'", file);
+			/* TROUBLESHOOT
+				The model loaded so far could not be saved to the file given
+				to the <b>--save</b> command line directive.  This usually
+				follows a more specific message regarding the problem.
+			 */
+			return CMDERR;
+		}
+		output_verbose("model saved to '%s'", file);
+		return 1;
+	}
+	else
+	{
+		output_fatal("missing save file");
+		/* TROUBLESHOOT
+			The <b>--save</b> command line directive was not followed by
+			a valid filename.  The correct syntax is <b>--save <i>file</i></b>.
+		 */
+		return CMDERR;
+	}
+}
 static int environment(int argc, char *argv[])
 {
 	if (argc>1)
@@ -1288,6 +1317,7 @@ static CMDARG main[] = {
 	{"output",		"o",	output,			"<file>", "Enables save of output to a file (default is gridlabd.glm)" },
 	{"pause",		NULL,	pauseatexit,			NULL, "Toggles pause-at-exit feature" },
 	{"relax",		NULL,	relax,			NULL, "Allows implicit variable definition when assignments are made" },
+	{"save",		NULL,	save,			"<file>", "Saves the model loaded so far to a file (.gbm saves a binary model)" },
 
 	{NULL,NULL,NULL,NULL, "Server mode"},
 	{"server",		NULL,	server,			NULL, "Enables the server"},
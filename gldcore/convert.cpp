@@ -509,7 +509,7 @@ int convert_from_int32(char *buffer, /**< pointer to the string buffer */
 					    PROPERTY *prop) /**< a pointer to keywords that are supported */
 {
 	char temp[1025];
-	int count = sprintf(temp,"%ld",*(int*)data);
+	int count = sprintf(temp,"%d",*(int*)data);
 	if(count < size - 1){
 		memcpy(buffer, temp, count);
 		buffer[count] = 0;
@@ -527,7 +527,7 @@ int convert_to_int32(const char *buffer, /**< a pointer to the string buffer */
 					    void *data, /**< a pointer to the data */
 					    PROPERTY *prop) /**< a pointer to keywords that are supported */
 {
-	return sscanf(buffer,"%ld",data);
+	return sscanf(buffer,"%d",data);
 }
 
 /** Convert from an \e int64
@@ -598,6 +598,8 @@ int convert_to_char8(const char *buffer, /**< a pointer to the string buffer */
 	case '\0':
 		return ((char*)data)[0]='\0', 1;
 	case '"':
+		if ( buffer[1]=='"' ) /* "" is how an empty string is written */
+			return ((char*)data)[0]='\0', 1;
 		return sscanf(buffer+1,"%8[^\"]",data);
 	default:
 		return sscanf(buffer,"%8s",data);
@@ -641,6 +643,8 @@ int convert_to_char32(const char *buffer, /**< a pointer to the string buffer */
 	case '\0':
 		return ((char*)data)[0]='\0', 1;
 	case '"':
+		if ( buffer[1]=='"' )
+			return ((char*)data)[0]='\0', 1;
 		return sscanf(buffer+1,"%32[^\"]",data);
 	default:
 		return sscanf(buffer,"%32s",data);
@@ -684,6 +688,8 @@ int convert_to_char256(const char *buffer, /**< a pointer to the string buffer *
 	case '\0':
 		return ((char*)data)[0]='\0', 1;
 	case '"':
+		if ( buffer[1]=='"' )
+			return ((char*)data)[0]='\0', 1;
 		return sscanf(buffer+1,"%256[^\"]",data);
 	default:
 		//return sscanf(buffer,"%256s",data);
@@ -728,6 +734,8 @@ int convert_to_char1024(const char *buffer, /**< a pointer to the string buffer
 	case '\0':
 		return ((char*)data)[0]='\0', 1;
 	case '"':
+		if ( buffer[1]=='"' )
+			return ((char*)data)[0]='\0', 1;
 		return sscanf(buffer+1,"%1024[^\"]",data);
 	default:
 		return sscanf(buffer,"%1024[^\n]",data);
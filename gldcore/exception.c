@@ -57,7 +57,8 @@
 #include "exception.h"
 #include "output.h"
 
-EXCEPTIONHANDLER *handlers = NULL;
+/* each thread has its own handlers, so an exception thrown in a thread is caught by that thread */
+static THREADLOCAL EXCEPTIONHANDLER *handlers = NULL;
 
 /** Creates an exception handler for use in a try block 
 	@return a pointer to an EXCEPTIONHANDLER structure
@@ -99,6 +99,7 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <sys/errno.h>
+#include <sys/wait.h>
 #define SOCKET int
 #define INVALID_SOCKET (-1)
 #define closesocket close
@@ -133,6 +134,8 @@
 #include "test.h"
 #include "link.h"
 #include "save.h"
+#include "replicate.h"
+#include "profile.h"
 
 #include "pthread.h"
 
@@ -343,6 +346,119 @@ static STATUS show_progress(void)
 /***********************************************************************/
 /* CHECKPOINTS (DPC Apr 2011) */
 
+#ifndef WIN32
+static pid_t checkpoint_pid = 0; /* background checkpoint writer process */
+static char checkpoint_pending[1024] = ""; /* checkpoint file being written in background */
+static bool checkpoint_pending_full = false; /* background checkpoint is a full checkpoint */
+#endif
+static char checkpoint_last[1024] = ""; /* last completed checkpoint file */
+static char checkpoint_base[1024] = ""; /* last completed full checkpoint file */
+static int checkpoint_deltas = 0; /* delta checkpoints written since last full checkpoint */
+
+/* writes a checkpoint file; the stream is written to a temporary file that is 
+   only renamed when complete so a failed checkpoint never replaces a good one */
+static STATUS checkpoint_write(char *fn, int options)
+{
+	char tmp[1040];
+	FILE *fp;
+	size_t len;
+	sprintf(tmp,"%s.tmp",fn);
+	fp = fopen(tmp,"wb");
+	if ( fp==NULL )
+	{
+		output_error("unable to open checkpoint file '%s' for writing", tmp);
+		return FAILED;
+	}
+	len = stream(fp,options);
+	if ( fclose(fp)!=0 || len==0 || len==(size_t)-1 )
+	{
+		output_error("checkpoint failure (stream context is %s)",stream_context());
+		unlink(tmp);
+		return FAILED;
+	}
+	if ( global_checkpoint_verify && stream_verify(tmp)==FAILED )
+	{
+		output_error("checkpoint file '%s' does not match the state it was written from", tmp);
+		/* TROUBLESHOOT
+			The checkpoint was read back after it was written and its contents differ
+			from the simulation state it was written from, so it cannot be used to
+			restore the simulation.  The previous checkpoint is kept.  Check that the 
+			disk the checkpoint files are written to is working properly and try again.
+		 */
+		unlink(tmp);
+		return FAILED;
+	}
+	unlink(fn);
+	if ( rename(tmp,fn)!=0 )
+	{
+		output_error("unable to rename checkpoint file '%s' to '%s'", tmp, fn);
+		/* TROUBLESHOOT
+			The checkpoint was written to a temporary file but it could not be renamed
+			to the checkpoint file name.  Check the permissions of the folder in which 
+			the checkpoint files are written and try again.
+		 */
+		return FAILED;
+	}
+	return SUCCESS;
+}
+
+/* records a completed checkpoint and deletes the previous ones if not desired,
+   but never the full checkpoint that delta checkpoints depend on */
+static void checkpoint_done(char *fn, bool full)
+{
+	if ( global_checkpoint_keepall==0 )
+	{
+		if ( strcmp(checkpoint_last,"")!=0 && strcmp(checkpoint_last,checkpoint_base)!=0 )
+			unlink(checkpoint_last);
+		if ( full && strcmp(checkpoint_base,"")!=0 )
+			unlink(checkpoint_base);
+	}
+	if ( full )
+		strcpy(checkpoint_base,fn);
+	strcpy(checkpoint_last,fn);
+}
+
+/* records a failed checkpoint; a failed full checkpoint cannot be used as a delta base,
+   and the run fails if checkpoints are being verified */
+static void checkpoint_failed(bool full)
+{
+	if ( full )
+		stream_snapshot(NULL);
+	if ( global_checkpoint_verify && exec_getexitcode()==XC_SUCCESS )
+		exec_setexitcode(XC_IOERR);
+}
+
+/* collects the background checkpoint writer, if any; returns false if it is still running */
+static bool checkpoint_wait(bool block)
+{
+#ifndef WIN32
+	int status;
+	pid_t pid;
+	if ( checkpoint_pid==0 )
+		return true;
+	pid = waitpid(checkpoint_pid,&status,block?0:WNOHANG);
+	if ( pid==0 )
+		return false;
+	if ( pid==checkpoint_pid && WIFEXITED(status) && WEXITSTATUS(status)==0 )
+	{
+		output_verbose("background checkpoint '%s' completed", checkpoint_pending);
+		checkpoint_done(checkpoint_pending,checkpoint_pending_full);
+	}
+	else
+	{
+		output_error("background checkpoint '%s' failed", checkpoint_pending);
+		/* TROUBLESHOOT
+			The process writing a checkpoint in the background did not complete successfully.
+			This message is usually preceded by a more detailed message from the checkpoint
+			writer.  Follow the guidance for that message and try again.
+		 */
+		checkpoint_failed(checkpoint_pending_full);
+	}
+	checkpoint_pid = 0;
+#endif
+	return true;
+}
+
 void do_checkpoint(void)
 {
 	/* last checkpoint value */
@@ -392,8 +508,16 @@ void do_checkpoint(void)
 		/* checkpoint time lapsed */
 		if ( last_checkpoint + global_checkpoint_interval <= now )
 		{
-			static char fn[1024] = "";
-			FILE *fp = NULL;
+			char fn[1024];
+			bool full;
+			int options = SF_OUT|(global_checkpoint_compress?SF_BLOCK:0);
+
+			/* previous background checkpoint is still being written */
+			if ( !checkpoint_wait(false) )
+			{
+				output_verbose("checkpoint deferred until '%s' is complete", checkpoint_pending);
+				return;
+			}
 
 			/* default checkpoint filename */
 			if ( strcmp(global_checkpoint_file,"")==0 )
@@ -409,25 +533,334 @@ void do_checkpoint(void)
 					*ext = '\0';
 			}
 
-			/* delete old checkpoint file if not desired */
-			if ( global_checkpoint_keepall==0 && strcmp(fn,"")!=0 )
-				unlink(fn);
-
 			/* create current checkpoint save filename */
 			sprintf(fn,"%s.%d",global_checkpoint_file,global_checkpoint_seqnum++);
-			fp = fopen(fn,"w");
-			if ( fp==NULL )
-				output_error("unable to open checkpoint file '%s' for writing");
+			last_checkpoint = now;
+
+			/* only write objects that changed since the last full checkpoint if possible */
+			full = global_checkpoint_deltas<=0 || checkpoint_deltas>=global_checkpoint_deltas || !stream_delta_ready();
+			if ( full )
+			{
+				if ( global_checkpoint_deltas>0 )
+					stream_snapshot(fn);
+				checkpoint_deltas = 0;
+			}
+			else
+			{
+				options |= SF_DELTA;
+				checkpoint_deltas++;
+			}
+
+#ifndef WIN32
+			/* write the checkpoint from a copy-on-write snapshot of the process.  Checkpoints are
+			   only taken between passes, once every sync thread has finished its list and is
+			   waiting for the next pass, so the snapshot is consistent.  The writer runs on the
+			   forked thread alone and leaves with _exit().  The server and multirun threads run
+			   independently of the passes and could hold locks the writer needs, so the checkpoint
+			   is written in the foreground when either is running. */
+			if ( global_checkpoint_background && ( strcmp(global_environment,"batch")!=0 || global_multirun_mode!=MRM_STANDALONE ) )
+			{
+				static int warned = 0;
+				if ( !warned++ )
+					output_warning("background checkpoints are not used in the %s environment or in multirun mode, checkpoints will be written in the foreground", global_environment);
+					/* TROUBLESHOOT
+						Background checkpoints are written by a process forked from the simulation, which is
+						only safe when no threads other than the sync threads are running.  The server, GUI
+						and multirun modes run threads of their own, so the checkpoints are written in the
+						foreground instead.  Run in batch mode to write checkpoints in the background.
+					 */
+			}
+			else if ( global_checkpoint_background )
+			{
+				pid_t pid;
+				fflush(NULL);
+				pid = fork();
+				if ( pid==0 )
+					_exit(checkpoint_write(fn,options)==SUCCESS?0:1);
+				else if ( pid>0 )
+				{
+					checkpoint_pid = pid;
+					strcpy(checkpoint_pending,fn);
+					checkpoint_pending_full = full;
+					return;
+				}
+				output_warning("unable to start background checkpoint writer (%s), checkpoint will be written in the foreground", strerror(errno));
+			}
+#endif
+			if ( checkpoint_write(fn,options)==SUCCESS )
+				checkpoint_done(fn,full);
 			else
+				checkpoint_failed(full);
+		}
+	}
+
+}
+
+/***********************************************************************/
+/* sparse sync (see global_sparse_sync)
+
+   Skip-safe objects are only synced in the iterations they are scheduled in.
+   The schedule of each iteration is made by sparse_begin() before the passes
+   start, while no sync thread is running, so the passes only read it:
+
+   - objects whose own time came are taken from a timing wheel keyed by the
+     time they asked to be synced, and their parent and children are woken;
+   - objects whose trigger properties were set (see exec_sparse_activate)
+     are woken;
+   - every object that runs wakes its children, and so on down the tree, so
+     objects under a parent that is not skip-safe are always synced.
+
+   Objects that ran are put back in the wheel at the start of the next 
+   iteration, once the time they returned in every pass is known.
+ */
+#define SPARSE_WHEEL 4096 /* number of wheel slots (must be a power of 2) */
+#define SPARSE_NONE 0xffffffff /* end of a wheel slot list */
+typedef struct s_sparsestate {
+	TIMESTAMP due; /**< earliest time the object asked to be synced (negative if soft) */
+	unsigned int epoch; /**< last iteration the object was scheduled in */
+	unsigned int synced; /**< last iteration the object was synced in */
+	unsigned int next, prev; /**< neighbours in the wheel slot list */
+	unsigned int slot; /**< wheel slot of the object (SPARSE_NONE if it is not in the wheel) */
+	bool always; /**< object or one of its ancestors is not skip-safe */
+	bool woken; /**< object is in the wake list */
+} SPARSESTATE;
+static SPARSESTATE *sparse = NULL; /* indexed by object id */
+static unsigned int n_sparse = 0;
+static OBJECT **sparse_link = NULL; /* parent and children of each object */
+static unsigned int *sparse_link_index = NULL; /* first link of each object (n_sparse+1 entries) */
+static unsigned int *sparse_active = NULL; /* objects scheduled in the current iteration */
+static unsigned int n_active = 0;
+static unsigned int *sparse_wake = NULL; /* objects woken by a trigger property since the schedule was made */
+static unsigned int n_wake = 0;
+static unsigned int sparse_wheel[SPARSE_WHEEL]; /* first object of each wheel slot */
+static TIMESTAMP sparse_wheel_time = TS_INVALID; /* time the wheel was last scanned */
+static unsigned int sparse_epoch = 0;
+static bool sparse_reiterate = false;
+static unsigned int sparse_lock = 0; /* protects the wake list and the schedule against trigger properties set by other threads */
+
+static STATUS sparse_init(void)
+{
+	OBJECT *obj;
+	unsigned int n, *fill;
+	if ( !global_sparse_sync )
+		return SUCCESS;
+
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		if ( obj->id>=n_sparse ) n_sparse = obj->id+1;
+	sparse = (SPARSESTATE*)calloc(n_sparse,sizeof(SPARSESTATE));
+	sparse_link_index = (unsigned int*)calloc(n_sparse+1,sizeof(unsigned int));
+	sparse_active = (unsigned int*)malloc(sizeof(unsigned int)*(n_sparse+1));
+	sparse_wake = (unsigned int*)malloc(sizeof(unsigned int)*(n_sparse+1));
+	fill = (unsigned int*)calloc(n_sparse,sizeof(unsigned int));
+	if ( sparse==NULL || sparse_link_index==NULL || sparse_active==NULL || sparse_wake==NULL || fill==NULL )
+		goto Nomem;
+
+	/* count links (each parent/child pair is a link in both directions) */
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		OBJECT *p;
+		for ( p=obj ; p!=NULL && (p->flags&OF_SKIPSAFE) ; p=p->parent ) {}
+		sparse[obj->id].always = (p!=NULL);
+		sparse[obj->id].slot = SPARSE_NONE;
+		sparse[obj->id].due = TS_NEVER;
+		if ( obj->parent==NULL ) continue;
+		sparse_link_index[obj->id+1]++;
+		sparse_link_index[obj->parent->id+1]++;
+	}
+	for ( n=0 ; n<n_sparse ; n++ )
+		sparse_link_index[n+1] += sparse_link_index[n];
+	sparse_link = (OBJECT**)malloc(sizeof(OBJECT*)*(sparse_link_index[n_sparse]+1));
+	if ( sparse_link==NULL )
+		goto Nomem;
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		if ( obj->parent==NULL ) continue;
+		sparse_link[sparse_link_index[obj->id]+fill[obj->id]++] = obj->parent;
+		sparse_link[sparse_link_index[obj->parent->id]+fill[obj->parent->id]++] = obj;
+	}
+	free(fill);
+	for ( n=0 ; n<SPARSE_WHEEL ; n++ )
+		sparse_wheel[n] = SPARSE_NONE;
+	sparse_wheel_time = TS_INVALID;
+	n_active = n_wake = 0;
+
+	/* every skip-safe object is woken for the first iteration */
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		if ( sparse[obj->id].always ) continue;
+		sparse[obj->id].woken = true;
+		sparse_wake[n_wake++] = obj->id;
+	}
+	output_verbose("sparse sync enabled for %d objects with %d parent/child links", n_sparse, sparse_link_index[n_sparse]);
+	return SUCCESS;
+Nomem:
+	output_error("sparse sync memory allocation failed");
+	/* TROUBLESHOOT
+		The sparse sync tables could not be allocated.  
+		Follow the standard process for freeing up memory or disable sparse_sync and try again.
+	 */
+	free(fill);
+	return FAILED;
+}
+
+static void sparse_term(void)
+{
+	free(sparse);
+	free(sparse_link);
+	free(sparse_link_index);
+	free(sparse_active);
+	free(sparse_wake);
+	sparse = NULL;
+	sparse_link = NULL;
+	sparse_link_index = NULL;
+	sparse_active = NULL;
+	sparse_wake = NULL;
+	n_sparse = n_active = n_wake = 0;
+}
+
+/* take an object out of its wheel slot */
+static void sparse_wheel_remove(unsigned int id)
+{
+	SPARSESTATE *s = &sparse[id];
+	if ( s->slot==SPARSE_NONE ) return;
+	if ( s->prev==SPARSE_NONE ) sparse_wheel[s->slot] = s->next; else sparse[s->prev].next = s->next;
+	if ( s->next!=SPARSE_NONE ) sparse[s->next].prev = s->prev;
+	s->slot = SPARSE_NONE;
+}
+
+/* put an object in the wheel slot of the time it asked to be synced */
+static void sparse_wheel_insert(unsigned int id)
+{
+	SPARSESTATE *s = &sparse[id];
+	TIMESTAMP t = absolute_timestamp(s->due);
+	sparse_wheel_remove(id);
+	if ( t==TS_NEVER ) return;
+	s->slot = (unsigned int)(t&(SPARSE_WHEEL-1));
+	s->prev = SPARSE_NONE;
+	s->next = sparse_wheel[s->slot];
+	if ( s->next!=SPARSE_NONE ) sparse[s->next].prev = id;
+	sparse_wheel[s->slot] = id;
+}
+
+/* add an object to the schedule of the current iteration */
+static void sparse_schedule(unsigned int id)
+{
+	SPARSESTATE *s = &sparse[id];
+	if ( s->always || s->epoch==sparse_epoch ) return;
+	s->epoch = sparse_epoch;
+	sparse_wheel_remove(id);
+	sparse_active[n_active++] = id;
+}
+
+/* take the objects whose time came out of the wheel and schedule them with their parent and children */
+static void sparse_wheel_scan(void)
+{
+	TIMESTAMP t, from = sparse_wheel_time;
+	if ( from==TS_INVALID || from>global_clock || global_clock-from>=SPARSE_WHEEL )
+		from = global_clock-SPARSE_WHEEL+1; /* every slot */
+	for ( t=from ; t<=global_clock ; t++ )
+	{
+		unsigned int id = sparse_wheel[t&(SPARSE_WHEEL-1)];
+		while ( id!=SPARSE_NONE )
+		{
+			unsigned int next = sparse[id].next, n;
+			if ( absolute_timestamp(sparse[id].due)<=global_clock )
 			{
-				if ( stream(fp,SF_OUT)<=0 )
-					output_error("checkpoint failure (stream context is %s)",stream_context());
-				fclose(fp);
-				last_checkpoint = now;
+				sparse_schedule(id);
+				for ( n=sparse_link_index[id] ; n<sparse_link_index[id+1] ; n++ )
+					sparse_schedule(sparse_link[n]->id);
 			}
+			id = next;
 		}
 	}
+	sparse_wheel_time = global_clock;
+}
 
+/* make the schedule of a new iteration; called before the passes start */
+static void sparse_begin(void)
+{
+	unsigned int n, i;
+	if ( sparse==NULL )
+		return;
+	wlock(&sparse_lock);
+	sparse_epoch++;
+	sparse_reiterate = false;
+
+	/* objects that ran in the last iteration go back in the wheel */
+	for ( n=0 ; n<n_active ; n++ )
+		sparse_wheel_insert(sparse_active[n]);
+	n_active = 0;
+
+	/* objects whose time came, and their parent and children */
+	sparse_wheel_scan();
+
+	/* objects whose trigger properties were set */
+	for ( n=0 ; n<n_wake ; n++ )
+	{
+		sparse[sparse_wake[n]].woken = false;
+		sparse_schedule(sparse_wake[n]);
+	}
+	n_wake = 0;
+
+	/* objects that run wake their children, and so on down the tree */
+	for ( i=0 ; i<n_active ; i++ )
+	{
+		unsigned int id = sparse_active[i];
+		for ( n=sparse_link_index[id] ; n<sparse_link_index[id+1] ; n++ )
+			if ( sparse_link[n]->parent!=NULL && sparse_link[n]->parent->id==id )
+				sparse_schedule(sparse_link[n]->id);
+	}
+	wunlock(&sparse_lock);
+}
+
+/** Reactivate an object when sparse sync is enabled
+	This is called when a property that triggers reactivation (see PF_ACTIVATE) is set.
+	The object is synced in the next iteration, which repeats the current one if 
+	the object was not scheduled in it.
+ **/
+void exec_sparse_activate(OBJECT *obj) /**< the object whose inputs changed */
+{
+	SPARSESTATE *s;
+	if ( sparse==NULL || obj->id>=n_sparse )
+		return;
+	wlock(&sparse_lock);
+	s = &sparse[obj->id];
+	if ( !s->always && s->epoch!=sparse_epoch && !s->woken )
+	{
+		s->woken = true;
+		sparse_wake[n_wake++] = obj->id;
+		sparse_reiterate = true;
+	}
+	wunlock(&sparse_lock);
+}
+
+/* decide whether an object must be synced in the current iteration */
+static bool sparse_run(OBJECT *obj)
+{
+	SPARSESTATE *s;
+	if ( sparse==NULL || obj->id>=n_sparse )
+		return true;
+	s = &sparse[obj->id];
+	return s->always || s->epoch==sparse_epoch;
+}
+
+/* record the time at which a scheduled object next needs to be synced; only the 
+   thread syncing the object writes its state during the passes */
+static void sparse_update(OBJECT *obj, TIMESTAMP t)
+{
+	SPARSESTATE *s;
+	if ( sparse==NULL || obj->id>=n_sparse || t==TS_INVALID )
+		return;
+	s = &sparse[obj->id];
+	if ( s->always || s->epoch!=sparse_epoch )
+		return;
+	if ( s->synced!=sparse_epoch )
+	{
+		s->synced = sparse_epoch;
+		s->due = TS_NEVER;
+	}
+	if ( absolute_timestamp(t)<absolute_timestamp(s->due) || (absolute_timestamp(t)==absolute_timestamp(s->due) && t>0) )
+		s->due = t;
 }
 
 /***********************************************************************/
@@ -447,9 +880,15 @@ static void ss_do_object_sync(int thread, void *item)
 		this_t = obj->in_svc; /* yet to go in service */
 	else if ((global_clock==obj->in_svc) && (obj->in_svc_micro != 0))	/* If our in service is a little higher, delay to next time */
 		this_t = obj->in_svc + 1;	/* Technically yet to go into service -- deltamode handled separately */
+	else if (global_clock<=obj->out_svc && !sparse_run(obj))
+	{
+		this_t = sparse[obj->id].due; /* not due yet and inputs unchanged */
+		data->skipped++;
+	}
 	else if (global_clock<=obj->out_svc)
 	{
 		this_t = object_sync(obj, global_clock, passtype[pass]);
+		data->executed++;
 		if (this_t == global_clock)
 		{
 			output_verbose("%s: object %s calling for re-sync", simtime(), object_name(obj, b, 63));
@@ -507,6 +946,7 @@ static void ss_do_object_sync(int thread, void *item)
 	}
 	else 
 		this_t = TS_NEVER; /* already out of service */
+	sparse_update(obj,this_t);
 
 	/* check for "soft" event (events that are ignored when stopping) */
 	if (this_t < -1)
@@ -1256,20 +1696,29 @@ TIMESTAMP sync_heartbeats(void)
 TIMESTAMP syncall_internals(TIMESTAMP t1)
 {
 	TIMESTAMP h1, h2, s1, s2, s3, s4, s5, s6, se, sa;
+	int64 t = global_profiler ? profile_clock() : 0;
 
 	/* external link must be first */
 	h1 = link_syncall(t1);
+	if ( global_profiler ) t = profile_internal(PRI_LINK,t);
 
 	/* @todo add other internal syncs here */
 	h2 = instance_syncall(t1);	
+	if ( global_profiler ) t = profile_internal(PRI_INSTANCE,t);
 	s1 = randomvar_syncall(t1);
+	if ( global_profiler ) t = profile_internal(PRI_RANDOMVAR,t);
 	s2 = schedule_syncall(t1);
+	if ( global_profiler ) t = profile_internal(PRI_SCHEDULE,t);
 	s3 = loadshape_syncall(t1);
+	if ( global_profiler ) t = profile_internal(PRI_LOADSHAPE,t);
 	s4 = transform_syncall(t1,XS_SCHEDULE|XS_LOADSHAPE);
+	if ( global_profiler ) t = profile_internal(PRI_TRANSFORM,t);
 	s5 = enduse_syncall(t1);
+	if ( global_profiler ) t = profile_internal(PRI_ENDUSE,t);
 
 	/* heartbeats go last */
 	s6 = sync_heartbeats();
+	if ( global_profiler ) profile_internal(PRI_HEARTBEAT,t);
 
 	/* earliest soft event */
 	se = absolute_timestamp(earliest_timestamp(s1,s2,s3,s4,s5,s6,TS_ZERO));
@@ -1695,6 +2144,10 @@ STATUS exec_start(void)
 	/* initialize the main loop state control */
 	exec_mls_init();
 
+	/* start the profiler before objects are initialized */
+	if ( global_profiler && profile_init()==FAILED )
+		return FAILED;
+
 	/* perform object initialization */
 	if (init_all() == FAILED)
 	{
@@ -1727,6 +2180,28 @@ STATUS exec_start(void)
 	if (global_compileonly)
 		return SUCCESS;
 
+	/* run Monte Carlo replications from the initialized model */
+	if ( global_replications>1 && global_multirun_mode==MRM_STANDALONE )
+	{
+		switch ( replicate_start() ) {
+		case -1:
+			output_error("replication startup failed");
+			return FAILED;
+		case 0:
+			/* term scripts run once, in the parent, so they can use the report */
+			if ( replicate_report()==FAILED )
+				return FAILED;
+			if ( exec_run_termscripts()!=XC_SUCCESS )
+			{
+				output_error("term script(s) failed");
+				return FAILED;
+			}
+			return SUCCESS;
+		default:
+			break; /* replication worker continues with the main loop */
+		}
+	}
+
 	/* enable non-determinism check, if any */
 	if (global_randomseed!=0 && global_threadcount>1)
 		global_nondeterminism_warning = 1;
@@ -1764,7 +2239,15 @@ STATUS exec_start(void)
 		thread_data->count = global_threadcount;
 		thread_data->data = (struct sync_data *) (thread_data + 1);
 		for (j = 0; j < thread_data->count; j++) 
+		{
 			thread_data->data[j].status = SUCCESS;
+			thread_data->data[j].executed = 0;
+			thread_data->data[j].skipped = 0;
+		}
+
+		/* setup sparse sync tables */
+		if ( sparse_init()==FAILED )
+			return FAILED;
 	}
 	else
 	{
@@ -2033,6 +2516,7 @@ STATUS exec_start(void)
 					thread_data->data[j].hard_event = 0;
 					thread_data->data[j].step_to = TS_NEVER;
 				}
+				sparse_begin();
 			}
 #ifdef _DEBUG
 			if ( global_clock>=global_runaway_time ) 
@@ -2194,6 +2678,10 @@ STATUS exec_start(void)
 					exec_sync_merge(NULL,&thread_data->data[j]);
 				}
 
+				/* repeat the iteration if a skipped object was reactivated */
+				if ( sparse_reiterate )
+					exec_sync_set(NULL,global_clock);
+
 				/* report progress */
 				realtime_run_schedule();
 			}
@@ -2320,6 +2808,9 @@ STATUS exec_start(void)
 		instance_master_done(TS_NEVER); // tell everyone to pack up and go home
 	}
 
+	/* wait for background checkpoint, if any */
+	checkpoint_wait(true);
+
 	//sjin: GetMachineCycleCount
 	cend = (clock_t)exec_clock();
 
@@ -2329,8 +2820,12 @@ STATUS exec_start(void)
 		output_error("finalize_all() failed");
 	}
 
-	/* run term scripts, if any */
-	if ( exec_run_termscripts()!=XC_SUCCESS )
+	/* collect profile data and write profile files (before the term scripts, so they can read them) */
+	if ( global_profiler )
+		profile_export();
+
+	/* run term scripts, if any (replication workers leave them to the parent) */
+	if ( global_replication_index==0 && exec_run_termscripts()!=XC_SUCCESS )
 	{
 		output_error("term script(s) failed");
 		return FAILED;
@@ -2339,6 +2834,14 @@ STATUS exec_start(void)
 	/* deallocate threadpool */
 	if (!global_debug_mode)
 	{
+		for (j = 0; j < thread_data->count; j++)
+		{
+			global_sync_executed += thread_data->data[j].executed;
+			global_sync_skipped += thread_data->data[j].skipped;
+		}
+		if ( global_sparse_sync )
+			output_verbose("sparse sync executed %"FMT_INT64"d and skipped %"FMT_INT64"d object syncs", global_sync_executed, global_sync_skipped);
+		sparse_term();
 		free(thread_data);
 		thread_data = NULL;
 
@@ -2378,7 +2881,7 @@ STATUS exec_start(void)
 		double delta_runtime = 0, delta_simtime = 0;
 		if (global_threadcount==0) global_threadcount=1;
 		for (cl=class_get_first_class(); cl!=NULL; cl=cl->next)
-			sync_time += ((double)cl->profiler.clocks)/CLOCKS_PER_SEC;
+			sync_time += ((double)cl->profiler.clocks)/1e9;
 		sync_time /= global_threadcount;
 		delta_runtime = dp->t_count>0 ? (dp->t_preupdate+dp->t_update+dp->t_postupdate)/CLOCKS_PER_SEC : 0;
 		delta_simtime = dp->t_count*(double)dp->t_delta/(double)dp->t_count/1e9;
@@ -2409,6 +2912,9 @@ STATUS exec_start(void)
 		output_profile("Passes completed        %8d passes", passes);
 		output_profile("Time steps completed    %8d timesteps", tsteps);
 		output_profile("Convergence efficiency  %8.02lf passes/timestep", (double)passes/tsteps);
+		output_profile("Object syncs executed   %8"FMT_INT64"d syncs", global_sync_executed);
+		if ( global_sparse_sync )
+			output_profile("Object syncs skipped    %8"FMT_INT64"d syncs (%.1f%%)", global_sync_skipped, global_sync_executed+global_sync_skipped>0 ? (double)global_sync_skipped/(global_sync_executed+global_sync_skipped)*100 : 0);
 #ifndef NOLOCKS
 		output_profile("Read lock contention    %7.01lf%%", (rlock_spin>0 ? (1-(double)rlock_count/(double)rlock_spin)*100 : 0));
 		output_profile("Write lock contention   %7.01lf%%", (wlock_spin>0 ? (1-(double)wlock_count/(double)wlock_spin)*100 : 0));
@@ -2439,6 +2945,10 @@ STATUS exec_start(void)
 
 	sched_update(global_clock,MLS_DONE);
 
+	/* report replication results (does not return in replication workers) */
+	if ( global_replication_index>0 )
+		replicate_done(exec_sync_getstatus(NULL));
+
 	/* terminate links */
 	return exec_sync_getstatus(NULL);
 }
@@ -18,6 +18,8 @@ struct sync_data {
 	TIMESTAMP step_to; /**< time to advance to */
 	unsigned int hard_event; /**< non-zero for hard events that can effect the advance step-to */
 	STATUS status; /**< the current status */
+	int64 executed; /**< number of object syncs executed */
+	int64 skipped; /**< number of object syncs skipped by sparse sync */
 }; /**< the synchronization state structure */
 
 struct thread_data {
@@ -35,6 +37,8 @@ STATUS t_setup_ranks(void);
 INDEX **exec_getranks(void);
 void exec_sleep(unsigned int usec);
 int64 exec_clock(void);
+struct s_object_list;
+void exec_sparse_activate(struct s_object_list *obj);
 
 void exec_mls_create(void);
 void exec_mls_init(void);
@@ -137,7 +137,12 @@ static struct s_varmap {
 	{"dumpall", PT_bool, &global_dumpall, PA_PUBLIC, "dumpall enable flag"},
 	{"runchecks", PT_bool, &global_runchecks, PA_PUBLIC, "runchecks enable flag"},
 	{"threadcount", PT_int32, &global_threadcount, PA_PUBLIC, "number of threads to use while using multicore"},
+	{"loadthreads", PT_int32, &global_loadthreads, PA_PUBLIC, "number of threads used to parse the objects of included files"},
 	{"profiler", PT_bool, &global_profiler, PA_PUBLIC, "profiler enable flag"},
+	{"profile_summary", PT_char1024, &global_profile_summary, PA_PUBLIC, "profiler CSV summary file name"},
+	{"profile_trace", PT_char1024, &global_profile_trace, PA_PUBLIC, "profiler Chrome trace file name"},
+	{"profile_trace_limit", PT_int32, &global_profile_trace_limit, PA_PUBLIC, "maximum number of profiler trace events per thread"},
+	{"slab_size", PT_int32, &global_slab_size, PA_PUBLIC, "largest number of objects allocated in one chunk of memory"},
 	{"pauseatexit", PT_bool, &global_pauseatexit, PA_PUBLIC, "pause at exit flag"},
 	{"testoutputfile", PT_char1024, &global_testoutputfile, PA_PUBLIC, "filename for test output"},
 	{"xml_encoding", PT_int32, &global_xml_encoding, PA_PUBLIC, "XML data encoding"},
@@ -163,6 +168,9 @@ static struct s_varmap {
 	{"force_compile", PT_int32, &global_force_compile, PA_PUBLIC, "force recompile enable flag"},
 	{"nolocks", PT_bool, &global_nolocks, PA_PUBLIC, "locking disable flag"},
 	{"skipsafe", PT_bool, &global_skipsafe, PA_PUBLIC, "skip sync safe enable flag"},
+	{"sparse_sync", PT_bool, &global_sparse_sync, PA_PUBLIC, "sparse sync enable flag"},
+	{"sync_executed", PT_int64, &global_sync_executed, PA_REFERENCE, "number of object syncs executed"},
+	{"sync_skipped", PT_int64, &global_sync_skipped, PA_REFERENCE, "number of object syncs skipped by sparse sync"},
 	{"dateformat", PT_enumeration, &global_dateformat, PA_PUBLIC, "date format string", df_keys},
 	{"init_sequence", PT_enumeration, &global_init_sequence, PA_PUBLIC, "initialization sequence control flag", isc_keys},
 	{"minimum_timestep", PT_int32, &global_minimum_timestep, PA_PUBLIC, "minimum timestep"},
@@ -191,6 +199,10 @@ static struct s_varmap {
 	{"checkpoint_seqnum", PT_int32, &global_checkpoint_seqnum, PA_PUBLIC, "checkpoint sequence number"},
 	{"checkpoint_interval", PT_int32, &global_checkpoint_interval, PA_PUBLIC, "checkpoint interval"},
 	{"checkpoint_keepall", PT_bool, &global_checkpoint_keepall, PA_PUBLIC, "checkpoint file keep enable flag"},
+	{"checkpoint_background", PT_bool, &global_checkpoint_background, PA_PUBLIC, "background checkpoint writer enable flag"},
+	{"checkpoint_compress", PT_bool, &global_checkpoint_compress, PA_PUBLIC, "checkpoint block compression and checksum enable flag"},
+	{"checkpoint_verify", PT_bool, &global_checkpoint_verify, PA_PUBLIC, "checkpoint verification enable flag"},
+	{"checkpoint_deltas", PT_int32, &global_checkpoint_deltas, PA_PUBLIC, "number of delta checkpoints between full checkpoints"},
 	{"check_version", PT_bool, &global_check_version, PA_PUBLIC, "check version enable flag"},
 	{"random_number_generator", PT_enumeration, &global_randomnumbergenerator, PA_PUBLIC, "random number generator version control flag", rng_keys},
 	{"mainloop_state", PT_enumeration, &global_mainloopstate, PA_PUBLIC, "main sync loop state flag", mls_keys},
@@ -230,6 +242,11 @@ static struct s_varmap {
 	{"wget_options", PT_char1024, &global_wget_options, PA_PUBLIC, "wget options"},
 	{"svnroot", PT_char1024, &global_svnroot, PA_PUBLIC, "svnroot"},
 	{"allow_reinclude", PT_bool, &global_reinclude, PA_PUBLIC, "allow the same include file to be included multiple times"},
+	{"replications", PT_int32, &global_replications, PA_PUBLIC, "number of Monte Carlo replications"},
+	{"replication_workers", PT_int32, &global_replication_workers, PA_PUBLIC, "maximum number of concurrent replications (0 means processor count)"},
+	{"replication_index", PT_int32, &global_replication_index, PA_REFERENCE, "replication run by this process"},
+	{"replication_metrics", PT_char1024, &global_replication_metrics, PA_PUBLIC, "list of object.property values collected from each replication"},
+	{"replication_report", PT_char1024, &global_replication_report, PA_PUBLIC, "replication summary report file name"},
 	/* add new global variables here */
 };
 
@@ -91,7 +91,12 @@ GLOBAL int global_dumpall INIT(FALSE);	/**< Flags all modules to dump data after
 GLOBAL int global_runchecks INIT(FALSE); /**< Flags module check code to be called after initialization */
 /** @todo Set the threadcount to zero to automatically use the maximum system resources (tickets 180) */
 GLOBAL int global_threadcount INIT(1); /**< the maximum thread limit, zero means automagically determine best thread count */
+GLOBAL int global_loadthreads INIT(1); /**< the number of threads that parse the objects of included files (1 loads them serially) */
 GLOBAL int global_profiler INIT(0); /**< Flags the profiler to process class performance data */
+GLOBAL char global_profile_summary[1024] INIT(""); /**< CSV file to which the profiler summary is written (none if empty) */
+GLOBAL char global_profile_trace[1024] INIT(""); /**< Chrome trace JSON file to which profiled calls are written (none if empty) */
+GLOBAL int global_profile_trace_limit INIT(1000000); /**< maximum number of trace events kept by each thread */
+GLOBAL int global_slab_size INIT(1024); /**< largest number of objects allocated in one chunk of memory (0 allocates each object separately) */
 GLOBAL int global_pauseatexit INIT(0); /**< Enable a pause for user input after exit */
 GLOBAL char global_testoutputfile[1024] INIT("test.txt"); /**< Specifies the test output file */
 GLOBAL int global_xml_encoding INIT(8);  /**< Specifies XML encoding (default is 8) */
@@ -131,6 +136,9 @@ GLOBAL int global_force_compile INIT(0); /** flag to force recompile of GLM file
 GLOBAL int global_nolocks INIT(0); /** flag to disable memory locking */
 GLOBAL int global_forbid_multiload INIT(0); /** flag to disable multiple GLM file loads */
 GLOBAL int global_skipsafe INIT(0); /** flag to allow skipping of safe syncs (see OF_SKIPSAFE) */
+GLOBAL bool global_sparse_sync INIT(false); /** flag to sync OF_SKIPSAFE objects only when they are due or their inputs change */
+GLOBAL int64 global_sync_executed INIT(0); /** number of object syncs executed by the main loop */
+GLOBAL int64 global_sync_skipped INIT(0); /** number of object syncs skipped by sparse sync */
 typedef enum {DF_ISO=0, DF_US=1, DF_EURO=2} DATEFORMAT;
 GLOBAL int global_dateformat INIT(DF_ISO); /** date format (ISO=0, US=1, EURO=2) */
 typedef enum {IS_CREATION=0, IS_DEFERRED=1, IS_BOTTOMUP=2, IS_TOPDOWN=3} INITSEQ;
@@ -207,6 +215,10 @@ GLOBAL char global_checkpoint_file[1024] INIT(""); /**< checkpoint file name is
 GLOBAL int global_checkpoint_seqnum INIT(0); /**< checkpoint sequence file number */
 GLOBAL int global_checkpoint_interval INIT(0); /** checkpoint interval (default is 3600 for CPT_WALL and 86400 for CPT_SIM */
 GLOBAL int global_checkpoint_keepall INIT(0); /** determines whether all checkpoint files are kept, non-zero keeps files, zero delete all but last */
+GLOBAL bool global_checkpoint_background INIT(false); /** determines whether checkpoints are written by a forked process while the simulation continues */
+GLOBAL bool global_checkpoint_compress INIT(false); /** determines whether checkpoints are written in compressed and checksummed blocks */
+GLOBAL bool global_checkpoint_verify INIT(false); /** determines whether each checkpoint is read back and compared with the state it was written from */
+GLOBAL int global_checkpoint_deltas INIT(0); /** number of delta checkpoints written between full checkpoints (0 means all checkpoints are full) */
 
 /* version check */
 GLOBAL int global_check_version INIT(0); /**< check version flag */
@@ -315,6 +327,13 @@ GLOBAL char1024 global_svnroot INIT("http://gridlab-d.svn.sourceforge.net/svnroo
 GLOBAL char1024 global_wget_options INIT("maxsize:100MB;update:newer"); /**< maximum size of wget request */
 
 GLOBAL bool global_reinclude INIT(false); /**< allow the same include file to be included multiple times */
+
+/* Monte Carlo replication */
+GLOBAL int global_replications INIT(0); /**< number of Monte Carlo replications to run from the initialized model (0 or 1 runs once) */
+GLOBAL int global_replication_workers INIT(0); /**< maximum number of replications run concurrently (0 means processor count) */
+GLOBAL int global_replication_index INIT(0); /**< replication being run by this process (0 when not replicating) */
+GLOBAL char1024 global_replication_metrics INIT(""); /**< comma-separated list of object.property (or global) values to collect from each replication */
+GLOBAL char1024 global_replication_report INIT("replications.csv"); /**< replication summary report file name */
 #ifdef __cplusplus
 }
 #endif
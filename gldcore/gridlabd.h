@@ -93,6 +93,7 @@
 #include "transform.h"
 #include "object.h"
 #include "find.h"
+#include "propview.h"
 #include "random.h"
 #define STREAM_MODULE
 #include "stream.h"
@@ -2262,6 +2263,33 @@ public:
 	inline void exception(const char *msg, ...) { static char buf[1024]; va_list ptr; va_start(ptr,msg); vsprintf(buf,msg,ptr); va_end(ptr); throw (const char*)buf;};
 };
 
+/// Property view container
+class gld_propview {
+private:
+	struct s_propview *view;
+public:
+	inline operator PROPVIEW*() { return view; };
+public:
+	inline gld_propview(CLASS *c, char *proplist) { view=callback->propview.create(c,proplist); if (!view) exception("gld_propview(): view of '%s' in class '%s' could not be created",proplist,c?c->name:"(null)"); };
+	inline gld_propview(char *cn, char *proplist)
+	{
+		CLASS *c=callback->class_getname(cn); if (!c) exception("gld_propview(): class '%s' is not found",cn);
+		view=callback->propview.create(c,proplist); if (!view) exception("gld_propview(): view of '%s' in class '%s' could not be created",proplist,cn);
+	};
+	inline ~gld_propview(void) { callback->propview.destroy(view); };
+public:
+	inline unsigned int get_count(void) { return view->n_props; };
+	inline PROPERTY *get_property(unsigned int n) { return view->prop[n]; };
+	inline size_t get_width(unsigned int n) { return view->width[n]; };
+	inline bool is_writable(void) { return view->writable!=0; };
+	static inline bool can_view(PROPERTY *prop) { return callback->propview.can_view(prop); };
+	inline size_t gather(OBJECT **obj, size_t n, void **column, unsigned int threads=0) { return callback->propview.gather(view,obj,n,column,threads); };
+	inline size_t gather(OBJLIST *list, void **column, unsigned int threads=0) { return gather(list->objlist,list->size,column,threads); };
+	inline size_t scatter(OBJECT **obj, size_t n, void **column, unsigned int threads=0) { return callback->propview.scatter(view,obj,n,column,threads); };
+	inline size_t scatter(OBJLIST *list, void **column, unsigned int threads=0) { return scatter(list->objlist,list->size,column,threads); };
+	inline void exception(const char *msg, ...) { static char buf[1024]; va_list ptr; va_start(ptr,msg); vsprintf(buf,msg,ptr); va_end(ptr); throw (const char*)buf;};
+};
+
 /// Web data container
 class gld_webdata {
 private:
@@ -2302,7 +2330,7 @@ CDECL int gld_major=MAJOR, gld_minor=MINOR;
 CDECL int dllinit() __attribute__((constructor));
 CDECL int dllkill() __attribute__((destructor));
 CDECL int dllinit() { return 0; }
-CDECL int dllkill() { do_kill(NULL); }
+CDECL int dllkill() { do_kill(NULL); return 0; }
 #endif // !WIN32
 #elif defined CONSOLE
 #ifdef WIN32
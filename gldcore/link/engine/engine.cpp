@@ -10,7 +10,7 @@ CALLBACKS *callback = NULL;
 #include "link.h"
 #include "build.h"
 
-gld_property **sync_index = NULL;
+SYNCDATA **sync_index = NULL;
 unsigned int sync_index_size = 0;
 
 typedef enum {ELS_INIT=0, ELS_OK=1, ELS_ERROR=2, ELS_TERM=3} ENGINELINKSTATUS;
@@ -278,14 +278,83 @@ bool send_time(ENGINELINK *engine,TIMESTAMP t0){
   return true;
 }
 
+// make property views of the object properties in a sync list, one per class and property,
+// so the values are copied for all the objects at once; imports are only viewed when
+// they can be scattered, i.e., the properties are public and nothing is notified of changes
+SYNCVIEW *make_views(SYNCDATA *list, bool write)
+{
+	SYNCVIEW *first = NULL, *view;
+	SYNCDATA *item;
+
+	// count the objects of each class and property
+	for ( item=list ; item!=NULL ; item=item->next )
+	{
+		OBJECT *obj = item->prop->get_object();
+		PROPERTY *prop = item->prop->get_property();
+		if ( obj==NULL || prop==NULL || !gld_propview::can_view(prop) || gl_find_property(obj->oclass,prop->name)!=prop )
+			continue;
+		if ( write && (prop->access!=PA_PUBLIC || prop->notify!=NULL || obj->oclass->notify!=NULL) )
+			continue;
+		for ( view=first ; view!=NULL && (view->oclass!=obj->oclass || view->prop!=prop) ; view=view->next ) {}
+		if ( view==NULL )
+		{
+			view = new SYNCVIEW;
+			memset(view,0,sizeof(SYNCVIEW));
+			view->oclass = obj->oclass;
+			view->prop = prop;
+			view->next = first;
+			first = view;
+		}
+		view->n_objects++;
+	}
+
+	// make the views and their columns
+	for ( view=first ; view!=NULL ; view=view->next )
+	{
+		view->view = new gld_propview(view->oclass,view->prop->name);
+		view->obj = new OBJECT*[view->n_objects];
+		view->column = new char[view->view->get_width(0)*view->n_objects];
+		view->n_objects = 0;
+	}
+
+	// assign each item a place in the column of its view
+	for ( item=list ; item!=NULL ; item=item->next )
+	{
+		OBJECT *obj = item->prop->get_object();
+		PROPERTY *prop = item->prop->get_property();
+		for ( view=first ; view!=NULL && (obj==NULL || view->oclass!=obj->oclass || view->prop!=prop) ; view=view->next ) {}
+		if ( view==NULL )
+			continue;
+		item->value = (char*)view->column + view->n_objects*view->view->get_width(0);
+		view->obj[view->n_objects++] = obj;
+	}
+	return first;
+}
+
+// copy the viewed values from the objects into the columns
+void gather_views(SYNCVIEW *list)
+{
+	for ( SYNCVIEW *view=list ; view!=NULL ; view=view->next )
+		view->view->gather(view->obj,view->n_objects,&(view->column),1);
+}
+
 bool send_exports(ENGINELINK *engine)
 {
 	char buffer[1500];
+	char value[1025];
 	int len;
 	SYNCDATA *item;
+	gather_views(engine->send_view);
 	for ( item=engine->send ; item!=NULL ; item=item->next )
 	{
-		len=sprintf(buffer,"%d %s", item->index, item->prop->get_string().get_buffer());
+		if ( item->value!=NULL )
+		{
+			if ( callback->convert.property_to_string(item->prop->get_property(),item->value,value,sizeof(value))<=0 )
+				return false;
+			len=sprintf(buffer,"%d %s", item->index, value);
+		}
+		else
+			len=sprintf(buffer,"%d %s", item->index, item->prop->get_string().get_buffer());
 		if ( engine_send(engine,buffer,len+1)<=0 )
 			return false;
 	}
@@ -295,6 +364,9 @@ bool send_exports(ENGINELINK *engine)
 bool recv_imports(ENGINELINK *engine)
 {
 	SYNCDATA *item;
+
+	// objects whose values are not received keep the values they have
+	gather_views(engine->recv_view);
 	for ( item=engine->recv ; item!=NULL ; item=item->next )
 	{
 		char buffer[1500];
@@ -308,8 +380,9 @@ bool recv_imports(ENGINELINK *engine)
 		  return false;
 		if ( index>=0 && index<sync_index_size )
 		{
-			gld_property *prop = sync_index[index];
-			if ( prop->from_string(value)<=0 )
+			gld_property *prop = sync_index[index]->prop;
+			void *addr = sync_index[index]->value;
+			if ( (addr!=NULL ? callback->convert.string_to_property(prop->get_property(),addr,value) : prop->from_string(value))<=0 )
 			{
 				gl_warning("unable to read import value '%s' for %s.%s", prop->get_object()->name, prop->get_property()->name);
 				true;
@@ -318,9 +391,13 @@ bool recv_imports(ENGINELINK *engine)
 		else
 		{
 			gl_warning("recv_imports index value %d is invalid", index);
-			return true;
+			break;
 		}
 	}
+
+	// copy the values received into the objects
+	for ( SYNCVIEW *view=engine->recv_view ; view!=NULL ; view=view->next )
+		view->view->scatter(view->obj,view->n_objects,&(view->column),1);
 	return true;
 }
 
@@ -329,6 +406,7 @@ SYNCDATA *add_property(SYNCDATA *list, unsigned int index, gld_property *prop)
 	SYNCDATA *data = new SYNCDATA;
 	data->index = index;
 	data->prop = prop;
+	data->value = NULL;
 	data->next = list;
 	return data;
 }
@@ -477,12 +555,16 @@ EXPORT bool glx_init(glxlink *mod)
 	// index send/recv lists
 	SYNCDATA *data;
 	sync_index_size = index;
-	sync_index = new gld_property*[sync_index_size];
-	memset(sync_index,0,sizeof(gld_property*)*sync_index_size);
+	sync_index = new SYNCDATA*[sync_index_size];
+	memset(sync_index,0,sizeof(SYNCDATA*)*sync_index_size);
 	for ( data=engine->send ; data!=NULL ; data=data->next )
-		sync_index[data->index] = data->prop;
+		sync_index[data->index] = data;
 	for ( data=engine->recv ; data!=NULL ; data=data->next )
-		sync_index[data->index] = data->prop;
+		sync_index[data->index] = data;
+
+	// view the object properties exchanged
+	engine->send_view = make_views(engine->send,false);
+	engine->recv_view = make_views(engine->recv,true);
 
 	return true;
 }
@@ -40,9 +40,21 @@ TCP code is not yet stable.
 typedef struct s_syncdata {
 	unsigned int index;
 	gld_property *prop;
+	void *value; // the value in the column of a sync view, NULL if the value is accessed in the object
 	struct s_syncdata *next;
 } SYNCDATA;
 
+// property view of the exported or imported objects of a class that share a property
+typedef struct s_syncview {
+	CLASS *oclass;
+	PROPERTY *prop;
+	gld_propview *view;
+	size_t n_objects;
+	OBJECT **obj;
+	void *column;
+	struct s_syncview *next;
+} SYNCVIEW;
+
 typedef enum {TCP=1, UDP} SOCKET_TYPE;
 
 typedef struct s_socket_data{
@@ -63,6 +75,8 @@ typedef struct s_enginelink {
 	unsigned int cachesize;
 	SYNCDATA *send;
 	SYNCDATA *recv;
+	SYNCVIEW *send_view;
+	SYNCVIEW *recv_view;
 } ENGINELINK;
 
 //General debug functions
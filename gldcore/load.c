@@ -30,6 +30,17 @@
 
 	@todo Regular expressions using \p ${varname/from/to} and \p ${varname//from/to}.
 
+	@par Concurrent includes
+	When the global \p loadthreads is more than 1, the objects of \p #include files
+	are parsed concurrently.  The object blocks of each file are queued as a batch,
+	and the queue is parsed by \p loadthreads threads when anything else is read
+	(another statement, or a macro other than \p #include and the conditionals).
+	The objects of a batch get their ids, random states and place in the object
+	list when the batch is committed, which is always in include order, so the
+	model is the same as when it is loaded serially.  Objects of classes without
+	the \p PC_CONCURRENT_LOAD flag, and values that refer to other objects or draw
+	random numbers, wait for the batches before them to be committed.
+
 	@par Macros
 	The "#" character at the beginning of a line followed by a non-white character
 	will cause the word that follows to be treated as a macro.  When a "#" is followed
@@ -177,6 +188,7 @@ typedef struct stat STAT;
 #include "complex.h"
 #include "object.h"
 #include "load.h"
+#include "load_bin.h"
 #include "output.h"
 #include "random.h"
 #include "convert.h"
@@ -185,10 +197,12 @@ typedef struct stat STAT;
 #include "instance.h"
 #include "linkage.h"
 #include "gui.h"
+#include "slab.h"
+#include "propview.h"
 
-static unsigned int linenum=1;
+static THREADLOCAL unsigned int linenum=1;
 static int include_fail = 0;
-static char filename[1024];
+static THREADLOCAL char filename[1024];
 static time_t modtime = 0;
 static int last_good_depth = -1;
 static int current_depth = -1;
@@ -198,7 +212,7 @@ static char stop_ts[64];
 
 static char *format_object(OBJECT *obj)
 {
-	static char256 buffer;
+	static THREADLOCAL char256 buffer;
 	strcpy(buffer,"(unidentified)");
 	if (obj->name==NULL)
 		sprintf(buffer,global_object_format,obj->oclass->name,obj->id);
@@ -306,8 +320,10 @@ void inline_code_term(void)
 #define FN_FINALIZE		0x0800
 #define FN_EXPORT		0x1000
 
+/* the block buffer starts at this size and doubles whenever a block doesn't fit */
+#define BLOCKSIZE 20480
+
 /* used for tracking #include directives in files */
-#define BUFFERSIZE (65536*1000)
 typedef struct s_include_list {
 	char file[256];
 	struct s_include_list *next;
@@ -973,6 +989,7 @@ static void free_index(void)
 }
 
 static UNRESOLVED *first_unresolved = NULL;
+static THREADLOCAL UNRESOLVED **unresolved = &first_unresolved; /* the list this thread adds to */
 /*static*/ UNRESOLVED *add_unresolved(OBJECT *by, PROPERTYTYPE ptype, void *ref, CLASS *oclass, char *id, char *file, unsigned int line, int flags)
 {
 	UNRESOLVED *item;
@@ -988,10 +1005,10 @@ static UNRESOLVED *first_unresolved = NULL;
 	item->ref = ref;
 	item->oclass = oclass;
 	strncpy(item->id,id,sizeof(item->id));
-	if (first_unresolved!=NULL && strcmp(first_unresolved->file,file)==0)
+	if (*unresolved!=NULL && strcmp((*unresolved)->file,file)==0)
 	{
-		item->file = first_unresolved->file; // means keep using the same file
-		first_unresolved->file = NULL;
+		item->file = (*unresolved)->file; // means keep using the same file
+		(*unresolved)->file = NULL;
 	}
 	else
 	{
@@ -999,9 +1016,9 @@ static UNRESOLVED *first_unresolved = NULL;
 		strcpy(item->file,file);
 	}
 	item->line = line;
-	item->next = first_unresolved;
+	item->next = *unresolved;
 	item->flags = flags;
-	first_unresolved = item;
+	*unresolved = item;
 	return item;
 }
 static int resolve_object(UNRESOLVED *item, char *filename)
@@ -1237,6 +1254,115 @@ static int resolve_list(UNRESOLVED *item)
 	return result;
 }
 
+/* Concurrent loading of included files
+
+	When the global loadthreads is more than 1, the object blocks read from the
+	model are queued instead of parsed, in batches of the consecutive blocks of
+	one file.  Reading anything else, or a macro other than #include and the
+	conditionals, flushes the queue first: loadthreads threads parse the batches
+	at once and the batches are committed in the order they were queued.
+	Committing a batch gives its objects their ids and random states, appends
+	them to the object list and adds their unresolved references to the list,
+	so the model is the same as a serial load would make.
+	
+	Anything that depends on the objects loaded before it (classes that do not
+	allow concurrent loading, transforms, childless parents, object references
+	in expressions, random values, object ids) first waits for the batches
+	before it to be committed and commits its own batch so far; the rest of that
+	batch is loaded as it would be serially.  Module code (create, notify and
+	load methods) and the unit list are only used by one thread at a time.
+ */
+typedef enum {
+	BS_PENDING, /* not parsed yet */
+	BS_DONE, /* parsed */
+	BS_FAILED /* parse failed */
+} BATCHSTATUS;
+typedef struct s_loadblock {
+	char *text; /* the block as read */
+	unsigned int line; /* the line on which it starts */
+	struct s_loadblock *next;
+} LOADBLOCK;
+typedef struct s_loadbatch {
+	char file[1024]; /* the file the blocks are from */
+	LOADBLOCK *first, *last; /* the blocks, in file order */
+	OBJECTBATCH objects; /* the objects created and not committed yet */
+	UNRESOLVED *unresolved; /* the unresolved references not committed yet, newest first */
+	BATCHSTATUS status;
+	bool front; /* the batches before it are committed and it now loads serially */
+	struct s_loadbatch *next;
+} LOADBATCH;
+static LOADBATCH *first_batch = NULL, *last_batch = NULL; /* the queue */
+static LOADBATCH *next_batch = NULL; /* the next batch to parse */
+static LOADBATCH *next_commit = NULL; /* the first batch not committed yet */
+static pthread_mutex_t batch_lock = PTHREAD_MUTEX_INITIALIZER; /* guards the loader state the threads share */
+static pthread_cond_t batch_commit_done = PTHREAD_COND_INITIALIZER; /* signals that next_commit moved */
+static THREADLOCAL LOADBATCH *current_batch = NULL; /* the batch this thread is parsing */
+static THREADLOCAL bool batch_locked = false; /* this thread holds the batch lock */
+
+/* takes turns with the other batch threads (only while parsing a batch) */
+static void batch_enter(void)
+{
+	if ( current_batch!=NULL )
+	{
+		pthread_mutex_lock(&batch_lock);
+		batch_locked = true;
+	}
+}
+static void batch_leave(void)
+{
+	if ( batch_locked )
+	{
+		batch_locked = false;
+		pthread_mutex_unlock(&batch_lock);
+	}
+}
+
+/* commits what a batch has parsed so far (the batch lock is held) */
+static void batch_commit(LOADBATCH *batch)
+{
+	UNRESOLVED *item;
+	object_commit_batch(&batch->objects);
+	if ( batch->unresolved!=NULL )
+	{
+		for ( item=batch->unresolved ; item->next!=NULL ; item=item->next ) {}
+		item->next = first_unresolved;
+		first_unresolved = batch->unresolved;
+		batch->unresolved = NULL;
+	}
+}
+
+/* waits until the batches before this one are committed, then commits this one
+   so far and loads the rest of it serially */
+static void load_sync(void)
+{
+	LOADBATCH *batch = current_batch;
+	if ( batch==NULL || batch->front )
+		return;
+	pthread_mutex_lock(&batch_lock);
+	while ( next_commit!=batch )
+		pthread_cond_wait(&batch_commit_done,&batch_lock);
+	batch_commit(batch);
+	batch->front = true;
+	object_set_batch(NULL);
+	unresolved = &first_unresolved;
+	pthread_mutex_unlock(&batch_lock);
+}
+
+/* objects of a class can be loaded out of order if the class allows it and all its
+   properties are plain values (the others have create functions that keep lists) */
+static bool load_concurrent(CLASS *oclass)
+{
+	PROPERTY *prop;
+	if ( (oclass->passconfig&PC_CONCURRENT_LOAD)==0 )
+		return false;
+	for ( prop=oclass->pmap; prop!=NULL; prop=(prop->next?prop->next:(prop->oclass->parent?prop->oclass->parent->pmap:NULL)))
+	{
+		if ( !propview_can_view(prop) )
+			return false;
+	}
+	return true;
+}
+
 #define PARSER char *_p
 #define START int _mm=0, _m=0, _n=0, _l=linenum;
 #define ACCEPT { _n+=_m; _p+=_m; _m=0; }
@@ -1369,6 +1495,7 @@ static int unitspec(PARSER, UNIT **unit)
 	START;
 	while (size>1 && isalpha(*_p) || isdigit(*_p) || *_p=='$' || *_p=='%' || *_p=='*' || *_p=='/' || *_p=='^') COPY(result);
 	result[_n]='\0';
+	batch_enter(); /* the unit list grows as units are derived */
 	TRY {
 		if ((*unit=unit_find(result))==NULL){
 			linenum=_l;
@@ -1382,6 +1509,7 @@ static int unitspec(PARSER, UNIT **unit)
 		_n = 0;
 	}
 	ENDCATCH
+	batch_leave();
 	DONE;
 }
 
@@ -1512,6 +1640,7 @@ static int functional_int(PARSER, int64 *value){
 		RANDOMTYPE rtype = random_type(fname);
 		int nargs = random_nargs(fname);
 		double a;
+		load_sync(); /* random values are drawn in load order */
 		if (rtype==RT_INVALID || nargs==0 || (WHITE,!LITERAL("(")))
 		{
 			output_message("%s(%d): %s is not a valid random distribution", filename,linenum,fname);
@@ -1679,6 +1808,7 @@ static int functional(PARSER, double *pValue)
 		RANDOMTYPE rtype = random_type(fname);
 		int nargs = random_nargs(fname);
 		double a;
+		load_sync(); /* random values are drawn in load order */
 		if (rtype==RT_INVALID || nargs==0 || (WHITE,!LITERAL("(")))
 		{
 			output_error_raw("%s(%d): %s is not a valid random distribution", filename,linenum,fname);
@@ -1985,7 +2115,9 @@ static int expression(PARSER, double *pValue, UNIT **unit, OBJECT *obj){
 			}
 		} else if ( TERM(name(HERE,oname,sizeof(oname))) && LITERAL(".") && TERM(name(HERE,tname,sizeof(tname))))
 		{
-			OBJECT *nobj = object_find_name(oname);
+			OBJECT *nobj;
+			load_sync(); /* the object must already exist */
+			nobj = object_find_name(oname);
 			if ( nobj == NULL )
 			{
 				output_error_raw("%s(%d): object not found (object must already exist): %s.%s", filename,linenum, oname, tname);
@@ -2039,6 +2171,7 @@ static int expression(PARSER, double *pValue, UNIT **unit, OBJECT *obj){
 			if(0 == strcmp(oname, "parent")){
 				otarg = obj->parent;
 			} else {
+				load_sync(); /* the object must already exist */
 				otarg = object_find_name(oname);
 			}
 			if(otarg == NULL){ // delayed checking
@@ -2493,8 +2626,8 @@ static int pathname(PARSER, char *path, int size)
 	{var} embeds the current value of the current object's variable <var>
 
  **/
-static OBJECT *current_object = NULL; /* context object */
-static MODULE *current_module = NULL; /* context module */
+static THREADLOCAL OBJECT *current_object = NULL; /* context object */
+static THREADLOCAL MODULE *current_module = NULL; /* context module */
 static int expanded_value(char *text, char *result, int size, char *delims)
 {
 	int n=0;
@@ -2561,6 +2694,7 @@ static int expanded_value(char *text, char *result, int size, char *delims)
 					strcpy(value,"6267"); /* @todo copy actual master port */
 				else if (strcmp(varname,"id")==0)
 				{
+					load_sync(); /* ids are given in load order */
 					if (current_object)
 						sprintf(value,"%d",current_object->id);
 					else
@@ -3768,7 +3902,9 @@ static int property_ref(PARSER, TRANSFORMSOURCE *xstype, void **ref, OBJECT *fro
 	if WHITE ACCEPT;
 	if (TERM(name(HERE,oname,sizeof(oname))) && LITERAL(".") && TERM(dotted_name(HERE,pname,sizeof(pname))))
 	{
-		OBJECT *obj = (strcmp(oname,"this")==0 ? from : object_find_name(oname));
+		OBJECT *obj;
+		load_sync(); /* transforms are kept in load order */
+		obj = (strcmp(oname,"this")==0 ? from : object_find_name(oname));
 
 		// object isn't defined yet
 		if (obj==NULL)
@@ -3840,6 +3976,7 @@ static int transform_source(PARSER, TRANSFORMSOURCE *xstype, void **source, OBJE
 	if WHITE ACCEPT;
 	if (TERM(schedule_ref(HERE,&sch)))
 	{
+		load_sync(); /* transforms are kept in load order */
 		*source = (void*)&(sch->value);
 		*xstype = XS_SCHEDULE;
 		ACCEPT;
@@ -3968,6 +4105,16 @@ MODULE *load_get_current_module(void)
 {
 	return current_module;
 }
+/* sets a property from a string, which calls the notify functions of the module */
+static int load_set_value(OBJECT *obj, char *propname, char *value)
+{
+	int result;
+	batch_enter();
+	result = object_set_value_by_name(obj,propname,value);
+	batch_leave();
+	return result;
+}
+
 static int object_block(PARSER, OBJECT *parent, OBJECT **obj);
 static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 {
@@ -4004,7 +4151,11 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 		{
 			if ( TERM(value(HERE,propval,sizeof(propval))) )
 			{
-				if ( method->call(obj,propval)==1 )
+				int result;
+				batch_enter();
+				result = method->call(obj,propval);
+				batch_leave();
+				if ( result==1 )
 				{
 					ACCEPT;
 				}
@@ -4030,8 +4181,9 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 			if (prop!=NULL && prop->ptype==PT_object && TERM(object_block(HERE,NULL,&subobj)))
 			{
 				char objname[64];
+				if (subobj->name==NULL) load_sync(); /* the id is given in load order */
 				if (subobj->name) strcpy(objname,subobj->name); else sprintf(objname,"%s:%d", subobj->oclass->name,subobj->id);
-				if (object_set_value_by_name(obj,propname,objname))
+				if (load_set_value(obj,propname,objname))
 					ACCEPT
 				else
 				{
@@ -4046,6 +4198,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 					&& (WHITE,TERM(dashed_name(HERE,targetvalue,sizeof(targetvalue)))) )
 			{
 				OBJECT *target;
+				load_sync(); /* only the objects loaded before it are searched */
 				for ( target = object_get_first() ; target != NULL ; target = object_get_next(target) )
 				{
 					char value[1024];
@@ -4078,7 +4231,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 					output_error_raw("%s(%d): unable to get value of inherit property '%s'", filename, linenum, propname);
 					REJECT;
 				}
-				if ( object_set_value_by_name(obj,propname,value)<=0 )
+				if ( load_set_value(obj,propname,value)<=0 )
 				{
 					output_error_raw("%s(%d): unable to set value of inherit property '%s'", filename, linenum, propname);
 					REJECT;
@@ -4189,10 +4342,10 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				else if ( source!=NULL )
 				{
 					/* a transform is unresolved */
-					if (first_unresolved==source)
+					if (*unresolved==source)
 
 						/* source was the unresolved entry, for now it will be the transform itself */
-						first_unresolved->ref = (void*)transform_getnext(NULL);
+						(*unresolved)->ref = (void*)transform_getnext(NULL);
 
 					ACCEPT;
 				}
@@ -4204,6 +4357,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				int n = sscanf(sources,"%[^.].%[^,]",sobj,sprop);
 				OBJECT *source_obj;
 				PROPERTY *source_prop;
+				load_sync(); /* transforms are kept in load order */
 
 				/* get source object */
 				source_obj = (n==1||strcmp(sobj,"this")==0) ? obj : object_find_name(sobj);
@@ -4233,10 +4387,10 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				else if ( source!=NULL )
 				{
 					/* a transform is unresolved */
-					if (first_unresolved==source)
+					if (*unresolved==source)
 
 						/* source was the unresolved entry, for now it will be the transform itself */
-						first_unresolved->ref = (void*)transform_getnext(NULL);
+						(*unresolved)->ref = (void*)transform_getnext(NULL);
 
 					ACCEPT;
 				}
@@ -4248,6 +4402,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				int n = sscanf(sources,"%[^:]:%[^,]",sobj,sprop);
 				OBJECT *source_obj;
 				PROPERTY *source_prop;
+				load_sync(); /* transforms are kept in load order */
 
 				/* get source object */
 				source_obj = (n==1||strcmp(sobj,"this")==0) ? obj : object_find_name(sobj);
@@ -4277,10 +4432,10 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 				else if ( source!=NULL )
 				{
 					/* a transform is unresolved */
-					if (first_unresolved==source)
+					if (*unresolved==source)
 
 						/* source was the unresolved entry, for now it will be the transform itself */
-						first_unresolved->ref = (void*)transform_getnext(NULL);
+						(*unresolved)->ref = (void*)transform_getnext(NULL);
 
 					ACCEPT;
 				}
@@ -4403,7 +4558,7 @@ static int object_properties(PARSER, CLASS *oclass, OBJECT *obj)
 						ACCEPT;
 					}
 				}
-				else if (object_set_value_by_name(obj,propname,propval)==0)
+				else if (load_set_value(obj,propname,propval)==0)
 				{
 					output_error_raw("%s(%d): property %s of %s could not be set to '%s'", filename, linenum, propname, format_object(obj), propval);
 					REJECT;
@@ -4496,7 +4651,7 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 {
 #define NAMEOBJ  /* DPC: not sure what this does, but it doesn't seem to be harmful */
 #ifdef NAMEOBJ
-	static OBJECT nameobj;
+	OBJECT nameobj;
 #endif
 	FULLNAME space;
 	CLASSNAME classname;
@@ -4593,10 +4748,16 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 	nameobj.name = classname;
 #endif
 	if (id2==-1) id2=id+1; /* create singleton */
+	if ( current_batch!=NULL && !load_concurrent(oclass) )
+		load_sync();
+	batch_enter(); /* the create functions of modules are used by one thread at a time */
+	slab_reserve(oclass,(unsigned int)(id2-id)); /* keep the objects of a block together */
+	batch_leave();
 	BEGIN_REPEAT;
 	while (id<id2)
 	{
 		REPEAT;
+		batch_enter();
 		if (oclass->create!=NULL)
 		{
 #ifdef NAMEOBJ
@@ -4604,6 +4765,7 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 #endif
 			if ((*oclass->create)(&obj,parent)==0) 
 			{
+				batch_leave();
 				output_error_raw("%s(%d): create failed for object %s:%d", filename, linenum, classname, id);
 				REJECT;
 			}
@@ -4613,6 +4775,7 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 #endif
 				) 
 			{
+				batch_leave();
 				output_error_raw("%s(%d): create failed name object %s:%d", filename, linenum, classname, id);
 				REJECT;
 			}
@@ -4622,6 +4785,7 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 			obj = object_create_single(oclass);
 			if ( obj==NULL )
 			{
+				batch_leave();
 				output_error_raw("%s(%d): create failed for object %s:%d", filename, linenum, classname, id);
 				REJECT;
 			}
@@ -4629,10 +4793,12 @@ static int object_block(PARSER, OBJECT *parent, OBJECT **subobj)
 		}
 		if (id!=-1 && load_set_index(obj,(OBJECTNUM)id)==FAILED)
 		{
+			batch_leave();
 			output_error_raw("%s(%d): unable to index object id number for %s:%d", filename, linenum, classname, id);
 			REJECT;
 		}
-		else if TERM(object_properties(HERE,oclass,obj))
+		batch_leave();
+		if TERM(object_properties(HERE,oclass,obj))
 		{
 			ACCEPT;
 		} 
@@ -5861,6 +6027,250 @@ static int gridlabd_file(PARSER)
 	DONE;
 }
 
+/* a block can be queued if it holds only object blocks */
+static bool load_can_queue(char *text)
+{
+	char *p = text;
+	int depth;
+	bool quote;
+	while ( true )
+	{
+		while ( isspace((unsigned char)(*p)) || *p==';' )
+			p++;
+		if ( *p=='\0' )
+			return p!=text;
+		if ( strncmp(p,"object",6)!=0 || !isspace((unsigned char)(p[6])) )
+			return false;
+		for ( depth=0, quote=false ; *p!='\0' ; p++ )
+		{
+			if ( quote )
+				quote = ( *p!='"' );
+			else if ( *p=='"' )
+				quote = true;
+			else if ( *p=='@' && p[-1]=='\n' ) /* a line spec changes the file */
+				return false;
+			else if ( *p=='{' )
+				depth++;
+			else if ( *p=='}' && --depth==0 )
+				break;
+		}
+		if ( *p=='\0' )
+			return false;
+		p++;
+	}
+}
+
+/* a block of line specs and white space changes only the file and line of the parser */
+static bool load_is_linespec(char *text)
+{
+	char *p;
+	for ( p=text ; *p!='\0' ; p++ )
+	{
+		if ( *p=='@' && (p==text || p[-1]=='\n') )
+		{
+			if ( (p=strchr(p,'\n'))==NULL )
+				break;
+		}
+		else if ( !isspace((unsigned char)(*p)) && *p!=';' )
+			return false;
+	}
+	return true;
+}
+
+/* commits what a batch thread parsed and any batches after it that are done */
+static void load_batch_done(LOADBATCH *batch, BATCHSTATUS status)
+{
+	pthread_mutex_lock(&batch_lock);
+	batch->status = status;
+	while ( next_commit!=NULL && next_commit->status!=BS_PENDING )
+	{
+		batch_commit(next_commit);
+		next_commit = next_commit->next;
+	}
+	pthread_cond_broadcast(&batch_commit_done);
+	pthread_mutex_unlock(&batch_lock);
+}
+
+/* parses the blocks of a batch */
+static void load_batch(LOADBATCH *batch)
+{
+	LOADBLOCK *block;
+	BATCHSTATUS status = BS_DONE;
+	current_batch = batch;
+	object_set_batch(&batch->objects);
+	unresolved = &batch->unresolved;
+	TRY {
+		for ( block=batch->first ; block!=NULL && status==BS_DONE ; block=block->next )
+		{
+			char *p = block->text;
+			int move;
+			strcpy(filename,batch->file);
+			linenum = block->line;
+			while ( *p!='\0' && (move=gridlabd_file(p))>0 )
+				p += move;
+			if ( *p!='\0' )
+			{
+				output_error_raw("%s(%d): load failed at or near '%.12s...'", filename, linenum, p);
+				status = BS_FAILED;
+			}
+		}
+	}
+	CATCH (char *msg) {
+		batch_leave();
+		output_error_raw("%s(%d): %s", filename, linenum, msg);
+		status = BS_FAILED;
+	}
+	ENDCATCH;
+	object_set_batch(NULL);
+	unresolved = &first_unresolved;
+	current_batch = NULL;
+	load_batch_done(batch,status);
+}
+
+/* parses the queued batches one after the other until none are left */
+static void *load_batchproc(void *arg)
+{
+	LOADBATCH *batch;
+	while ( true )
+	{
+		pthread_mutex_lock(&batch_lock);
+		batch = next_batch;
+		if ( batch!=NULL )
+			next_batch = batch->next;
+		pthread_mutex_unlock(&batch_lock);
+		if ( batch==NULL )
+			break;
+		load_batch(batch);
+	}
+	return NULL;
+}
+
+/** Parses the queued object blocks in loadthreads threads and commits them in queue order
+	@return SUCCESS, or FAILED if a block could not be parsed
+ **/
+static STATUS load_flush(void)
+{
+	LOADBATCH *batch, *next;
+	LOADBLOCK *block, *next_block;
+	pthread_t *thread;
+	unsigned int n, n_batches = 0, n_threads, n_started;
+	char file[1024];
+	unsigned int line = linenum;
+	OBJECT *obj = current_object;
+	MODULE *mod = current_module;
+	STATUS status = SUCCESS;
+
+	if ( first_batch==NULL )
+		return SUCCESS;
+	strcpy(file,filename);
+
+	/* the caller parses batches too */
+	for ( batch=first_batch ; batch!=NULL ; batch=batch->next )
+		n_batches++;
+	n_threads = (unsigned int)global_loadthreads<n_batches ? (unsigned int)global_loadthreads : n_batches;
+	next_batch = next_commit = first_batch;
+	thread = (pthread_t*)malloc(sizeof(pthread_t)*n_threads);
+	for ( n=1 ; thread!=NULL && n<n_threads ; n++ )
+	{
+		if ( pthread_create(&thread[n],NULL,load_batchproc,NULL)!=0 )
+			break;
+	}
+	n_started = n;
+	load_batchproc(NULL);
+	for ( n=1 ; n<n_started ; n++ )
+		pthread_join(thread[n],NULL);
+	free(thread);
+	output_verbose("%d batch%s of included objects loaded by %d thread%s", n_batches, n_batches>1?"es":"", n_started, n_started>1?"s":"");
+
+	/* done with the queue */
+	for ( batch=first_batch ; batch!=NULL ; batch=next )
+	{
+		if ( batch->status!=BS_DONE )
+			status = FAILED;
+		for ( block=batch->first ; block!=NULL ; block=next_block )
+		{
+			next_block = block->next;
+			free(block->text);
+			free(block);
+		}
+		next = batch->next;
+		free(batch);
+	}
+	first_batch = last_batch = next_batch = next_commit = NULL;
+
+	/* restore the context of the caller */
+	strcpy(filename,file);
+	linenum = line;
+	current_object = obj;
+	current_module = mod;
+	return status;
+}
+
+/** Queues an object block to be parsed with the other blocks of its file when
+	loadthreads is more than 1, or flushes the queue before anything else is parsed
+	@return 1 if the block is queued, 0 if it is to be parsed now, or -1 if the flush failed
+ **/
+static int load_queue(char *text)
+{
+	LOADBLOCK *block;
+	char *p;
+
+	if ( load_is_linespec(text) )
+		return 0;
+	if ( global_loadthreads<2 || !load_can_queue(text) )
+		return load_flush()==SUCCESS ? 0 : -1;
+
+	block = (LOADBLOCK*)malloc(sizeof(LOADBLOCK));
+	if ( block==NULL || (block->text=(char*)malloc(strlen(text)+1))==NULL )
+	{
+		free(block);
+		return load_flush()==SUCCESS ? 0 : -1;
+	}
+	strcpy(block->text,text);
+	block->line = linenum;
+	block->next = NULL;
+
+	/* consecutive blocks of a file make a batch */
+	if ( last_batch==NULL || strcmp(last_batch->file,filename)!=0 )
+	{
+		LOADBATCH *batch = (LOADBATCH*)malloc(sizeof(LOADBATCH));
+		if ( batch==NULL )
+		{
+			free(block->text);
+			free(block);
+			return load_flush()==SUCCESS ? 0 : -1;
+		}
+		memset(batch,0,sizeof(LOADBATCH));
+		strcpy(batch->file,filename);
+		if ( last_batch==NULL )
+			first_batch = batch;
+		else
+			last_batch->next = batch;
+		last_batch = batch;
+	}
+	if ( last_batch->last==NULL )
+		last_batch->first = block;
+	else
+		last_batch->last->next = block;
+	last_batch->last = block;
+
+	/* count the lines as the parser would */
+	for ( p=text ; *p!='\0' ; p++ )
+	{
+		if ( *p=='\n' )
+			linenum++;
+	}
+	return 1;
+}
+
+/* macros that do not need the queued objects loaded first */
+static bool load_macro_queues(char *line)
+{
+	char *macro = line+strlen(MACRO);
+	return strncmp(macro,"include",7)==0 || strncmp(macro,"if",2)==0 
+		|| strncmp(macro,"else",4)==0 || strncmp(macro,"endif",5)==0;
+}
+
 int replace_variables(char *to,char *from,int len,int warn)
 {
 	char *p, *e=from;
@@ -5921,79 +6331,42 @@ static int suppress = 0;
 static int nesting = 0;
 static int macro_line[64];
 static int process_macro(char *line, int size, char *filename, int linenum);
-static int buffer_read(FILE *fp, char *buffer, char *filename, int size)
+/** Makes room in a block buffer
+	@return the buffer, or NULL if it could not grow
+ **/
+static char *buffer_reserve(char **buffer, int *size, int need)
 {
-	char line[65536];
-	int n=0;
-	int linenum=0;
-	int startnest = nesting;
-	while (fgets(line,sizeof(line),fp)!=NULL)
-	{
-		int len;
-		char subst[65536];
-
-		/* comments must have preceding whitespace in macros */
-		char *c = line[0]!='#'?strstr(line,COMMENT):strstr(line, " " COMMENT);
-		linenum++;
-		if (c!=NULL) /* truncate at comment */
-			strcpy(c,"\n");
-		len = (int)strlen(line);
-		if (len>=size-1)
-			return 0;
-
-	
-#ifndef OLDSTYLE
-		/* check for oldstyle file under newstyle parse */
-		if (linenum==1 && strncmp(line,"# ",2)==0)
-		{
-			output_error("%s looks like a version 1.x GLM files, please convert this file to new style before loading", filename);
-			return 0;
-		}
-#endif
-		/* expand variables */
-		if ((len=replace_variables(subst,line,sizeof(subst),suppress==0))>=0)
-			strcpy(line,subst);
-		else
-		{
-			output_error_raw("%s(%d): unable to continue", filename,linenum);
-			return -1;
-		}
-
-		/* expand macros */
-		if (strncmp(line,MACRO,strlen(MACRO))==0)
-		{
-			/* macro disables reading */
-			if (process_macro(line,sizeof(line),filename,linenum)==FALSE)
-				return 0;
-			len = (int)strlen(line);
-			strcat(buffer,line);
-			buffer += len;
-			size -= len;
-			n += len;
-		}
-
-		/* if reading is enabled */
-		else if (suppress==0)
-		{
-			strcpy(buffer,subst);
-			buffer+=len;
-			size -= len;
-			n+=len;
+	if (need>*size)
+	{
+		int newsize = *size>0 ? *size : BLOCKSIZE;
+		char *data;
+		while (newsize<need)
+			newsize *= 2;
+		data = (char*)realloc(*buffer,newsize);
+		if (data==NULL)
+		{
+			output_error("load.c: unable to grow the block buffer to %d bytes", newsize);
+			/*	TROUBLESHOOT
+				The loader holds one top-level block of a file (an object with all its children, 
+				a class with its code, and so on) in memory at a time.  A block in the model is 
+				too large to fit in the memory available.  Split it into smaller blocks, 
+				or free up system memory and try again.
+			 */
+			return NULL;
 		}
+		*buffer = data;
+		*size = newsize;
 	}
-	if (nesting != startnest)
-	{
-		//output_message("%s(%d): missing %sendif for #if at %s(%d)", filename,linenum,MACRO,filename,macro_line[nesting-1]);
-		output_error_raw("%s(%d): Unbalanced %sif/%sendif at %s(%d) ~ started with nestlevel %i, ending %i", filename,linenum,MACRO,MACRO,filename,macro_line[nesting-1], startnest, nesting);
-		return -1;
-	}
-	return n;
+	return *buffer;
 }
 
-static int buffer_read_alt(FILE *fp, char *buffer, char *filename, int size)
+/** Reads the next top-level block of a file into the block buffer, growing it as needed
+	Memory use depends on the size of the largest block, not on the size of the file.
+	@return the number of characters read, 0 at the end of the file, -1 on error
+ **/
+static int buffer_read_alt(FILE *fp, char **buffer, int *size, char *filename)
 {
 	char line[10240];
-	char *buf = buffer;
 	int n = 0, i = 0;
 	int _linenum=0;
 	int startnest = nesting;
@@ -6010,14 +6383,6 @@ static int buffer_read_alt(FILE *fp, char *buffer, char *filename, int size)
 		_linenum++;
 		if (c!=NULL) /* truncate at comment */
 			strcpy(c,"\n");
-		len = (int)strlen(line);
-		if (len>=size-1){
-			output_error("load.c: buffer exhaustion reading %i lines past line %i", _linenum, linenum);
-			if(quote != 0){
-				output_error("look for an unterminated doublequote string on line %i", quoteline);
-			}
-			return 0;
-		}
 	
 #ifndef OLDSTYLE
 		/* check for oldstyle file under newstyle parse */
@@ -6028,37 +6393,37 @@ static int buffer_read_alt(FILE *fp, char *buffer, char *filename, int size)
 		}
 #endif
 		/* expand variables */
-		if ((len=replace_variables(subst,line,sizeof(subst),suppress==0))>=0)
-			strcpy(line,subst);
-		else
+		if ((len=replace_variables(subst,line,sizeof(subst),suppress==0))<0)
 		{
 			output_error_raw("%s(%d): unable to continue", filename,_linenum);
 			return -1;
 		}
 
 		/* expand macros */
-		if (strncmp(line,MACRO,strlen(MACRO))==0)
+		if (strncmp(subst,MACRO,strlen(MACRO))==0)
 		{
 			/* macro disables reading */
+			strcpy(line,subst);
+			if ( !load_macro_queues(line) && load_flush()==FAILED )
+				return -1;
 			if (process_macro(line,sizeof(line),filename,linenum + _linenum - 1)==FALSE){
 				return 0;
 			} else {
 				++hassc;
 			}
-			//strcat(buffer,line);
-			strcpy(buffer,line);
-			len = (int)strlen(buffer); // include anything else in the buffer, then advance
-			buffer += len;
-			size -= len;
+			len = (int)strlen(line); // include anything else in the line, then advance
+			if (buffer_reserve(buffer,size,n+len+1)==NULL)
+				return -1;
+			memcpy(*buffer+n,line,len+1);
 			n += len;
 		}
 
 		/* if reading is enabled */
 		else if (suppress==0)
 		{
-			strcpy(buffer,subst);
-			buffer+=len;
-			size -= len;
+			if (buffer_reserve(buffer,size,n+len+1)==NULL)
+				return -1;
+			memcpy(*buffer+n,subst,len+1);
 			n+=len;
 			for(i = 0; i < len; ++i){
 				if(quote == 0){
@@ -6082,9 +6447,9 @@ static int buffer_read_alt(FILE *fp, char *buffer, char *filename, int size)
 				}
 			}
 		} else {
-			strcpy(buffer,"\n");
-			buffer+=strlen("\n");
-			size -= 1;
+			if (buffer_reserve(buffer,size,n+2)==NULL)
+				return -1;
+			strcpy(*buffer+n,"\n");
 			n += 1;
 		}
 		if(bnest == 0 && hassc > 0 && nesting == startnest){ // make sure we read ALL of an #if block, if possible
@@ -6119,7 +6484,8 @@ static int include_file(char *incname, char *buffer, int size, int _linenum)
 	STAT stat;
 	char ff[1024];
 	FILE *fp = 0;
-	char buffer2[20480];
+	char *buffer2 = NULL;
+	int size2 = 0;
 	unsigned int old_linenum = _linenum;
 	/* check include list */
 	INCLUDELIST *list;
@@ -6128,8 +6494,6 @@ static int include_file(char *incname, char *buffer, int size, int _linenum)
 	strcpy(this->file, incname);
 	this->next = include_list;
 
-	buffer2[0]=0;
-	
 	for (list = include_list; list != NULL; list = list->next)
 	{
 		if (strcmp(incname, list->file) == 0 && !global_reinclude )
@@ -6199,12 +6563,20 @@ static int include_file(char *incname, char *buffer, int size, int _linenum)
 
 	/* reset line counter for parser */
 	include_list = this;
-	//count = buffer_read(fp,buffer,incname,size); // fread(buffer,1,stat.st_size,fp);
 
-	move = buffer_read_alt(fp, buffer2, incname, 20479);
+	move = buffer_read_alt(fp, &buffer2, &size2, incname);
 	while(move > 0){
+		int queued;
 		count += move;
 		p = buffer2; // grab a block
+		queued = load_queue(p);
+		if ( queued<0 )
+		{
+			count = -1;
+			break;
+		}
+		else if ( queued>0 )
+			p += strlen(p); // parsed when the queue is flushed
 		while(*p != 0){
 			// and process it
 			move = gridlabd_file(p);
@@ -6217,8 +6589,13 @@ static int include_file(char *incname, char *buffer, int size, int _linenum)
 			count = -1;
 			break;
 		}
-		move = buffer_read_alt(fp, buffer2, incname, 20479);
+		move = buffer_read_alt(fp, &buffer2, &size2, incname);
 	}
+	if(move < 0){
+		count = -1;
+	}
+	free(buffer2);
+	fclose(fp);
 
 	//include_list = this.next;
 
@@ -6960,97 +7337,13 @@ static int process_macro(char *line, int size, char *_filename, int linenum)
 	return FALSE;
 }
 
-STATUS loadall_glm(char *file) /**< a pointer to the first character in the file name string */
-{
-	OBJECT *obj, *first = object_get_first();
-	char *buffer = NULL, *p = NULL;
-	int fsize = 0;
-	STATUS status=FAILED;
-	STAT stat;
-	char *ext = strrchr(file,'.');
-	FILE *fp;
-	int move=0;
-	errno = 0;
-
-	fp = fopen(file,"rt");
-	if (fp==NULL)
-		goto Failed;
-	if (FSTAT(fileno(fp),&stat)==0)
-	{
-		modtime = stat.st_mtime;
-		fsize = stat.st_size;
-		buffer = malloc(BUFFERSIZE); /* lots of space */
-	}
-	output_verbose("file '%s' is %d bytes long", file,fsize);
-	if (buffer==NULL)
-	{
-		output_error("unable to allocate buffer for file '%s': %s", file, errno?strerror(errno):"(no details)");
-		errno = ENOMEM;
-		goto Done;
-	}
-	else
-		p=buffer;
-
-	buffer[0] = '\0';
-	if (buffer_read(fp,buffer,file,BUFFERSIZE)==0)
-	{
-		fclose(fp);
-		goto Failed;
-	}
-	fclose(fp);
-
-	/* reset line counter for parser */
-	linenum = 1;
-	while (*p!='\0')
-	{
-		move = gridlabd_file(p);
-		if (move==0)
-			break;
-		p+=move;
-	}
-	status = (*p=='\0') ? SUCCESS : FAILED;
-	if (status==FAILED)
-	{
-		char *eol = strchr(p,'\n');
-		if (eol!=NULL)
-			*eol='\0';
-		output_error_raw("%s(%d): load failed at or near '%.12s...'", file, linenum,*p=='\0'?"end of line":p);
-		if (p==0)
-			output_error("%s doesn't appear to be a GLM file", file);
-		goto Failed;
-	}
-	else if ((status=load_resolve_all())==FAILED)
-		goto Failed;
-
-	/* establish ranks */
-	for (obj=first?first:object_get_first(); obj!=NULL; obj=obj->next)
-		object_set_parent(obj,obj->parent);
-	output_verbose("%d object%s loaded", object_get_count(), object_get_count()>1?"s":"");
-	goto Done;
-Failed:
-	if (errno!=0){
-		output_error("unable to load '%s': %s", file, errno?strerror(errno):"(no details)");
-		/*	TROUBLESHOOT
-			In most cases, strerror(errno) will claim "No such file or directory".  This claim should be ignored in
-			favor of prior error messages.
-		*/
-	}
-Done:
-	free(buffer);
-	buffer = NULL;
-	free_index();
-	linenum=1; // parser starts at 1
-	return status;
-}
-
 /**/
 STATUS loadall_glm_roll(char *file) /**< a pointer to the first character in the file name string */
 {
 	OBJECT *obj, *first = object_get_first();
-	//char *buffer = NULL, *p = NULL;
-	char *p = NULL;
-	char buffer[20480];
-	int fsize = 0;
+	char *buffer = NULL, *p = NULL;
+	int size = 0, pos = -1; /* offset of the parser in the block buffer, which moves when it grows */
+	int64 fsize = 0;
 	STATUS status=FAILED;
 	STAT stat;
 	char *ext = strrchr(file,'.');
@@ -7068,31 +7361,43 @@ STATUS loadall_glm_roll(char *file) /**< a pointer to the first character in the
 	}
 	if(fsize <= 1){
 		// empty file short circuit
+		fclose(fp);
 		return SUCCESS;
 	}
-	output_verbose("file '%s' is %d bytes long", file,fsize);
-	/* removed malloc check since it doesn't malloc any more */
-	buffer[0] = '\0';
+	output_verbose("file '%s' is %" FMT_INT64 "d bytes long", file,fsize);
 
-	move = buffer_read_alt(fp, buffer, file, 20479);
+	/* the file is read and parsed one top-level block at a time */
+	move = buffer_read_alt(fp, &buffer, &size, file);
 	while(move > 0){
-		p = buffer; // grab a block
-		while(*p != 0){
+		int queued;
+		pos = 0; // grab a block
+		queued = load_queue(buffer);
+		if ( queued<0 )
+		{
+			move = -1;
+			break;
+		}
+		else if ( queued>0 )
+			pos = (int)strlen(buffer); // parsed when the queue is flushed
+		while(buffer[pos] != 0){
 			// and process it
-			move = gridlabd_file(p);
+			move = gridlabd_file(buffer+pos);
 			if(move == 0)
 				break;
-			p += move;
+			pos += move;
 		}
-		if(*p != 0){
+		if(buffer[pos] != 0){
 			// failed if we didn't parse the whole thing
 			status = FAILED;
 			break;
 		}
-		move = buffer_read_alt(fp, buffer, file, 20479);
+		move = buffer_read_alt(fp, &buffer, &size, file);
 	}
+	if ( load_flush()==FAILED ) /* parse what is still queued */
+		move = -1;
+	p = pos>=0 ? buffer+pos : NULL;
 
-	if(p != 0){ /* did the file contain anything? */
+	if(p != 0 && move >= 0){ /* did the file contain anything, and was all of it read? */
 		status = (*p=='\0' && !include_fail) ? SUCCESS : FAILED;
 	} else {
 		status = FAILED;
@@ -7130,7 +7435,7 @@ Failed:
 		*/
 	}
 Done:
-	//free(buffer);
+	free(buffer);
 	free_index();
 	linenum=1; // parser starts at one
 	if (fp!=NULL) fclose(fp);
@@ -7233,8 +7538,7 @@ STATUS loadall(char *file){
 	/* load the appropriate type of file */
 	if (global_streaming_io_enabled || (ext!=NULL && isdigit(ext[1])) )
 	{
-		FILE *fp = fopen(file,"rb");
-		if (fp==NULL || stream(fp,SF_IN)<0)
+		if (stream_restore(file)==FAILED)
 		{
 			output_error("%s: unable to read stream", file);
 			return FAILED;
@@ -7244,6 +7548,8 @@ STATUS loadall(char *file){
 	}
 	else if (ext==NULL || strcmp(ext, ".glm")==0)
 		load_status = loadall_glm_roll(filename);
+	else if (strcmp(ext, ".gbm")==0)
+		load_status = loadall_bin(filename);
 #ifdef HAVE_XERCES
 	else if(strcmp(ext, ".xml")==0)
 		load_status = loadall_xml(filename);
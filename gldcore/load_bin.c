@@ -0,0 +1,957 @@
+/** $Id: load_bin.c
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file load_bin.c
+	@addtogroup load_bin
+	@ingroup core
+
+	Loads and saves binary model files (see load_bin.h for the layout).
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "platform.h"
+#include "output.h"
+#include "globals.h"
+#include "module.h"
+#include "class.h"
+#include "object.h"
+#include "property.h"
+#include "convert.h"
+#include "timestamp.h"
+#include "transform.h"
+#include "slab.h"
+
+#include "load_bin.h"
+
+#define GBM_NONE 0xffffffff	/* string length of a value that is not given */
+
+/* object header fields that can be saved as columns */
+typedef enum {
+	HF_NAME,
+	HF_PARENT,
+	HF_GROUPID,
+	HF_CLOCK,
+	HF_LATITUDE,
+	HF_LONGITUDE,
+	HF_INSVC,
+	HF_OUTSVC,
+	HF_HEARTBEAT,
+	HF_FLAGS,
+	HF_SCHEDULESKEW,
+	_HF_LAST
+} HEADERFIELD;
+
+static struct {
+	char *name;
+	PROPERTYTYPE ptype;
+	uint32 encoding; /* encoding used when saving */
+} header_field[_HF_LAST] = {
+	{"name",		PT_char256,		GBM_TEXT},
+	{"parent",		PT_object,		GBM_REF},
+	{"groupid",		PT_char32,		GBM_TEXT},
+	{"clock",		PT_timestamp,	GBM_RAW},
+	{"latitude",	PT_double,		GBM_RAW},
+	{"longitude",	PT_double,		GBM_RAW},
+	{"in_svc",		PT_timestamp,	GBM_RAW},
+	{"out_svc",		PT_timestamp,	GBM_RAW},
+	{"heartbeat",	PT_timestamp,	GBM_RAW},
+	{"flags",		PT_set,			GBM_RAW},
+	{"schedule_skew",	PT_int64,	GBM_RAW},
+};
+
+/* storage width of a property, including all the elements of arrayed properties */
+static uint32 property_width(PROPERTY *prop)
+{
+	return property_size(prop) * (prop->size>0 ? prop->size : 1);
+}
+
+/* encoding used to save a property, GBM_NONE if it is not saved */
+static uint32 property_encoding(PROPERTY *prop)
+{
+	if ( prop->access!=PA_PUBLIC )
+		return GBM_NONE;
+	switch ( prop->ptype ) {
+	case PT_void:
+		return GBM_NONE;
+	case PT_object:
+		return GBM_REF;
+	case PT_double:
+	case PT_complex:
+	case PT_enumeration:
+	case PT_set:
+	case PT_int16:
+	case PT_int32:
+	case PT_int64:
+	case PT_bool:
+	case PT_timestamp:
+	case PT_real:
+	case PT_float:
+		return GBM_RAW;
+	default: /* strings are shorter as text, the others hold pointers */
+		return GBM_TEXT;
+	}
+}
+
+/* first property of a class, including the properties of its parent classes */
+static PROPERTY *first_property(CLASS *oclass)
+{
+	for ( ; oclass!=NULL ; oclass=oclass->parent )
+	{
+		if ( oclass->pmap!=NULL )
+			return oclass->pmap;
+	}
+	return NULL;
+}
+static PROPERTY *next_property(PROPERTY *prop)
+{
+	return prop->next ? prop->next : first_property(prop->oclass->parent);
+}
+
+/************************************************************************/
+/* SAVE */
+
+static size_t write_uint32(FILE *fp, uint32 value)
+{
+	return fwrite(&value,sizeof(value),1,fp)*sizeof(value);
+}
+static size_t write_int32(FILE *fp, int32 value)
+{
+	return fwrite(&value,sizeof(value),1,fp)*sizeof(value);
+}
+static size_t write_int64(FILE *fp, int64 value)
+{
+	return fwrite(&value,sizeof(value),1,fp)*sizeof(value);
+}
+static size_t write_string(FILE *fp, const char *value)
+{
+	uint32 len;
+	if ( value==NULL )
+		return write_uint32(fp,GBM_NONE);
+	len = (uint32)strlen(value);
+	return write_uint32(fp,len) + fwrite(value,1,len,fp);
+}
+static size_t write_column(FILE *fp, const char *name, uint32 scope, PROPERTYTYPE ptype, uint32 width, uint32 encoding)
+{
+	return write_string(fp,name) + write_uint32(fp,scope) + write_int32(fp,(int32)ptype)
+		+ write_uint32(fp,encoding==GBM_RAW?width:0) + write_uint32(fp,encoding);
+}
+
+/* object reference as an index in the object table */
+static int32 object_index(int32 *index, OBJECT *obj)
+{
+	return obj==NULL ? -1 : index[obj->id];
+}
+
+typedef struct s_saveclass {
+	CLASS *oclass;
+	uint32 n_objects;
+	uint32 n_listed;
+	OBJECT **obj;
+} SAVECLASS;
+
+/** Save the loaded model to the stream \p fp as a binary model file
+	@return the number of bytes written, 0 on error
+ **/
+int saveall_bin(char *filename, FILE *fp)
+{
+	size_t count = 0;
+	SAVECLASS *cls = NULL, *last = NULL;
+	uint32 n_classes = 0, n_modules = 0, n_globals = 0, n_objects = 0, max_classes = 0, i, n;
+	OBJECTNUM max_id = 0;
+	int32 *index = NULL;
+	MODULE *mod;
+	GLOBALVAR *var;
+	OBJECT *obj;
+	PROPERTY *prop;
+	char *tz = timestamp_current_timezone();
+	char *buffer = NULL;
+	size_t size = 65536;
+	int status = 0;
+
+	if ( transform_getnext(NULL)!=NULL )
+		output_warning("saveall_bin(): transforms are not saved in binary model '%s'", filename);
+		/*	TROUBLESHOOT
+			Binary model files only hold modules, objects and their property values.  The
+			transforms used by the model (property values given by schedules, players or
+			expressions) are not saved and will be missing when the file is loaded.  Save
+			the model as GLM to keep them.
+		 */
+
+	/* count the objects of each class */
+	for ( obj=object_get_first() ; obj!=NULL ; obj=obj->next )
+	{
+		if ( last==NULL || last->oclass!=obj->oclass )
+		{
+			for ( last=cls ; last<cls+n_classes && last->oclass!=obj->oclass ; last++ ) {}
+			if ( last==cls+n_classes )
+			{
+				if ( n_classes==max_classes )
+				{
+					SAVECLASS *more;
+					max_classes = max_classes>0 ? max_classes*2 : 32;
+					more = (SAVECLASS*)realloc(cls,sizeof(SAVECLASS)*max_classes);
+					if ( more==NULL )
+						goto Nomem;
+					cls = more;
+					last = cls+n_classes;
+				}
+				last->oclass = obj->oclass;
+				last->n_objects = 0;
+				last->n_listed = 0;
+				last->obj = NULL;
+				n_classes++;
+			}
+		}
+		last->n_objects++;
+		if ( obj->id>max_id )
+			max_id = obj->id;
+		n_objects++;
+	}
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		if ( (cls[i].obj=(OBJECT**)malloc(sizeof(OBJECT*)*cls[i].n_objects))==NULL )
+		{
+			while ( i-->0 ) free(cls[i].obj);
+			n_classes = 0;
+			goto Nomem;
+		}
+	}
+	index = (int32*)malloc(sizeof(int32)*(max_id+1));
+	buffer = (char*)malloc(size);
+	if ( index==NULL || buffer==NULL )
+		goto Nomem;
+
+	/* header */
+	for ( mod=module_get_first() ; mod!=NULL ; mod=mod->next )
+		n_modules++;
+	for ( var=global_getnext(NULL) ; var!=NULL ; var=global_getnext(var) )
+	{
+		if ( strstr(var->prop->name,"::")!=NULL && var->prop->access==PA_PUBLIC && global_getvar(var->prop->name,buffer,(int)size)!=NULL )
+			n_globals++;
+	}
+	count += fwrite(GBM_MAGIC,1,4,fp);
+	count += write_uint32(fp,GBM_VERSION);
+	count += write_uint32(fp,GBM_BYTEORDER);
+	count += write_string(fp,tz!=NULL?tz:"");
+	count += write_int64(fp,global_starttime);
+	count += write_int64(fp,global_stoptime);
+	count += write_uint32(fp,n_modules);
+	count += write_uint32(fp,n_globals);
+	count += write_uint32(fp,n_classes);
+	count += write_uint32(fp,n_objects);
+
+	/* module and global tables */
+	for ( mod=module_get_first() ; mod!=NULL ; mod=mod->next )
+		count += write_string(fp,mod->name);
+	for ( var=global_getnext(NULL) ; var!=NULL ; var=global_getnext(var) )
+	{
+		if ( strstr(var->prop->name,"::")!=NULL && var->prop->access==PA_PUBLIC && global_getvar(var->prop->name,buffer,(int)size)!=NULL )
+		{
+			count += write_string(fp,var->prop->name);
+			count += write_string(fp,buffer);
+		}
+	}
+
+	/* class table */
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		uint32 n_columns = _HF_LAST;
+		HEADERFIELD hf;
+		for ( prop=first_property(cls[i].oclass) ; prop!=NULL ; prop=next_property(prop) )
+		{
+			if ( property_encoding(prop)!=GBM_NONE )
+				n_columns++;
+		}
+		count += write_string(fp,cls[i].oclass->name);
+		count += write_uint32(fp,cls[i].n_objects);
+		count += write_uint32(fp,n_columns);
+		for ( hf=0 ; hf<_HF_LAST ; hf++ )
+			count += write_column(fp,header_field[hf].name,GBM_HEADER,header_field[hf].ptype,8,header_field[hf].encoding);
+		for ( prop=first_property(cls[i].oclass) ; prop!=NULL ; prop=next_property(prop) )
+		{
+			uint32 encoding = property_encoding(prop);
+			if ( encoding!=GBM_NONE )
+				count += write_column(fp,prop->name,GBM_PROPERTY,prop->ptype,property_width(prop),encoding);
+		}
+	}
+
+	/* object table */
+	last = NULL;
+	for ( obj=object_get_first(), n=0 ; obj!=NULL ; obj=obj->next, n++ )
+	{
+		if ( last==NULL || last->oclass!=obj->oclass )
+			for ( last=cls ; last->oclass!=obj->oclass ; last++ ) {}
+		last->obj[last->n_listed++] = obj;
+		index[obj->id] = (int32)n;
+		count += write_uint32(fp,(uint32)(last-cls));
+	}
+
+	/* class data */
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		OBJECT **list = cls[i].obj;
+		HEADERFIELD hf;
+		for ( hf=0 ; hf<_HF_LAST ; hf++ )
+		{
+			for ( n=0 ; n<cls[i].n_objects ; n++ )
+			{
+				obj = list[n];
+				switch ( hf ) {
+				case HF_NAME: count += write_string(fp,obj->name); break;
+				case HF_PARENT: count += write_int32(fp,object_index(index,obj->parent)); break;
+				case HF_GROUPID: count += write_string(fp,obj->groupid[0]!='\0'?obj->groupid:NULL); break;
+				case HF_CLOCK: count += write_int64(fp,obj->clock); break;
+				case HF_LATITUDE: count += fwrite(&obj->latitude,sizeof(double),1,fp)*sizeof(double); break;
+				case HF_LONGITUDE: count += fwrite(&obj->longitude,sizeof(double),1,fp)*sizeof(double); break;
+				case HF_INSVC: count += write_int64(fp,obj->in_svc); break;
+				case HF_OUTSVC: count += write_int64(fp,obj->out_svc); break;
+				case HF_HEARTBEAT: count += write_int64(fp,obj->heartbeat); break;
+				case HF_FLAGS: count += write_int64(fp,(int64)obj->flags); break;
+				case HF_SCHEDULESKEW: count += write_int64(fp,obj->schedule_skew); break;
+				default: break;
+				}
+			}
+		}
+		for ( prop=first_property(cls[i].oclass) ; prop!=NULL ; prop=next_property(prop) )
+		{
+			uint32 encoding = property_encoding(prop);
+			uint32 width = property_width(prop);
+			for ( n=0 ; n<cls[i].n_objects && encoding!=GBM_NONE ; n++ )
+			{
+				char *addr = (char*)(list[n]+1)+(int64)prop->addr;
+				if ( encoding==GBM_RAW )
+					count += fwrite(addr,1,width,fp);
+				else if ( encoding==GBM_REF )
+					count += write_int32(fp,object_index(index,*(OBJECT**)addr));
+				else if ( class_property_to_string(prop,addr,buffer,(int)size)>0 )
+					count += write_string(fp,buffer);
+				else
+					count += write_string(fp,NULL);
+			}
+		}
+	}
+
+	if ( ferror(fp) )
+	{
+		output_error("saveall_bin(): unable to write binary model '%s': %s", filename, strerror(errno));
+		/*	TROUBLESHOOT
+			The binary model file could not be written completely.  Check that the disk is not
+			full and that the file can be written and try again.
+		 */
+		goto Failed;
+	}
+	output_verbose("saved %d objects of %d classes to binary model '%s'", n_objects, n_classes, filename);
+	status = count>0 ? (int)count : 1;
+	goto Done;
+Nomem:
+	output_error("saveall_bin(): memory allocation failed");
+	/*	TROUBLESHOOT
+		The system ran out of memory while preparing the binary model file.  Free up memory
+		and try again.
+	 */
+Failed:
+	status = 0;
+Done:
+	for ( i=0 ; cls!=NULL && i<n_classes ; i++ )
+		free(cls[i].obj);
+	free(cls);
+	free(index);
+	free(buffer);
+	if ( fp!=stdout )
+		fclose(fp);
+	return status;
+}
+
+/************************************************************************/
+/* LOAD */
+
+typedef struct s_loadcolumn {
+	char name[64];
+	uint32 scope;
+	PROPERTYTYPE ptype;
+	uint32 width;
+	uint32 encoding;
+	PROPERTY *prop; /* class property (GBM_PROPERTY) */
+	HEADERFIELD field; /* header field (GBM_HEADER) */
+	int direct; /* raw values are copied into the object without conversion */
+	char *data; /* first value */
+	char *next; /* next text value */
+} LOADCOLUMN;
+
+typedef struct s_loadclass {
+	CLASS *oclass;
+	uint32 n_objects;
+	uint32 n_created;
+	OBJECT **obj;
+	uint32 n_columns;
+	LOADCOLUMN *column;
+} LOADCLASS;
+
+typedef struct s_reader {
+	char *filename;
+	char *start;
+	char *pos;
+	char *end;
+	char *text; /* null-terminated copy of the last string read */
+	uint32 size; /* size of the text buffer */
+} READER;
+
+static int read_fail(READER *rd)
+{
+	output_error("loadall_bin(): binary model '%s' is truncated at offset %d", rd->filename, (int)(rd->pos-rd->start));
+	/*	TROUBLESHOOT
+		The binary model file ends before all the values its tables declare.  The file is
+		either damaged or was not written completely.  Save the model again and retry.
+	 */
+	return 0;
+}
+static int read_data(READER *rd, void *data, size_t len)
+{
+	if ( (size_t)(rd->end-rd->pos)<len )
+		return read_fail(rd);
+	memcpy(data,rd->pos,len);
+	rd->pos += len;
+	return 1;
+}
+static int skip_data(READER *rd, size_t len)
+{
+	if ( (size_t)(rd->end-rd->pos)<len )
+		return read_fail(rd);
+	rd->pos += len;
+	return 1;
+}
+/* reads a string into the reader's text buffer, sets *given to 0 for a value that is not given */
+static int read_string(READER *rd, int *given)
+{
+	uint32 len;
+	if ( !read_data(rd,&len,sizeof(len)) )
+		return 0;
+	if ( len==GBM_NONE )
+	{
+		if ( given==NULL )
+			return read_fail(rd);
+		*given = 0;
+		rd->text[0] = '\0';
+		return 1;
+	}
+	if ( given!=NULL )
+		*given = 1;
+	if ( (size_t)(rd->end-rd->pos)<len )
+		return read_fail(rd);
+	if ( len>=rd->size )
+	{
+		char *more = (char*)realloc(rd->text,len+1);
+		if ( more==NULL )
+		{
+			output_error("loadall_bin(): unable to allocate %d bytes for a string", len+1);
+			/*	TROUBLESHOOT
+				The system ran out of memory while reading the binary model.  Free up memory
+				and try again.
+			 */
+			return 0;
+		}
+		rd->text = more;
+		rd->size = len+1;
+	}
+	memcpy(rd->text,rd->pos,len);
+	rd->text[len] = '\0';
+	rd->pos += len;
+	return 1;
+}
+
+/* checks a column against the class and resolves its property or header field */
+static int resolve_column(READER *rd, LOADCLASS *cls, LOADCOLUMN *col)
+{
+	if ( col->scope==GBM_HEADER )
+	{
+		for ( col->field=0 ; col->field<_HF_LAST ; col->field++ )
+		{
+			if ( strcmp(header_field[col->field].name,col->name)==0 )
+				break;
+		}
+		if ( col->field==_HF_LAST )
+		{
+			output_error("loadall_bin(): '%s' is not an object header field (class %s)", col->name, cls->oclass->name);
+			/*	TROUBLESHOOT
+				The column schema of a class in the binary model names a header field that does not
+				exist.  The valid header fields are name, parent, groupid, clock, latitude, longitude,
+				in_svc, out_svc, heartbeat, flags and schedule_skew.  Correct the tool that wrote the file and try again.
+			 */
+			return 0;
+		}
+		if ( col->encoding==GBM_TEXT
+			|| (col->encoding==GBM_REF && col->field==HF_PARENT)
+			|| (col->encoding==GBM_RAW && col->width==8 && col->field>=HF_CLOCK) )
+			return 1;
+	}
+	else if ( col->scope==GBM_PROPERTY )
+	{
+		col->prop = class_find_property(cls->oclass,col->name);
+		if ( col->prop==NULL )
+		{
+			output_error("loadall_bin(): class %s has no property '%s'", cls->oclass->name, col->name);
+			/*	TROUBLESHOOT
+				The binary model was saved with a version of the module that publishes a property the
+				loaded module does not have.  Load the model with the version of the module it was
+				saved with, or save it as GLM and correct the model.
+			 */
+			return 0;
+		}
+		if ( col->prop->access!=PA_PUBLIC )
+		{
+			output_error("loadall_bin(): property %s of class %s is not public", col->name, cls->oclass->name);
+			/*	TROUBLESHOOT
+				Only public properties may be set by a model file.  Remove the column from the binary
+				model and try again.
+			 */
+			return 0;
+		}
+		/* the GLM loader sets double and complex values without notifying the object */
+		if ( col->encoding==GBM_REF )
+			col->width = sizeof(OBJECT*);
+		col->direct = col->encoding!=GBM_TEXT
+			&& ( (col->prop->notify==NULL && cls->oclass->notify==NULL) || col->prop->ptype==PT_double || col->prop->ptype==PT_complex );
+		if ( col->encoding==GBM_TEXT
+			|| (col->encoding==GBM_REF && col->prop->ptype==PT_object)
+			|| (col->encoding==GBM_RAW && col->ptype==col->prop->ptype && col->width==property_width(col->prop)) )
+			return 1;
+	}
+	output_error("loadall_bin(): column %s of class %s does not match the class (scope %d, type %d, width %d, encoding %d)",
+		col->name, cls->oclass->name, col->scope, col->ptype, col->width, col->encoding);
+	/*	TROUBLESHOOT
+		The type or storage width of a column in the binary model is not that of the property it
+		sets.  This happens when the module that defines the class has changed since the file was
+		saved, or when the tool that wrote the file used the wrong type.  Save the model with the
+		current version, or write the column as text, and try again.
+	 */
+	return 0;
+}
+
+/* sets a property from a value in its own representation, the way the GLM loader would */
+static int set_raw(READER *rd, OBJECT *obj, LOADCOLUMN *col, void *value)
+{
+	char *addr = (char*)(obj+1)+(int64)col->prop->addr;
+	if ( col->direct )
+	{
+		memcpy(addr,value,col->width);
+		return 1;
+	}
+	if ( class_property_to_string(col->prop,value,rd->text,rd->size)<0 )
+		return 0;
+	return object_set_value_by_addr(obj,addr,rd->text,col->prop)>0 || rd->text[0]=='\0';
+}
+
+static int set_failed(READER *rd, OBJECT *obj, LOADCOLUMN *col)
+{
+	output_error("loadall_bin(): unable to set %s of %s:%d to '%s'", col->name, obj->oclass->name, obj->id, rd->text);
+	/*	TROUBLESHOOT
+		A value in the binary model could not be set.  This usually follows a more specific
+		message regarding the value.  Correct the value in the tool that wrote the file and try again.
+	 */
+	return 0;
+}
+
+/* applies the value of a column to the \p n-th object of its class */
+static int load_value(READER *rd, LOADCOLUMN *col, OBJECT *obj, uint32 n, OBJECT **table, uint32 n_objects)
+{
+	if ( col->encoding==GBM_RAW )
+	{
+		void *value = col->data + (size_t)n*col->width;
+		if ( col->scope==GBM_PROPERTY )
+		{
+			if ( !set_raw(rd,obj,col,value) )
+				return set_failed(rd,obj,col);
+		}
+		else
+		{
+			TIMESTAMP t;
+			double x;
+			memcpy(&t,value,sizeof(t));
+			memcpy(&x,value,sizeof(x));
+			switch ( col->field ) {
+			case HF_CLOCK: obj->clock = t; break;
+			case HF_LATITUDE: obj->latitude = x; break;
+			case HF_LONGITUDE: obj->longitude = x; break;
+			case HF_INSVC: obj->in_svc = t; obj->in_svc_micro = 0; obj->in_svc_double = (double)t; break;
+			case HF_OUTSVC: obj->out_svc = t; obj->out_svc_micro = 0; obj->out_svc_double = (double)t; break;
+			case HF_HEARTBEAT: obj->heartbeat = t; break;
+			case HF_FLAGS: obj->flags = (uint32)t; break;
+			case HF_SCHEDULESKEW: obj->schedule_skew = t; break;
+			default: break;
+			}
+		}
+	}
+	else if ( col->encoding==GBM_REF )
+	{
+		int32 ref;
+		OBJECT *target;
+		memcpy(&ref,col->data+(size_t)n*sizeof(int32),sizeof(ref));
+		if ( ref<-1 || ref>=(int32)n_objects )
+		{
+			output_error("loadall_bin(): %s of %s:%d refers to object %d, which is not in the object table", col->name, obj->oclass->name, obj->id, ref);
+			/*	TROUBLESHOOT
+				An object reference in the binary model is not a valid index into its object table.
+				Correct the tool that wrote the file and try again.
+			 */
+			return 0;
+		}
+		target = ref<0 ? NULL : table[ref];
+		sprintf(rd->text,"object %d",ref);
+		if ( col->scope==GBM_HEADER )
+		{
+			if ( target!=NULL && object_set_parent(obj,target)<0 )
+				return set_failed(rd,obj,col);
+		}
+		else if ( !set_raw(rd,obj,col,&target) )
+			return set_failed(rd,obj,col);
+	}
+	else
+	{
+		/* text values have different lengths, so each column keeps its own place */
+		int given;
+		rd->pos = col->next;
+		if ( !read_string(rd,&given) )
+			return 0;
+		col->next = rd->pos;
+		if ( !given )
+			return 1;
+		if ( col->scope==GBM_PROPERTY )
+		{
+			char *addr = (char*)(obj+1)+(int64)col->prop->addr;
+			if ( object_set_value_by_addr(obj,addr,rd->text,col->prop)<=0 && rd->text[0]!='\0' )
+				return set_failed(rd,obj,col);
+		}
+		else if ( col->field==HF_NAME )
+		{
+			if ( object_set_name(obj,rd->text)==NULL )
+				return set_failed(rd,obj,col);
+		}
+		else if ( col->field==HF_GROUPID )
+		{
+			strncpy(obj->groupid,rd->text,sizeof(obj->groupid)-1);
+			obj->groupid[sizeof(obj->groupid)-1] = '\0';
+		}
+		else if ( col->field==HF_FLAGS )
+		{
+			if ( convert_to_set(rd->text,&(obj->flags),object_flag_property())<=0 )
+				return set_failed(rd,obj,col);
+		}
+		else if ( col->field==HF_SCHEDULESKEW )
+			obj->schedule_skew = atoi64(rd->text);
+		else if ( object_set_value_by_name(obj,col->name,rd->text)<=0 )
+			return set_failed(rd,obj,col);
+	}
+	return 1;
+}
+
+/* copies a raw column into the storage of all the objects of its class at once */
+static void copy_column(LOADCLASS *cls, LOADCOLUMN *col)
+{
+	size_t offset = sizeof(OBJECT)+(size_t)(int64)col->prop->addr;
+	char *value = col->data;
+	uint32 k;
+	for ( k=0 ; k<cls->n_objects ; k++, value+=col->width )
+		memcpy((char*)(cls->obj[k])+offset,value,col->width);
+}
+
+/* skips over the values of a column, remembering where they start */
+static int skip_column(READER *rd, LOADCLASS *cls, LOADCOLUMN *col)
+{
+	uint32 n;
+	col->data = col->next = rd->pos;
+	if ( col->encoding==GBM_RAW )
+		return skip_data(rd,(size_t)cls->n_objects*col->width);
+	else if ( col->encoding==GBM_REF )
+		return skip_data(rd,(size_t)cls->n_objects*sizeof(int32));
+	for ( n=0 ; n<cls->n_objects ; n++ )
+	{
+		uint32 len;
+		if ( !read_data(rd,&len,sizeof(len)) || (len!=GBM_NONE && !skip_data(rd,len)) )
+			return 0;
+	}
+	return 1;
+}
+
+/** Load a binary model file
+	@return SUCCESS or FAILED
+ **/
+STATUS loadall_bin(char *filename)
+{
+	STATUS status = FAILED;
+	FILE *fp = fopen(filename,"rb");
+	char *buffer = NULL;
+	int64 fsize;
+	READER rd = {filename,NULL,NULL,NULL,NULL,0};
+	char magic[4];
+	uint32 version, byteorder, n_modules, n_globals, n_classes = 0, n_objects, i, n;
+	TIMESTAMP starttime, stoptime;
+	LOADCLASS *cls = NULL;
+	OBJECT **table = NULL;
+	int pass;
+
+	if ( fp==NULL )
+	{
+		output_error("loadall_bin(): unable to open '%s': %s", filename, strerror(errno));
+		return FAILED;
+	}
+	fseek(fp,0,SEEK_END);
+	fsize = ftell(fp);
+	fseek(fp,0,SEEK_SET);
+	buffer = (char*)malloc(fsize>0?(size_t)fsize:1);
+	rd.size = 1024;
+	rd.text = (char*)malloc(rd.size);
+	if ( buffer==NULL || rd.text==NULL )
+	{
+		output_error("loadall_bin(): unable to allocate %" FMT_INT64 "d bytes to read '%s'", fsize, filename);
+		/*	TROUBLESHOOT
+			The binary model is read into memory at once, and the system does not have enough
+			memory for it.  Free up memory and try again.
+		 */
+		goto Done;
+	}
+	if ( fread(buffer,1,(size_t)fsize,fp)!=(size_t)fsize )
+	{
+		output_error("loadall_bin(): unable to read '%s': %s", filename, strerror(errno));
+		goto Done;
+	}
+	rd.start = rd.pos = buffer;
+	rd.end = buffer+fsize;
+
+	/* header */
+	if ( !read_data(&rd,magic,sizeof(magic)) || !read_data(&rd,&version,sizeof(version)) || !read_data(&rd,&byteorder,sizeof(byteorder)) )
+		goto Done;
+	if ( memcmp(magic,GBM_MAGIC,sizeof(magic))!=0 || version!=GBM_VERSION || byteorder!=GBM_BYTEORDER )
+	{
+		output_error("loadall_bin(): '%s' is not a version %d binary model in the byte order of this machine", filename, GBM_VERSION);
+		/*	TROUBLESHOOT
+			The file does not start with the binary model header this version of GridLAB-D reads.
+			It is not a binary model, was written with another version, or was written on a
+			machine with a different byte order.  Save the model again from its GLM file.
+		 */
+		goto Done;
+	}
+	if ( !read_string(&rd,NULL) )
+		goto Done;
+	if ( rd.text[0]!='\0' && timestamp_set_tz(rd.text)==NULL )
+		output_warning("loadall_bin(): timezone %s is not defined", rd.text);
+		/*	TROUBLESHOOT
+			The specified timezone is not defined in the timezone file <code>.../etc/tzinfo.txt</code>.
+			Try using an known timezone, or add the desired timezone to the timezome file and try again.
+		 */
+	if ( !read_data(&rd,&starttime,sizeof(starttime)) || !read_data(&rd,&stoptime,sizeof(stoptime))
+		|| !read_data(&rd,&n_modules,sizeof(n_modules)) || !read_data(&rd,&n_globals,sizeof(n_globals))
+		|| !read_data(&rd,&n_classes,sizeof(n_classes)) || !read_data(&rd,&n_objects,sizeof(n_objects)) )
+		goto Done;
+	global_starttime = starttime;
+	global_stoptime = stoptime;
+
+	/* modules */
+	for ( i=0 ; i<n_modules ; i++ )
+	{
+		if ( !read_string(&rd,NULL) )
+			goto Done;
+		if ( module_find(rd.text)==NULL && module_load(rd.text,0,NULL)==NULL )
+		{
+			output_error("loadall_bin(): module %s could not be loaded", rd.text);
+			/*	TROUBLESHOOT
+				A module used by the binary model was not found or failed to load.  This usually
+				follows a more specific message regarding the module.  Make sure the module is
+				installed and try again.
+			 */
+			goto Done;
+		}
+	}
+
+	/* globals, only those that differ from the defaults are set */
+	for ( i=0 ; i<n_globals ; i++ )
+	{
+		char name[1024], value[1024];
+		if ( !read_string(&rd,NULL) )
+			goto Done;
+		strncpy(name,rd.text,sizeof(name)-1);
+		name[sizeof(name)-1] = '\0';
+		if ( !read_string(&rd,NULL) )
+			goto Done;
+		if ( global_getvar(name,value,sizeof(value))!=NULL && strcmp(value,rd.text)==0 )
+			continue;
+		if ( global_setvar(name,rd.text)!=SUCCESS )
+			output_warning("loadall_bin(): global %s could not be set to '%s'", name, rd.text);
+			/*	TROUBLESHOOT
+				A global variable saved in the binary model could not be set.  The global was
+				probably removed or renamed in the module that defines it.  Check the value of
+				the global and set it in the GLM file or on the command line if needed.
+			 */
+	}
+
+	/* class table */
+	cls = (LOADCLASS*)calloc(n_classes>0?n_classes:1,sizeof(LOADCLASS));
+	table = (OBJECT**)malloc(sizeof(OBJECT*)*(n_objects>0?n_objects:1));
+	if ( cls==NULL || table==NULL )
+	{
+		output_error("loadall_bin(): unable to allocate tables for %d classes and %d objects", n_classes, n_objects);
+		/*	TROUBLESHOOT
+			The system ran out of memory while reading the binary model.  Free up memory
+			and try again.
+		 */
+		goto Done;
+	}
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		LOADCLASS *c = cls+i;
+		if ( !read_string(&rd,NULL) )
+			goto Done;
+		c->oclass = class_get_class_from_classname(rd.text);
+		if ( c->oclass==NULL )
+		{
+			output_error("loadall_bin(): class %s is not defined by any loaded module", rd.text);
+			/*	TROUBLESHOOT
+				The class table of the binary model names a class that none of the modules in its
+				module table defines.  Runtime classes are not supported in binary models.
+				Correct the tool that wrote the file, or load the model from GLM.
+			 */
+			goto Done;
+		}
+		if ( !read_data(&rd,&c->n_objects,sizeof(c->n_objects)) || !read_data(&rd,&c->n_columns,sizeof(c->n_columns)) )
+			goto Done;
+		c->obj = (OBJECT**)malloc(sizeof(OBJECT*)*(c->n_objects>0?c->n_objects:1));
+		c->column = (LOADCOLUMN*)calloc(c->n_columns>0?c->n_columns:1,sizeof(LOADCOLUMN));
+		if ( c->obj==NULL || c->column==NULL )
+		{
+			output_error("loadall_bin(): unable to allocate the table of class %s", c->oclass->name);
+			goto Done;
+		}
+		for ( n=0 ; n<c->n_columns ; n++ )
+		{
+			LOADCOLUMN *col = c->column+n;
+			int32 ptype;
+			if ( !read_string(&rd,NULL) )
+				goto Done;
+			strncpy(col->name,rd.text,sizeof(col->name)-1);
+			if ( !read_data(&rd,&col->scope,sizeof(col->scope)) || !read_data(&rd,&ptype,sizeof(ptype))
+				|| !read_data(&rd,&col->width,sizeof(col->width)) || !read_data(&rd,&col->encoding,sizeof(col->encoding)) )
+				goto Done;
+			col->ptype = (PROPERTYTYPE)ptype;
+			if ( !resolve_column(&rd,c,col) )
+				goto Done;
+		}
+		slab_reserve(c->oclass,c->n_objects);
+	}
+
+	/* create the objects */
+	for ( n=0 ; n<n_objects ; n++ )
+	{
+		uint32 ci;
+		LOADCLASS *c;
+		OBJECT *obj = NULL;
+		if ( !read_data(&rd,&ci,sizeof(ci)) )
+			goto Done;
+		if ( ci>=n_classes || cls[ci].n_created==cls[ci].n_objects )
+		{
+			output_error("loadall_bin(): object %d of '%s' does not match the class table", n, filename);
+			/*	TROUBLESHOOT
+				The object table of the binary model refers to a class that is not in the class table,
+				or has more objects of a class than the class table declares.  Correct the tool that
+				wrote the file and try again.
+			 */
+			goto Done;
+		}
+		c = cls+ci;
+		if ( c->oclass->create!=NULL )
+		{
+			if ( (*c->oclass->create)(&obj,NULL)==0 )
+				obj = NULL;
+		}
+		else
+			obj = object_create_single(c->oclass);
+		if ( obj==NULL )
+		{
+			output_error("loadall_bin(): create failed for object %d of class %s", n, c->oclass->name);
+			/*	TROUBLESHOOT
+				The class could not create an object.  This usually follows a more specific message
+				from the module regarding the problem.  Follow the recommendation for that problem.
+			 */
+			goto Done;
+		}
+		c->obj[c->n_created++] = obj;
+		table[n] = obj;
+	}
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		if ( cls[i].n_created!=cls[i].n_objects )
+		{
+			output_error("loadall_bin(): the object table of '%s' has %d objects of class %s, the class table %d",
+				filename, cls[i].n_created, cls[i].oclass->name, cls[i].n_objects);
+			goto Done;
+		}
+	}
+
+	/* locate the values of each column */
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		for ( n=0 ; n<cls[i].n_columns ; n++ )
+		{
+			if ( !skip_column(&rd,cls+i,cls[i].column+n) )
+				goto Done;
+		}
+	}
+
+	/* raw values that need no conversion or notification are copied a column at a time */
+	for ( i=0 ; i<n_classes ; i++ )
+	{
+		for ( n=0 ; n<cls[i].n_columns ; n++ )
+		{
+			LOADCOLUMN *col = cls[i].column+n;
+			if ( col->scope==GBM_PROPERTY && col->encoding==GBM_RAW && col->direct )
+				copy_column(cls+i,col);
+		}
+	}
+
+	/* then names and parents so that text references resolve, then the other values
+	   one object at a time */
+	for ( pass=0 ; pass<3 ; pass++ )
+	{
+		for ( i=0 ; i<n_classes ; i++ )
+		{
+			LOADCLASS *c = cls+i;
+			uint32 k;
+			for ( k=0 ; k<c->n_objects ; k++ )
+			{
+				for ( n=0 ; n<c->n_columns ; n++ )
+				{
+					LOADCOLUMN *col = c->column+n;
+					int order = col->scope!=GBM_HEADER ? 2 : (col->field==HF_NAME ? 0 : (col->field==HF_PARENT ? 1 : 2));
+					if ( col->scope==GBM_PROPERTY && col->encoding==GBM_RAW && col->direct )
+						continue;
+					if ( order==pass && !load_value(&rd,col,c->obj[k],k,table,n_objects) )
+						goto Done;
+				}
+			}
+		}
+	}
+
+	/* establish ranks */
+	for ( n=0 ; n<n_objects ; n++ )
+		object_set_parent(table[n],table[n]->parent);
+	output_verbose("%d objects of %d classes loaded from binary model '%s'", n_objects, n_classes, filename);
+	status = SUCCESS;
+
+Done:
+	for ( i=0 ; cls!=NULL && i<n_classes ; i++ )
+	{
+		free(cls[i].obj);
+		free(cls[i].column);
+	}
+	free(cls);
+	free(table);
+	free(rd.text);
+	free(buffer);
+	fclose(fp);
+	return status;
+}
+
+/**@}**/
@@ -0,0 +1,127 @@
+/** $Id: load_bin.h
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file load_bin.h
+	@addtogroup load_bin Binary model files
+	@ingroup core
+
+	Binary model files (extension \p .gbm) hold the same model a GLM file
+	does in a form that is loaded without parsing: each class's property
+	values are stored as typed columns that are copied directly into
+	object storage.  They are meant for tools that generate or exchange
+	models, not for editing.  Use
+	@code
+	gridlabd model.glm --save model.gbm
+	@endcode
+	to convert a model, and load \p model.gbm as any other model file.
+
+	@par Layout
+	All integers are in the byte order of the machine that wrote the file
+	(little-endian on every supported platform).  A \e string is a uint32
+	length followed by that many bytes, without a terminating null.  A
+	length of 0xffffffff is used in value columns for a value that is not
+	given, in which case no bytes follow.
+	<pre>
+	header
+		char[4]  magic "GLDB"
+		uint32   version (GBM_VERSION)
+		uint32   byte order mark 0x01020304
+		string   timezone (may be empty)
+		int64    clock starttime
+		int64    clock stoptime
+		uint32   number of modules
+		uint32   number of globals
+		uint32   number of classes
+		uint32   number of objects
+	module table, one entry per module
+		string   module name, loaded as with a \p module statement
+	global table, one entry per global
+		string   global name (module globals are \p module::name)
+		string   global value, set as with a \p #set statement
+	class table, one entry per class
+		string   class name
+		uint32   number of objects of this class
+		uint32   number of columns
+		column schema, one entry per column
+			string   property name
+			uint32   scope: GBM_PROPERTY or GBM_HEADER
+			int32    property type (PROPERTYTYPE)
+			uint32   width of a value in bytes (GBM_RAW only)
+			uint32   encoding: GBM_RAW, GBM_TEXT or GBM_REF
+	object table, one entry per object
+		uint32   index of the object's class in the class table
+	class data, for each class in class table order
+		for each column in schema order, one value per object of the class
+		in object table order:
+			GBM_RAW  \e width bytes, copied as is into the property
+			GBM_TEXT string, converted as in a GLM file
+			GBM_REF  int32 index of an object in the object table, -1 for none
+	</pre>
+
+	Objects are created in object table order, so the object table index
+	is also the object id when the model is loaded on its own.
+
+	@par Columns
+	Property columns (scope GBM_PROPERTY) name a property of the class or
+	of one of its parent classes.  A GBM_RAW column must have the
+	property's type and storage width (the type size times the array size
+	for arrayed properties); GBM_REF is only valid for \p object
+	properties; any property may use GBM_TEXT.  Header columns (scope
+	GBM_HEADER) set the object header and are \p name (GBM_TEXT),
+	\p parent (GBM_REF or GBM_TEXT), \p groupid (GBM_TEXT), and
+	\p clock, \p latitude, \p longitude, \p in_svc, \p out_svc,
+	\p heartbeat, \p flags and \p schedule_skew (GBM_RAW, 8 bytes, or
+	GBM_TEXT).  A writer may leave out any column, in which case the value
+	the object is created with is kept.
+
+	Values are set the way the GLM loader sets them: property notifiers
+	are called for everything but \p double and \p complex values, and
+	names and parents are set before any other property, so that text
+	object references can be resolved.  GBM_RAW columns that need no
+	notification are copied into object storage a whole column at a time,
+	before any other value is set.
+
+	@par Limitations
+	Schedules and transforms defined in the model, runtime classes and core
+	globals other than the clock are not saved.  Schedules that modules
+	create for their objects are created again when the objects are.  Of
+	the object header, \p valid_to and the microsecond parts of \p in_svc
+	and \p out_svc are not saved, and ranks are established again from
+	the parents.
+
+ @{
+ **/
+
+#ifndef _LOAD_BIN_H
+#define _LOAD_BIN_H
+
+#include <stdio.h>
+
+#include "globals.h"
+
+#define GBM_MAGIC "GLDB"		/**< first bytes of a binary model file */
+#define GBM_VERSION 1			/**< change this when the layout changes */
+#define GBM_BYTEORDER 0x01020304	/**< written in native byte order to detect a mismatch */
+
+/* column scopes */
+#define GBM_PROPERTY 0	/**< the column is a class property */
+#define GBM_HEADER 1	/**< the column is an object header field */
+
+/* column encodings */
+#define GBM_RAW 0	/**< values are stored in the property's own representation */
+#define GBM_TEXT 1	/**< values are strings converted by the property type */
+#define GBM_REF 2	/**< values are indexes in the object table */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+STATUS loadall_bin(char *filename);
+int saveall_bin(char *filename, FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/**@}**/
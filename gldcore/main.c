@@ -33,6 +33,7 @@
 #include "kml.h"
 #include "kill.h"
 #include "threadpool.h"
+#include "slab.h"
 
 #if defined WIN32 && _DEBUG 
 /** Implements a pause on exit capability for Windows consoles
@@ -214,6 +215,7 @@ int main(int argc, /**< the number entries on command-line argument list \p argv
 	if (global_profiler)
 	{
 		class_profiles();
+		slab_profiles();
 		module_profiles();
 	}
 
@@ -72,6 +72,7 @@
 #include "output.h"
 #include "module.h"
 #include "find.h"
+#include "propview.h"
 #include "random.h"
 #include "test_callbacks.h"
 #include "exception.h"
@@ -226,6 +227,7 @@ static CALLBACKS callbacks = {
 	{transform_getnext,transform_add_linear,transform_add_external,transform_apply},
 	{randomvar_getnext,randomvar_getspec},
 	{version_major,version_minor,version_patch,version_build,version_branch},
+	{propview_create,propview_destroy,propview_gather,propview_scatter,propview_can_view},
 	MAGIC /* used to check structure */
 };
 CALLBACKS *module_callbacks(void) { return &callbacks; }
@@ -42,6 +42,8 @@
 #include "lock.h"
 #include "threadpool.h"
 #include "exec.h"
+#include "profile.h"
+#include "slab.h"
 
 /* object list */
 static OBJECTNUM next_object_id = 0;
@@ -59,7 +61,8 @@ KEYWORD oflags[] = {
 	{"LOCKED", OF_LOCKED, oflags + 3},
 	{"RERANKED", OF_RERANK, oflags + 4},
 	{"RECALC", OF_RECALC, oflags + 5},
-	{"DELTAMODE", OF_DELTAMODE, NULL},
+	{"DELTAMODE", OF_DELTAMODE, oflags + 6},
+	{"SKIPSAFE", OF_SKIPSAFE, NULL},
 };
 
 /* WARNING: untested. -d3p988 30 Jan 08 */
@@ -279,6 +282,41 @@ char *object_get_unit(OBJECT *obj, char *name)
 	}
 }
 
+/* the batch of the objects the calling thread creates, if any */
+static THREADLOCAL OBJECTBATCH *current_batch = NULL;
+
+/** Hold the objects the calling thread creates in a batch, or NULL to create them
+	normally.  The loader uses this to create the objects of included files in
+	several threads and number them in the order they appear in the model.
+ **/
+void object_set_batch(OBJECTBATCH *batch) /**< the batch, or NULL */
+{
+	current_batch = batch;
+}
+
+/** Give the objects in a batch their ids and random states and append them to
+	the object list, in the order they were created.  The batch is left empty.
+	The caller must make sure no other thread is creating objects outside a batch.
+ **/
+void object_commit_batch(OBJECTBATCH *batch) /**< the batch */
+{
+	OBJECT *obj, *next;
+	for ( obj=batch->first ; obj!=NULL ; obj=next )
+	{
+		next = obj->next;
+		obj->next = NULL;
+		obj->id = next_object_id++;
+		obj->rng_state = randwarn(NULL);
+		if ( first_object==NULL )
+			first_object = obj;
+		else
+			last_object->next = obj;
+		last_object = obj;
+		obj->oclass->profiler.numobjs++;
+	}
+	batch->first = batch->last = NULL;
+}
+
 /** Create a single object.
 	@return a pointer to object header, \p NULL of error, set \p errno as follows:
 	- \p EINVAL type is not valid
@@ -312,7 +350,7 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 		*/
 	}
 
-	obj = (OBJECT*)malloc(sz + oclass->size);
+	obj = (OBJECT*)slab_alloc(oclass);
 
 	if(obj == NULL){
 		throw_exception("object_create_single(CLASS *oclass='%s'): memory allocation failed", oclass->name);
@@ -325,7 +363,8 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 
 	tp_next %= tp_count;
 
-	obj->id = next_object_id++;
+	if ( current_batch==NULL )
+		obj->id = next_object_id++;
 	obj->oclass = oclass;
 	obj->next = NULL;
 	obj->name = NULL;
@@ -343,11 +382,23 @@ OBJECT *object_create_single(CLASS *oclass){ /**< the class of the object */
 	obj->out_svc_double = (double)obj->out_svc;
 	obj->space = object_current_namespace();
 	obj->flags = OF_NONE;
-	obj->rng_state = randwarn(NULL);
+	if ( current_batch==NULL )
+		obj->rng_state = randwarn(NULL);
 	obj->heartbeat = 0;
 
 	for ( prop=obj->oclass->pmap; prop!=NULL; prop=(prop->next?prop->next:(prop->oclass->parent?prop->oclass->parent->pmap:NULL)))
 		property_create(prop,(void*)((char *)(obj+1)+(int64)(prop->addr)));
+
+	/* the id, random state and place in the list are given when the batch is committed */
+	if ( current_batch!=NULL )
+	{
+		if ( current_batch->last==NULL )
+			current_batch->first = obj;
+		else
+			current_batch->last->next = obj;
+		current_batch->last = obj;
+		return obj;
+	}
 	
 	if(first_object == NULL){
 		first_object = obj;
@@ -425,11 +476,20 @@ OBJECT *object_create_foreign(OBJECT *obj) /**< a pointer to the OBJECT data str
 	return obj;
 }
 
-/** Stream fixup object
+/** Stream fixup object - the object is moved into its class's storage, so it
+	is released with the other objects of its class
  **/
 void object_stream_fixup(OBJECT *obj, char *classname, char *objname)
 {
-	obj->oclass = class_get_class_from_classname(classname);
+	CLASS *oclass = class_get_class_from_classname(classname);
+	OBJECT *stored = oclass ? (OBJECT*)slab_alloc(oclass) : NULL;
+	if ( stored!=NULL )
+	{
+		memcpy(stored,obj,sizeof(OBJECT)+oclass->size);
+		free(obj);
+		obj = stored;
+	}
+	obj->oclass = oclass;
 	obj->name = (char*)malloc(strlen(objname)+1);
 	strcpy(obj->name,objname);
 	obj->next = NULL;
@@ -438,6 +498,7 @@ void object_stream_fixup(OBJECT *obj, char *classname, char *objname)
 	else
 		last_object->next = obj;
 	last_object = obj;
+	next_object_id++;
 }
 
 /** Create multiple objects.
@@ -448,6 +509,9 @@ OBJECT *object_create_array(CLASS *oclass, /**< a pointer to the CLASS structure
 							unsigned int n_objects){ /**< the number of objects to create */
 	OBJECT *first = NULL;
 	
+	/* place the whole array in one block */
+	slab_reserve(oclass, n_objects);
+
 	while(n_objects-- > 0){
 		OBJECT *obj = object_create_single(oclass);
 		
@@ -484,7 +548,9 @@ OBJECT *object_remove_by_id(OBJECTNUM id){
 		next = target->next;
 		prev->next = next;
 		target->oclass->profiler.numobjs--;
-		free(target);
+		if(!slab_free(target->oclass, target)){
+			free(target);
+		}
 		target = NULL;
 		deleted_object_count++;
 	}
@@ -760,6 +826,21 @@ static PROPERTY *get_property_at_addr(OBJECT *obj, void *addr)
 	return NULL;
 }
 
+/** Flag an object whose property value is being changed, so that it is
+	recalculated if the property has a recalc trigger and reactivated if
+	the property is a sparse sync trigger.  Anything that writes property
+	values directly into objects must call this for each property it sets.
+ **/
+void object_property_changed(OBJECT *obj, /**< the object being altered */
+							 PROPERTY *prop) /**< the property being set */
+{
+	/* set the recalc bit if the property has a recalc trigger */
+	if(prop->flags&PF_RECALC) obj->flags |= OF_RECALC;
+
+	/* reactivate the object if the property is a sparse sync trigger */
+	if(global_sparse_sync && (prop->flags&PF_ACTIVATE || prop->oclass==NULL || !prop->oclass->has_activate)) exec_sparse_activate(obj);
+}
+
 /** Set a property value by reference to its physical address
 	@return the character written to the buffer
  **/
@@ -779,8 +860,7 @@ int object_set_value_by_addr(OBJECT *obj, /**< the object to alter */
 		return 0;
 	}
 
-	/* set the recalc bit if the property has a recalc trigger */
-	if(prop->flags&PF_RECALC) obj->flags |= OF_RECALC;
+	object_property_changed(obj,prop);
 
 	/* dispatch notifiers */
 	if(obj->oclass->notify){
@@ -1396,16 +1476,13 @@ char *object_property_to_string(OBJECT *obj, char *name, char *buffer, int sz)
 		return "";
 }
 
-void object_profile(OBJECT *obj, OBJECTPROFILEITEM pass, clock_t t)
+/* t is the profile_clock() time at which the call started, or 0 if the profiler was off */
+void object_profile(OBJECT *obj, OBJECTPROFILEITEM pass, int64 t)
 {
-	if ( global_profiler==1 )
+	if ( global_profiler==1 && t>0 )
 	{
-		clock_t dt = (clock_t)exec_clock()-t;
-		obj->synctime[pass] += dt;
-		wlock(&obj->oclass->profiler.lock);
-		obj->oclass->profiler.count++;
-		obj->oclass->profiler.clocks += dt;
-		wunlock(&obj->oclass->profiler.lock);
+		int64 dt = profile_object(obj,pass,t);
+		obj->synctime[pass] += (clock_t)(dt*CLOCKS_PER_SEC/1000000000);
 	}
 }
 
@@ -1497,7 +1574,7 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 					  TIMESTAMP ts, /**< the desire clock to sync to */
 					  PASSCONFIG pass) /**< the pass configuration */
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	TIMESTAMP t2=TS_NEVER;
 	do {
 		/* don't call sync beyond valid horizon */
@@ -1526,7 +1603,7 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 
 TIMESTAMP object_heartbeat(OBJECT *obj)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	TIMESTAMP t1 = obj->oclass->heartbeat ? obj->oclass->heartbeat(obj) : TS_NEVER;
 	object_profile(obj,OPI_HEARTBEAT,t);
 		if ( global_debug_output>0 )
@@ -1544,7 +1621,7 @@ TIMESTAMP object_heartbeat(OBJECT *obj)
  **/
 int object_init(OBJECT *obj) /**< the object to initialize */
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	int rv = 1;
 	obj->clock = global_starttime;
 	if(obj->oclass->init != NULL)
@@ -1566,7 +1643,7 @@ int object_init(OBJECT *obj) /**< the object to initialize */
  **/
 STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	STATUS rv = SUCCESS;
 	if(obj->oclass->precommit != NULL){
 		rv = (STATUS)(*(obj->oclass->precommit))(obj, t1);
@@ -1582,7 +1659,7 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 
 TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	TIMESTAMP rv = 1;
 	if(obj->oclass->commit != NULL){
 		rv = (TIMESTAMP)(*(obj->oclass->commit))(obj, t1, t2);
@@ -1607,7 +1684,7 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
  **/
 STATUS object_finalize(OBJECT *obj)
 {
-	clock_t t = (clock_t)exec_clock();
+	int64 t = global_profiler ? profile_clock() : 0;
 	STATUS rv = SUCCESS;
 	if(obj->oclass->finalize != NULL){
 		rv = (STATUS)(*(obj->oclass->finalize))(obj);
@@ -2102,10 +2179,12 @@ typedef struct s_objecttree {
 	char name[64];
 	OBJECT *obj;
 	struct s_objecttree *before, *after;
-	int balance; /* unused */
+	int balance; /* height of after less height of before */
+	int height; /* height of the subtree rooted here */
 } OBJECTTREE;
 
 static OBJECTTREE *top=NULL;
+static unsigned int object_tree_lock=0; /* guards the tree against concurrent registration */
 
 void debug_traverse_tree(OBJECTTREE *tree){
 	if(tree == NULL){
@@ -2128,14 +2207,18 @@ int tree_get_height(OBJECTTREE *tree){
 	if(tree == NULL){
 		return 0;
 	} else {
-		int left = tree_get_height(tree->before);
-		int right = tree_get_height(tree->after);
-		if(left > right)
-			return left+1;
-		else return right+1;
+		return tree->height;
 	}
 }
 
+/* recomputes the height of a node from the heights of its subtrees */
+static void tree_set_height(OBJECTTREE *tree){
+	int left = tree_get_height(tree->before);
+	int right = tree_get_height(tree->after);
+	tree->height = (left > right ? left : right) + 1;
+	tree->balance = right - left;
+}
+
 /* returns the node to point to instead of tree */
 void rotate_tree_right(OBJECTTREE **tree){ /* move one object from left to right */
 	OBJECTTREE *root, *pivot, *child;
@@ -2145,8 +2228,8 @@ void rotate_tree_right(OBJECTTREE **tree){ /* move one object from left to right
 	*tree = pivot;
 	pivot->after = root;
 	root->before = child;
-	root->balance += 2;
-	pivot->balance += 1;
+	tree_set_height(root);
+	tree_set_height(pivot);
 }
 
 /* returns the node to point to instead of tree */
@@ -2158,8 +2241,8 @@ void rotate_tree_left(OBJECTTREE **tree){ /* move one object from right to left
 	*tree = pivot;
 	pivot->before = root;
 	root->after = child;
-	root->balance -= 2;
-	pivot->balance -= 1;
+	tree_set_height(root);
+	tree_set_height(pivot);
 }
 
 /*  Rebalance the tree to make searching more efficient
@@ -2176,7 +2259,7 @@ int object_tree_rebalance(OBJECTTREE *tree) /* AVL logic */
  */
 static int addto_tree(OBJECTTREE **tree, OBJECTTREE *item){
 	int rel = strcmp((*tree)->name, item->name);
-	int right = 0, left = 0, ir = 0, il = 0, rv = 0, height = 0;
+	int rv = 0;
 
 	// find location to insert new object
 	if(rel > 0){
@@ -2201,10 +2284,8 @@ static int addto_tree(OBJECTTREE **tree, OBJECTTREE *item){
 		return (*tree)->obj==item->obj;
 	}
 
-	// check balance
-	right = tree_get_height((*tree)->after);
-	left = tree_get_height((*tree)->before);
-	(*tree)->balance = right - left;
+	// check balance - the heights below are already current
+	tree_set_height(*tree);
 
 	// rotations needed?
 	if((*tree)->balance > 1){
@@ -2237,6 +2318,7 @@ static OBJECTTREE *object_tree_add(OBJECT *obj, OBJECTNAME name){
 	
 	item->obj = obj;
 	item->balance = 0;
+	item->height = 1;
 	strncpy(item->name, name, sizeof(item->name));
 	item->before = item->after = NULL;
 
@@ -2256,7 +2338,6 @@ static OBJECTTREE *object_tree_add(OBJECT *obj, OBJECTNAME name){
  */
 static OBJECTTREE **findin_tree(OBJECTTREE *tree, OBJECTNAME name)
 {
-	static OBJECTTREE **temptree = NULL;
 	if(tree == NULL){
 		return NULL;
 	} else {
@@ -2282,7 +2363,9 @@ static OBJECTTREE **findin_tree(OBJECTTREE *tree, OBJECTNAME name)
 				return NULL;
 			}
 		} else {
-			return (temptree = &tree);
+			/* only the root is matched here - matches below it are caught by their parent,
+			   and the address of the tree argument doesn't outlive this call */
+			return &top;
 		}
 	}
 }
@@ -2292,9 +2375,12 @@ static OBJECTTREE **findin_tree(OBJECTTREE *tree, OBJECTNAME name)
  */
 void object_tree_delete(OBJECT *obj, OBJECTNAME name)
 {
-	OBJECTTREE **item = findin_tree(top,name);
+	OBJECTTREE **item = NULL;
 	OBJECTTREE *temp = NULL, **dtemp = NULL;
 
+	wlock(&object_tree_lock);
+	item = findin_tree(top,name);
+
 	if(item != NULL && strcmp((*item)->name, name)!=0){
 		if((*item)->after == NULL && (*item)->before == NULL){ /* no children -- nuke */
 			free(*item);
@@ -2330,6 +2416,7 @@ void object_tree_delete(OBJECT *obj, OBJECTNAME name)
 
 		/* throw_exception("object_tree_delete(obj=%s:%d, name='%s'): rename of objects in tree is not supported yet", obj->oclass->name, obj->id, name); */
 	}
+	wunlock(&object_tree_lock);
 }
 
 /** Find an object from a name.  This only works for named objects.  See object_set_name().
@@ -2337,15 +2424,17 @@ void object_tree_delete(OBJECT *obj, OBJECTNAME name)
  **/
 OBJECT *object_find_name(OBJECTNAME name){
 	OBJECTTREE **item = NULL;
+	OBJECT *obj = NULL;
 
+	rlock(&object_tree_lock);
 	item = findin_tree(top, name);
 	
 	if(item != NULL && *item != NULL){
-		return (*item)->obj;
-	} else {
-		/* normal operation, remain silent */
-		return NULL;
+		obj = (*item)->obj;
 	}
+	/* otherwise normal operation, remain silent */
+	runlock(&object_tree_lock);
+	return obj;
 }
 
 int object_build_name(OBJECT *obj, char *buffer, int len){
@@ -2403,7 +2492,12 @@ OBJECTNAME object_set_name(OBJECT *obj, OBJECTNAME name){
 	}
 	
 	if(name != NULL){
-		if(object_find_name(name) != NULL){
+		/* the check and the insert are one step, so two objects can't register the same name */
+		OBJECTTREE **found = NULL;
+		wlock(&object_tree_lock);
+		found = findin_tree(top, name);
+		if(found != NULL && *found != NULL){
+			wunlock(&object_tree_lock);
 			output_error("An object named '%s' already exists!", name);
 			/*	TROUBLESHOOT
 				GridLab-D prohibits two objects from using the same name, to prevent
@@ -2415,6 +2509,7 @@ OBJECTNAME object_set_name(OBJECT *obj, OBJECTNAME name){
 		if(item != NULL){
 			obj->name = item->name;
 		}
+		wunlock(&object_tree_lock);
 	}
 	
 	if(item != NULL){
@@ -2434,9 +2529,12 @@ void remove_objects(){
 	while(obj1 != NULL){
 		first_object = obj1->next;
 		obj1->oclass->profiler.numobjs--;
-		free(obj1);
+		if(!slab_contains(obj1->oclass)){ /* objects in slabs are released with them below */
+			free(obj1);
+		}
 		obj1 = first_object;
 	}
+	slab_free_all();
 
 	next_object_id = 0;
 }
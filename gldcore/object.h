@@ -94,6 +94,14 @@ typedef struct s_object_list {
 	/* IMPORTANT: flags must be last */
 } OBJECT; /**< Object header structure */
 
+/** Objects created by a thread that holds a batch (see object_set_batch())
+	get no id and are not in the object list until the batch is committed
+ **/
+typedef struct s_objectbatch {
+	OBJECT *first; /**< the first object created, linked to the others by next */
+	OBJECT *last; /**< the last object created */
+} OBJECTBATCH;
+
 /* this is the callback table for modules
  * the table is initialized in module.cpp
  */
@@ -324,6 +332,13 @@ typedef struct s_callbacks {
 		unsigned int (*build)(void);
 		const char * (*branch)(void);
 	} version;
+	struct {
+		struct s_propview *(*create)(CLASS *oclass, char *proplist);
+		void (*destroy)(struct s_propview *view);
+		size_t (*gather)(struct s_propview *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+		size_t (*scatter)(struct s_propview *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+		bool (*can_view)(PROPERTY *prop);
+	} propview;
 	long unsigned int magic; /* used to check structure alignment */
 } CALLBACKS; /**< core callback function table */
 
@@ -334,6 +349,8 @@ extern "C" {
 OBJECT *object_create_single(CLASS *oclass);
 OBJECT *object_create_array(CLASS *oclass, unsigned int n_objects);
 OBJECT *object_create_foreign(OBJECT *obj);
+void object_set_batch(OBJECTBATCH *batch);
+void object_commit_batch(OBJECTBATCH *batch);
 OBJECT *object_remove_by_id(OBJECTNUM id);
 int object_init(OBJECT *obj);
 STATUS object_precommit(OBJECT *obj, TIMESTAMP t1);
@@ -347,6 +364,7 @@ PROPERTY *object_get_property(OBJECT *obj, PROPERTYNAME name, PROPERTYSTRUCT *pa
 PROPERTY *object_prop_in_class(OBJECT *obj, PROPERTY *prop);
 int object_set_value_by_name(OBJECT *obj, PROPERTYNAME name, char *value);
 int object_set_value_by_addr(OBJECT *obj, void *addr, char *value, PROPERTY *prop);
+void object_property_changed(OBJECT *obj, PROPERTY *prop);
 int object_set_int16_by_name(OBJECT *obj, PROPERTYNAME name, int16 value);
 int object_set_int32_by_name(OBJECT *obj, PROPERTYNAME name, int32 value);
 int object_set_int64_by_name(OBJECT *obj, PROPERTYNAME name, int64 value);
@@ -41,6 +41,11 @@
 	#define stricmp strcasecmp	/**< deprecated stricmp */
 	#define strnicmp strncasecmp /**< deprecated strnicmp */
 	#define strtok_s strtok_r
+	#ifdef _MSC_VER
+		#define THREADLOCAL __declspec(thread) /**< storage class of per-thread variables */
+	#else
+		#define THREADLOCAL __thread /**< storage class of per-thread variables */
+	#endif
 	#ifndef isfinite
 		#define isfinite finite
 	#endif
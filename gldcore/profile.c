@@ -0,0 +1,475 @@
+/* profile.c
+ * Copyright (C) 2016 Battelle Memorial Institute
+ *
+ * High-resolution profiler.
+ *
+ * When the profiler global is set, object callbacks and the core's internal
+ * syncs are timed with a monotonic nanosecond clock.  Each thread that runs
+ * callbacks records into its own buffer, so no locks are taken while the
+ * simulation runs: per-class latency histograms and trace events are kept
+ * per thread, and per-object statistics are only updated by the thread that
+ * is running that object.  At the end of the run the buffers are merged, the
+ * class totals used by the profiler report are filled in, and the files named
+ * by profile_summary (CSV) and profile_trace (Chrome trace JSON, which can be
+ * loaded in chrome://tracing) are written.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#include "profile.h"
+#include "output.h"
+#include "class.h"
+
+#define PROFILE_BINS 32 /* bin n holds latencies from 2^n to 2^(n+1) ns, the last bin holds all longer ones */
+
+typedef struct s_profilehist {
+	int64 count; /**< number of calls */
+	int64 total; /**< total time (ns) */
+	int64 max; /**< longest call (ns) */
+	unsigned int bin[PROFILE_BINS]; /**< latency histogram */
+} PROFILEHIST;
+
+typedef struct s_profileobject {
+	PROFILEHIST sync; /**< all sync passes */
+	int64 count[OPI_POSTSYNC+1]; /**< calls by pass */
+	int64 total[OPI_POSTSYNC+1]; /**< time by pass (ns) */
+} PROFILEOBJECT;
+
+typedef struct s_profileevent {
+	int64 t0; /**< start time (ns since profile_init) */
+	int64 dt; /**< duration (ns) */
+	OBJECT *obj; /**< object, or NULL for core activities */
+	int item; /**< OBJECTPROFILEITEM, or PROFILEINTERNAL when obj is NULL */
+} PROFILEEVENT;
+
+typedef struct s_profilethread {
+	unsigned int id; /**< thread number in order of first use */
+	PROFILEHIST *classes; /**< class histograms [class][item] */
+	PROFILEHIST internals[_PRI_NUMITEMS]; /**< core activity histograms */
+	PROFILEEVENT *trace; /**< trace events */
+	unsigned int n_trace; /**< number of trace events */
+	unsigned int max_trace; /**< trace events allocated */
+	bool overflow; /**< trace events were dropped */
+	struct s_profilethread *next;
+} PROFILETHREAD;
+
+static const char *object_item[_OPI_NUMITEMS] = {"presync","sync","postsync","init","heartbeat","precommit","commit","finalize"};
+static const char *internal_item[_PRI_NUMITEMS] = {"link","instance","randomvar","schedule","loadshape","transform","enduse","heartbeat"};
+
+static bool ready = false;
+static bool tracing = false;
+static int64 t_start = 0;
+static pthread_key_t thread_key;
+static pthread_mutex_t thread_lock = PTHREAD_MUTEX_INITIALIZER;
+static PROFILETHREAD *first_thread = NULL;
+static unsigned int n_threads = 0;
+static unsigned int n_classes = 0;
+static PROFILEOBJECT *objects = NULL; /* indexed by object id */
+static unsigned int n_objects = 0;
+
+/** Read the monotonic profiler clock
+	@return the time in ns from an arbitrary origin
+ **/
+int64 profile_clock(void)
+{
+#ifdef WIN32
+	static LARGE_INTEGER freq = {0};
+	LARGE_INTEGER now;
+	if ( freq.QuadPart==0 )
+		QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (int64)(now.QuadPart/freq.QuadPart)*1000000000 + (int64)(now.QuadPart%freq.QuadPart)*1000000000/freq.QuadPart;
+#elif defined(__APPLE__)
+	static mach_timebase_info_data_t timebase = {0,0};
+	if ( timebase.denom==0 )
+		mach_timebase_info(&timebase);
+	return (int64)(mach_absolute_time()*timebase.numer/timebase.denom);
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return (int64)now.tv_sec*1000000000 + now.tv_nsec;
+#endif
+}
+
+static void hist_add(PROFILEHIST *h, int64 dt)
+{
+	unsigned int n = 0;
+	int64 t = dt;
+	while ( t>1 && n<PROFILE_BINS-1 )
+	{
+		t >>= 1;
+		n++;
+	}
+	h->bin[n]++;
+	h->count++;
+	h->total += dt;
+	if ( dt>h->max ) h->max = dt;
+}
+
+static void hist_merge(PROFILEHIST *to, PROFILEHIST *from)
+{
+	unsigned int n;
+	for ( n=0 ; n<PROFILE_BINS ; n++ )
+		to->bin[n] += from->bin[n];
+	to->count += from->count;
+	to->total += from->total;
+	if ( from->max>to->max ) to->max = from->max;
+}
+
+/* upper bound of the bin holding the given fraction of calls (ns) */
+static int64 hist_percentile(PROFILEHIST *h, double p)
+{
+	unsigned int n;
+	int64 sum = 0;
+	for ( n=0 ; n<PROFILE_BINS-1 ; n++ )
+	{
+		sum += h->bin[n];
+		if ( sum>=p*h->count )
+			break;
+	}
+	return ((int64)2<<n)<h->max ? ((int64)2<<n) : h->max;
+}
+
+/* get the calling thread's buffer, creating it on first use */
+static PROFILETHREAD *profile_thread(void)
+{
+	PROFILETHREAD *pt = (PROFILETHREAD*)pthread_getspecific(thread_key);
+	if ( pt==NULL )
+	{
+		pt = (PROFILETHREAD*)calloc(1,sizeof(PROFILETHREAD));
+		if ( pt==NULL )
+			return NULL;
+		pt->classes = (PROFILEHIST*)calloc(n_classes*_OPI_NUMITEMS,sizeof(PROFILEHIST));
+		if ( pt->classes==NULL )
+		{
+			free(pt);
+			return NULL;
+		}
+		pthread_mutex_lock(&thread_lock);
+		pt->id = n_threads++;
+		pt->next = first_thread;
+		first_thread = pt;
+		pthread_mutex_unlock(&thread_lock);
+		pthread_setspecific(thread_key,pt);
+	}
+	return pt;
+}
+
+static void profile_trace(PROFILETHREAD *pt, OBJECT *obj, int item, int64 t0, int64 dt)
+{
+	PROFILEEVENT *event;
+	if ( pt->n_trace==pt->max_trace )
+	{
+		unsigned int size = pt->max_trace==0 ? 4096 : pt->max_trace*2;
+		if ( size>(unsigned int)global_profile_trace_limit )
+			size = global_profile_trace_limit;
+		if ( size<=pt->max_trace || (event=(PROFILEEVENT*)realloc(pt->trace,sizeof(PROFILEEVENT)*size))==NULL )
+		{
+			pt->overflow = true;
+			return;
+		}
+		pt->trace = event;
+		pt->max_trace = size;
+	}
+	event = &pt->trace[pt->n_trace++];
+	event->t0 = t0-t_start;
+	event->dt = dt;
+	event->obj = obj;
+	event->item = item;
+}
+
+/** Start collecting profile data for the objects and classes that exist now
+	@return SUCCESS or FAILED
+ **/
+STATUS profile_init(void)
+{
+	OBJECT *obj;
+	if ( ready )
+		return SUCCESS;
+	n_classes = class_get_count();
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		if ( obj->id>=n_objects ) n_objects = obj->id+1;
+	objects = (PROFILEOBJECT*)calloc(n_objects>0?n_objects:1,sizeof(PROFILEOBJECT));
+	if ( objects==NULL || pthread_key_create(&thread_key,NULL)!=0 )
+	{
+		output_error("profiler initialization failed");
+		/* TROUBLESHOOT
+			The profiler could not allocate the per-object statistics table or its thread buffers.
+			Follow the standard process for freeing up memory or disable the profiler and try again.
+		 */
+		free(objects);
+		objects = NULL;
+		return FAILED;
+	}
+	tracing = global_profile_trace[0]!='\0';
+	t_start = profile_clock();
+	ready = true;
+	return SUCCESS;
+}
+
+/** Record an object callback that started at \p t0
+	@return the duration of the callback (ns)
+ **/
+int64 profile_object(OBJECT *obj, /**< the object */
+					 OBJECTPROFILEITEM item, /**< the callback */
+					 int64 t0) /**< the profile_clock() time at which the callback started */
+{
+	int64 dt = profile_clock()-t0;
+	PROFILETHREAD *pt;
+	if ( !ready || (pt=profile_thread())==NULL )
+		return dt;
+	if ( (unsigned int)obj->oclass->id<n_classes )
+		hist_add(&pt->classes[obj->oclass->id*_OPI_NUMITEMS+item],dt);
+	if ( item<=OPI_POSTSYNC && obj->id<n_objects )
+	{
+		PROFILEOBJECT *po = &objects[obj->id];
+		hist_add(&po->sync,dt);
+		po->count[item]++;
+		po->total[item] += dt;
+	}
+	if ( tracing )
+		profile_trace(pt,obj,item,t0,dt);
+	return dt;
+}
+
+/** Record a core activity that started at \p t0
+	@return the time at which the activity ended, to use as the start of the next one
+ **/
+int64 profile_internal(PROFILEINTERNAL item, /**< the activity */
+					   int64 t0) /**< the profile_clock() time at which the activity started */
+{
+	int64 t1 = profile_clock();
+	PROFILETHREAD *pt;
+	if ( !ready || (pt=profile_thread())==NULL )
+		return t1;
+	hist_add(&pt->internals[item],t1-t0);
+	if ( tracing )
+		profile_trace(pt,NULL,item,t0,t1-t0);
+	return t1;
+}
+
+static void write_row(FILE *fp, const char *section, const char *name, const char *item, PROFILEHIST *h)
+{
+	fprintf(fp,"%s,%s,%s,%"FMT_INT64"d,%.6f,%.3f,%.3f,%.3f,%.3f,%.3f\n", section, name, item,
+		h->count, h->total/1e9, h->count>0?h->total/1e3/h->count:0.0,
+		hist_percentile(h,0.50)/1e3, hist_percentile(h,0.90)/1e3, hist_percentile(h,0.99)/1e3, h->max/1e3);
+}
+
+static STATUS write_summary(const char *fname, PROFILEHIST *classes)
+{
+	PROFILETHREAD *pt;
+	PROFILEHIST pass[OPI_POSTSYNC+1], internals[_PRI_NUMITEMS];
+	CLASS *oclass;
+	OBJECT *obj;
+	int64 *rank_count = NULL, *rank_total = NULL;
+	unsigned int n, item, max_rank = 0;
+	char name[1024];
+	FILE *fp = fopen(fname,"w");
+	if ( fp==NULL )
+	{
+		output_error("unable to open profile summary file '%s'", fname);
+		/* TROUBLESHOOT
+			The file named by the profile_summary global could not be opened for writing.
+			Check the file name and the permissions of the folder and try again.
+		 */
+		return FAILED;
+	}
+	fprintf(fp,"# GridLAB-D profile summary\n");
+	fprintf(fp,"# model: %s\n", global_modelname);
+	fprintf(fp,"# threads: %d, objects: %d\n", n_threads, n_objects);
+	fprintf(fp,"section,name,item,count,total_s,mean_us,p50_us,p90_us,p99_us,max_us\n");
+
+	/* classes and passes */
+	memset(pass,0,sizeof(pass));
+	for ( oclass=class_get_first_class() ; oclass!=NULL ; oclass=oclass->next )
+	{
+		if ( (unsigned int)oclass->id>=n_classes ) continue;
+		for ( item=0 ; item<_OPI_NUMITEMS ; item++ )
+		{
+			PROFILEHIST *h = &classes[oclass->id*_OPI_NUMITEMS+item];
+			if ( h->count==0 ) continue;
+			write_row(fp,"class",oclass->name,object_item[item],h);
+			if ( item<=OPI_POSTSYNC )
+				hist_merge(&pass[item],h);
+		}
+	}
+	for ( item=0 ; item<=OPI_POSTSYNC ; item++ )
+		if ( pass[item].count>0 )
+			write_row(fp,"pass","all",object_item[item],&pass[item]);
+
+	/* ranks */
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		if ( (unsigned int)obj->rank>max_rank ) max_rank = obj->rank;
+	rank_count = (int64*)calloc((max_rank+1)*(OPI_POSTSYNC+1),sizeof(int64));
+	rank_total = (int64*)calloc((max_rank+1)*(OPI_POSTSYNC+1),sizeof(int64));
+	if ( rank_count!=NULL && rank_total!=NULL )
+	{
+		for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		{
+			if ( obj->id>=n_objects ) continue;
+			for ( item=0 ; item<=OPI_POSTSYNC ; item++ )
+			{
+				rank_count[obj->rank*(OPI_POSTSYNC+1)+item] += objects[obj->id].count[item];
+				rank_total[obj->rank*(OPI_POSTSYNC+1)+item] += objects[obj->id].total[item];
+			}
+		}
+		for ( n=0 ; n<=max_rank ; n++ )
+		{
+			for ( item=0 ; item<=OPI_POSTSYNC ; item++ )
+			{
+				int64 count = rank_count[n*(OPI_POSTSYNC+1)+item];
+				int64 total = rank_total[n*(OPI_POSTSYNC+1)+item];
+				if ( count==0 ) continue;
+				fprintf(fp,"rank,%d,%s,%"FMT_INT64"d,%.6f,%.3f,,,,\n", n, object_item[item], count, total/1e9, total/1e3/count);
+			}
+		}
+	}
+	free(rank_count);
+	free(rank_total);
+
+	/* core activities */
+	memset(internals,0,sizeof(internals));
+	for ( pt=first_thread ; pt!=NULL ; pt=pt->next )
+		for ( item=0 ; item<_PRI_NUMITEMS ; item++ )
+			hist_merge(&internals[item],&pt->internals[item]);
+	for ( item=0 ; item<_PRI_NUMITEMS ; item++ )
+		if ( internals[item].count>0 )
+			write_row(fp,"internal","core",internal_item[item],&internals[item]);
+
+	/* threads */
+	for ( n=0 ; n<n_threads ; n++ )
+	{
+		PROFILEHIST total;
+		memset(&total,0,sizeof(total));
+		for ( pt=first_thread ; pt!=NULL && pt->id!=n ; pt=pt->next ) {}
+		if ( pt==NULL ) continue;
+		for ( item=0 ; item<n_classes*_OPI_NUMITEMS ; item++ )
+			hist_merge(&total,&pt->classes[item]);
+		sprintf(name,"%d",n);
+		write_row(fp,"thread",name,"all",&total);
+	}
+
+	/* objects */
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+	{
+		if ( obj->id>=n_objects || objects[obj->id].sync.count==0 ) continue;
+		write_row(fp,"object",object_name(obj,name,sizeof(name)-1),"sync",&objects[obj->id].sync);
+	}
+	fclose(fp);
+	output_verbose("profile summary written to '%s'", fname);
+	return SUCCESS;
+}
+
+/* copy a name for use in a JSON string */
+static const char *json_name(const char *in, char *out, size_t len)
+{
+	size_t n;
+	for ( n=0 ; in[n]!='\0' && n<len-1 ; n++ )
+		out[n] = ( in[n]=='"' || in[n]=='\\' || in[n]<' ' ) ? '_' : in[n];
+	out[n] = '\0';
+	return out;
+}
+
+static STATUS write_trace(const char *fname)
+{
+	PROFILETHREAD *pt;
+	unsigned int n;
+	char name[1024], buffer[1024];
+	const char *sep = "";
+	FILE *fp = fopen(fname,"w");
+	if ( fp==NULL )
+	{
+		output_error("unable to open profile trace file '%s'", fname);
+		/* TROUBLESHOOT
+			The file named by the profile_trace global could not be opened for writing.
+			Check the file name and the permissions of the folder and try again.
+		 */
+		return FAILED;
+	}
+	fprintf(fp,"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	for ( pt=first_thread ; pt!=NULL ; pt=pt->next )
+	{
+		fprintf(fp,"%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", sep, pt->id, pt->id);
+		sep = ",";
+		for ( n=0 ; n<pt->n_trace ; n++ )
+		{
+			PROFILEEVENT *event = &pt->trace[n];
+			if ( event->obj==NULL )
+				fprintf(fp,",\n{\"name\":\"%s\",\"cat\":\"core\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+					internal_item[event->item], pt->id, event->t0/1e3, event->dt/1e3);
+			else
+				fprintf(fp,",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"class\":\"%s\",\"rank\":%d}}",
+					json_name(object_name(event->obj,buffer,sizeof(buffer)-1),name,sizeof(name)), object_item[event->item],
+					pt->id, event->t0/1e3, event->dt/1e3, event->obj->oclass->name, event->obj->rank);
+		}
+		if ( pt->overflow )
+			output_warning("profiler thread %d trace was truncated at %d events (see profile_trace_limit)", pt->id, pt->n_trace);
+			/* TROUBLESHOOT
+				The trace buffer of a thread reached the number of events allowed by the profile_trace_limit global,
+				or memory for it could not be allocated, and later events were not recorded in the trace.
+				Increase profile_trace_limit or profile a shorter run to get a complete trace.
+			 */
+	}
+	fprintf(fp,"\n]}\n");
+	fclose(fp);
+	output_verbose("profile trace written to '%s'", fname);
+	return SUCCESS;
+}
+
+/** Merge the thread buffers, update the class profiler totals, and
+	write the profile summary and trace files, if any
+	@return SUCCESS or FAILED
+ **/
+STATUS profile_export(void)
+{
+	PROFILETHREAD *pt;
+	PROFILEHIST *classes;
+	CLASS *oclass;
+	unsigned int n;
+	STATUS rv = SUCCESS;
+	if ( !ready )
+		return SUCCESS;
+
+	/* merge class histograms */
+	classes = (PROFILEHIST*)calloc(n_classes*_OPI_NUMITEMS+1,sizeof(PROFILEHIST));
+	if ( classes==NULL )
+	{
+		output_error("profiler merge failed (memory allocation failed)");
+		/* TROUBLESHOOT
+			The profiler could not allocate memory to merge the data collected by each thread.
+			Follow the standard process for freeing up memory and try again.
+		 */
+		return FAILED;
+	}
+	for ( pt=first_thread ; pt!=NULL ; pt=pt->next )
+		for ( n=0 ; n<n_classes*_OPI_NUMITEMS ; n++ )
+			hist_merge(&classes[n],&pt->classes[n]);
+	for ( oclass=class_get_first_class() ; oclass!=NULL ; oclass=oclass->next )
+	{
+		if ( (unsigned int)oclass->id>=n_classes ) continue;
+		oclass->profiler.count = 0;
+		oclass->profiler.clocks = 0;
+		for ( n=0 ; n<_OPI_NUMITEMS ; n++ )
+		{
+			oclass->profiler.count += (int32)classes[oclass->id*_OPI_NUMITEMS+n].count;
+			oclass->profiler.clocks += classes[oclass->id*_OPI_NUMITEMS+n].total;
+		}
+	}
+
+	if ( global_profile_summary[0]!='\0' && write_summary(global_profile_summary,classes)==FAILED )
+		rv = FAILED;
+	if ( tracing && write_trace(global_profile_trace)==FAILED )
+		rv = FAILED;
+	free(classes);
+	return rv;
+}
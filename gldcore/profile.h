@@ -0,0 +1,39 @@
+/* profile.h
+ * Copyright (C) 2016 Battelle Memorial Institute
+ * High-resolution profiler
+ */
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include "globals.h"
+#include "object.h"
+
+/* core activities timed by the profiler that are not object callbacks */
+typedef enum {
+	PRI_LINK,
+	PRI_INSTANCE,
+	PRI_RANDOMVAR,
+	PRI_SCHEDULE,
+	PRI_LOADSHAPE,
+	PRI_TRANSFORM,
+	PRI_ENDUSE,
+	PRI_HEARTBEAT,
+	_PRI_NUMITEMS,
+} PROFILEINTERNAL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64 profile_clock(void);
+STATUS profile_init(void);
+int64 profile_object(OBJECT *obj, OBJECTPROFILEITEM item, int64 t0);
+int64 profile_internal(PROFILEINTERNAL item, int64 t0);
+STATUS profile_export(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -888,6 +888,7 @@ typedef uint32 PROPERTYFLAGS;
 #define PF_RECALC	0x0001 /**< property has a recalc trigger (only works if recalc_<class> is exported) */
 #define PF_CHARSET	0x0002 /**< set supports single character keywords (avoids use of |) */
 #define PF_EXTENDED 0x0004 /**< indicates that the property was added at runtime */
+#define PF_ACTIVATE 0x0008 /**< setting the property reactivates the object when sparse sync is enabled */
 #define PF_DEPRECATED 0x8000 /**< set this flag to indicate that the property is deprecated (warning will be displayed anytime it is used */
 #define PF_DEPRECATED_NONOTICE 0x04000 /**< set this flag to indicate that the property is deprecated but no reference warning is desired */
 
@@ -0,0 +1,464 @@
+/** $Id: propview.c
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file propview.c
+	@addtogroup propview
+	@ingroup core
+
+	Bulk copying of property values between objects and typed buffers
+	(see propview.h).
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "platform.h"
+#include "output.h"
+#include "globals.h"
+#include "class.h"
+#include "object.h"
+#include "property.h"
+#include "lock.h"
+
+#include "propview.h"
+
+/** Check whether a property can be viewed
+	@return true if values of the property type can be copied as is
+ **/
+bool propview_can_view(PROPERTY *prop) /**< the property */
+{
+	switch ( prop->ptype ) {
+	case PT_double:
+	case PT_complex:
+	case PT_enumeration:
+	case PT_set:
+	case PT_int16:
+	case PT_int32:
+	case PT_int64:
+	case PT_char8:
+	case PT_char32:
+	case PT_char256:
+	case PT_char1024:
+	case PT_object:
+	case PT_bool:
+	case PT_timestamp:
+	case PT_real:
+	case PT_float:
+		return true;
+	default: /* the others hold pointers or state */
+		return false;
+	}
+}
+
+/** Create a view of properties of a class
+	@return the view, or NULL if a property is not found or cannot be viewed
+ **/
+PROPVIEW *propview_create(CLASS *oclass, /**< the class of the objects that will be viewed */
+						  char *proplist) /**< comma-separated list of property names */
+{
+	PROPVIEW *view;
+	char list[1024], *name, *next, *last = NULL;
+	unsigned int n;
+
+	if ( oclass==NULL || proplist==NULL )
+		return NULL;
+	if ( strlen(proplist)>=sizeof(list) )
+	{
+		output_error("propview_create(oclass='%s',...): property list is too long", oclass->name);
+		/* TROUBLESHOOT
+			A property view was requested for more properties than the list can hold.
+			Split the properties among several views.
+		 */
+		return NULL;
+	}
+	strcpy(list,proplist);
+
+	view = (PROPVIEW*)malloc(sizeof(PROPVIEW));
+	if ( view==NULL )
+	{
+		output_error("propview_create(oclass='%s',...): memory allocation failed", oclass->name);
+		/* TROUBLESHOOT
+			The system has run out of memory.  Try making the model smaller and try again.
+		 */
+		return NULL;
+	}
+	memset(view,0,sizeof(PROPVIEW));
+	view->oclass = oclass;
+	view->writable = true;
+
+	/* the number of properties is at most one more than the number of separators */
+	for ( n=1, next=list ; (next=strpbrk(next,", \t"))!=NULL ; next++ )
+		n++;
+	view->prop = (PROPERTY**)malloc(sizeof(PROPERTY*)*n);
+	view->width = (size_t*)malloc(sizeof(size_t)*n);
+	if ( view->prop==NULL || view->width==NULL )
+	{
+		output_error("propview_create(oclass='%s',...): memory allocation failed", oclass->name);
+		/* TROUBLESHOOT
+			The system has run out of memory.  Try making the model smaller and try again.
+		 */
+		propview_destroy(view);
+		return NULL;
+	}
+
+	for ( name=strtok_s(list,", \t",&last) ; name!=NULL ; name=strtok_s(NULL,", \t",&last) ) /* callers may be tokenizing too */
+	{
+		PROPERTY *prop = class_find_property(oclass,name);
+		if ( prop==NULL )
+		{
+			output_error("propview_create(oclass='%s',...): property '%s' is not found", oclass->name, name);
+			/* TROUBLESHOOT
+				A property view was requested for a property the class does not have.
+				Check the spelling of the property name and the class of the objects viewed.
+			 */
+			propview_destroy(view);
+			return NULL;
+		}
+		if ( !propview_can_view(prop) )
+		{
+			output_error("propview_create(oclass='%s',...): property '%s' has type '%s', which cannot be viewed", oclass->name, name, class_get_property_typename(prop->ptype));
+			/* TROUBLESHOOT
+				Property views only copy values that do not refer to other storage.
+				Use object_get_value_by_name() or object_set_value_by_name() to access this property.
+			 */
+			propview_destroy(view);
+			return NULL;
+		}
+		if ( prop->access!=PA_PUBLIC || prop->notify!=NULL )
+			view->writable = false;
+		view->prop[view->n_props] = prop;
+		view->width[view->n_props] = property_size(prop) * (prop->size>0 ? prop->size : 1);
+		view->n_props++;
+	}
+	if ( view->n_props==0 )
+	{
+		output_error("propview_create(oclass='%s',...): property list is empty", oclass->name);
+		/* TROUBLESHOOT
+			A property view was requested without naming any properties.
+		 */
+		propview_destroy(view);
+		return NULL;
+	}
+	return view;
+}
+
+/** Destroy a property view
+ **/
+void propview_destroy(PROPVIEW *view)
+{
+	if ( view==NULL )
+		return;
+	free(view->prop);
+	free(view->width);
+	free(view);
+}
+
+/* a block of objects copied by one thread */
+typedef struct s_propviewblock {
+	PROPVIEW *view;
+	OBJECT **obj;
+	void **column;
+	size_t first, last; /* objects first to last-1 are copied */
+	bool write;
+	size_t done; /* number of objects copied */
+	pthread_t pt;
+	bool ok; /* thread was started */
+} PROPVIEWBLOCK;
+
+/* copy a block of objects, one object at a time so each is locked once */
+static void *propview_copy(void *arg)
+{
+	PROPVIEWBLOCK *block = (PROPVIEWBLOCK*)arg;
+	PROPVIEW *view = block->view;
+	int locking = (global_threadcount>1);
+	CLASS *last_class = NULL;
+	bool last_ok = false;
+	size_t i;
+	unsigned int p;
+
+	for ( i=block->first ; i<block->last ; i++ )
+	{
+		OBJECT *obj = block->obj[i];
+		char *data;
+		if ( obj==NULL )
+			continue;
+
+		/* check the class only when it changes */
+		if ( obj->oclass!=last_class )
+		{
+			CLASS *oclass;
+			last_class = obj->oclass;
+			for ( oclass=last_class ; oclass!=NULL && oclass!=view->oclass ; oclass=oclass->parent ) {}
+			last_ok = ( oclass!=NULL && !(block->write && last_class->notify!=NULL) );
+		}
+		if ( !last_ok )
+			continue;
+
+		data = (char*)(obj+1);
+		if ( block->write )
+		{
+			if ( locking ) wlock(&obj->lock);
+			for ( p=0 ; p<view->n_props ; p++ )
+				memcpy(data+(size_t)(view->prop[p]->addr),(char*)block->column[p]+i*view->width[p],view->width[p]);
+			if ( locking ) wunlock(&obj->lock);
+
+			/* recalc and reactivate the object as object_set_value_by_name() would */
+			for ( p=0 ; p<view->n_props ; p++ )
+				object_property_changed(obj,view->prop[p]);
+		}
+		else
+		{
+			if ( locking ) rlock(&obj->lock);
+			for ( p=0 ; p<view->n_props ; p++ )
+				memcpy((char*)block->column[p]+i*view->width[p],data+(size_t)(view->prop[p]->addr),view->width[p]);
+			if ( locking ) runlock(&obj->lock);
+		}
+		block->done++;
+	}
+	return NULL;
+}
+
+/* split the objects among threads and copy them */
+static size_t propview_run(PROPVIEW *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads, bool write)
+{
+	PROPVIEWBLOCK one, *block = &one;
+	size_t n_items, done = 0;
+	unsigned int n;
+
+	if ( view==NULL || obj==NULL || column==NULL || n_objects==0 )
+		return 0;
+
+	/* use no more threads than there are blocks of PROPVIEW_MINBLOCK objects */
+	if ( n_threads==0 )
+		n_threads = global_threadcount;
+	if ( n_threads>n_objects/PROPVIEW_MINBLOCK )
+		n_threads = (unsigned int)(n_objects/PROPVIEW_MINBLOCK);
+	if ( n_threads<2 )
+		n_threads = 1;
+	else
+	{
+		block = (PROPVIEWBLOCK*)malloc(sizeof(PROPVIEWBLOCK)*n_threads);
+		if ( block==NULL )
+		{
+			block = &one;
+			n_threads = 1;
+		}
+	}
+	memset(block,0,sizeof(PROPVIEWBLOCK)*n_threads);
+
+	/* assign objects to each block */
+	n_items = (n_objects+n_threads-1)/n_threads;
+	for ( n=0 ; n<n_threads ; n++ )
+	{
+		block[n].view = view;
+		block[n].obj = obj;
+		block[n].column = column;
+		block[n].write = write;
+		block[n].first = n*n_items;
+		block[n].last = (n+1)*n_items<n_objects ? (n+1)*n_items : n_objects;
+	}
+
+	/* the first block is done by the caller, the others by new threads if they can be started */
+	for ( n=1 ; n<n_threads ; n++ )
+		block[n].ok = ( pthread_create(&(block[n].pt),NULL,propview_copy,&(block[n]))==0 );
+	propview_copy(&(block[0]));
+	for ( n=0 ; n<n_threads ; n++ )
+	{
+		if ( n>0 )
+		{
+			if ( block[n].ok )
+				pthread_join(block[n].pt,NULL);
+			else
+				propview_copy(&(block[n]));
+		}
+		done += block[n].done;
+	}
+	if ( block!=&one )
+		free(block);
+	return done;
+}
+
+/** Copy the viewed property values of objects into columns
+	@return the number of objects copied; objects that are NULL or not of the view's class are skipped
+ **/
+size_t propview_gather(PROPVIEW *view, /**< the property view */
+					   OBJECT **obj, /**< the objects */
+					   size_t n_objects, /**< the number of objects */
+					   void **column, /**< one buffer per property, each large enough for n_objects values */
+					   unsigned int n_threads) /**< the most threads to use, 0 for global threadcount */
+{
+	return propview_run(view,obj,n_objects,column,n_threads,false);
+}
+
+/** Copy values from columns into the viewed properties of objects
+	@return the number of objects copied, or 0 if the view is not writable; objects that
+	are NULL, not of the view's class or of a class with a notifier are skipped
+ **/
+size_t propview_scatter(PROPVIEW *view, /**< the property view */
+						OBJECT **obj, /**< the objects */
+						size_t n_objects, /**< the number of objects */
+						void **column, /**< one buffer per property, each holding n_objects values */
+						unsigned int n_threads) /**< the most threads to use, 0 for global threadcount */
+{
+	if ( view!=NULL && !view->writable )
+	{
+		output_error("propview_scatter(view.oclass='%s',...): view includes properties that are not public or have notifiers", view->oclass->name);
+		/* TROUBLESHOOT
+			Values can only be scattered directly into public properties that do not notify
+			the object when they change.  Remove those properties from the view and set them
+			using object_set_value_by_name() instead.
+		 */
+		return 0;
+	}
+	return propview_run(view,obj,n_objects,column,n_threads,true);
+}
+
+/************************************************************************
+ * SELF-TEST
+ */
+
+/* check a view of all the plain properties of a class against the objects of the class */
+static int propview_test_class(CLASS *oclass, OBJECT **obj, size_t n_objects, unsigned int n_threads)
+{
+	char list[1024] = "";
+	PROPVIEW *view;
+	PROPERTY *prop;
+	void **column;
+	size_t i, n;
+	unsigned int p;
+	CLASS *pclass;
+	int failed = 0;
+
+	/* classes that publish no properties of their own start with those of a parent class */
+	for ( pclass=oclass ; pclass!=NULL && pclass->pmap==NULL ; pclass=pclass->parent ) {}
+	for ( prop=pclass?pclass->pmap:NULL ; prop!=NULL ; prop=(prop->next?prop->next:(prop->oclass->parent?prop->oclass->parent->pmap:NULL)) )
+	{
+		if ( propview_can_view(prop) && strlen(list)+strlen(prop->name)+2<sizeof(list) )
+		{
+			if ( list[0]!='\0' ) strcat(list,",");
+			strcat(list,prop->name);
+		}
+	}
+	if ( list[0]=='\0' )
+		return 0;
+	view = propview_create(oclass,list);
+	if ( view==NULL )
+	{
+		output_test("!!! class %s: view of '%s' could not be created", oclass->name, list);
+		return 1;
+	}
+
+	column = (void**)calloc(view->n_props,sizeof(void*));
+	for ( p=0 ; column!=NULL && p<view->n_props ; p++ )
+	{
+		if ( (column[p]=malloc(view->width[p]*n_objects))==NULL )
+			break;
+	}
+	if ( column==NULL || p<view->n_props )
+	{
+		output_test("!!! class %s: memory allocation failed", oclass->name);
+		for ( p=0 ; column!=NULL && p<view->n_props ; p++ )
+			free(column[p]);
+		free(column);
+		propview_destroy(view);
+		return 1;
+	}
+
+	/* gathered values must match the objects */
+	n = propview_gather(view,obj,n_objects,column,n_threads);
+	if ( n!=n_objects )
+	{
+		output_test("!!! class %s: %d of %d objects gathered", oclass->name, (int)n, (int)n_objects);
+		failed++;
+	}
+	for ( i=0 ; i<n_objects ; i++ )
+	{
+		for ( p=0 ; p<view->n_props ; p++ )
+		{
+			if ( memcmp((char*)column[p]+i*view->width[p],(char*)(obj[i]+1)+(size_t)(view->prop[p]->addr),view->width[p])!=0 )
+			{
+				output_test("!!! class %s: object %d property %s gathered incorrectly", oclass->name, obj[i]->id, view->prop[p]->name);
+				failed++;
+			}
+		}
+	}
+
+	/* scattering the same values back must succeed if the view is writable and change nothing */
+	if ( view->writable && oclass->notify==NULL )
+	{
+		n = propview_scatter(view,obj,n_objects,column,n_threads);
+		if ( n!=n_objects )
+		{
+			output_test("!!! class %s: %d of %d objects scattered", oclass->name, (int)n, (int)n_objects);
+			failed++;
+		}
+	}
+
+	for ( p=0 ; p<view->n_props ; p++ )
+		free(column[p]);
+	free(column);
+	output_test("class %s: %d objects, %d properties, %d threads, %s", oclass->name, (int)n_objects, view->n_props, n_threads, failed?"FAILED":"ok");
+	propview_destroy(view);
+	return failed;
+}
+
+/** Test property views on the objects in the model
+	@return the number of failures
+ **/
+int propview_test(void)
+{
+	CLASS *oclass;
+	OBJECT **obj = (OBJECT**)malloc(sizeof(OBJECT*)*(object_get_count()+1));
+	int failed = 0, ok = 0;
+
+	output_test("\nBEGIN: property view tests");
+	if ( obj==NULL )
+	{
+		output_test("!!! memory allocation failed");
+		return 1;
+	}
+	for ( oclass=class_get_first_class() ; oclass!=NULL ; oclass=oclass->next )
+	{
+		OBJECT *o;
+		size_t n = 0;
+		int result;
+		for ( o=object_get_first() ; o!=NULL ; o=o->next )
+		{
+			if ( o->oclass==oclass )
+				obj[n++] = o;
+		}
+		if ( n==0 )
+			continue;
+		result = propview_test_class(oclass,obj,n,1);
+		if ( n>=2*PROPVIEW_MINBLOCK )
+			result += propview_test_class(oclass,obj,n,global_threadcount>1?global_threadcount:2);
+		if ( result>0 )
+			failed++;
+		else
+			ok++;
+	}
+	free(obj);
+	if ( failed+ok==0 )
+	{
+		output_test("!!! the model has no objects to view");
+		failed++;
+	}
+
+	/* report results */
+	if ( failed )
+	{
+		output_error("propview_test: %d property view tests failed--see test.txt for more information",failed);
+		output_test("!!! %d property view tests failed",failed);
+	}
+	else
+	{
+		output_verbose("%d property view tests completed with no errors--see test.txt for details",ok);
+		output_test("propview_test: %d property view tests completed with no errors",ok);
+	}
+	output_test("END: property view tests");
+	return failed;
+}
+
+/**@}**/
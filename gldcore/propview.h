@@ -0,0 +1,78 @@
+/** $Id: propview.h
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file propview.h
+	@addtogroup propview Property views
+	@ingroup core
+
+	A property view resolves a list of properties of a class once, and
+	then copies the values of those properties for many objects at a time
+	between the objects and contiguous typed buffers, one buffer (column)
+	per property.  Views are meant for code that reads or writes the same
+	properties of many objects every time it runs, which would otherwise
+	look up and convert each value by name.  The HTTP server's \p /view/
+	requests, the aggregations of constant collector groups, the recorders
+	and group recorders, and the engine link's exports and imports use
+	them.  Modules reach views through \p callback->propview (see
+	gld_propview in gridlabd.h), and propview_can_view() tells whether a
+	property can be viewed before a view of it is created.
+
+	@code
+	PROPVIEW *view = propview_create(oclass,"voltage_A,power_A");
+	complex *voltage = malloc(sizeof(complex)*n), *power = malloc(sizeof(complex)*n);
+	void *column[] = {voltage,power};
+	propview_gather(view,objects,n,column,0);
+	@endcode
+
+	Column \e i of a view holds one value of property \e i per object, in
+	the order the objects are given, and each value has the property's own
+	representation (see PROPVIEW::width).  Only properties whose values do
+	not refer to other storage can be viewed: \p double, \p complex,
+	\p enumeration, \p set, integers, fixed-length strings, \p object,
+	\p bool, \p timestamp, \p real and \p float, including arrays of these.
+	Values of \p object properties are copied as object pointers.
+
+	Scattering copies values into objects without conversion, so it is
+	only allowed for views whose properties are all public and have no
+	notifier, and it skips objects of classes that have a notifier.  Each
+	object scattered into is flagged for recalculation and reactivated for
+	sparse sync just as object_set_value_by_name() does (see
+	object_property_changed()).  Use object_set_value_by_name() for
+	anything else.
+
+ @{
+ **/
+
+#ifndef _PROPVIEW_H
+#define _PROPVIEW_H
+
+#include "class.h"
+#include "object.h"
+
+#define PROPVIEW_MINBLOCK 4096 /**< smallest number of objects given to a thread */
+
+typedef struct s_propview {
+	CLASS *oclass; /**< class the view was created for (objects may be of derived classes) */
+	unsigned int n_props; /**< number of properties in the view */
+	PROPERTY **prop; /**< properties in the order they were listed */
+	size_t *width; /**< size in bytes of a value of each property (arrays included) */
+	bool writable; /**< true if values may be scattered into objects */
+} PROPVIEW; /**< property view */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool propview_can_view(PROPERTY *prop);
+PROPVIEW *propview_create(CLASS *oclass, char *proplist);
+void propview_destroy(PROPVIEW *view);
+size_t propview_gather(PROPVIEW *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+size_t propview_scatter(PROPVIEW *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+int propview_test(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/**@}**/
@@ -0,0 +1,379 @@
+/* replicate.c
+ * Copyright (C) 2016 Battelle Memorial Institute
+ *
+ * Monte Carlo replication driver.
+ *
+ * When the global replications is greater than 1, the model is loaded and
+ * initialized once and the main loop is then run by a set of worker processes
+ * forked from the initialized model.  Each worker reseeds the random number
+ * state of every object (and the global random seed) from the replication index
+ * so that eventgen and other stochastic objects draw distinct streams.  At the end
+ * of each replication the values listed in replication_metrics are written to
+ * a shared results table, and the parent process writes a summary report with
+ * the mean, standard deviation and 95% confidence interval of each metric.
+ *
+ * Files opened by objects during initialization are shared by all workers,
+ * so recorders and other file writers should be disabled or made replication
+ * specific when replicating.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#include "replicate.h"
+#include "output.h"
+#include "object.h"
+#include "threadpool.h"
+
+#define MAXMETRICS 64
+
+typedef struct s_replicatemetric {
+	char name[256]; /**< metric name as given in replication_metrics */
+	OBJECT *obj; /**< object, or NULL for a global variable */
+	char property[64]; /**< property or global name */
+	double *addr; /**< direct address of double properties */
+} REPLICATEMETRIC;
+
+static REPLICATEMETRIC metric[MAXMETRICS];
+static int n_metrics = 0;
+static int n_replications = 0;
+static int *result_status = NULL; /**< shared replication status (0 not run, 1 success, -1 failed) */
+static double *result_value = NULL; /**< shared replication values [replication][metric] */
+static size_t result_size = 0;
+
+/* parse the replication_metrics list and resolve each entry */
+static int replicate_metrics(void)
+{
+	char list[1024], *item, *next;
+	strncpy(list,global_replication_metrics,sizeof(list)-1);
+	list[sizeof(list)-1] = '\0';
+	n_metrics = 0;
+	for ( item=list ; item!=NULL && *item!='\0' ; item=next )
+	{
+		char *dot;
+		REPLICATEMETRIC *m;
+		next = strchr(item,',');
+		if ( next!=NULL )
+			*next++ = '\0';
+		while ( *item==' ' ) item++;
+		if ( *item=='\0' )
+			continue;
+		if ( n_metrics==MAXMETRICS )
+		{
+			output_error("replication_metrics lists more than %d metrics", MAXMETRICS);
+			/* TROUBLESHOOT
+				The replication driver can only collect a limited number of values from each replication.
+				Reduce the number of entries in the replication_metrics global and try again.
+			 */
+			return 0;
+		}
+		m = &metric[n_metrics];
+		memset(m,0,sizeof(REPLICATEMETRIC));
+		strncpy(m->name,item,sizeof(m->name)-1);
+		dot = strchr(m->name,'.');
+		if ( dot==NULL )
+		{
+			char buffer[1024];
+			if ( global_getvar(m->name,buffer,sizeof(buffer))==NULL )
+			{
+				output_error("replication metric '%s' is not a global variable", m->name);
+				/* TROUBLESHOOT
+					An entry in the replication_metrics global does not contain a period and does not name a global variable.
+					Use the form <i>object</i>.<i>property</i> to refer to an object property, or correct the global name.
+				 */
+				return 0;
+			}
+			strncpy(m->property,m->name,sizeof(m->property)-1);
+		}
+		else
+		{
+			PROPERTY *prop;
+			*dot = '\0';
+			m->obj = object_find_name(m->name);
+			strncpy(m->property,dot+1,sizeof(m->property)-1);
+			*dot = '.';
+			if ( m->obj==NULL )
+			{
+				output_error("replication metric '%s' refers to an object that does not exist", m->name);
+				/* TROUBLESHOOT
+					An entry in the replication_metrics global refers to an object name that is not defined in the model.
+					Correct the object name and try again.
+				 */
+				return 0;
+			}
+			prop = object_get_property(m->obj,m->property,NULL);
+			if ( prop==NULL )
+			{
+				output_error("replication metric '%s' refers to a property that does not exist", m->name);
+				/* TROUBLESHOOT
+					An entry in the replication_metrics global refers to a property that is not defined by the object's class.
+					Correct the property name and try again.
+				 */
+				return 0;
+			}
+			if ( prop->ptype==PT_double )
+				m->addr = object_get_double_by_name(m->obj,m->property);
+		}
+		n_metrics++;
+	}
+	return 1;
+}
+
+/* read the current value of a metric */
+static double replicate_value(REPLICATEMETRIC *m)
+{
+	char buffer[1024];
+	if ( m->addr!=NULL )
+		return *(m->addr);
+	if ( m->obj==NULL )
+		return global_getvar(m->property,buffer,sizeof(buffer))!=NULL ? atof(buffer) : QNAN;
+	return object_get_value_by_name(m->obj,m->property,buffer,sizeof(buffer))>0 ? atof(buffer) : QNAN;
+}
+
+/* mix the base seed with the replication index and object id */
+static unsigned int replicate_seed(unsigned int seed, unsigned int index, unsigned int id)
+{
+	unsigned int h = seed ^ (index*0x9e3779b9U) ^ (id*0x85ebca6bU);
+	h ^= h>>16; h *= 0x7feb352dU;
+	h ^= h>>15; h *= 0x846ca68bU;
+	h ^= h>>16;
+	return h|1; /* RNG3 state must be odd to keep its full period */
+}
+
+/* reseed the global and object random states for replication n */
+static void replicate_reseed(int n)
+{
+	OBJECT *obj;
+	global_randomseed = replicate_seed(global_randomseed,(unsigned int)n,0);
+	for ( obj=object_get_first() ; obj!=NULL ; obj=obj->next )
+		obj->rng_state = replicate_seed(global_randomseed,(unsigned int)n,obj->id+1);
+}
+
+/* two-sided 95% Student-t critical values for 1 to 30 degrees of freedom */
+static double t95(int df)
+{
+	static double t[] = {12.706,4.303,3.182,2.776,2.571,2.447,2.365,2.306,2.262,2.228,
+		2.201,2.179,2.160,2.145,2.131,2.120,2.110,2.101,2.093,2.086,
+		2.080,2.074,2.069,2.064,2.060,2.056,2.052,2.048,2.045,2.042};
+	if ( df<1 ) return QNAN;
+	if ( df<=30 ) return t[df-1];
+	if ( df<=60 ) return 2.000;
+	if ( df<=120 ) return 1.980;
+	return 1.960;
+}
+
+/** Starts the Monte Carlo replications of the initialized model.
+	Must be called after init_all() and before any helper threads are started.
+	@return 0 in the parent once all replications are complete, the replication
+	number (1..N) in a worker process, or -1 on failure.
+ **/
+int replicate_start(void)
+{
+#ifdef WIN32
+	output_error("Monte Carlo replications are not supported on this platform");
+	/* TROUBLESHOOT
+		The replication driver uses worker processes forked from the initialized model, which
+		is not available on Windows.  Set replications to 0 or run the replications separately.
+	 */
+	return -1;
+#else
+	int running = 0, next = 1;
+	int workers = global_replication_workers>0 ? global_replication_workers : processor_count();
+	unsigned int seed;
+	size_t status_size;
+
+	n_replications = global_replications;
+	if ( !replicate_metrics() )
+		return -1;
+
+	/* results are shared so workers can report without a pipe protocol */
+	status_size = (sizeof(int)*n_replications+sizeof(double)-1)/sizeof(double)*sizeof(double);
+	result_size = status_size + sizeof(double)*n_replications*(n_metrics>0?n_metrics:1);
+	result_status = (int*)mmap(NULL,result_size,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0);
+	if ( result_status==MAP_FAILED )
+	{
+		result_status = NULL;
+		output_error("unable to allocate replication results table (%s)", strerror(errno));
+		/* TROUBLESHOOT
+			The shared memory used to collect the results of each replication could not be allocated.
+			Reduce the number of replications or metrics and try again.
+		 */
+		return -1;
+	}
+	memset(result_status,0,result_size);
+	result_value = (double*)((char*)result_status+status_size);
+
+	/* use a deterministic base seed so replications are reproducible */
+	seed = global_randomseed;
+	output_verbose("running %d replications using up to %d worker(s), base seed %u", n_replications, workers, seed);
+
+	/* flush buffered output so workers don't repeat it */
+	fflush(NULL);
+
+	while ( next<=n_replications || running>0 )
+	{
+		int status;
+		pid_t pid;
+
+		/* start workers up to the concurrency limit */
+		while ( next<=n_replications && running<workers )
+		{
+			pid = fork();
+			if ( pid==0 )
+			{
+				global_replication_index = next;
+				global_randomseed = seed;
+				replicate_reseed(next);
+				output_verbose("replication %d started (pid %d)", next, getpid());
+				return next;
+			}
+			else if ( pid<0 )
+			{
+				output_error("unable to start replication %d (%s)", next, strerror(errno));
+				/* TROUBLESHOOT
+					The operating system refused to create a worker process for a replication.
+					Reduce replication_workers and try again.
+				 */
+				result_status[next-1] = -1;
+				next++;
+				if ( running==0 ) continue;
+				break;
+			}
+			running++;
+			next++;
+		}
+
+		/* wait for a worker to finish */
+		if ( running>0 )
+		{
+			pid = waitpid(-1,&status,0);
+			if ( pid<0 )
+			{
+				if ( errno==EINTR ) continue;
+				output_error("replication wait failed (%s)", strerror(errno));
+			/* TROUBLESHOOT
+				The parent process was unable to wait for the replication workers to complete.
+				This is an operating system error and should be reported to the software developers.
+			 */
+				return -1;
+			}
+			running--;
+			if ( !WIFEXITED(status) || WEXITSTATUS(status)!=0 )
+				output_warning("replication worker %d exited abnormally", pid);
+		}
+	}
+	return 0;
+#endif
+}
+
+/** Completes a replication in a worker process.
+	Records the replication metrics in the shared results table and terminates the worker.
+ **/
+void replicate_done(STATUS status)
+{
+#ifndef WIN32
+	int n = global_replication_index;
+	if ( n<1 || n>n_replications || result_status==NULL )
+		return;
+	if ( status==SUCCESS )
+	{
+		int m;
+		for ( m=0 ; m<n_metrics ; m++ )
+			result_value[(n-1)*n_metrics+m] = replicate_value(&metric[m]);
+		result_status[n-1] = 1;
+	}
+	else
+		result_status[n-1] = -1;
+	output_verbose("replication %d %s", n, status==SUCCESS?"completed":"failed");
+	fflush(NULL);
+	_exit(status==SUCCESS?0:1);
+#endif
+}
+
+/** Writes the replication summary report.
+	@return SUCCESS if at least one replication completed and the report was written
+ **/
+STATUS replicate_report(void)
+{
+#ifdef WIN32
+	return FAILED;
+#else
+	int n, m, completed = 0;
+	FILE *fp;
+
+	for ( n=0 ; n<n_replications ; n++ )
+	{
+		if ( result_status[n]==1 )
+			completed++;
+		else
+			output_warning("replication %d did not complete and is excluded from the report", n+1);
+	}
+	if ( completed==0 )
+	{
+		output_error("no replication completed successfully");
+		/* TROUBLESHOOT
+			None of the Monte Carlo replications ran to completion.  Look at the messages
+			output by the workers for the cause of the failures and try again.
+		 */
+		munmap(result_status,result_size);
+		return FAILED;
+	}
+
+	fp = fopen(global_replication_report,"w");
+	if ( fp==NULL )
+	{
+		output_error("unable to open replication report '%s' (%s)", global_replication_report, strerror(errno));
+		/* TROUBLESHOOT
+			The replication report file could not be opened for writing.
+			Check the replication_report global and the file permissions and try again.
+		 */
+		munmap(result_status,result_size);
+		return FAILED;
+	}
+	fprintf(fp,"# %s replication report\n", global_modelname);
+	fprintf(fp,"# replications completed: %d of %d\n", completed, n_replications);
+	fprintf(fp,"# base random state: %u\n", global_randomseed);
+	fprintf(fp,"metric,count,mean,stdev,ci95_low,ci95_high,min,max\n");
+	for ( m=0 ; m<n_metrics ; m++ )
+	{
+		int count = 0;
+		double sum = 0, sum2 = 0, mean, var, half;
+		double lo = 0, hi = 0;
+		for ( n=0 ; n<n_replications ; n++ )
+		{
+			double x = result_value[n*n_metrics+m];
+			if ( result_status[n]!=1 || isnan(x) )
+				continue;
+			if ( count==0 || x<lo ) lo = x;
+			if ( count==0 || x>hi ) hi = x;
+			sum += x;
+			sum2 += x*x;
+			count++;
+		}
+		if ( count==0 )
+		{
+			fprintf(fp,"%s,0,,,,,,\n", metric[m].name);
+			continue;
+		}
+		mean = sum/count;
+		var = count>1 ? (sum2-sum*mean)/(count-1) : 0;
+		if ( var<0 ) var = 0;
+		half = count>1 ? t95(count-1)*sqrt(var/count) : 0;
+		fprintf(fp,"%s,%d,%g,%g,%g,%g,%g,%g\n", metric[m].name, count, mean, sqrt(var), mean-half, mean+half, lo, hi);
+		output_verbose("%s: mean %g, 95%% CI [%g,%g] over %d replications", metric[m].name, mean, mean-half, mean+half, count);
+	}
+	fclose(fp);
+	munmap(result_status,result_size);
+	result_status = NULL;
+	result_value = NULL;
+	return SUCCESS;
+#endif
+}
@@ -0,0 +1,23 @@
+/* replicate.h
+ * Copyright (C) 2016 Battelle Memorial Institute
+ * Monte Carlo replication driver
+ */
+
+#ifndef _REPLICATE_H
+#define _REPLICATE_H
+
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int replicate_start(void);
+STATUS replicate_report(void);
+void replicate_done(STATUS status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1316,6 +1316,12 @@ typedef struct s_callbacks {
 		unsigned int (*build)(void);
 		const char * (*branch)(void);
 	} version;
+	struct {
+		struct s_propview *(*create)(CLASS *oclass, char *proplist);
+		void (*destroy)(struct s_propview *view);
+		size_t (*gather)(struct s_propview *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+		size_t (*scatter)(struct s_propview *view, OBJECT **obj, size_t n_objects, void **column, unsigned int n_threads);
+	} propview;
 	long unsigned int magic; /* used to check structure alignment */
 } CALLBACKS; /**< core callback function table */
 
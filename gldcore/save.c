@@ -14,6 +14,7 @@
 #include "gui.h"
 #include "schedule.h"
 #include "transform.h"
+#include "load_bin.h"
 
 #define DEFAULT_FORMAT "gld"
 
@@ -32,6 +33,7 @@ int saveall(char *filename)
 		{"glm", saveglm},
 		//{"xml", savexml_strict},
 		{"xml", savexml},
+		{"gbm", saveall_bin},
 	};
 	int i;
 
@@ -74,7 +76,7 @@ int saveall(char *filename)
 
 	output_error("saveall: extension '.%s' not a known format", ext);
 	/*	TROUBLESHOOT
-		Only the format extensions ".txt", ".gld", and ".xml" are recognized by
+		Only the format extensions ".txt", ".gld", ".xml", and ".gbm" are recognized by
 		GridLAB-D.  Please end the specified output field accordingly, or omit the
 		extension entirely to force use of the default format.
 	*/
@@ -34,6 +34,7 @@
 #include "exec.h"
 #include "timestamp.h"
 #include "load.h"
+#include "propview.h"
 
 #include "legal.h"
 
@@ -1051,6 +1052,100 @@ int http_json_request(HTTPCNX *http,char *uri)
 	return 0;
 }
 
+/** Process an incoming property view request of the form \p class/prop1,prop2,...
+	and post the values of the properties for every object of the class as JSON columns
+	@returns non-zero on success, 0 on failure (errno set)
+ **/
+int http_view_request(HTTPCNX *http,char *uri)
+{
+	char classname[1024]="", proplist[1024]="";
+	CLASS *oclass;
+	PROPVIEW *view;
+	OBJECT *obj, **list;
+	void **column;
+	size_t n_objects=0, n;
+	unsigned int p;
+
+	if ( sscanf(uri,"%1023[^/\r\n]/%1023[^\r\n]",classname,proplist)<2 )
+		return 0;
+	http_decode(classname);
+	http_decode(proplist);
+
+	oclass = class_get_class_from_classname(classname);
+	if ( oclass==NULL )
+	{
+		http_format(http,"{error: \"class not found\", query: \"%s\"}\n", classname);
+		http_type(http,"text/json");
+		return 1;
+	}
+	view = propview_create(oclass,proplist);
+	if ( view==NULL )
+	{
+		http_format(http,"{error: \"property view failed\", class: \"%s\", query: \"%s\"}\n", classname, proplist);
+		http_type(http,"text/json");
+		return 1;
+	}
+
+	/* list the objects of the class and its derived classes */
+	list = (OBJECT**)malloc(sizeof(OBJECT*)*(object_get_count()+1));
+	column = (void**)malloc(sizeof(void*)*view->n_props);
+	if ( list==NULL || column==NULL )
+	{
+		free(list);
+		free(column);
+		propview_destroy(view);
+		return 0;
+	}
+	for ( obj=object_get_first() ; obj!=NULL ; obj=obj->next )
+	{
+		CLASS *c;
+		for ( c=obj->oclass ; c!=NULL && c!=oclass ; c=c->parent ) {}
+		if ( c!=NULL )
+			list[n_objects++] = obj;
+	}
+	for ( p=0 ; p<view->n_props ; p++ )
+	{
+		column[p] = malloc(view->width[p]*(n_objects+1));
+		if ( column[p]==NULL )
+		{
+			while ( p-->0 )
+				free(column[p]);
+			free(column);
+			free(list);
+			propview_destroy(view);
+			return 0;
+		}
+	}
+
+	/* post the response */
+	propview_gather(view,list,n_objects,column,0);
+	http_format(http,"{\"class\": \"%s\", \"count\": %u,\n\t\"id\": [", oclass->name, (unsigned int)n_objects);
+	for ( n=0 ; n<n_objects ; n++ )
+		http_format(http,"%s%u", n>0?",":"", list[n]->id);
+	http_format(http,"]");
+	for ( p=0 ; p<view->n_props ; p++ )
+	{
+		char buffer[1024];
+		http_format(http,",\n\t\"%s\": [", view->prop[p]->name);
+		for ( n=0 ; n<n_objects ; n++ )
+		{
+			if ( class_property_to_string(view->prop[p],(char*)column[p]+n*view->width[p],buffer,sizeof(buffer))<=0 )
+				buffer[0] = '\0';
+			http_format(http,"%s\"%s\"", n>0?",":"", http_unquote(buffer));
+		}
+		http_format(http,"]");
+	}
+	http_format(http,"\n}\n");
+	http_type(http,"text/json");
+
+	for ( p=0 ; p<view->n_props ; p++ )
+		free(column[p]);
+	free(column);
+	free(list);
+	propview_destroy(view);
+	return 1;
+}
+
 /** Process an incoming GUI request
 	@returns non-zero on success, 0 on failure (errno set)
  **/
@@ -1810,6 +1905,7 @@ void *http_response(void *ptr)
 				{"/octave/",	http_run_octave,		HTTP_OK, HTTP_NOTFOUND},
 				{"/kml/", 		http_kml_request,		HTTP_OK, HTTP_NOTFOUND},
 				{"/json/",		http_json_request,		HTTP_OK, HTTP_NOTFOUND},
+				{"/view/",		http_view_request,		HTTP_OK, HTTP_NOTFOUND},
 			};
 			int n;
 			for ( n=0 ; n<sizeof(map)/sizeof(map[0]) ; n++ )
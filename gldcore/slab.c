@@ -0,0 +1,248 @@
+/* slab.c
+ * Copyright (C) 2016 Battelle Memorial Institute
+ *
+ * Per-class object storage.
+ *
+ * Objects are not allocated one at a time.  Each class keeps a list of chunks
+ * (slabs) and objects are placed one after the other in the class's last
+ * chunk, so objects of the same class, which are mostly created together and
+ * synced together, are contiguous in memory and startup doesn't pay for a heap
+ * allocation per object.  Every object starts on a cache line, so two threads
+ * syncing neighboring objects never write the same line.
+ *
+ * A class's first chunk holds a few objects and each new chunk is twice the
+ * size of the previous one, up to slab_size objects, so classes with only a
+ * handful of objects don't waste memory.  When the number of objects about to
+ * be created is known (object arrays, GLM object blocks with id ranges) the
+ * space is reserved in one chunk beforehand.  Objects removed during the run
+ * are kept on the class's free list and reused by the next objects created.
+ * Setting slab_size to 0 reverts to allocating each object separately; the
+ * choice is made when a class's first object is created and kept for the rest
+ * of its objects, so a class's objects are either all in slabs or all not.
+ *
+ * None of this is thread safe: like the rest of object_create_single() (ids,
+ * the object list), allocation and release must be serialized by the caller.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "slab.h"
+#include "globals.h"
+#include "object.h"
+#include "output.h"
+
+#define SLAB_ALIGN 64 /* objects start on cache line boundaries */
+#define SLAB_FIRST 8 /* number of objects in the first chunk of a class */
+
+typedef struct s_slabchunk {
+	char *raw; /**< memory as allocated */
+	char *base; /**< first object (aligned) */
+	unsigned int count; /**< number of objects the chunk holds */
+	unsigned int used; /**< number of objects placed so far */
+	struct s_slabchunk *next;
+} SLABCHUNK;
+
+struct s_slab {
+	size_t objsize; /**< bytes per object, rounded up to SLAB_ALIGN */
+	SLABCHUNK *first, *last; /**< chunks, objects are placed in the last one */
+	void *freelist; /**< objects removed, linked through their first word */
+	unsigned int n_chunks; /**< number of chunks */
+	unsigned int n_objects; /**< number of objects in use */
+	unsigned int n_free; /**< number of objects on the free list */
+	size_t allocated; /**< bytes allocated for chunks */
+	int heap; /**< objects are allocated separately (slab_size was 0 when the first was created) */
+};
+
+static SLAB *slab_get(CLASS *oclass)
+{
+	if ( oclass->slab==NULL )
+	{
+		SLAB *slab = (SLAB*)malloc(sizeof(SLAB));
+		if ( slab==NULL )
+			return NULL;
+		memset(slab,0,sizeof(SLAB));
+		slab->objsize = (sizeof(OBJECT)+oclass->size+SLAB_ALIGN-1)/SLAB_ALIGN*SLAB_ALIGN;
+		slab->heap = ( global_slab_size<=0 );
+		oclass->slab = slab;
+	}
+	return oclass->slab;
+}
+
+static SLABCHUNK *slab_add_chunk(SLAB *slab, unsigned int count)
+{
+	SLABCHUNK *chunk = (SLABCHUNK*)malloc(sizeof(SLABCHUNK));
+	size_t size = slab->objsize*count + SLAB_ALIGN;
+	if ( chunk==NULL )
+		return NULL;
+	chunk->raw = (char*)malloc(size);
+	if ( chunk->raw==NULL )
+	{
+		free(chunk);
+		return NULL;
+	}
+	chunk->base = chunk->raw + (SLAB_ALIGN - ((size_t)chunk->raw)%SLAB_ALIGN)%SLAB_ALIGN;
+	chunk->count = count;
+	chunk->used = 0;
+	chunk->next = NULL;
+	if ( slab->last==NULL )
+		slab->first = chunk;
+	else
+		slab->last->next = chunk;
+	slab->last = chunk;
+	slab->n_chunks++;
+	slab->allocated += size;
+	return chunk;
+}
+
+/* size of the next chunk when it isn't reserved */
+static unsigned int slab_next_count(SLAB *slab)
+{
+	unsigned int count = ( slab->last==NULL ? SLAB_FIRST : slab->last->count*2 );
+	if ( count>(unsigned int)global_slab_size )
+		count = global_slab_size;
+	return count>0 ? count : 1;
+}
+
+/** Allocate memory for an object (header and class data) of a class
+	@return a pointer to the memory, which is not cleared, or \p NULL if none is available
+	@note not thread safe
+ **/
+void *slab_alloc(CLASS *oclass)
+{
+	SLAB *slab;
+	void *ptr;
+
+	slab = slab_get(oclass);
+	if ( slab==NULL )
+		return NULL;
+	if ( slab->heap )
+		return malloc(sizeof(OBJECT)+oclass->size);
+
+	/* reuse removed objects first */
+	if ( slab->freelist!=NULL )
+	{
+		ptr = slab->freelist;
+		slab->freelist = *(void**)ptr;
+		slab->n_free--;
+		slab->n_objects++;
+		return ptr;
+	}
+
+	if ( slab->last==NULL || slab->last->used==slab->last->count )
+	{
+		if ( slab_add_chunk(slab,slab_next_count(slab))==NULL )
+			return NULL;
+	}
+	ptr = slab->last->base + slab->objsize*slab->last->used++;
+	slab->n_objects++;
+	return ptr;
+}
+
+/** Make room for a number of objects of a class to be created one after the other
+	@return 1 if the objects will be contiguous, 0 if not (they can still be created)
+ **/
+int slab_reserve(CLASS *oclass, unsigned int count)
+{
+	SLAB *slab;
+	unsigned int next;
+
+	if ( count<=1 )
+		return 1;
+	slab = slab_get(oclass);
+	if ( slab==NULL )
+		return 0;
+	if ( slab->heap )
+		return 1;
+	if ( slab->last!=NULL && slab->last->count-slab->last->used>=count )
+		return 1;
+
+	/* objects removed earlier would be reused first and break up the block */
+	if ( slab->freelist!=NULL )
+		return 0;
+
+	next = slab_next_count(slab);
+	return slab_add_chunk(slab,count>next?count:next)!=NULL;
+}
+
+/** Release the memory of an object
+	@return 1 if the object was allocated in a slab, 0 if it wasn't (and must be freed by the caller)
+	@note not thread safe
+ **/
+int slab_free(CLASS *oclass, void *ptr)
+{
+	SLAB *slab = oclass->slab;
+	SLABCHUNK *chunk;
+
+	if ( slab==NULL || slab->heap )
+		return 0;
+	for ( chunk=slab->first ; chunk!=NULL ; chunk=chunk->next )
+	{
+		if ( (char*)ptr>=chunk->base && (char*)ptr<chunk->base+slab->objsize*chunk->used )
+		{
+			*(void**)ptr = slab->freelist;
+			slab->freelist = ptr;
+			slab->n_free++;
+			slab->n_objects--;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/** Check whether the objects of a class are allocated in slabs
+	@return 1 if they are (and are released by slab_free_all()), 0 if each was allocated separately
+ **/
+int slab_contains(CLASS *oclass)
+{
+	return oclass->slab!=NULL && !oclass->slab->heap;
+}
+
+/** Release the slabs of all classes - all the objects in them are destroyed
+ **/
+void slab_free_all(void)
+{
+	CLASS *oclass;
+	for ( oclass=class_get_first_class() ; oclass!=NULL ; oclass=oclass->next )
+	{
+		SLAB *slab = oclass->slab;
+		SLABCHUNK *chunk, *next;
+		if ( slab==NULL )
+			continue;
+		for ( chunk=slab->first ; chunk!=NULL ; chunk=next )
+		{
+			next = chunk->next;
+			free(chunk->raw);
+			free(chunk);
+		}
+		free(slab);
+		oclass->slab = NULL;
+	}
+}
+
+/** Report object memory use by class
+ **/
+void slab_profiles(void)
+{
+	CLASS *oclass;
+	unsigned int objects = 0, chunks = 0;
+	size_t allocated = 0, used = 0;
+	output_profile("Object memory");
+	output_profile("=============\n");
+	output_profile("Class            Objects Chunks Bytes/obj  Alloc (kB)   Used (kB)");
+	output_profile("---------------- ------- ------ --------- ----------- -----------");
+	for ( oclass=class_get_first_class() ; oclass!=NULL ; oclass=oclass->next )
+	{
+		SLAB *slab = oclass->slab;
+		if ( slab==NULL || slab->n_chunks==0 )
+			continue;
+		output_profile("%-16.16s %7u %6u %9u %11.1f %11.1f", oclass->name, slab->n_objects, slab->n_chunks,
+			(unsigned int)slab->objsize, slab->allocated/1024.0, slab->objsize*slab->n_objects/1024.0);
+		objects += slab->n_objects;
+		chunks += slab->n_chunks;
+		allocated += slab->allocated;
+		used += slab->objsize*slab->n_objects;
+	}
+	output_profile("================ ======= ====== ========= =========== ===========");
+	output_profile("%-16.16s %7u %6u %9s %11.1f %11.1f\n", "Total", objects, chunks, "", allocated/1024.0, used/1024.0);
+}
@@ -0,0 +1,26 @@
+/* slab.h
+ * Copyright (C) 2016 Battelle Memorial Institute
+ * Per-class object storage
+ */
+
+#ifndef _SLAB_H
+#define _SLAB_H
+
+#include "class.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *slab_alloc(CLASS *oclass);
+int slab_reserve(CLASS *oclass, unsigned int count);
+int slab_free(CLASS *oclass, void *ptr);
+int slab_contains(CLASS *oclass);
+void slab_free_all(void);
+void slab_profiles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,8 @@
  *
  */
 
+#include <ctype.h>
+
 #include "output.h"
 #include "stream.h"
 #include "module.h"
@@ -54,6 +56,9 @@ static FILE *fp = NULL;
 /* stream size */
 static size_t count=0;
 
+/* stream options */
+static int flags = 0x00;
+
 char *stream_context()
 {
 	static char buffer[64];
@@ -292,13 +297,320 @@ size_t stream_decompress(char *buf, const size_t len)
 		return stream_error("stream_decompress(): stream confirmation code mismatched--probable invalid stream");
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BLOCK CONTAINER
+//
+// When SF_BLOCK is set the stream is written as a sequence of blocks, each
+// compressed with a fast LZ compressor and protected with a CRC-32 checksum.
+//
+//	[magic] "GLDBLK1\0"
+//	[block]* [UI/rawlen] [UI/datalen] [UI/crc] [UC/data ...] (datalen==rawlen means stored)
+//	[trailer] [UI/0] [UI/0] [UI/crc of all raw data] [U64/total raw length]
+//
+// Block streams are detected automatically when reading and the whole file is 
+// validated before any of it is loaded.
+//
+
+#define BLOCK_MAGIC "GLDBLK1"
+#define BLOCK_SIZE 65536
+#define BLOCK_MAXDATA (BLOCK_SIZE+BLOCK_SIZE/32+16)
+
+typedef struct s_blockheader {
+	unsigned int rawlen; ///< uncompressed length of block (0 for trailer)
+	unsigned int datalen; ///< stored length of block
+	unsigned int crc; ///< checksum of uncompressed block (or whole stream for trailer)
+} BLOCKHEADER;
+
+static unsigned char *block_raw = NULL; // uncompressed block buffer
+static unsigned char *block_data = NULL; // compressed block buffer
+static size_t block_len = 0; // data in raw buffer
+static size_t block_pos = 0; // read position in raw buffer
+static unsigned int block_crc = 0; // checksum of all raw data
+static uint64 block_total = 0; // length of all raw data
+
+static unsigned int crc32_update(unsigned int crc, const unsigned char *buf, size_t len)
+{
+	static unsigned int table[256];
+	static bool ready = false;
+	if ( !ready )
+	{
+		unsigned int n, k, c;
+		for ( n=0 ; n<256 ; n++ )
+		{
+			for ( c=n, k=0 ; k<8 ; k++ )
+				c = c&1 ? 0xedb88320U^(c>>1) : c>>1;
+			table[n] = c;
+		}
+		ready = true;
+	}
+	crc = ~crc;
+	while ( len-->0 )
+		crc = table[(crc^*buf++)&0xff]^(crc>>8);
+	return ~crc;
+}
+
+/** block_compress
+
+	LZ compression of a single block (LZF encoding)
+	
+	[UC/ctrl<32] literal run of ctrl+1 bytes follows
+	[UC/ctrl>=32] back reference of (ctrl>>5)+2 bytes (length 7 is extended by the next byte),
+		offset is ((ctrl&0x1f)<<8)+next byte+1
+	
+	@returns compressed length, or 0 if the data does not compress into max bytes
+ **/
+static size_t block_literals(const unsigned char *lit, size_t len, unsigned char **op, unsigned char *oend)
+{
+	while ( len>0 )
+	{
+		size_t run = len<32 ? len : 32;
+		if ( *op+run+1>oend ) return 0;
+		*(*op)++ = (unsigned char)(run-1);
+		memcpy(*op,lit,run);
+		*op += run;
+		lit += run;
+		len -= run;
+	}
+	return 1;
+}
+static size_t block_compress(const unsigned char *in, size_t len, unsigned char *out, size_t max)
+{
+	static const unsigned char *htab[1<<14];
+	const unsigned char *ip = in, *end = in+len, *lit = in;
+	unsigned char *op = out, *oend = out+max;
+	memset(htab,0,sizeof(htab));
+	while ( ip+4<end )
+	{
+		unsigned int h = (((unsigned int)ip[0]<<16)|((unsigned int)ip[1]<<8)|ip[2])*2654435761U>>18;
+		const unsigned char *ref = htab[h];
+		size_t off;
+		htab[h] = ip;
+		if ( ref!=NULL && (off=ip-ref-1)<8192 && ref[0]==ip[0] && ref[1]==ip[1] && ref[2]==ip[2] )
+		{
+			size_t n = 3, maxlen = end-ip<264 ? end-ip : 264;
+			while ( n<maxlen && ref[n]==ip[n] ) n++;
+			if ( !block_literals(lit,ip-lit,&op,oend) || op+3>oend ) return 0;
+			ip += n;
+			lit = ip;
+			n -= 2;
+			if ( n<7 )
+				*op++ = (unsigned char)((n<<5)|(off>>8));
+			else
+			{
+				*op++ = (unsigned char)((7<<5)|(off>>8));
+				*op++ = (unsigned char)(n-7);
+			}
+			*op++ = (unsigned char)off;
+		}
+		else
+			ip++;
+	}
+	if ( !block_literals(lit,end-lit,&op,oend) ) return 0;
+	return op-out;
+}
+
+/** block_decompress
+	@returns decompressed length, or 0 if the data is invalid
+ **/
+static size_t block_decompress(const unsigned char *in, size_t len, unsigned char *out, size_t max)
+{
+	const unsigned char *ip = in, *iend = in+len;
+	unsigned char *op = out, *oend = out+max;
+	while ( ip<iend )
+	{
+		unsigned int ctrl = *ip++;
+		if ( ctrl<32 )
+		{
+			ctrl++;
+			if ( op+ctrl>oend || ip+ctrl>iend ) return 0;
+			memcpy(op,ip,ctrl);
+			op += ctrl;
+			ip += ctrl;
+		}
+		else
+		{
+			unsigned int n = ctrl>>5;
+			const unsigned char *ref;
+			if ( n==7 )
+			{
+				if ( ip>=iend ) return 0;
+				n += *ip++;
+			}
+			n += 2;
+			if ( ip>=iend ) return 0;
+			ref = op-((ctrl&0x1f)<<8)-*ip++-1;
+			if ( ref<out || op+n>oend ) return 0;
+			while ( n-->0 ) // may overlap
+				*op++ = *ref++;
+		}
+	}
+	return op-out;
+}
+
+static void block_flush(void)
+{
+	BLOCKHEADER hdr;
+	if ( block_len==0 ) return;
+	hdr.rawlen = (unsigned int)block_len;
+	hdr.crc = crc32_update(0,block_raw,block_len);
+	hdr.datalen = (unsigned int)block_compress(block_raw,block_len,block_data,block_len);
+	if ( hdr.datalen==0 ) hdr.datalen = hdr.rawlen; // stored
+	if ( fwrite(&hdr,sizeof(hdr),1,fp)!=1 
+		|| fwrite(hdr.datalen<hdr.rawlen?block_data:block_raw,1,hdr.datalen,fp)!=hdr.datalen )
+		throw "block write failure";
+	block_crc = crc32_update(block_crc,block_raw,block_len);
+	block_total += block_len;
+	block_len = 0;
+}
+
+static void block_finish(void)
+{
+	BLOCKHEADER hdr = {0,0,0};
+	block_flush();
+	hdr.crc = block_crc;
+	if ( fwrite(&hdr,sizeof(hdr),1,fp)!=1 || fwrite(&block_total,sizeof(block_total),1,fp)!=1 )
+		throw "block trailer write failure";
+	output_debug("stream(): %lld bytes written in checksummed blocks (crc %08x)", (int64)block_total, block_crc);
+}
+
+/* reads the next block into the raw buffer; returns false at the trailer */
+static bool block_load(void)
+{
+	BLOCKHEADER hdr;
+	if ( fread(&hdr,sizeof(hdr),1,fp)!=1 )
+		throw "block header truncated";
+	if ( hdr.rawlen==0 )
+	{
+		uint64 total;
+		if ( fread(&total,sizeof(total),1,fp)!=1 )
+			throw "block trailer truncated";
+		if ( total!=block_total || hdr.crc!=block_crc )
+			throw "stream checksum mismatch";
+		return false;
+	}
+	if ( hdr.rawlen>BLOCK_SIZE || hdr.datalen>hdr.rawlen )
+		throw "block header invalid";
+	if ( fread(block_data,1,hdr.datalen,fp)!=hdr.datalen )
+		throw "block data truncated";
+	if ( hdr.datalen==hdr.rawlen )
+		memcpy(block_raw,block_data,hdr.rawlen);
+	else if ( block_decompress(block_data,hdr.datalen,block_raw,hdr.rawlen)!=hdr.rawlen )
+		throw "block data corrupt";
+	if ( crc32_update(0,block_raw,hdr.rawlen)!=hdr.crc )
+		throw "block checksum mismatch";
+	block_crc = crc32_update(block_crc,block_raw,hdr.rawlen);
+	block_total += hdr.rawlen;
+	block_len = hdr.rawlen;
+	block_pos = 0;
+	return true;
+}
+
+static void block_start(void)
+{
+	if ( block_raw==NULL )
+	{
+		block_raw = (unsigned char*)malloc(BLOCK_SIZE);
+		block_data = (unsigned char*)malloc(BLOCK_MAXDATA);
+		if ( block_raw==NULL || block_data==NULL )
+			throw "block buffer allocation failed";
+	}
+	block_len = block_pos = 0;
+	block_crc = 0;
+	block_total = 0;
+}
+
+/* checks every block and the trailer before anything is loaded */
+static void block_validate(void)
+{
+	long start = ftell(fp);
+	block_start();
+	while ( block_load() ) {}
+	output_verbose("stream validated, %lld bytes in checksummed blocks", (int64)block_total);
+	if ( fseek(fp,start,SEEK_SET)!=0 )
+		throw "unable to rewind validated stream";
+	block_start();
+}
+
+static void stream_write(const void *ptr, size_t len)
+{
+	if ( flags&SF_BLOCK )
+	{
+		const unsigned char *p = (const unsigned char*)ptr;
+		while ( len>0 )
+		{
+			size_t n = BLOCK_SIZE-block_len;
+			if ( n>len ) n = len;
+			memcpy(block_raw+block_len,p,n);
+			block_len += n;
+			p += n;
+			len -= n;
+			if ( block_len==BLOCK_SIZE )
+				block_flush();
+		}
+	}
+	else if ( fwrite(ptr,1,len,fp)!=len )
+		throw "write failure";
+}
+
+static size_t stream_read(void *ptr, size_t len)
+{
+	if ( flags&SF_BLOCK )
+	{
+		unsigned char *p = (unsigned char*)ptr;
+		size_t count = 0;
+		while ( count<len )
+		{
+			size_t n;
+			if ( block_pos==block_len && !block_load() )
+				break;
+			n = block_len-block_pos;
+			if ( n>len-count ) n = len-count;
+			memcpy(p+count,block_raw+block_pos,n);
+			block_pos += n;
+			count += n;
+		}
+		return count;
+	}
+	return fread(ptr,1,len,fp);
+}
+
+#ifdef _DEBUG
+/* reads one character of a text stream, through the block container if any */
+static int stream_getc(void)
+{
+	unsigned char c;
+	return stream_read(&c,1)==1 ? c : EOF;
+}
+#endif
+
+/* returns a scratch buffer of at least len bytes to read verified items into */
+static void *stream_verify_buffer(size_t len)
+{
+	static char *buffer = NULL;
+	static size_t size = 0;
+	if ( len>size )
+	{
+		char *p = (char*)realloc(buffer,len);
+		if ( p==NULL ) throw "verify buffer allocation failure";
+		buffer = p;
+		size = len;
+	}
+	return buffer;
+}
+
+/* compares an item read from a stream with the live value it was written from */
+static bool stream_compare(const void *live, size_t len, bool is_str, const void *item, size_t a)
+{
+	if ( is_str ) len = strnlen((const char*)live,len);
+	return a==len && memcmp(live,item,a)==0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 static char stream_name[] = STREAM_NAME;
 static unsigned int stream_version = STREAM_VERSION;
 static unsigned int stream_wordsize = sizeof(void*);
 static size_t stream_pos = 0;
-static int flags = 0x00;
 
 /** Stream data
     @returns Bytes read/written to/from stream
@@ -312,62 +624,79 @@ size_t stream(void *ptr, ///< pointer to buffer
 	{
 #ifdef _DEBUG
 		if ( is_str ) len = strlen((char*)ptr);
-		unsigned int a = fprintf(fp,"%d ",len);
-		if ( a<0 ) throw;
+		char text[16];
+		unsigned int a = sprintf(text,"%d ",(int)len);
+		stream_write(text,a);
 		unsigned int i;
 		for ( i=0 ; i<len ; i++ )
 		{
 			int c = ((unsigned char*)ptr)[i];
 			size_t b=1;
 			if ( !is_str || c<32 || c>126 || c=='\\' )
-				b = fprintf(fp,"\\%02x",c);
-			else if ( fputc(c,fp)==EOF ) b=-1;
-			if ( b==-1 ) throw;
+				b = sprintf(text,"\\%02x",c);
+			else
+				text[0] = (char)c;
+			stream_write(text,b);
 			a+=b;
 		}
-		unsigned int b = fprintf(fp,"\n");
-		if ( b<0 ) throw;
-		a+=b;
+		stream_write("\n",1);
+		a++;
 		stream_pos += a;
 		return a;
 #else
 		if ( is_str ) len = strlen((char*)ptr);
-		size_t a = fwrite((void*)&len,1,sizeof(len),fp);
-		if ( a!=sizeof(len) ) throw;
-		size_t b = fwrite((void*)ptr,1,len,fp);
-		if ( b!=len ) throw;
-		a+=b;
+		stream_write(&len,sizeof(len));
+		stream_write(ptr,len);
+		size_t a = sizeof(len)+len;
 		stream_pos += a;
 		return a;
 #endif
 	}
 	if ( flags&SF_IN ) 
 	{
+		// verified items are read aside and compared with the live value
+		void *target = ptr;
+		if ( flags&SF_VERIFY )
+			ptr = stream_verify_buffer(len);
 #ifdef _DEBUG
-		unsigned int a;
-		if ( fscanf(fp,"%d",&a)<1 ) throw -1;
-		if ( a>len ) throw;
-		if ( fgetc(fp)!=' ') throw "FMT";
+		unsigned int a = 0, n = 0;
+		int b;
+		while ( (b=stream_getc())!=EOF && isspace(b) ) {}
+		for ( ; b!=EOF && isdigit(b) ; b=stream_getc(), n++ )
+			a = a*10+(b-'0');
+		if ( n==0 ) throw -1;
+		if ( a>len ) throw "oversized item";
+		if ( b!=' ') throw "FMT";
 		memset(ptr,0,len);
 		unsigned int i;
 		for ( i=0; i<a ; i++ )
 		{
-			int b = fgetc(fp);
-			if ( b=='\\' && fscanf(fp,"%02x",&b)<1 ) throw -1;
+			b = stream_getc();
+			if ( b=='\\' )
+			{
+				int h = stream_getc(), l = stream_getc();
+				if ( h==EOF || l==EOF || !isxdigit(h) || !isxdigit(l) ) throw -1;
+				char hex[3] = {(char)h,(char)l,'\0'};
+				b = (int)strtol(hex,NULL,16);
+			}
+			else if ( b==EOF ) throw "truncated item";
 			((char*)ptr)[i] = (char)b;
 		}
-		while ( fgetc(fp)!='\n' ) {}
+		while ( (b=stream_getc())!='\n' && b!=EOF ) {}
 		if ( match!=NULL && memcmp(ptr,match,a)!=0 ) throw 0;
-		unsigned int b = (log((double)a)+2)+a*3;
-		stream_pos += b;
-		return b;
+		if ( flags&SF_VERIFY && !stream_compare(target,len,is_str,ptr,a) ) throw "item does not match the current state";
+		unsigned int c = (log((double)a)+2)+a*3;
+		stream_pos += c;
+		return c;
 #else
-		size_t a, b = fread(&a,1,sizeof(size_t),fp);
+		size_t a, b = stream_read(&a,sizeof(size_t));
 		if ( b<sizeof(size_t) ) throw -1;
-		if ( a>len ) throw;
-		size_t c = fread((void*)ptr,1,a,fp);
-		if ( a!=c ) throw;
+		if ( a>len ) throw "oversized item";
+		memset(ptr,0,len);
+		size_t c = stream_read(ptr,a);
+		if ( a!=c ) throw "truncated item";
 		if ( match!=NULL && memcmp(ptr,match,a)!=0 ) throw 0;
+		if ( flags&SF_VERIFY && !stream_compare(target,len,is_str,ptr,a) ) throw "item does not match the current state";
 		b+=c;
 		stream_pos += b;
 		return b;
@@ -392,8 +721,8 @@ void stream(MODULE *mod)
 		char name[1024]; if (mod) strcpy(name,mod->name);
 		stream(name,sizeof(name));
 
-		if ( flags&SF_OUT ) mod = mod->next;
-		if ( flags&SF_IN ) module_load(name,0,NULL);
+		if ( flags&(SF_OUT|SF_VERIFY) ) mod = mod->next;
+		else if ( flags&SF_IN ) module_load(name,0,NULL);
 	}
 	stream("/MOD");
 }
@@ -420,8 +749,8 @@ void stream(CLASS *oclass, PROPERTY *prop)
 		uint32 width; if ( prop ) width = prop->width;
 		stream(width);
 
-		if ( flags&SF_OUT ) prop = prop->next;
-		if ( flags&SF_IN ) class_add_extended_property(oclass,name,ptype,unit);
+		if ( flags&(SF_OUT|SF_VERIFY) ) prop = prop->next;
+		else if ( flags&SF_IN ) class_add_extended_property(oclass,name,ptype,unit);
 	}
 	stream("/RTC");
 }
@@ -445,18 +774,110 @@ void stream(CLASS *oclass)
 		PASSCONFIG passconfig; if ( oclass ) passconfig = oclass->passconfig;
 		stream(passconfig);
 
-		if ( flags&SF_IN ) oclass = class_register(NULL,name,size,passconfig);
+		if ( flags&SF_IN && !(flags&SF_VERIFY) ) oclass = class_register(NULL,name,size,passconfig);
 
 		// TODO parent
 
 		stream(oclass,oclass->pmap);
 
-		if ( flags&SF_OUT ) oclass = class_get_next_runtime(oclass);
-		if ( flags&SF_IN ) module_load(oclass->name,0,NULL);
+		if ( flags&(SF_OUT|SF_VERIFY) ) oclass = class_get_next_runtime(oclass);
+		else if ( flags&SF_IN ) module_load(oclass->name,0,NULL);
 	}
 	stream("/RTC");
 }
 
+// DELTA CHECKPOINTS
+//
+// A delta stream only contains the objects whose published state has changed 
+// since the last full snapshot, which is identified by the object hashes taken 
+// when it was written.  Deltas are cumulative, so restoring loads the full 
+// snapshot named in the delta header and then patches the objects recorded in 
+// the delta.
+//
+
+static uint64 *delta_hash = NULL; // object hashes at last full snapshot
+static size_t delta_count = 0; // number of objects at last full snapshot
+static char delta_base[1024] = ""; // name of last full snapshot
+static char *verify_skip = NULL; // objects recorded in the delta being verified
+static bool verify_base = false; // set while the base of a delta is verified
+
+static uint64 stream_hash(const void *ptr, size_t len, uint64 h=0xcbf29ce484222325ULL)
+{
+	const unsigned char *p = (const unsigned char*)ptr;
+	h ^= len;
+	while ( len>=8 )
+	{
+		uint64 w;
+		memcpy(&w,p,8);
+		h = (h^w)*0x100000001b3ULL;
+		h ^= h>>29;
+		p += 8;
+		len -= 8;
+	}
+	while ( len-->0 )
+		h = (h^*p++)*0x100000001b3ULL;
+	return h;
+}
+
+static size_t object_stream_size(OBJECT *obj)
+{
+	return sizeof(OBJECT)+obj->oclass->size;
+}
+
+/* true if the value of a property is hashed; the others hold pointers, which
+   change without the state they refer to changing */
+static bool property_is_hashed(PROPERTY *prop)
+{
+	switch ( prop->ptype ) {
+	case PT_double:
+	case PT_complex:
+	case PT_enumeration:
+	case PT_set:
+	case PT_int16:
+	case PT_int32:
+	case PT_int64:
+	case PT_char8:
+	case PT_char32:
+	case PT_char256:
+	case PT_char1024:
+	case PT_bool:
+	case PT_timestamp:
+	case PT_real:
+	case PT_float:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* hashes the published state of an object, i.e., the non-pointer fields of its header
+   and the values of its non-pointer properties; data is the memory of the object, 
+   which is either the object itself or a copy of it read from a stream */
+static uint64 object_hash(OBJECT *obj, const void *data)
+{
+	const OBJECT *hdr = (const OBJECT*)data;
+	const char *addr = (const char*)(hdr+1);
+	uint64 h = 0xcbf29ce484222325ULL;
+#define HASH(X) h = stream_hash(&hdr->X,sizeof(hdr->X),h)
+	HASH(id); HASH(groupid); HASH(child_count); HASH(rank); 
+	HASH(clock); HASH(valid_to); HASH(schedule_skew); 
+	HASH(latitude); HASH(longitude); 
+	HASH(in_svc); HASH(out_svc); HASH(in_svc_micro); HASH(out_svc_micro); HASH(in_svc_double); HASH(out_svc_double);
+	HASH(rng_state); HASH(heartbeat); HASH(flags);
+#undef HASH
+	CLASS *pclass;
+	for ( pclass=obj->oclass ; pclass!=NULL ; pclass=pclass->parent )
+	{
+		PROPERTY *prop;
+		for ( prop=pclass->pmap ; prop!=NULL && prop->oclass==pclass ; prop=prop->next )
+		{
+			if ( property_is_hashed(prop) )
+				h = stream_hash(addr+(size_t)prop->addr,property_size(prop)*(prop->size>0?prop->size:1),h);
+		}
+	}
+	return h;
+}
+
 // object stream
 void stream(OBJECT *obj)
 {
@@ -476,11 +897,25 @@ void stream(OBJECT *obj)
 		stream(oname,sizeof(oname));
 
 		OBJECT *data=(OBJECT*)malloc(size); if ( obj ) memcpy(data,obj,size);
-		stream(data,size);
+		if ( verify_base )
+		{
+			// the base of a delta is older than the current state, so only the published
+			// state of the objects the delta does not record can be compared
+			flags &= ~SF_VERIFY;
+			stream(data,size);
+			flags |= SF_VERIFY;
+			if ( !verify_skip[n] && object_hash(obj,data)!=object_hash(obj,obj) )
+			{
+				free(data);
+				throw "object does not match the current state";
+			}
+		}
+		else
+			stream(data,size);
 
 		// TODO forecast and namespace
 
-		if ( flags&SF_OUT ) 
+		if ( flags&(SF_OUT|SF_VERIFY) ) 
 		{
 			obj = obj->next;
 			free(data);
@@ -491,6 +926,95 @@ void stream(OBJECT *obj)
 	stream("/OBJ");
 }
 
+// delta object stream
+void stream_delta(OBJECT *obj)
+{
+	stream("DLT");
+	size_t count = object_get_count();
+	stream(count);
+	if ( count!=object_get_count() )
+		throw "delta object count does not match base";
+	size_t n, last = (size_t)-1;
+	if ( flags&SF_OUT )
+	{
+		size_t changed = 0;
+		for ( n=0 ; obj!=NULL ; n++, obj=obj->next )
+		{
+			unsigned int size = (unsigned int)object_stream_size(obj);
+			if ( n<delta_count && object_hash(obj,obj)==delta_hash[n] )
+				continue;
+			stream(n);
+			stream(size);
+			stream((void*)obj,size);
+			changed++;
+		}
+		stream(last);
+		output_debug("stream_delta(): %d of %d objects changed since '%s'", changed, count, delta_base);
+	}
+	else if ( flags&SF_IN )
+	{
+		size_t pos = 0;
+		int verify = flags&SF_VERIFY;
+		while ( true )
+		{
+			// object indexes and sizes describe the stream so they are never verified
+			flags &= ~SF_VERIFY;
+			stream(n);
+			if ( n==last ) { flags |= verify; break; }
+			if ( n<pos || n>=count ) throw "delta object index invalid";
+			if ( verify_skip!=NULL ) verify_skip[n] = 1;
+			for ( ; pos<n ; pos++ ) obj = obj->next;
+			unsigned int size;
+			stream(size);
+			flags |= verify;
+			if ( size!=object_stream_size(obj) ) throw "delta object size does not match base";
+
+			// keep the runtime links of the loaded object
+			char *name = obj->name;
+			CLASS *oclass = obj->oclass;
+			OBJECT *next = obj->next;
+			stream((void*)obj,size);
+			obj->name = name;
+			obj->oclass = oclass;
+			obj->next = next;
+		}
+	}
+	stream("/DLT");
+}
+
+/** Record the object hashes of a full snapshot
+	Subsequent SF_DELTA streams only contain objects that have changed since this call.
+	@param basename the name of the file the full snapshot is written to (NULL clears the snapshot)
+ **/
+extern "C" void stream_snapshot(const char *basename)
+{
+	OBJECT *obj;
+	size_t n;
+	free(delta_hash);
+	delta_hash = NULL;
+	delta_count = 0;
+	strcpy(delta_base,"");
+	if ( basename==NULL )
+		return;
+	delta_hash = (uint64*)malloc(sizeof(uint64)*(object_get_count()+1));
+	if ( delta_hash==NULL )
+	{
+		output_warning("stream_snapshot(): unable to allocate object hashes, delta checkpoints disabled");
+		return;
+	}
+	for ( n=0, obj=object_get_first() ; obj!=NULL ; n++, obj=obj->next )
+		delta_hash[n] = object_hash(obj,obj);
+	delta_count = n;
+	strncpy(delta_base,basename,sizeof(delta_base)-1);
+}
+
+/** Check whether a delta can be written against the last full snapshot
+ **/
+extern "C" int stream_delta_ready(void)
+{
+	return delta_hash!=NULL && delta_count==object_get_count();
+}
+
 // globals stream
 void stream(GLOBALVAR *var)
 {
@@ -507,8 +1031,8 @@ void stream(GLOBALVAR *var)
 		char value[1024]; if ( var ) global_getvar(name,value,sizeof(value));
 		stream(value,sizeof(value));
 
-		if ( flags&SF_OUT ) var = var->next;
-		if ( flags&SF_IN ) global_setvar(name,value);
+		if ( flags&(SF_OUT|SF_VERIFY) ) var = var->next;
+		else if ( flags&SF_IN ) global_setvar(name,value);
 	}
 
 	stream("/VAR");
@@ -522,27 +1046,86 @@ size_t stream(FILE *fileptr,int opts)
 	output_debug("starting stream on file %d with options %x", fileno(fp), flags);
 	try {
 
-		// header
-		stream("GLD30");
+		// block container
+		if ( flags&SF_OUT && flags&SF_BLOCK )
+		{
+			block_start();
+			if ( fwrite(BLOCK_MAGIC,1,sizeof(BLOCK_MAGIC),fp)!=sizeof(BLOCK_MAGIC) )
+				throw "block magic write failure";
+		}
+		else if ( flags&SF_IN )
+		{
+			char magic[sizeof(BLOCK_MAGIC)];
+			if ( fread(magic,1,sizeof(magic),fp)==sizeof(magic) && memcmp(magic,BLOCK_MAGIC,sizeof(magic))==0 )
+			{
+				flags |= SF_BLOCK;
+				block_validate();
+			}
+			else
+				rewind(fp);
+		}
 
-		// runtime classes
-		try { stream(class_get_first_runtime()); } catch (int) {};
+		// header
+		bool delta = false;
+		if ( flags&SF_OUT )
+		{
+			delta = (flags&SF_DELTA)!=0;
+			stream(delta?"GLD30D":"GLD30");
+			if ( delta )
+				stream(delta_base,sizeof(delta_base));
+		}
+		else
+		{
+			// the header describes the stream so it is never verified
+			int verify = flags&SF_VERIFY;
+			flags &= ~SF_VERIFY;
+			char header[32];
+			stream(header,sizeof(header));
+			delta = strcmp(header,"GLD30D")==0;
+			if ( !delta && strcmp(header,"GLD30")!=0 )
+				throw "stream header";
+			if ( delta )
+			{
+				char base[1024];
+				stream(base,sizeof(base));
+			}
+			flags |= verify;
+		}
 
-		// modules
-		try { stream(module_get_first()); } catch (int) {}
+		if ( delta )
+		{
+			// changed objects only
+			stream_delta(object_get_first());
+		}
+		else
+		{
+			// runtime classes
+			try { stream(class_get_first_runtime()); } catch (int) {};
 
-		// objects
-		try { stream(object_get_first()); } catch (int) {};
+			// modules
+			try { stream(module_get_first()); } catch (int) {}
 
-		// globals
-		try { stream(global_getnext(NULL)); } catch (int) {};
+			// objects
+			try { stream(object_get_first()); } catch (int) {};
+		}
 
-		// module data
-		struct s_stream *s;
-		for ( s=stream_list ; s!=NULL ; s=s->next )
-		{	
-			s->call((int)flags,(STREAMCALLBACK)stream_callback);
+		// the globals and module data of a delta base are older than the current state
+		if ( !verify_base )
+		{
+			// globals
+			try { stream(global_getnext(NULL)); } catch (int) {};
+
+			// module data
+			struct s_stream *s;
+			for ( s=stream_list ; s!=NULL ; s=s->next )
+			{	
+				s->call((int)flags,(STREAMCALLBACK)stream_callback);
+			}
 		}
+
+		// block trailer
+		if ( flags&SF_OUT && flags&SF_BLOCK )
+			block_finish();
 		output_debug("done processing stream on file %d with options %x", fileno(fp), flags);
 		return stream_pos;
 	}
@@ -558,6 +1141,134 @@ size_t stream(FILE *fileptr,int opts)
 	}
 }
 
+/* reads the header of a stream and returns true if it is a delta, with the name of its base */
+static bool stream_peek(FILE *fileptr, char *base, size_t len)
+{
+	char header[32];
+	char magic[sizeof(BLOCK_MAGIC)];
+	fp = fileptr;
+	flags = SF_IN;
+	try {
+		if ( fread(magic,1,sizeof(magic),fp)==sizeof(magic) && memcmp(magic,BLOCK_MAGIC,sizeof(magic))==0 )
+		{
+			flags |= SF_BLOCK;
+			block_start();
+		}
+		else
+			rewind(fp);
+		stream(header,sizeof(header));
+		if ( strcmp(header,"GLD30D")!=0 )
+			return false;
+		char name[1024];
+		stream(name,sizeof(name));
+		strncpy(base,name,len-1);
+		base[len-1] = '\0';
+		return true;
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+/* locates the base of a delta, which is normally in the same folder as the delta */
+static void stream_basepath(const char *filename, char *base)
+{
+	const char *dir = strrchr(filename,'/');
+	if ( dir==NULL ) dir = strrchr(filename,'\\');
+	if ( dir!=NULL && base[0]!='/' && base[0]!='\\' && strchr(base,':')==NULL )
+	{
+		char path[1024];
+		sprintf(path,"%.*s%s",(int)(dir-filename+1),filename,base);
+		strcpy(base,path);
+	}
+}
+
+/** Restore a stream file
+	Delta streams are restored by first restoring the full snapshot they are based on.
+	@returns SUCCESS or FAILED
+ **/
+extern "C" STATUS stream_restore(const char *filename)
+{
+	char base[1024];
+	FILE *fileptr = fopen(filename,"rb");
+	if ( fileptr==NULL )
+	{
+		output_error("stream_restore(): unable to open '%s'", filename);
+		return FAILED;
+	}
+	if ( stream_peek(fileptr,base,sizeof(base)) )
+	{
+		stream_basepath(filename,base);
+		output_verbose("restoring delta '%s' from base '%s'", filename, base);
+		if ( stream_restore(base)==FAILED )
+		{
+			output_error("stream_restore(): unable to restore base '%s' of delta '%s'", base, filename);
+			fclose(fileptr);
+			return FAILED;
+		}
+	}
+	rewind(fileptr);
+	size_t len = stream(fileptr,SF_IN);
+	fclose(fileptr);
+	return len==0 || len==(size_t)-1 ? FAILED : SUCCESS;
+}
+
+/** Verify a stream file
+	The stream is read back and compared with the current state instead of being
+	restored, so a checkpoint can be checked by the process that just wrote it.
+	A delta stream is verified together with the full snapshot it is based on:
+	the objects recorded in the delta are compared with their current state, and
+	the published state of the other objects is compared with the base.
+	@returns SUCCESS if the stream matches the current state, FAILED otherwise
+ **/
+extern "C" STATUS stream_verify(const char *filename)
+{
+	char base[1024];
+	FILE *fileptr = fopen(filename,"rb");
+	if ( fileptr==NULL )
+	{
+		output_error("stream_verify(): unable to open '%s'", filename);
+		return FAILED;
+	}
+	bool delta = stream_peek(fileptr,base,sizeof(base));
+	rewind(fileptr);
+	if ( delta && (verify_skip=(char*)calloc(object_get_count()+1,1))==NULL )
+	{
+		output_error("stream_verify(): memory allocation failed");
+		fclose(fileptr);
+		return FAILED;
+	}
+	size_t len = stream(fileptr,SF_IN|SF_VERIFY);
+	fclose(fileptr);
+	STATUS status = len==0 || len==(size_t)-1 ? FAILED : SUCCESS;
+	if ( delta && status==SUCCESS )
+	{
+		stream_basepath(filename,base);
+		fileptr = fopen(base,"rb");
+		if ( fileptr==NULL )
+		{
+			output_error("stream_verify(): unable to open base '%s' of delta '%s'", base, filename);
+			status = FAILED;
+		}
+		else
+		{
+			verify_base = true;
+			len = stream(fileptr,SF_IN|SF_VERIFY);
+			verify_base = false;
+			fclose(fileptr);
+			if ( len==0 || len==(size_t)-1 )
+			{
+				output_error("stream_verify(): base '%s' of delta '%s' does not match the current state", base, filename);
+				status = FAILED;
+			}
+		}
+	}
+	free(verify_skip);
+	verify_skip = NULL;
+	return status;
+}
+
 #define stream_type(T) extern "C" size_t stream_##T(void *ptr, size_t len, PROPERTY *prop) { return stream((T*)ptr,len); }
 #include "stream_type.h"
 #undef stream_type
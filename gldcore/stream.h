@@ -14,6 +14,9 @@
 #define SF_IN		0x0001
 #define SF_OUT		0x0002
 #define SF_STR		0x0004
+#define SF_BLOCK	0x0008 /**< stream is written in compressed and checksummed blocks */
+#define SF_DELTA	0x0010 /**< stream only contains objects changed since the last snapshot */
+#define SF_VERIFY	0x0020 /**< stream is read back and compared with the current state instead of being restored */
 
 typedef const char *TOKEN;
 typedef unsigned int uint;
@@ -35,6 +38,10 @@ typedef size_t (*STREAMCALL)(int flags,STREAMCALLBACK call);
 void stream_register(STREAMCALL);
 size_t stream(FILE *fp, int flags);
 char* stream_context();
+void stream_snapshot(const char *basename);
+int stream_delta_ready(void);
+STATUS stream_restore(const char *filename);
+STATUS stream_verify(const char *filename);
 #endif
 
 #define stream_type(T) size_t stream_##T(void*,size_t,PROPERTY*p)
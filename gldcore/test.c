@@ -13,6 +13,7 @@
 #include "find.h"
 #include "test.h"
 #include "aggregate.h"
+#include "propview.h"
 
 typedef struct s_testlist {
 	char name[64];
@@ -27,7 +28,8 @@ static TESTLIST test_list[] = {
 	{"schedule",	schedule_test,		0, test_list+4},
 	{"loadshape",	loadshape_test,		0, test_list+5},
 	{"enduse",		enduse_test,		0, test_list+6},
-	{"lock",		test_lock,			0, NULL}, /* last test in list has no next */
+	{"lock",		test_lock,			0, test_list+7},
+	{"propview",	propview_test,		0, NULL}, /* last test in list has no next */
 	/* add new core test routines before this line */
 }, *last_test = test_list+sizeof(test_list)/sizeof(test_list[0])-1;
 
@@ -78,17 +80,26 @@ int test_request(char *name)
 	return FAILED;
 }
 
+/** Run the tests that were requested
+	@return SUCCESS if none of them reported a failure, FAILED otherwise
+ **/
 int test_exec(void)
 {
 	TESTLIST *item;
+	int failed = 0;
 	for ( item=test_list ; item!=NULL ; item=item->next )
 	{
-		if ( item->enabled!=0 )
+		if ( item->enabled!=0 && item->call()!=0 )
 		{
-			item->call();
+			output_error("test '%s' failed", item->name);
+			/*	TROUBLESHOOT
+				A core test requested with <b>--test</b> found errors.  The test output
+				(test.txt by default) describes them.
+			 */
+			failed++;
 		}
 	}
-	return SUCCESS;
+	return failed ? FAILED : SUCCESS;
 }
 
 
@@ -132,7 +143,7 @@ int test_lock(void)
 	if ( !count )
 	{
 		output_test("memory allocation failed");
-		return FAILED;
+		return 1;
 	}
 	
 	output_test("*** Begin memory locking test for %d threads", global_threadcount);
@@ -144,7 +155,7 @@ int test_lock(void)
 		if ( pthread_create(&pt,NULL,test_lock_proc,(void*)&n)!=0 )
 		{
 			output_test("thread creation failed");
-			return FAILED;
+			return 1;
 		}
 	}
 	wunlock(&key);
@@ -181,6 +192,6 @@ int test_lock(void)
 	else
 		output_test("Last key = %d", key);
 	output_test("*** End memory locking test", global_threadcount);
-	return SUCCESS;
+	return sum!=total;
 }
 
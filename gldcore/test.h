@@ -6,7 +6,7 @@
 #ifndef _TEST_H
 #define _TEST_H
 
-typedef int (*TESTFUNCTION)(void);
+typedef int (*TESTFUNCTION)(void); /* returns the number of failures */
 
 /* general testing API */
 int test_register(char *name, TESTFUNCTION call);
@@ -7,12 +7,16 @@ market_market_la_LDFLAGS =
 market_market_la_LDFLAGS += $(AM_LDFLAGS)
 
 market_market_la_LIBADD =
+market_market_la_LIBADD += $(PTHREAD_CFLAGS)
+market_market_la_LIBADD += $(PTHREAD_LIBS)
 
 market_market_la_SOURCES =
 market_market_la_SOURCES += market/auction.cpp
 market_market_la_SOURCES += market/auction.h
 market_market_la_SOURCES += market/bid.cpp
 market_market_la_SOURCES += market/bid.h
+market_market_la_SOURCES += market/bid_queue.cpp
+market_market_la_SOURCES += market/bid_queue.h
 market_market_la_SOURCES += market/collect.cpp
 market_market_la_SOURCES += market/collect.h
 market_market_la_SOURCES += market/controller.cpp
@@ -34,3 +38,7 @@ market_market_la_SOURCES += market/stubauction.cpp
 market_market_la_SOURCES += market/stubauction.h
 market_market_la_SOURCES += market/supervisory_control.cpp
 market_market_la_SOURCES += market/supervisory_control.h
+
+if ENABLE_BENCHMARKS
+market_market_la_SOURCES += market/bid_bench.cpp
+endif
@@ -15,6 +15,7 @@
 #include "gridlabd.h"
 #include "auction.h"
 #include "stubauction.h"
+#include "bid_queue.h"
 
 CLASS *auction::oclass = NULL;
 auction *auction::defaults = NULL;
@@ -196,6 +197,7 @@ auction::auction(MODULE *module)
 				throw msg;
 			}
 		gl_publish_function(oclass,	"submit_bid_state", (FUNCTIONADDR)submit_bid_state);
+		gl_publish_function(oclass,	"submit_bid_handle", (FUNCTIONADDR)submit_bid_handle);
 		gl_publish_function(oclass, "get_market_for_time", (FUNCTIONADDR)get_market_for_time);
 		gl_publish_function(oclass, "register_participant", (FUNCTIONADDR)register_participant);
 		defaults = this;
@@ -223,6 +225,8 @@ int auction::create(void)
 	warmup = 1;
 	market_id = 1;
 	clearing_scalar = 0.5;
+	bid_queue = bid_queue_register();
+	memset(&queued_bids,0,sizeof(queued_bids));
 	/* process dynamic statistics */
 	if(statistic_check == -1){
 		int rv;
@@ -748,6 +752,10 @@ TIMESTAMP auction::pop_market_frame(TIMESTAMP t1){
 /* Presync is called when the clock needs to advance on the first top-down pass */
 TIMESTAMP auction::presync(TIMESTAMP t0, TIMESTAMP t1)
 {
+	/* pick up the bids queued by handle bidders since the last pass */
+	if (merge_queued_bids() == 0)
+		return TS_INVALID;
+
 	if (clearat==TS_ZERO)
 	{
 		clearat = nextclear();
@@ -919,7 +927,7 @@ void auction::clear_market(void)
 		}
 		else if (unresponsive.quantity > 0.001)
 		{
-			submit_nolock(unresponsive.from, -unresponsive.quantity, unresponsive.price, unresponsive.bid_id, BS_ON, false, market_id);
+			submit_nolock(unresponsive.from, -unresponsive.quantity, unresponsive.price, unresponsive.bid_id, BS_ON, false, market_id, gl_globalclock);
 			gl_verbose("capacity_reference_property %s has %.3f unresponsive load", gl_name(linkref,name,sizeof(name)), -unresponsive.quantity);
 		}
 	}
@@ -942,7 +950,7 @@ void auction::clear_market(void)
 					sprintf(msg, "capacity_reference_property %s uses units of %s and is incompatible with auction units (%s)", capacity_reference_property->name, capacity_reference_property->unit->name, unit.get_string());
 					throw msg;
 				} else {
-					submit_nolock((char *)OBJECTHDR(this)->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price, (int64)OBJECTHDR(this)->id, BS_ON, false, market_id);
+					submit_nolock((char *)OBJECTHDR(this)->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price, (int64)OBJECTHDR(this)->id, BS_ON, false, market_id, gl_globalclock);
 					if (verbose) gl_output("Capacity reference object: %s bids %.2f at %.2f", capacity_reference_object->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price);
 				}
 			}
@@ -1443,7 +1451,7 @@ void auction::clear_market(void)
 	}
 }
 
-void auction::record_bid(char *from, double quantity, double real_price, BIDDERSTATE state){
+void auction::record_bid(char *from, double quantity, double real_price, BIDDERSTATE state, TIMESTAMP submit_time){
 	char name_buffer[256];
 	char *unkState = "unknown";
 	char *offState = "off";
@@ -1454,7 +1462,6 @@ void auction::record_bid(char *from, double quantity, double real_price, BIDDERS
 	char *pState;
 	char *tStr;
 	DATETIME dt;
-	TIMESTAMP submit_time = gl_globalclock;
 	if(trans_file){ // copied from version below
 		if((this->trans_log_max <= 0) || (trans_log_count > 0)){
 			gl_localtime(submit_time,&dt);
@@ -1484,15 +1491,57 @@ void auction::record_bid(char *from, double quantity, double real_price, BIDDERS
 int auction::submit(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
 {
 	gld_wlock lock(my());
-	return submit_nolock(from,quantity,real_price,key,state, rebid, mkt_id);
+	return submit_nolock(from,quantity,real_price,key,state, rebid, mkt_id, gl_globalclock);
 }
-int auction::submit_nolock(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
+
+/* Lock-free submission for bidders with a market handle - the bid waits in the calling
+   thread's buffer and goes into the curves when the market next clears */
+int auction::submit_queued(BIDHANDLE *handle, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
+{
+	QUEUEDBID bid;
+	bid.handle = handle;
+	bid.sequence = handle->sequence++;
+	bid.quantity = quantity;
+	bid.price = real_price;
+	bid.bid_id = key;
+	bid.state = state;
+	bid.rebid = rebid;
+	bid.market_id = mkt_id;
+	bid.submit_time = gl_globalclock;
+	return bid_queue_append(bid_queue,&bid);
+}
+
+/* Puts everything queued since the last clearing into the curves, as if each bid had been submitted
+   when it was queued.  Returns 0 if a bid was rejected, which is what submit() would have reported. */
+int auction::merge_queued_bids(void)
+{
+	unsigned int n, index;
+	int result = 1;
+	char myname[64];
+
+	n = bid_queue_collect(bid_queue,&queued_bids);
+	for (index=0; index<n; index++)
+	{
+		QUEUEDBID *bid = &(queued_bids.bids[index]);
+		if (submit_nolock(bid->handle->from,bid->quantity,bid->price,bid->bid_id,bid->state,bid->rebid,bid->market_id,bid->submit_time) == 0)
+		{
+			gl_error("%s rejected the bid from %s", gl_name(OBJECTHDR(this),myname,sizeof(myname)), bid->handle->from);
+			/* TROUBLESHOOT
+				A rebid queued by a controller could not replace its earlier bid in the auction's curves.  This
+				happens when the bid id appears more than once in the curve.  Check that every bidder into the
+				market has its own bid id.
+			 */
+			result = 0;
+		}
+	}
+	return result;
+}
+
+int auction::submit_nolock(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, TIMESTAMP submit_time)
 {
 	char myname[64];
-	TIMESTAMP submit_time = gl_globalclock;
 	DATETIME dt;
 	double price;
-	gl_localtime(submit_time,&dt);
 	char buffer[256];
 	BIDDEF biddef;
 	KEY b_id = key;
@@ -1537,6 +1586,7 @@ int auction::submit_nolock(char *from, double quantity, double real_price, KEY k
 	{
 		KEY out;
 		if (verbose){
+			gl_localtime(submit_time,&dt);
 			gl_output("   ...  %s resubmits %s from object %s for %.2f %s at $%.2f/%s at %s", 
 				gl_name(OBJECTHDR(this),myname,sizeof(myname)), quantity<0?"ask":"offer", from,
 				fabs(quantity), unit.get_string(), price, unit.get_string(), gl_strtime(&dt,buffer,sizeof(buffer))?buffer:"unknown time");
@@ -1563,13 +1613,14 @@ int auction::submit_nolock(char *from, double quantity, double real_price, KEY k
 			return 0;
 		}
 
-		record_bid(from, quantity, real_price, state);
+		record_bid(from, quantity, real_price, state, submit_time);
 		return 1;
 	} else if (mkt_id == market_id && rebid == false){
 		char myname[64];
 		char biddername[64];
 		KEY out;
 		if (verbose){
+			gl_localtime(submit_time,&dt);
 			gl_output("   ...  %s receives %s from object %s for %.2f %s at $%.2f/%s at %s", 
 				gl_name(OBJECTHDR(this),myname,sizeof(myname)), quantity<0?"ask":"offer", from,
 				fabs(quantity), unit.get_string(), price, unit.get_string(), gl_strtime(&dt,buffer,sizeof(buffer))?buffer:"unknown time");
@@ -1588,7 +1639,7 @@ int auction::submit_nolock(char *from, double quantity, double real_price, KEY k
 		biddef.bid_type = (quantity > 0 ? BID_SELL : BID_BUY);
 		write_bid(out, biddef.market, biddef.bid, biddef.bid_type);
 		// interject transaction log file writing here
-		record_bid(from, quantity, real_price, state);
+		record_bid(from, quantity, real_price, state, submit_time);
 		biddef.raw = out;
 		return 1;
 	} else { // key between cleared market and 'market_id' ~ points to an old market
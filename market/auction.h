@@ -72,7 +72,7 @@ private:
 	int push_market_frame(TIMESTAMP t1);
 	int check_next_market(TIMESTAMP t1);
 	TIMESTAMP pop_market_frame(TIMESTAMP t1);
-	void record_bid(char *from, double quantity, double real_price, BIDDERSTATE state);
+	void record_bid(char *from, double quantity, double real_price, BIDDERSTATE state, TIMESTAMP submit_time);
 	void record_curve(double, double);
 	// variables
 	curve asks;			/**< demand curve */ 
@@ -153,10 +153,14 @@ private:
 	int64 trans_log_count;
 	FILE *curve_file;
 	int64 curve_log_count;
+	unsigned int bid_queue;	/**< index of this auction's per-thread bid buffers */
+	BIDQUEUE queued_bids;	/**< bids collected from the buffers at clearing */
 public:
 	int submit(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id);
+	int submit_queued(BIDHANDLE *handle, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id);
 private:
-	int submit_nolock(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id);
+	int submit_nolock(char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, TIMESTAMP submit_time);
+	int merge_queued_bids(void);
 public:
 	TIMESTAMP nextclear() const;
 private:
@@ -64,6 +64,46 @@ EXPORT void submit_bid_state(char *from, char *to, char *function_name, char *fu
 	}
 }
 
+/** Resolves a bidder's market once, at init, for submit_bid_handle
+	@return 1 on success, 0 if the market can't take handle bids
+ **/
+int resolve_bid_handle(BIDHANDLE *handle, OBJECT *market, OBJECT *bidder)
+{
+	char biddername[64];
+	memset(handle,0,sizeof(BIDHANDLE));
+	if(market == NULL){
+		gl_error("%s has no market to bid into", gl_name(bidder,biddername,sizeof(biddername)));
+		return 0;
+	}
+	if(market->oclass != auction::oclass && market->oclass != supervisory_control::oclass){
+		gl_error("%s bids into an object that is not an auction or a supervisory control", gl_name(bidder,biddername,sizeof(biddername)));
+		return 0;
+	}
+	handle->market = market;
+	handle->bidder = bidder;
+	if(gl_name(bidder,handle->from,sizeof(handle->from)) == NULL){
+		handle->from[0] = '\0';
+	}
+	return 1;
+}
+
+/** Handle version of submit_bid_state - auction bids are only queued in the calling thread's
+	buffer and reach the curves when the auction clears, so no lock is taken here
+ **/
+EXPORT void submit_bid_handle(BIDHANDLE *handle, void *bidding_buffer, size_t bid_len)
+{
+	BIDINFO *bidding_info = (BIDINFO *)bidding_buffer;
+	if(handle->market->oclass == auction::oclass){
+		auction *mkt = OBJECTDATA(handle->market,auction);
+		if(mkt->submit_queued(handle,bidding_info->quantity,bidding_info->price,bidding_info->bid_id,bidding_info->state,bidding_info->rebid,bidding_info->market_id) == 0){
+			bidding_info->bid_accepted = false;
+		}
+	} else {
+		supervisory_control *mkt = OBJECTDATA(handle->market,supervisory_control);
+		mkt->submit(handle->bidder,bidding_info->quantity,bidding_info->price,bidding_info->market_id,(bidding_info->state == BS_ON ? 1 : 0));
+	}
+}
+
 void translate_bid(BIDDEF &biddef, KEY key){
 	int64 mask = 0x8FFFFFFFFFFF0000LL;
 	biddef.raw = key;
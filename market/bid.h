@@ -43,11 +43,42 @@ typedef struct s_bid_info {
 }BIDINFO;
 typedef struct s_bid BID;
 
+/** Market handle - resolved once when the bidder initializes, so bids skip the name lookups */
+typedef struct s_bid_handle {
+	OBJECT *market;			/**< market the bids go to */
+	OBJECT *bidder;			/**< object submitting the bids */
+	char from[64];			/**< bidder name, formatted once (the curves keep a pointer to it) */
+	unsigned int sequence;	/**< number of bids submitted through the handle */
+} BIDHANDLE;
+
+/** Bid waiting in a submitting thread's buffer until its auction merges it */
+typedef struct s_queued_bid {
+	BIDHANDLE *handle;		/**< bidder the bid came from */
+	unsigned int sequence;	/**< bidder's submission count when it was queued */
+	double quantity;		/**< bid quantity (negative is sell, positive is buy) */
+	double price;			/**< bid price */
+	KEY bid_id;
+	BIDDERSTATE state;
+	bool rebid;
+	int64 market_id;
+	TIMESTAMP submit_time;	/**< clock when the bid was submitted */
+} QUEUEDBID;
+
+/** Growable list of queued bids */
+typedef struct s_bid_queue {
+	QUEUEDBID *bids;
+	unsigned int n_bids;
+	unsigned int max_bids;
+} BIDQUEUE;
+
 /** Bid structure for markets */
 EXPORT void submit_bid_state(char *from, char *to, char *function_name, char *function_class, void *bidding_buffer, size_t bid_len);
 
 EXPORT int64 submit_bid(OBJECT *obj, OBJECT *from, double quantity, double price, KEY bid_id);
 
+int resolve_bid_handle(BIDHANDLE *handle, OBJECT *market, OBJECT *bidder);
+EXPORT void submit_bid_handle(BIDHANDLE *handle, void *bidding_buffer, size_t bid_len);
+
 void translate_bid(BIDDEF &biddef, KEY key);
 void write_bid(KEY &key, int64 market, int64 bid, BIDTYPE type);
 #endif
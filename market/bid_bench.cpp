@@ -0,0 +1,167 @@
+/** $Id: bid_bench.cpp
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file bid_bench.cpp
+	@addtogroup auction
+	@ingroup market
+
+	Bid submission throughput against the number of bidding threads (the market
+	module's --modtest, see bench.h).
+
+	For each thread count, every thread submits the same number of bids two ways:
+
+	- locked: each bid takes the write lock on a shared curve, converts the clock
+	  and goes straight in, as auction::submit() did for every bid (the name
+	  lookups submit_bid_state() also does are left out)
+
+	- queued: each bid is appended to the thread's own buffer (bid_queue_append), and
+	  the buffers are merged into the curve once at the end, as the auction does at
+	  clearing for bidders with a market handle - the merge is included in the time
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "gridlabd.h"
+#include "market.h"
+#include "bid.h"
+#include "bid_queue.h"
+#include "curve.h"
+#include "bench.h"
+
+#define BENCH_MAX_THREADS 16
+#define BENCH_BIDS_PER_THREAD 200000
+
+typedef struct s_bench_thread {
+	BIDHANDLE handle;
+	unsigned int queue;		/**< bid queue index, for the queued run */
+	curve *target;			/**< shared curve, for the locked run */
+	unsigned int *lock;		/**< lock on the shared curve */
+	int n_bids;
+	bool queued;
+	bool ok;
+} BENCHTHREAD;
+
+static void *bench_bidder(void *arg)
+{
+	BENCHTHREAD *bt = (BENCHTHREAD *)arg;
+	int n;
+
+	bt->ok = true;
+	for (n=0; n<bt->n_bids; n++)
+	{
+		double quantity = 1.0 + (n % 7);
+		double price = 10.0 + (n % 101) * 0.5;
+
+		if (bt->queued)
+		{
+			QUEUEDBID bid;
+			bid.handle = &(bt->handle);
+			bid.sequence = bt->handle.sequence++;
+			bid.quantity = quantity;
+			bid.price = price;
+			bid.bid_id = n;
+			bid.state = BS_ON;
+			bid.rebid = false;
+			bid.market_id = 1;
+			bid.submit_time = 0;
+			if (bid_queue_append(bt->queue,&bid) == 0)
+			{
+				bt->ok = false;
+				break;
+			}
+		}
+		else
+		{
+			BID bid = {bt->handle.from,n,quantity,price,BS_ON};
+			DATETIME dt;
+			wlock(bt->lock);
+			gl_localtime(gl_globalclock,&dt);
+			bt->target->submit(&bid);
+			wunlock(bt->lock);
+		}
+	}
+	return NULL;
+}
+
+/* Runs one submission method on n_threads threads, returns bids per second (0 on failure) */
+static double bench_run(int n_threads, bool queued, unsigned int queue)
+{
+	BENCHTHREAD threads[BENCH_MAX_THREADS];
+	pthread_t ids[BENCH_MAX_THREADS];
+	curve target;
+	BIDQUEUE merged;
+	unsigned int lock = 0;
+	unsigned int n, index;
+	double t0, t1;
+	bool ok = true;
+
+	memset(&merged,0,sizeof(merged));
+	for (n=0; n<(unsigned int)n_threads; n++)
+	{
+		memset(&threads[n],0,sizeof(BENCHTHREAD));
+		sprintf(threads[n].handle.from,"bench_bidder:%d",n);
+		threads[n].queue = queue;
+		threads[n].target = &target;
+		threads[n].lock = &lock;
+		threads[n].n_bids = BENCH_BIDS_PER_THREAD;
+		threads[n].queued = queued;
+	}
+
+	t0 = bench_seconds();
+	for (n=0; n<(unsigned int)n_threads; n++)
+	{
+		if (pthread_create(&ids[n],NULL,bench_bidder,&threads[n]) != 0)
+		{
+			gl_testmsg("  unable to start bidder thread %d", n);
+			n_threads = n;
+			ok = false;
+			break;
+		}
+	}
+	for (n=0; n<(unsigned int)n_threads; n++)
+	{
+		pthread_join(ids[n],NULL);
+		ok = ok && threads[n].ok;
+	}
+	if (queued)
+	{
+		unsigned int count = bid_queue_collect(queue,&merged);
+		for (index=0; index<count; index++)
+		{
+			BID bid = {merged.bids[index].handle->from,merged.bids[index].bid_id,merged.bids[index].quantity,merged.bids[index].price,merged.bids[index].state};
+			target.submit(&bid);
+		}
+	}
+	t1 = bench_seconds();
+
+	ok = ok && (target.getcount() == (unsigned int)(n_threads*BENCH_BIDS_PER_THREAD));
+	bid_queue_free(&merged);
+
+	if (!ok || t1 <= t0)
+		return 0.0;
+	return (double)target.getcount() / (t1 - t0);
+}
+
+EXPORT void test(int argc, char *argv[])
+{
+	static int thread_counts[] = {1, 2, 4, 8, 16};
+	unsigned int queue = bid_queue_register();
+	unsigned int n;
+
+	gl_testmsg("market bid submission throughput, %d bids per thread", BENCH_BIDS_PER_THREAD);
+	gl_testmsg("  %7s   %14s   %14s   %7s", "threads", "locked bids/s", "queued bids/s", "speedup");
+
+	for (n=0; n<sizeof(thread_counts)/sizeof(thread_counts[0]); n++)
+	{
+		double locked = bench_run(thread_counts[n],false,queue);
+		double queued = bench_run(thread_counts[n],true,queue);
+
+		gl_testmsg("  %7d   %14.0f   %14.0f   %6.2fx", thread_counts[n], locked, queued, (locked > 0.0 ? queued/locked : 0.0));
+	}
+}
+
+/**@}**/
@@ -0,0 +1,263 @@
+/** $Id: bid_queue.cpp
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file bid_queue.cpp
+	@addtogroup auction
+	@ingroup market
+
+	Per-thread bid buffers for auctions.
+
+	Bidders that use a market handle (see resolve_bid_handle) don't submit
+	into the auction's curves directly.  Each thread that submits bids gets
+	its own buffer for every auction, so a bid is only an append - no lock is
+	taken on the auction and no two threads write the same memory.  When the
+	auction clears, it collects what every thread queued for it and submits
+	the bids to its curves in one go.
+
+	The collection only runs while none of the auction's bidders can be
+	syncing - bidders depend on their market, so the market is always ranked
+	above them and never runs in the same pass.
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "bid_queue.h"
+
+typedef struct s_bid_thread {
+	BIDQUEUE *queues;			/**< this thread's buffer for each auction, by queue index */
+	unsigned int n_queues;		/**< number of auction buffers allocated */
+	bool exited;				/**< the thread has ended - released once its bids are collected */
+	struct s_bid_thread *next;
+} BIDTHREAD;
+
+static pthread_key_t thread_key;
+static pthread_once_t thread_key_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t thread_lock = PTHREAD_MUTEX_INITIALIZER;
+static BIDTHREAD *first_thread = NULL;
+static unsigned int n_auctions = 0;
+
+static bool bid_thread_empty(BIDTHREAD *bt)
+{
+	unsigned int index;
+
+	for (index=0; index<bt->n_queues; index++)
+	{
+		if (bt->queues[index].n_bids > 0)
+			return false;
+	}
+	return true;
+}
+
+static void bid_thread_free(BIDTHREAD *bt)
+{
+	unsigned int index;
+
+	for (index=0; index<bt->n_queues; index++)
+	{
+		if (bt->queues[index].bids != NULL)
+			free(bt->queues[index].bids);
+	}
+	if (bt->queues != NULL)
+		free(bt->queues);
+	free(bt);
+}
+
+/* Thread exit - buffers that still hold bids are only flagged, and released when the auction collects them */
+static void bid_thread_exit(void *data)
+{
+	BIDTHREAD *bt = (BIDTHREAD *)data, **prev;
+
+	pthread_mutex_lock(&thread_lock);
+	if (bid_thread_empty(bt))
+	{
+		for (prev = &first_thread; *prev != NULL; prev = &((*prev)->next))
+		{
+			if (*prev == bt)
+			{
+				*prev = bt->next;
+				break;
+			}
+		}
+		bid_thread_free(bt);
+	}
+	else
+		bt->exited = true;
+	pthread_mutex_unlock(&thread_lock);
+}
+
+static void bid_thread_key_create(void)
+{
+	pthread_key_create(&thread_key,bid_thread_exit);
+}
+
+/* Finds the calling thread's buffers, creating them on its first bid */
+static BIDTHREAD *bid_thread_get(void)
+{
+	BIDTHREAD *bt;
+
+	pthread_once(&thread_key_once,bid_thread_key_create);
+	bt = (BIDTHREAD *)pthread_getspecific(thread_key);
+	if (bt == NULL)
+	{
+		bt = (BIDTHREAD *)malloc(sizeof(BIDTHREAD));
+		if (bt == NULL)
+			return NULL;
+		memset(bt,0,sizeof(BIDTHREAD));
+		pthread_setspecific(thread_key,bt);
+
+		/* only the list itself is shared - this is the one lock a thread ever takes to bid */
+		pthread_mutex_lock(&thread_lock);
+		bt->next = first_thread;
+		first_thread = bt;
+		pthread_mutex_unlock(&thread_lock);
+	}
+	return bt;
+}
+
+static int bid_queue_grow(BIDQUEUE *queue, unsigned int size)
+{
+	QUEUEDBID *newbids;
+	unsigned int newmax;
+
+	if (size <= queue->max_bids)
+		return 1;
+
+	newmax = (queue->max_bids == 0 ? 64 : queue->max_bids);
+	while (newmax < size)
+		newmax *= 2;
+
+	newbids = (QUEUEDBID *)realloc(queue->bids,newmax*sizeof(QUEUEDBID));
+	if (newbids == NULL)
+		return 0;
+	queue->bids = newbids;
+	queue->max_bids = newmax;
+	return 1;
+}
+
+/* orders bids by bidder, then in the order each bidder submitted them */
+static int bid_queue_compare(const void *a, const void *b)
+{
+	const QUEUEDBID *qa = (const QUEUEDBID *)a;
+	const QUEUEDBID *qb = (const QUEUEDBID *)b;
+	unsigned int ida = (qa->handle->bidder != NULL ? qa->handle->bidder->id : 0);
+	unsigned int idb = (qb->handle->bidder != NULL ? qb->handle->bidder->id : 0);
+
+	if (ida != idb)
+		return (ida < idb ? -1 : 1);
+	if (qa->sequence != qb->sequence)
+		return (qa->sequence < qb->sequence ? -1 : 1);
+	return 0;
+}
+
+/** Reserves a set of per-thread buffers for a new auction
+	@return the queue index the auction submits and collects with
+ **/
+unsigned int bid_queue_register(void)
+{
+	unsigned int index;
+
+	pthread_mutex_lock(&thread_lock);
+	index = n_auctions++;
+	pthread_mutex_unlock(&thread_lock);
+
+	return index;
+}
+
+/** Appends a bid to the calling thread's buffer for an auction
+	@return 1 on success, 0 if the buffer could not be allocated
+ **/
+int bid_queue_append(unsigned int index, QUEUEDBID *bid)
+{
+	BIDTHREAD *bt = bid_thread_get();
+	BIDQUEUE *queue;
+
+	if (bt == NULL)
+		return 0;
+
+	/* auctions are all created before anything bids, so this normally happens once per thread */
+	if (index >= bt->n_queues)
+	{
+		unsigned int newcount = (index < n_auctions ? n_auctions : index+1);
+		BIDQUEUE *newqueues = (BIDQUEUE *)realloc(bt->queues,newcount*sizeof(BIDQUEUE));
+		if (newqueues == NULL)
+			return 0;
+		memset(newqueues+bt->n_queues,0,(newcount-bt->n_queues)*sizeof(BIDQUEUE));
+		bt->queues = newqueues;
+		bt->n_queues = newcount;
+	}
+
+	queue = &(bt->queues[index]);
+	if (bid_queue_grow(queue,queue->n_bids+1) == 0)
+		return 0;
+
+	queue->bids[queue->n_bids++] = *bid;
+	return 1;
+}
+
+/** Moves everything the threads queued for an auction into one list and empties their buffers.
+	Bids from one thread keep their order; when more than one thread queued bids, the list is
+	sorted by bidder (and submission order), so the result doesn't depend on thread scheduling.
+	@return the number of bids collected
+ **/
+unsigned int bid_queue_collect(unsigned int index, BIDQUEUE *merged)
+{
+	BIDTHREAD *bt, **prev;
+	BIDQUEUE *queue;
+	unsigned int n_sources = 0;
+
+	merged->n_bids = 0;
+
+	pthread_mutex_lock(&thread_lock);
+	prev = &first_thread;
+	while ((bt = *prev) != NULL)
+	{
+		if (index >= bt->n_queues || bt->queues[index].n_bids == 0)
+		{
+			prev = &(bt->next);
+			continue;
+		}
+
+		queue = &(bt->queues[index]);
+		if (bid_queue_grow(merged,merged->n_bids+queue->n_bids) == 0)
+		{
+			pthread_mutex_unlock(&thread_lock);
+			GL_THROW("unable to allocate memory to merge queued bids");
+			/* TROUBLESHOOT
+				The auction ran out of memory while collecting the bids submitted since its
+				last clearing.  Reduce the size of the model or free up system memory and try again.
+			 */
+		}
+		memcpy(merged->bids+merged->n_bids,queue->bids,queue->n_bids*sizeof(QUEUEDBID));
+		merged->n_bids += queue->n_bids;
+		queue->n_bids = 0;
+		n_sources++;
+
+		/* drop the buffers of threads that are gone once nothing is left in them */
+		if (bt->exited && bid_thread_empty(bt))
+		{
+			*prev = bt->next;
+			bid_thread_free(bt);
+		}
+		else
+			prev = &(bt->next);
+	}
+	pthread_mutex_unlock(&thread_lock);
+
+	if (n_sources > 1)
+		qsort(merged->bids,merged->n_bids,sizeof(QUEUEDBID),bid_queue_compare);
+
+	return merged->n_bids;
+}
+
+/** Releases a bid list */
+void bid_queue_free(BIDQUEUE *queue)
+{
+	if (queue->bids != NULL)
+		free(queue->bids);
+	memset(queue,0,sizeof(BIDQUEUE));
+}
+
+/**@}**/
@@ -0,0 +1,24 @@
+/** $Id: bid_queue.h
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file bid_queue.h
+	@addtogroup auction
+	@ingroup market
+
+ @{
+ **/
+
+#ifndef _bid_queue_h_
+#define _bid_queue_h_
+
+#include "gridlabd.h"
+#include "market.h"
+#include "bid.h"
+
+unsigned int bid_queue_register(void);
+int bid_queue_append(unsigned int index, QUEUEDBID *bid);
+unsigned int bid_queue_collect(unsigned int index, BIDQUEUE *merged);
+void bid_queue_free(BIDQUEUE *queue);
+
+#endif
+
+/**@}**/
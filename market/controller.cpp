@@ -206,6 +206,18 @@ int controller::create(){
 	return 1;
 }
 
+/** sends a bid to the market - through its handle when bidding into an auction,
+	by name for proxy bidding
+ **/
+void controller::send_bid(FUNCTIONADDR fn, BIDHANDLE *handle, char *mktname, BIDINFO *bid){
+	char ctrname[1024];
+	if(handle->market != NULL){
+		((void (*)(BIDHANDLE *, void *, size_t))(*fn))(handle, (void *)bid, (size_t)sizeof(BIDINFO));
+	} else {
+		((void (*)(char *, char *, char *, char *, void *, size_t))(*fn))((char *)gl_name(OBJECTHDR(this), ctrname, 1024), mktname, "submit_bid_state", "auction", (void *)bid, (size_t)sizeof(BIDINFO));
+	}
+}
+
 /** provides some easy default inputs for the transactive controller,
 	 and some examples of what various configurations would look like.
  **/
@@ -427,10 +439,13 @@ int controller::init(OBJECT *parent){
 		gld_string mku;
 		mku = marketunit->get_string();
 		strncpy(market_unit, mku.get_buffer(), 31);
-		submit = (FUNCTIONADDR)(gl_get_function(pMarket, "submit_bid_state"));
+		submit = (FUNCTIONADDR)(gl_get_function(pMarket, "submit_bid_handle"));
 		if(submit == NULL){
 			char buf[256];
-			gl_error("Unable to find function, submit_bid_state(), for object %s.", (char *)gl_name(pMarket, buf, 255));
+			gl_error("Unable to find function, submit_bid_handle(), for object %s.", (char *)gl_name(pMarket, buf, 255));
+			return 0;
+		}
+		if(resolve_bid_handle(&market_handle, pMarket, hdr) == 0){
 			return 0;
 		}
 		if(fetch_property(&pInitPrice, "init_price", pMarket) == 0) {
@@ -464,10 +479,13 @@ int controller::init(OBJECT *parent){
 			}
 			mku = marketunit2->get_string();
 			strncpy(market_unit2, mku.get_buffer(), 31);
-			submit2 = (FUNCTIONADDR)(gl_get_function(pMarket2, "submit_bid_state"));
+			submit2 = (FUNCTIONADDR)(gl_get_function(pMarket2, "submit_bid_handle"));
 			if(submit2 == NULL){
 				char buf[256];
-				gl_error("Unable to find function, submit_bid_state(), for object %s.", (char *)gl_name(pMarket2, buf, 255));
+				gl_error("Unable to find function, submit_bid_handle(), for object %s.", (char *)gl_name(pMarket2, buf, 255));
+				return 0;
+			}
+			if(resolve_bid_handle(&market_handle2, pMarket2, hdr) == 0){
 				return 0;
 			}
 		}
@@ -1014,7 +1032,6 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 	TIMESTAMP fast_reg_run;
 	OBJECT *hdr = OBJECTHDR(this);
 	char mktname[1024];
-	char ctrname[1024];
 	double avgP = 0.0;
 	double stdP = 0.0;
 	int64 marketId = 0;
@@ -1333,11 +1350,11 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				} else {
 					controller_bid.state = BS_OFF;
 				}
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				controller_bid.rebid = true;
 			} else {
 				controller_bid.state = BS_UNKNOWN;
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				controller_bid.rebid = true;
 			}
 			if(controller_bid.bid_accepted == false){
@@ -1582,7 +1599,7 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				controller_bid2.price = last_p;
 				controller_bid2.quantity = last_q;
 				controller_bid2.state = BS_UNKNOWN;
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit2))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt2), "submit_bid_state", "auction", (void *)&controller_bid2, (size_t)sizeof(controller_bid2));
+				send_bid(submit2, &market_handle2, (char *)(&pMkt2), &controller_bid2);
 				controller_bid2.rebid = true;
 				if(controller_bid2.bid_accepted == false){
 					return TS_INVALID;
@@ -1596,7 +1613,7 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 					controller_bid.price = pCap;
 					controller_bid.quantity = last_q;
 					controller_bid.state = BS_UNKNOWN;
-					((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+					send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 					controller_bid.rebid = true;
 					if(controller_bid.bid_accepted == false){
 						return TS_INVALID;
@@ -1618,7 +1635,7 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				controller_bid.price = last_p;
 				controller_bid.quantity = last_q;
 				controller_bid.state = BS_UNKNOWN;
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				controller_bid.rebid = true;
 				if(controller_bid.bid_accepted == false){
 					return TS_INVALID;
@@ -1632,7 +1649,7 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 					controller_bid2.price = pCap2;
 					controller_bid2.quantity = last_q;
 					controller_bid2.state = BS_UNKNOWN;
-					((void (*)(char *, char *, char *, char *, void *, size_t))(*submit2))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt2), "submit_bid_state", "auction", (void *)&controller_bid2, (size_t)sizeof(controller_bid2));
+					send_bid(submit2, &market_handle2, (char *)(&pMkt2), &controller_bid2);
 					controller_bid2.rebid = true;
 					if(controller_bid2.bid_accepted == false){
 						return TS_INVALID;
@@ -1871,11 +1888,11 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				} else {
 					controller_bid.state = BS_OFF;
 				}
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				controller_bid.rebid = true;
 			} else {
 				controller_bid.state = BS_UNKNOWN;
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				controller_bid.rebid = true;
 			}
 			if(controller_bid.bid_accepted == false){
@@ -1896,7 +1913,7 @@ TIMESTAMP controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				} else {
 					controller_bid.state = BS_OFF;
 				}
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)(&pMkt), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				send_bid(submit, &market_handle, (char *)(&pMkt), &controller_bid);
 				if(controller_bid.bid_accepted == false){
 					return TS_INVALID;
 				}
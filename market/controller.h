@@ -158,6 +158,7 @@ private:
 	gld_keyword *PS_OFF, *PS_ON, *PS_UNKNOWN;
 	enumeration last_pState;
 	void cheat();
+	void send_bid(FUNCTIONADDR fn, BIDHANDLE *handle, char *mktname, BIDINFO *bid);
 	int fetch_property(gld_property **prop, char *propName, OBJECT *obj);
 	int dir, direction;
 	int dir2, direction2;
@@ -203,6 +204,8 @@ private:
 	BIDINFO controller_bid2;
 	FUNCTIONADDR submit;
 	FUNCTIONADDR submit2;
+	BIDHANDLE market_handle;	// resolved at init when bidding into an auction, unused for proxy bidding
+	BIDHANDLE market_handle2;
 
 	gld_property override_prop;
 	gld_keyword *OV_NORMAL, *OV_ON, *OV_OFF;
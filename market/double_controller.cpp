@@ -215,10 +215,13 @@ int double_controller::init(OBJECT *parent){
 	next_run = 0;
 
 	controller_bid.bid_id = (int64)hdr->id;
-	submit = (FUNCTIONADDR)(gl_get_function(pMarket, "submit_bid_state"));
+	submit = (FUNCTIONADDR)(gl_get_function(pMarket, "submit_bid_handle"));
 	if(submit == NULL){
 	char buf[256];
-	gl_error("Unable to find function, submit_bid_state(), for object %s.", (char *)gl_name(pMarket, buf, 255));
+	gl_error("Unable to find function, submit_bid_handle(), for object %s.", (char *)gl_name(pMarket, buf, 255));
+		return 0;
+	}
+	if(resolve_bid_handle(&market_handle, pMarket, hdr) == 0){
 		return 0;
 	}
 
@@ -267,8 +270,6 @@ TIMESTAMP double_controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 	double heat_ramp, cool_ramp;
 	double new_limit;
 	OBJECT *hdr = OBJECTHDR(this);
-	char mktname[1024];
-	char ctrname[1024];
 
 	/* short circuit if we've run recently */
 	if(t1 < next_run){
@@ -412,10 +413,10 @@ TIMESTAMP double_controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 				} else {
 					controller_bid.state = BS_OFF;
 				}
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)gl_name(pMarket, mktname, 1024), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				((void (*)(BIDHANDLE *, void *, size_t))(*submit))(&market_handle, (void *)&controller_bid, (size_t)sizeof(controller_bid));
 			} else {
 				controller_bid.state = BS_UNKNOWN;
-				((void (*)(char *, char *, char *, char *, void *, size_t))(*submit))((char *)gl_name(hdr, ctrname, 1024), (char *)gl_name(pMarket, mktname, 1024), "submit_bid_state", "auction", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+				((void (*)(BIDHANDLE *, void *, size_t))(*submit))(&market_handle, (void *)&controller_bid, (size_t)sizeof(controller_bid));
 			}
 			if(controller_bid.bid_accepted == false){
 				return TS_INVALID;
@@ -118,6 +118,7 @@ private:
 	int64 *pMarketID;
 	BIDINFO controller_bid;
 	FUNCTIONADDR submit;
+	BIDHANDLE market_handle;
 };
 
 #endif
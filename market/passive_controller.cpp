@@ -392,6 +392,9 @@ int passive_controller::init(OBJECT *parent){
 			fetch_double(&ratedPowerParent, "heating_element_capacity", parent);			
 			// cheating a little to get the unit of supervisor
 			market = OBJECTDATA(observation_object, supervisory_control);
+			if(resolve_bid_handle(&market_handle, observation_object, hdr) == 0){
+				return 0;
+			}
 		}
 
 		if (voltage_lockout != 0 || observation_object != 0) { //we need to check the voltage of the parent 
@@ -762,8 +765,6 @@ TIMESTAMP passive_controller::sync(TIMESTAMP t0, TIMESTAMP t1){
 
 TIMESTAMP passive_controller::postsync(TIMESTAMP t0, TIMESTAMP t1){
 	OBJECT *hdr = OBJECTHDR(this);
-	char ctrname[1024];
-	char spvrname[1024];
 	
 
 	if (control_mode == CM_PFC && observation_object != 0) { // we have a supervisor
@@ -795,7 +796,7 @@ TIMESTAMP passive_controller::postsync(TIMESTAMP t0, TIMESTAMP t1){
 			} else {
 				controller_bid.state = BS_OFF;
 			}
-			submit_bid_state((char *)gl_name(hdr, ctrname, 1024),(char *)gl_name(observation_object, spvrname, 1024), "submit_bid_state", "supervisor", (void *)&controller_bid, (size_t)sizeof(controller_bid));
+			submit_bid_handle(&market_handle, (void *)&controller_bid, (size_t)sizeof(controller_bid));
 			controller_bid.rebid = true;
 			if(!controller_bid.bid_accepted) {
 				return TS_INVALID;
@@ -210,6 +210,7 @@ public:
 	int voltage_lockout_time;
 	int time_in_voltage_lockout;
 	BIDINFO controller_bid;
+	BIDHANDLE market_handle;
 private:
 	void fetch_double(double **prop, char *name, OBJECT *parent);
 	void fetch_int(int **prop, char *name, OBJECT *parent);
@@ -10,8 +10,12 @@ mysql_mysql_la_LDFLAGS += $(AM_LDFLAGS)
 
 mysql_mysql_la_LIBADD =
 mysql_mysql_la_LIBADD += $(MYSQL_LIBS)
+mysql_mysql_la_LIBADD += $(PTHREAD_CFLAGS)
+mysql_mysql_la_LIBADD += $(PTHREAD_LIBS)
 
 mysql_mysql_la_SOURCES =
+mysql_mysql_la_SOURCES += mysql/batch.cpp
+mysql_mysql_la_SOURCES += mysql/batch.h
 mysql_mysql_la_SOURCES += mysql/collector.cpp
 mysql_mysql_la_SOURCES += mysql/collector.h
 mysql_mysql_la_SOURCES += mysql/database.cpp
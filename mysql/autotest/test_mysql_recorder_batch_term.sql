@@ -0,0 +1,4 @@
+select if(count(*)=1000,1,(select 1 union select 2)) from test_batch_recorder;
+select if(count(*)=1000,1,(select 1 union select 2)) from test_batch_recorder where label='batch test';
+select if(count(*) between 23 and 24,1,(select 1 union select 2)) from test_batch_collector;
+DUMP test_batch_recorder;
@@ -0,0 +1,314 @@
+/** $Id: batch.cpp
+    Copyright (C) 2012 Battelle Memorial Institute
+
+	Batched inserts for recorders and collectors.
+
+	Rather than sending one INSERT per sample, a recorder or collector adds its
+	rows to a batch.  The rows are copied into a block, and when the block holds
+	batch_size rows, or its first row is batch_delay seconds old (wall clock),
+	it is handed to the database's writer thread.  The writer has its own
+	connection and inserts each block with one multi-row prepared statement, so
+	the simulation only ever waits on the database when an on_sync script needs
+	the tables current, and at the end of the run.
+
+	Full blocks use a statement prepared once for the batch; partial blocks
+	(flushed on time, on sync or at the end) are prepared as they come.
+ **/
+
+#ifdef HAVE_MYSQL
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "database.h"
+
+batch::batch(database *d, const char *t, const char *fields, const char *r, unsigned int n, unsigned char *tp)
+{
+	db = d;
+	strncpy(table,t,sizeof(table)-1);
+	table[sizeof(table)-1] = '\0';
+	prefix = new char[strlen(table)+strlen(fields)+32];
+	sprintf(prefix,"INSERT INTO `%s` (%s) VALUES ",table,fields);
+	row = new char[strlen(r)+1];
+	strcpy(row,r);
+	n_values = n;
+	types = new unsigned char[n>0?n:1];
+	memcpy(types,tp,n);
+
+	// keep the placeholder count of a full block within what the server accepts
+	max_rows = db->get_batch_size()>0 ? db->get_batch_size() : 1;
+	if ( max_rows > BATCH_MAXPARAMS/(n_values+1) )
+		max_rows = BATCH_MAXPARAMS/(n_values+1);
+
+	current = NULL;
+	started = 0.0;
+	n_added = 0;
+	pthread_mutex_init(&lock,NULL);
+	stmt = NULL;
+	binds = NULL;
+	next = NULL;
+
+	db->add_batch(this);
+}
+
+batch::~batch(void)
+{
+	if ( current!=NULL )
+		free_block(current);
+	delete [] prefix;
+	delete [] row;
+	delete [] types;
+	pthread_mutex_destroy(&lock);
+}
+
+double batch::wallclock(void)
+{
+#ifdef WIN32
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return (double)now.tv_sec + (double)now.tv_usec*1e-6;
+#endif
+}
+
+BATCHBLOCK *batch::new_block(void)
+{
+	BATCHBLOCK *block = (BATCHBLOCK*)malloc(sizeof(BATCHBLOCK));
+	if ( block==NULL )
+		return NULL;
+	memset(block,0,sizeof(BATCHBLOCK));
+	block->owner = this;
+	block->times = (int64*)malloc(sizeof(int64)*max_rows);
+	block->values = (double*)malloc(sizeof(double)*max_rows*(n_values>0?n_values:1));
+	block->offsets = (size_t*)malloc(sizeof(size_t)*max_rows*(n_values>0?n_values:1));
+	if ( block->times==NULL || block->values==NULL || block->offsets==NULL )
+	{
+		free_block(block);
+		return NULL;
+	}
+	return block;
+}
+
+void batch::free_block(BATCHBLOCK *block)
+{
+	if ( block->times ) free(block->times);
+	if ( block->values ) free(block->values);
+	if ( block->offsets ) free(block->offsets);
+	if ( block->text ) free(block->text);
+	free(block);
+}
+
+/// copies a text value into the block, returns its offset or -1 if it could not be allocated
+size_t batch::add_text(BATCHBLOCK *block, const char *text)
+{
+	size_t len = strlen(text)+1;
+	if ( block->text_len+len > block->text_max )
+	{
+		size_t size = block->text_max>0 ? block->text_max : 4096;
+		while ( size < block->text_len+len ) size *= 2;
+		char *buffer = (char*)realloc(block->text,size);
+		if ( buffer==NULL )
+			return (size_t)-1;
+		block->text = buffer;
+		block->text_max = size;
+	}
+	size_t offset = block->text_len;
+	memcpy(block->text+offset,text,len);
+	block->text_len += len;
+	return offset;
+}
+
+/** Adds a row to the batch
+	@param t row time (database time)
+	@param values value of each BC_DOUBLE column (NaN for NULL)
+	@param texts value of each BC_TEXT column (NULL for NULL)
+ **/
+void batch::add_row(int64 t, double *values, char **texts)
+{
+	BATCHBLOCK *full = NULL;
+	pthread_mutex_lock(&lock);
+	if ( current==NULL )
+	{
+		current = new_block();
+		if ( current==NULL )
+		{
+			pthread_mutex_unlock(&lock);
+			db->exception("unable to allocate batch for table '%s'", table);
+		}
+		started = wallclock();
+	}
+	unsigned int r = current->n_rows;
+	current->times[r] = t;
+	for ( unsigned int n=0 ; n<n_values ; n++ )
+	{
+		if ( types[n]==BC_DOUBLE )
+			current->values[r*n_values+n] = values[n];
+		else if ( texts[n]==NULL )
+			current->offsets[r*n_values+n] = (size_t)-1;
+		else if ( (current->offsets[r*n_values+n]=add_text(current,texts[n]))==(size_t)-1 )
+		{
+			// the row is not counted, so the rows already in the block are still sent
+			pthread_mutex_unlock(&lock);
+			db->exception("unable to allocate text for row %u of batch for table '%s'", r, table);
+		}
+	}
+	current->n_rows++;
+	n_added++;
+	if ( current->n_rows==max_rows || wallclock()-started>=db->get_batch_delay() )
+	{
+		full = current;
+		current = NULL;
+	}
+	pthread_mutex_unlock(&lock);
+
+	if ( full!=NULL )
+		db->send_block(full);
+}
+
+/** Sends the rows collected so far to the writer
+	@param min_age only send them if the first row is at least this old (wall clock seconds)
+ **/
+void batch::flush(double min_age)
+{
+	BATCHBLOCK *block = NULL;
+	pthread_mutex_lock(&lock);
+	if ( current!=NULL && current->n_rows>0 && wallclock()-started>=min_age )
+	{
+		block = current;
+		current = NULL;
+	}
+	pthread_mutex_unlock(&lock);
+
+	if ( block!=NULL )
+		db->send_block(block);
+}
+
+char *batch::build_statement(unsigned int n_rows)
+{
+	size_t len = strlen(prefix), rowlen = strlen(row);
+	char *sql = new char[len+n_rows*(rowlen+1)+1];
+	strcpy(sql,prefix);
+	for ( unsigned int r=0 ; r<n_rows ; r++ )
+	{
+		if ( r>0 ) sql[len++] = ',';
+		strcpy(sql+len,row);
+		len += rowlen;
+	}
+	return sql;
+}
+
+void batch::bind_block(BATCHBLOCK *block, MYSQL_BIND *bind)
+{
+	memset(bind,0,sizeof(MYSQL_BIND)*block->n_rows*(n_values+1));
+	for ( unsigned int r=0 ; r<block->n_rows ; r++ )
+	{
+		bind->buffer_type = MYSQL_TYPE_LONGLONG;
+		bind->buffer = &(block->times[r]);
+		bind++;
+		for ( unsigned int n=0 ; n<n_values ; n++, bind++ )
+		{
+			if ( types[n]==BC_DOUBLE )
+			{
+				double *value = &(block->values[r*n_values+n]);
+				if ( isnan(*value) )
+					bind->buffer_type = MYSQL_TYPE_NULL;
+				else
+				{
+					bind->buffer_type = MYSQL_TYPE_DOUBLE;
+					bind->buffer = value;
+				}
+			}
+			else
+			{
+				size_t offset = block->offsets[r*n_values+n];
+				if ( offset==(size_t)-1 )
+					bind->buffer_type = MYSQL_TYPE_NULL;
+				else
+				{
+					bind->buffer_type = MYSQL_TYPE_STRING;
+					bind->buffer = block->text+offset;
+					bind->buffer_length = strlen(block->text+offset);
+				}
+			}
+		}
+	}
+}
+
+/** Inserts a block (writer thread only)
+	@return true on success, false with the reason in error
+ **/
+bool batch::write(MYSQL *mysql, BATCHBLOCK *block, char *error, size_t len)
+{
+	MYSQL_STMT *s = NULL;
+	MYSQL_BIND *b = NULL;
+	bool full = ( block->n_rows==max_rows );
+	bool ok = true;
+
+	if ( full && stmt!=NULL )
+	{
+		s = stmt;
+		b = binds;
+	}
+	else
+	{
+		char *sql = build_statement(block->n_rows);
+		s = mysql_stmt_init(mysql);
+		if ( s==NULL || mysql_stmt_prepare(s,sql,strlen(sql))!=0 )
+		{
+			snprintf(error,len,"unable to prepare insert into '%s' - %s", table, s ? mysql_stmt_error(s) : mysql_error(mysql));
+			if ( s ) mysql_stmt_close(s);
+			delete [] sql;
+			return false;
+		}
+		delete [] sql;
+		b = new MYSQL_BIND[block->n_rows*(n_values+1)];
+
+		// keep the statement for the next full block
+		if ( full )
+		{
+			stmt = s;
+			binds = b;
+		}
+	}
+
+	bind_block(block,b);
+	if ( mysql_stmt_bind_param(s,b)!=0 || mysql_stmt_execute(s)!=0 )
+	{
+		snprintf(error,len,"unable to insert %u rows into '%s' - %s", block->n_rows, table, mysql_stmt_error(s));
+		ok = false;
+	}
+
+	if ( s!=stmt )
+	{
+		mysql_stmt_close(s);
+		delete [] b;
+	}
+	return ok;
+}
+
+/// releases the full block statement (writer thread only)
+void batch::release(void)
+{
+	if ( stmt!=NULL )
+	{
+		mysql_stmt_close(stmt);
+		stmt = NULL;
+	}
+	if ( binds!=NULL )
+	{
+		delete [] binds;
+		binds = NULL;
+	}
+}
+
+#endif // HAVE_MYSQL
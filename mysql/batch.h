@@ -0,0 +1,72 @@
+/* $Id: batch.h
+ * Copyright (C) 2012 Battelle Memorial Institute
+ *
+ * Batched inserts for recorders and collectors
+ */
+
+#ifndef _BATCH_H
+#define _BATCH_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define BC_DOUBLE	0	///< column is bound as a double (NaN is stored as NULL)
+#define BC_TEXT		1	///< column is bound as a string
+
+#define BATCH_MAXPARAMS 65535	///< most placeholders mysql accepts in one prepared statement
+
+class database;
+class batch;
+
+/// A block of rows waiting to be written
+typedef struct s_batchblock {
+	batch *owner;			///< batch the rows belong to
+	unsigned int n_rows;	///< number of rows filled
+	int64 *times;			///< row times (database time)
+	double *values;			///< double columns, row major
+	size_t *offsets;		///< text columns, offsets in text (-1 is NULL), row major
+	char *text;				///< text column data
+	size_t text_len, text_max;
+	struct s_batchblock *next;
+} BATCHBLOCK;
+
+/// Multi-row insert into one table, written by the database's writer thread
+class batch {
+private:
+	database *db;
+	char table[1024];
+	char *prefix;			///< "INSERT INTO `table` (fields) VALUES "
+	char *row;				///< one row of placeholders, e.g. "(from_unixtime(?),?,?)"
+	unsigned int n_values;	///< bound columns per row, not counting the time
+	unsigned char *types;	///< BC_DOUBLE or BC_TEXT for each bound column
+	unsigned int max_rows;	///< rows per block
+	BATCHBLOCK *current;	///< block being filled
+	double started;			///< wall clock time the first row of the current block was added
+	uint64_t n_added;		///< rows added since the batch was created
+	pthread_mutex_t lock;	///< held while the current block is changed
+	// writer thread only
+	MYSQL_STMT *stmt;		///< prepared statement for full blocks
+	MYSQL_BIND *binds;		///< parameters for full blocks
+	batch *next;
+public:
+	batch(database *db, const char *table, const char *fields, const char *row, unsigned int n_values, unsigned char *types);
+	~batch(void);
+	inline const char *get_table(void) { return table; };
+	inline uint64_t get_count(void) { return n_added; };
+	inline batch *get_next(void) { return next; };
+	inline void set_next(batch *b) { next = b; };
+public:
+	void add_row(int64 t, double *values, char **texts);
+	void flush(double min_age=0.0);
+	bool write(MYSQL *mysql, BATCHBLOCK *block, char *error, size_t len);
+	void release(void);
+	static void free_block(BATCHBLOCK *block);
+	static double wallclock(void);
+private:
+	BATCHBLOCK *new_block(void);
+	size_t add_text(BATCHBLOCK *block, const char *text);
+	void bind_block(BATCHBLOCK *block, MYSQL_BIND *bind);
+	char *build_statement(unsigned int n_rows);
+};
+
+#endif
@@ -165,11 +165,16 @@ int collector::init(OBJECT *parent)
 			exception("NOCREATE option prevents creation of table '%s'", get_table());
 	}
 
-	// check row count
+	// check last row id
 	else 
 	{
-		if ( db->select("SELECT count(*) FROM `%s`", get_table())==NULL )
-			exception("unable to get row count of table '%s'", get_table());
+		MYSQL_RES *res = db->select("SELECT IFNULL(MAX(id),0) FROM `%s`", get_table());
+		if ( res==NULL )
+			exception("unable to get last row id of table '%s'", get_table());
+		MYSQL_ROW row = mysql_fetch_row(res);
+		if ( row!=NULL && row[0]!=NULL )
+			last_id = strtoull(row[0],NULL,10);
+		mysql_free_result(res);
 
 		gl_verbose("table '%s' ok", get_table());
 	}
@@ -182,8 +187,22 @@ int collector::init(OBJECT *parent)
 		next_t = TS_NEVER;
 	else
 		exception("%s: interval must be zero or positive");
-		
-	// @todo use prepared statement instead of insert
+
+	// setup batched inserts
+	char fieldlist[4096], valuelist[4096];
+	size_t fieldlen = sprintf(fieldlist,"%s","t");
+	size_t valuelen = sprintf(valuelist,"%s","(from_unixtime(?)");
+	unsigned char *types = new unsigned char[n_aggregates];
+	for ( n=0 ; n<n_aggregates ; n++ )
+	{
+		fieldlen += sprintf(fieldlist+fieldlen,",`%s`",names[n]);
+		valuelen += sprintf(valuelist+valuelen,"%s",",?");
+		types[n] = BC_DOUBLE;
+	}
+	strcpy(valuelist+valuelen,")");
+	row_values = new double[n_aggregates];
+	inserts = new batch(db,get_table(),fieldlist,valuelist,n_aggregates,types);
+	delete [] types;
 
 	// set heartbeat
 	if ( interval>0 )
@@ -206,23 +225,13 @@ TIMESTAMP collector::commit(TIMESTAMP t0, TIMESTAMP t1)
 	TIMESTAMP dt = (TIMESTAMP)get_interval();
 	if ( dt==0 || ( t1==next_t && next_t!=TS_NEVER ) )
 	{
-		char buffer[4096];
-		size_t eos = sprintf(buffer,"INSERT INTO `%s` (t", get_table());
 		int n;
 		for ( n=0 ; n<n_aggregates ; n++ )
-			eos += sprintf(buffer+eos,",`%s`",names[n]);
-		eos += sprintf(buffer+eos,") VALUES (from_unixtime(%lli)",db->convert_to_dbtime(gl_globalclock));
-		for ( n=0 ; n<n_aggregates ; n++ )
-			eos += sprintf(buffer+eos,",%g",list[n].get_value());
-		sprintf(buffer+eos,"%s",")");
-
-		if ( !db->query(buffer) )
-			exception("unable to add data to '%s' - %s", get_table(), mysql_error(mysql));
-		else
-			gl_verbose("%s: sample added to '%s' ok", get_name(), get_table());
+			row_values[n] = list[n].get_value();
+		inserts->add_row(db->convert_to_dbtime(gl_globalclock),row_values,NULL);
 
-		// check limit
-		if ( get_limit()>0 && db->get_last_index()>=get_limit() )
+		// check limit against the id of the row just added, which was the last insert id before batching
+		if ( get_limit()>0 && last_id+inserts->get_count()>=(uint64_t)get_limit() )
 		{
 			gl_verbose("%s: limit of %d records reached", get_name(), get_limit());
 			next_t = TS_NEVER;
@@ -22,6 +22,9 @@ private:
 	size_t n_aggregates; /// number of aggregates found
 	gld_aggregate *list; ///< list of aggregates
 	char **names; ///< list of aggregate names
+	batch *inserts; ///< rows waiting to be written
+	uint64_t last_id; ///< largest row id in the table at init, rows added after it are numbered on from it
+	double *row_values; ///< row being added
 public:
 	TIMESTAMP next_t;
 public:
@@ -71,6 +71,8 @@ database::database(MODULE *module)
 			PT_double,"sync_interval[s]",get_sync_interval_offset(),PT_ACCESS,PA_PUBLIC,PT_DESCRIPTION,"interval at which on_sync is called",
 			PT_int32,"tz_offset",get_tz_offset_offset(),PT_ACCESS,PA_PUBLIC,PT_DESCRIPTION,"timezone offset used by timestamp in the database",
 			PT_bool,"uses_dst",get_uses_dst_offset(),PT_ACCESS,PA_PUBLIC,PT_DESCRIPTION,"timestamps in database include summer time offsets",
+			PT_int32,"batch_size",get_batch_size_offset(),PT_ACCESS,PA_PUBLIC,PT_DESCRIPTION,"number of rows recorders and collectors insert at once",
+			PT_double,"batch_delay[s]",get_batch_delay_offset(),PT_ACCESS,PA_PUBLIC,PT_DESCRIPTION,"longest time (wall clock) rows wait before they are inserted",
 			NULL)<1){
 				char msg[256];
 				sprintf(msg, "unable to publish properties in %s",__FILE__);
@@ -78,6 +80,8 @@ database::database(MODULE *module)
 		}
 
 		memset(this,0,sizeof(database));
+		batch_size = 100;
+		batch_delay = 1.0;
 		gl_verbose("MySQL client info: %s", mysql_get_client_info());
 	}
 }
@@ -177,6 +181,15 @@ int database::init(OBJECT *parent)
 
 void database::term(void)
 {	
+	// finish inserts before on_term scripts look at the tables
+	try {
+		stop_writer();
+	}
+	catch (const char *msg)
+	{
+		gl_error("%s", msg);
+	}
+
 	if ( strcmp(get_on_term(),"")!=0 )
 	{
 		gl_verbose("%s running on_term script '%s'", get_name(), get_on_term());
@@ -196,12 +209,21 @@ void database::term(void)
 TIMESTAMP database::commit(TIMESTAMP t0, TIMESTAMP t1)
 {
 	set_clock();
+
+	// send rows that have waited long enough and report writer failures
+	flush_batches(get_batch_delay());
+	check_writer();
+
 	if ( get_sync_interval()>0 )
 	{
 		gld_clock ts(t1);
 		int mod = ts.get_localtimestamp()%(TIMESTAMP)get_sync_interval();
 		if ( strcmp(get_on_sync(),"")!=0 && mod==0 )
 		{
+			// on_sync scripts see everything recorded so far
+			flush_batches();
+			drain_batches();
+
 			int mod1 = t1%86400, mod2 = ts.get_timestamp()%86400, mod3 = ts.get_localtimestamp()%86400;
 			gld_clock ts(t0);
 			char buffer[64];
@@ -215,6 +237,137 @@ TIMESTAMP database::commit(TIMESTAMP t0, TIMESTAMP t1)
 	return TS_NEVER;
 }
 
+void database::add_batch(batch *b)
+{
+	// start the writer with the first batch
+	if ( !writer_running )
+	{
+		writer = mysql_init(NULL);
+		if ( writer==NULL )
+			exception("unable to initialize writer connection");
+		if ( mysql_real_connect(writer,hostname,username,strcmp(password,"")?password:NULL,get_schema(),port,socketname,(unsigned long)clientflags)==NULL )
+			exception("writer connect failed - %s", mysql_error(writer));
+		pthread_mutex_init(&writer_lock,NULL);
+		pthread_cond_init(&writer_wake,NULL);
+		pthread_cond_init(&writer_done,NULL);
+		queue_first = queue_last = NULL;
+		writer_stop = writer_busy = false;
+		writer_error[0] = '\0';
+		if ( pthread_create(&writer_thread,NULL,writer_main,this)!=0 )
+			exception("unable to start writer thread");
+		writer_running = true;
+		gl_verbose("%s: writer started with batch_size=%d, batch_delay=%g s", get_name(), get_batch_size(), get_batch_delay());
+	}
+	b->set_next(first_batch);
+	first_batch = b;
+}
+
+void database::send_block(BATCHBLOCK *block)
+{
+	pthread_mutex_lock(&writer_lock);
+	block->next = NULL;
+	if ( queue_last!=NULL )
+		queue_last->next = block;
+	else
+		queue_first = block;
+	queue_last = block;
+	pthread_cond_signal(&writer_wake);
+	pthread_mutex_unlock(&writer_lock);
+}
+
+void database::flush_batches(double min_age)
+{
+	batch *b;
+	for ( b=first_batch ; b!=NULL ; b=b->get_next() )
+		b->flush(min_age);
+}
+
+void database::drain_batches(void)
+{
+	if ( !writer_running )
+		return;
+	pthread_mutex_lock(&writer_lock);
+	while ( queue_first!=NULL || writer_busy )
+		pthread_cond_wait(&writer_done,&writer_lock);
+	pthread_mutex_unlock(&writer_lock);
+	check_writer();
+}
+
+void database::check_writer(void)
+{
+	if ( !writer_running )
+		return;
+	char error[1024];
+	pthread_mutex_lock(&writer_lock);
+	strcpy(error,writer_error);
+	pthread_mutex_unlock(&writer_lock);
+	if ( error[0]!='\0' )
+		exception("batch insert failed - %s", error);
+}
+
+void database::stop_writer(void)
+{
+	if ( !writer_running )
+		return;
+	flush_batches();
+	pthread_mutex_lock(&writer_lock);
+	writer_stop = true;
+	pthread_cond_signal(&writer_wake);
+	pthread_mutex_unlock(&writer_lock);
+	pthread_join(writer_thread,NULL);
+	writer_running = false;
+	gl_verbose("%s: writer stopped", get_name());
+	if ( writer_error[0]!='\0' )
+		exception("batch insert failed - %s", writer_error);
+}
+
+void *database::writer_main(void *arg)
+{
+	database *db = (database*)arg;
+	mysql_thread_init();
+	db->write_queue();
+	mysql_thread_end();
+	return NULL;
+}
+
+void database::write_queue(void)
+{
+	char error[1024];
+	pthread_mutex_lock(&writer_lock);
+	while ( true )
+	{
+		while ( queue_first==NULL && !writer_stop )
+			pthread_cond_wait(&writer_wake,&writer_lock);
+		if ( queue_first==NULL )
+			break;
+
+		BATCHBLOCK *block = queue_first;
+		queue_first = block->next;
+		if ( queue_first==NULL )
+			queue_last = NULL;
+		writer_busy = true;
+		bool failed = ( writer_error[0]!='\0' );
+		pthread_mutex_unlock(&writer_lock);
+
+		// once an insert fails the rest are dropped - the error is raised by the next commit
+		bool ok = failed || block->owner->write(writer,block,error,sizeof(error));
+		batch::free_block(block);
+
+		pthread_mutex_lock(&writer_lock);
+		if ( !ok )
+			strcpy(writer_error,error);
+		writer_busy = false;
+		if ( queue_first==NULL )
+			pthread_cond_broadcast(&writer_done);
+	}
+	pthread_mutex_unlock(&writer_lock);
+
+	batch *b;
+	for ( b=first_batch ; b!=NULL ; b=b->get_next() )
+		b->release();
+	mysql_close(writer);
+}
+
 void database::check_schema(void)
 {
 	if ( last_used!=this )
@@ -26,6 +26,7 @@
 #endif
 
 #include <mysql.h>
+#include "batch.h"
 
 #ifdef DLMAIN
 #define EXTERN
@@ -66,6 +67,8 @@ public:
 	GL_ATOMIC(double,sync_interval);
 	GL_ATOMIC(int32,tz_offset);
 	GL_ATOMIC(bool,uses_dst);
+	GL_ATOMIC(int32,batch_size);
+	GL_ATOMIC(double,batch_delay);
 
 	// mysql handle
 private:
@@ -73,6 +76,27 @@ private:
 public:
 	inline MYSQL *get_handle() { return mysql; };
 
+	// batch writer
+private:
+	MYSQL *writer; ///< writer thread's own connection
+	pthread_t writer_thread;
+	pthread_mutex_t writer_lock;
+	pthread_cond_t writer_wake; ///< signaled when blocks are queued or the writer is stopped
+	pthread_cond_t writer_done; ///< signaled when the queue is empty
+	BATCHBLOCK *queue_first, *queue_last;
+	bool writer_running, writer_stop, writer_busy;
+	char writer_error[1024];
+	batch *first_batch;
+	static void *writer_main(void *arg);
+	void write_queue(void);
+public:
+	void add_batch(batch *b);
+	void send_block(BATCHBLOCK *block);
+	void flush_batches(double min_age=0.0);
+	void drain_batches(void);
+	void check_writer(void);
+	void stop_writer(void);
+
 	// term list
 private:
 	database *next;
@@ -244,11 +244,16 @@ int recorder::init(OBJECT *parent)
 				exception("NOCREATE option prevents creation of table '%s'", get_table());
 		}
 
-		// check row count
+		// check last row id
 		else 
 		{
-			if ( db->select("SELECT count(*) FROM `%s`", get_table())==NULL )
-				exception("unable to get row count of table '%s'", get_table());
+			MYSQL_RES *res = db->select("SELECT IFNULL(MAX(`%s`),0) FROM `%s`", (const char*)recordid_fieldname, get_table());
+			if ( res==NULL )
+				exception("unable to get last row id of table '%s'", get_table());
+			MYSQL_ROW row = mysql_fetch_row(res);
+			if ( row!=NULL && row[0]!=NULL )
+				last_id = strtoull(row[0],NULL,10);
+			mysql_free_result(res);
 
 			gl_verbose("table '%s' ok", get_table());
 		}
@@ -259,6 +264,41 @@ int recorder::init(OBJECT *parent)
 		return 0;
 	}
 
+	// setup batched inserts, header data goes into the statement as is
+	char fieldlist[65536], valuelist[65536];
+	size_t fieldlen = sprintf(fieldlist,"`%s`",(const char*)datetime_fieldname);
+	size_t valuelen = sprintf(valuelist,"(from_unixtime(?)%s",header_data);
+	if ( header_fieldnames[0]!='\0' )
+		fieldlen += sprintf(fieldlist+fieldlen,",%s",(const char*)header_fieldnames);
+	unsigned char *types = new unsigned char[n_properties];
+	row_values = new double[n_properties];
+	row_texts = new char*[n_properties];
+	row_buffers = new char*[n_properties];
+	for ( size_t n = 0 ; n < n_properties ; n++ )
+	{
+		if ( property_unit[n].is_valid() )
+			fieldlen += sprintf(fieldlist+fieldlen,",`%s[%s]`", property_target[n].get_name(), property_unit[n].get_name());
+		else
+			fieldlen += sprintf(fieldlist+fieldlen,",`%s`", property_target[n].get_name());
+		valuelen += sprintf(valuelist+valuelen,"%s",",?");
+		switch ( property_target[n].get_type() ) {
+		case PT_double:
+		case PT_random:
+		case PT_loadshape:
+		case PT_enduse:
+			types[n] = BC_DOUBLE;
+			row_buffers[n] = NULL;
+			break;
+		default:
+			types[n] = BC_TEXT;
+			row_buffers[n] = new char[1024];
+			break;
+		}
+	}
+	strcpy(valuelist+valuelen,")");
+	inserts = new batch(db,get_table(),fieldlist,valuelist,n_properties,types);
+	delete [] types;
+
 	// set heartbeat
 	if ( interval>0 )
 	{
@@ -322,30 +362,23 @@ TIMESTAMP recorder::commit(TIMESTAMP t0, TIMESTAMP t1)
 	// collect data
 	if ( enabled )
 	{
-		gl_debug("header_fieldname=[%s]", (const char*)header_fieldnames);
-		gl_debug("header_fielddata=[%s]", header_data);
-		char fieldlist[65536] = "", valuelist[65536] = "";
-		size_t fieldlen = 0;
-		if ( header_fieldnames[0]!='\0' )
-			fieldlen = sprintf(fieldlist,",%s",(const char*)header_fieldnames);
-		strcpy(valuelist,header_data);
-		size_t valuelen = strlen(valuelist);
-		for ( size_t n = 0 ; n < property_target.size() ; n++ )
+		for ( size_t n = 0 ; n < n_properties ; n++ )
 		{
-			char buffer[1024] = "NULL";
-			if ( property_unit[n].is_valid() )
-				fieldlen += sprintf(fieldlist+fieldlen,",`%s[%s]`", property_target[n].get_name(), property_unit[n].get_name());
-			else
-				fieldlen += sprintf(fieldlist+fieldlen,",`%s`", property_target[n].get_name());
-			db->get_sqldata(buffer, sizeof(buffer), property_target[n], &property_unit[n]);
-			valuelen += sprintf(valuelist+valuelen,", %s", buffer);
+			row_texts[n] = NULL;
+			if ( row_buffers[n]==NULL )
+			{
+				if ( property_unit[n].is_valid() )
+					row_values[n] = property_target[n].get_double((UNIT*)&property_unit[n]);
+				else
+					row_values[n] = property_target[n].get_double();
+			}
+			else if ( property_target[n].to_string(row_buffers[n],1024)>=0 )
+				row_texts[n] = row_buffers[n];
 		}
-		db->query("INSERT INTO `%s` (`%s`%s) VALUES (from_unixtime('%"FMT_INT64"d')%s)",
-			get_table(), (const char*)datetime_fieldname, fieldlist, db->convert_to_dbtime(gl_globalclock),  valuelist);
-
+		inserts->add_row(db->convert_to_dbtime(gl_globalclock),row_values,row_texts);
 
-		// check limit
-		if ( get_limit()>0 && db->get_last_index()>=get_limit() )
+		// check limit against the id of the row just added, which was the last insert id before batching
+		if ( get_limit()>0 && last_id+inserts->get_count()>=(uint64_t)get_limit() )
 		{
 			// shut off recorder
 			enabled=false;
@@ -36,6 +36,11 @@ private:
 	std::vector<gld_property> property_target;
 	std::vector<gld_unit> property_unit;
 	char header_data[1024];
+	batch *inserts; ///< rows waiting to be written
+	uint64_t last_id; ///< largest row id in the table at init, rows added after it are numbered on from it
+	double *row_values; ///< row being added, double columns
+	char **row_texts; ///< row being added, text columns (NULL for NULL)
+	char **row_buffers; ///< storage for the text columns
 public:
 	inline bool get_trigger_on(void) { return trigger_on; };
 	inline bool get_enabled(void) { return enabled; };
@@ -1,12 +1,16 @@
-pkglib_LTLIBRARIES = network/network.la
+pkglib_LTLIBRARIES += network/network.la
 
 network_network_la_CPPFLAGS =
-network_network_la_CPPFLAGS = $(AM_CPPFLAGS)
+network_network_la_CPPFLAGS += -I$(top_srcdir)/third_party/superLU_MT
+network_network_la_CPPFLAGS += $(AM_CPPFLAGS)
 
 network_network_la_LDFLAGS =
 network_network_la_LDFLAGS = $(AM_LDFLAGS)
 
 network_network_la_LIBADD =
+network_network_la_LIBADD += third_party/superLU_MT/libsuperlu.la
+network_network_la_LIBADD += $(PTHREAD_CFLAGS)
+network_network_la_LIBADD += $(PTHREAD_LIBS)
 
 network_network_la_SOURCES =
 network_network_la_SOURCES += network/capbank.cpp
@@ -32,6 +36,8 @@ network_network_la_SOURCES += network/regulator.cpp
 network_network_la_SOURCES += network/regulator.h
 network_network_la_SOURCES += network/relay.cpp
 network_network_la_SOURCES += network/relay.h
+network_network_la_SOURCES += network/solver_nr.cpp
+network_network_la_SOURCES += network/solver_nr.h
 network_network_la_SOURCES += network/transformer.cpp
 network_network_la_SOURCES += network/transformer.h
 network_network_la_SOURCES += network/varmap.c
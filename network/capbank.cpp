@@ -19,9 +19,8 @@
 CLASS *capbank::oclass = NULL;
 CLASS *capbank::pclass = NULL;
 capbank *capbank::defaults = NULL;
-CLASS *capbank_class = NULL;
 
-capbank::capbank(MODULE *mod) : link(mod)
+capbank::capbank(MODULE *mod) : link_object(mod)
 {
 	// TODO: set default values
 	// first time init
@@ -56,7 +55,7 @@ capbank::capbank(MODULE *mod) : link(mod)
 
 int capbank::create() 
 {
-	int result = link::create();
+	int result = link_object::create();
 	memcpy(this,defaults,sizeof(*this));
 	return result;
 }
@@ -68,7 +67,7 @@ TIMESTAMP capbank::sync(TIMESTAMP t0)
 	if (f==NULL || t==NULL)
 		return TS_NEVER;
 	// TODO: update capbank state
-	return link::sync(t0);
+	return link_object::sync(t0);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 
 #include "link.h"
 
-class capbank : public link {
+class capbank : public link_object {
 public:
 	double KVARrated;
 	double Vrated;
@@ -33,7 +33,7 @@ EXPORT int check(void)
 	obj=NULL;
 	while ((obj=gl_find_next(links,obj))!=NULL)
 	{
-		link *branch=OBJECTDATA(obj,link);
+		link_object *branch=OBJECTDATA(obj,link_object);
 		if (branch->from==NULL && branch->to==NULL)
 		{
 			gl_error("link:%d is not connected on either end", obj->id);
@@ -111,7 +111,7 @@ EXPORT int check(void)
 			changed=false;
 			while ((p=gl_find_next(links,p))!=NULL)
 			{
-				link *q=OBJECTDATA(p,link);
+				link_object *q=OBJECTDATA(p,link_object);
 				OBJECT *f = q->from;
 				OBJECT *t = q->to;
 				if (f==NULL || t==NULL)
@@ -20,9 +20,8 @@
 CLASS* fuse::oclass = NULL;
 CLASS* fuse::pclass = NULL;
 fuse *fuse::defaults = NULL;
-CLASS *fuse_class = (NULL);
 
-fuse::fuse(MODULE *mod) : link(mod)
+fuse::fuse(MODULE *mod) : link_object(mod)
 {
 	// first time init
 	if (oclass==NULL)
@@ -65,14 +64,14 @@ fuse::fuse(MODULE *mod) : link(mod)
 
 int fuse::create() 
 {
-	int result = link::create();
+	int result = link_object::create();
 	memcpy(this,defaults,sizeof(*this));
 	return result;
 }
 
 TIMESTAMP fuse::sync(TIMESTAMP t0) 
 {
-	link::sync(t0);
+	link_object::sync(t0);
 
 	double M = I.Mag()/SetCurrent;
 	switch (State) {
@@ -7,7 +7,7 @@
 
 #include "link.h"
 
-class fuse : public link {
+class fuse : public link_object {
 public:
 	double TimeConstant;
 	double SetCurrent;
@@ -53,8 +53,6 @@ CLASS* generator::oclass = NULL;
 CLASS* generator::pclass = NULL;
 generator *generator::defaults = NULL;
 
-CLASS *generator_class = (NULL);
-OBJECT *last_generator = (NULL);
 
 generator::generator(MODULE *mod)
 {
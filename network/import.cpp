@@ -34,7 +34,7 @@ int import_cdf(char *file)
 	// model variables
 	// branch variables
 	char buffer[1024];
-	ff = gl_findfile(file,NULL,FF_READ,buffer,sizeof(buffer)-1);
+	ff = gl_findfile(file,NULL,R_OK,buffer,sizeof(buffer)-1);
 	fp = ff?fopen(ff, "r"):NULL;
 	if (fp==NULL)
 		return 0;
@@ -117,7 +117,7 @@ int import_cdf(char *file)
 					obj = gl_create_object(link_class);
 					obj->parent = NULL;
 					branch[n_branch] = obj;
-					link *p = OBJECTDATA(obj,link);
+					link_object *p = OBJECTDATA(obj,link_object);
 					p->create();
 					p->from = bus[from];
 					p->to = bus[to];
@@ -175,7 +175,7 @@ int import_cdf(char *file)
 	{
 		OBJECT *obj = branch[n];
 		if (obj==NULL) continue;
-		link *p = OBJECTDATA(obj,link);
+		link_object *p = OBJECTDATA(obj,link_object);
 		if (p->from!=NULL && p->to!=NULL)
 			gl_set_parent(obj, p->from->rank<p->to->rank ? p->from : p->to);
 
@@ -56,19 +56,17 @@
 // link CLASS FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
-CLASS* link::oclass = NULL;
-CLASS* link::pclass = NULL;
-link *link::defaults = NULL;
-CLASS *link_class = (NULL);
-OBJECT *last_link = (NULL);
+CLASS* link_object::oclass = NULL;
+CLASS* link_object::pclass = NULL;
+link_object *link_object::defaults = NULL;
 
-link::link(MODULE *mod) 
+link_object::link_object(MODULE *mod) 
 {
 	// first time init
 	if (oclass==NULL)
 	{
 		// register the class definition
-		link_class = oclass = gl_register_class(mod,"link",sizeof(link),PC_BOTTOMUP|PC_UNSAFE_OVERRIDE_OMIT);
+		link_class = oclass = gl_register_class(mod,"link",sizeof(link_object),PC_BOTTOMUP|PC_UNSAFE_OVERRIDE_OMIT);
 		if (oclass==NULL)
 			throw "unable to register class link";
 		else
@@ -79,6 +77,7 @@ link::link(MODULE *mod)
 			PT_complex, "Y", PADDR(Y),
 			PT_complex, "I", PADDR(I),
 			PT_double, "B", PADDR(B),
+			PT_double, "turns_ratio", PADDR(turns_ratio),
 			PT_object, "from", PADDR(from),
 			PT_object, "to", PADDR(to),
 			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
@@ -94,13 +93,13 @@ link::link(MODULE *mod)
 	}
 }
 
-int link::create() 
+int link_object::create() 
 {
 	memcpy(this,defaults,sizeof(*this));
 	return 1;
 }
 
-int link::init(node *parent)
+int link_object::init(node *parent)
 {
 	node *f = OBJECTDATA(from,node);
 	if (f==NULL)
@@ -124,7 +123,7 @@ int link::init(node *parent)
 	return 1;
 }
 
-TIMESTAMP link::sync(TIMESTAMP t0) 
+TIMESTAMP link_object::sync(TIMESTAMP t0) 
 {
 	node *f = OBJECTDATA(from,node);
 	node *t = OBJECTDATA(to,node);
@@ -179,7 +178,7 @@ TIMESTAMP link::sync(TIMESTAMP t0)
 	return TS_NEVER;
 }
 
-void link::apply_dV(OBJECT *source, complex dV)
+void link_object::apply_dV(OBJECT *source, complex dV)
 {
 	complex dI = dV * Y * c;
 	OBJECT *obj;
@@ -203,7 +202,7 @@ EXPORT int create_link(OBJECT **obj, OBJECT *parent)
 	if (*obj!=NULL)
 	{
 		last_link = *obj;
-		link *my = OBJECTDATA(*obj,link);
+		link_object *my = OBJECTDATA(*obj,link_object);
 		gl_set_parent(*obj,parent);
 		my->create();
 		return 1;
@@ -213,7 +212,7 @@ EXPORT int create_link(OBJECT **obj, OBJECT *parent)
 
 EXPORT TIMESTAMP sync_link(OBJECT *obj, TIMESTAMP t0)
 {
-	TIMESTAMP t1 = OBJECTDATA(obj,link)->sync(t0);
+	TIMESTAMP t1 = OBJECTDATA(obj,link_object)->sync(t0);
 	obj->clock = t0;
 	return t1;
 }
@@ -221,7 +220,7 @@ EXPORT TIMESTAMP sync_link(OBJECT *obj, TIMESTAMP t0)
 EXPORT int init_link(OBJECT *obj)
 {
 
-	return OBJECTDATA(obj,link)->init(OBJECTDATA(obj->parent,node));
+	return OBJECTDATA(obj,link_object)->init(OBJECTDATA(obj->parent,node));
 }
 
 
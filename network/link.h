@@ -3,12 +3,12 @@
  **/
 
 
-#ifndef _LINK_H
-#define _LINK_H
+#ifndef _NETWORK_LINK_H
+#define _NETWORK_LINK_H
 
-#include "node.h"
+class node;
 
-class link {
+class link_object {
 public:
 	complex Y; /* impedance, per unit */
 	complex I; /* current, per unit */
@@ -23,10 +23,10 @@ public:
 
 public:
 	static CLASS *oclass;
-	static link *defaults;
+	static link_object *defaults;
 	static CLASS *pclass;
 public:
-	link(MODULE *mod);
+	link_object(MODULE *mod);
 	int create();
 	TIMESTAMP sync(TIMESTAMP t0);
 	int init(node *parent);
@@ -23,7 +23,6 @@ meter *meter::defaults = NULL;
 CLASS* meter::pclass = NULL;
 //CLASS *meter_class = NULL;
 
-CLASS *meter_class = (NULL);
 
 meter::meter(MODULE *mod) : node(mod)
 {
@@ -29,18 +29,27 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 		return NULL;
 	}
 
+	gl_global_create("network::solver_method",PT_enumeration,&solver_method,
+		PT_KEYWORD,"GS",SM_GS,
+		PT_KEYWORD,"NR",SM_NR,
+		PT_DESCRIPTION,"network flow solution method - Gauss-Seidel over passes, or Newton-Raphson within one pass",
+		NULL);
+	gl_global_create("network::convergence_limit",PT_double,&convergence_limit,PT_UNITS,"pu",PT_DESCRIPTION,"largest voltage change (GS) or power mismatch (NR) of a converged solution",NULL);
+	gl_global_create("network::acceleration_factor",PT_double,&acceleration_factor,PT_DESCRIPTION,"Gauss-Seidel acceleration factor",NULL);
+	gl_global_create("network::mvabase",PT_double,&mvabase,PT_UNITS,"MVA",PT_DESCRIPTION,"system MVA base",NULL);
+	gl_global_create("network::NR_iteration_limit",PT_int32,&NR_iteration_limit,PT_DESCRIPTION,"Newton-Raphson iterations allowed in one pass",NULL);
+
+	/* always return the first class registered */
+	CLASS *first = (new node(module))->oclass;
+	new link_object(module);
+
 #ifdef HAVE_POWERWORLD
 #ifndef PWX64
 	int status = gl_global_setvar("run_powerworld=true");
-	CLASS *first = (new pw_model(module))->oclass;
+	new pw_model(module);
 	new pw_load(module);
 	new pw_recorder(module);
-	/* always return the first class registered */
-#else
-	CLASS *first = NULL;
 #endif
-#else
-	CLASS *first = NULL;
 #endif
 	return first;
 
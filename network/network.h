@@ -16,11 +16,34 @@
 #define INIT(A)
 #endif
 
+typedef enum {
+	SM_GS=0,		/**< Gauss-Seidel, one update per bus per pass until the passes converge */
+	SM_NR=1,		/**< Newton-Raphson, the whole network solved within one pass */
+} SOLVERMETHOD;
+
+GLOBAL SOLVERMETHOD solver_method INIT(SM_GS);	/**< network flow solution method */
+GLOBAL double convergence_limit INIT(0.001);	/**< largest voltage change (GS) or power mismatch (NR) of a converged solution, per unit */
+GLOBAL double acceleration_factor INIT(1.4);	/**< Gauss-Seidel acceleration factor */
+GLOBAL double mvabase INIT(100);				/**< system MVA base */
+GLOBAL int32 NR_iteration_limit INIT(30);		/**< Newton-Raphson iterations allowed in one pass */
+GLOBAL int32 debug_node INIT(0);
+GLOBAL int32 debug_link INIT(0);
+
 GLOBAL bool startedCOM INIT(false);	/*Flag to indicate if COM was initialzed, calls UnInitialization at termination */
 GLOBAL OBJECT *initiatorCOM INIT(NULL);	/* Object that initiated the COM interface */
 
 #ifdef __cplusplus
 
+#include "node.h"
+#include "solver_nr.h"
+#include "capbank.h"
+#include "fuse.h"
+#include "generator.h"
+#include "meter.h"
+#include "regulator.h"
+#include "relay.h"
+#include "transformer.h"
+
 #ifdef HAVE_POWERWORLD
 #ifndef PWX64
 #include "pw_model.h"
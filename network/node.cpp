@@ -70,9 +70,6 @@ CLASS* node::oclass = NULL;
 CLASS* node::pclass = NULL;
 node *node::defaults = NULL;
 
-CLASS *node_class = (NULL);
-OBJECT *last_node = (NULL);
-
 node::node(MODULE *mod) 
 {
 
@@ -101,6 +98,7 @@ node::node(MODULE *mod)
 				PT_KEYWORD,"SWING",SWING,
 			PT_int16, "flow_area_num", PADDR(flow_area_num),
 			PT_double, "base_kV", PADDR(base_kV),
+			PT_complex, "NR_S", PADDR(NR_S),
 #ifdef HYBRID
 			PT_complex, "Vobs", PADDR(Vobs),
 			PT_double, "Vstdev", PADDR(Vstdev),
@@ -113,6 +111,7 @@ node::node(MODULE *mod)
 		type = PQ;
 		V = complex(1,0,A);
 		S = complex(0,0,J);
+		NR_S = complex(0,0,J);
 		flow_area_num=1;
 		loss_zone_num=1;
 		Vobs = complex(0,0,A); /* default observation is 0+0j */
@@ -135,7 +134,7 @@ int node::create()
 	return 1;
 }
 
-void node::attach(link *pLink)
+void node::attach(link_object *pLink)
 {
 	LINKLIST *item = new LINKLIST;
 	if (item==NULL)
@@ -165,6 +164,9 @@ int node::init(OBJECT *parent)
 	swing->add_inj_residual(this);
 #endif
 
+	if (type==SWING)
+		solver_nr_attach(hdr);
+
 	YVs=complex(0,0);
 	Ys=complex(0,0);
 	return 1;
@@ -252,6 +254,14 @@ TIMESTAMP node::presync(TIMESTAMP t0)
 
 TIMESTAMP node::postsync(TIMESTAMP t0) 
 {
+	// the Newton-Raphson solution covers the whole network at once
+	if (solver_method==SM_NR)
+	{
+		if (solver_nr_owner(OBJECTHDR(this)))
+			solver_nr(t0);
+		return TS_NEVER;
+	}
+
 	OBJECT *hdr = OBJECTHDR(this);
 	node *swing = hdr->parent?OBJECTDATA(hdr->parent,node):this;
 	complex dV(0.0);
@@ -418,11 +428,7 @@ EXPORT TIMESTAMP sync_node(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 			throw "invalid passconfig";
 		}
 	}
-	catch (char *msg) 
-	{
-		gl_error("%s(%s:%d): %s", obj->name?obj->name:"(anon)", obj->oclass->name, obj->id, msg);
-		return TS_INVALID;
-	}
+	SYNC_CATCHALL(node);
 }
 
 /**@}*/
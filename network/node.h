@@ -8,7 +8,7 @@
 #include "link.h"
 
 typedef struct s_linklist {
-	class link *data;
+	class link_object *data;
 	struct s_linklist *next;
 } LINKLIST;
 
@@ -29,6 +29,9 @@ public:
 	OBJECT *remote_bus_id; /* remote bus */
 	LINKLIST *linklist;
 
+	unsigned int NR_index; /* position of the bus in the Newton-Raphson solution */
+	complex NR_S; /* power at the bus found by the Newton-Raphson solution, with the sign of S */
+
 	/* these values are used by state estimation */
 	complex Vobs;	/* observed voltage */
 	double Vstdev;	/* observed voltage standard deviation; 0 means no observation */
@@ -50,7 +53,7 @@ public:
 	int create();
 	int init(OBJECT *parent);
 
-	void attach(link *pLink);
+	void attach(link_object *pLink);
 
 	void add_obs_residual(node *pNode);
 	void del_obs_residual(node *pNode);
@@ -64,7 +67,7 @@ public:
 
 	TIMESTAMP presync(TIMESTAMP t0);
 	TIMESTAMP postsync(TIMESTAMP t0);
-	friend class link;
+	friend class link_object;
 };
 
 GLOBAL CLASS *node_class INIT(NULL);
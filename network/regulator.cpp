@@ -21,9 +21,8 @@
 CLASS* regulator::oclass = NULL;
 CLASS* regulator::pclass = NULL;
 regulator *regulator::defaults = NULL;
-CLASS *regulator_class = (NULL);
 
-regulator::regulator(MODULE *mod) : link(mod)
+regulator::regulator(MODULE *mod) : link_object(mod)
 {
 	// first time init
 	if (oclass==NULL)
@@ -56,7 +55,7 @@ regulator::regulator(MODULE *mod) : link(mod)
 
 int regulator::create() 
 {
-	int result = link::create();
+	int result = link_object::create();
 	memcpy(this,defaults,sizeof(*this));
 	return result;
 }
@@ -68,7 +67,7 @@ TIMESTAMP regulator::sync(TIMESTAMP t0)
 	if (f==NULL || t==NULL)
 		return TS_NEVER;
 	// TODO: update regulator state
-	return link::sync(t0);
+	return link_object::sync(t0);
 }
 //////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION OF CORE LINKAGE: regulator
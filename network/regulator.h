@@ -8,7 +8,7 @@
 
 #include "link.h"
 
-class regulator : public link {
+class regulator : public link_object {
 public:
 	enum {RT_LTC, RT_VR} Type;
 	double Vmax;
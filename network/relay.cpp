@@ -48,9 +48,8 @@ CLASS* relay::oclass = NULL;
 CLASS* relay::pclass = NULL;
 relay *relay::defaults = NULL;
 
-CLASS *relay_class = (NULL);
 
-relay::relay(MODULE *mod) : link(mod)
+relay::relay(MODULE *mod) : link_object(mod)
 {
 	// first time init
 	if (oclass==NULL)
@@ -87,14 +86,14 @@ relay::relay(MODULE *mod) : link(mod)
 
 int relay::create() 
 {
-	int result = link::create();
+	int result = link_object::create();
 	memcpy(this,defaults,sizeof(*this));
 	return result;
 }
 
 TIMESTAMP relay::sync(TIMESTAMP t0) 
 {
-	link::sync(t0);
+	link_object::sync(t0);
 
 	double M = I.Mag()/SetCurrent;
 	switch (State) {
@@ -7,7 +7,7 @@
 
 #include "link.h"
 
-class relay : public link {
+class relay : public link_object {
 public:
 	enum {FC_U1=1,FC_U2=2,FC_U3=3,FC_U4=4,FC_U5=5} Curve;
 	double TimeDial;
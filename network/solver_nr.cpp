@@ -0,0 +1,484 @@
+/** $Id: solver_nr.cpp
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file solver_nr.cpp
+	@addtogroup solver_nr Newton-Raphson network solution
+	@ingroup network
+
+	The Newton-Raphson solver finds the voltages of all the buses within one pass,
+	instead of the one Gauss-Seidel update per bus per pass made by node::postsync.
+	It is used when the module global \p solver_method is \p NR.
+
+	The bus admittance matrix is assembled from the links, with the turns ratio on the
+	\e from side and the line charging split between the ends [Kundur 1993, p. 236, 259]
+
+		\f[ Y_{ff} \leftarrow Y_{ff} + \widetilde{Y}_{eff} c^2 \f] \n
+
+		\f[ Y_{tt} \leftarrow Y_{tt} + \widetilde{Y}_{eff} \f] \n
+
+		\f[ Y_{ft}, Y_{tf} \leftarrow Y_{ft} - \widetilde{Y} c \f]
+
+	and the shunt conductance \p G and susceptance \p B of the nodes on the diagonal.
+	The bus injections are then
+
+		\f[ \widetilde S_i = \widetilde V_i \left( \Sigma_k Y_{ik} \widetilde V_k \right)^* \f]
+
+	and the mismatches are taken against the negative of the node power \p S, which is
+	a load.  Each iteration solves the Jacobian of the injections with respect to the angle
+	and the relative change in magnitude of the voltages
+
+		\f[ \left[ \begin{array}{cc} \partial P / \partial \theta & V \partial P / \partial V \\
+			\partial Q / \partial \theta & V \partial Q / \partial V \end{array} \right]
+			\left[ \begin{array}{c} \Delta \theta \\ \Delta V / V \end{array} \right]
+			= \left[ \begin{array}{c} \Delta P \\ \Delta Q \end{array} \right] \f]
+
+	using superLU_MT, as the powerflow Newton-Raphson solver does.  PQ buses solve both
+	unknowns, PV buses only the angle, and SWING buses neither.  The equations of held
+	values stay in the matrix as identity rows, so its sparsity never changes and the
+	column ordering is only found once.
+
+	A PV bus holds the voltage magnitude it had when the network was first solved, whatever
+	reactive power that takes.  \p Qmax_MVAR and \p Qmin_MVAR are generator limits, and
+	the node keeps only the net power of the bus, so they are not applied.
+
+	The first SWING bus initialized runs the solution for the whole network in its postsync,
+	when the loads have been updated for the pass.  It leaves \p S as given and posts the
+	power each bus ends up with, in the same sign as \p S, to \p NR_S, so the SWING power
+	and the PV reactive power are read there.  The link currents \p I are the currents into
+	the \e from end, found from the same two-port terms the link adds to the admittance matrix.
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+#include "network.h"
+
+#include <pdsp_defs.h>	//superLU_MT
+
+typedef struct s_nrbus {
+	node *data;
+	BUSTYPE type;	/* type in the solution, PQV buses are solved as PQ */
+	double Vset;	/* voltage magnitude held at PV buses */
+	double Vm;		/* voltage magnitude */
+	double Va;		/* voltage angle */
+	complex V;		/* voltage */
+	double P, Q;	/* specified injection */
+	complex S;		/* computed injection */
+} NRBUS;
+
+typedef struct s_nrbranch {
+	link_object *data;
+	unsigned int ff, ft, tf, tt;	/* positions of the branch terms in the admittance matrix */
+} NRBRANCH;
+
+static OBJECT *nr_owner = NULL;		/* swing bus that runs the solution */
+static bool nr_ready = false;		/* admittance and Jacobian structures are built */
+
+static unsigned int n_bus = 0;
+static unsigned int n_branch = 0;
+static NRBUS *bus = NULL;
+static NRBRANCH *branch = NULL;
+
+/* bus admittance matrix, by rows */
+static unsigned int Y_nnz = 0;
+static unsigned int *Y_row = NULL;		/* start of each row */
+static unsigned int *Y_col = NULL;		/* column of each term */
+static unsigned int *Y_diag = NULL;		/* position of the diagonal term of each row */
+static unsigned int *Y_trans = NULL;	/* position of the transposed term */
+static complex *Y = NULL;
+
+/* Jacobian, by columns for superLU - bus k has columns 2k (angle) and 2k+1 (magnitude) */
+static unsigned int J_size = 0;
+static double *J_val = NULL;
+static int *J_row = NULL;
+static int *J_col = NULL;
+static double *J_rhs = NULL;
+static int *perm_c = NULL;
+static int *perm_r = NULL;
+static NCformat J_store;
+static DNformat B_store;
+static SuperMatrix J_LU, B_LU;
+
+/** Names the swing bus that runs the solution, the first one initialized gets it
+ **/
+void solver_nr_attach(OBJECT *swing)
+{
+	if (nr_owner==NULL)
+		nr_owner = swing;
+}
+
+/** Checks whether an object runs the solution
+ **/
+bool solver_nr_owner(OBJECT *obj)
+{
+	return obj==nr_owner;
+}
+
+static void *solver_nr_malloc(size_t size)
+{
+	void *ptr = gl_malloc(size);
+	if (ptr==NULL)
+	{
+		GL_THROW("network NR: unable to allocate %u bytes for the solver", (unsigned int)size);
+		/*  TROUBLESHOOT
+			While building the admittance and Jacobian matrices of the network Newton-Raphson
+			solver, memory could not be allocated.  The system is probably out of memory.  Reduce
+			the size of the model, or use the Gauss-Seidel solver (network::solver_method GS).
+		*/
+	}
+	return ptr;
+}
+
+static int solver_nr_pair_compare(const void *a, const void *b)
+{
+	const unsigned int *p = (const unsigned int*)a;
+	const unsigned int *q = (const unsigned int*)b;
+	if (p[0]!=q[0])
+		return p[0]<q[0] ? -1 : 1;
+	if (p[1]!=q[1])
+		return p[1]<q[1] ? -1 : 1;
+	return 0;
+}
+
+/* position of a term in the admittance matrix, which must be there */
+static unsigned int solver_nr_find(unsigned int row, unsigned int col)
+{
+	unsigned int lo = Y_row[row], hi = Y_row[row+1];
+	while (lo<hi)
+	{
+		unsigned int mid = (lo+hi)/2;
+		if (Y_col[mid]<col)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* numbers the buses and builds the admittance and Jacobian structures */
+static void solver_nr_build(void)
+{
+	OBJECT *obj;
+	unsigned int i, k, e, n_pair, *pair;
+
+	// count the buses and branches
+	n_bus = n_branch = 0;
+	for (obj=gl_object_get_first(); obj!=NULL; obj=obj->next)
+	{
+		if (obj->oclass==node_class)
+			n_bus++;
+		else if (obj->oclass==link_class)
+			n_branch++;
+	}
+	bus = (NRBUS*)solver_nr_malloc(sizeof(NRBUS)*n_bus);
+	branch = (NRBRANCH*)solver_nr_malloc(sizeof(NRBRANCH)*(n_branch>0?n_branch:1));
+
+	// the diagonal and both off-diagonal terms of each branch
+	n_pair = n_bus+2*n_branch;
+	pair = (unsigned int*)solver_nr_malloc(sizeof(unsigned int)*2*n_pair);
+	n_bus = n_branch = n_pair = 0;
+	for (obj=gl_object_get_first(); obj!=NULL; obj=obj->next)
+	{
+		if (obj->oclass==node_class)
+		{
+			node *p = OBJECTDATA(obj,node);
+			p->NR_index = n_bus;
+			bus[n_bus].data = p;
+			bus[n_bus].Vset = p->V.Mag();
+			pair[2*n_pair] = pair[2*n_pair+1] = n_bus;
+			n_pair++;
+			n_bus++;
+		}
+	}
+	for (obj=gl_object_get_first(); obj!=NULL; obj=obj->next)
+	{
+		if (obj->oclass==link_class)
+		{
+			link_object *p = OBJECTDATA(obj,link_object);
+			if (p->from==NULL || p->to==NULL || p->from->oclass!=node_class || p->to->oclass!=node_class || p->from==p->to)
+			{
+				gl_free(pair);
+				GL_THROW("network NR: link:%d does not connect two different network nodes", obj->id);
+				/*  TROUBLESHOOT
+					The Newton-Raphson solver requires that every link of the network module connects
+					two different nodes of the network module.  Check the \p from and \p to properties
+					of the link.
+				*/
+			}
+			branch[n_branch].data = p;
+			i = OBJECTDATA(p->from,node)->NR_index;
+			k = OBJECTDATA(p->to,node)->NR_index;
+			pair[2*n_pair] = i; pair[2*n_pair+1] = k;
+			n_pair++;
+			pair[2*n_pair] = k; pair[2*n_pair+1] = i;
+			n_pair++;
+			n_branch++;
+		}
+	}
+
+	// rows of the admittance matrix, with parallel branches sharing terms
+	qsort(pair,n_pair,2*sizeof(unsigned int),solver_nr_pair_compare);
+	Y_row = (unsigned int*)solver_nr_malloc(sizeof(unsigned int)*(n_bus+1));
+	Y_col = (unsigned int*)solver_nr_malloc(sizeof(unsigned int)*n_pair);
+	memset(Y_row,0,sizeof(unsigned int)*(n_bus+1));
+	for (e=0, Y_nnz=0; e<n_pair; e++)
+	{
+		if (Y_nnz>0 && pair[2*e]==pair[2*e-2] && pair[2*e+1]==pair[2*e-1])
+			continue;
+		Y_col[Y_nnz++] = pair[2*e+1];
+		Y_row[pair[2*e]+1]++;
+	}
+	gl_free(pair);
+	for (i=0; i<n_bus; i++)
+		Y_row[i+1] += Y_row[i];
+	Y = (complex*)solver_nr_malloc(sizeof(complex)*Y_nnz);
+	Y_diag = (unsigned int*)solver_nr_malloc(sizeof(unsigned int)*n_bus);
+	Y_trans = (unsigned int*)solver_nr_malloc(sizeof(unsigned int)*Y_nnz);
+	for (i=0; i<n_bus; i++)
+	{
+		Y_diag[i] = solver_nr_find(i,i);
+		for (e=Y_row[i]; e<Y_row[i+1]; e++)
+			Y_trans[e] = solver_nr_find(Y_col[e],i);
+	}
+	for (k=0; k<n_branch; k++)
+	{
+		i = OBJECTDATA(branch[k].data->from,node)->NR_index;
+		e = OBJECTDATA(branch[k].data->to,node)->NR_index;
+		branch[k].ff = Y_diag[i];
+		branch[k].tt = Y_diag[e];
+		branch[k].ft = solver_nr_find(i,e);
+		branch[k].tf = solver_nr_find(e,i);
+	}
+
+	// the Jacobian has a 2x2 block for each admittance term, by columns the rows
+	// of the terms in row k of Y serve the columns of bus k since Y is structurally symmetric
+	J_size = 2*n_bus;
+	J_val = (double*)solver_nr_malloc(sizeof(double)*4*Y_nnz);
+	J_row = (int*)solver_nr_malloc(sizeof(int)*4*Y_nnz);
+	J_col = (int*)solver_nr_malloc(sizeof(int)*(J_size+1));
+	J_rhs = (double*)solver_nr_malloc(sizeof(double)*J_size);
+	perm_c = (int*)solver_nr_malloc(sizeof(int)*J_size);
+	perm_r = (int*)solver_nr_malloc(sizeof(int)*J_size);
+	for (k=0; k<n_bus; k++)
+	{
+		unsigned int degree = Y_row[k+1]-Y_row[k];
+		J_col[2*k] = 4*Y_row[k];
+		J_col[2*k+1] = 4*Y_row[k]+2*degree;
+		for (e=Y_row[k]; e<Y_row[k+1]; e++)
+		{
+			unsigned int pos = 2*(e-Y_row[k]);
+			J_row[J_col[2*k]+pos] = J_row[J_col[2*k+1]+pos] = 2*Y_col[e];
+			J_row[J_col[2*k]+pos+1] = J_row[J_col[2*k+1]+pos+1] = 2*Y_col[e]+1;
+		}
+	}
+	J_col[J_size] = 4*Y_nnz;
+
+	J_store.nnz = 4*Y_nnz;
+	J_store.nzval = J_val;
+	J_store.rowind = J_row;
+	J_store.colptr = J_col;
+	J_LU.Stype = SLU_NC;
+	J_LU.Dtype = SLU_D;
+	J_LU.Mtype = SLU_GE;
+	J_LU.nrow = J_size;
+	J_LU.ncol = J_size;
+	J_LU.Store = &J_store;
+
+	B_store.lda = J_size;
+	B_store.nzval = J_rhs;
+	B_LU.Stype = SLU_DN;
+	B_LU.Dtype = SLU_D;
+	B_LU.Mtype = SLU_GE;
+	B_LU.nrow = J_size;
+	B_LU.ncol = 1;
+	B_LU.Store = &B_store;
+
+	// the sparsity never changes, so neither does the column ordering
+	get_perm_c(1, &J_LU, perm_c);
+
+	gl_verbose("network NR: %u buses, %u branches, %u admittance terms", n_bus, n_branch, Y_nnz);
+}
+
+/* assembles the admittance matrix from the current link and node values */
+static void solver_nr_admittance(void)
+{
+	unsigned int i, e;
+
+	for (e=0; e<Y_nnz; e++)
+		Y[e] = complex(0,0);
+	for (i=0; i<n_bus; i++)
+		Y[Y_diag[i]] += complex(bus[i].data->G,bus[i].data->B);
+	for (i=0; i<n_branch; i++)
+	{
+		link_object *p = branch[i].data;
+		complex Yeff = p->Y + complex(0,p->B/2);
+		complex Yft = p->Y*p->c;
+		Y[branch[i].ff] += Yeff*p->c*p->c;
+		Y[branch[i].tt] += Yeff;
+		Y[branch[i].ft] -= Yft;
+		Y[branch[i].tf] -= Yft;
+	}
+}
+
+/* computes the injections and fills the right-hand side with the mismatches, returns the largest */
+static double solver_nr_mismatch(void)
+{
+	unsigned int i, e;
+	double dP, dQ, worst = 0;
+
+	for (i=0; i<n_bus; i++)
+	{
+		NRBUS *b = bus+i;
+		complex I(0,0);
+		for (e=Y_row[i]; e<Y_row[i+1]; e++)
+			I += Y[e]*bus[Y_col[e]].V;
+		b->S = b->V*~I;
+
+		dP = (b->type==SWING ? 0 : b->P - b->S.Re());
+		dQ = (b->type==PQ ? b->Q - b->S.Im() : 0);
+		J_rhs[2*i] = dP;
+		J_rhs[2*i+1] = dQ;
+		if (fabs(dP)>worst) worst = fabs(dP);
+		if (fabs(dQ)>worst) worst = fabs(dQ);
+	}
+	return worst;
+}
+
+/* Jacobian term, or the identity if its row or column is held */
+static inline double solver_nr_term(bool held, unsigned int row, unsigned int col, double value)
+{
+	return held ? (row==col ? 1.0 : 0.0) : value;
+}
+
+/* fills the Jacobian from the voltages and injections of the last mismatch */
+static void solver_nr_jacobian(void)
+{
+	unsigned int i, k, e;
+	complex j(0,1);
+
+	for (k=0; k<n_bus; k++)
+	{
+		bool held_a = (bus[k].type==SWING);
+		bool held_m = (bus[k].type!=PQ);
+		double *Ja = J_val+J_col[2*k];
+		double *Jm = J_val+J_col[2*k+1];
+		for (e=Y_row[k]; e<Y_row[k+1]; e++, Ja+=2, Jm+=2)
+		{
+			complex dA, dM;	// derivatives of S(i) by the angle and the relative magnitude of V(k)
+			i = Y_col[e];
+			complex a = bus[i].V*~(Y[Y_trans[e]]*bus[k].V);
+			if (i==k)
+			{
+				dA = j*(bus[k].S - a);
+				dM = bus[k].S + a;
+			}
+			else
+			{
+				dA = -(j*a);
+				dM = a;
+			}
+			bool held_p = (bus[i].type==SWING);
+			bool held_q = (bus[i].type!=PQ);
+			Ja[0] = solver_nr_term(held_a||held_p, 2*i, 2*k, dA.Re());
+			Ja[1] = solver_nr_term(held_a||held_q, 2*i+1, 2*k, dA.Im());
+			Jm[0] = solver_nr_term(held_m||held_p, 2*i, 2*k+1, dM.Re());
+			Jm[1] = solver_nr_term(held_m||held_q, 2*i+1, 2*k+1, dM.Im());
+		}
+	}
+}
+
+/** Solves the network voltages
+	@return the number of iterations taken
+ **/
+int solver_nr(TIMESTAMP t0)
+{
+	unsigned int i;
+	int iteration, info;
+	SuperMatrix L_LU, U_LU;
+
+	if (!nr_ready)
+	{
+		solver_nr_build();
+		nr_ready = true;
+	}
+
+	// link and node values are read on every solution, so changes to them are seen
+	solver_nr_admittance();
+	for (i=0; i<n_bus; i++)
+	{
+		NRBUS *b = bus+i;
+		node *p = b->data;
+		b->type = (p->type==PV || p->type==SWING) ? p->type : PQ;
+		b->Vm = (b->type==PV ? b->Vset : p->V.Mag());
+		b->Va = p->V.Arg();
+		b->V.SetPolar(b->Vm,b->Va);
+		b->P = -p->S.Re();
+		b->Q = -p->S.Im();
+	}
+
+	for (iteration=0; solver_nr_mismatch()>convergence_limit; iteration++)
+	{
+		if (iteration>=NR_iteration_limit)
+		{
+			GL_THROW("network NR: the solution did not converge in %d iterations", NR_iteration_limit);
+			/*  TROUBLESHOOT
+				The Newton-Raphson solution of the network did not reach the power mismatch set by
+				network::convergence_limit within network::NR_iteration_limit iterations.  The loading
+				may be past the point the network can supply, or the model data may be invalid.  Check
+				the loads, generation and line impedances, or raise network::NR_iteration_limit.
+			*/
+		}
+
+		solver_nr_jacobian();
+
+		pdgssv(1, &J_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
+
+		/* superLU matrix types must be destroyed at every iteration */
+		Destroy_SuperNode_SCP(&L_LU);
+		Destroy_CompCol_NCP(&U_LU);
+
+		if (info!=0)
+		{
+			GL_THROW("network NR: superLU failed to solve the Jacobian with code %d", info);
+			/*  TROUBLESHOOT
+				The Jacobian of the network Newton-Raphson solution is singular.  This happens when
+				part of the network has no SWING bus, or is connected to the rest only through open
+				links.  Run the network check or verify that every island has a SWING bus.
+			*/
+		}
+
+		// apply the corrections, J_rhs holds the solution
+		for (i=0; i<n_bus; i++)
+		{
+			NRBUS *b = bus+i;
+			b->Va += J_rhs[2*i];
+			b->Vm *= 1 + J_rhs[2*i+1];
+			b->V.SetPolar(b->Vm,b->Va);
+		}
+	}
+
+	// post the solution, the node S stays as given and the solved power goes to NR_S
+	for (i=0; i<n_bus; i++)
+	{
+		NRBUS *b = bus+i;
+		node *p = b->data;
+		p->V.SetPolar(b->Vm,b->Va);
+		p->NR_S = -b->S;
+		p->NR_S.Notation() = J;
+	}
+
+	// the current into each link at its from end, from the same two-port terms added to Y
+	for (i=0; i<n_branch; i++)
+	{
+		link_object *p = branch[i].data;
+		complex Yeff = p->Y + complex(0,p->B/2);
+		p->I = Yeff*p->c*p->c*OBJECTDATA(p->from,node)->V - p->Y*p->c*OBJECTDATA(p->to,node)->V;
+	}
+
+	gl_verbose("network NR: solved in %d iteration%s at %" FMT_INT64 "d", iteration, iteration==1?"":"s", t0);
+	return iteration;
+}
+
+/**@}*/
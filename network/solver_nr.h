@@ -0,0 +1,12 @@
+/** $Id: solver_nr.h
+	Copyright (C) 2008 Battelle Memorial Institute
+ **/
+
+#ifndef _NETWORK_SOLVER_NR_H
+#define _NETWORK_SOLVER_NR_H
+
+void solver_nr_attach(OBJECT *swing);
+bool solver_nr_owner(OBJECT *obj);
+int solver_nr(TIMESTAMP t0);
+
+#endif
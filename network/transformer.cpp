@@ -23,9 +23,8 @@ CLASS* transformer::oclass = NULL;
 CLASS* transformer::pclass = NULL;
 transformer *transformer::defaults = NULL;
 
-CLASS *transformer_class = (NULL);
 
-transformer::transformer(MODULE *mod) : link(mod)
+transformer::transformer(MODULE *mod) : link_object(mod)
 {
 	// first time init
 	if (oclass==NULL)
@@ -58,7 +57,7 @@ transformer::transformer(MODULE *mod) : link(mod)
 
 int transformer::create() 
 {
-	int result = link::create();
+	int result = link_object::create();
 	memcpy(this,defaults,sizeof(*this));
 	return result;
 }
@@ -70,7 +69,7 @@ TIMESTAMP transformer::sync(TIMESTAMP t0)
 	if (f==NULL || t==NULL)
 		return TS_NEVER;
 	// TODO: update transformer state
-	return link::sync(t0);
+	return link_object::sync(t0);
 }
 //////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION OF CORE LINKAGE: transformer
@@ -7,7 +7,7 @@
 
 #include "link.h"
 
-class transformer : public link {
+class transformer : public link_object {
 public:
 	enum {TT_YY=0, TT_YD=1, TT_DY=2, TT_DD=3} Type;
 	double Sbase;
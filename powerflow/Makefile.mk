@@ -19,6 +19,7 @@ powerflow_powerflow_la_SOURCES += powerflow/billdump.cpp
 powerflow_powerflow_la_SOURCES += powerflow/billdump.h
 powerflow_powerflow_la_SOURCES += powerflow/capacitor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/capacitor.h
+powerflow_powerflow_la_SOURCES += powerflow/complex_matrix.h
 powerflow_powerflow_la_SOURCES += powerflow/currdump.cpp
 powerflow_powerflow_la_SOURCES += powerflow/currdump.h
 powerflow_powerflow_la_SOURCES += powerflow/emissions.cpp
@@ -76,11 +77,14 @@ powerflow_powerflow_la_SOURCES += powerflow/regulator.h
 powerflow_powerflow_la_SOURCES += powerflow/regulator_test.h
 powerflow_powerflow_la_SOURCES += powerflow/restoration.cpp
 powerflow_powerflow_la_SOURCES += powerflow/restoration.h
+powerflow_powerflow_la_SOURCES += powerflow/scenario_batch.cpp
+powerflow_powerflow_la_SOURCES += powerflow/scenario_batch.h
 powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.cpp	
 powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.h
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.h
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.cpp
+powerflow_powerflow_la_SOURCES += powerflow/solver_nr_complex.cpp
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.h
 powerflow_powerflow_la_SOURCES += powerflow/substation.cpp
 powerflow_powerflow_la_SOURCES += powerflow/substation.h
@@ -88,6 +92,8 @@ powerflow_powerflow_la_SOURCES += powerflow/switch_object.cpp
 powerflow_powerflow_la_SOURCES += powerflow/switch_object.h
 powerflow_powerflow_la_SOURCES += powerflow/test.cpp
 powerflow_powerflow_la_SOURCES += powerflow/test.h
+powerflow_powerflow_la_SOURCES += powerflow/topology_csr.cpp
+powerflow_powerflow_la_SOURCES += powerflow/topology_csr.h
 powerflow_powerflow_la_SOURCES += powerflow/transformer_configuration.cpp
 powerflow_powerflow_la_SOURCES += powerflow/transformer_configuration.h
 powerflow_powerflow_la_SOURCES += powerflow/transformer.cpp
@@ -122,3 +128,7 @@ powerflow_powerflow_la_SOURCES += powerflow/uot/uot_network_exporter.cpp
 powerflow_powerflow_la_SOURCES += powerflow/uot/uot_network_exporter.h
 powerflow_powerflow_la_SOURCES += powerflow/uot/uot_state_exporter.cpp
 powerflow_powerflow_la_SOURCES += powerflow/uot/uot_state_exporter.h
+
+if ENABLE_BENCHMARKS
+powerflow_powerflow_la_SOURCES += powerflow/complex_matrix_bench.cpp
+endif
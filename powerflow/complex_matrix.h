@@ -0,0 +1,243 @@
+/* $Id
+ * Fixed-size complex matrix kernels behind link_object::lmatrix_mult and lmatrix_vmult
+ *
+ * Two forms are provided, both templated on the dimension:
+ *
+ * - cmatrix<N> holds the real and imaginary parts in separate column-major arrays,
+ *   so products walk contiguous columns and handle two rows per SSE2 operation.
+ *   Converting in and out costs a pass over the data, so these pay off when every
+ *   entry is used several times - the 6x6 link and 8x8 transformer matrix products
+ *   that go through lmatrix_mult.
+ *
+ * - The *_complex kernels work in place on row-major complex arrays (&a_mat[0][0],
+ *   node voltages), handling each entry's real/imaginary pair as one SSE2 register.
+ *   These are for the one-shot matrix-vector products of lmatrix_vmult (in-rush
+ *   history terms, fault current solves), where a conversion would cost more than
+ *   it saves.
+ *
+ * The 3x3 link, transformer and regulator calculations are left as scalar loops -
+ * the compiler's code is as fast as either form at that size.
+ *
+ * Every output entry is accumulated in the same k=0..N-1 order as the scalar
+ * complex loops they replace, so results match those bit for bit.
+ */
+
+#ifndef _COMPLEX_MATRIX
+#define _COMPLEX_MATRIX
+
+#include "complex.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CMATRIX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Smallest size cmatrix_mult_complex converts to the split form for */
+#define CMATRIX_SPLIT_MULT_MIN 6
+
+template <int N> struct cmatrix {
+	double re[N*N];	///< real parts - column-major, entry (row,col) is at col*N+row
+	double im[N*N];	///< imaginary parts - same layout
+};
+
+/********************************************************************
+ * Split storage
+ ********************************************************************/
+
+/* Loads a row-major complex matrix (e.g., &a_mat[0][0]) */
+template <int N> inline void cmatrix_load(cmatrix<N> &m, complex *src)
+{
+	int jindex, kindex;
+
+	for (jindex=0; jindex<N; jindex++)
+	{
+		for (kindex=0; kindex<N; kindex++)
+		{
+			m.re[kindex*N+jindex] = src[jindex*N+kindex].Re();
+			m.im[kindex*N+jindex] = src[jindex*N+kindex].Im();
+		}
+	}
+}
+
+/* Stores back into a row-major complex matrix */
+template <int N> inline void cmatrix_store(cmatrix<N> &m, complex *dst)
+{
+	int jindex, kindex;
+
+	for (jindex=0; jindex<N; jindex++)
+	{
+		for (kindex=0; kindex<N; kindex++)
+		{
+			dst[jindex*N+kindex] = complex(m.re[kindex*N+jindex],m.im[kindex*N+jindex]);
+		}
+	}
+}
+
+/* Accumulates column col_re/col_im times (xr + j*xi) into the rows of acc_re/acc_im - one k term
+   of every output row, the building block of the split products */
+template <int N> inline void cmatrix_column_acc(double *acc_re, double *acc_im, double *col_re, double *col_im, double xr, double xi)
+{
+	int jindex = 0;
+
+#ifdef CMATRIX_SSE2
+	__m128d vxr = _mm_set1_pd(xr);
+	__m128d vxi = _mm_set1_pd(xi);
+	__m128d cre, cim;
+
+	for (; (jindex+1)<N; jindex+=2)
+	{
+		cre = _mm_loadu_pd(&col_re[jindex]);
+		cim = _mm_loadu_pd(&col_im[jindex]);
+
+		//Same rounding as complex *= : re = ar*xr - ai*xi, im = ar*xi + ai*xr
+		_mm_storeu_pd(&acc_re[jindex],_mm_add_pd(_mm_loadu_pd(&acc_re[jindex]),_mm_sub_pd(_mm_mul_pd(cre,vxr),_mm_mul_pd(cim,vxi))));
+		_mm_storeu_pd(&acc_im[jindex],_mm_add_pd(_mm_loadu_pd(&acc_im[jindex]),_mm_add_pd(_mm_mul_pd(cre,vxi),_mm_mul_pd(cim,vxr))));
+	}
+#endif
+
+	//Scalar rows (odd row out, or everything without SSE2)
+	for (; jindex<N; jindex++)
+	{
+		acc_re[jindex] += col_re[jindex] * xr - col_im[jindex] * xi;
+		acc_im[jindex] += col_re[jindex] * xi + col_im[jindex] * xr;
+	}
+}
+
+/* c = a*b - c must be different from a and b */
+template <int N> inline void cmatrix_mult(cmatrix<N> &a, cmatrix<N> &b, cmatrix<N> &c)
+{
+	int jindex, kindex;
+
+	for (jindex=0; jindex<N*N; jindex++)
+	{
+		c.re[jindex] = 0.0;
+		c.im[jindex] = 0.0;
+	}
+
+	//Column j of c is a times column j of b
+	for (jindex=0; jindex<N; jindex++)
+	{
+		for (kindex=0; kindex<N; kindex++)
+		{
+			cmatrix_column_acc<N>(&c.re[jindex*N],&c.im[jindex*N],&a.re[kindex*N],&a.im[kindex*N],b.re[jindex*N+kindex],b.im[jindex*N+kindex]);
+		}
+	}
+}
+
+/********************************************************************
+ * Kernels on complex arrays
+ ********************************************************************/
+
+#ifdef CMATRIX_SSE2
+/* [re,im] of a complex - r and i are adjacent members */
+inline __m128d cmatrix_pair_load(complex &value)
+{
+	return _mm_loadu_pd(&value.Re());
+}
+
+inline void cmatrix_pair_store(complex &value, __m128d pair)
+{
+	_mm_storeu_pd(&value.Re(),pair);
+	value.Notation() = CNOTATION_DEFAULT;
+}
+
+/* x prepared for products: [xr,xi] and [-xi,xr] */
+inline void cmatrix_pair_prep(__m128d x, __m128d &x_fwd, __m128d &x_rot)
+{
+	x_fwd = x;
+	x_rot = _mm_xor_pd(_mm_shuffle_pd(x,x,1),_mm_set_pd(0.0,-0.0));
+}
+
+/* a*x with the rounding of complex *= : ar*[xr,xi] + ai*[-xi,xr] = [ar*xr - ai*xi, ar*xi + ai*xr] */
+inline __m128d cmatrix_pair_mul(complex &a, __m128d x_fwd, __m128d x_rot)
+{
+	return _mm_add_pd(_mm_mul_pd(_mm_load1_pd(&a.Re()),x_fwd),_mm_mul_pd(_mm_load1_pd(&a.Im()),x_rot));
+}
+#endif
+
+/* y = a*x for a row-major N x N complex array */
+template <int N> inline void cmatrix_vmult_complex(complex *a, complex *x, complex *y)
+{
+	int jindex, kindex;
+
+#ifdef CMATRIX_SSE2
+	__m128d x_fwd[N], x_rot[N];
+	__m128d acc;
+
+	//Pull x first, so y may be the same vector
+	for (kindex=0; kindex<N; kindex++)
+	{
+		cmatrix_pair_prep(cmatrix_pair_load(x[kindex]),x_fwd[kindex],x_rot[kindex]);
+	}
+
+	for (jindex=0; jindex<N; jindex++)
+	{
+		acc = _mm_setzero_pd();
+
+		for (kindex=0; kindex<N; kindex++)
+		{
+			acc = _mm_add_pd(acc,cmatrix_pair_mul(a[jindex*N+kindex],x_fwd[kindex],x_rot[kindex]));
+		}
+
+		cmatrix_pair_store(y[jindex],acc);
+	}
+#else
+	complex xv[N];
+
+	for (kindex=0; kindex<N; kindex++)
+	{
+		xv[kindex] = x[kindex];
+	}
+
+	for (jindex=0; jindex<N; jindex++)
+	{
+		y[jindex] = complex(0.0,0.0);
+
+		for (kindex=0; kindex<N; kindex++)
+		{
+			y[jindex] += a[jindex*N+kindex] * xv[kindex];
+		}
+	}
+#endif
+}
+
+/* c = a*b - larger sizes through the split form, small ones as plain complex loops
+   (for 3x3 and 4x4 the compiler's scalar code is already as fast as either SIMD form) */
+template <int N> inline void cmatrix_mult_complex(complex *a, complex *b, complex *c)
+{
+	int jindex, kindex, lindex;
+
+	if (N >= CMATRIX_SPLIT_MULT_MIN)
+	{
+		cmatrix<N> wa, wb, wc;
+
+		cmatrix_load<N>(wa,a);
+		cmatrix_load<N>(wb,b);
+		cmatrix_mult<N>(wa,wb,wc);
+		cmatrix_store<N>(wc,c);
+	}
+	else
+	{
+		complex wc[N*N];	//Out of place, so c may be a or b
+
+		for (jindex=0; jindex<N; jindex++)
+		{
+			for (kindex=0; kindex<N; kindex++)
+			{
+				wc[jindex*N+kindex] = complex(0.0,0.0);
+
+				for (lindex=0; lindex<N; lindex++)
+				{
+					wc[jindex*N+kindex] += a[jindex*N+lindex] * b[lindex*N+kindex];
+				}
+			}
+		}
+
+		for (jindex=0; jindex<N*N; jindex++)
+		{
+			c[jindex] = wc[jindex];
+		}
+	}
+}
+
+#endif
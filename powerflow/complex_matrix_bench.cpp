@@ -0,0 +1,226 @@
+// $Id: complex_matrix_bench.cpp
+/**	Copyright (C) 2008 Battelle Memorial Institute
+
+	@file complex_matrix_bench.cpp
+
+	Microbenchmark of the fixed-size complex matrix kernels (complex_matrix.h)
+	against the scalar complex loops the link routines used before them (the
+	powerflow module's --modtest, see bench.h).
+
+	Each case is timed both ways on the same pseudo-random inputs, and the
+	largest difference between the two results is reported along with the
+	times - the kernels keep the scalar summation order, so it should be zero.
+
+	@{
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "powerflow.h"
+#include "complex_matrix.h"
+#include "bench.h"
+
+#define BENCH_SAMPLES 64	///< Distinct inputs cycled through, so nothing stays constant across iterations
+
+typedef struct s_bench_data {
+	complex *a, *b, *c;		///< matrix-matrix operands and product, BENCH_SAMPLES of each
+	complex *x, *y;			///< matrix-vector operand and product, BENCH_SAMPLES of each
+} BENCHDATA;
+
+//Deterministic inputs - no need to touch the simulation random streams
+static void bench_fill(complex *values, int count, unsigned int *seed)
+{
+	int index;
+	double re, im;
+
+	for (index=0; index<count; index++)
+	{
+		*seed = *seed * 1103515245 + 12345;
+		re = (double)((*seed >> 8) & 0xFFFF) / 65536.0 - 0.5;
+		*seed = *seed * 1103515245 + 12345;
+		im = (double)((*seed >> 8) & 0xFFFF) / 65536.0 - 0.5;
+
+		values[index] = complex(re,im);
+	}
+}
+
+static double bench_maxdiff(complex *a, complex *b, int count)
+{
+	int index;
+	double diff, maxdiff;
+
+	maxdiff = 0.0;
+	for (index=0; index<count; index++)
+	{
+		diff = (a[index] - b[index]).Mag();
+
+		if (diff > maxdiff)
+			maxdiff = diff;
+	}
+
+	return maxdiff;
+}
+
+//Scalar references - the loops lmatrix_mult/lmatrix_vmult use for sizes without a kernel
+template <int N> static void bench_scalar_mult(void *data, unsigned int iterations)
+{
+	BENCHDATA *bd = (BENCHDATA *)data;
+	complex *a, *b, *c;
+	unsigned int iter;
+	int jindex, kindex, lindex;
+
+	for (iter=0; iter<iterations; iter++)
+	{
+		a = &bd->a[(iter % BENCH_SAMPLES)*N*N];
+		b = &bd->b[(iter % BENCH_SAMPLES)*N*N];
+		c = &bd->c[(iter % BENCH_SAMPLES)*N*N];
+
+		for (jindex=0; jindex<N; jindex++)
+		{
+			for (kindex=0; kindex<N; kindex++)
+			{
+				c[jindex*N+kindex] = complex(0.0,0.0);
+
+				for (lindex=0; lindex<N; lindex++)
+				{
+					c[jindex*N+kindex] += a[jindex*N+lindex] * b[lindex*N+kindex];
+				}
+			}
+		}
+		bench_keep(c[0].Re());
+	}
+}
+
+template <int N> static void bench_scalar_vmult(void *data, unsigned int iterations)
+{
+	BENCHDATA *bd = (BENCHDATA *)data;
+	complex *a, *x, *y;
+	unsigned int iter;
+	int jindex, kindex;
+
+	for (iter=0; iter<iterations; iter++)
+	{
+		a = &bd->a[(iter % BENCH_SAMPLES)*N*N];
+		x = &bd->x[(iter % BENCH_SAMPLES)*N];
+		y = &bd->y[(iter % BENCH_SAMPLES)*N];
+
+		for (jindex=0; jindex<N; jindex++)
+		{
+			y[jindex] = complex(0.0,0.0);
+
+			for (kindex=0; kindex<N; kindex++)
+			{
+				y[jindex] += a[jindex*N+kindex] * x[kindex];
+			}
+		}
+		bench_keep(y[0].Re());
+	}
+}
+
+//The kernels, on the same inputs
+template <int N> static void bench_kernel_mult(void *data, unsigned int iterations)
+{
+	BENCHDATA *bd = (BENCHDATA *)data;
+	unsigned int iter, sample;
+
+	for (iter=0; iter<iterations; iter++)
+	{
+		sample = iter % BENCH_SAMPLES;
+		cmatrix_mult_complex<N>(&bd->a[sample*N*N],&bd->b[sample*N*N],&bd->c[sample*N*N]);
+		bench_keep(bd->c[sample*N*N].Re());
+	}
+}
+
+template <int N> static void bench_kernel_vmult(void *data, unsigned int iterations)
+{
+	BENCHDATA *bd = (BENCHDATA *)data;
+	unsigned int iter, sample;
+
+	for (iter=0; iter<iterations; iter++)
+	{
+		sample = iter % BENCH_SAMPLES;
+		cmatrix_vmult_complex<N>(&bd->a[sample*N*N],&bd->x[sample*N],&bd->y[sample*N]);
+		bench_keep(bd->y[sample*N].Re());
+	}
+}
+
+static void bench_report(const char *name, unsigned int iterations, double scalar_time, double kernel_time, double maxdiff)
+{
+	double scalar_ns, kernel_ns;
+
+	scalar_ns = scalar_time * 1e9 / iterations;
+	kernel_ns = kernel_time * 1e9 / iterations;
+
+	gl_testmsg("  %-22s %10u   %10.1f   %10.1f   %6.2fx   %.3g",name,iterations,scalar_ns,kernel_ns,(kernel_ns > 0.0 ? scalar_ns/kernel_ns : 0.0),maxdiff);
+}
+
+//Times matrix-vector (and for the larger sizes, matrix-matrix) products of one size, both ways - the scalar
+//and kernel results are kept in separate buffers so they can be compared afterwards
+template <int N> static void bench_size(unsigned int iterations, unsigned int *seed)
+{
+	BENCHDATA scalar, kernel;
+	char name[64];
+	double scalar_time, kernel_time;
+	unsigned int vm_iterations;
+
+	scalar.a = kernel.a = new complex[BENCH_SAMPLES*N*N];
+	scalar.b = kernel.b = new complex[BENCH_SAMPLES*N*N];
+	scalar.x = kernel.x = new complex[BENCH_SAMPLES*N];
+	scalar.c = new complex[BENCH_SAMPLES*N*N];
+	kernel.c = new complex[BENCH_SAMPLES*N*N];
+	scalar.y = new complex[BENCH_SAMPLES*N];
+	kernel.y = new complex[BENCH_SAMPLES*N];
+
+	bench_fill(scalar.a,BENCH_SAMPLES*N*N,seed);
+	bench_fill(scalar.b,BENCH_SAMPLES*N*N,seed);
+	bench_fill(scalar.x,BENCH_SAMPLES*N,seed);
+
+	//Matrix-matrix - below CMATRIX_SPLIT_MULT_MIN the kernel is the same loop, so skip it
+	if (N >= CMATRIX_SPLIT_MULT_MIN)
+	{
+		scalar_time = bench_best(bench_scalar_mult<N>,&scalar,iterations);
+		kernel_time = bench_best(bench_kernel_mult<N>,&kernel,iterations);
+
+		sprintf(name,"mult %dx%d",N,N);
+		bench_report(name,iterations,scalar_time,kernel_time,bench_maxdiff(scalar.c,kernel.c,BENCH_SAMPLES*N*N));
+	}
+
+	//Matrix-vector is cheaper, so run it more
+	vm_iterations = iterations*N;
+
+	scalar_time = bench_best(bench_scalar_vmult<N>,&scalar,vm_iterations);
+	kernel_time = bench_best(bench_kernel_vmult<N>,&kernel,vm_iterations);
+
+	sprintf(name,"vmult %dx%d",N,N);
+	bench_report(name,vm_iterations,scalar_time,kernel_time,bench_maxdiff(scalar.y,kernel.y,BENCH_SAMPLES*N));
+
+	delete [] scalar.a;
+	delete [] scalar.b;
+	delete [] scalar.x;
+	delete [] scalar.c;
+	delete [] kernel.c;
+	delete [] scalar.y;
+	delete [] kernel.y;
+}
+
+EXPORT void test(int argc, char *argv[])
+{
+	unsigned int seed = 1;
+
+#ifdef CMATRIX_SSE2
+	gl_testmsg("powerflow complex matrix kernels (SSE2) vs. scalar complex loops");
+#else
+	gl_testmsg("powerflow complex matrix kernels (scalar build) vs. scalar complex loops");
+#endif
+	gl_testmsg("  %-22s %10s   %10s   %10s   %7s   %s","operation","calls","scalar ns","kernel ns","speedup","max diff");
+
+	bench_size<2>(1000000,&seed);
+	bench_size<3>(1000000,&seed);
+	bench_size<4>(500000,&seed);
+	bench_size<6>(200000,&seed);
+	bench_size<8>(100000,&seed);
+}
+
+/**@}**/
@@ -8,6 +8,7 @@
 #include <math.h>
 
 #include "fault_check.h"
+#include "node.h"
 
 //////////////////////////////////////////////////////////////////////////
 // fault_check CLASS FUNCTIONS
@@ -73,6 +74,16 @@ int fault_check::create(void)
 
 	grid_association_mode = false;	//By default, we go to normal "Highlander" grid (there can be only one!)
 
+	topo_search.size = 0;			//Search workspace over NR_topology - allocated on first use
+	topo_search.queue = NULL;
+	topo_search.stack_pos = NULL;
+	topo_search.queued = NULL;
+
+	mesh_link_state = NULL;		//Link snapshot for incremental mesh checks - allocated on first use
+	mesh_state_valid = false;	//No mesh check done yet
+	mesh_state_swing = -1;
+	mesh_state_seed = 0x00;
+
 	return result;
 }
 
@@ -208,18 +219,7 @@ TIMESTAMP fault_check::sync(TIMESTAMP t0)
 				}
 			}//End restoration function map
 
-			//Mandate "mesh mode" for this, just because I say so
-			if (reliability_search_mode == true)	//Radial
-			{
-				gl_warning("fault_check interaction with restoration requires meshed checking mode - enabling this now");
-				/*  TROUBLESHOOT
-				The restoration algorithm is improved by using the meshed mode of topology checking for faults.  This has
-				been automatically enabled for the object.  If this is undesired, do not use fault_check with restoration.
-				*/
-
-				//Set it to mesh
-				reliability_search_mode = false;
-			}
+			//Restoration runs in "mesh mode" - mandated when the alteration values were allocated
 
 			//Call restoration -- fault_checks will occur as part of this
 			return_val = ((int (*)(OBJECT *,int))(*restoration_fxn))(restoration_object,-99);
@@ -344,202 +344,168 @@ TIMESTAMP fault_check::sync(TIMESTAMP t0)
 }
 
 
+//Function to make sure the shared topology index matches the current powerflow, and that this object has a search workspace for it
+//Connectivity is fixed once all links have populated, so this only builds it once
+void fault_check::check_topology_index(void)
+{
+	if (topology_csr_current(&NR_topology,NR_bus_count,NR_branch_count) == false)
+	{
+		//Make sure everything has populated its link tables first
+		if ((NR_curr_bus != (int)NR_bus_count) || (NR_curr_branch != (int)NR_branch_count))
+		{
+			GL_THROW("fault_check: Incomplete initialization detected - this will cause issues");
+			//Defined above
+		}
+
+		topology_csr_build(&NR_topology,NR_busdata,NR_bus_count,NR_branchdata,NR_branch_count);
+	}
+
+	//Our own search workspace - the index is shared, the queue isn't
+	topology_search_alloc(&topo_search,NR_topology.bus_count);
+}
+
+//Breadth-first support search - buses are queued whenever they pick up a newly supported phase
 void fault_check::search_links(int node_int)
 {
-	unsigned int index, indexb;
-	bool both_handled, from_val, first_resto, proceed_in;
-	int branch_val;
-	BRANCHDATA temp_branch;
+	unsigned int entry, indexb, head, tail, queue_count;
+	int bus_val, far_val;
+	bool proceed_in;
+	BRANCHDATA *temp_branch;
 	unsigned char work_phases;
 
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
-	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+	check_topology_index();
 
-		first_resto = false;		//Flag that restoration hasn't gone off
-		proceed_in = false;			//Flag that we need to go the next link in
+	//Start with the entry bus
+	head = 0;
+	tail = 0;
+	queue_count = 0;
 
-		//Check for no phase condition
-		if ((temp_branch.phases & 0x07) != 0x00)
+	topo_search.queue[tail] = node_int;
+	topo_search.queued[node_int] = 1;
+	tail = (tail + 1) % NR_topology.bus_count;
+	queue_count++;
+
+	while (queue_count > 0)
+	{
+		bus_val = topo_search.queue[head];
+		topo_search.queued[bus_val] = 0;
+		head = (head + 1) % NR_topology.bus_count;
+		queue_count--;
+
+		//Loop through the connectivity and populate appropriately
+		for (entry=NR_topology.adj_start[bus_val]; entry<NR_topology.adj_start[bus_val+1]; entry++)
 		{
+			temp_branch = &NR_branchdata[NR_topology.adj_branch[entry]];	//Get connecting link information
+
+			//Check for no phase condition
+			if ((temp_branch->phases & 0x07) == 0x00)
+				continue;
+
+			far_val = NR_topology.adj_bus[entry];
+			proceed_in = false;			//Flag that we need to go the next link in
+
 			for (indexb=0; indexb<3; indexb++)	//Handle phases
 			{
 				work_phases = 0x04 >> indexb;	//Pull off the phase reference
 
-				if ((temp_branch.phases & work_phases) == work_phases)	//We are of the proper phase
+				if ((temp_branch->phases & work_phases) == work_phases)	//We are of the proper phase
 				{
-					both_handled = false;	//Reset flag
-
-					//See which end we are, and if the other end has been handled
-					if (temp_branch.from == node_int)	//We're the from
+					//Our end supported and the far one not yet - flag it as connected
+					if ((Supported_Nodes[bus_val][indexb] == 1) && (Supported_Nodes[far_val][indexb] != 1))
 					{
-						from_val = true;	//Flag us as the from end (so we don't have to check it again later)
+						Supported_Nodes[far_val][indexb] = 1;
+						proceed_in = true;
 					}
-					else	//Must be the to
-					{
-						from_val = false;	//Flag us as the to end (so we don't have to check it again later)
-					}
-
-					//See if both sides of this link are already set - if so, don't bother going back in
-					if ((Supported_Nodes[temp_branch.to][indexb]==1) && (Supported_Nodes[temp_branch.from][indexb]==1))
-						both_handled=true;
-
-					//If not handled, proceed with logic-ness
-					if (both_handled==false)
-					{
-						//Figure out the indexing so we can tell what we are
-						if (from_val)	//From end
-						{
-							branch_val = temp_branch.to;
-
-							//See if our FROM end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.from][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
-						else	//To end
-						{
-							branch_val = temp_branch.from;
-
-							//See if our TO end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.to][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
-
-						//Flag us as connected
-						Supported_Nodes[branch_val][indexb] = 1;
-
-					}//End both not handled (work to be done)
 				}//End are a proper phase
 			}//End phase testloop
 
-			if (proceed_in)
+			//Something new on the far end - queue it, if it isn't already waiting
+			if ((proceed_in == true) && (topo_search.queued[far_val] == 0))
 			{
-				//Recursion!!
-				search_links(branch_val);
+				topo_search.queue[tail] = far_val;
+				topo_search.queued[far_val] = 1;
+				tail = (tail + 1) % NR_topology.bus_count;
+				queue_count++;
 			}
-		}//End has phases test loop
-	}//End link table loop
+		}//End link table loop
+	}//End queue loop
 }
 
-//Mesh searching function -- checks to see how something was removed
-void fault_check::search_links_mesh(int node_int)
+//Phases a link can carry support on in the mesh check -- current phases, plus the original ones if it is closed
+unsigned char fault_check::mesh_link_phases(int branch_idx)
 {
-	unsigned int index, device_value, node_value;
-	unsigned char temp_phases, temp_compare_phases;
+	unsigned char temp_phases;
 
-	//Check our entry mode -- if grid association mode, do this as a recursion
-	if (grid_association_mode == false)	//Nope, do "normally"
+	//Get initial phasing information - the ones that are available
+	temp_phases = NR_branchdata[branch_idx].phases;
+
+	//Are we a switch
+	if ((NR_branchdata[branch_idx].lnk_type == 2) || (NR_branchdata[branch_idx].lnk_type == 5) || (NR_branchdata[branch_idx].lnk_type == 6))
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		if (*NR_branchdata[branch_idx].status == 1)
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
-
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
-			}
+			temp_phases |= NR_branchdata[branch_idx].origphases & 0x07;
+		}
+	}
+	else
+	{
+		temp_phases |= NR_branchdata[branch_idx].origphases & 0x07;
+	}
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+	return (temp_phases & 0x07);
+}
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
-				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-				}
-			}
+//Mesh searching function -- spreads valid_phases out from the queued buses until nothing changes
+//Support only ever grows here, so the result is the same whatever order the buses are handled in
+void fault_check::propagate_mesh_support(unsigned int head, unsigned int tail, unsigned int queue_count)
+{
+	unsigned int entry;
+	int bus_val, far_val;
+	unsigned char temp_compare_phases;
 
-			//Populate the phase information
-			valid_phases[node_value] |= (valid_phases[node_int] & temp_phases);
-		}//End of node link table traversion
-	}//End not grid association mode
-	else	//Grid association mode
+	while (queue_count > 0)
 	{
+		bus_val = topo_search.queue[head];
+		topo_search.queued[bus_val] = 0;
+		head = (head + 1) % NR_topology.bus_count;
+		queue_count--;
+
 		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		for (entry=NR_topology.adj_start[bus_val]; entry<NR_topology.adj_start[bus_val+1]; entry++)
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
-
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
-			}
+			far_val = NR_topology.adj_bus[entry];
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+			//Check our "contributions" against the other end
+			temp_compare_phases = (valid_phases[far_val] | (valid_phases[bus_val] & mesh_link_phases(NR_topology.adj_branch[entry])));
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
+			//See if it changed - if so, store it and handle that node too
+			if (valid_phases[far_val] != temp_compare_phases)
 			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
+				valid_phases[far_val] = temp_compare_phases;
+
+				if (topo_search.queued[far_val] == 0)
 				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
+					topo_search.queue[tail] = far_val;
+					topo_search.queued[far_val] = 1;
+					tail = (tail + 1) % NR_topology.bus_count;
+					queue_count++;
 				}
 			}
+			//Default else -- they match, so don't bother
+		}//End of node link table traversion
+	}//End queue loop
+}
 
-			//Check our "contributions" against the other end - use this to determine recursion
-			temp_compare_phases = (valid_phases[node_value] | (valid_phases[node_int] & temp_phases));
+//Mesh searching function -- checks to see how something was removed
+void fault_check::search_links_mesh(int node_int)
+{
+	check_topology_index();
 
-			//See if it is the same
-			if (valid_phases[node_value] != temp_compare_phases)
-			{
-				//Populate the phase information - store what we just did (no point doing twice)
-				valid_phases[node_value] = temp_compare_phases;
+	//Seed the queue with this node and spread out from it
+	topo_search.queue[0] = node_int;
+	topo_search.queued[node_int] = 1;
 
-				//Recurse in, do this node now
-				search_links_mesh(node_value);
-			}
-			//Default else -- they match, so don't bother
-		}//End of node link table traversion
-	}//End grid association mode
+	propagate_mesh_support(0,(1 % NR_topology.bus_count),1);
 }
 
 void fault_check::support_check(int swing_node_int)
@@ -566,29 +532,119 @@ void fault_check::support_check(int swing_node_int)
 //Mesh-capable version of support check -- by default, it doesn't support restoration object
 void fault_check::support_check_mesh(int swing_node_int)
 {
-	unsigned int indexa, indexb;
+	unsigned int indexa, tail, queue_count;
+	unsigned char seed_phases, link_phases;
+	bool full_check;
 
-	//Reset the node status list
-	reset_support_check();
+	check_topology_index();
 
-	if (grid_association_mode == false)	//Not needing to do grid association, use normal, inefficient method
+	if (grid_association_mode == false)	//Not needing to do grid association, use the single swing
 	{
+		//Allocate the link snapshot, if this is the first time through
+		if (mesh_link_state == NULL)
+		{
+			mesh_link_state = (unsigned char *)gl_malloc(NR_branch_count*sizeof(unsigned char));
+
+			if (mesh_link_state == NULL)
+			{
+				GL_THROW("fault_check: link alteration status vector allocation failure");
+				//Defined below
+			}
+
+			mesh_state_valid = false;
+		}
+
 		//Swing node has support - if the phase exists (changed for complete faults)
-		valid_phases[swing_node_int] = NR_busdata[swing_node_int].phases & 0x07;
+		seed_phases = NR_busdata[swing_node_int].phases & 0x07;
 
-		//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-		//Supports possibly meshed topology - brute force method
-		for (indexa=0; indexa<NR_bus_count; indexa++)
+		//See if the last check can just be extended -- only if no link (or the swing) lost phases since it was done
+		//Closing a switch only adds support, so the old result is still a subset of the new one
+		full_check = true;
+		if ((mesh_state_valid == true) && (mesh_state_swing == swing_node_int) && ((mesh_state_seed & ~seed_phases) == 0x00))
+		{
+			full_check = false;
+
+			for (indexa=0; indexa<NR_branch_count; indexa++)
+			{
+				if ((mesh_link_state[indexa] & ~mesh_link_phases(indexa)) != 0x00)
+				{
+					full_check = true;	//Something opened or was removed - start over
+					break;
+				}
+			}
+		}
+
+		if (full_check == true)
 		{
-			for (indexb=0; indexb<NR_bus_count; indexb++)
+			//Reset the node status list
+			reset_support_check();
+
+			//Snapshot the links as they are now
+			for (indexa=0; indexa<NR_branch_count; indexa++)
 			{
-				//Call the search link on individual nodes
-				search_links_mesh(indexb);
+				mesh_link_state[indexa] = mesh_link_phases(indexa);
 			}
+
+			valid_phases[swing_node_int] = seed_phases;
+
+			//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
+			search_links_mesh(swing_node_int);
 		}
+		else	//Incremental -- only spread out from the ends of links that picked up phases
+		{
+			tail = 0;
+			queue_count = 0;
+
+			if (seed_phases != mesh_state_seed)
+			{
+				valid_phases[swing_node_int] |= seed_phases;
+
+				topo_search.queue[tail] = swing_node_int;
+				topo_search.queued[swing_node_int] = 1;
+				tail = (tail + 1) % NR_topology.bus_count;
+				queue_count++;
+			}
+
+			for (indexa=0; indexa<NR_branch_count; indexa++)
+			{
+				link_phases = mesh_link_phases(indexa);
+
+				if (link_phases != mesh_link_state[indexa])
+				{
+					mesh_link_state[indexa] = link_phases;
+
+					//Queue whichever ends already have support
+					if ((valid_phases[NR_branchdata[indexa].from] != 0x00) && (topo_search.queued[NR_branchdata[indexa].from] == 0))
+					{
+						topo_search.queue[tail] = NR_branchdata[indexa].from;
+						topo_search.queued[NR_branchdata[indexa].from] = 1;
+						tail = (tail + 1) % NR_topology.bus_count;
+						queue_count++;
+					}
+
+					if ((valid_phases[NR_branchdata[indexa].to] != 0x00) && (topo_search.queued[NR_branchdata[indexa].to] == 0))
+					{
+						topo_search.queue[tail] = NR_branchdata[indexa].to;
+						topo_search.queued[NR_branchdata[indexa].to] = 1;
+						tail = (tail + 1) % NR_topology.bus_count;
+						queue_count++;
+					}
+				}
+			}
+
+			propagate_mesh_support(0,tail,queue_count);
+		}
+
+		//Store what this check was based on
+		mesh_state_seed = seed_phases;
+		mesh_state_swing = swing_node_int;
+		mesh_state_valid = true;
 	}
 	else	//Grid association mode, do slightly different
 	{
+		//Reset the node status list
+		reset_support_check();
+
 		//Traverse the whole bus list, just in case (since may be altered in the future)
 		for (indexa=0; indexa<NR_bus_count; indexa++)
 		{
@@ -653,6 +709,9 @@ void fault_check::reset_support_check(void)
 			valid_phases[index] = 0x00;
 		}
 	}
+
+	//Any previous mesh check can't be built on anymore
+	mesh_state_valid = false;
 }
 
 void fault_check::write_output_file(TIMESTAMP tval, double tval_delta)
@@ -1431,25 +1490,46 @@ void fault_check::special_object_alteration_handle(int branch_idx)
 	}//End "normal" reliability operations
 }
 
-//Recursive function to traverse powerflow and alter phases as necessary
+//Function to traverse powerflow and alter phases as necessary
 //Based on search_links code from above
 void fault_check::support_search_links(int node_int, int node_start, bool impact_mode)
 {
-	unsigned int index;
+	unsigned int entry;
+	int stack_depth, link_val;
 	bool both_handled, from_val;
 	int branch_val;
-	BRANCHDATA temp_branch;
+	BRANCHDATA *temp_branch;
 	unsigned char work_phases, phase_restrictions;
 
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
+	check_topology_index();
+
+	//Walk depth-first with an explicit stack -- links are handled in the same order the recursive walk did
+	stack_depth = 0;
+	topo_search.queue[0] = node_int;
+	topo_search.stack_pos[0] = NR_topology.adj_start[node_int];
+
+	while (stack_depth >= 0)
 	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+		node_int = topo_search.queue[stack_depth];
+
+		//Done with this node's links -- back up to the node that led here
+		if (topo_search.stack_pos[stack_depth] >= NR_topology.adj_start[node_int+1])
+		{
+			stack_depth--;
+			continue;
+		}
+
+		//Pull the next link off this node
+		entry = topo_search.stack_pos[stack_depth];
+		topo_search.stack_pos[stack_depth]++;
+
+		link_val = NR_topology.adj_branch[entry];
+		temp_branch = &NR_branchdata[link_val];	//Get connecting link information
 
 		both_handled = false;	//Reset flag
 
 		//See which end we are, and if the other end has been handled
-		if (temp_branch.from == node_int)	//We're the from
+		if (temp_branch->from == node_int)	//We're the from
 		{
 			from_val = true;	//Flag us as the from end (so we don't have to check it again later)
 		}
@@ -1460,13 +1540,13 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 
 		if ((node_int == node_start) && (from_val == false))	//We're the TO side of the base node, Oh Noes!
 		{
-			Alteration_Nodes[temp_branch.from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
+			Alteration_Nodes[temp_branch->from] = 1;	//Flag us to prevent future issues (not sure how they'd happen)
 			continue;	//Nothing to do with this link, so I hereby render this iteration useless and proceed to skip it
 		}
 		else	//FROM side of any, or not the TO side as the base node
 		{
 			//See if both sides of this link are already set - if so, don't bother going back in
-			if ((Alteration_Nodes[temp_branch.to]==1) && (Alteration_Nodes[temp_branch.from]==1))
+			if ((Alteration_Nodes[temp_branch->to]==1) && (Alteration_Nodes[temp_branch->from]==1))
 				both_handled=true;
 		}
 
@@ -1476,38 +1556,38 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			//Figure out the indexing so we can tell what we are
 			if (from_val)	//From end
 			{
-				branch_val = temp_branch.to;
+				branch_val = temp_branch->to;
 
 				if (impact_mode == false)	//Removal time
 				{
 					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
+					if (Alteration_Nodes[temp_branch->from] == 1)
 					{
 						//Remove our phase portions - determine by our FROM end
-						work_phases = NR_busdata[temp_branch.from].phases & 0x07;
+						work_phases = NR_busdata[temp_branch->from].phases & 0x07;
 
 						//See if we are split-phase
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
+						if ((NR_branchdata[link_val].phases & 0x80) == 0x80)
 						{
 							//See if any support exists
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & work_phases) == 0x00)	//no longer any support
+							if ((NR_branchdata[link_val].phases & work_phases) == 0x00)	//no longer any support
 							{
 								//Just remove it all
-								NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases = 0x00;
+								NR_branchdata[link_val].phases = 0x00;
 							}
 							//Defaulted else - do nothing
 						}
 						else	//Not split-phase, normal - continue
 						{
 							//Remove components - USBs are typically node oriented, so they aren't included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
+							NR_branchdata[link_val].phases &= work_phases;
 						}
 
 						//Now apply the phases on the TO end of this branch - first off, get base phases - D is omitted (D unsupported for now)
-						work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+						work_phases = NR_branchdata[link_val].phases & 0x07;
 
 						//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
+						if ((NR_branchdata[link_val].phases & 0x80) == 0x80)
 						{
 							work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
 						}
@@ -1517,7 +1597,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						}
 
 						//Apply the change to the TO node
-						NR_busdata[temp_branch.to].phases &= work_phases;
+						NR_busdata[temp_branch->to].phases &= work_phases;
 					}//End FROM end is valid
 					else	//FROM end not valid - hope we get hit by something else later
 					{
@@ -1527,12 +1607,12 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 				else	//Restoration time
 				{
 					//Make sure our FROM end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.from] == 1)
+					if (Alteration_Nodes[temp_branch->from] == 1)
 					{
 						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
-						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
+						phase_restrictions = ~(NR_branchdata[link_val].faultphases & 0x07);	//Get unrestricted
 
-						phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
+						phase_restrictions &= (NR_branchdata[link_val].origphases & 0x07);	//Mask this with what we used to be
 
 						if (phase_restrictions == 0x00)	//No phases are available below here, go to next
 						{
@@ -1541,32 +1621,32 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						else	//At least one phase is valid, proceed
 						{
 							//Restore our phase portions - determine by our FROM end and restrictions
-							work_phases = NR_busdata[temp_branch.from].phases & phase_restrictions;
+							work_phases = NR_busdata[temp_branch->from].phases & phase_restrictions;
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+							if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
 							{
 								if (work_phases != 0x00)
-									work_phases |= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0xE0);	//Mask in SPCT-type flags
+									work_phases |= (NR_branchdata[link_val].origphases & 0xE0);	//Mask in SPCT-type flags
 							}
 
 							//Restore components - USBs are typically node oriented, so they aren't explicitly included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
+							NR_branchdata[link_val].phases |= work_phases;
 
 							//Now apply the phases on the TO end of this branch - first off, get base phases
-							work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+							work_phases = NR_branchdata[link_val].phases & 0x07;
 
 							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
+							if ((NR_branchdata[link_val].phases & 0x80) == 0x80)
 							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
+								work_phases |= (NR_busdata[temp_branch->to].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
 							}
 							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
 							{
-								work_phases |= (NR_busdata[temp_branch.to].origphases & 0x18);	//D
+								work_phases |= (NR_busdata[temp_branch->to].origphases & 0x18);	//D
 							}
 
 							//Apply the change to the TO node
-							NR_busdata[temp_branch.to].phases |= work_phases;
+							NR_busdata[temp_branch->to].phases |= work_phases;
 						}
 					}//End FROM end is valid
 					else	//FROM end not valid - hope we get hit by something else later
@@ -1577,30 +1657,30 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			}//End FROM end
 			else	//To end
 			{
-				branch_val = temp_branch.from;
+				branch_val = temp_branch->from;
 
 				if (impact_mode == false)	//Removal time
 				{
 					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
+					if (Alteration_Nodes[temp_branch->to] == 1)	//Implies TO is done, but not FROM.  Basically indicates reverse flow or a mesh - not necessarily good (solver won't care)
 					{
 						//Remove our phase portions - determine by our TO end
-						work_phases = NR_busdata[temp_branch.to].phases & 0x07;
+						work_phases = NR_busdata[temp_branch->to].phases & 0x07;
 
-						if ((temp_branch.phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
+						if ((temp_branch->phases & 0x80) == 0x80)	//See if we are split phase - if so and no phases are present, remove that too for good measure
 						{
 							if (work_phases != 0x00)
 								work_phases |= 0xA0;	//Add in the split phase flag
 						}
 
 						//Remove components - USBs are typically node oriented, so they aren't included here
-						NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases &= work_phases;
+						NR_branchdata[link_val].phases &= work_phases;
 
 						//Now apply the phases on the FROM end of this branch - first off, get base phases - D is omitted (D unsupported for now)
-						work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+						work_phases = NR_branchdata[link_val].phases & 0x07;
 
 						//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-						if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
+						if ((NR_branchdata[link_val].phases & 0x80) == 0x80)
 						{
 							work_phases |= 0xE0;	//SP, House?, To SPCT - flagged on
 						}
@@ -1610,7 +1690,7 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						}
 
 						//Apply the change to the FROM node
-						NR_busdata[temp_branch.from].phases &= work_phases;
+						NR_busdata[temp_branch->from].phases &= work_phases;
 					}//End TO end is valid
 					else	//TO end not valid - hope we get hit by something else later
 					{
@@ -1620,12 +1700,12 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 				else	//Restoration time
 				{
 					//Make sure our TO end is valid first - just in case
-					if (Alteration_Nodes[temp_branch.to] == 1)
+					if (Alteration_Nodes[temp_branch->to] == 1)
 					{
 						//Now see if we can even proceed - if we are a fault blocked area, then go no lower
-						phase_restrictions = ~(NR_branchdata[NR_busdata[node_int].Link_Table[index]].faultphases & 0x07);	//Get unrestricted
+						phase_restrictions = ~(NR_branchdata[link_val].faultphases & 0x07);	//Get unrestricted
 
-						phase_restrictions &= (NR_branchdata[NR_busdata[node_int].Link_Table[index]].origphases & 0x07);	//Mask this with what we used to be
+						phase_restrictions &= (NR_branchdata[link_val].origphases & 0x07);	//Mask this with what we used to be
 
 						if (phase_restrictions == 0x00)	//No phases are available below here, go to next
 						{
@@ -1634,32 +1714,32 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 						else	//At least one phase is valid, proceed
 						{
 							//Restore our phase portions - determine by our TO end and restrictions
-							work_phases = NR_busdata[temp_branch.to].phases & phase_restrictions;
+							work_phases = NR_busdata[temp_branch->to].phases & phase_restrictions;
 
-							if ((temp_branch.origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
+							if ((temp_branch->origphases & 0x80) == 0x80)	//See if we were split phase - if so and no phases are present, remove that too for good measure
 							{
 								if (work_phases != 0x00)
 									work_phases |= 0x80;	//Add in the split phase flag
 							}
 
 							//Restore components - USBs are typically node oriented, so they aren't explicitly included here
-							NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases |= work_phases;
+							NR_branchdata[link_val].phases |= work_phases;
 
 							//Now apply the phases on the TO end of this branch - first off, get base phases
-							work_phases = NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07;
+							work_phases = NR_branchdata[link_val].phases & 0x07;
 
 							//See if the line is a SPCT or Triplex - if so, bring the flag in.  If not, clear it
-							if ((NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x80) == 0x80)
+							if ((NR_branchdata[link_val].phases & 0x80) == 0x80)
 							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
+								work_phases |= (NR_busdata[temp_branch->from].origphases & 0xE0);	//SP, House?, To SPCT - flagged on
 							}
 							else if (work_phases == 0x07)	//Fully connected, we can pass D and diff conns
 							{
-								work_phases |= (NR_busdata[temp_branch.from].origphases & 0x18);	//House?, D
+								work_phases |= (NR_busdata[temp_branch->from].origphases & 0x18);	//House?, D
 							}
 
 							//Apply the change to the TO node
-							NR_busdata[temp_branch.from].phases |= work_phases;
+							NR_busdata[temp_branch->from].phases |= work_phases;
 						}
 					}//End TO end is valid
 					else	//TO end not valid - hope we get hit by something else later
@@ -1670,15 +1750,28 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			}//End TO end
 
 			//Functionalized version of modifier
-			special_object_alteration_handle(NR_busdata[node_int].Link_Table[index]);
+			special_object_alteration_handle(link_val);
 
 			//Flag us as handled
 			Alteration_Nodes[branch_val] = 1;
 
-			//Recursion!!
-			support_search_links(branch_val,node_start,impact_mode);
+			//Go down this side before the rest of our links -- each node only gets flagged (and stacked) once
+			stack_depth++;
+
+			if (stack_depth >= (int)NR_topology.bus_count)
+			{
+				GL_THROW("fault_check: topology search exceeded the bus count");
+				/*  TROUBLESHOOT
+				While walking the system to remove or restore unsupported components, the search visited
+				more nodes than exist in the system.  This should not occur.  Please submit your code and a
+				bug report via the ticketing system.
+				*/
+			}
+
+			topo_search.queue[stack_depth] = branch_val;
+			topo_search.stack_pos[stack_depth] = NR_topology.adj_start[branch_val];
 		}//End both not handled (work to be done)
-	}//End link table loop
+	}//End link walk
 }
 
 //Function to reset "touched" alteration variable
@@ -1725,6 +1818,17 @@ void fault_check::allocate_alterations_values(bool reliability_mode_bool)
 			unsuccessful node support checks will call the reconfiguration.
 			*/
 		}
+		else if (reliability_search_mode == true)	//Radial - mandate "mesh mode" for restoration, before the mesh items below are skipped
+		{
+			gl_warning("fault_check interaction with restoration requires meshed checking mode - enabling this now");
+			/*  TROUBLESHOOT
+			The restoration algorithm is improved by using the meshed mode of topology checking for faults.  This has
+			been automatically enabled for the object.  If this is undesired, do not use fault_check with restoration.
+			*/
+
+			//Set it to mesh
+			reliability_search_mode = false;
+		}
 
 		//Create our node reference vector - one for each bus
 		Supported_Nodes = (unsigned int**)gl_malloc(NR_bus_count*sizeof(unsigned int*));
@@ -1838,8 +1942,8 @@ void fault_check::momentary_activation(int node_int)
 		//Map it
 		momentary_flag = (bool*)GETADDR(tmp_obj,pval);
 
-		//Flag it
-		*momentary_flag = true;
+		//Flag it - through the node, so any reliability counters see the change
+		OBJECTDATA(tmp_obj,node)->set_interruption_flag(momentary_flag,true,true);
 	}
 
 	//Loop through the link table
@@ -1988,52 +2092,68 @@ void fault_check::associate_grids(void)
 }
 
 //Multiple grid checking items - the actual crawler
-//This is recursively called
 void fault_check::search_associated_grids(unsigned int node_int, int grid_counter)
 {
-	unsigned int index;
-	int node_ref;
+	unsigned int entry, head, tail, queue_count;
+	int bus_val, node_ref;
 
-	//Loop through the connection table for this node
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+	check_topology_index();
+
+	//Breadth-first from the source -- each newly associated node gets queued once
+	head = 0;
+	tail = 0;
+	queue_count = 0;
+
+	topo_search.queue[tail] = node_int;
+	topo_search.queued[node_int] = 1;
+	tail = (tail + 1) % NR_topology.bus_count;
+	queue_count++;
+
+	while (queue_count > 0)
 	{
-		//See which end of the link we are
-		if (NR_branchdata[NR_busdata[node_int].Link_Table[index]].from == node_int)	//From end
-		{
-			//Set the node-ref - must be other end
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].to;
-		}
-		else	//Must be the to-end
-		{
-			//Set the node-ref, it must be us
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].from;
-		}
+		bus_val = topo_search.queue[head];
+		topo_search.queued[bus_val] = 0;
+		head = (head + 1) % NR_topology.bus_count;
+		queue_count--;
 
-		//We're theoretically coming from a "powered node", so see if it has any phase alignment to proceed
-		//Only do "in service" items, so go on current phases, not original phases
-		if (((NR_busdata[node_int].phases & 0x07) & (NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07)) != 0x00)
+		//Loop through the connection table for this node
+		for (entry=NR_topology.adj_start[bus_val]; entry<NR_topology.adj_start[bus_val+1]; entry++)
 		{
-			//See if the other side has been handled
-			if (associated_grid[node_ref] == -1)
-			{
-				//Set the appropriate side
-				associated_grid[node_ref] = grid_counter;
+			//Other end of the link
+			node_ref = NR_topology.adj_bus[entry];
 
-				//Recurse in
-				search_associated_grids(node_ref,grid_counter);
-			}
-			else if (associated_grid[node_ref] != grid_counter)
+			//We're theoretically coming from a "powered node", so see if it has any phase alignment to proceed
+			//Only do "in service" items, so go on current phases, not original phases
+			if (((NR_busdata[bus_val].phases & 0x07) & (NR_branchdata[NR_topology.adj_branch[entry]].phases & 0x07)) != 0x00)
 			{
-				GL_THROW("fault_check: duplicate grid assignment on node %s!",NR_busdata[node_ref].name);
-				/*  TROUBLESHOOT
-				While mapping the associated grid/swing node for a system, a condition was encountered where
-				a node tried to belong to two different systems.  This should not have occurred.  Please submit
-				your code and a bug report via the ticketing system.
-				*/
+				//See if the other side has been handled
+				if (associated_grid[node_ref] == -1)
+				{
+					//Set the appropriate side
+					associated_grid[node_ref] = grid_counter;
+
+					//Queue it up
+					if (topo_search.queued[node_ref] == 0)
+					{
+						topo_search.queue[tail] = node_ref;
+						topo_search.queued[node_ref] = 1;
+						tail = (tail + 1) % NR_topology.bus_count;
+						queue_count++;
+					}
+				}
+				else if (associated_grid[node_ref] != grid_counter)
+				{
+					GL_THROW("fault_check: duplicate grid assignment on node %s!",NR_busdata[node_ref].name);
+					/*  TROUBLESHOOT
+					While mapping the associated grid/swing node for a system, a condition was encountered where
+					a node tried to belong to two different systems.  This should not have occurred.  Please submit
+					your code and a bug report via the ticketing system.
+					*/
+				}
+				//Default else -- already handled as this grid
 			}
-			//Default else -- already handled as this grid
+			//Default else, not a match, so next
 		}
-		//Default else, not a match, so next
 	}
 }
 
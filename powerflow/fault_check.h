@@ -37,8 +37,11 @@ public:
 	int create(void);
 	int init(OBJECT *parent=NULL);
 	int isa(char *classname);
+	void check_topology_index(void);							//Function to make sure the shared topology adjacency and this object's search workspace are built
 	void search_links(int node_int);							//Function to check connectivity and support of nodes
 	void search_links_mesh(int node_int);						//Function to check connectivity and support of nodes, but more in the "mesh" sense
+	unsigned char mesh_link_phases(int branch_idx);				//Function to get the phases a link can carry support on in the mesh check
+	void propagate_mesh_support(unsigned int head, unsigned int tail, unsigned int queue_count);	//Function to spread mesh support out from the queued nodes
 	void support_check(int swing_node_int);						//Function that performs the connectivity check - this way so can be easily externally accessed
 	void support_check_mesh(int swing_node_int);				//Function that performs the connectivity check for not-so-radial systems
 	void reset_support_check(void);								//Function to re-init the support matrix
@@ -64,6 +67,11 @@ private:
 	TIMESTAMP prev_time;	//Previous timestamp - mainly for intialization
 	FUNCTIONADDR restoration_fxn;	// Function address for restoration object reconfiguration call
 	int *associated_grid;	//Array for assignment of nodes to different "main connection" points
+	TOPOLOGY_SEARCH topo_search;	//Queue and flags of this object's searches over NR_topology
+	unsigned char *mesh_link_state;	//Phases each link could carry at the last mesh check - lets link closures extend it instead of redoing it
+	unsigned char mesh_state_seed;	//Swing phases at the last mesh check
+	int mesh_state_swing;			//Swing node of the last mesh check
+	bool mesh_state_valid;			//Flag to indicate valid_phases still holds the result of the last mesh check
 };
 
 EXPORT int powerflow_alterations(OBJECT *thisobj, int baselink,bool rest_mode);
@@ -41,6 +41,7 @@
 #include "load_tracker.h"
 #include "triplex_load.h"
 #include "impedance_dump.h"
+#include "scenario_batch.h"
 
 #include "uot/uot_network_exporter.h"
 #include "uot/uot_state_exporter.h"
@@ -85,6 +86,37 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("powerflow::NR_iteration_limit",PT_int64,&NR_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_deltamode_iteration_limit",PT_int64,&NR_delta_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_superLU_procs",PT_int32,&NR_superLU_procs,NULL);
+	gl_global_create("powerflow::NR_formulation",PT_enumeration,&NR_formulation,
+		PT_KEYWORD,"REAL",NRF_REAL,
+		PT_KEYWORD,"COMPLEX",NRF_COMPLEX,
+		PT_KEYWORD,"VALIDATE",NRF_VALIDATE,
+		PT_DESCRIPTION,"Formulation of the Newton-Raphson linear system - real/imaginary split, complex, or both with a voltage comparison",
+		NULL);
+	gl_global_create("powerflow::NR_complex_fallbacks",PT_int64,&NR_complex_fallbacks,PT_DESCRIPTION,"Number of complex formulation steps that were handed back to the real formulation",NULL);
+	gl_global_create("powerflow::NR_iteration_count",PT_int64,&NR_iteration_count,PT_DESCRIPTION,"Newton-Raphson iterations used by all converged solves",NULL);
+	gl_global_create("powerflow::NR_predictor",PT_enumeration,&NR_predictor,
+		PT_KEYWORD,"NONE",NRP_NONE,
+		PT_KEYWORD,"LINEAR",NRP_LINEAR,
+		PT_KEYWORD,"QUADRATIC",NRP_QUADRATIC,
+		PT_DESCRIPTION,"Extrapolation of the last converged bus voltages used to seed the first Newton-Raphson solve of each timestep",
+		NULL);
+	gl_global_create("powerflow::NR_predictor_correction",PT_bool,&NR_predictor_correction,PT_DESCRIPTION,"Flag to take the first step of a predicted solve with the last converged factorization, correcting for load changes",NULL);
+	gl_global_create("powerflow::NR_predictor_solves",PT_int64,&NR_predictor_solves,PT_DESCRIPTION,"Number of Newton-Raphson solves seeded by the predictor",NULL);
+	gl_global_create("powerflow::NR_predictor_iterations",PT_int64,&NR_predictor_iterations,PT_DESCRIPTION,"Newton-Raphson iterations used by the predictor-seeded solves",NULL);
+	gl_global_create("powerflow::NR_predictor_iterations_saved",PT_double,&NR_predictor_iterations_saved,PT_DESCRIPTION,"Estimated Newton-Raphson iterations saved by the predictor, against the average of unseeded timestep solves",NULL);
+	gl_global_create("powerflow::NR_qsts_fastpath",PT_enumeration,&NR_qsts_fastpath,
+		PT_KEYWORD,"NONE",NRQ_NONE,
+		PT_KEYWORD,"LINEAR",NRQ_LINEAR,
+		PT_KEYWORD,"SKIP",NRQ_SKIP,
+		PT_DESCRIPTION,"Handling of Newton-Raphson timesteps whose loads changed less than NR_qsts_load_threshold - full solve, one step with the last converged factorization, or keep the last solution",
+		NULL);
+	gl_global_create("powerflow::NR_qsts_load_threshold",PT_double,&NR_qsts_load_threshold,PT_DESCRIPTION,"Aggregate load change since the last full solve, relative to the total load, below which the fast path is taken",NULL);
+	gl_global_create("powerflow::NR_qsts_full_interval",PT_int32,&NR_qsts_full_interval,PT_DESCRIPTION,"Consecutive fast-path timesteps allowed before a full Newton-Raphson solve is forced",NULL);
+	gl_global_create("powerflow::NR_qsts_fast_solves",PT_int64,&NR_qsts_fast_solves,PT_DESCRIPTION,"Number of timesteps handled by the fast path",NULL);
+	gl_global_create("powerflow::NR_admit_lowrank",PT_bool,&NR_admit_lowrank,PT_DESCRIPTION,"Flag to keep the last converged factorization through value-only admittance changes (e.g., regulator taps), correcting it with a low-rank update",NULL);
+	gl_global_create("powerflow::NR_admit_partial_updates",PT_int64,&NR_admit_partial_updates,PT_DESCRIPTION,"Number of admittance changes that only rebuilt the matrix entries of the branches and buses they touched",NULL);
+	gl_global_create("powerflow::NR_admit_lowrank_updates",PT_int64,&NR_admit_lowrank_updates,PT_DESCRIPTION,"Number of admittance changes folded into the last converged factorization as a low-rank correction",NULL);
+	gl_global_create("powerflow::NR_assembly_procs",PT_int32,&NR_assembly_procs,PT_DESCRIPTION,"Number of threads used to assemble the Newton-Raphson mismatch and Jacobian terms",NULL);
 	gl_global_create("powerflow::default_maximum_voltage_error",PT_double,&default_maximum_voltage_error,NULL);
 	gl_global_create("powerflow::default_maximum_power_error",PT_double,&default_maximum_power_error,NULL);
 	gl_global_create("powerflow::NR_admit_change",PT_bool,&NR_admit_change,NULL);
@@ -99,6 +131,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("powerflow::enable_inrush",PT_bool,&enable_inrush_calculations,PT_DESCRIPTION,"Flag to enable in-rush calculations for lines and transformers in deltamode",NULL);
 	gl_global_create("powerflow::low_voltage_impedance_level",PT_double,&impedance_conversion_low_pu,PT_DESCRIPTION,"Lower limit of voltage (in per-unit) at which all load types are converted to impedance for in-rush calculations",NULL);
 	gl_global_create("powerflow::enable_mesh_fault_current",PT_bool,&enable_mesh_fault_current,PT_DESCRIPTION,"Flag to enable mesh-based fault current calculations",NULL);
+	gl_global_create("powerflow::NR_packed_storage",PT_bool,&NR_packed_storage,PT_DESCRIPTION,"Flag to gather bus and branch values into contiguous solver-owned arrays during Newton-Raphson solutions",NULL);
 
 	// register each object class by creating the default instance
 	new powerflow_object(module);
@@ -144,6 +177,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	new load_tracker(module);
 	new triplex_load(module);
 	new impedance_dump(module);
+	new scenario_batch(module);
 
 	new uot_network_exporter(module);
 	new uot_state_exporter(module);
@@ -495,7 +529,33 @@ int delta_extra_function(unsigned int mode)
 			return 0;
 	}
 	
-	return 1;	
+	return 1;
+}
+
+//clock_update function
+//Module-level call once the timestep has converged, before the clock advances
+//Solves the scenario batches waiting on the timestep - returns t1, since the batches don't move the clock
+EXPORT TIMESTAMP clock_update(TIMESTAMP t1)
+{
+	if (NR_batch_pending == true)
+	{
+		//Put in try/catch, since GL_THROWs inside solver_nr tend to be a little upsetting
+		try {
+			scenario_batch::run_pending(gl_globalclock);
+		}
+		catch (const char *msg)
+		{
+			gl_error("powerflow:clock_update - scenario batch solve: %s", msg);
+			return TS_INVALID;
+		}
+		catch (...)
+		{
+			gl_error("powerflow:clock_update - scenario batch solve: unknown exception");
+			return TS_INVALID;
+		}
+	}
+
+	return t1;
 }
 
 CDECL int do_kill()
@@ -754,3 +814,10 @@ EXPORT int check()
 	//return 0;
 	return 1;	//Nothing really checked in here, so just let it pass.  Not sure why it fails by default.
 }
+
+//Module termination function
+//Stops the NR assembly threads started for NR_assembly_procs
+EXPORT void term(void)
+{
+	solver_nr_assembly_stop();
+}
@@ -92,6 +92,7 @@
 #include <errno.h>
 #include <math.h>
 #include "link.h"
+#include "complex_matrix.h"
 #include "node.h"
 #include "meter.h"
 #include "regulator.h"
@@ -13385,6 +13386,20 @@ void link_object::lmatrix_mult(complex *matrix_in_A, complex *matrix_in_B, compl
 		*/
 	}
 
+	//The in-rush (6x6) and transformer (8x8) products go through the split-storage kernels - smaller
+	//ones are as quick as the loop below
+	switch (matsize)
+	{
+		case 6:
+			cmatrix_mult_complex<6>(matrix_in_A,matrix_in_B,matrix_out);
+			return;
+		case 8:
+			cmatrix_mult_complex<8>(matrix_in_A,matrix_in_B,matrix_out);
+			return;
+		default:
+			break;
+	}
+
 	//Perform the matrix mulitplication
 	for (jindex=0; jindex<matsize; jindex++)
 	{
@@ -13424,6 +13439,25 @@ void link_object::lmatrix_vmult(complex *matrix_in, complex *vector_in, complex
 		//Define elsewhere
 	}
 
+	//Sizes the links actually use go through the fixed-size kernels
+	switch (matsize)
+	{
+		case 2:
+			cmatrix_vmult_complex<2>(matrix_in,vector_in,vector_out);
+			return;
+		case 3:
+			cmatrix_vmult_complex<3>(matrix_in,vector_in,vector_out);
+			return;
+		case 4:
+			cmatrix_vmult_complex<4>(matrix_in,vector_in,vector_out);
+			return;
+		case 6:
+			cmatrix_vmult_complex<6>(matrix_in,vector_in,vector_out);
+			return;
+		default:
+			break;
+	}
+
 	//Perform the matrix mulitplication
 	for (jindex=0; jindex<matsize; jindex++)
 	{
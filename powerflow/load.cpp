@@ -25,7 +25,7 @@ load::load(MODULE *mod) : node(mod)
 	{
 		pclass = node::oclass;
 		
-		oclass = gl_register_class(mod,"load",sizeof(load),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK);
+		oclass = gl_register_class(mod,"load",sizeof(load),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK|PC_CONCURRENT_LOAD);
 		if (oclass==NULL)
 			throw "unable to register class load";
 		else
@@ -51,7 +51,7 @@ meter::meter(MODULE *mod) : node(mod)
 		pclass = node::oclass;
 
 		// register the class definition
-		oclass = gl_register_class(mod,"meter",sizeof(meter),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK);
+		oclass = gl_register_class(mod,"meter",sizeof(meter),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK|PC_CONCURRENT_LOAD);
 		if (oclass==NULL)
 			throw "unable to register class meter";
 		else
@@ -84,8 +84,8 @@ meter::meter(MODULE *mod) : node(mod)
 			PT_complex, "measured_current_A[A]", PADDR(measured_current[0]),PT_DESCRIPTION,"measured current on phase A",
 			PT_complex, "measured_current_B[A]", PADDR(measured_current[1]),PT_DESCRIPTION,"measured current on phase B",
 			PT_complex, "measured_current_C[A]", PADDR(measured_current[2]),PT_DESCRIPTION,"measured current on phase C",
-			PT_bool, "customer_interrupted", PADDR(meter_interrupted),PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an 'interrupted' state",
-			PT_bool, "customer_interrupted_secondary", PADDR(meter_interrupted_secondary),PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an 'secondary interrupted' state - i.e., momentary",
+			PT_bool, "customer_interrupted", PADDR(meter_interrupted),PT_HAS_NOTIFY,PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an 'interrupted' state",
+			PT_bool, "customer_interrupted_secondary", PADDR(meter_interrupted_secondary),PT_HAS_NOTIFY,PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an 'secondary interrupted' state - i.e., momentary",
 #ifdef SUPPORT_OUTAGES
 			PT_int16, "sustained_count", PADDR(sustained_count),	//reliability sustained event counter
 			PT_int16, "momentary_count", PADDR(momentary_count),	//reliability momentary event counter
@@ -130,6 +130,10 @@ meter::meter(MODULE *mod) : node(mod)
 			GL_THROW("Unable to publish meter deltamode function");
 		if (gl_publish_function(oclass,	"delta_freq_pwr_object", (FUNCTIONADDR)delta_frequency_node)==NULL)
 			GL_THROW("Unable to publish meter deltamode function");
+
+		//Publish reliability functions
+		if (gl_publish_function(oclass,	"attach_interruption_counter", (FUNCTIONADDR)attach_interruption_counter_node)==NULL)
+			GL_THROW("Unable to publish meter reliability counter function");
 		}
 }
 
@@ -303,7 +307,7 @@ TIMESTAMP meter::presync(TIMESTAMP t0)
 
 	//Reliability addition - if momentary flag set - clear it
 	if (meter_interrupted_secondary == true)
-		meter_interrupted_secondary = false;
+		set_interruption_flag(&meter_interrupted_secondary,false,true);
     
     // Capturing first timestamp of simulation for use in delta energy measurements.
     if (t0 != 0 && start_timestamp == 0)
@@ -332,15 +336,15 @@ void meter::BOTH_meter_sync_fxn()
 
 		if ((NR_busdata[TempNodeRef].origphases & NR_busdata[TempNodeRef].phases) != NR_busdata[TempNodeRef].origphases)	//We have a phase mismatch - something has been lost
 		{
-			meter_interrupted = true;	//Someone is out of service, they just may not know it
+			set_interruption_flag(&meter_interrupted,true,false);	//Someone is out of service, they just may not know it
 
 			//See if we're flagged for a momentary as well - if we are, clear it
 			if (meter_interrupted_secondary == true)
-				meter_interrupted_secondary = false;
+				set_interruption_flag(&meter_interrupted_secondary,false,true);
 		}
 		else
 		{
-			meter_interrupted = false;	//All is well
+			set_interruption_flag(&meter_interrupted,false,false);	//All is well
 		}
 	}
 
@@ -609,7 +613,7 @@ SIMULATIONMODE meter::inter_deltaupdate_meter(unsigned int64 delta_time, unsigne
 
 		//Reliability addition - if momentary flag set - clear it
 		if (meter_interrupted_secondary == true)
-			meter_interrupted_secondary = false;
+			set_interruption_flag(&meter_interrupted_secondary,false,true);
 
 		//Call presync-equivalent items
 		NR_node_presync_fxn(0);
@@ -787,6 +791,19 @@ EXPORT int notify_meter(OBJECT *obj, int update_mode, PROPERTY *prop, char *valu
 }
 
 //Deltamode export
+//Property notifiers - customer interruption flags go through the node, so reliability counters see every change
+EXPORT int notify_meter_customer_interrupted(OBJECT *obj, char *value)
+{
+	meter *my = OBJECTDATA(obj,meter);
+	return my->set_interruption_flag_value("customer_interrupted",&my->meter_interrupted,value,false);
+}
+
+EXPORT int notify_meter_customer_interrupted_secondary(OBJECT *obj, char *value)
+{
+	meter *my = OBJECTDATA(obj,meter);
+	return my->set_interruption_flag_value("customer_interrupted_secondary",&my->meter_interrupted_secondary,value,true);
+}
+
 EXPORT SIMULATIONMODE interupdate_meter(OBJECT *obj, unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val, bool interupdate_pos)
 {
 	meter *my = OBJECTDATA(obj,meter);
@@ -99,7 +99,7 @@ node::node(MODULE *mod) : powerflow_object(mod)
 	if(oclass == NULL)
 	{
 		pclass = powerflow_object::oclass;
-		oclass = gl_register_class(mod,"node",sizeof(node),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK);
+		oclass = gl_register_class(mod,"node",sizeof(node),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK|PC_CONCURRENT_LOAD);
 		if (oclass==NULL)
 			throw "unable to register class node";
 		else
@@ -251,6 +251,8 @@ int node::create(void)
 
 	prev_phases = 0x00;
 
+	interruption_counters = NULL;	//No reliability counters attached by default
+
 	mean_repair_time = 0.0;
 
 	// Only used in capacitors, at this time, but put into node for future functionality (maybe with reliability?)
@@ -2553,7 +2555,12 @@ TIMESTAMP node::sync(TIMESTAMP t0)
 					NR_retval=t0;
 				}
 				else
+				{
+					//Scenario batches are solved once the timestep is over - keep the loads while the children are still accounted for
+					solver_nr_batch_capture(NR_bus_count, NR_busdata);
+
 					NR_retval=t1;
+				}
 
 				//See where we wanted to go
 				return NR_retval;
@@ -4550,9 +4557,91 @@ double node::perform_GFA_checks(double timestepvalue)
 	}
 }
 
+//Function to attach a reliability interruption counter to this node
+//The counters are adjusted whenever one of our customer interruption flags is changed through set_interruption_flag
+int node::attach_interruption_counter(int *count, int *count_secondary, unsigned int *lock)
+{
+	INTERRUPTION_COUNTER *new_counter;
+
+	//Make a new entry
+	new_counter = (INTERRUPTION_COUNTER*)gl_malloc(sizeof(INTERRUPTION_COUNTER));
+
+	//Make sure it worked
+	if (new_counter == NULL)
+	{
+		return 0;
+	}
+
+	//Populate it and put it at the front of the list
+	new_counter->count = count;
+	new_counter->count_secondary = count_secondary;
+	new_counter->lock = lock;
+	new_counter->next = interruption_counters;
+	interruption_counters = new_counter;
+
+	return 1;
+}
+
+//Function to set a customer interruption flag - pushes the transition into any attached reliability counters
+void node::set_interruption_flag(bool *flag, bool value, bool secondary)
+{
+	INTERRUPTION_COUNTER *counter;
+
+	//Only transitions matter
+	if (*flag == value)
+		return;
+
+	*flag = value;
+
+	for (counter=interruption_counters; counter!=NULL; counter=counter->next)
+	{
+		::wlock(counter->lock);
+
+		if (secondary == true)
+			*counter->count_secondary += (value ? 1 : -1);
+		else
+			*counter->count += (value ? 1 : -1);
+
+		::wunlock(counter->lock);
+	}
+}
+
+//Function to set a customer interruption flag from the text value of its property
+//Called by the property notifiers, so flags set through the property system (GLM files, players, the server) keep any attached counters in step
+//The core stores the same value once the notifier returns
+int node::set_interruption_flag_value(char *propname, bool *flag, char *value, bool secondary)
+{
+	PROPERTY *pval;
+	bool new_value;
+
+	//Convert the value the same way the core would
+	pval = gl_get_property(OBJECTHDR(this),propname);
+
+	if ((pval == NULL) || (callback->convert.string_to_property(pval,(void*)&new_value,value) <= 0))
+	{
+		gl_error("Unable to set %s on %s to '%s'",propname,(OBJECTHDR(this)->name ? OBJECTHDR(this)->name : "an unnamed node"),value);
+		/*  TROUBLESHOOT
+		The customer interruption flag could not be set from the value given.  Make sure the value is a valid boolean
+		(TRUE or FALSE) and try again.
+		*/
+		return 0;
+	}
+
+	set_interruption_flag(flag,new_value,secondary);
+
+	return 1;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION OF OTHER EXPORT FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
+EXPORT int attach_interruption_counter_node(OBJECT *obj, int *count, int *count_secondary, unsigned int *lock)
+{
+	node *my = OBJECTDATA(obj,node);
+
+	return my->attach_interruption_counter(count,count_secondary,lock);
+}
+
 EXPORT int isa_node(OBJECT *obj, char *classname)
 {
 	if(obj != 0 && classname != 0){
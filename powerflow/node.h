@@ -14,6 +14,9 @@ EXPORT complex *delta_linkage(OBJECT *obj, unsigned char mapvar);
 EXPORT STATUS delta_frequency_node(OBJECT *obj, complex *powerval, complex *freqpowerval);
 EXPORT SIMULATIONMODE interupdate_node(OBJECT *obj, unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val, bool interupdate_pos);
 
+//Reliability functions
+EXPORT int attach_interruption_counter_node(OBJECT *obj, int *count, int *count_secondary, unsigned int *lock);
+
 #define I_INJ(V, S, Z, I) (I_S(S, V) + ((Z.IsFinite()) ? I_Z(Z, V) : complex(0.0)) + I_I(I))
 #define I_S(S, V) (~((S) / (V)))  // Current injection - constant power load
 #define I_Z(Z, V) ((V) / (Z))     // Current injection - constant impedance load
@@ -81,6 +84,14 @@ typedef enum {
 	METER_NODE=2		///< We're a meter
 } DYN_NODE_TYPE;		/// Definition for deltamode calls
 
+//Reliability interruption counter - customer interruption transitions are pushed into it
+typedef struct s_interruption_counter {
+	int *count;								///< Number of customers interrupted
+	int *count_secondary;					///< Number of customers secondarily interrupted
+	unsigned int *lock;						///< Lock protecting both counts
+	struct s_interruption_counter *next;	///< Next counter attached to this node
+} INTERRUPTION_COUNTER;
+
 //Frequency measurement variable structure
 typedef struct {
 	double x[3]; 		     //integrator state variable
@@ -211,6 +222,7 @@ public:
 	int NR_node_reference;		/// Node's reference in NR_busdata
 	int *NR_subnode_reference;	/// Pointer to parent node's reference in NR_busdata - just in case things get inited out of synch
 	unsigned char prev_phases;	/// Phase tracking variable for use in reliability calls
+	INTERRUPTION_COUNTER *interruption_counters;	/// Reliability counters to update when a customer interruption flag changes
 
 	inline bool is_split() {return (phases&PHASE_S)!=0;};
 public:
@@ -240,6 +252,10 @@ public:
 
 	double perform_GFA_checks(double timestepvalue);
 
+	int attach_interruption_counter(int *count, int *count_secondary, unsigned int *lock);
+	void set_interruption_flag(bool *flag, bool value, bool secondary);
+	int set_interruption_flag_value(char *propname, bool *flag, char *value, bool secondary);
+
 	bool current_accumulated;
 
 	int NR_populate(void);
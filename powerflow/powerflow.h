@@ -12,6 +12,7 @@
 
 #include "gridlabd.h"
 #include "solver_nr.h"
+#include "topology_csr.h"
 
 #ifdef _POWERFLOW_CPP
 #define GLOBAL
@@ -36,6 +37,21 @@ typedef enum {
 	MD_PERCALL=2,		///< Matrix dump every call desired
 	MD_ALL=3			///< Matrix dump on every iteration desired
 } MATRIXDUMPMETHOD;
+typedef enum {
+	NRF_REAL=0,			///< Real/imaginary split Jacobian, as originally formulated
+	NRF_COMPLEX=1,		///< One complex equation per non-swing phase, factored with complex sparse LU
+	NRF_VALIDATE=2		///< Solve with both and warn where the voltages disagree
+} NRFORMULATION;
+typedef enum {
+	NRP_NONE=0,			///< Start each timestep from the voltages the objects hold
+	NRP_LINEAR=1,		///< Linear extrapolation from the last two timesteps
+	NRP_QUADRATIC=2		///< Quadratic extrapolation from the last three timesteps
+} NRPREDICTOR;
+typedef enum {
+	NRQ_NONE=0,			///< Every timestep gets a full solve
+	NRQ_LINEAR=1,		///< Small load changes get one step with the last converged factorization
+	NRQ_SKIP=2			///< Small load changes keep the last solution
+} NRQSTSMODE;
 
 typedef enum {
 	LS_OPEN=0,			///< defines that that link is open
@@ -65,12 +81,30 @@ GLOBAL unsigned int NR_branch_count INIT(0);		/**< Newton-Raphson branch count -
 GLOBAL BUSDATA *NR_busdata INIT(NULL);				/**< Newton-Raphson bus data pointer array */
 GLOBAL BRANCHDATA *NR_branchdata INIT(NULL);		/**< Newton-Raphson branch data pointer array */
 GLOBAL NR_SOLVER_STRUCT NR_powerflow;				/**< Newton-Raphson solver working variables - "steady-state" powerflow version */
+GLOBAL TOPOLOGY_CSR NR_topology;					/**< Newton-Raphson bus/branch adjacency - shared by the topology searches */
 GLOBAL int NR_curr_bus INIT(-1);					/**< Newton-Raphson current bus indicator - used to populate NR_busdata */
 GLOBAL int NR_curr_branch INIT(-1);					/**< Newton-Raphson current branch indicator - used to populate NR_branchdata */
 GLOBAL int64 NR_iteration_limit INIT(500);			/**< Newton-Raphson iteration limit (per GridLAB-D iteration) */
 GLOBAL bool NR_dyn_first_run INIT(true);			/**< Newton-Raphson first run indicator - used by deltamode functionality for initialization powerflow */
 GLOBAL bool NR_admit_change INIT(true);				/**< Newton-Raphson admittance matrix change detector - used to prevent complete recalculation of admittance at every timestep */
 GLOBAL int NR_superLU_procs INIT(1);				/**< Newton-Raphson related - superLU MT processor count to request - separate from thread_count */
+GLOBAL NRFORMULATION NR_formulation INIT(NRF_REAL);	/**< Newton-Raphson related - real or complex formulation of the linear system */
+GLOBAL int64 NR_complex_fallbacks INIT(0);			/**< Newton-Raphson related - complex formulation steps handed back to the real formulation */
+GLOBAL int64 NR_iteration_count INIT(0);			/**< Newton-Raphson related - iterations used by all converged solves */
+GLOBAL NRPREDICTOR NR_predictor INIT(NRP_NONE);	/**< Newton-Raphson related - extrapolation used to seed the first solve of each timestep */
+GLOBAL bool NR_predictor_correction INIT(true);	/**< Newton-Raphson related - take the first step of a predicted solve with the last converged factorization */
+GLOBAL int64 NR_predictor_solves INIT(0);			/**< Newton-Raphson related - number of solves seeded by the predictor */
+GLOBAL int64 NR_predictor_iterations INIT(0);		/**< Newton-Raphson related - iterations used by the predictor-seeded solves */
+GLOBAL double NR_predictor_iterations_saved INIT(0.0);	/**< Newton-Raphson related - estimated iterations saved by the predictor, against unseeded timestep solves */
+GLOBAL NRQSTSMODE NR_qsts_fastpath INIT(NRQ_NONE);	/**< Newton-Raphson related - handling of timesteps whose loads barely changed */
+GLOBAL double NR_qsts_load_threshold INIT(0.001);	/**< Newton-Raphson related - aggregate load change, relative to the total load, below which the fast path is taken */
+GLOBAL int NR_qsts_full_interval INIT(10);			/**< Newton-Raphson related - consecutive fast-path timesteps allowed before a full solve is forced */
+GLOBAL int64 NR_qsts_fast_solves INIT(0);			/**< Newton-Raphson related - number of timesteps handled by the fast path */
+GLOBAL bool NR_admit_lowrank INIT(false);			/**< Newton-Raphson related - fold value-only admittance changes into the kept factorization as a low-rank correction */
+GLOBAL int64 NR_admit_partial_updates INIT(0);		/**< Newton-Raphson related - number of admittance changes that only rebuilt the entries they touched */
+GLOBAL int64 NR_admit_lowrank_updates INIT(0);		/**< Newton-Raphson related - number of admittance changes folded into the kept factorization */
+GLOBAL bool NR_batch_pending INIT(false);			/**< Newton-Raphson related - scenario batches are waiting for the loads of a converged timestep solve */
+GLOBAL int NR_assembly_procs INIT(1);				/**< Newton-Raphson related - threads used for the per-bus load, mismatch and Jacobian assembly loops - separate from thread_count */
 GLOBAL TIMESTAMP NR_retval INIT(TS_NEVER);			/**< Newton-Raphson current return value - if t0 objects know we aren't going anywhere */
 GLOBAL OBJECT *NR_swing_bus INIT(NULL);				/**< Newton-Raphson swing bus */
 GLOBAL int NR_swing_bus_reference INIT(-1);			/**< Newton-Raphson swing bus index reference in NR_busdata */
@@ -117,6 +151,7 @@ GLOBAL double impedance_conversion_low_pu INIT(0.7);	/** Lower PU voltage level
 GLOBAL double deltatimestep_running INIT(-1.0);			/** Value of the current deltamode simulation - used for integration method in in-rush */
 
 //Mesh fault current stuff
+GLOBAL bool NR_packed_storage INIT(false);		/**< Flag to have the NR solver gather bus and branch values into contiguous arrays for the solve */
 GLOBAL bool enable_mesh_fault_current INIT(false);	/** Flag to enable mesh-based fault current calculations */
 
 // Deltamode stuff
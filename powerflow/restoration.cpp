@@ -1932,17 +1932,17 @@ void restoration::simplifyTop_2(void)
 }
 
 //Set feeder vertices
+//Breadth-first from each feeder vertex of top_sim_1 to the nearest vertex that survived into top_sim_2,
+//queueing every vertex once in the graph's own search workspace
 void restoration::setFeederVertices_2(void)
 {
-	int idx, curNode, nodeSetIdx;
+	int idx, curNode, nodeSetIdx, nodeSetSize, index;
 	CHAINNODE *tNode;
-	INTVECT nodeSet;
+	TOPOLOGY_SEARCH *nodeSet;
 
-	//Empty it, to be safe
-	nodeSet.data = NULL;
-
-	//Allocate the temporary vector - assume won't be bigger than feederVertices_1? (failed horribly on feederVertices)
-	INTVECTalloc(&nodeSet,feederVertices_1.maxSize);
+	//Queue and flags are sized to the graph
+	nodeSet = &top_sim_1->search;
+	topology_search_alloc(nodeSet,top_sim_1->numVertices);
 
 	//Allocate the feederVertices_2 vector
 	INTVECTalloc(&feederVertices_2,feederVertices_1.maxSize);
@@ -1953,13 +1953,23 @@ void restoration::setFeederVertices_2(void)
 	for (idx=0; idx<feederVertices.currSize; idx++)
 	{
 		//Start from zero, again
+		for (index=0; index<top_sim_1->numVertices; index++)
+		{
+			nodeSet->queued[index] = 0;
+		}
+
 		nodeSetIdx = 0;
-		nodeSet.data[nodeSetIdx] = feederVertices_1.data[idx];
-		nodeSet.currSize = 1;
+		nodeSetSize = 0;
 
-		while ((nodeSet.data[nodeSetIdx] != -1) && (nodeSetIdx < nodeSet.currSize))
+		if (feederVertices_1.data[idx] != -1)
 		{
-			curNode = nodeSet.data[nodeSetIdx];
+			nodeSet->queue[nodeSetSize++] = feederVertices_1.data[idx];
+			nodeSet->queued[feederVertices_1.data[idx]] = 1;
+		}
+
+		while (nodeSetIdx < nodeSetSize)
+		{
+			curNode = nodeSet->queue[nodeSetIdx];
 			nodeSetIdx++;
 			
 			if (ver_map_2.data[curNode] != -1)
@@ -1980,19 +1990,16 @@ void restoration::setFeederVertices_2(void)
 
 				while (tNode != NULL)
 				{
-					if (tNode->data != s_ver_1)
+					if ((tNode->data != s_ver_1) && (nodeSet->queued[tNode->data] == 0))
 					{
-						nodeSet.data[nodeSet.currSize] = tNode->data;
-						nodeSet.currSize++;
+						nodeSet->queue[nodeSetSize++] = tNode->data;
+						nodeSet->queued[tNode->data] = 1;
 					}
 					tNode = tNode->link;
 				}
 			}
 		}
 	}
-
-	//De-allocate the working variable
-	gl_free(nodeSet.data);
 }
 
 //Set microgrid vertices
@@ -4383,6 +4390,17 @@ LinkedBase::LinkedBase(int nVer)
 	dfs_time = 0;
 	numEdges = 0;
 
+	//Search index - built by BFS
+	csr.bus_count = 0;
+	csr.branch_count = 0;
+	csr.adj_start = NULL;
+	csr.adj_branch = NULL;
+	csr.adj_bus = NULL;
+	search.size = 0;
+	search.queue = NULL;
+	search.stack_pos = NULL;
+	search.queued = NULL;
+
 	if (nVer == 0)
 	{
 		numVertices = 0;
@@ -4490,6 +4508,10 @@ void LinkedBase::delAllVer(void)
 {
 	int indexvar;
 
+	//Search index goes with the graph
+	topology_csr_free(&csr);
+	topology_search_free(&search);
+
 	if (numVertices != 0)
 	{
 		//Loop through and remove chain items
@@ -4635,65 +4657,48 @@ int LinkedBase::nextVertex(int index)
 }
 
 // Breadth-first search
+// Flattens the adjacency chains into the compressed index fault_check searches the powerflow
+// topology with, and runs the shared breadth-first search over it
 void LinkedBase::BFS(int s)
 {
-	int index, u, v;
-	LinkedQueue *Q;
-
-    // Intialization
-    for (index=0; index<numVertices; index++)
-	{
-		status_value[index] = 0;
-		parent_value[index] = -1;
-		dist[index] = INFINITY;
-	}
-
-	source = s;
-	status_value[s] = 1;
-	dist[s] = 0.0;
-
-	// Use the queue to manager vertices whose status is '1'
-	//Create a temporary Q
-	Q = (LinkedQueue *)gl_malloc(sizeof(LinkedQueue));
+	int index, entry_count;
+	unsigned int entry;
+	CHAINNODE *adjNode;
 
-	//Make sure it worked
-	if (Q == NULL)
+	//Count the entries
+	entry_count = 0;
+	for (index=0; index<numVertices; index++)
 	{
-		GL_THROW("Restoration:Failed to allocate new LinkedQueue");
+		entry_count += adjList[index]->getLength();
 	}
 
-	//Call the constructor, just in case
-	new (Q) LinkedQueue();
-
-	Q->enQueue(s);
-    
-	// Initialize the iterator
-	initializePos();
+	topology_csr_alloc(&csr,numVertices,entry_count);
+	topology_search_alloc(&search,numVertices);
 
-	// Search process
-	while (Q->isempty() != true)
+	//Populate - in chain order, so vertices are discovered in the same order as walking the chains
+	entry = 0;
+	for (index=0; index<numVertices; index++)
 	{
-		u = Q->deQueue();
-        v = beginVertex(u);
+		csr.adj_start[index] = entry;
 
-		while (v != -1)
+		for (adjNode = adjList[index]->first; adjNode != NULL; adjNode = adjNode->link)
 		{
-            if (status_value[v] == 0) // v has not been discovered yet
-			{
-				status_value[v] = 1;
-				dist[v] = dist[u] + 1.0;
-				parent_value[v] = u;
-				Q->enQueue(v);
-			}
-
-			v = nextVertex(u);
+			csr.adj_branch[entry] = -1;	//No branches behind these graphs
+			csr.adj_bus[entry] = adjNode->data;
+			entry++;
 		}
+	}
+	csr.adj_start[numVertices] = entry;
+
+	// Search process
+	source = s;
+	topology_csr_bfs(&csr,&search,s,parent_value,dist);
 
-		status_value[u] = 2;
+	//Everything reached is finished, the rest never discovered
+	for (index=0; index<numVertices; index++)
+	{
+		status_value[index] = (search.queued[index] != 0) ? 2 : 0;
 	}
-	
-	// Deactive the iterator
-	deactivatePos();
 }
 
 // Depth-first search I: create a depth-first forest
@@ -6,6 +6,7 @@
 
 #include "powerflow.h"
 #include "powerflow_library.h"
+#include "topology_csr.h"
 
 typedef struct s_ChainNode {
 	int data;
@@ -114,6 +115,8 @@ public: // member properties
 	TIMESTAMP dfs_time;			//Previous timestamp - mainly for intialization
 	TIMESTAMP *dTime;			//timestamp array I for DFS, records when each vertex is discovered
 	TIMESTAMP *fTime;			//timestamp array II for DFS, records when the search finishes exaining the adjacency list for each vertex
+	TOPOLOGY_CSR csr;			//compressed adjacency the BFS walks - rebuilt from adjList by each BFS, since the graphs are edited in between
+	TOPOLOGY_SEARCH search;		//BFS queue and flags
 public: // member functions
 	LinkedBase(int nVer);				//Initializer
 	void delAllVer(void);				//delete all elements in the adjacency list
@@ -0,0 +1,535 @@
+// $Id: scenario_batch.cpp
+/**	Copyright (C) 2008 Battelle Memorial Institute
+
+	@file scenario_batch.cpp
+
+	Solves a set of load/DER injection scenarios against the network as it
+	stands at runtime, sharing one admittance structure and factorization
+	(see solver_nr_batch), and writes the voltages of every scenario side by
+	side into one file.
+
+	The scenarios are solved by the powerflow module's clock_update, once the
+	runtime timestep is over.  The swing bus keeps the loads of each of its
+	converged solves while a batch waits (solver_nr_batch_capture), since the
+	child objects take their contributions back off their parents in
+	postsync - the last pass of the timestep is the one that ends up in the
+	file.  If no solve converged, the batch waits for the next timestep.
+
+	The scenario file has one injection per line:
+
+		scenario_name,node_name,power_A,power_B,power_C
+
+	where the powers are complex constant power loads (VA) added to the node
+	for that scenario - negative values inject.  Missing powers are zero, a
+	scenario with no non-zero injections is the base case, and lines starting
+	with # are comments.
+
+	@{
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+
+#include "scenario_batch.h"
+#include "node.h"
+
+//////////////////////////////////////////////////////////////////////////
+// scenario_batch CLASS FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+CLASS* scenario_batch::oclass = NULL;
+scenario_batch *scenario_batch::first_pending = NULL;
+
+scenario_batch::scenario_batch(MODULE *mod)
+{
+	if (oclass==NULL)
+	{
+		// register the class definition
+		oclass = gl_register_class(mod,"scenario_batch",sizeof(scenario_batch),PC_PRETOPDOWN|PC_BOTTOMUP|PC_AUTOLOCK);
+		if (oclass==NULL)
+			throw "unable to register class scenario_batch";
+		else
+			oclass->trl = TRL_PROTOTYPE;
+
+		// publish the class properties
+		if (gl_publish_variable(oclass,
+			PT_timestamp,"runtime",PADDR(runtime),PT_DESCRIPTION,"the time to solve the scenarios",
+			PT_char256,"scenarios",PADDR(scenarios),PT_DESCRIPTION,"the file listing the injections of each scenario",
+			PT_char256,"file",PADDR(filename),PT_DESCRIPTION,"the file to write the scenario voltages into",
+			PT_int32,"runcount",PADDR(runcount),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"the number of times the scenarios have been solved",
+			PT_int64,"scenario_count",PADDR(scenario_count),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"the number of scenarios read from the scenario file",
+			PT_int64,"converged_count",PADDR(converged_count),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"the number of scenarios that converged on the last run",
+			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
+	}
+}
+
+int scenario_batch::create(void)
+{
+	runtime = TS_NEVER;
+	scenarios.erase();
+	filename.erase();
+	runcount = 0;
+	scenario_count = 0;
+	converged_count = 0;
+
+	scenario_name = NULL;
+	entry_count = 0;
+	entry_scenario = NULL;
+	entry_obj = NULL;
+	entry_power = NULL;
+	next_pending = NULL;
+
+	return 1;
+}
+
+int scenario_batch::init(OBJECT *parent)
+{
+	OBJECT *obj = OBJECTHDR(this);
+
+	if (solver_method != SM_NR)
+	{
+		GL_THROW("scenario_batch:%d - %s - scenario batches are only supported by the NR solver",obj->id,(obj->name ? obj->name : "Unnamed"));
+		/*  TROUBLESHOOT
+		The scenario_batch object solves its scenarios with the Newton-Raphson solver's batch interface.
+		Set the powerflow module's solver_method to NR to use it.
+		*/
+	}
+
+	if (scenarios[0] == '\0')
+	{
+		GL_THROW("scenario_batch:%d - %s - no scenario file was specified",obj->id,(obj->name ? obj->name : "Unnamed"));
+		/*  TROUBLESHOOT
+		The scenarios property of the scenario_batch object must name the file listing the injections
+		of each scenario.  Please specify one and try again.
+		*/
+	}
+
+	if (filename[0] == '\0')
+	{
+		GL_THROW("scenario_batch:%d - %s - no output file was specified",obj->id,(obj->name ? obj->name : "Unnamed"));
+		/*  TROUBLESHOOT
+		The file property of the scenario_batch object must name the file the scenario voltages are
+		written into.  Please specify one and try again.
+		*/
+	}
+
+	read_scenarios();
+
+	return 1;
+}
+
+int scenario_batch::isa(char *classname)
+{
+	return strcmp(classname,"scenario_batch")==0;
+}
+
+//Reads a complex power field - real alone, or real and imaginary with a trailing i or j.  Blank fields are zero.
+static bool scenario_batch_power(char *field, complex *value)
+{
+	double real_val, imag_val;
+	char *endptr, *imag_end;
+
+	while ((*field == ' ') || (*field == '\t'))
+		field++;
+
+	real_val = imag_val = 0.0;
+
+	if ((*field != '\0') && (*field != '\r') && (*field != '\n'))
+	{
+		real_val = strtod(field,&endptr);
+
+		if (endptr == field)
+			return false;
+
+		if ((*endptr == '+') || (*endptr == '-'))
+		{
+			imag_val = strtod(endptr,&imag_end);
+
+			if ((imag_end == endptr) || ((*imag_end != 'i') && (*imag_end != 'j')))
+				return false;
+		}
+	}
+
+	*value = complex(real_val,imag_val);
+	return true;
+}
+
+void scenario_batch::read_scenarios(void)
+{
+	OBJECT *obj = OBJECTHDR(this);
+	FILE *infile;
+	char line[1024];
+	char *field[5], *name, *end;
+	unsigned int line_count, line_num, sindex;
+	int findex, jindex;
+
+	infile = fopen(scenarios,"r");
+
+	if (infile == NULL)
+	{
+		GL_THROW("scenario_batch:%d - %s - unable to open scenario file %s",obj->id,(obj->name ? obj->name : "Unnamed"),scenarios.get_string());
+		/*  TROUBLESHOOT
+		The scenario file named by the scenarios property could not be opened.  Check the file exists
+		and can be read, then try again.
+		*/
+	}
+
+	//Every line could be an entry (and a scenario) - size for that
+	line_count = 0;
+	while (fgets(line,sizeof(line),infile) != NULL)
+		line_count++;
+
+	rewind(infile);
+
+	scenario_name = (char (*)[64])gl_malloc((line_count+1)*sizeof(*scenario_name));
+	entry_scenario = (unsigned int *)gl_malloc((line_count+1)*sizeof(unsigned int));
+	entry_obj = (OBJECT **)gl_malloc((line_count+1)*sizeof(OBJECT *));
+	entry_power = (complex *)gl_malloc(3*(line_count+1)*sizeof(complex));
+
+	if ((scenario_name == NULL) || (entry_scenario == NULL) || (entry_obj == NULL) || (entry_power == NULL))
+	{
+		GL_THROW("scenario_batch:%d - %s - unable to allocate memory",obj->id,(obj->name ? obj->name : "Unnamed"));
+		/*  TROUBLESHOOT
+		While reading the scenario file, memory for the scenario entries could not be allocated.  Please
+		try again.  If the error persists, please submit your code and a bug report via the ticketing system.
+		*/
+	}
+
+	scenario_count = 0;
+	entry_count = 0;
+	line_num = 0;
+
+	while (fgets(line,sizeof(line),infile) != NULL)
+	{
+		line_num++;
+
+		//Split the fields in place - empty ones stay empty
+		findex = 0;
+		field[findex++] = line;
+		for (end=line; (*end != '\0') && (*end != '\r') && (*end != '\n'); end++)
+		{
+			if ((*end == ',') && (findex < 5))
+			{
+				*end = '\0';
+				field[findex++] = end+1;
+			}
+		}
+		*end = '\0';
+
+		while ((*field[0] == ' ') || (*field[0] == '\t'))
+			field[0]++;
+
+		//Comments and blank lines
+		if ((*field[0] == '#') || ((findex == 1) && (*field[0] == '\0')))
+			continue;
+
+		if (findex < 2)
+		{
+			GL_THROW("scenario_batch:%d - %s - line %d of %s has no node",obj->id,(obj->name ? obj->name : "Unnamed"),line_num,scenarios.get_string());
+			/*  TROUBLESHOOT
+			Each line of the scenario file must have at least a scenario name and a node name, followed
+			by up to three constant power injections.  Please correct the line and try again.
+			*/
+		}
+
+		//Find the scenario, or start a new one
+		for (sindex=0; sindex<(unsigned int)scenario_count; sindex++)
+		{
+			if (strcmp(scenario_name[sindex],field[0]) == 0)
+				break;
+		}
+
+		if (sindex == (unsigned int)scenario_count)
+		{
+			strncpy(scenario_name[sindex],field[0],sizeof(scenario_name[sindex])-1);
+			scenario_name[sindex][sizeof(scenario_name[sindex])-1] = '\0';
+			scenario_count++;
+		}
+
+		name = field[1];
+		while ((*name == ' ') || (*name == '\t'))
+			name++;
+
+		end = name + strlen(name);
+		while ((end > name) && ((*(end-1) == ' ') || (*(end-1) == '\t')))
+			*(--end) = '\0';
+
+		entry_obj[entry_count] = gl_get_object(name);
+
+		if ((entry_obj[entry_count] == NULL) || (gl_object_isa(entry_obj[entry_count],"node","powerflow") == 0))
+		{
+			GL_THROW("scenario_batch:%d - %s - %s on line %d of %s is not a powerflow node",obj->id,(obj->name ? obj->name : "Unnamed"),name,line_num,scenarios.get_string());
+			/*  TROUBLESHOOT
+			Scenario injections can only be added to powerflow nodes (node, load, meter, triplex_node and
+			similar objects).  Check the node name on that line of the scenario file and try again.
+			*/
+		}
+
+		for (jindex=0; jindex<3; jindex++)
+		{
+			entry_power[3*entry_count+jindex] = 0.0;
+
+			if (((jindex+2) < findex) && (scenario_batch_power(field[jindex+2],&entry_power[3*entry_count+jindex]) == false))
+			{
+				GL_THROW("scenario_batch:%d - %s - unable to read power %s on line %d of %s",obj->id,(obj->name ? obj->name : "Unnamed"),field[jindex+2],line_num,scenarios.get_string());
+				/*  TROUBLESHOOT
+				The powers in the scenario file must be real numbers or complex numbers written like
+				1000+250j.  Please correct the line and try again.
+				*/
+			}
+		}
+
+		entry_scenario[entry_count] = sindex;
+		entry_count++;
+	}
+
+	fclose(infile);
+
+	if (scenario_count == 0)
+	{
+		gl_warning("scenario_batch:%d - %s - no scenarios were found in %s",obj->id,(obj->name ? obj->name : "Unnamed"),scenarios.get_string());
+		/*  TROUBLESHOOT
+		The scenario file didn't have any injection lines, so there is nothing to solve.  The output
+		file will only hold its header.
+		*/
+	}
+}
+
+void scenario_batch::run(TIMESTAMP t)
+{
+	OBJECT *obj = OBJECTHDR(this);
+	char namestr[64];
+	char timestr[64];
+	static const char *phase_name[3] = {"A","B","C"};
+	static const char *split_name[3] = {"1","2","N"};
+	NR_BATCH batch;
+	FILE *outfile;
+	node *pnode;
+	complex *V;
+	unsigned int indexer, sindex, eindex;
+	int jindex, result;
+
+	batch.scenario_count = scenario_count;
+	batch.entry_count = entry_count;
+	batch.entry_scenario = entry_scenario;
+	batch.entry_power = entry_power;
+
+	batch.entry_bus = (int *)gl_malloc((entry_count+1)*sizeof(int));
+	batch.V_out = (complex *)gl_malloc((3*NR_bus_count*scenario_count+1)*sizeof(complex));
+	batch.iterations = (int64 *)gl_malloc((scenario_count+1)*sizeof(int64));
+	batch.converged = (bool *)gl_malloc((scenario_count+1)*sizeof(bool));
+
+	if ((batch.entry_bus == NULL) || (batch.V_out == NULL) || (batch.iterations == NULL) || (batch.converged == NULL))
+	{
+		GL_THROW("scenario_batch:%d - %s - unable to allocate memory",obj->id,(obj->name ? obj->name : "Unnamed"));
+		//Defined above
+	}
+
+	//Children are solved as part of their parent's bus
+	for (eindex=0; eindex<entry_count; eindex++)
+	{
+		pnode = OBJECTDATA(entry_obj[eindex],node);
+
+		if (pnode->NR_node_reference == -99)
+			batch.entry_bus[eindex] = *pnode->NR_subnode_reference;
+		else
+			batch.entry_bus[eindex] = pnode->NR_node_reference;
+
+		if ((batch.entry_bus[eindex] < 0) || (batch.entry_bus[eindex] >= (int)NR_bus_count))
+		{
+			GL_THROW("scenario_batch:%d - %s - %s is not part of the powerflow solution",obj->id,(obj->name ? obj->name : "Unnamed"),(entry_obj[eindex]->name ? entry_obj[eindex]->name : "Unnamed"));
+			/*  TROUBLESHOOT
+			A node named in the scenario file was never added to the Newton-Raphson solution, so no
+			injection can be placed on it.  Check the node is connected to the system and try again.
+			*/
+		}
+	}
+
+	result = solver_nr_batch(NR_bus_count,NR_busdata,NR_branch_count,NR_branchdata,&NR_powerflow,&batch);
+
+	if (result < 0)
+	{
+		gl_error("scenario_batch:%d - %s - the base case failed to converge, so no scenarios were solved",obj->id,(obj->name ? obj->name : "Unnamed"));
+		/*  TROUBLESHOOT
+		Before solving its scenarios, the scenario_batch object solves the network as it stands at runtime
+		and shares that solution's factorization between the scenarios.  That solve failed, so nothing was
+		written.  Check the system solves normally at that time.
+		*/
+		converged_count = 0;
+	}
+	else
+	{
+		converged_count = result;
+
+		outfile = fopen(filename, "w");
+		if (outfile == NULL)
+		{
+			gl_error("scenario_batch unable to open %s for output", filename.get_string());
+		}
+		else
+		{
+			gl_printtime(t, timestr, 64);
+			fprintf(outfile,"# %s run at %s on %d scenarios, %d converged\n", filename.get_string(), timestr, (int)scenario_count, (int)converged_count);
+
+			for (sindex=0; sindex<(unsigned int)scenario_count; sindex++)
+			{
+				if (batch.converged[sindex] == true)
+					fprintf(outfile,"# %s converged in %d iterations\n", scenario_name[sindex], (int)batch.iterations[sindex]);
+				else if (batch.iterations[sindex] > 0)
+					fprintf(outfile,"# %s did not converge in %d iterations\n", scenario_name[sindex], (int)batch.iterations[sindex]);
+				else
+					fprintf(outfile,"# %s could not be solved\n", scenario_name[sindex]);
+			}
+
+			//One column pair per scenario
+			fprintf(outfile,"node_name,phase");
+			for (sindex=0; sindex<(unsigned int)scenario_count; sindex++)
+				fprintf(outfile,",%s_real,%s_imag", scenario_name[sindex], scenario_name[sindex]);
+			fprintf(outfile,"\n");
+
+			for (indexer=0; indexer<NR_bus_count; indexer++)
+			{
+				if (NR_busdata[indexer].name == NULL)
+					sprintf(namestr, "%s:%i", NR_busdata[indexer].obj->oclass->name, NR_busdata[indexer].obj->id);
+
+				for (jindex=0; jindex<3; jindex++)
+				{
+					//Only the phases the bus has - triplex buses are 1 and 2
+					if ((NR_busdata[indexer].phases & 0x80) == 0x80)
+					{
+						if (jindex == 2)
+							continue;
+					}
+					else if ((NR_busdata[indexer].phases & (0x04 >> jindex)) == 0)
+						continue;
+
+					fprintf(outfile,"%s,%s", (NR_busdata[indexer].name ? NR_busdata[indexer].name : namestr), ((NR_busdata[indexer].phases & 0x80) == 0x80) ? split_name[jindex] : phase_name[jindex]);
+
+					for (sindex=0; sindex<(unsigned int)scenario_count; sindex++)
+					{
+						V = &batch.V_out[3*(NR_bus_count*sindex+indexer)];
+						fprintf(outfile,",%f,%f", V[jindex].Re(), V[jindex].Im());
+					}
+
+					fprintf(outfile,"\n");
+				}
+			}
+
+			fclose(outfile);
+		}
+	}
+
+	gl_free(batch.entry_bus);
+	gl_free(batch.V_out);
+	gl_free(batch.iterations);
+	gl_free(batch.converged);
+}
+
+//Queues the batch at runtime, so the swing bus keeps the loads of its solves for it
+TIMESTAMP scenario_batch::presync(TIMESTAMP t0){
+	if(runtime == 0){
+		runtime = t0;
+	}
+	if((t0 >= runtime || runtime == TS_NEVER) && (runcount < 1)){
+		LOCK_OBJECT(NR_swing_bus);	//Lock SWING since its queue is being modified
+
+		if ((next_pending == NULL) && (first_pending != this))
+		{
+			next_pending = first_pending;
+			first_pending = this;
+		}
+
+		NR_batch_pending = true;
+
+		UNLOCK_OBJECT(NR_swing_bus);
+	}
+	return TS_NEVER;
+}
+
+//Solves every queued batch against the loads of the timestep's last converged solve - called by the module's clock_update
+void scenario_batch::run_pending(TIMESTAMP t){
+	scenario_batch *batch;
+
+	//Nothing converged yet - the batches wait for the next timestep's solves
+	if (solver_nr_batch_captured(NR_bus_count) == false)
+		return;
+
+	while (first_pending != NULL)
+	{
+		batch = first_pending;
+		first_pending = batch->next_pending;
+		batch->next_pending = NULL;
+
+		batch->run(t);
+		++batch->runcount;
+	}
+
+	NR_batch_pending = false;
+	solver_nr_batch_clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION OF CORE LINKAGE: scenario_batch
+//////////////////////////////////////////////////////////////////////////
+
+/**
+* REQUIRED: allocate and initialize an object.
+*
+* @param obj a pointer to a pointer of the last object in the list
+* @param parent a pointer to the parent of this object
+* @return 1 for a successfully created object, 0 for error
+*/
+EXPORT int create_scenario_batch(OBJECT **obj, OBJECT *parent)
+{
+	try
+	{
+		*obj = gl_create_object(scenario_batch::oclass);
+		if (*obj!=NULL)
+		{
+			scenario_batch *my = OBJECTDATA(*obj,scenario_batch);
+			gl_set_parent(*obj,parent);
+			return my->create();
+		}
+		else
+			return 0;
+	}
+	CREATE_CATCHALL(scenario_batch);
+}
+
+EXPORT int init_scenario_batch(OBJECT *obj)
+{
+	try {
+		scenario_batch *my = OBJECTDATA(obj,scenario_batch);
+		return my->init(obj->parent);
+	}
+	INIT_CATCHALL(scenario_batch);
+}
+
+EXPORT TIMESTAMP sync_scenario_batch(OBJECT *obj, TIMESTAMP t1, PASSCONFIG pass)
+{
+	try
+	{
+		scenario_batch *my = OBJECTDATA(obj,scenario_batch);
+		TIMESTAMP rv;
+		switch (pass) {
+		case PC_PRETOPDOWN:
+			return my->presync(t1);
+		case PC_BOTTOMUP:
+			obj->clock = t1;
+			rv = my->runtime > t1 ? my->runtime : TS_NEVER;
+			return rv;
+		default:
+			throw "invalid pass request";
+		}
+	}
+	SYNC_CATCHALL(scenario_batch);
+}
+
+EXPORT int isa_scenario_batch(OBJECT *obj, char *classname)
+{
+	return OBJECTDATA(obj,scenario_batch)->isa(classname);
+}
+
+/**@}*/
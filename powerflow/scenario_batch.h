@@ -0,0 +1,41 @@
+// $Id: scenario_batch.h
+//	Copyright (C) 2008 Battelle Memorial Institute
+
+#ifndef _SCENARIO_BATCH_H
+#define _SCENARIO_BATCH_H
+
+#include "powerflow.h"
+#include "node.h"
+
+class scenario_batch : public gld_object
+{
+public:
+	TIMESTAMP runtime;
+	char256 scenarios;			///< file listing the injections of each scenario
+	char256 filename;			///< file the scenario voltages are written to
+	int32 runcount;
+	int64 scenario_count;		///< number of scenarios read from the scenario file
+	int64 converged_count;		///< number of scenarios that converged on the last run
+private:
+	char (*scenario_name)[64];	///< name of each scenario, in order of first appearance
+	unsigned int entry_count;	///< number of injection entries read
+	unsigned int *entry_scenario;	///< scenario of each entry
+	OBJECT **entry_obj;			///< node of each entry
+	complex *entry_power;		///< constant power each entry adds - 3 per entry
+	scenario_batch *next_pending;	///< next batch waiting to be solved
+	static scenario_batch *first_pending;	///< batches waiting to be solved at the end of the timestep
+public:
+	static CLASS *oclass;
+public:
+	scenario_batch(MODULE *mod);
+	int create(void);
+	int init(OBJECT *parent);
+	TIMESTAMP presync(TIMESTAMP t0);
+	int isa(char *classname);
+
+	void read_scenarios(void);
+	void run(TIMESTAMP t);
+	static void run_pending(TIMESTAMP t);
+};
+
+#endif // _SCENARIO_BATCH_H
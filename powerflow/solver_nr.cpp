@@ -35,6 +35,8 @@ Initialization after returning to service?
 
 #include "solver_nr.h"
 
+#include <pthread.h>
+
 #define MT // this enables multithreaded SuperLU
 
 #ifdef MT
@@ -53,6 +55,36 @@ NR_SOLVER_VARS matrices_LU;
 int *perm_c, *perm_r;
 SuperMatrix A_LU,B_LU;
 
+//Matrix rows a low-rank correction of the kept factors may cover before they are just released
+#define NR_LOWRANK_LIMIT 48
+
+//Last converged factorization - kept so a predicted or fast-path solve can take its first step without refactoring
+typedef struct {
+	bool valid;						//Factors below are usable
+	NR_SOLVER_STRUCT *owner;		//Solver structure the factors were made for
+	unsigned int size;				//Size of the factored system
+	unsigned int max_size;			//Allocated size of the permutation copies
+	SuperMatrix L, U;				//Factors
+	int *perm_c, *perm_r;			//Permutations the factors were made with
+	unsigned int lowrank_size;		//Rows covered by the admittance correction - 0 if the factors are used as made
+	int lowrank_row[NR_LOWRANK_LIMIT];	//Matrix row of each correction row
+	Y_NR *lowrank_delta;			//Admittance changes since the factors were made - row_ind is the correction row
+	unsigned int lowrank_count;		//Number of changes
+	unsigned int max_lowrank_count;	//Allocated space for changes
+	double *lowrank_W;				//Factor solves against each correction row's unit vector - size values per row
+	unsigned int max_lowrank_W;		//Allocated space for lowrank_W
+	double lowrank_C[NR_LOWRANK_LIMIT*NR_LOWRANK_LIMIT];	//I + D*W, LU factored in place
+	int lowrank_piv[NR_LOWRANK_LIMIT];	//Row pivots of lowrank_C
+} NR_KEPT_FACTOR;
+NR_KEPT_FACTOR NR_kept;
+bool NR_kept_first_step = false;	//Take the first iteration of the next solve with the kept factors
+bool NR_kept_chord = false;			//Keep iterating with the kept factors, up to NR_CHORD_LIMIT iterations (fast-path linear updates)
+bool NR_kept_force = false;			//Keep the next converged factors whatever the predictor and fast path settings (batch base case)
+bool NR_kept_hold = false;			//Don't replace the kept factors (batch scenarios all share the base case's)
+
+//Iterations a fast-path solve takes with the kept factors before it refactors
+#define NR_CHORD_LIMIT 5
+
 //External solver global
 void *ext_solver_glob_vars;
 
@@ -194,7 +226,8 @@ inline void sparse_add(SPARSE* sm, int row, int col, double value)
 		sm->cols[col] = new_list_element;
 }
 
-void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU)
+//Convert to compressed-column form, optionally recording where each triplet (llheap entry) landed
+void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU, SP_SCATTER *scatter)
 {
 	//traverse each linked list, which are in order, and copy values into new array
 	unsigned int rowidx = 0;
@@ -215,5819 +248,8518 @@ void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU)
 		{
 			matrices_LU->rows_LU[rowidx] = LL_pointer->row_ind; // row pointers of non zero values
 			matrices_LU->a_LU[rowidx] = LL_pointer->value;
+			if (scatter != NULL)
+			{
+				scatter[LL_pointer - sm->llheap].row_ind = LL_pointer->row_ind;
+				scatter[LL_pointer - sm->llheap].col_ind = i;
+				scatter[LL_pointer - sm->llheap].csc_ind = rowidx;
+			}
 			++rowidx;
 			LL_pointer = LL_pointer->next;
 		}		
 	}
 }
 
-/** Newton-Raphson solver
-	Solves a power flow problem using the Newton-Raphson method
-	
-	@return n=0 on failure to complete a single iteration, 
-	n>0 to indicate success after n interations, or 
-	n<0 to indicate failure after n iterations
- **/
-int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations)
+//Write a block of triplets directly into the compressed-column values - returns false as soon as a
+//triplet no longer matches the recorded pattern, in which case the matrix must be rebuilt through sparse_add
+bool sparse_scatter(SP_SCATTER *scatter, Y_NR *elements, unsigned int count, double *values)
 {
-	//Internal iteration counter - just NR limits
-	int64 Iteration;
+	unsigned int i;
 
-	//File pointer for debug outputs
-	FILE *FPoutVal;
+	for (i=0; i<count; i++)
+	{
+		if ((scatter[i].row_ind != elements[i].row_ind) || (scatter[i].col_ind != elements[i].col_ind))
+			return false;
 
-	//A matrix size variable
-	unsigned int size_Amatrix;
+		values[scatter[i].csc_ind] = elements[i].Y_value;
+	}
 
-	//Voltage mismatch tracking variable
-	double Maxmismatch;
+	return true;
+}
 
-	//Saturation mismatch tracking variable
-	bool SaturationMismatchPresent;
-	int func_result_val;
+//Per-iteration values shared by the per-bus assembly loops
+typedef struct {
+	BUSDATA *bus;
+	BRANCHDATA *branch;
+	NR_SOLVER_STRUCT *powerflow_values;
+	NRSOLVERMODE powerflow_type;
+	int64 Iteration;
+	bool swing_is_a_swing;
+	complex aval, avalsq;
+	NR_PACKED_STORAGE *packed;	//Packed arrays the ranges read, NULL when the solve is not packed
+} NR_ASSEMBLY_DATA;
+
+//Contiguous range of buses assembled by one thread - each bus owns its own deltaI_NR rows,
+//Jacobian terms and Y_diag_update entries, so the ranges never write to the same place
+typedef struct {
+	NR_ASSEMBLY_DATA *data;
+	unsigned int bus_start;			///< First bus of the range
+	unsigned int bus_end;			///< One past the last bus of the range
+	unsigned int diag_update_start;	///< Y_diag_update index of the first entry of bus_start
+	bool swing_converged;			///< PF_DYNINIT balancing convergence of this range
+	char errmsg[1024];				///< Failure message of this range
+} NR_ASSEMBLY_CHUNK;
+
+//GL_THROW longjmps back to the core, which can't be done from a helper thread - so the range
+//functions record the message and stop, and solver_nr_assembly_run throws it afterwards
+#define NR_ASSEMBLY_THROW(chunk,...) { snprintf((chunk)->errmsg,sizeof((chunk)->errmsg),__VA_ARGS__); return; }
+
+//Assembly ranges and helper threads
+NR_ASSEMBLY_CHUNK *NR_assembly_chunks = NULL;
+unsigned int NR_assembly_chunk_count = 0;		//Ranges used by the current solve
+unsigned int NR_assembly_chunk_max = 0;			//Ranges allocated
+unsigned int NR_assembly_helpers = 0;			//Helper threads started
+pthread_t *NR_assembly_threads = NULL;			//Helper threads, joined by solver_nr_assembly_stop
+unsigned int NR_assembly_thread_max = 0;		//Helper thread handles allocated
+bool NR_assembly_quit = false;					//Tells the helpers to exit when they are next released
+void (*NR_assembly_func)(NR_ASSEMBLY_CHUNK *) = NULL;
+unsigned int NR_assembly_generation = 0;		//Incremented to release the helpers
+unsigned int NR_assembly_pending = 0;			//Helpers still working on the current loop
+pthread_mutex_t NR_assembly_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t NR_assembly_start = PTHREAD_COND_INITIALIZER;
+pthread_cond_t NR_assembly_done = PTHREAD_COND_INITIALIZER;
+
+//Helper thread - runs its range of every assembly loop it is released for
+static void *solver_nr_assembly_helper(void *arg)
+{
+	unsigned int chunk_index = (unsigned int)(size_t)arg;
+	unsigned int generation = 0;
+	void (*func)(NR_ASSEMBLY_CHUNK *);
 
-	//Phase collapser variable
-	unsigned char phase_worka, phase_workb, phase_workc, phase_workd, phase_worke;
+	while (true)
+	{
+		//Wait to be released
+		pthread_mutex_lock(&NR_assembly_lock);
+		while (NR_assembly_generation == generation)
+			pthread_cond_wait(&NR_assembly_start,&NR_assembly_lock);
+		generation = NR_assembly_generation;
+		func = NR_assembly_func;
+		pthread_mutex_unlock(&NR_assembly_lock);
+
+		//Released to exit
+		if (NR_assembly_quit == true)
+			break;
 
-	//Temporary calculation variables
-	double tempIcalcReal, tempIcalcImag;
-	double tempPbus; //tempPbus store the temporary value of active power load at each bus
-	double tempQbus; //tempQbus store the temporary value of reactive power load at each bus
+		//Solves with fewer buses than threads leave some helpers idle
+		if (chunk_index < NR_assembly_chunk_count)
+			(*func)(&NR_assembly_chunks[chunk_index]);
 
-	//Miscellaneous index variable
-	unsigned int indexer, tempa, tempb, jindexer, kindexer;
-	char jindex, kindex;
-	char temp_index, temp_index_b;
-	unsigned int temp_index_c;
+		//Report back
+		pthread_mutex_lock(&NR_assembly_lock);
+		NR_assembly_pending--;
+		if (NR_assembly_pending == 0)
+			pthread_cond_signal(&NR_assembly_done);
+		pthread_mutex_unlock(&NR_assembly_lock);
+	}
 
-	//Working matrix for admittance collapsing/determinations
-	complex tempY[3][3];
+	return NULL;
+}
 
-	//Working matrix for mesh fault impedance storage, prior to "reconstruction"
-	double temp_z_store[6][6];
+//Splits the buses into NR_assembly_procs ranges, starting helper threads as needed
+static void solver_nr_assembly_setup(unsigned int bus_count, NR_ASSEMBLY_DATA *data)
+{
+	unsigned int count, index;
+	pthread_t *threads;
 
-	//Miscellaneous flag variables
-	bool Full_Mat_A, Full_Mat_B, proceed_flag;
+	count = (NR_assembly_procs > 1) ? (unsigned int)NR_assembly_procs : 1;
 
-	//Iteration flag
-	bool newiter;
+	if (count > bus_count)
+		count = (bus_count > 0) ? bus_count : 1;
 
-	//Deltamode pass flag - changes how SWING buses are handled
-	//Multiple SWING-bus attached generators may cause issues, but no good way to detect
-	bool swing_is_a_swing;
+	if (count > NR_assembly_chunk_max)
+	{
+		if (NR_assembly_chunks != NULL)
+			gl_free(NR_assembly_chunks);
 
-	//Deltamode initial dynamics run - swing convergence flag (symmetry)
-	bool swing_converged;
+		NR_assembly_chunks = (NR_ASSEMBLY_CHUNK *)gl_malloc(count*sizeof(NR_ASSEMBLY_CHUNK));
 
-	//Deltamode intermediate variables
-	complex temp_complex_0, temp_complex_1, temp_complex_2, temp_complex_3, temp_complex_4, temp_complex_5;
-	complex aval, avalsq;
+		if (NR_assembly_chunks == NULL)
+		{
+			NR_assembly_chunk_max = 0;
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-	//Temporary size variable
-	char temp_size, temp_size_b, temp_size_c;
+		NR_assembly_chunk_max = count;
+	}
 
-	//Temporary admittance variables
-	complex Temp_Ad_A[3][3];
-	complex Temp_Ad_B[3][3];
+	if (count > NR_assembly_thread_max+1)
+	{
+		threads = (pthread_t *)gl_malloc((count-1)*sizeof(pthread_t));
 
-	//Temporary load calculation variables
-	complex undeltacurr[3];
-	complex delta_current[3], voltageDel[3];
-	complex temp_current[3], temp_power[3], temp_store[3];
-	complex adjusted_constant_current[6];
-	complex adjust_temp_nominal_voltage[6];
-	double adjust_temp_voltage_mag[6];
-	double adjust_nominal_voltage_val, adjust_nominal_voltaged_val;
+		if (threads == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-	//DV checking array
-	complex DVConvCheck[3];
-	double CurrConvVal;
+		if (NR_assembly_threads != NULL)
+		{
+			memcpy(threads,NR_assembly_threads,NR_assembly_helpers*sizeof(pthread_t));
+			gl_free(NR_assembly_threads);
+		}
 
-	//Miscellaneous counter tracker
-	unsigned int index_count = 0;
+		NR_assembly_threads = threads;
+		NR_assembly_thread_max = count-1;
+	}
 
-	//Miscellaneous working variable
-	double work_vals_double_0, work_vals_double_1,work_vals_double_2,work_vals_double_3,work_vals_double_4;
-	char work_vals_char_0;
+	//Range 0 always runs on the calling thread
+	while (NR_assembly_helpers+1 < count)
+	{
+		if (pthread_create(&NR_assembly_threads[NR_assembly_helpers],NULL,solver_nr_assembly_helper,(void *)(size_t)(NR_assembly_helpers+1)) != 0)
+		{
+			GL_THROW("NR: unable to start powerflow assembly thread %d",NR_assembly_helpers+1);
+			/*  TROUBLESHOOT
+			The Newton-Raphson solver was unable to start one of the threads requested by NR_assembly_procs.
+			Reduce NR_assembly_procs, or set it to 1 to assemble the system on the main thread only.
+			*/
+		}
 
-	//SuperLU variables
-	SuperMatrix L_LU,U_LU;
-	NCformat *Astore;
-	DNformat *Bstore;
-	int nnz, info;
-	unsigned int m,n;
-	double *sol_LU;
+		NR_assembly_helpers++;
+	}
 
-	//Spare notation variable - for output
-	SP_E *temp_element;
-	int row, col;
-	double value;
-	
-#ifndef MT
-	superlu_options_t options;	//Additional variables for sequential superLU
-	SuperLUStat_t stat;
-#endif
+	for (index=0; index<count; index++)
+	{
+		NR_assembly_chunks[index].data = data;
+		NR_assembly_chunks[index].bus_start = (unsigned int)(((int64)index*bus_count)/count);
+		NR_assembly_chunks[index].bus_end = (unsigned int)(((int64)(index+1)*bus_count)/count);
+		NR_assembly_chunks[index].diag_update_start = 0;
+		NR_assembly_chunks[index].swing_converged = true;
+	}
 
-	//Ensure bad computations flag is set first
-	*bad_computations = false;
+	NR_assembly_chunk_count = count;
+}
 
-	//Determine special circumstances of SWING bus -- do we want it to truly participate right
-	if (powerflow_type != PF_NORMAL)
+//Releases the helper threads to exit, waits for them and frees the ranges - called at module termination
+void solver_nr_assembly_stop(void)
+{
+	unsigned int index;
+
+	if (NR_assembly_helpers > 0)
 	{
-		if (powerflow_type == PF_DYNCALC)	//Parse the list -- anything that is a swing and a generator, deflag it out of principle (and to make it work right)
-		{
-			//Set the master swing flag
-			swing_is_a_swing = false;
+		pthread_mutex_lock(&NR_assembly_lock);
+		NR_assembly_quit = true;
+		NR_assembly_generation++;
+		pthread_cond_broadcast(&NR_assembly_start);
+		pthread_mutex_unlock(&NR_assembly_lock);
 
-			//Check the buses
-			for (indexer=0; indexer<bus_count; indexer++)
-			{
-				//See if we're a swing-flagged bus
-				if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))
-				{
-					//See if we're "generator ready"
-					if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
-					{
-						//Deflag us back to "PQ" status
-						bus[indexer].swing_functions_enabled = false;
-					}
-				}
-				//Default else -- normal bus
-			}//End bus traversion loop
-		}//Handle running dynamics differently
-		else	//Must be PF_DYNINIT
-		{
-			//Flag us as true, initially
-			swing_is_a_swing = true;
-		}
-	}//End not normal
-	else	//Must be normal
+		for (index=0; index<NR_assembly_helpers; index++)
+			pthread_join(NR_assembly_threads[index],NULL);
+
+		NR_assembly_helpers = 0;
+		NR_assembly_quit = false;
+	}
+
+	if (NR_assembly_threads != NULL)
 	{
-		swing_is_a_swing = true;	//Flag as a swing, even though this shouldn't do anything
+		gl_free(NR_assembly_threads);
+		NR_assembly_threads = NULL;
 	}
+	NR_assembly_thread_max = 0;
 
-	//Populate aval, if necessary
-	if (powerflow_type == PF_DYNINIT)
+	if (NR_assembly_chunks != NULL)
 	{
-		//Conversion variables - 1@120-deg
-		aval = complex(-0.5,(sqrt(3.0)/2.0));
-		avalsq = aval*aval;	//squared value is used a couple places too
+		gl_free(NR_assembly_chunks);
+		NR_assembly_chunks = NULL;
 	}
-	else	//Zero it, just in case something uses it (what would???)
+	NR_assembly_chunk_max = 0;
+	NR_assembly_chunk_count = 0;
+}
+
+//Runs an assembly loop over every range and waits for all of them
+static void solver_nr_assembly_run(void (*func)(NR_ASSEMBLY_CHUNK *))
+{
+	unsigned int index;
+
+	for (index=0; index<NR_assembly_chunk_count; index++)
+		NR_assembly_chunks[index].errmsg[0] = '\0';
+
+	//Release the helpers
+	if (NR_assembly_chunk_count > 1)
 	{
-		aval = 0.0;
-		avalsq = 0.0;
+		pthread_mutex_lock(&NR_assembly_lock);
+		NR_assembly_func = func;
+		NR_assembly_pending = NR_assembly_helpers;
+		NR_assembly_generation++;
+		pthread_cond_broadcast(&NR_assembly_start);
+		pthread_mutex_unlock(&NR_assembly_lock);
 	}
 
-	if (matrix_solver_method==MM_EXTERN)
+	//Do our own range
+	(*func)(&NR_assembly_chunks[0]);
+
+	//Wait for the rest
+	if (NR_assembly_chunk_count > 1)
 	{
-		//Call the initialization routine
-		ext_solver_glob_vars = ((void *(*)(void *))(LUSolverFcns.ext_init))(ext_solver_glob_vars);
+		pthread_mutex_lock(&NR_assembly_lock);
+		while (NR_assembly_pending > 0)
+			pthread_cond_wait(&NR_assembly_done,&NR_assembly_lock);
+		pthread_mutex_unlock(&NR_assembly_lock);
+	}
 
-		//Make sure it worked (allocation check)
-		if (ext_solver_glob_vars==NULL)
+	//Now that everyone is done, pass on the first failure
+	for (index=0; index<NR_assembly_chunk_count; index++)
+	{
+		if (NR_assembly_chunks[index].errmsg[0] != '\0')
 		{
-			GL_THROW("External LU matrix solver failed to allocate memory properly!");
+			GL_THROW("%s",NR_assembly_chunks[index].errmsg);
 			/*  TROUBLESHOOT
-			While attempting to allocate memory for the external LU solver, an error occurred.
-			Please try again.  If the error persists, ensure your external LU solver is behaving correctly
-			and coordinate with their development team as necessary.
+			A bus range of the NR load, mismatch or Jacobian assembly failed.  The message above is the
+			one recorded at the failure point in that range - see its description.  The ranges are run on
+			powerflow::NR_assembly_procs threads, and failures are reported from the calling thread once
+			every range has finished.
 			*/
 		}
 	}
+}
 
-	if (NR_admit_change)	//If an admittance update was detected, fix it
-	{
-		//Build the diagnoal elements of the bus admittance matrix - this should only happen once no matter what
-		if (powerflow_values->BA_diag == NULL)
-		{
-			powerflow_values->BA_diag = (Bus_admit *)gl_malloc(bus_count *sizeof(Bus_admit));   //BA_diag store the location and value of diagonal elements of Bus Admittance matrix
+//System load at each bus is represented by second order polynomial equations - one bus range
+static void solver_nr_load_range(NR_ASSEMBLY_CHUNK *chunk)
+{
+	BUSDATA *bus = chunk->data->bus;
+	NR_SOLVER_STRUCT *powerflow_values = chunk->data->powerflow_values;
+	NR_PACKED_STORAGE *packed = chunk->data->packed;
+	complex *bus_V, *bus_S, *bus_Y, *bus_I, *bus_S_dy, *bus_Y_dy, *bus_I_dy;
+	unsigned int indexer;
+	char jindex;
+	char temp_index, temp_index_b;
 
-			//Make sure it worked
-			if (powerflow_values->BA_diag == NULL)
-			{
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
-				/*  TROUBLESHOOT
-				During the allocation stage of the NR algorithm, one of the matrices failed to be allocated.
-				Please try again and if this bug persists, submit your code and a bug report using the trac
-				website.
-				*/
-			}
-		}
-		
-		for (indexer=0; indexer<bus_count; indexer++) // Construct the diagonal elements of Bus admittance matrix.
+	//Temporary calculation variables
+	double tempPbus; //tempPbus store the temporary value of active power load at each bus
+	double tempQbus; //tempQbus store the temporary value of reactive power load at each bus
+
+	//Temporary load calculation variables
+	complex undeltacurr[3];
+	complex delta_current[3], voltageDel[3];
+	complex temp_current[3], temp_store[3];
+	complex adjusted_constant_current[6];
+	complex adjust_temp_nominal_voltage[6];
+	double adjust_temp_voltage_mag[6];
+	double adjust_nominal_voltage_val, adjust_nominal_voltaged_val;
+
+	for (indexer=chunk->bus_start; indexer<chunk->bus_end; indexer++)
+	{
+		//Read the packed copies directly when they are in use
+		bus_V = (packed != NULL) ? &packed->V[3*indexer] : bus[indexer].V;
+		bus_S = (packed != NULL) ? &packed->S[3*indexer] : bus[indexer].S;
+		bus_Y = (packed != NULL) ? &packed->Y[3*indexer] : bus[indexer].Y;
+		bus_I = (packed != NULL) ? &packed->I[3*indexer] : bus[indexer].I;
+		bus_S_dy = (packed != NULL) ? &packed->S_dy[6*indexer] : bus[indexer].S_dy;
+		bus_Y_dy = (packed != NULL) ? &packed->Y_dy[6*indexer] : bus[indexer].Y_dy;
+		bus_I_dy = (packed != NULL) ? &packed->I_dy[6*indexer] : bus[indexer].I_dy;
+
+		if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
 		{
-			//Determine the size we need
-			if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase
-				powerflow_values->BA_diag[indexer].size = 2;
-			else										//Other cases, figure out how big they are
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
 			{
-				phase_worka = 0;
-				for (jindex=0; jindex<3; jindex++)		//Accumulate number of phases
+				//Create nominal magnitudes
+				adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+
+				//Compute delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+
+				//Start adjustments - AB
+				if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
 				{
-					phase_worka += ((bus[indexer].phases & (0x01 << jindex)) >> jindex);
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
 				}
-				powerflow_values->BA_diag[indexer].size = phase_worka;
-			}
-
-			//Ensure the admittance matrix is zeroed
-			for (jindex=0; jindex<3; jindex++)
-			{
-				for (kindex=0; kindex<3; kindex++)
+				else
 				{
-					powerflow_values->BA_diag[indexer].Y[jindex][kindex] = 0;
-					tempY[jindex][kindex] = 0;
+					adjusted_constant_current[0] = 0.0;
 				}
-			}
 
-			//If we're in any deltamode, store out self-admittance as well, if it exists
-			if ((powerflow_type!=PF_NORMAL) && (bus[indexer].full_Y != NULL))
-			{
-				//Loop and add
-				for (jindex=0; jindex<3; jindex++)
+				//Start adjustments - BC
+				if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
 				{
-					for (kindex=0; kindex<3; kindex++)
-					{
-						tempY[jindex][kindex] = bus[indexer].full_Y[jindex*3+kindex];	//Adds in any self-admittance terms (generators)
-					}
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
 				}
-			}
-
-			//Now go through all of the branches to get the self admittance information (hinges on size)
-			for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size);kindexer++)
-			{ 
-				//Assign jindexer as intermediate variable (easier for me this way)
-				jindexer = bus[indexer].Link_Table[kindexer];
 
-				if ((branch[jindexer].from == indexer) || (branch[jindexer].to == indexer))	//Bus is the from or to side of things - not sure how it would be in link table otherwise, but meh
+				//Start adjustments - CA
+				if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
 				{
-					if ((bus[indexer].phases & 0x07) == 0x07)		//Full three phase
-					{
-						for (jindex=0; jindex<3; jindex++)	//Add in all three phase values
-						{
-							//See if this phase is valid
-							phase_workb = 0x04 >> jindex;
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
 
-							if ((phase_workb & branch[jindexer].phases) == phase_workb)
-							{
-								for (kindex=0; kindex<3; kindex++)
-								{
-									//Check phase
-									phase_workd = 0x04 >> kindex;
+				//See if we have any "different children"
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Create nominal magnitudes
+					adjust_nominal_voltage_val = bus[indexer].volt_base;
 
-									if ((phase_workd & branch[jindexer].phases) == phase_workd)
-									{
-										if (branch[jindexer].from == indexer)	//We're the from version
-										{
-											tempY[jindex][kindex] += branch[jindexer].YSfrom[jindex*3+kindex];
-										}
-										else									//Must be the to version
-										{
-											tempY[jindex][kindex] += branch[jindexer].YSto[jindex*3+kindex];
-										}
-									}//End valid column phase
-								}
-							}//End valid row phase
-						}
+					//Create the nominal voltage vectors
+					adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+					adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+
+					//Get magnitudes of all
+					adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+					adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+					adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+					//Start adjustments - A
+					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
 					}
-					else if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase - add in 2x2 element to upper left 2x2
+					else
 					{
-						if (branch[jindexer].from == indexer)	//From branch
+						adjusted_constant_current[3] = 0.0;
+					}
+
+					//Start adjustments - B
+					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[4] = 0.0;
+					}
+
+					//Start adjustments - C
+					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[5] = 0.0;
+					}
+				}
+				else	//Nope
+				{
+					//Set to zero, just cause
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}
+			else	//"Normal" modes -- handle traditionally
+			{
+				adjusted_constant_current[0] = bus_I[0];
+				adjusted_constant_current[1] = bus_I[1];
+				adjusted_constant_current[2] = bus_I[2];
+
+				//See if we have different children too
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Store them too
+					adjusted_constant_current[3] = bus[indexer].extra_var[6];
+					adjusted_constant_current[4] = bus[indexer].extra_var[7];
+					adjusted_constant_current[5] = bus[indexer].extra_var[8];
+				}
+				else	//Nope, just zero this for now
+				{
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}//End adjustment code
+
+			//Delta components - populate according to what is there
+			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+			{
+				//Voltage calculations
+				voltageDel[0] = bus_V[0] - bus_V[1];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S[0]/voltageDel[0]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[0] += voltageDel[0] * (bus_Y[0]);
+			}
+			else
+			{
+				//Zero values - they shouldn't be used anyhow
+				voltageDel[0] = 0.0;
+				delta_current[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+			{
+				//Voltage calculations
+				voltageDel[1] = bus_V[1] - bus_V[2];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S[1]/voltageDel[1]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[1] += voltageDel[1] * (bus_Y[1]);
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[1] = 0.0;
+				delta_current[1] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+			{
+				//Voltage calculations
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S[2]/voltageDel[2]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[2] += voltageDel[2] * (bus_Y[2]);
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[2] = 0.0;
+				delta_current[2] = 0.0;
+			}
+			
+			//Convert delta-current into a phase current, where appropriate - reuse temp variable
+			//Everything will be accumulated into the "current" field for ease (including differents)
+			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+			{
+				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+				{
+					//Power values
+					undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus_V[0]);
+
+					//Shunt values
+					undeltacurr[0] += bus[indexer].extra_var[3]*bus_V[0];
+
+					//Current values
+					undeltacurr[0] += adjusted_constant_current[3];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			{
+				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+				{
+					//Power values
+					undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus_V[1]);
+
+					//Shunt values
+					undeltacurr[1] += bus[indexer].extra_var[4]*bus_V[1];
+
+					//Current values
+					undeltacurr[1] += adjusted_constant_current[4];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[1] = 0.0;
+			}
+
+
+			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+			{
+				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
+					{
+					//Power values
+					undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus_V[2]);
+
+					//Shunt values
+					undeltacurr[2] += bus[indexer].extra_var[5]*bus_V[2];
+
+					//Current values
+					undeltacurr[2] += adjusted_constant_current[5];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[2] = 0.0;
+			}
+
+			//Provide updates to relevant phases
+			//only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
+					case 0x01:	//C
 						{
-							//End of SPCT transformer requires slightly different Diagonal components (so when it's the To bus of SPCT and from for other triplex
-							if ((bus[indexer].phases & 0x20) == 0x20)	//Special case
+							temp_index=0;
+							temp_index_b=2;
+							break;
+						}
+					case 0x02:	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+							break;
+						}
+					case 0x03:	//BC
+						{
+							if (jindex==0)	//B
 							{
-								//Other triplexes need to be negated to match sign conventions
-								tempY[0][0] -= branch[jindexer].YSfrom[0];
-								tempY[0][1] -= branch[jindexer].YSfrom[1];
-								tempY[1][0] -= branch[jindexer].YSfrom[3];
-								tempY[1][1] -= branch[jindexer].YSfrom[4];
+								temp_index=0;
+								temp_index_b=1;
 							}
-							else										//Just a normal to bus
+							else			//C
 							{
-								tempY[0][0] += branch[jindexer].YSfrom[0];
-								tempY[0][1] += branch[jindexer].YSfrom[1];
-								tempY[1][0] += branch[jindexer].YSfrom[3];
-								tempY[1][1] += branch[jindexer].YSfrom[4];
+								temp_index=1;
+								temp_index_b=2;
 							}
+							break;
 						}
-						else									//To branch
+					case 0x04:	//A
 						{
-							//Replicate the above for SPCT test, in case people put lines in backwards
-							//End of SPCT transformer requires slightly different Diagonal components (so when it's the To bus of SPCT and from for other triplex
-							if (((bus[indexer].phases & 0x20) == 0x20) && (branch[jindexer].lnk_type == 1))	//Special case, but make sure we're not the transformer
+							temp_index=0;
+							temp_index_b=0;
+							break;
+						}
+					case 0x05:	//AC
+						{
+							if (jindex==0)	//A
 							{
-								tempY[0][0] -= branch[jindexer].YSto[0];
-								tempY[0][1] -= branch[jindexer].YSto[1];
-								tempY[1][0] -= branch[jindexer].YSto[3];
-								tempY[1][1] -= branch[jindexer].YSto[4];
+								temp_index=0;
+								temp_index_b=0;
 							}
-							else	//Normal bus - no funky SPCT nonsense
+							else			//C
 							{
-								tempY[0][0] += branch[jindexer].YSto[0];
-								tempY[0][1] += branch[jindexer].YSto[1];
-								tempY[1][0] += branch[jindexer].YSto[3];
-								tempY[1][1] += branch[jindexer].YSto[4];
+								temp_index=1;
+								temp_index_b=2;
 							}
+							break;
 						}
-					}
-					else	//We must be a single or two-phase line - always populate the upper left portion of matrix (easier for later)
-					{
-						switch(bus[indexer].phases & 0x07) {
-							case 0x00:	//No phases (we've been faulted out
-								{
-									break;	//Just get us outta here
-								}
-							case 0x01:	//Only C
-								{
-									if ((branch[jindexer].phases & 0x01) == 0x01)	//Phase C valid on branch
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[8];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[8];
-										}
-									}//End valid phase C
-									break;
-								}
-							case 0x02:	//Only B
-								{
-									if ((branch[jindexer].phases & 0x02) == 0x02)	//Phase B valid on branch
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[4];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[4];
-										}
-									}//End valid phase B
-									break;
-								}
-							case 0x03:	//B & C
-								{
-									phase_worka = (branch[jindexer].phases & 0x03);	//Extract branch phases
+					case 0x06:	//AB
+					case 0x07:	//ABC
+						{
+							temp_index=jindex;
+							temp_index_b=jindex;
+							break;
+						}
+					default:
+						break;
+				}//end case
 
-									if (phase_worka == 0x03)	//Full B & C
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[4];
-											tempY[0][1] += branch[jindexer].YSfrom[5];
-											tempY[1][0] += branch[jindexer].YSfrom[7];
-											tempY[1][1] += branch[jindexer].YSfrom[8];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[4];
-											tempY[0][1] += branch[jindexer].YSto[5];
-											tempY[1][0] += branch[jindexer].YSto[7];
-											tempY[1][1] += branch[jindexer].YSto[8];
-										}
-									}//End valid B & C
-									else if (phase_worka == 0x01)	//Only C branch
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[1][1] += branch[jindexer].YSfrom[8];
-										}
-										else									//To branch
-										{
-											tempY[1][1] += branch[jindexer].YSto[8];
-										}
-									}//end valid C
-									else if (phase_worka == 0x02)	//Only B branch
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[4];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[4];
-										}
-									}//end valid B
-									else	//Must be nothing then - all phases must be faulted, or something
-										;
-									break;
-								}
-							case 0x04:	//Only A
-								{
-									if ((branch[jindexer].phases & 0x04) == 0x04)	//Phase A is valid
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[0];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[0];
-										}
-									}//end valid phase A
-									break;
-								}
-							case 0x05:	//A & C
-								{
-									phase_worka = branch[jindexer].phases & 0x05;	//Extract phases
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A scheduled power update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the scheduled portions of the
+					attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
 
-									if (phase_worka == 0x05)	//Both A & C valid
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[0];
-											tempY[0][1] += branch[jindexer].YSfrom[2];
-											tempY[1][0] += branch[jindexer].YSfrom[6];
-											tempY[1][1] += branch[jindexer].YSfrom[8];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[0];
-											tempY[0][1] += branch[jindexer].YSto[2];
-											tempY[1][0] += branch[jindexer].YSto[6];
-											tempY[1][1] += branch[jindexer].YSto[8];
-										}
-									}//End A & C valid
-									else if (phase_worka == 0x04)	//Only A valid
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[0];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[0];
-										}
-									}//end only A valid
-									else if (phase_worka == 0x01)	//Only C valid
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[1][1] += branch[jindexer].YSfrom[8];
-										}
-										else									//To branch
-										{
-											tempY[1][1] += branch[jindexer].YSto[8];
-										}
-									}//end only C valid
-									else	//No connection - must be faulted
-										;
-									break;
-								}
-							case 0x06:	//A & B
-								{
-									phase_worka = branch[jindexer].phases & 0x06;	//Extract phases
+				//Real power calculations
+				tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				bus[indexer].PL[temp_index] = tempPbus;	//Real power portion - all is current based
 
-									if (phase_worka == 0x06)	//Valid A & B phase
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[0];
-											tempY[0][1] += branch[jindexer].YSfrom[1];
-											tempY[1][0] += branch[jindexer].YSfrom[3];
-											tempY[1][1] += branch[jindexer].YSfrom[4];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[0];
-											tempY[0][1] += branch[jindexer].YSto[1];
-											tempY[1][0] += branch[jindexer].YSto[3];
-											tempY[1][1] += branch[jindexer].YSto[4];
-										}
-									}//End valid A & B
-									else if (phase_worka == 0x04)	//Only valid A
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[0][0] += branch[jindexer].YSfrom[0];
-										}
-										else									//To branch
-										{
-											tempY[0][0] += branch[jindexer].YSto[0];
-										}
-									}//end valid A
-									else if (phase_worka == 0x02)	//Only valid B
-									{
-										if (branch[jindexer].from == indexer)	//From branch
-										{
-											tempY[1][1] += branch[jindexer].YSfrom[4];
-										}
-										else									//To branch
-										{
-											tempY[1][1] += branch[jindexer].YSto[4];
-										}
-									}//end valid B
-									else	//Default - must be already handled
-										;
-									break;
-								}
-							default:	//How'd we get here?
-								{
-									GL_THROW("Unknown phase connection in NR self admittance diagonal");
-									/*  TROUBLESHOOT
-									An unknown phase condition was encountered in the NR solver when constructing
-									the self admittance diagonal.  Please report this bug and submit your code to 
-									the trac system.
-									*/
-								break;
-								}
-						}	//switch end
-					}	//1 or 2 phase end
-				}	//phase accumulation end
-				else		//It's nothing (no connnection)
-					;
-			}//branch traversion end
+				//Reactive load calculations
+				tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion - all is current based
+				
+			}//End phase traversion
+		}//end delta connected
+		else if ((bus[indexer].phases & 0x80) == 0x80)	//Split-phase connected node
+		{
+			//Convert it all back to current (easiest to handle)
+			//Get V12 first
+			voltageDel[0] = bus_V[0] + bus_V[1];
+
+			//Start with the currents (just put them in)
+			temp_current[0] = bus_I[0];
+			temp_current[1] = bus_I[1];
+			temp_current[2] = *bus[indexer].extra_var;	//Current12 is not part of the standard current array
+
+			//Add in deltamode unrotated, if necessary
+			if ((bus[indexer].prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
+				temp_current[2] += bus[indexer].prerot_I[2];
+
+			//Now add in power contributions
+			temp_current[0] += bus_V[0] == 0.0 ? 0.0 : ~(bus_S[0]/bus_V[0]);
+			temp_current[1] += bus_V[1] == 0.0 ? 0.0 : ~(bus_S[1]/bus_V[1]);
+			temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus_S[2]/voltageDel[0]);
+
+			//Last, but not least, admittance/impedance contributions
+			temp_current[0] += bus_Y[0]*bus_V[0];
+			temp_current[1] += bus_Y[1]*bus_V[1];
+			temp_current[2] += bus_Y[2]*voltageDel[0];
+
+			//See if we are a house-connected node, if so, adjust and add in those values as well
+			if ((bus[indexer].phases & 0x40) == 0x40)
+			{
+				//Update phase adjustments
+				temp_store[0].SetPolar(1.0,bus_V[0].Arg());	//Pull phase of V1
+				temp_store[1].SetPolar(1.0,bus_V[1].Arg());	//Pull phase of V2
+				temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
+
+				//Update these current contributions (use delta current variable, it isn't used in here anyways)
+				delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
+				delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
+				delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
+
+				//Now add it into the current contributions
+				temp_current[0] += delta_current[0];
+				temp_current[1] += delta_current[1];
+				temp_current[2] += delta_current[2];
+			}//End house-attached splitphase
+
+			//Convert 'em to line currents
+			temp_store[0] = temp_current[0] + temp_current[2];
+			temp_store[1] = -temp_current[1] - temp_current[2];
+
+			//Update the stored values
+			bus[indexer].PL[0] = temp_store[0].Re();
+			bus[indexer].QL[0] = temp_store[0].Im();
+
+			bus[indexer].PL[1] = temp_store[1].Re();
+			bus[indexer].QL[1] = temp_store[1].Im();
+		}//end split-phase connected
+		else	//Wye-connected node
+		{
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
+			{
+				//Create nominal magnitudes
+				adjust_nominal_voltage_val = bus[indexer].volt_base;
 
-			//Store the self admittance into BA_diag.  Also update the indices for possible use later
-			powerflow_values->BA_diag[indexer].col_ind = powerflow_values->BA_diag[indexer].row_ind = index_count;	// Store the row and column starting information (square matrices)
-			bus[indexer].Matrix_Loc = index_count;								//Store our location so we know where we go
-			index_count += powerflow_values->BA_diag[indexer].size;				// Update the index for this matrix's size, so next one is in appropriate place
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+				adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+				adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
 
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+				adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+				adjust_temp_voltage_mag[5] = bus_V[2].Mag();
 
-			//Store the admittance values into the BA_diag matrix structure
-			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-			{
-				for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)			//Store values - assume square matrix - don't bother parsing what doesn't exist.
+				//Start adjustments - A
+				if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
 				{
-					powerflow_values->BA_diag[indexer].Y[jindex][kindex] = tempY[jindex][kindex];// Store the self admittance terms.
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus_I[0] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[0] = 0.0;
 				}
-			}
 
-			//Copy values into node-specific link (if needed)
-			if (bus[indexer].full_Y_all != NULL)
-			{
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+				//Start adjustments - B
+				if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 				{
-					for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)			//Store values - assume square matrix - don't bother parsing what doesn't exist.
-					{
-						bus[indexer].full_Y_all[jindex*3+kindex] = tempY[jindex][kindex];// Store the self admittance terms.
-					}
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus_I[1] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
 				}
-			}//End self-admittance update
-		}//End diagonal construction
 
-		//Store the size of the diagonal, since it represents how many variables we are solving (useful later)
-		powerflow_values->total_variables=index_count;
+				//Start adjustments - C
+				if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus_I[2] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
 
-		//Check to see if we've exceeded our max.  If so, reallocate!
-		if (powerflow_values->total_variables > powerflow_values->max_total_variables)
-			powerflow_values->NR_realloc_needed = true;
+				//Testing - do adjustments for unrotated current
+				if (bus[indexer].prerot_I[0] != 0.0)
+					adjusted_constant_current[0] += bus[indexer].prerot_I[0];
 
-		/// Build the off_diagonal_PQ bus elements of 6n*6n Y_NR matrix.Equation (12). All the value in this part will not be updated at each iteration.
-		//Constructed using sparse methodology, non-zero elements are the only thing considered (and non-PV)
-		//No longer necessarily 6n*6n any more either,
-		powerflow_values->size_offdiag_PQ = 0;
-		for (jindexer=0; jindexer<branch_count;jindexer++)	//Parse all of the branches
-		{
-			tempa  = branch[jindexer].from;
-			tempb  = branch[jindexer].to;
+				if (bus[indexer].prerot_I[1] != 0.0)
+					adjusted_constant_current[1] += bus[indexer].prerot_I[1];
 
-			//Preliminary check to make sure we weren't missed in the initialization
-			if ((bus[tempa].Matrix_Loc == -1) || (bus[tempb].Matrix_Loc == -1))
-			{
-				GL_THROW("An element in NR line:%d was not properly localized");
-				/*  TROUBLESHOOT
-				When parsing the bus list, the Newton-Raphson solver found a bus that did not
-				appear to have a location within the overall admittance/Jacobian matrix.  Please
-				submit this as a bug with your code on the Trac site.
-				*/
-			}
+				if (bus[indexer].prerot_I[2] != 0.0)
+					adjusted_constant_current[2] += bus[indexer].prerot_I[2];
 
-			if (((branch[jindexer].phases & 0x80) == 0x80) && (branch[jindexer].v_ratio==1.0))	//Triplex, but not SPCT
-			{
-				for (jindex=0; jindex<2; jindex++)			//rows
+				//See if we have any "different children"
+				if ((bus[indexer].phases & 0x10) == 0x10)
 				{
-					for (kindex=0; kindex<2; kindex++)		//columns
-					{
-						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
-							powerflow_values->size_offdiag_PQ += 1; 
+					//Create nominal magnitudes
+					adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
 
-						if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
-							powerflow_values->size_offdiag_PQ += 1; 
+					//Create the nominal voltage vectors
+					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
 
-						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-							powerflow_values->size_offdiag_PQ += 1; 
+					//Compute delta voltages
+					voltageDel[0] = bus_V[0] - bus_V[1];
+					voltageDel[1] = bus_V[1] - bus_V[2];
+					voltageDel[2] = bus_V[2] - bus_V[0];
 
-						if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-							powerflow_values->size_offdiag_PQ += 1; 
-					}//end columns of split phase
-				}//end rows of split phase
-			}//end traversion of split-phase
-			else											//Three phase or some variety
-			{
-				//Make sure we aren't SPCT, otherwise things get jacked
-				if ((branch[jindexer].phases & 0x80) != 0x80)	//SPCT, but v_ratio not = 1
-				{
-					for (jindex=0; jindex<3; jindex++)			//rows
-					{
-						//See if this phase is valid
-						phase_workb = 0x04 >> jindex;
+					//Get magnitudes of all
+					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
 
-						if ((phase_workb & branch[jindexer].phases) == phase_workb)	//Row check
-						{
-							for (kindex=0; kindex<3; kindex++)		//columns
-							{
-								//Check this phase as well
-								phase_workd = 0x04 >> kindex;
+					//Start adjustments - AB
+					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[3] = 0.0;
+					}
 
-								if ((phase_workd & branch[jindexer].phases) == phase_workd)	//Column validity check
-								{
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
-										powerflow_values->size_offdiag_PQ += 1; 
+					//Start adjustments - BC
+					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[4] = 0.0;
+					}
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
-										powerflow_values->size_offdiag_PQ += 1; 
+					//Start adjustments - CA
+					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[5] = 0.0;
+					}
+				}
+				else	//Nope
+				{
+					//Set to zero, just cause
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}
+			else	//"Normal" modes -- handle traditionally
+			{
+				adjusted_constant_current[0] = bus_I[0];
+				adjusted_constant_current[1] = bus_I[1];
+				adjusted_constant_current[2] = bus_I[2];
 
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-										powerflow_values->size_offdiag_PQ += 1; 
+				//See if we have different children too
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Store them too
+					adjusted_constant_current[3] = bus[indexer].extra_var[6];
+					adjusted_constant_current[4] = bus[indexer].extra_var[7];
+					adjusted_constant_current[5] = bus[indexer].extra_var[8];
+				}
+				else	//Nope, just zero this for now
+				{
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}//End adjustment code
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-										powerflow_values->size_offdiag_PQ += 1; 
-								}//end column validity check
-							}//end columns of 3 phase
-						}//End row validity check
-					}//end rows of 3 phase
-				}//end not SPCT
-				else	//SPCT inmplementation
+			//For Wye-connected, only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+
+			if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
+			{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
+				//Delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Make sure phase combinations exist
+				if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
 				{
-					for (jindex=0; jindex<3; jindex++)			//rows
-					{
-						//See if this phase is valid
-						phase_workb = 0x04 >> jindex;
+					//Power - put into a current value (iterates less this way)
+					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
 
-						if ((phase_workb & branch[jindexer].phases) == phase_workb)	//Row check
-						{
-							for (kindex=0; kindex<3; kindex++)		//Row valid, traverse all columns for SPCT Yfrom
-							{
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
-									powerflow_values->size_offdiag_PQ += 1; 
+					//Convert delta connected load to appropriate Wye 
+					delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					delta_current[0] = 0.0;
+				}
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-									powerflow_values->size_offdiag_PQ += 1; 
-							}//end columns traverse
+				//Check for BC
+				if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
+				{
+					//Power - put into a current value (iterates less this way)
+					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
 
-							//If row is valid, now traverse the rows of that column for Yto
-							for (kindex=0; kindex<3; kindex++)
+					//Convert delta connected load to appropriate Wye 
+					delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					delta_current[1] = 0.0;
+				}
+
+				//Check for CA
+				if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
+				{
+					//Power - put into a current value (iterates less this way)
+					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
+
+					//Convert delta connected load to appropriate Wye 
+					delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					delta_current[2] = 0.0;
+				}
+
+				//Convert delta-current into a phase current - reuse temp variable
+				undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
+				undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
+				undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
+			}
+			else	//zero the variable so we don't have excessive ifs
+			{
+				undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = 0.0;	//Zero it
+			}
+
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
+					case 0x01:	//C
+						{
+							temp_index=0;
+							temp_index_b=2;
+							break;
+						}
+					case 0x02:	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+							break;
+						}
+					case 0x03:	//BC
+						{
+							if (jindex==0)	//B
 							{
-								if (((branch[jindexer].Yto[kindex*3+jindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
-									powerflow_values->size_offdiag_PQ += 1; 
+								temp_index=0;
+								temp_index_b=1;
+							}
+							else			//C
+							{
+								temp_index=1;
+								temp_index_b=2;
+							}
+							break;
+						}
+					case 0x04:	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+							break;
+						}
+					case 0x05:	//AC
+						{
+							if (jindex==0)	//A
+							{
+								temp_index=0;
+								temp_index_b=0;
+							}
+							else			//C
+							{
+								temp_index=1;
+								temp_index_b=2;
+							}
+							break;
+						}
+					case 0x06:	//AB
+					case 0x07:	//ABC
+						{
+							temp_index=jindex;
+							temp_index_b=jindex;
+							break;
+						}
+					default:
+						break;
+				}//end case
 
-								if (((branch[jindexer].Yto[kindex*3+jindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
-									powerflow_values->size_offdiag_PQ += 1; 
-							}//end rows traverse
-						}//End row validity check
-					}//end rows of 3 phase
-				}//End SPCT
-			}//end three phase
-		}//end line traversion
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A scheduled power update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the scheduled portions of the
+					attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
 
-		//Allocate the space - double the number found (each element goes in two places)
-		if (powerflow_values->Y_offdiag_PQ == NULL)
-		{
-			powerflow_values->Y_offdiag_PQ = (Y_NR *)gl_malloc((powerflow_values->size_offdiag_PQ*2) *sizeof(Y_NR));   //powerflow_values->Y_offdiag_PQ store the row,column and value of off_diagonal elements of Bus Admittance matrix in which all the buses are not PV buses. 
+				//Perform the power calculation
+				tempPbus = (bus_S[temp_index_b]).Re();									// Real power portion of constant power portion
+				tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				tempPbus += (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current from "different" children
+				tempPbus += (bus_Y[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (bus_Y[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+				bus[indexer].PL[temp_index] = tempPbus;	//Real power portion
+				
+				
+				tempQbus = (bus_S[temp_index_b]).Im();									// Reactive power portion of constant power portion
+				tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				tempQbus += (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
+				tempQbus += -(bus_Y[temp_index_b]).Im() * (bus_V[temp_index_b]).Im() * (bus_V[temp_index_b]).Im() - (bus_Y[temp_index_b]).Im() * (bus_V[temp_index_b]).Re() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage				
+				bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion  
 
-			//Make sure it worked
-			if (powerflow_values->Y_offdiag_PQ == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			}//end phase traversion
+		}//end wye-connected
 
-			//Save our size
-			powerflow_values->max_size_offdiag_PQ = powerflow_values->size_offdiag_PQ;	//Don't care about the 2x, since we'll be comparing it against itself
-		}
-		else if (powerflow_values->size_offdiag_PQ > powerflow_values->max_size_offdiag_PQ)	//Something changed and we are bigger!!
+		//Perform explicit delta/wye load accumulation - do if not triplex
+		if ((bus[indexer].phases & 0x80) != 0x80)
 		{
-			//Destroy us!
-			gl_free(powerflow_values->Y_offdiag_PQ);
+			//Delta components - populate according to what is there
+			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+			{
+				//Voltage calculations
+				voltageDel[0] = bus_V[0] - bus_V[1];
 
-			//Rebuild us, we have the technology
-			powerflow_values->Y_offdiag_PQ = (Y_NR *)gl_malloc((powerflow_values->size_offdiag_PQ*2) *sizeof(Y_NR));
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S_dy[0]/voltageDel[0]);
 
-			//Make sure it worked
-			if (powerflow_values->Y_offdiag_PQ == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+				//Convert delta connected load to appropriate Wye
+				delta_current[0] += voltageDel[0] * (bus_Y_dy[0]);
 
-			//Store the new size
-			powerflow_values->max_size_offdiag_PQ = powerflow_values->size_offdiag_PQ;
+			}
+			else
+			{
+				//Zero values - they shouldn't be used anyhow
+				voltageDel[0] = 0.0;
+				delta_current[0] = 0.0;
+			}
 
-			//Flag for a reallocation
-			powerflow_values->NR_realloc_needed = true;
-		}
+			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+			{
+				//Voltage calculations
+				voltageDel[1] = bus_V[1] - bus_V[2];
 
-		indexer = 0;
-		for (jindexer=0; jindexer<branch_count;jindexer++)	//Parse through all of the branches
-		{
-			//Extract both ends
-			tempa  = branch[jindexer].from;
-			tempb  = branch[jindexer].to;
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S_dy[1]/voltageDel[1]);
 
-			phase_worka = 0;
-			phase_workb = 0;
-			for (jindex=0; jindex<3; jindex++)		//Accumulate number of phases
+				//Convert delta connected load to appropriate Wye
+				delta_current[1] += voltageDel[1] * (bus_Y_dy[1]);
+
+			}
+			else
 			{
-				phase_worka += ((bus[tempa].phases & (0x01 << jindex)) >> jindex);
-				phase_workb += ((bus[tempb].phases & (0x01 << jindex)) >> jindex);
+				//Zero unused
+				voltageDel[1] = 0.0;
+				delta_current[1] = 0.0;
 			}
 
-			if ((phase_worka==3) && (phase_workb==3))	//Both ends are full three phase, normal operations
+			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
 			{
-				for (jindex=0; jindex<3; jindex++)		//Loop through rows of admittance matrices				
-				{
-					//See if this row is valid for this branch
-					phase_workd = 0x04 >> jindex;
+				//Voltage calculations
+				voltageDel[2] = bus_V[2] - bus_V[0];
 
-					if ((branch[jindexer].phases & phase_workd) == phase_workd)	//Validity check
-					{
-						for (kindex=0; kindex<3; kindex++)	//Loop through columns of admittance matrices
-						{
-							//Extract column information
-							phase_worke = 0x04 >> kindex;
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S_dy[2]/voltageDel[2]);
 
-							if ((branch[jindexer].phases & phase_worke) == phase_worke)	//Valid column too!
-							{
-								//Indices counted out from Self admittance above.  needs doubling due to complex separation
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-									indexer += 1;
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+				//Convert delta connected load to appropriate Wye
+				delta_current[2] += voltageDel[2] * (bus_Y_dy[2]);
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
-									indexer += 1;
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[2] = 0.0;
+				delta_current[2] = 0.0;
+			}
+			
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
+			{
+				//Create line-line nominal magnitude
+				adjust_nominal_voltage_val = bus[indexer].volt_base;
+				adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
+
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
+				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
+				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
+				adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
+				adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
+				adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
+
+				//Compute delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+				adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+				adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+				adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+				//Start adjustments - A
+				if ((bus_I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus_I_dy[3] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[3] = 0.0;
+				}
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
+				//Start adjustments - B
+				if ((bus_I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus_I_dy[4] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[4] = 0.0;
+				}
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 3;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
-							}//End valid column
-						}//column end
-					}//End valid row
-				}//row end
-			}//if all 3 end
-			else if (((bus[tempa].phases & 0x80) == 0x80) || ((bus[tempb].phases & 0x80) == 0x80))	//Someone's a triplex
-			{
-				if (((bus[tempa].phases & 0x80) == 0x80) && ((bus[tempb].phases & 0x80) == 0x80))	//Both are triplex, easy case
+				//Start adjustments - C
+				if ((bus_I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
 				{
-					for (jindex=0; jindex<2; jindex++)		//Loop through rows of admittance matrices (only 2x2)
-					{
-						for (kindex=0; kindex<2; kindex++)	//Loop through columns of admittance matrices (only 2x2)
-						{
-							//Make sure one end of us isn't a SPCT transformer To node (they are different)
-							if (((bus[tempa].phases & 0x20) & (bus[tempb].phases & 0x20)) == 0x20)	//Both ends are SPCT tos
-							{
-								GL_THROW("NR: SPCT to SPCT via triplex connections are unsupported at this time.");
-								/*  TROUBLESHOOT
-								The Newton-Raphson solve does not currently support running a triplex line between the low-voltage
-								side of two different split-phase center tapped transformers.  This functionality may be added if needed
-								in the future.
-								*/
-							}//end both ends SPCT to
-							else if ((bus[tempa].phases & 0x20) == 0x20)	//From end is a SPCT to
-							{
-								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+					//calculate new value
+					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus_I_dy[5] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[5] = 0.0;
+				}
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+				//Start adjustments - AB
+				if ((bus_I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[0] = 0.0;
+				}
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+				//Start adjustments - BC
+				if ((bus_I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
+				}
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
+				//Start adjustments - CA
+				if ((bus_I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
+			}//End deltamode adjustment
+			else	//Normal mode
+			{
+				//Just copy the values in
+				adjusted_constant_current[0] = bus_I_dy[0];
+				adjusted_constant_current[1] = bus_I_dy[1];
+				adjusted_constant_current[2] = bus_I_dy[2];
+				adjusted_constant_current[3] = bus_I_dy[3];
+				adjusted_constant_current[4] = bus_I_dy[4];
+				adjusted_constant_current[5] = bus_I_dy[5];
+			}
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
-							}//end From end SPCT to
-							else if ((bus[tempb].phases & 0x20) == 0x20)	//To end is a SPCT to
-							{
-								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+			//Convert delta-current into a phase current, where appropriate - reuse temp variable
+			//Everything will be accumulated into the "current" field for ease (including differents)
+			//Also handle wye currents in here (was a differently connected child code before)
+			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+			{
+				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
 
-								//Make sure we aren't the transformer
-								if (branch[jindexer].lnk_type == 1)	//We're not, we're a line - proceed
-								{
+				//Power values
+				undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus_S_dy[3]/bus_V[0]);
 
-									//Indices counted out from Self admittance above.  needs doubling due to complex separation
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-										indexer += 1;
+				//Shunt values
+				undeltacurr[0] += bus_Y_dy[3]*bus_V[0];
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-										indexer += 1;
-									}
+				//Current values
+				undeltacurr[0] += adjusted_constant_current[3];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[0] = 0.0;
+			}
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Im());
-										indexer += 1;
+			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			{
+				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yto[jindex*3+kindex]).Im();
-										indexer += 1;
-									}
+				//Power values
+				undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus_S_dy[4]/bus_V[1]);
 
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-										indexer += 1;
+				//Shunt values
+				undeltacurr[1] += bus_Y_dy[4]*bus_V[1];
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-										indexer += 1;
-									}
+				//Current values
+				undeltacurr[1] += adjusted_constant_current[4];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[1] = 0.0;
+			}
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
-										indexer += 1;
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
-										indexer += 1;
-									}
-								}//End SPCT TO bus and we're a line
-								else	//Transformer to - don't do things weird
-								{
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-										indexer += 1;
+			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+			{
+				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-										indexer += 1;
-									}
+				//Power values
+				undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus_S_dy[5]/bus_V[2]);
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Im());
-										indexer += 1;
+				//Shunt values
+				undeltacurr[2] += bus_Y_dy[5]*bus_V[2];
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yto[jindex*3+kindex]).Im();
-										indexer += 1;
-									}
+				//Current values
+				undeltacurr[2] += adjusted_constant_current[5];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[2] = 0.0;
+			}
 
-									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-										indexer += 1;
+			//Provide updates to relevant phases
+			//only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
+					case 0x01:	//C
+						{
+							temp_index=0;
+							temp_index_b=2;
+							break;
+						}
+					case 0x02:	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+							break;
+						}
+					case 0x03:	//BC
+						{
+							if (jindex==0)	//B
+							{
+								temp_index=0;
+								temp_index_b=1;
+							}
+							else			//C
+							{
+								temp_index=1;
+								temp_index_b=2;
+							}
+							break;
+						}
+					case 0x04:	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+							break;
+						}
+					case 0x05:	//AC
+						{
+							if (jindex==0)	//A
+							{
+								temp_index=0;
+								temp_index_b=0;
+							}
+							else			//C
+							{
+								temp_index=1;
+								temp_index_b=2;
+							}
+							break;
+						}
+					case 0x06:	//AB
+					case 0x07:	//ABC
+						{
+							temp_index=jindex;
+							temp_index_b=jindex;
+							break;
+						}
+					default:
+						break;
+				}//end case
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-										indexer += 1;
-									}
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A scheduled power update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the scheduled portions of the
+					attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
 
-									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
-									{
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
-										indexer += 1;
+				//Real power calculations
+				tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				bus[indexer].PL[temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
 
-										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
-										indexer += 1;
-									}
-								}//End SPCT TO and we're the transformer
-							}//end To end SPCT to
-							else											//Plain old ugly line
-							{
-								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+				//Reactive load calculations
+				tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				bus[indexer].QL[temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
+					
+			}//End phase traversion
+		}//End delta/wye explicit load update
+	}//end bus traversion for power update
+}
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+//Calculated loads and current injection mismatch (deltaI) of one bus range
+static void solver_nr_mismatch_range(NR_ASSEMBLY_CHUNK *chunk)
+{
+	BUSDATA *bus = chunk->data->bus;
+	NR_SOLVER_STRUCT *powerflow_values = chunk->data->powerflow_values;
+	BRANCHDATA *branch = chunk->data->branch;
+	NR_PACKED_STORAGE *packed = chunk->data->packed;
+	complex *bus_V, *from_V, *to_V, *branch_Yfrom, *branch_Yto;
+	NRSOLVERMODE powerflow_type = chunk->data->powerflow_type;
+	int64 Iteration = chunk->data->Iteration;
+	bool swing_is_a_swing = chunk->data->swing_is_a_swing;
+	complex aval = chunk->data->aval;
+	complex avalsq = chunk->data->avalsq;
+	unsigned int indexer, jindexer, kindexer;
+	char jindex, kindex;
+	char temp_index, temp_index_b;
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
-									indexer += 1;
-								}
+	//Phase collapser variable
+	unsigned char phase_worka;
 
-								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
+	//Miscellaneous flag variable
+	bool proceed_flag;
 
-								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
-								{
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;
-									
-									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
-									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
-									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
-									indexer += 1;	
-								}
-							}//end Normal triplex branch
-						}//column end
-					}//row end
-				}//end both triplexy
-				else if ((bus[tempa].phases & 0x80) == 0x80)	//From is the triplex - this implies transformer with or something, we don't support this
-				{
-					GL_THROW("NR does not support triplex to 3-phase connections.");
-					/*  TROUBLESHOOT
-					The Newton-Raphson solver does not have any implementation elements
-					to support the connection of a split-phase or triplex node to a three-phase
-					node.  The opposite (3-phase to triplex) is available as the split-phase-center-
-					tapped transformer model.  See if that will work for your implementation.
-					*/
-				}//end from triplexy
-				else	//Only option left is the to must be the triplex - implies SPCT xformer - so only one phase on the three-phase side (we just need to figure out where)
+	//Temporary calculation variables
+	double tempIcalcReal, tempIcalcImag;
+	double tempPbus; //tempPbus store the temporary value of active power load at each bus
+	double tempQbus; //tempQbus store the temporary value of reactive power load at each bus
+
+	//Deltamode intermediate variables
+	complex temp_complex_0, temp_complex_1, temp_complex_2, temp_complex_3, temp_complex_4, temp_complex_5;
+
+	//Miscellaneous working variable
+	double work_vals_double_0, work_vals_double_1,work_vals_double_2,work_vals_double_3,work_vals_double_4;
+	char work_vals_char_0;
+
+	//Assume converged, fail by exception
+	chunk->swing_converged = true;
+
+	for (indexer=chunk->bus_start; indexer<chunk->bus_end; indexer++) //for specific bus k
+	{
+		//Read the packed copies directly when they are in use
+		bus_V = (packed != NULL) ? &packed->V[3*indexer] : bus[indexer].V;
+
+		//Update for generator symmetry - only in static dynamic mode and when SWING is a SWING
+		if ((powerflow_type == PF_DYNINIT) && (swing_is_a_swing==true))
+		{
+			//Secondary check - see if it is even needed - basically built around 3-phase right now
+			if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+			{
+				//Form denominator term of Ii, since it won't change
+				temp_complex_1 = (~bus_V[0]) + (~bus_V[1])*avalsq + (~bus_V[2])*aval;
+				
+				//Form up numerator portion that doesn't change (Q and admittance)
+				//Do in parts, just for readability
+				temp_complex_2 = ~bus_V[0];	//conj(Va)
+				
+				//Row 1 of admittance mult
+				temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*bus_V[0] + bus[indexer].full_Y[1]*bus_V[1] + bus[indexer].full_Y[2]*bus_V[2]);
+
+				// Row 1 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus 
+				temp_complex_5 = bus[indexer].full_Y[0]*bus_V[0] + bus[indexer].full_Y[1]*bus_V[1] + bus[indexer].full_Y[2]*bus_V[2];
+				temp_complex_4 = ~temp_complex_5;
+				temp_complex_3 = bus_V[0]*temp_complex_4;
+
+				//conj(Vb)
+				temp_complex_2 = ~bus_V[1];
+
+				//Row 2 of admittance
+				temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*bus_V[0] + bus[indexer].full_Y[4]*bus_V[1] + bus[indexer].full_Y[5]*bus_V[2]);
+				
+				// Row 2 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
+				temp_complex_5 = bus[indexer].full_Y[3]*bus_V[0] + bus[indexer].full_Y[4]*bus_V[1] + bus[indexer].full_Y[5]*bus_V[2];
+				temp_complex_4 = ~temp_complex_5;
+				temp_complex_3 += bus_V[1]*temp_complex_4;
+
+				//conj(Vc)
+				temp_complex_2 = ~bus_V[2];
+
+				//Row 3 of admittance
+				temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*bus_V[0] + bus[indexer].full_Y[7]*bus_V[1] + bus[indexer].full_Y[8]*bus_V[2]);
+
+				// Row 3 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
+				temp_complex_5 = bus[indexer].full_Y[6]*bus_V[0] + bus[indexer].full_Y[7]*bus_V[1] + bus[indexer].full_Y[8]*bus_V[2];
+				temp_complex_4 = ~temp_complex_5;
+				temp_complex_3 += bus_V[2]*temp_complex_4;					
+
+				//numerator done, except PT portion (add in below - SWING bus is different
+
+				//On that note, if we are a SWING, zero our PT portion and QT for accumulation
+				if ((bus[indexer].type == 2) && (Iteration>0))
 				{
-					//Extract the line phase
-					phase_workc = (branch[jindexer].phases & 0x07);
+					*bus[indexer].PGenTotal = complex(0.0,0.0);
+				}
+			}
+			else	//Not enabled or not "full-Y-ed" - set to zero
+			{
+				temp_complex_0 = 0.0;
+				temp_complex_1 = 0.0;	//Basically a flag to ignore it
+			}
+		}//End PF_DYNINIT and SWING is still the same
 
-					//Reset temp_index and size, just in case
-					temp_index = -1;
-					temp_size = -1;
+		for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++) // rows - for specific phase that exists
+		{
+			tempIcalcReal = tempIcalcImag = 0;   
 
-					//Figure out what the offset on the from side is (how many phases and which one we are)
-					switch(bus[tempa].phases & 0x07)
+			if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase - triplex bus
+			{
+				//Two states of triplex bus - To node of SPCT transformer needs to be different
+				//First different - Delta-I and diagonal contributions
+				if ((bus[indexer].phases & 0x20) == 0x20)	//We're the To bus
+				{
+					//Pre-negated due to the nature of how it's calculated (V1 compared to I1)
+					tempPbus =  bus[indexer].PL[jindex];	//Copy load amounts in
+					tempQbus =  bus[indexer].QL[jindex];	
+				}
+				else	//We're just a normal triplex bus
+				{
+					//This one isn't negated (normal operations)
+					tempPbus =  -bus[indexer].PL[jindex];	//Copy load amounts in
+					tempQbus =  -bus[indexer].QL[jindex];	
+				}//end normal triplex bus
+
+				//Get diagonal contributions - only (& always) 2
+				//Column 1
+				tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus_V[0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus_V[0]).Im();// equation (7), the diag elements of bus admittance matrix 
+				tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus_V[0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus_V[0]).Re();// equation (8), the diag elements of bus admittance matrix 
+
+				//Column 2
+				tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus_V[1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus_V[1]).Im();// equation (7), the diag elements of bus admittance matrix 
+				tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus_V[1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus_V[1]).Re();// equation (8), the diag elements of bus admittance matrix 
+
+				//Now off diagonals
+				for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)
+				{
+					//Apply proper index to jindexer (easier to implement this way)
+					jindexer=bus[indexer].Link_Table[kindexer];
+					branch_Yfrom = (packed != NULL) ? &packed->Yfrom[9*jindexer] : branch[jindexer].Yfrom;
+					branch_Yto = (packed != NULL) ? &packed->Yto[9*jindexer] : branch[jindexer].Yto;
+					from_V = (packed != NULL) ? &packed->V[3*branch[jindexer].from] : bus[branch[jindexer].from].V;
+					to_V = (packed != NULL) ? &packed->V[3*branch[jindexer].to] : bus[branch[jindexer].to].V;
+
+					if (branch[jindexer].from == indexer)	//We're the from bus
 					{
-						case 0x01:	//C
-							{
-								temp_size = 1;	//Single phase matrix
+						if ((bus[indexer].phases & 0x20) == 0x20)	//SPCT from bus - needs different signage
+						{
+							work_vals_char_0 = jindex*3;
 
-								if (phase_workc==0x01)	//Line is phase C
-								{
-									//Only C in the node, so no offset
-									temp_index = 0;
-								}
-								else if (phase_workc==0x02)	//Line is phase B
-								{
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-									/*  TROUBLESHOOT
-									A split-phase, center-tapped transformer in the Newton-Raphson solver is somehow attached
-									to a node that is missing the required phase of the transformer.  This should have been caught.
-									Please submit your code and a bug report using the trac website.
-									*/
-								}
-								else					//Has to be phase A
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+							//This situation can only be a normal line (triplex will never be the from for another type)
+							//Again only, & always 2 columns (just do them explicitly)
+							//Column 1
+							tempIcalcReal += ((branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Re() - ((branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += ((branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Im() + ((branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
-								break;
+							//Column2
+							tempIcalcReal += ((branch_Yfrom[jindex*3+1])).Re() * (to_V[1]).Re() - ((branch_Yfrom[jindex*3+1])).Im() * (to_V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += ((branch_Yfrom[jindex*3+1])).Re() * (to_V[1]).Im() + ((branch_Yfrom[jindex*3+1])).Im() * (to_V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+
+						}//End SPCT To bus - from diagonal contributions
+						else		//Normal line connection to normal triplex
+						{
+							work_vals_char_0 = jindex*3;
+							//This situation can only be a normal line (triplex will never be the from for another type)
+							//Again only, & always 2 columns (just do them explicitly)
+							//Column 1
+							tempIcalcReal += (-(branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Re() - (-(branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += (-(branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Im() + (-(branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+
+							//Column2
+							tempIcalcReal += (-(branch_Yfrom[jindex*3+1])).Re() * (to_V[1]).Re() - (-(branch_Yfrom[jindex*3+1])).Im() * (to_V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += (-(branch_Yfrom[jindex*3+1])).Re() * (to_V[1]).Im() + (-(branch_Yfrom[jindex*3+1])).Im() * (to_V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+
+						}//end normal triplex from
+					}//end from bus
+					else if (branch[jindexer].to == indexer)	//We're the to bus
+					{
+						if (branch[jindexer].v_ratio != 1.0)	//Transformer
+						{
+							//Only a single contributor on the from side - figure out how to get to it
+							if ((branch[jindexer].phases & 0x01) == 0x01)	//C
+							{
+								temp_index=2;
 							}
-						case 0x02:	//B
+							else if ((branch[jindexer].phases & 0x02) == 0x02)	//B
 							{
-								temp_size = 1;	//Single phase matrix
+								temp_index=1;
+							}
+							else if ((branch[jindexer].phases & 0x04) == 0x04)	//A
+							{
+								temp_index=0;
+							}
+							else	//How'd we get here!?!
+							{
+								NR_ASSEMBLY_THROW(chunk,"NR: A split-phase transformer appears to have an invalid phase");
+								/*  TROUBLESHOOT
+								While attempting to compute the calculated power current, a split-phase transformer was found
+								connected to a phase other than A, B, or C.  Please check the phasing of the split-phase
+								transformers in the model, and submit your code and a bug report via the trac website if it is correct.
+								*/
+							}
 
-								if (phase_workc==0x01)	//Line is phase C
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-								else if (phase_workc==0x02)	//Line is phase B
-								{
-									//Only B in the node, so no offset
-									temp_index = 0;
-								}
-								else					//Has to be phase A
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+							work_vals_char_0 = jindex*3+temp_index;
 
-								break;
-							}
-						case 0x03:	//BC
+							//Perform the update, it only happens for one column (nature of the transformer)
+							tempIcalcReal += (-(branch_Yto[work_vals_char_0])).Re() * (from_V[temp_index]).Re() - (-(branch_Yto[work_vals_char_0])).Im() * (from_V[temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += (-(branch_Yto[work_vals_char_0])).Re() * (from_V[temp_index]).Im() + (-(branch_Yto[work_vals_char_0])).Im() * (from_V[temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+
+						}//end transformer
+						else									//Must be a normal line then
+						{
+							if ((bus[indexer].phases & 0x20) == 0x20)	//SPCT from bus - needs different signage
 							{
-								temp_size = 2;	//Two phase matrix
+								work_vals_char_0 = jindex*3;
+								//This case should never really exist, but if someone reverses a secondary or is doing meshed secondaries, it might
+								//Again only, & always 2 columns (just do them explicitly)
+								//Column 1
+								tempIcalcReal += ((branch_Yto[work_vals_char_0])).Re() * (from_V[0]).Re() - ((branch_Yto[work_vals_char_0])).Im() * (from_V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((branch_Yto[work_vals_char_0])).Re() * (from_V[0]).Im() + ((branch_Yto[work_vals_char_0])).Im() * (from_V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
-								if (phase_workc==0x01)	//Line is phase C
-								{
-									//BC in the node, so offset by 1
-									temp_index = 1;
-								}
-								else if (phase_workc==0x02)	//Line is phase B
-								{
-									//BC in the node, so offset by 0
-									temp_index = 0;
-								}
-								else					//Has to be phase A
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								//Column2
+								tempIcalcReal += ((branch_Yto[work_vals_char_0+1])).Re() * (from_V[1]).Re() - ((branch_Yto[work_vals_char_0+1])).Im() * (from_V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((branch_Yto[work_vals_char_0+1])).Re() * (from_V[1]).Im() + ((branch_Yto[work_vals_char_0+1])).Im() * (from_V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							}//End SPCT To bus - from diagonal contributions
+							else		//Normal line connection to normal triplex
+							{
+								work_vals_char_0 = jindex*3;
+								//Again only, & always 2 columns (just do them explicitly)
+								//Column 1
+								tempIcalcReal += (-(branch_Yto[work_vals_char_0])).Re() * (from_V[0]).Re() - (-(branch_Yto[work_vals_char_0])).Im() * (from_V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(branch_Yto[work_vals_char_0])).Re() * (from_V[0]).Im() + (-(branch_Yto[work_vals_char_0])).Im() * (from_V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+
+								//Column2
+								tempIcalcReal += (-(branch_Yto[work_vals_char_0+1])).Re() * (from_V[1]).Re() - (-(branch_Yto[work_vals_char_0+1])).Im() * (from_V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(branch_Yto[work_vals_char_0+1])).Re() * (from_V[1]).Im() + (-(branch_Yto[work_vals_char_0+1])).Im() * (from_V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							}//End normal triplex connection
+						}//end normal line
+					}//end to bus
+					else	//We're nothing
+						;
+
+				}//End branch traversion
+
+				//Determine how we are posting this update
+				if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))	//SWING bus is different (when it really is a SWING bus)
+				{
+					if ((powerflow_type == PF_DYNINIT) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+					{
+						//Compute the delta_I, just like below - but don't post it (still zero in calcs)
+						work_vals_double_3 = tempPbus - tempIcalcReal;
+						work_vals_double_4 = tempQbus - tempIcalcImag;
+
+						//Form a magnitude vector
+						work_vals_double_0 = sqrt((work_vals_double_3*work_vals_double_3+work_vals_double_4*work_vals_double_4));
+						
+						if (work_vals_double_0 > bus[indexer].max_volt_error)	//Failure check (defaults to voltage convergence for now)
+						{
+							chunk->swing_converged=false;
+						}
+					}//End PF_DYNINIT SWING traversion
+
+					//Must be normal run, since DYNRUN should have swing capabilities deflagged
+					//Normal run - zero it - should already be zerod, but let's be paranoid for now
+					powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
+					powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
+				}//End SWING bus cases
+				else	//PQ bus or SWING masquerading as a PQ
+				{
+					//It's I.  Just a direct conversion (P changed above to I as well)
+					powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = tempPbus - tempIcalcReal;
+					powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = tempQbus - tempIcalcImag;
+				}//End Normal PQ bus
+			}//End split-phase present
+			else	//Three phase or some variant thereof
+			{
+				tempPbus =  - bus[indexer].PL[jindex];	//Copy load amounts in
+				tempQbus =  - bus[indexer].QL[jindex];	
 
+				for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)		//cols - Still only for specified phases
+				{
+					//Determine our indices, based on phase information
+					temp_index = -1;
+					switch(bus[indexer].phases & 0x07) {
+						case 0x01:	//C
+							{
+								temp_index=2;
 								break;
-							}
+							}//end 0x01
+						case 0x02:	//B
+							{
+								temp_index=1;
+								break;
+							}//end 0x02
+						case 0x03:	//BC
+							{
+								if (kindex==0)	//B
+									temp_index=1;
+								else	//C
+									temp_index=2;
+								break;
+							}//end 0x03
 						case 0x04:	//A
 							{
-								temp_size = 1;	//Single phase matrix
-
-								if (phase_workc==0x01)	//Line is phase C
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-								else if (phase_workc==0x02)	//Line is phase B
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-								else					//Has to be phase A
-								{
-									//Only A in the node, so no offset
-									temp_index = 0;
-								}
-
+								temp_index=0;
 								break;
-							}
+							}//end 0x04
 						case 0x05:	//AC
 							{
-								temp_size = 2;	//Two phase matrix
+								if (kindex==0)	//A
+									temp_index=0;
+								else			//C
+									temp_index=2;
+								break;
+							}//end 0x05
+						case 0x06:	//AB
+							{
+								if (kindex==0)	//A
+									temp_index=0;
+								else			//B
+									temp_index=1;
+								break;
+							}//end 0x06
+						case 0x07:	//ABC
+							{
+								temp_index = kindex;	//Will loop all 3
+								break;
+							}//end 0x07
+					}//End switch/case
 
-								if (phase_workc==0x01)	//Line is phase C
-								{
-									//AC in the node, so offset by 1
-									temp_index = 1;
-								}
-								else if (phase_workc==0x02)	//Line is phase B
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-								else					//Has to be phase A
-								{
-									//AC in the node, so offset by 0
-									temp_index = 0;
-								}
+					if (temp_index==-1)	//Error check
+					{
+						NR_ASSEMBLY_THROW(chunk,"NR: A voltage index failed to be found.");
+						/*  TROUBLESHOOT
+						While attempting to compute the calculated power current, a voltage index failed to be
+						resolved.  Please submit your code and a bug report via the trac website.
+						*/
+					}
+
+					//Normal diagonal contributions
+					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus_V[temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus_V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus_V[temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus_V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+
+					//In-rush load contributions (if any) - only along explicit diagonal
+					if ((bus[indexer].full_Y_load != NULL) && (jindex==kindex))
+					{
+						tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (bus_V[temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (bus_V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+						tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (bus_V[temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (bus_V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+					}
 
+					//Off diagonal contributions
+					//Need another variable to handle the rows
+					temp_index_b = -1;
+					switch(bus[indexer].phases & 0x07) {
+						case 0x01:	//C
+							{
+								temp_index_b=2;
 								break;
-							}
+							}//end 0x01
+						case 0x02:	//B
+							{
+								temp_index_b=1;
+								break;
+							}//end 0x02
+						case 0x03:	//BC
+							{
+								if (jindex==0)	//B
+									temp_index_b=1;
+								else	//C
+									temp_index_b=2;
+								break;
+							}//end 0x03
+						case 0x04:	//A
+							{
+								temp_index_b=0;
+								break;
+							}//end 0x04
+						case 0x05:	//AC
+							{
+								if (jindex==0)	//A
+									temp_index_b=0;
+								else			//C
+									temp_index_b=2;
+								break;
+							}//end 0x05
 						case 0x06:	//AB
 							{
-								temp_size = 2;	//Two phase matrix
-
-								if (phase_workc==0x01)	//Line is phase C
-									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-								else if (phase_workc==0x02)	//Line is phase B
-								{
-									//BC in the node, so offset by 1
-									temp_index = 1;
-								}
-								else					//Has to be phase A
-								{
-									//AB in the node, so offset by 0
-									temp_index = 0;
-								}
-
+								if (jindex==0)	//A
+									temp_index_b=0;
+								else			//B
+									temp_index_b=1;
 								break;
-							}
+							}//end 0x06
 						case 0x07:	//ABC
 							{
-								temp_size = 3;	//Three phase matrix
+								temp_index_b = jindex;	//Will loop all 3
+								break;
+							}//end 0x07
+					}//End switch/case
 
-								if (phase_workc==0x01)	//Line is phase C
-								{
-									//ABC in the node, so offset by 2
-									temp_index = 2;
-								}
-								else if (phase_workc==0x02)	//Line is phase B
+					if (temp_index_b==-1)	//Error check
+					{
+						NR_ASSEMBLY_THROW(chunk,"NR: A voltage index failed to be found.");
+						/*  TROUBLESHOOT
+						While attempting to compute the calculated power current, a voltage index failed to be
+						resolved.  Please submit your code and a bug report via the trac website.
+						*/
+					}
+
+					for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)	//Parse through the branch list
+					{
+						//Apply proper index to jindexer (easier to implement this way)
+						jindexer=bus[indexer].Link_Table[kindexer];
+						branch_Yfrom = (packed != NULL) ? &packed->Yfrom[9*jindexer] : branch[jindexer].Yfrom;
+						branch_Yto = (packed != NULL) ? &packed->Yto[9*jindexer] : branch[jindexer].Yto;
+						from_V = (packed != NULL) ? &packed->V[3*branch[jindexer].from] : bus[branch[jindexer].from].V;
+						to_V = (packed != NULL) ? &packed->V[3*branch[jindexer].to] : bus[branch[jindexer].to].V;
+
+						if (branch[jindexer].from == indexer) 
+						{
+							//See if we're a triplex transformer (will only occur on the from side)
+							if ((branch[jindexer].phases & 0x80) == 0x80)	//Triplexy
+							{
+								proceed_flag = false;
+								phase_worka = branch[jindexer].phases & 0x07;
+
+								if (kindex==0)	//All of this will only occur the first column iteration
 								{
-									//ABC in the node, so offset by 1
-									temp_index = 1;
-								}
-								else					//Has to be phase A
+									switch (bus[indexer].phases & 0x07)	{
+										case 0x01:	//C
+											{
+												if (phase_worka==0x01)
+													proceed_flag=true;
+												break;
+											}//end 0x01
+										case 0x02:	//B
+											{
+												if (phase_worka==0x02)
+													proceed_flag=true;
+												break;
+											}//end 0x02
+										case 0x03:	//BC
+											{
+												if ((jindex==0) && (phase_worka==0x02))	//First row and is a B
+													proceed_flag=true;
+												else if ((jindex==1) && (phase_worka==0x01))	//Second row and is a C
+													proceed_flag=true;
+												else
+													;
+												break;
+											}//end 0x03
+										case 0x04:	//A
+											{
+												if (phase_worka==0x04)
+													proceed_flag=true;
+												break;
+											}//end 0x04
+										case 0x05:	//AC
+											{
+												if ((jindex==0) && (phase_worka==0x04))	//First row and is a A
+													proceed_flag=true;
+												else if ((jindex==1) && (phase_worka==0x01))	//Second row and is a C
+													proceed_flag=true;
+												else
+													;
+												break;
+											}//end 0x05
+										case 0x06:	//AB - shares with ABC
+										case 0x07:	//ABC 
+											{
+												if ((jindex==0) && (phase_worka==0x04))	//A & first row
+													proceed_flag=true;
+												else if ((jindex==1) && (phase_worka==0x02))	//B & second row
+													proceed_flag=true;
+												else if ((jindex==2) && (phase_worka==0x01))	//C & third row
+													proceed_flag=true;
+												else;
+												break;
+											}//end 0x07
+									}//end switch
+								}//End if kindex==0
+
+								if (proceed_flag)
 								{
-									//ABC in the node, so offset by 0
-									temp_index = 0;
-								}
+									work_vals_char_0 = temp_index_b*3;
+									//Do columns individually
+									//1
+									tempIcalcReal += (-(branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Re() - (-(branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(branch_Yfrom[work_vals_char_0])).Re() * (to_V[0]).Im() + (-(branch_Yfrom[work_vals_char_0])).Im() * (to_V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
-								break;
-							}
-						default:
-							GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
-							break;
-					}//end switch
-					if ((temp_index==-1) || (temp_size==-1))	//Should never get here
-						GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+									//2
+									tempIcalcReal += (-(branch_Yfrom[work_vals_char_0+1])).Re() * (to_V[1]).Re() - (-(branch_Yfrom[work_vals_char_0+1])).Im() * (to_V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(branch_Yfrom[work_vals_char_0+1])).Re() * (to_V[1]).Im() + (-(branch_Yfrom[work_vals_char_0+1])).Im() * (to_V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
-					//Determine first index
-					if (phase_workc==0x01)	//Line is phase C
-					{
-						jindex=2;
-					}//end line C if
-					else if (phase_workc==0x02)	//Line is phase B
-					{
-						jindex=1;
-					}//end line B if
-					else						//Line has to be phase A
-					{
-						jindex=0;
-					}//End line A if
+								}
+							}//end SPCT transformer
+							else	///Must be a standard line
+							{
+								work_vals_char_0 = temp_index_b*3+temp_index;
+								work_vals_double_0 = (-branch_Yfrom[work_vals_char_0]).Re();
+								work_vals_double_1 = (-branch_Yfrom[work_vals_char_0]).Im();
+								work_vals_double_2 = (to_V[temp_index]).Re();
+								work_vals_double_3 = (to_V[temp_index]).Im();
 
+								tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
-					//Indices counted out from Self admittance above.  needs doubling due to complex separation
-					for (kindex=0; kindex<2; kindex++)	//Loop through columns of admittance matrices (only 2x2)
+							}//end standard line
+						}	
+						if  (branch[jindexer].to == indexer)
+						{
+							work_vals_char_0 = temp_index_b*3+temp_index;
+							work_vals_double_0 = (-branch_Yto[work_vals_char_0]).Re();
+							work_vals_double_1 = (-branch_Yto[work_vals_char_0]).Im();
+							work_vals_double_2 = (from_V[temp_index]).Re();
+							work_vals_double_3 = (from_V[temp_index]).Im();
+
+							tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+							tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+						}
+						else;
+					}
+				}//end intermediate current for each phase column
+
+				//Determine how we are posting this update
+				if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))	//SWING bus is different (when it really is a SWING bus)
+				{
+					if ((powerflow_type == PF_DYNINIT) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
 					{
+						//Compute our "power generated" value for this phase - conjugated in formation
+						temp_complex_2 = bus_V[jindex] * complex(tempIcalcReal,-tempIcalcImag);
 
-						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+						if (Iteration>0)	//Only update SWING on subsequent passes
 						{
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
-							indexer += 1;
-							
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
-							indexer += 1;
+							//Now add it into the "generation total" for the SWING
+							(*bus[indexer].PGenTotal) += temp_complex_2 - temp_complex_3/3.0; // both PT and QT = Ssource-Sysource = v conj(I) - v conj(ysource v)
 						}
+							
+						//Compute the delta_I, just like below - but don't post it (still zero in calcs)
+						work_vals_double_0 = (bus_V[temp_index_b]).Mag()*(bus_V[temp_index_b]).Mag();
 
-						if (((branch[jindexer].Yto[kindex*3+jindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+						if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 						{
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Im());
-							indexer += 1;
-							
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[kindex*3+jindex]).Im();
-							indexer += 1;
-						}
+							work_vals_double_1 = (bus_V[temp_index_b]).Re();
+							work_vals_double_2 = (bus_V[temp_index_b]).Im();
+							work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
+							work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 
-						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+							//Form a magnitude value - put in work_vals_double_0, since we're done with it
+							work_vals_double_0 = sqrt((work_vals_double_3*work_vals_double_3+work_vals_double_4*work_vals_double_4));
+						}
+						else	//Would give us a NAN, so it must be out of service or something (case from below - really shouldn't apply to SWING)
 						{
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-							indexer += 1;
-							
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
-							indexer += 1;	
+           						work_vals_double_0 = 0.0;	//Assumes "converged"
 						}
-
-						if (((branch[jindexer].Yto[kindex*3+jindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
+						
+						if (work_vals_double_0 > bus[indexer].max_volt_error)	//Failure check (defaults to voltage convergence for now)
 						{
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Re());
-							indexer += 1;
-							
-							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex;
-							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
-							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Re());
-							indexer += 1;	
+							chunk->swing_converged=false;
 						}
-					}//secondary index end
+					}//End PF_DYNINIT SWING traversion
 
-				}//end to triplexy
-			}//end triplex in here
-			else					//Some combination of not-3 phase
-			{
-				//Clear working variables, just in case
-				temp_index = temp_index_b = -1;
-				temp_size = temp_size_b = temp_size_c = -1;
-				Full_Mat_A = Full_Mat_B = false;
+					//Effectively Zero out the components, regardless of normal run or not
+					//Should already be zerod, but do it again for paranoia sake
+					if (NR_busdata[indexer].BusHistTerm != NULL)	//See if we're "delta-capable"
+					{
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Re();
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Im();
+					}
+					else
+					{
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
+					}
 
-				//Intermediate store the admittance matrices so they can be directly indexed later
-				switch(branch[jindexer].phases & 0x07) {
-					case 0x00:	//No phases (open switch or reliability excluded item)
+					//Saturation skipped for "swing is a swing" case, since it doesn't affect the admittance (no need to offset)
+				}//End SWING bus cases
+				else	//PQ bus or SWING masquerading as a PQ
+				{
+					work_vals_double_0 = (bus_V[temp_index_b]).Mag()*(bus_V[temp_index_b]).Mag();
+
+					if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
+					{
+						work_vals_double_1 = (bus_V[temp_index_b]).Re();
+						work_vals_double_2 = (bus_V[temp_index_b]).Im();
+
+						//See if deltamode needs to include extra term
+						if (NR_busdata[indexer].BusHistTerm != NULL)
 						{
-							temp_size_c = -99;	//Arbitrary flag
-							break;
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) + NR_busdata[indexer].BusHistTerm[jindex].Re() - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) + NR_busdata[indexer].BusHistTerm[jindex].Im() - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 						}
-					case 0x01:	//C only
+						else	//Nope
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[8];
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[8];
-							temp_size_c = 1;
-							break;
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 						}
-					case 0x02:	//B only
+
+						//Accumulate in any saturation current values as well, while we're here
+						if (NR_busdata[indexer].BusSatTerm != NULL)
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[4];
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[4];
-							temp_size_c = 1;
-							break;
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Re();
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Im();
 						}
-					case 0x03:	//BC only
+					}
+					else
+					{
+						if (NR_busdata[indexer].BusHistTerm != NULL)	//See if extra deltamode term needs to be included
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[4];
-							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[5];
-							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[7];
-							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[8];
-							
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[4];
-							Temp_Ad_B[0][1] = branch[jindexer].Yto[5];
-							Temp_Ad_B[1][0] = branch[jindexer].Yto[7];
-							Temp_Ad_B[1][1] = branch[jindexer].Yto[8];
-
-							temp_size_c = 2;
-							break;
+           						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Re();
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Im();
 						}
-					case 0x04:	//A only
+						else
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
-							temp_size_c = 1;
-							break;
+           						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
 						}
-					case 0x05:	//AC only
+
+						//Accumulate in any saturation current values as well, while we're here
+						if (NR_busdata[indexer].BusSatTerm != NULL)
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
-							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[2];
-							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[6];
-							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[8];
-							
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
-							Temp_Ad_B[0][1] = branch[jindexer].Yto[2];
-							Temp_Ad_B[1][0] = branch[jindexer].Yto[6];
-							Temp_Ad_B[1][1] = branch[jindexer].Yto[8];
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Re();
+							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Im();
+						}
+					}
+				}//End normal bus handling
+			}//End three-phase or variant thereof
+		}//End delta_I for each phase row
 
-							temp_size_c = 2;
-							break;
+		//Add in generator current amounts, if relevant
+		if (powerflow_type != PF_NORMAL)
+		{
+			//Secondary check - see if it is even needed - basically built around 3-phase right now (checks)
+			if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+			{
+				if ((bus[indexer].phases & 0x07) == 0x07)	//Make sure is three-phase
+				{
+					//Only update in particular mode - SWING bus values should still be treated as such
+					if ((swing_is_a_swing == true) && (powerflow_type == PF_DYNINIT))	//Really only true for PF_DYNINIT anyways
+					{
+						//Power should be all updated, now update current values
+						temp_complex_0 += complex((*bus[indexer].PGenTotal).Re(),-(*bus[indexer].PGenTotal).Im()); // total generated power injected congugated
+
+						//Compute Ii
+						if (temp_complex_1.Mag() > 0.0)	//Non zero
+						{
+							temp_complex_2 = temp_complex_0/temp_complex_1;	//Forms Ii
+
+							//Now convert Ii to the individual phase amounts
+							bus[indexer].DynCurrent[0] = temp_complex_2;
+							bus[indexer].DynCurrent[1] = temp_complex_2*avalsq;
+							bus[indexer].DynCurrent[2] = temp_complex_2*aval;
 						}
-					case 0x06:	//AB only
+						else	//Must make zero
 						{
-							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
-							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[1];
-							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[3];
-							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[4];
-							
-							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
-							Temp_Ad_B[0][1] = branch[jindexer].Yto[1];
-							Temp_Ad_B[1][0] = branch[jindexer].Yto[3];
-							Temp_Ad_B[1][1] = branch[jindexer].Yto[4];
-
-							temp_size_c = 2;
-							break;
-						}
-					default:
-						{
-							break;
+							bus[indexer].DynCurrent[0] = complex(0.0,0.0);
+							bus[indexer].DynCurrent[1] = complex(0.0,0.0);
+							bus[indexer].DynCurrent[2] = complex(0.0,0.0);
 						}
-				}//end line switch/case
+					}//End SWING is still swing, otherwise should just accumulate what it had
 
-				if (temp_size_c==-99)
+					//Don't get added in as part of "normal swing" routine
+					if ((bus[indexer].type == 0) || ((bus[indexer].type>1) && (bus[indexer].swing_functions_enabled == false)))
+					{
+						//Add these into the system - added because "generation"
+       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size] += bus[indexer].DynCurrent[0].Re();		//Phase A
+       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + 1] += bus[indexer].DynCurrent[1].Re();	//Phase B
+       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + 2] += bus[indexer].DynCurrent[2].Re();	//Phase C
+
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc] += bus[indexer].DynCurrent[0].Im();		//Phase A
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + 1] += bus[indexer].DynCurrent[1].Im();	//Phase B
+						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + 2] += bus[indexer].DynCurrent[2].Im();	//Phase C
+					}
+					//Defaulted else - leave as they were
+				}//End three-phase
+				else	//Not three-phase athe moment
 				{
-					continue;	//Next iteration of branch loop
+					//See if we ever were (reliability call)
+					if ((bus[indexer].origphases & 0x07) == 0x07)
+					{
+						//Just zero it
+						bus[indexer].DynCurrent[0] = complex(0.0,0.0);
+						bus[indexer].DynCurrent[1] = complex(0.0,0.0);
+						bus[indexer].DynCurrent[2] = complex(0.0,0.0);
+					}
+					else	//Never was, just fail out
+					{
+						NR_ASSEMBLY_THROW(chunk,"NR_solver: bus:%s has tried updating deltamode dyanmics, but is not three-phase!",bus[indexer].name);
+						/*  TROUBLESHOOT
+						The NR_solver routine tried update a three-phase current value for a bus that is not
+						three phase.  At this time, the deltamode system only supports three-phase buses for
+						generator attachment.
+						*/
+					}
 				}
+			}//End extra current adds
+		}//End dynamic (generator postings)
+	}//End delta_I for each bus
+}
 
-				if (temp_size_c==-1)	//Make sure it is right
+//Jacobian update elements a,b,c,d of equations (14),(15),(16),(17) for one bus range
+static void solver_nr_jacobian_range(NR_ASSEMBLY_CHUNK *chunk)
+{
+	BUSDATA *bus = chunk->data->bus;
+	NR_SOLVER_STRUCT *powerflow_values = chunk->data->powerflow_values;
+	NR_PACKED_STORAGE *packed = chunk->data->packed;
+	complex *bus_V, *bus_S, *bus_Y, *bus_I, *bus_S_dy, *bus_Y_dy, *bus_I_dy;
+	unsigned int indexer;
+	char jindex;
+	char temp_index, temp_index_b;
+
+	//Temporary load calculation variables
+	complex undeltacurr[3];
+	complex delta_current[3], voltageDel[3];
+	complex temp_current[3], temp_store[3];
+	complex adjusted_constant_current[6];
+	complex adjust_temp_nominal_voltage[6];
+	double adjust_temp_voltage_mag[6];
+	double adjust_nominal_voltage_val, adjust_nominal_voltaged_val;
+
+	for (indexer=chunk->bus_start; indexer<chunk->bus_end; indexer++)
+	{
+		//Read the packed copies directly when they are in use
+		bus_V = (packed != NULL) ? &packed->V[3*indexer] : bus[indexer].V;
+		bus_S = (packed != NULL) ? &packed->S[3*indexer] : bus[indexer].S;
+		bus_Y = (packed != NULL) ? &packed->Y[3*indexer] : bus[indexer].Y;
+		bus_I = (packed != NULL) ? &packed->I[3*indexer] : bus[indexer].I;
+		bus_S_dy = (packed != NULL) ? &packed->S_dy[6*indexer] : bus[indexer].S_dy;
+		bus_Y_dy = (packed != NULL) ? &packed->Y_dy[6*indexer] : bus[indexer].Y_dy;
+		bus_I_dy = (packed != NULL) ? &packed->I_dy[6*indexer] : bus[indexer].I_dy;
+
+		if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
+		{
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
+			{
+				//Create nominal magnitudes
+				adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+
+				//Compute delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+
+				//Start adjustments - AB
+				if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
 				{
-					GL_THROW("NR: A line's phase was flagged as not full three-phase, but wasn't");
-					/*  TROUBLESHOOT
-					A line inside the powerflow model was flagged as not being full three-phase or
-					triplex in any form.  It failed the other cases though, so it must have been.
-					Please submit your code and a bug report to the trac website.
-					*/
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[0] = 0.0;
 				}
 
-				//Check the from side and get all appropriate offsets
-				switch(bus[tempa].phases & 0x07) {
+				//Start adjustments - BC
+				if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
+				}
+
+				//Start adjustments - CA
+				if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
+
+				//See if we have any "different children"
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Create nominal magnitudes
+					adjust_nominal_voltage_val = bus[indexer].volt_base;
+
+					//Create the nominal voltage vectors
+					adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+					adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+
+					//Get magnitudes of all
+					adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+					adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+					adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+					//Start adjustments - A
+					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[3] = 0.0;
+					}
+
+					//Start adjustments - B
+					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[4] = 0.0;
+					}
+
+					//Start adjustments - C
+					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[5] = 0.0;
+					}
+				}
+				else	//Nope
+				{
+					//Set to zero, just cause
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}
+			else	//"Normal" modes -- handle traditionally
+			{
+				adjusted_constant_current[0] = bus_I[0];
+				adjusted_constant_current[1] = bus_I[1];
+				adjusted_constant_current[2] = bus_I[2];
+
+				//See if we have different children too
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Store them too
+					adjusted_constant_current[3] = bus[indexer].extra_var[6];
+					adjusted_constant_current[4] = bus[indexer].extra_var[7];
+					adjusted_constant_current[5] = bus[indexer].extra_var[8];
+				}
+				else	//Nope, just zero this for now
+				{
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}//End adjustment code
+
+			//Delta components - populate according to what is there
+			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+			{
+				//Voltage calculations
+				voltageDel[0] = bus_V[0] - bus_V[1];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S[0]/voltageDel[0]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[0] += voltageDel[0] * (bus_Y[0]);
+
+			}
+			else
+			{
+				//Zero values - they shouldn't be used anyhow
+				voltageDel[0] = 0.0;
+				delta_current[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+			{
+				//Voltage calculations
+				voltageDel[1] = bus_V[1] - bus_V[2];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S[1]/voltageDel[1]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[1] += voltageDel[1] * (bus_Y[1]);
+
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[1] = 0.0;
+				delta_current[1] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+			{
+				//Voltage calculations
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S[2]/voltageDel[2]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[2] += voltageDel[2] * (bus_Y[2]);
+
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[2] = 0.0;
+				delta_current[2] = 0.0;
+			}
+			
+			//Convert delta-current into a phase current, where appropriate - reuse temp variable
+			//Everything will be accumulated into the "current" field for ease (including differents)
+			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+			{
+				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+				{
+					//Power values
+					undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus_V[0]);
+
+					//Shunt values
+					undeltacurr[0] += bus[indexer].extra_var[3]*bus_V[0];
+
+					//Current values
+					undeltacurr[0] += adjusted_constant_current[3];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			{
+				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+				{
+					//Power values
+					undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus_V[1]);
+
+					//Shunt values
+					undeltacurr[1] += bus[indexer].extra_var[4]*bus_V[1];
+
+					//Current values
+					undeltacurr[1] += adjusted_constant_current[4];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[1] = 0.0;
+			}
+
+
+			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+			{
+				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+
+				//Check for "different" children and apply them, as well
+				if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
+				{
+					//Power values
+					undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus_V[2]);
+
+					//Shunt values
+					undeltacurr[2] += bus[indexer].extra_var[5]*bus_V[2];
+
+					//Current values
+					undeltacurr[2] += adjusted_constant_current[5];
+				}
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[2] = 0.0;
+			}
+
+			//Provide updates to relevant phases
+			//only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
 					case 0x01:	//C
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_size = 1;		//Single size
-								temp_index = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-								/*  TROUBLESHOOT
-								One of the lines in the powerflow model has an invalid phase in
-								reference to its to and from ends.  This should have been caught
-								earlier, so submit your code and a bug report using the trac website.
-								*/
-							}
+							temp_index=0;
+							temp_index_b=2;
 							break;
-						}//end 0x01
+						}
 					case 0x02:	//B
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_size = 1;		//Single size
-								temp_index = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
+							temp_index=0;
+							temp_index_b=1;
 							break;
-						}//end 0x02
+						}
 					case 0x03:	//BC
 						{
-							temp_size = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							if (jindex==0)	//B
 							{
-								temp_index = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_index = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
-							{
-								temp_index = 0;
+								temp_index=0;
+								temp_index_b=1;
 							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x03
+						}
 					case 0x04:	//A
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_size = 1;		//Single size
-								temp_index = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
+							temp_index=0;
+							temp_index_b=0;
 							break;
-						}//end 0x04
+						}
 					case 0x05:	//AC
 						{
-							temp_size = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							if (jindex==0)	//A
 							{
-								temp_index = 1;		//offset
+								temp_index=0;
+								temp_index_b=0;
 							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_index = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
-							{
-								temp_index = 0;
-							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x05
+						}
 					case 0x06:	//AB
-						{
-							temp_size = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_index = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_index = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
-							{
-								temp_index = 0;
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
-							break;
-						}//end 0x06
 					case 0x07:	//ABC
 						{
-							temp_size = 3;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_index = 2;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_index = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
-							{
-								temp_index = 1;
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_index = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
-							{
-								temp_index = 0;
-								Full_Mat_A = true;		//Flag so we know C needs to be gapped
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
-							{
-								temp_index = 0;
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
-							break;
-						}//end 0x07
-					default:
-						{
+							temp_index=jindex;
+							temp_index_b=jindex;
 							break;
 						}
-				}//End switch/case for from
+					default:
+						break;
+				}//end case
 
-				//Check the to side and get all appropriate offsets
-				switch(bus[tempb].phases & 0x07) {
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A Jacobian update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the "dynamic" portions of the
+					Jacobian matrix that encompass attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
+
+				if ((bus_V[temp_index_b]).Mag()!=0)
+				{
+					bus[indexer].Jacob_A[temp_index] = ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
+					bus[indexer].Jacob_B[temp_index] = -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
+					bus[indexer].Jacob_C[temp_index] =((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
+					bus[indexer].Jacob_D[temp_index] = ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
+				}
+				else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
+				{
+					bus[indexer].Jacob_A[temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+					bus[indexer].Jacob_B[temp_index] = -1e-4;
+					bus[indexer].Jacob_C[temp_index] = -1e-4;
+					bus[indexer].Jacob_D[temp_index] = -1e-4;
+				}
+			}//End phase traversion
+		}//end delta-connected load
+		else if	((bus[indexer].phases & 0x80) == 0x80)	//Split phase computations
+		{
+			//Convert it all back to current (easiest to handle)
+			//Get V12 first
+			voltageDel[0] = bus_V[0] + bus_V[1];
+
+			//Start with the currents (just put them in)
+			temp_current[0] = bus_I[0];
+			temp_current[1] = bus_I[1];
+			temp_current[2] = *bus[indexer].extra_var; //current12 is not part of the standard current array
+
+			//Add in deltamode unrotated, if necessary
+			if ((bus[indexer].prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
+				temp_current[2] += bus[indexer].prerot_I[2];
+
+			//Now add in power contributions
+			temp_current[0] += bus_V[0] == 0.0 ? 0.0 : ~(bus_S[0]/bus_V[0]);
+			temp_current[1] += bus_V[1] == 0.0 ? 0.0 : ~(bus_S[1]/bus_V[1]);
+			temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus_S[2]/voltageDel[0]);
+
+			//Last, but not least, admittance/impedance contributions
+			temp_current[0] += bus_Y[0]*bus_V[0];
+			temp_current[1] += bus_Y[1]*bus_V[1];
+			temp_current[2] += bus_Y[2]*voltageDel[0];
+
+			//See if we are a house-connected node, if so, adjust and add in those values as well
+			if ((bus[indexer].phases & 0x40) == 0x40)
+			{
+				//Update phase adjustments
+				temp_store[0].SetPolar(1.0,bus_V[0].Arg());	//Pull phase of V1
+				temp_store[1].SetPolar(1.0,bus_V[1].Arg());	//Pull phase of V2
+				temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
+
+				//Update these current contributions (use delta current variable, it isn't used in here anyways)
+				delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
+				delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
+				delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
+
+				//Now add it into the current contributions
+				temp_current[0] += delta_current[0];
+				temp_current[1] += delta_current[1];
+				temp_current[2] += delta_current[2];
+			}//End house-attached splitphase
+
+			//Convert 'em to line currents - they need to be negated (due to the convention from earlier)
+			temp_store[0] = -(temp_current[0] + temp_current[2]);
+			temp_store[1] = -(-temp_current[1] - temp_current[2]);
+
+			for (jindex=0; jindex<2; jindex++)
+			{
+				if ((bus_V[jindex]).Mag()!=0)	//Only current
+				{
+					bus[indexer].Jacob_A[jindex] = ((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus_V[jindex]).Im(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(37)
+					bus[indexer].Jacob_B[jindex] = -((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus_V[jindex]).Re(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(38)
+					bus[indexer].Jacob_C[jindex] =((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus_V[jindex]).Im(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(39)
+					bus[indexer].Jacob_D[jindex] = ((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus_V[jindex]).Re(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(40)
+				}
+				else
+				{
+					bus[indexer].Jacob_A[jindex]=  -1e-4;	//Put very small to avoid singularity issues
+					bus[indexer].Jacob_B[jindex]=  -1e-4;
+					bus[indexer].Jacob_C[jindex]=  -1e-4;
+					bus[indexer].Jacob_D[jindex]=  -1e-4;
+				}
+			}
+
+			//Zero the last elements, just to be safe (shouldn't be an issue, but who knows)
+			bus[indexer].Jacob_A[2] = 0.0;
+			bus[indexer].Jacob_B[2] = 0.0;
+			bus[indexer].Jacob_C[2] = 0.0;
+			bus[indexer].Jacob_D[2] = 0.0;
+
+		}//end split-phase connected
+		else	//Wye-connected system/load
+		{
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
+			{
+				//Create nominal magnitudes
+				adjust_nominal_voltage_val = bus[indexer].volt_base;
+
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+				adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+				adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+				adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+				adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+				//Start adjustments - A
+				if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus_I[0] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[0] = 0.0;
+				}
+
+				//Start adjustments - B
+				if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus_I[1] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
+				}
+
+				//Start adjustments - C
+				if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus_I[2] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
+
+				if (bus[indexer].prerot_I[0] != 0.0)
+					adjusted_constant_current[0] += bus[indexer].prerot_I[0];
+
+				if (bus[indexer].prerot_I[1] != 0.0)
+					adjusted_constant_current[1] += bus[indexer].prerot_I[1];
+
+				if (bus[indexer].prerot_I[2] != 0.0)
+					adjusted_constant_current[2] += bus[indexer].prerot_I[2];
+
+				//See if we have any "different children"
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Create nominal magnitudes
+					adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+
+					//Create the nominal voltage vectors
+					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+
+					//Compute delta voltages
+					voltageDel[0] = bus_V[0] - bus_V[1];
+					voltageDel[1] = bus_V[1] - bus_V[2];
+					voltageDel[2] = bus_V[2] - bus_V[0];
+
+					//Get magnitudes of all
+					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+
+					//Start adjustments - AB
+					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[3] = 0.0;
+					}
+
+					//Start adjustments - BC
+					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[4] = 0.0;
+					}
+
+					//Start adjustments - CA
+					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+					{
+						//calculate new value
+						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+					}
+					else
+					{
+						adjusted_constant_current[5] = 0.0;
+					}
+				}
+				else	//Nope
+				{
+					//Set to zero, just cause
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}
+			else	//"Normal" modes -- handle traditionally
+			{
+				adjusted_constant_current[0] = bus_I[0];
+				adjusted_constant_current[1] = bus_I[1];
+				adjusted_constant_current[2] = bus_I[2];
+
+				//See if we have different children too
+				if ((bus[indexer].phases & 0x10) == 0x10)
+				{
+					//Store them too
+					adjusted_constant_current[3] = bus[indexer].extra_var[6];
+					adjusted_constant_current[4] = bus[indexer].extra_var[7];
+					adjusted_constant_current[5] = bus[indexer].extra_var[8];
+				}
+				else	//Nope, just zero this for now
+				{
+					adjusted_constant_current[3] = 0.0;
+					adjusted_constant_current[4] = 0.0;
+					adjusted_constant_current[5] = 0.0;
+				}
+			}//End adjustment code
+
+			//For Wye-connected, only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
+			{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
+				//Make sure phase combinations exist
+				if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
+				{
+				//Delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+
+					//Power - put into a current value (iterates less this way)
+					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
+
+					//Convert delta connected load to appropriate Wye 
+					delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					voltageDel[0] = 0.0;
+					delta_current[0] = 0.0;
+				}
+
+				//Check for BC
+				if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
+				{
+					//Delta voltages
+					voltageDel[1] = bus_V[1] - bus_V[2];
+
+					//Power - put into a current value (iterates less this way)
+					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
+
+					//Convert delta connected load to appropriate Wye 
+					delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					voltageDel[1] = 0.0;
+					delta_current[1] = 0.0;
+				}
+
+				//Check for CA
+				if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
+				{
+					//Delta voltages
+					voltageDel[2] = bus_V[2] - bus_V[0];
+
+					//Power - put into a current value (iterates less this way)
+					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
+
+					//Convert delta connected load to appropriate Wye 
+					delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
+				}
+				else
+				{
+					//Zero it, for good measure
+					voltageDel[2] = 0.0;
+					delta_current[2] = 0.0;
+				}
+
+				//Convert delta-current into a phase current - reuse temp variable
+				undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
+				undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
+				undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
+			}
+			else	//zero the variable so we don't have excessive ifs
+			{
+				undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = 0.0;	//Zero it
+			}
+
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
 					case 0x01:	//C
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_size_b = 1;		//Single size
-								temp_index_b = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-								/*  TROUBLESHOOT
-								One of the lines in the powerflow model has an invalid phase in
-								reference to its to and from ends.  This should have been caught
-								earlier, so submit your code and a bug report using the trac website.
-								*/
-							}
+							temp_index=0;
+							temp_index_b=2;
 							break;
-						}//end 0x01
+						}
 					case 0x02:	//B
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_size_b = 1;		//Single size
-								temp_index_b = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
+							temp_index=0;
+							temp_index_b=1;
 							break;
-						}//end 0x02
+						}
 					case 0x03:	//BC
 						{
-							temp_size_b = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_index_b = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_index_b = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
+							if (jindex==0)	//B
 							{
-								temp_index_b = 0;
+								temp_index=0;
+								temp_index_b=1;
 							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x03
+						}
 					case 0x04:	//A
 						{
-							if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_size_b = 1;		//Single size
-								temp_index_b = 0;		//No offset (only 1 big)
-							}
-							else
-							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
-							}
+							temp_index=0;
+							temp_index_b=0;
 							break;
-						}//end 0x04
+						}
 					case 0x05:	//AC
 						{
-							temp_size_b = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_index_b = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
-							{
-								temp_index_b = 0;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							if (jindex==0)	//A
 							{
-								temp_index_b = 0;
+								temp_index=0;
+								temp_index_b=0;
 							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x05
+						}
 					case 0x06:	//AB
+					case 0x07:	//ABC
 						{
-							temp_size_b = 2;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							temp_index=jindex;
+							temp_index_b=jindex;
+							break;
+						}
+					default:
+						break;
+				}//end case
+
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A Jacobian update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the "dynamic" portions of the
+					Jacobian matrix that encompass attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
+
+				if ((bus_V[temp_index_b]).Mag()!=0)
+				{
+					bus[indexer].Jacob_A[temp_index] = ((bus_S[temp_index_b]).Im() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Re())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(37)
+					bus[indexer].Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3) + (bus_Y[temp_index_b]).Im();// second part of equation(37)
+					bus[indexer].Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
+					
+					bus[indexer].Jacob_B[temp_index] = ((bus_S[temp_index_b]).Re() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) + 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Im())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(38)
+					bus[indexer].Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Re();// second part of equation(38)
+					bus[indexer].Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
+					
+					bus[indexer].Jacob_C[temp_index] = ((bus_S[temp_index_b]).Re() * (pow((bus_V[temp_index_b]).Im(),2) - pow((bus_V[temp_index_b]).Re(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Im())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(39)
+					bus[indexer].Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Re();// second part of equation(39)
+					bus[indexer].Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
+					
+					bus[indexer].Jacob_D[temp_index] = ((bus_S[temp_index_b]).Im() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Re())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(40)
+					bus[indexer].Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Im();// second part of equation(40)
+					bus[indexer].Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
+				
+				}
+				else
+				{
+					bus[indexer].Jacob_A[temp_index]= (bus_Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
+					bus[indexer].Jacob_B[temp_index]= -(bus_Y[temp_index_b]).Re() - 1e-4;
+					bus[indexer].Jacob_C[temp_index]= -(bus_Y[temp_index_b]).Re() - 1e-4;
+					bus[indexer].Jacob_D[temp_index]= -(bus_Y[temp_index_b]).Im() - 1e-4;
+				}
+			}//End phase traversion - Wye
+		}//End wye-connected load
+
+		//Perform delta/wye explicit load updates -- no triplex
+		if ((bus[indexer].phases & 0x80) != 0x80)	//Not triplex
+		{
+			//Delta components - populate according to what is there
+			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+			{
+				//Voltage calculations
+				voltageDel[0] = bus_V[0] - bus_V[1];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S_dy[0]/voltageDel[0]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[0] += voltageDel[0] * (bus_Y_dy[0]);
+
+			}
+			else
+			{
+				//Zero values - they shouldn't be used anyhow
+				voltageDel[0] = 0.0;
+				delta_current[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+			{
+				//Voltage calculations
+				voltageDel[1] = bus_V[1] - bus_V[2];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S_dy[1]/voltageDel[1]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[1] += voltageDel[1] * (bus_Y_dy[1]);
+
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[1] = 0.0;
+				delta_current[1] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+			{
+				//Voltage calculations
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Power - convert to a current (uses less iterations this way)
+				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S_dy[2]/voltageDel[2]);
+
+				//Convert delta connected load to appropriate Wye
+				delta_current[2] += voltageDel[2] * (bus_Y_dy[2]);
+
+			}
+			else
+			{
+				//Zero unused
+				voltageDel[2] = 0.0;
+				delta_current[2] = 0.0;
+			}
+
+			//Populate the values for constant current -- deltamode different right now (all same in future?)
+			if (*bus[indexer].dynamics_enabled == true)
+			{
+				//Create line-line nominal magnitude
+				adjust_nominal_voltage_val = bus[indexer].volt_base;
+				adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
+
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
+				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
+				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
+				adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
+				adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
+				adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
+
+				//Compute delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
+
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+				adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+				adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+				adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+				//Start adjustments - A
+				if ((bus_I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus_I_dy[3] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[3] = 0.0;
+				}
+
+				//Start adjustments - B
+				if ((bus_I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus_I_dy[4] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[4] = 0.0;
+				}
+
+				//Start adjustments - C
+				if ((bus_I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus_I_dy[5] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+				}
+				else
+				{
+					adjusted_constant_current[5] = 0.0;
+				}
+
+				//Start adjustments - AB
+				if ((bus_I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[0] = 0.0;
+				}
+
+				//Start adjustments - BC
+				if ((bus_I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[1] = 0.0;
+				}
+
+				//Start adjustments - CA
+				if ((bus_I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
+				}
+				else
+				{
+					adjusted_constant_current[2] = 0.0;
+				}
+			}//End deltamode adjustment
+			else	//Normal mode
+			{
+				//Just copy the values in
+				adjusted_constant_current[0] = bus_I_dy[0];
+				adjusted_constant_current[1] = bus_I_dy[1];
+				adjusted_constant_current[2] = bus_I_dy[2];
+				adjusted_constant_current[3] = bus_I_dy[3];
+				adjusted_constant_current[4] = bus_I_dy[4];
+				adjusted_constant_current[5] = bus_I_dy[5];
+			}
+
+			//Convert delta-current into a phase current, where appropriate - reuse temp variable
+			//Everything will be accumulated into the "current" field for ease (including differents)
+			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+			{
+				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+
+				//Apply wye-connected loads
+
+				//Power values
+				undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus_S_dy[3]/bus_V[0]);
+
+				//Shunt values
+				undeltacurr[0] += bus_Y_dy[3]*bus_V[0];
+
+				//Current values
+				undeltacurr[0] += adjusted_constant_current[3];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[0] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			{
+				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+
+				//Apply wye-connected loads
+
+				//Power values
+				undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus_S_dy[4]/bus_V[1]);
+
+				//Shunt values
+				undeltacurr[1] += bus_Y_dy[4]*bus_V[1];
+
+				//Current values
+				undeltacurr[1] += adjusted_constant_current[4];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[1] = 0.0;
+			}
+
+			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+			{
+				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+
+				//Apply wye-connected loads
+
+				//Power values
+				undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus_S_dy[5]/bus_V[2]);
+
+				//Shunt values
+				undeltacurr[2] += bus_Y_dy[5]*bus_V[2];
+
+				//Current values
+				undeltacurr[2] += adjusted_constant_current[5];
+			}
+			else
+			{
+				//Zero it, just in case
+				undeltacurr[2] = 0.0;
+			}
+
+			//Provide updates to relevant phases
+			//only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
+					case 0x01:	//C
+						{
+							temp_index=0;
+							temp_index_b=2;
+							break;
+						}
+					case 0x02:	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+							break;
+						}
+					case 0x03:	//BC
+						{
+							if (jindex==0)	//B
 							{
-								temp_index_b = 1;		//offset
+								temp_index=0;
+								temp_index_b=1;
 							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							else			//C
 							{
-								temp_index_b = 0;		//offset
+								temp_index=1;
+								temp_index_b=2;
 							}
-							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							break;
+						}
+					case 0x04:	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+							break;
+						}
+					case 0x05:	//AC
+						{
+							if (jindex==0)	//A
 							{
-								temp_index_b = 0;
+								temp_index=0;
+								temp_index_b=0;
 							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x06
+						}
+					case 0x06:	//AB
 					case 0x07:	//ABC
 						{
-							temp_size_b = 3;	//Size of this matrix's admittance
-							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
-							{
-								temp_index_b = 2;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
-							{
-								temp_index_b = 1;		//offset
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
-							{
-								temp_index_b = 1;
-							}
-							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							temp_index=jindex;
+							temp_index_b=jindex;
+							break;
+						}
+					default:
+						break;
+				}//end case
+
+				if ((temp_index==-1) || (temp_index_b==-1))
+				{
+					NR_ASSEMBLY_THROW(chunk,"NR: A Jacobian update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the "dynamic" portions of the
+					Jacobian matrix that encompass attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
+				}
+
+				if ((bus_V[temp_index_b]).Mag()!=0)
+				{
+					//Apply as an accumulation, in case any "normal" connections are present too
+					bus[indexer].Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
+					bus[indexer].Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
+					bus[indexer].Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
+					bus[indexer].Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
+				}
+				else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
+				{
+					bus[indexer].Jacob_A[temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+					bus[indexer].Jacob_B[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+					bus[indexer].Jacob_C[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+					bus[indexer].Jacob_D[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
+				}
+
+			}//End phase traversion
+		}//End delta/wye explicit loads
+
+		//Delta load components  get added to the Jacobian values too -- mostly because this is the most convenient place to do it
+		//See if we're even needed first
+		if (bus[indexer].full_Y_load != NULL)
+		{
+			//Provide updates to relevant phases
+			//only compute and store phases that exist (make top heavy)
+			temp_index = -1;
+			temp_index_b = -1;
+			
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				switch(bus[indexer].phases & 0x07) {
+					case 0x01:	//C
+						{
+							temp_index=0;
+							temp_index_b=2;
+							break;
+						}
+					case 0x02:	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+							break;
+						}
+					case 0x03:	//BC
+						{
+							if (jindex==0)	//B
 							{
-								temp_index_b = 0;		//offset
+								temp_index=0;
+								temp_index_b=1;
 							}
-							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							else			//C
 							{
-								temp_index_b = 0;
-								Full_Mat_B = true;		//Flag so we know C needs to be gapped
+								temp_index=1;
+								temp_index_b=2;
 							}
-							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							break;
+						}
+					case 0x04:	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+							break;
+						}
+					case 0x05:	//AC
+						{
+							if (jindex==0)	//A
 							{
-								temp_index_b = 0;
+								temp_index=0;
+								temp_index_b=0;
 							}
-							else
+							else			//C
 							{
-								GL_THROW("NR: One of the lines has invalid phase parameters");
+								temp_index=1;
+								temp_index_b=2;
 							}
 							break;
-						}//end 0x07
-					default:
+						}
+					case 0x06:	//AB
+					case 0x07:	//ABC
 						{
+							temp_index=jindex;
+							temp_index_b=jindex;
 							break;
 						}
-				}//End switch/case for to
+					default:
+						break;
+				}//end case
 
-				//Make sure everything was set before proceeding
-				if ((temp_index==-1) || (temp_index_b==-1) || (temp_size==-1) || (temp_size_b==-1) || (temp_size_c==-1))
+				if ((temp_index==-1) || (temp_index_b==-1))
 				{
-					GL_THROW("NR: Failure to construct single/double phase line indices");
+					NR_ASSEMBLY_THROW(chunk,"NR: A Jacobian update element failed.");
 					/*  TROUBLESHOOT
-					A single or double phase line (e.g., just A or AB) has failed to properly initialize all of the indices
-					necessary to form the admittance matrix.  Please submit a bug report, with your code, to the trac site.
+					While attempting to calculate the "dynamic" portions of the
+					Jacobian matrix that encompass attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
 					*/
 				}
 
-				if (Full_Mat_A)	//From side is a full ABC and we have AC
-				{
-					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
-					{
-						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
-						{
-							//Indices counted out from Self admittance above.  needs doubling due to complex separation
-							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2 + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-							}
+				//Accumulate the values
+				bus[indexer].Jacob_A[temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
+				bus[indexer].Jacob_B[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+				bus[indexer].Jacob_C[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+				bus[indexer].Jacob_D[temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
+			}//End phase traversion
+		}//End deltamode-enabled in-rush loads updates
+	}//end bus traversion for a,b,c, d value computation
+}
 
-							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2 + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
-								indexer += 1;
-							}
+//Dynamic diagonal elements of the 6n*6n Y matrix for one bus range
+static void solver_nr_diag_update_range(NR_ASSEMBLY_CHUNK *chunk)
+{
+	BUSDATA *bus = chunk->data->bus;
+	NR_SOLVER_STRUCT *powerflow_values = chunk->data->powerflow_values;
+	unsigned int indexer, jindexer;
+	char jindex;
 
-							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2 + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;	
-							}
+	//Start at this range's first entry
+	indexer = chunk->diag_update_start;
 
-							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2 + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;	
-							}
-						}//column end
-					}//row end
-				}//end full ABC for from AC
+	for (jindexer=chunk->bus_start; jindexer<chunk->bus_end; jindexer++)	//Parse through bus list
+	{
+		if ((bus[jindexer].type > 1) && (bus[jindexer].swing_functions_enabled == true))	//Swing bus - and we aren't ignoring it
+		{
+			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+			{
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind - powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
+				indexer += 1;
+
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
+				indexer += 1;
+			}//End swing bus traversion
+		}//End swing bus
+
+		if ((bus[jindexer].type == 0) || ((bus[jindexer].type > 1) && bus[jindexer].swing_functions_enabled == false))	//Only do on PQ (or SWING masquerading as PQ)
+		{
+			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+			{
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_A[jindex]; // Equation(14)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_B[jindex]; // Equation(15)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = 2*bus[jindexer].Matrix_Loc + jindex;
+				powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_C[jindex]; // Equation(16)
+				indexer += 1;
+				
+				powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
+				powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
+				powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_D[jindex]; // Equation(17)
+				indexer += 1;
+			}//end PQ phase traversion
+		}//End PQ bus
+	}//End bus parse list
+}
 
-				if (Full_Mat_B)	//To side is a full ABC and we have AC
-				{
-					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
-					{
-						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
-						{
-							//Indices counted out from Self admittance above.  needs doubling due to complex separation
-							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2 + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-							}
+//Build the A matrix linked lists from the Y_NR triplets
+static void solver_nr_sparse_build(NR_SOLVER_STRUCT *powerflow_values, unsigned int size_Amatrix)
+{
+	unsigned int indexer;
+	int row, col;
+	double value;
 
-							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2 + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
-								indexer += 1;
-							}
+	if (powerflow_values->Y_Amatrix == NULL)
+	{
+		powerflow_values->Y_Amatrix = (SPARSE*) gl_malloc(sizeof(SPARSE));
 
-							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2 + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;	
-							}
+		//Make sure it worked
+		if (powerflow_values->Y_Amatrix == NULL)
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2 + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;	
-							}
-						}//column end
-					}//row end
-				}//end full ABC for to AC
+		//Initiliaze it
+		sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
+	}
+	else if (powerflow_values->NR_realloc_needed)	//If one of the above changed, we changed too
+	{
+		//Destroy the old version
+		sparse_clear(powerflow_values->Y_Amatrix);
 
-				if ((!Full_Mat_A) && (!Full_Mat_B))	//Neither is a full ABC, or we aren't doing AC, so we don't care
-				{
-					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
-					{
-						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
-						{
-							//Indices counted out from Self admittance above.  needs doubling due to complex separation
-							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
-								indexer += 1;
-							}
+		//Create a new 
+		sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
+	}
+	else
+	{
+		//Just clear it out
+		sparse_reset(powerflow_values->Y_Amatrix, 6*NR_bus_count);
+	}
 
-							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
-								indexer += 1;
-							}
+	//integrate off diagonal components
+	for (indexer=0; indexer<powerflow_values->size_offdiag_PQ*2; indexer++)
+	{
+		row = powerflow_values->Y_offdiag_PQ[indexer].row_ind;
+		col = powerflow_values->Y_offdiag_PQ[indexer].col_ind;
+		value = powerflow_values->Y_offdiag_PQ[indexer].Y_value;
+		sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+	}
 
-							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
-								indexer += 1;	
-							}
+	//Integrate fixed portions of diagonal components
+	for (indexer=powerflow_values->size_offdiag_PQ*2; indexer< (powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2); indexer++)
+	{
+		row = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].row_ind;
+		col = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].col_ind;
+		value = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].Y_value;
+		sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+	}
 
-							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
-							{
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;
-								
-								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
-								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
-								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
-								indexer += 1;	
-							}
-						}//column end
-					}//row end
-				}//end not full ABC with AC on either side case
-			}//end all others else
-		}//end branch for
+	//Integrate the variable portions of the diagonal components
+	for (indexer=powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2; indexer< size_Amatrix; indexer++)
+	{
+		row = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].row_ind;
+		col = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].col_ind;
+		value = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].Y_value;
+		sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+	}
+}
 
-		//Build the fixed part of the diagonal PQ bus elements of 6n*6n Y_NR matrix. This part will not be updated at each iteration. 
-		powerflow_values->size_diag_fixed = 0;
-		for (jindexer=0; jindexer<bus_count;jindexer++) 
-		{
-			for (jindex=0; jindex<3; jindex++)
-			{
-				for (kindex=0; kindex<3; kindex++)
-				{		 
-				  if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)  
-					  powerflow_values->size_diag_fixed += 1; 
-				  if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex) 
-					  powerflow_values->size_diag_fixed += 1; 
-				  else {}
-				 }
-			}
-		}
-		if (powerflow_values->Y_diag_fixed == NULL)
-		{
-			powerflow_values->Y_diag_fixed = (Y_NR *)gl_malloc((powerflow_values->size_diag_fixed*2) *sizeof(Y_NR));   //powerflow_values->Y_diag_fixed store the row,column and value of the fixed part of the diagonal PQ bus elements of 6n*6n Y_NR matrix.
+/* Fills the real compressed-column values from the triplets - scattered straight into place when the recorded
+   pattern still matches, otherwise rebuilt through the linked lists.  size_diag_update counts Y_diag_update triplets */
+static void solver_nr_real_fill(NR_SOLVER_STRUCT *powerflow_values, unsigned int size_Amatrix, unsigned int size_diag_update, bool scatter_ready)
+{
+	//Scatter straight into the compressed-column values if the pattern still matches
+	if (scatter_ready == true)
+	{
+		scatter_ready = sparse_scatter(powerflow_values->Amatrix_scatter, powerflow_values->Y_offdiag_PQ, powerflow_values->size_offdiag_PQ*2, matrices_LU.a_LU) &&
+						sparse_scatter(&powerflow_values->Amatrix_scatter[powerflow_values->size_offdiag_PQ*2], powerflow_values->Y_diag_fixed, powerflow_values->size_diag_fixed*2, matrices_LU.a_LU) &&
+						sparse_scatter(&powerflow_values->Amatrix_scatter[powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2], powerflow_values->Y_diag_update, size_diag_update, matrices_LU.a_LU);
 
-			//Make sure it worked
-			if (powerflow_values->Y_diag_fixed == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+		//Pattern changed after all - build it the long way
+		if (scatter_ready == false)
+			solver_nr_sparse_build(powerflow_values,size_Amatrix);
+	}
 
-			//Update the max size
-			powerflow_values->max_size_diag_fixed = powerflow_values->size_diag_fixed;
-		}
-		else if (powerflow_values->size_diag_fixed > powerflow_values->max_size_diag_fixed)		//Something changed and we are bigger!!
+	if (scatter_ready == false)
+	{
+		//Make sure the map has room to record the new pattern
+		if (size_Amatrix > powerflow_values->max_size_Amatrix_scatter)
 		{
-			//Destroy us!
-			gl_free(powerflow_values->Y_diag_fixed);
+			if (powerflow_values->Amatrix_scatter != NULL)
+				gl_free(powerflow_values->Amatrix_scatter);
 
-			//Rebuild us, we have the technology
-			powerflow_values->Y_diag_fixed = (Y_NR *)gl_malloc((powerflow_values->size_diag_fixed*2) *sizeof(Y_NR));
+			powerflow_values->Amatrix_scatter = (SP_SCATTER *)gl_malloc(size_Amatrix*sizeof(SP_SCATTER));
 
 			//Make sure it worked
-			if (powerflow_values->Y_diag_fixed == NULL)
+			if (powerflow_values->Amatrix_scatter == NULL)
 				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-			//Store the new size
-			powerflow_values->max_size_diag_fixed = powerflow_values->size_diag_fixed;
-
-			//Flag for a reallocation
-			powerflow_values->NR_realloc_needed = true;
+			powerflow_values->max_size_Amatrix_scatter = size_Amatrix;
 		}
 
-		indexer = 0;
-		for (jindexer=0; jindexer<bus_count;jindexer++)	//Parse through bus list
-		{ 
-			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-			{
-				for (kindex=0; kindex<powerflow_values->BA_diag[jindexer].size; kindex++)
-				{					
-					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
-					{
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
-						indexer += 1;
+		sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU, powerflow_values->Amatrix_scatter);
 
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
-						indexer += 1;
-					}
+		//Only superLU leaves the compressed-column arrays alone between iterations
+		powerflow_values->size_Amatrix_scatter = (matrix_solver_method==MM_SUPERLU) ? size_Amatrix : 0;
+	}
+}
 
-					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
-					{
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
-						indexer += 1;
-						
-						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
-						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
-						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
-						indexer += 1;
-					}
-				}
-			}
-		}//End bus parse for fixed diagonal
-	}//End admittance update
+//Releases the kept factorization
+static void solver_nr_kept_release(void)
+{
+	if (NR_kept.valid == true)
+	{
+#ifdef MT
+		Destroy_SuperNode_SCP(&NR_kept.L);
+		Destroy_CompCol_NCP(&NR_kept.U);
+#else
+		Destroy_SuperNode_Matrix(&NR_kept.L);
+		Destroy_CompCol_Matrix(&NR_kept.U);
+#endif
+		NR_kept.valid = false;
+	}
 
-	//Reset saturation checks
-	SaturationMismatchPresent = false;
+	//Any correction went with them
+	NR_kept.lowrank_size = 0;
+	NR_kept.lowrank_count = 0;
+}
 
-	//Calculate the system load - this is the specified power of the system
-	for (Iteration=0; Iteration<NR_iteration_limit; Iteration++)
+//Keeps a converged factorization (and the permutations it was made with) in place of the previous one
+static void solver_nr_kept_store(NR_SOLVER_STRUCT *powerflow_values, SuperMatrix *L, SuperMatrix *U, unsigned int size)
+{
+	solver_nr_kept_release();
+
+	if (size > NR_kept.max_size)
 	{
-		//System load at each bus is represented by second order polynomial equations
-		for (indexer=0; indexer<bus_count; indexer++)
+		if (NR_kept.perm_c != NULL)
 		{
-			if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
-			{
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+			gl_free(NR_kept.perm_c);
+			gl_free(NR_kept.perm_r);
+		}
 
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+		NR_kept.perm_c = (int *)gl_malloc(size*sizeof(int));
+		NR_kept.perm_r = (int *)gl_malloc(size*sizeof(int));
 
-					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+		if ((NR_kept.perm_c == NULL) || (NR_kept.perm_r == NULL))
+		{
+			GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+			//Defined above
+		}
 
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+		NR_kept.max_size = size;
+	}
 
-					//Start adjustments - AB
-					if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
+	memcpy(NR_kept.perm_c,perm_c,size*sizeof(int));
+	memcpy(NR_kept.perm_r,perm_r,size*sizeof(int));
 
-					//Start adjustments - BC
-					if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[1] = 0.0;
-					}
+	NR_kept.L = *L;
+	NR_kept.U = *U;
+	NR_kept.owner = powerflow_values;
+	NR_kept.size = size;
+	NR_kept.valid = true;
+}
 
-					//Start adjustments - CA
-					if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[2] = 0.0;
-					}
+//Solves with the kept factors as they were made - triangular solves only, the solution overwrites rhs
+static int solver_nr_kept_factor_solve(double *rhs, unsigned int size)
+{
+	SuperMatrix B_kept;
+	DNformat Bstore_kept;
+	int info;
+#ifdef MT
+	Gstat_t Gstat;
+#else
+	SuperLUStat_t stat;
+#endif
 
-					//See if we have any "different children"
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Create nominal magnitudes
-						adjust_nominal_voltage_val = bus[indexer].volt_base;
+	Bstore_kept.lda = size;
+	Bstore_kept.nzval = rhs;
 
-						//Create the nominal voltage vectors
-						adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-						adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-						adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+	B_kept.Stype = SLU_DN;
+	B_kept.Dtype = SLU_D;
+	B_kept.Mtype = SLU_GE;
+	B_kept.nrow = size;
+	B_kept.ncol = 1;
+	B_kept.Store = &Bstore_kept;
 
-						//Get magnitudes of all
-						adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-						adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-						adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+#ifdef MT
+	StatAlloc(size, 1, sp_ienv(1), sp_ienv(2), &Gstat);
+	StatInit(size, 1, &Gstat);
 
-						//Start adjustments - A
-						if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[3] = 0.0;
-						}
+	dgstrs(NOTRANS, &NR_kept.L, &NR_kept.U, NR_kept.perm_r, NR_kept.perm_c, &B_kept, &Gstat, &info);
 
-						//Start adjustments - B
-						if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[4] = 0.0;
-						}
+	StatFree(&Gstat);
+#else
+	StatInit ( &stat );
 
-						//Start adjustments - C
-						if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[5] = 0.0;
-						}
-					}
-					else	//Nope
-					{
-						//Set to zero, just cause
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}
-				else	//"Normal" modes -- handle traditionally
-				{
-					adjusted_constant_current[0] = bus[indexer].I[0];
-					adjusted_constant_current[1] = bus[indexer].I[1];
-					adjusted_constant_current[2] = bus[indexer].I[2];
+	dgstrs(NOTRANS, &NR_kept.L, &NR_kept.U, NR_kept.perm_c, NR_kept.perm_r, &B_kept, &stat, &info);
 
-					//See if we have different children too
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Store them too
-						adjusted_constant_current[3] = bus[indexer].extra_var[6];
-						adjusted_constant_current[4] = bus[indexer].extra_var[7];
-						adjusted_constant_current[5] = bus[indexer].extra_var[8];
-					}
-					else	//Nope, just zero this for now
-					{
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}//End adjustment code
+	StatFree ( &stat );
+#endif
 
-				//Delta components - populate according to what is there
-				if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
-				{
-					//Voltage calculations
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+	return info;
+}
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S[0]/voltageDel[0]);
+//Solves the dense correction system with its LU factors (from solver_nr_lowrank_factor) - solution overwrites rhs
+static void solver_nr_lowrank_solve(double *C, int *piv, unsigned int n, double *rhs)
+{
+	unsigned int i, j;
+	double temp_val;
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[0] += voltageDel[0] * (bus[indexer].Y[0]);
-				}
-				else
-				{
-					//Zero values - they shouldn't be used anyhow
-					voltageDel[0] = 0.0;
-					delta_current[0] = 0.0;
-				}
+	//Forward substitution, with the row swaps
+	for (i=0; i<n; i++)
+	{
+		temp_val = rhs[piv[i]];
+		rhs[piv[i]] = rhs[i];
+		rhs[i] = temp_val;
 
-				if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
-				{
-					//Voltage calculations
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+		for (j=0; j<i; j++)
+			rhs[i] -= C[i*n+j]*rhs[j];
+	}
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S[1]/voltageDel[1]);
+	//Back substitution
+	for (i=n; i>0; i--)
+	{
+		for (j=i; j<n; j++)
+			rhs[i-1] -= C[(i-1)*n+j]*rhs[j];
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[1] += voltageDel[1] * (bus[indexer].Y[1]);
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[1] = 0.0;
-					delta_current[1] = 0.0;
-				}
+		rhs[i-1] /= C[(i-1)*n+(i-1)];
+	}
+}
 
-				if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
-				{
-					//Voltage calculations
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+//LU factors the dense correction system in place, with partial pivoting - returns false if it is singular
+static bool solver_nr_lowrank_factor(double *C, int *piv, unsigned int n)
+{
+	unsigned int i, j, k, pivot;
+	double temp_val;
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S[2]/voltageDel[2]);
+	for (k=0; k<n; k++)
+	{
+		//Find the largest remaining entry of the column
+		pivot = k;
+		for (i=k+1; i<n; i++)
+		{
+			if (fabs(C[i*n+k]) > fabs(C[pivot*n+k]))
+				pivot = i;
+		}
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[2] += voltageDel[2] * (bus[indexer].Y[2]);
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[2] = 0.0;
-					delta_current[2] = 0.0;
-				}
-				
-				//Convert delta-current into a phase current, where appropriate - reuse temp variable
-				//Everything will be accumulated into the "current" field for ease (including differents)
-				if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
-				{
-					undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+		if (C[pivot*n+k] == 0.0)
+			return false;
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
-					{
-						//Power values
-						undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus[indexer].V[0]);
+		piv[k] = pivot;
 
-						//Shunt values
-						undeltacurr[0] += bus[indexer].extra_var[3]*bus[indexer].V[0];
+		if (pivot != k)
+		{
+			for (j=0; j<n; j++)
+			{
+				temp_val = C[k*n+j];
+				C[k*n+j] = C[pivot*n+j];
+				C[pivot*n+j] = temp_val;
+			}
+		}
 
-						//Current values
-						undeltacurr[0] += adjusted_constant_current[3];
-					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[0] = 0.0;
-				}
+		//Eliminate below it
+		for (i=k+1; i<n; i++)
+		{
+			C[i*n+k] /= C[k*n+k];
 
-				if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
-				{
-					undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+			for (j=k+1; j<n; j++)
+				C[i*n+j] -= C[i*n+k]*C[k*n+j];
+		}
+	}
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
-					{
-						//Power values
-						undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus[indexer].V[1]);
+	return true;
+}
 
-						//Shunt values
-						undeltacurr[1] += bus[indexer].extra_var[4]*bus[indexer].V[1];
+//Solves with the kept factorization - the solution overwrites rhs.  Admittance changes made since the
+//factors were made (J = J0 + E*D, E the unit columns of the changed rows) are applied with the Woodbury
+//identity, x = x0 - W*(I + D*W)^-1*D*x0 where x0 and W are solves with the factors as made
+static int solver_nr_kept_solve(double *rhs, unsigned int size)
+{
+	double corr_vals[NR_LOWRANK_LIMIT];
+	unsigned int indexer, jindexer;
+	int info;
 
-						//Current values
-						undeltacurr[1] += adjusted_constant_current[4];
-					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[1] = 0.0;
-				}
+	info = solver_nr_kept_factor_solve(rhs,size);
 
+	if ((info == 0) && (NR_kept.lowrank_size > 0))
+	{
+		//D*x0
+		for (indexer=0; indexer<NR_kept.lowrank_size; indexer++)
+			corr_vals[indexer] = 0.0;
 
-				if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
-				{
-					undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+		for (indexer=0; indexer<NR_kept.lowrank_count; indexer++)
+			corr_vals[NR_kept.lowrank_delta[indexer].row_ind] += NR_kept.lowrank_delta[indexer].Y_value * rhs[NR_kept.lowrank_delta[indexer].col_ind];
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
-						{
-						//Power values
-						undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus[indexer].V[2]);
+		solver_nr_lowrank_solve(NR_kept.lowrank_C,NR_kept.lowrank_piv,NR_kept.lowrank_size,corr_vals);
 
-						//Shunt values
-						undeltacurr[2] += bus[indexer].extra_var[5]*bus[indexer].V[2];
+		//Remove W times that from the uncorrected solve
+		for (indexer=0; indexer<NR_kept.lowrank_size; indexer++)
+		{
+			for (jindexer=0; jindexer<size; jindexer++)
+				rhs[jindexer] -= NR_kept.lowrank_W[indexer*size+jindexer] * corr_vals[indexer];
+		}
+	}
 
-						//Current values
-						undeltacurr[2] += adjusted_constant_current[5];
-					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[2] = 0.0;
-				}
+	return info;
+}
 
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+//Folds admittance matrix changes into the kept factors' low-rank correction.  Releases the factors
+//(and returns false) if the changes touch more than NR_LOWRANK_LIMIT rows or can't be corrected for
+static bool solver_nr_kept_lowrank_add(Y_NR *delta, unsigned int delta_count)
+{
+	unsigned int indexer, jindexer, kindexer, old_size, size;
+	double *temp_W;
+	Y_NR *temp_delta;
 
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						//Defined below
-					}
+	size = NR_kept.size;
+	old_size = NR_kept.lowrank_size;
 
-					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion - all is current based
+	//Make room for the new changes
+	if ((NR_kept.lowrank_count + delta_count) > NR_kept.max_lowrank_count)
+	{
+		temp_delta = (Y_NR *)gl_malloc((NR_kept.lowrank_count + delta_count)*sizeof(Y_NR));
 
-					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion - all is current based
-					
-				}//End phase traversion
-			}//end delta connected
-			else if ((bus[indexer].phases & 0x80) == 0x80)	//Split-phase connected node
-			{
-				//Convert it all back to current (easiest to handle)
-				//Get V12 first
-				voltageDel[0] = bus[indexer].V[0] + bus[indexer].V[1];
-
-				//Start with the currents (just put them in)
-				temp_current[0] = bus[indexer].I[0];
-				temp_current[1] = bus[indexer].I[1];
-				temp_current[2] = *bus[indexer].extra_var;	//Current12 is not part of the standard current array
-
-				//Add in deltamode unrotated, if necessary
-				if ((bus[indexer].prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
-					temp_current[2] += bus[indexer].prerot_I[2];
-
-				//Now add in power contributions
-				temp_current[0] += bus[indexer].V[0] == 0.0 ? 0.0 : ~(bus[indexer].S[0]/bus[indexer].V[0]);
-				temp_current[1] += bus[indexer].V[1] == 0.0 ? 0.0 : ~(bus[indexer].S[1]/bus[indexer].V[1]);
-				temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus[indexer].S[2]/voltageDel[0]);
-
-				//Last, but not least, admittance/impedance contributions
-				temp_current[0] += bus[indexer].Y[0]*bus[indexer].V[0];
-				temp_current[1] += bus[indexer].Y[1]*bus[indexer].V[1];
-				temp_current[2] += bus[indexer].Y[2]*voltageDel[0];
-
-				//See if we are a house-connected node, if so, adjust and add in those values as well
-				if ((bus[indexer].phases & 0x40) == 0x40)
-				{
-					//Update phase adjustments
-					temp_store[0].SetPolar(1.0,bus[indexer].V[0].Arg());	//Pull phase of V1
-					temp_store[1].SetPolar(1.0,bus[indexer].V[1].Arg());	//Pull phase of V2
-					temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
-
-					//Update these current contributions (use delta current variable, it isn't used in here anyways)
-					delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
-					delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
-					delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
-
-					//Now add it into the current contributions
-					temp_current[0] += delta_current[0];
-					temp_current[1] += delta_current[1];
-					temp_current[2] += delta_current[2];
-				}//End house-attached splitphase
-
-				//Convert 'em to line currents
-				temp_store[0] = temp_current[0] + temp_current[2];
-				temp_store[1] = -temp_current[1] - temp_current[2];
-
-				//Update the stored values
-				bus[indexer].PL[0] = temp_store[0].Re();
-				bus[indexer].QL[0] = temp_store[0].Im();
-
-				bus[indexer].PL[1] = temp_store[1].Re();
-				bus[indexer].QL[1] = temp_store[1].Im();
-			}//end split-phase connected
-			else	//Wye-connected node
-			{
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base;
+		if (temp_delta == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-					adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+		if (NR_kept.lowrank_delta != NULL)
+		{
+			memcpy(temp_delta,NR_kept.lowrank_delta,NR_kept.lowrank_count*sizeof(Y_NR));
+			gl_free(NR_kept.lowrank_delta);
+		}
 
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+		NR_kept.lowrank_delta = temp_delta;
+		NR_kept.max_lowrank_count = NR_kept.lowrank_count + delta_count;
+	}
 
-					//Start adjustments - A
-					if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
+	//Add them, finding (or adding) each one's correction row
+	for (indexer=0; indexer<delta_count; indexer++)
+	{
+		if (delta[indexer].Y_value == 0.0)
+			continue;
 
-					//Start adjustments - B
-					if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[1] = 0.0;
-					}
+		for (jindexer=0; jindexer<NR_kept.lowrank_size; jindexer++)
+		{
+			if (NR_kept.lowrank_row[jindexer] == delta[indexer].row_ind)
+				break;
+		}
 
-					//Start adjustments - C
-					if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[2] = 0.0;
-					}
+		if (jindexer == NR_kept.lowrank_size)
+		{
+			if (NR_kept.lowrank_size == NR_LOWRANK_LIMIT)	//Too many to be worth it - refactor instead
+			{
+				solver_nr_kept_release();
+				return false;
+			}
 
-					//Testing - do adjustments for unrotated current
-					if (bus[indexer].prerot_I[0] != 0.0)
-						adjusted_constant_current[0] += bus[indexer].prerot_I[0];
+			NR_kept.lowrank_row[NR_kept.lowrank_size] = delta[indexer].row_ind;
+			NR_kept.lowrank_size++;
+		}
 
-					if (bus[indexer].prerot_I[1] != 0.0)
-						adjusted_constant_current[1] += bus[indexer].prerot_I[1];
+		//Repeated changes (a regulator stepping back and forth) just add to the entry they change
+		for (kindexer=0; kindexer<NR_kept.lowrank_count; kindexer++)
+		{
+			if ((NR_kept.lowrank_delta[kindexer].row_ind == (int)jindexer) && (NR_kept.lowrank_delta[kindexer].col_ind == delta[indexer].col_ind))
+				break;
+		}
 
-					if (bus[indexer].prerot_I[2] != 0.0)
-						adjusted_constant_current[2] += bus[indexer].prerot_I[2];
+		if (kindexer == NR_kept.lowrank_count)
+		{
+			NR_kept.lowrank_delta[kindexer].row_ind = jindexer;
+			NR_kept.lowrank_delta[kindexer].col_ind = delta[indexer].col_ind;
+			NR_kept.lowrank_delta[kindexer].Y_value = 0.0;
+			NR_kept.lowrank_count++;
+		}
 
-					//See if we have any "different children"
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Create nominal magnitudes
-						adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
-
-						//Create the nominal voltage vectors
-						adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-						adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-						adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
-
-						//Compute delta voltages
-						voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-						voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-						voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
-
-						//Get magnitudes of all
-						adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-						adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-						adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-
-						//Start adjustments - AB
-						if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[3] = 0.0;
-						}
+		NR_kept.lowrank_delta[kindexer].Y_value += delta[indexer].Y_value;
+	}
 
-						//Start adjustments - BC
-						if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[4] = 0.0;
-						}
+	if (NR_kept.lowrank_size == 0)	//Nothing actually changed
+		return true;
 
-						//Start adjustments - CA
-						if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[5] = 0.0;
-						}
-					}
-					else	//Nope
-					{
-						//Set to zero, just cause
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}
-				else	//"Normal" modes -- handle traditionally
-				{
-					adjusted_constant_current[0] = bus[indexer].I[0];
-					adjusted_constant_current[1] = bus[indexer].I[1];
-					adjusted_constant_current[2] = bus[indexer].I[2];
+	//Solves for the new rows - the existing ones still hold, since the factors didn't change
+	if ((NR_kept.lowrank_size*size) > NR_kept.max_lowrank_W)
+	{
+		temp_W = (double *)gl_malloc(NR_LOWRANK_LIMIT*size*sizeof(double));
 
-					//See if we have different children too
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Store them too
-						adjusted_constant_current[3] = bus[indexer].extra_var[6];
-						adjusted_constant_current[4] = bus[indexer].extra_var[7];
-						adjusted_constant_current[5] = bus[indexer].extra_var[8];
-					}
-					else	//Nope, just zero this for now
-					{
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}//End adjustment code
+		if (temp_W == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-				//For Wye-connected, only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
+		if (NR_kept.lowrank_W != NULL)
+		{
+			memcpy(temp_W,NR_kept.lowrank_W,old_size*size*sizeof(double));
+			gl_free(NR_kept.lowrank_W);
+		}
 
-				if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
-				{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
-					//Delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+		NR_kept.lowrank_W = temp_W;
+		NR_kept.max_lowrank_W = NR_LOWRANK_LIMIT*size;
+	}
 
-					//Make sure phase combinations exist
-					if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
-					{
-						//Power - put into a current value (iterates less this way)
-						delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
+	for (indexer=old_size; indexer<NR_kept.lowrank_size; indexer++)
+	{
+		temp_W = &NR_kept.lowrank_W[indexer*size];
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						delta_current[0] = 0.0;
-					}
+		for (jindexer=0; jindexer<size; jindexer++)
+			temp_W[jindexer] = 0.0;
 
-					//Check for BC
-					if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
-					{
-						//Power - put into a current value (iterates less this way)
-						delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
+		temp_W[NR_kept.lowrank_row[indexer]] = 1.0;
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						delta_current[1] = 0.0;
-					}
+		if (solver_nr_kept_factor_solve(temp_W,size) != 0)
+		{
+			solver_nr_kept_release();
+			return false;
+		}
+	}
 
-					//Check for CA
-					if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
-					{
-						//Power - put into a current value (iterates less this way)
-						delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
+	//I + D*W, over all of the changes so far
+	for (indexer=0; indexer<NR_kept.lowrank_size; indexer++)
+	{
+		for (jindexer=0; jindexer<NR_kept.lowrank_size; jindexer++)
+			NR_kept.lowrank_C[indexer*NR_kept.lowrank_size+jindexer] = ((indexer == jindexer) ? 1.0 : 0.0);
+	}
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						delta_current[2] = 0.0;
-					}
+	for (indexer=0; indexer<NR_kept.lowrank_count; indexer++)
+	{
+		for (jindexer=0; jindexer<NR_kept.lowrank_size; jindexer++)
+		{
+			NR_kept.lowrank_C[NR_kept.lowrank_delta[indexer].row_ind*NR_kept.lowrank_size+jindexer] += NR_kept.lowrank_delta[indexer].Y_value * NR_kept.lowrank_W[jindexer*size+NR_kept.lowrank_delta[indexer].col_ind];
+		}
+	}
 
-					//Convert delta-current into a phase current - reuse temp variable
-					undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
-					undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
-					undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
-				}
-				else	//zero the variable so we don't have excessive ifs
-				{
-					undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = 0.0;	//Zero it
-				}
+	if (solver_nr_lowrank_factor(NR_kept.lowrank_C,NR_kept.lowrank_piv,NR_kept.lowrank_size) == false)
+	{
+		solver_nr_kept_release();
+		return false;
+	}
 
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+	return true;
+}
 
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						/*  TROUBLESHOOT
-						While attempting to calculate the scheduled portions of the
-						attached loads, an update failed to process correctly.
-						Submit you code and a bug report using the trac website.
-						*/
-					}
+//How much of the admittance structures an admittance change needs rebuilt
+typedef enum {
+	NRA_FULL=0,		//Everything
+	NRA_BUSES=1,	//Self admittance of the buses on changed branches, then the fixed entries in full (their pattern moved)
+	NRA_VALUES=2	//Only the entries of changed branches and their buses, in place - same pattern
+} NRADMITUPDATE;
 
-					//Perform the power calculation
-					tempPbus = (bus[indexer].S[temp_index_b]).Re();									// Real power portion of constant power portion
-					tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					tempPbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current from "different" children
-					tempPbus += (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion
-					
-					
-					tempQbus = (bus[indexer].S[temp_index_b]).Im();									// Reactive power portion of constant power portion
-					tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					tempQbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
-					tempQbus += -(bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() - (bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage				
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion  
+//Allocates (or grows) the admittance snapshot
+static NR_ADMIT_STATE *solver_nr_admit_alloc(NR_SOLVER_STRUCT *powerflow_values, unsigned int bus_count, unsigned int branch_count)
+{
+	NR_ADMIT_STATE *admit = powerflow_values->admit;
+	unsigned int branch_alloc;
 
-				}//end phase traversion
-			}//end wye-connected
+	if (admit == NULL)
+	{
+		admit = (NR_ADMIT_STATE *)gl_malloc(sizeof(NR_ADMIT_STATE));
 
-			//Perform explicit delta/wye load accumulation - do if not triplex
-			if ((bus[indexer].phases & 0x80) != 0x80)
-			{
-				//Delta components - populate according to what is there
-				if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
-				{
-					//Voltage calculations
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+		if (admit == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S_dy[0]/voltageDel[0]);
+		memset(admit,0,sizeof(NR_ADMIT_STATE));
+		powerflow_values->admit = admit;
+	}
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[0] += voltageDel[0] * (bus[indexer].Y_dy[0]);
+	if (bus_count > admit->max_bus_count)
+	{
+		if (admit->bus_phases != NULL)
+		{
+			gl_free(admit->bus_phases);
+			gl_free(admit->bus_type);
+			gl_free(admit->diag_fixed_start);
+			gl_free(admit->bus_touched);
+			gl_free(admit->BA_prev);
+		}
 
-				}
-				else
-				{
-					//Zero values - they shouldn't be used anyhow
-					voltageDel[0] = 0.0;
-					delta_current[0] = 0.0;
-				}
+		admit->bus_phases = (unsigned char *)gl_malloc(bus_count*sizeof(unsigned char));
+		admit->bus_type = (int *)gl_malloc(bus_count*sizeof(int));
+		admit->diag_fixed_start = (unsigned int *)gl_malloc((bus_count+1)*sizeof(unsigned int));
+		admit->bus_touched = (char *)gl_malloc(bus_count*sizeof(char));
+		admit->BA_prev = (Bus_admit *)gl_malloc(bus_count*sizeof(Bus_admit));
 
-				if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
-				{
-					//Voltage calculations
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+		if ((admit->bus_phases == NULL) || (admit->bus_type == NULL) || (admit->diag_fixed_start == NULL) || (admit->bus_touched == NULL) || (admit->BA_prev == NULL))
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S_dy[1]/voltageDel[1]);
+		admit->max_bus_count = bus_count;
+		admit->valid = false;
+	}
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[1] += voltageDel[1] * (bus[indexer].Y_dy[1]);
+	//Room for one branch even without any, so offdiag_start[branch_count] always exists
+	branch_alloc = (branch_count > 0) ? branch_count : 1;
 
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[1] = 0.0;
-					delta_current[1] = 0.0;
-				}
+	if (branch_alloc > admit->max_branch_count)
+	{
+		if (admit->branch_phases != NULL)
+		{
+			gl_free(admit->branch_phases);
+			gl_free(admit->branch_v_ratio);
+			gl_free(admit->branch_Y);
+			gl_free(admit->offdiag_start);
+			gl_free(admit->branch_changed);
+		}
 
-				if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
-				{
-					//Voltage calculations
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+		admit->branch_phases = (unsigned char *)gl_malloc(branch_alloc*sizeof(unsigned char));
+		admit->branch_v_ratio = (double *)gl_malloc(branch_alloc*sizeof(double));
+		admit->branch_Y = (complex *)gl_malloc(36*branch_alloc*sizeof(complex));
+		admit->offdiag_start = (unsigned int *)gl_malloc((branch_alloc+1)*sizeof(unsigned int));
+		admit->branch_changed = (char *)gl_malloc(branch_alloc*sizeof(char));
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S_dy[2]/voltageDel[2]);
+		if ((admit->branch_phases == NULL) || (admit->branch_v_ratio == NULL) || (admit->branch_Y == NULL) || (admit->offdiag_start == NULL) || (admit->branch_changed == NULL))
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[2] += voltageDel[2] * (bus[indexer].Y_dy[2]);
+		admit->max_branch_count = branch_alloc;
+		admit->valid = false;
+	}
 
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[2] = 0.0;
-					delta_current[2] = 0.0;
-				}
-				
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create line-line nominal magnitude
-					adjust_nominal_voltage_val = bus[indexer].volt_base;
-					adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
+	return admit;
+}
 
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
-					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
-					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
-					adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
-					adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
-					adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
+//Checks if two admittance values are identical (complex's own comparison only checks the angle)
+static bool solver_nr_admit_same_value(complex *Y_a, complex *Y_b)
+{
+	return ((Y_a->Re() == Y_b->Re()) && (Y_a->Im() == Y_b->Im()));
+}
 
-					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+//Checks if two admittance values have the same zero real/imaginary parts - the Y_NR entries they make
+static bool solver_nr_admit_same_pattern(complex *Y_a, complex *Y_b)
+{
+	return (((Y_a->Re() != 0.0) == (Y_b->Re() != 0.0)) && ((Y_a->Im() != 0.0) == (Y_b->Im() != 0.0)));
+}
 
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+//Compares the admittance inputs against the snapshot of the last build - flags the changed branches
+//and the buses they touch, and returns how much needs rebuilding
+static NRADMITUPDATE solver_nr_admit_compare(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type)
+{
+	NR_ADMIT_STATE *admit = powerflow_values->admit;
+	NRADMITUPDATE update_type;
+	unsigned int indexer, jindex;
+	complex *Y_snap;
+	bool changed;
+
+	//Deltamode builds add generator self-admittance, so only normal builds are compared
+	if ((admit == NULL) || (admit->valid == false) || (powerflow_type != PF_NORMAL) || (admit->bus_count != bus_count) || (admit->branch_count != branch_count))
+		return NRA_FULL;
+
+	//Bus sizes and types set the layout of everything
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		if ((bus[indexer].phases != admit->bus_phases[indexer]) || (bus[indexer].type != admit->bus_type[indexer]))
+			return NRA_FULL;
 
-					//Start adjustments - A
-					if ((bus[indexer].I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I_dy[3] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[3] = 0.0;
-					}
+		admit->bus_touched[indexer] = 0;
+	}
 
-					//Start adjustments - B
-					if ((bus[indexer].I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I_dy[4] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[4] = 0.0;
-					}
+	update_type = NRA_VALUES;
 
-					//Start adjustments - C
-					if ((bus[indexer].I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I_dy[5] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[5] = 0.0;
-					}
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		Y_snap = &admit->branch_Y[36*indexer];
+		changed = ((branch[indexer].phases != admit->branch_phases[indexer]) || (branch[indexer].v_ratio != admit->branch_v_ratio[indexer]));
 
-					//Start adjustments - AB
-					if ((bus[indexer].I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
+		for (jindex=0; (jindex<9) && (changed == false); jindex++)
+		{
+			changed = ((solver_nr_admit_same_value(&branch[indexer].Yfrom[jindex],&Y_snap[jindex]) == false) || (solver_nr_admit_same_value(&branch[indexer].Yto[jindex],&Y_snap[9+jindex]) == false) ||
+					   (solver_nr_admit_same_value(&branch[indexer].YSfrom[jindex],&Y_snap[18+jindex]) == false) || (solver_nr_admit_same_value(&branch[indexer].YSto[jindex],&Y_snap[27+jindex]) == false));
+		}
 
-					//Start adjustments - BC
-					if ((bus[indexer].I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+		admit->branch_changed[indexer] = (changed ? 1 : 0);
+
+		if (changed == false)
+			continue;
+
+		admit->bus_touched[branch[indexer].from] = 1;
+		admit->bus_touched[branch[indexer].to] = 1;
+
+		//Phase changes (switching) or new/removed entries move the off-diagonal pattern
+		if (update_type == NRA_VALUES)
+		{
+			if ((branch[indexer].phases != admit->branch_phases[indexer]) || ((branch[indexer].v_ratio == 1.0) != (admit->branch_v_ratio[indexer] == 1.0)))
+				update_type = NRA_BUSES;
+
+			for (jindex=0; (jindex<9) && (update_type == NRA_VALUES); jindex++)
+			{
+				if ((solver_nr_admit_same_pattern(&branch[indexer].Yfrom[jindex],&Y_snap[jindex]) == false) || (solver_nr_admit_same_pattern(&branch[indexer].Yto[jindex],&Y_snap[9+jindex]) == false))
+					update_type = NRA_BUSES;
+			}
+		}
+	}
+
+	return update_type;
+}
+
+//Records the admittance inputs the structures were just built from - only the changed branches, unless it was a full build
+static void solver_nr_admit_snapshot(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_ADMIT_STATE *admit, NRSOLVERMODE powerflow_type, NRADMITUPDATE update_type)
+{
+	unsigned int indexer, jindex;
+	complex *Y_snap;
+
+	if (update_type == NRA_FULL)
+	{
+		for (indexer=0; indexer<bus_count; indexer++)
+		{
+			admit->bus_phases[indexer] = bus[indexer].phases;
+			admit->bus_type[indexer] = bus[indexer].type;
+		}
+	}
+
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		if ((update_type != NRA_FULL) && (admit->branch_changed[indexer] == 0))
+			continue;
+
+		Y_snap = &admit->branch_Y[36*indexer];
+
+		for (jindex=0; jindex<9; jindex++)
+		{
+			Y_snap[jindex] = branch[indexer].Yfrom[jindex];
+			Y_snap[9+jindex] = branch[indexer].Yto[jindex];
+			Y_snap[18+jindex] = branch[indexer].YSfrom[jindex];
+			Y_snap[27+jindex] = branch[indexer].YSto[jindex];
+		}
+
+		admit->branch_phases[indexer] = branch[indexer].phases;
+		admit->branch_v_ratio[indexer] = branch[indexer].v_ratio;
+	}
+
+	admit->bus_count = bus_count;
+	admit->branch_count = branch_count;
+	admit->valid = (powerflow_type == PF_NORMAL);
+}
+
+//Adds an entry to the in-place update's change list - returns its index
+static unsigned int solver_nr_admit_delta_add(NR_ADMIT_STATE *admit, int row, int col, double value)
+{
+	Y_NR *temp_delta;
+
+	if (admit->delta_count == admit->max_delta_count)
+	{
+		temp_delta = (Y_NR *)gl_malloc((2*admit->max_delta_count + 64)*sizeof(Y_NR));
+
+		if (temp_delta == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
+
+		if (admit->delta != NULL)
+		{
+			memcpy(temp_delta,admit->delta,admit->delta_count*sizeof(Y_NR));
+			gl_free(admit->delta);
+		}
+
+		admit->delta = temp_delta;
+		admit->max_delta_count = 2*admit->max_delta_count + 64;
+	}
+
+	admit->delta[admit->delta_count].row_ind = row;
+	admit->delta[admit->delta_count].col_ind = col;
+	admit->delta[admit->delta_count].Y_value = value;
+
+	return admit->delta_count++;
+}
+
+//Records the matrix changes a touched bus's self admittance made to the per-iteration diagonal
+//entries - these follow solver_nr_diag_update_range, less the load terms (which don't change)
+static void solver_nr_admit_delta_diag(NR_ADMIT_STATE *admit, BUSDATA *bus, Bus_admit *BA_new, Bus_admit *BA_old)
+{
+	int row;
+	char jindex, size;
+	complex Y_change;
+
+	size = BA_new->size;
+
+	for (jindex=0; jindex<size; jindex++)
+	{
+		row = 2*bus->Matrix_Loc + jindex;
+		Y_change = BA_new->Y[jindex][jindex] - BA_old->Y[jindex][jindex];
+
+		if ((bus->type > 1) && (bus->swing_functions_enabled == true))	//Swing - only the cross terms carry admittance
+		{
+			solver_nr_admit_delta_add(admit,row,row+size,Y_change.Re());
+			solver_nr_admit_delta_add(admit,row+size,row,Y_change.Re());
+		}
+		else if ((bus->type == 0) || (bus->type > 1))	//PQ (or swing acting as one)
+		{
+			solver_nr_admit_delta_add(admit,row,row,Y_change.Im());
+			solver_nr_admit_delta_add(admit,row,row+size,Y_change.Re());
+			solver_nr_admit_delta_add(admit,row+size,row,Y_change.Re());
+			solver_nr_admit_delta_add(admit,row+size,row+size,-Y_change.Im());
+		}
+	}
+}
+
+//Multiple of a bus's convergence limit the complex and real formulations may differ by before validation warns
+#define NR_VALIDATE_TOLERANCE 10.0
+
+//Allocates (or grows) the complex form of the system - size is in complex unknowns, triplets in real triplets
+static NR_COMPLEX_VARS *solver_nr_complex_alloc(NR_SOLVER_STRUCT *powerflow_values, unsigned int size, unsigned int triplets)
+{
+	NR_COMPLEX_VARS *complex_vars = powerflow_values->complex_vars;
+
+	if (complex_vars == NULL)
+	{
+		complex_vars = (NR_COMPLEX_VARS *)gl_malloc(sizeof(NR_COMPLEX_VARS));
+
+		if (complex_vars == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
+
+		memset(complex_vars,0,sizeof(NR_COMPLEX_VARS));
+		powerflow_values->complex_vars = complex_vars;
+	}
+
+	if (size > complex_vars->max_size)
+	{
+		if (complex_vars->real_map != NULL)
+		{
+			gl_free(complex_vars->real_map);
+			gl_free(complex_vars->real_half);
+			gl_free(complex_vars->col_first);
+			gl_free(complex_vars->col_second);
+			gl_free(complex_vars->marker);
+			gl_free(complex_vars->position);
+			gl_free(complex_vars->bucket);
+			gl_free(complex_vars->perm_c);
+			gl_free(complex_vars->perm_r);
+			gl_free(complex_vars->cols_LU);
+			gl_free(complex_vars->rhs_LU);
+			gl_free(complex_vars->x_LU);
+			gl_free(complex_vars->w_LU);
+		}
+
+		complex_vars->real_map = (int *)gl_malloc(2*size*sizeof(int));
+		complex_vars->real_half = (char *)gl_malloc(2*size*sizeof(char));
+		complex_vars->col_first = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->col_second = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->marker = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->position = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->bucket = (int *)gl_malloc((size+1)*sizeof(int));
+		complex_vars->perm_c = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->perm_r = (int *)gl_malloc(size*sizeof(int));
+		complex_vars->cols_LU = (int *)gl_malloc((size+1)*sizeof(int));
+		complex_vars->rhs_LU = (double *)gl_malloc(2*size*sizeof(double));
+		complex_vars->x_LU = (double *)gl_malloc(2*size*sizeof(double));
+		complex_vars->w_LU = (double *)gl_malloc(2*size*sizeof(double));
+
+		if ((complex_vars->real_map == NULL) || (complex_vars->real_half == NULL) || (complex_vars->col_first == NULL) || (complex_vars->col_second == NULL) ||
+			(complex_vars->marker == NULL) || (complex_vars->position == NULL) || (complex_vars->bucket == NULL) || (complex_vars->perm_c == NULL) || (complex_vars->perm_r == NULL) ||
+			(complex_vars->cols_LU == NULL) || (complex_vars->rhs_LU == NULL) || (complex_vars->x_LU == NULL) || (complex_vars->w_LU == NULL))
+		{
+			GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+			//Defined above
+		}
+
+		//Mapping is all new
+		for (unsigned int indexer=0; indexer<2*size; indexer++)
+			complex_vars->real_map[indexer] = -1;
+
+		complex_vars->max_size = size;
+		complex_vars->triplets = 0;
+	}
+
+	if (triplets > complex_vars->max_triplets)
+	{
+		if (complex_vars->a_LU != NULL)
+		{
+			gl_free(complex_vars->a_LU);
+			gl_free(complex_vars->q_LU);
+			gl_free(complex_vars->rows_LU);
+			gl_free(complex_vars->order);
+			gl_free(complex_vars->scatter);
+		}
+
+		complex_vars->a_LU = (double *)gl_malloc(2*triplets*sizeof(double));
+		complex_vars->q_LU = (double *)gl_malloc(2*triplets*sizeof(double));
+		complex_vars->rows_LU = (int *)gl_malloc(triplets*sizeof(int));
+		complex_vars->order = (int *)gl_malloc(triplets*sizeof(int));
+		complex_vars->scatter = (SP_SCATTER *)gl_malloc(triplets*sizeof(SP_SCATTER));
+
+		if ((complex_vars->a_LU == NULL) || (complex_vars->q_LU == NULL) || (complex_vars->rows_LU == NULL) || (complex_vars->order == NULL) || (complex_vars->scatter == NULL))
+		{
+			GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+			//Defined above
+		}
+
+		complex_vars->max_triplets = triplets;
+		complex_vars->triplets = 0;
+	}
+
+	return complex_vars;
+}
+
+/* Numbers the complex unknowns - one per phase of each bus, skipping active swing buses, whose voltages
+   don't move.  Returns true if the numbering changed since the last call */
+static bool solver_nr_complex_map(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, NR_COMPLEX_VARS *complex_vars)
+{
+	unsigned int indexer, base, size;
+	int first, second;
+	char jindex, bus_size;
+	bool changed = false;
+
+	size = 0;
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		bus_size = powerflow_values->BA_diag[indexer].size;
+		base = bus[indexer].Matrix_Loc;
+
+		for (jindex=0; jindex<bus_size; jindex++)
+		{
+			first = 2*base + jindex;
+			second = 2*base + bus_size + jindex;
+
+			complex_vars->real_half[first] = 0;
+			complex_vars->real_half[second] = 1;
+
+			if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))	//Swing - eliminated
+			{
+				if ((complex_vars->real_map[first] != -1) || (complex_vars->real_map[second] != -1))
+					changed = true;
+
+				complex_vars->real_map[first] = -1;
+				complex_vars->real_map[second] = -1;
+			}
+			else
+			{
+				if ((complex_vars->real_map[first] != (int)size) || (complex_vars->real_map[second] != (int)size))
+					changed = true;
+
+				complex_vars->real_map[first] = size;
+				complex_vars->real_map[second] = size;
+				complex_vars->col_first[size] = first;
+				complex_vars->col_second[size] = second;
+				size++;
+			}
+		}
+	}
+
+	complex_vars->size = size;
+
+	return changed;
+}
+
+/* Builds the complex compressed-column pattern straight from the real triplets (Y_offdiag_PQ, Y_diag_fixed
+   and Y_diag_update, in that order), and records where each triplet lands */
+static void solver_nr_complex_pattern(NR_COMPLEX_VARS *complex_vars, Y_NR **lists, unsigned int *counts)
+{
+	unsigned int list, indexer, triplet, cnnz;
+	int row, col, kindex, sindex, sorted_row;
+
+	//Count the triplets in each complex column
+	for (indexer=0; indexer<=complex_vars->size; indexer++)
+		complex_vars->bucket[indexer] = 0;
+
+	triplet = 0;
+	for (list=0; list<3; list++)
+	{
+		for (indexer=0; indexer<counts[list]; indexer++, triplet++)
+		{
+			complex_vars->scatter[triplet].row_ind = lists[list][indexer].row_ind;
+			complex_vars->scatter[triplet].col_ind = lists[list][indexer].col_ind;
+			complex_vars->scatter[triplet].csc_ind = -1;
+
+			row = complex_vars->real_map[lists[list][indexer].row_ind];
+			col = complex_vars->real_map[lists[list][indexer].col_ind];
+
+			if ((row >= 0) && (col >= 0))
+				complex_vars->bucket[col+1]++;
+		}
+	}
+
+	for (indexer=0; indexer<complex_vars->size; indexer++)
+		complex_vars->bucket[indexer+1] += complex_vars->bucket[indexer];
+
+	//Sort them by column - cols_LU is the fill pointer for now
+	for (indexer=0; indexer<complex_vars->size; indexer++)
+		complex_vars->cols_LU[indexer] = complex_vars->bucket[indexer];
+
+	for (indexer=0; indexer<triplet; indexer++)
+	{
+		row = complex_vars->real_map[complex_vars->scatter[indexer].row_ind];
+		col = complex_vars->real_map[complex_vars->scatter[indexer].col_ind];
+
+		if ((row >= 0) && (col >= 0))
+			complex_vars->order[complex_vars->cols_LU[col]++] = indexer;
+	}
+
+	//One entry per distinct row of each column, rows in order
+	for (indexer=0; indexer<complex_vars->size; indexer++)
+		complex_vars->marker[indexer] = -1;
+
+	cnnz = 0;
+	for (col=0; col<(int)complex_vars->size; col++)
+	{
+		complex_vars->cols_LU[col] = cnnz;
+
+		for (kindex=complex_vars->bucket[col]; kindex<complex_vars->bucket[col+1]; kindex++)
+		{
+			row = complex_vars->real_map[complex_vars->scatter[complex_vars->order[kindex]].row_ind];
+
+			if (complex_vars->marker[row] != col)
+			{
+				complex_vars->marker[row] = col;
+				complex_vars->rows_LU[cnnz++] = row;
+			}
+		}
+
+		//Columns are short, so insertion sort them
+		for (kindex=complex_vars->cols_LU[col]+1; kindex<(int)cnnz; kindex++)
+		{
+			sorted_row = complex_vars->rows_LU[kindex];
+
+			for (sindex=kindex-1; (sindex>=complex_vars->cols_LU[col]) && (complex_vars->rows_LU[sindex] > sorted_row); sindex--)
+				complex_vars->rows_LU[sindex+1] = complex_vars->rows_LU[sindex];
+
+			complex_vars->rows_LU[sindex+1] = sorted_row;
+		}
+
+		for (kindex=complex_vars->cols_LU[col]; kindex<(int)cnnz; kindex++)
+			complex_vars->position[complex_vars->rows_LU[kindex]] = kindex;
+
+		for (kindex=complex_vars->bucket[col]; kindex<complex_vars->bucket[col+1]; kindex++)
+		{
+			SP_SCATTER *entry = &complex_vars->scatter[complex_vars->order[kindex]];
+			entry->csc_ind = complex_vars->position[complex_vars->real_map[entry->row_ind]];
+		}
+	}
+	complex_vars->cols_LU[complex_vars->size] = cnnz;
+
+	complex_vars->nnz = cnnz;
+	complex_vars->triplets = triplet;
+}
+
+/* Assembles the complex Newton-Raphson system straight from the real triplets and right-hand side.
+   A real 2x2 block [a b; c d] maps a change in (real,imaginary) voltage onto a change in (imaginary,real)
+   current.  In complex terms that is dI = P*dV + Q*conj(dV), with P = (b+c)/2 + j(a-d)/2 and
+   Q = (c-b)/2 + j(a+d)/2.  Admittances only give P; the constant power loads give Q too, on their own buses */
+static NR_COMPLEX_VARS *solver_nr_complex_assemble(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, Y_NR **lists, unsigned int *counts, double *rhs)
+{
+	NR_COMPLEX_VARS *complex_vars;
+	unsigned int list, indexer, triplet, total;
+	int pos;
+	double value;
+	bool remapped, pattern_ok;
+	SP_SCATTER *entry;
+
+	total = counts[0] + counts[1] + counts[2];
+
+	complex_vars = solver_nr_complex_alloc(powerflow_values,powerflow_values->total_variables,total);
+
+	remapped = solver_nr_complex_map(bus_count,bus,powerflow_values,complex_vars);
+
+	pattern_ok = ((remapped == false) && (complex_vars->triplets == total));
+
+	do {
+		if (pattern_ok == false)
+			solver_nr_complex_pattern(complex_vars,lists,counts);
+
+		memset(complex_vars->a_LU,0,2*complex_vars->nnz*sizeof(double));
+		memset(complex_vars->q_LU,0,2*complex_vars->nnz*sizeof(double));
+
+		pattern_ok = true;
+		triplet = 0;
+		for (list=0; (list<3) && (pattern_ok == true); list++)
+		{
+			for (indexer=0; indexer<counts[list]; indexer++, triplet++)
+			{
+				entry = &complex_vars->scatter[triplet];
+
+				//Pattern moved - rebuild it and start over
+				if ((entry->row_ind != lists[list][indexer].row_ind) || (entry->col_ind != lists[list][indexer].col_ind))
+				{
+					pattern_ok = false;
+					break;
+				}
+
+				pos = entry->csc_ind;
+
+				if (pos < 0)	//Swing row or column
+					continue;
+
+				value = 0.5*lists[list][indexer].Y_value;
+
+				if (complex_vars->real_half[entry->row_ind] == 0)
+				{
+					if (complex_vars->real_half[entry->col_ind] == 0)	//a
 					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
+						complex_vars->a_LU[2*pos+1] += value;
+						complex_vars->q_LU[2*pos+1] += value;
 					}
-					else
+					else												//b
 					{
-						adjusted_constant_current[1] = 0.0;
+						complex_vars->a_LU[2*pos] += value;
+						complex_vars->q_LU[2*pos] -= value;
 					}
-
-					//Start adjustments - CA
-					if ((bus[indexer].I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+				}
+				else
+				{
+					if (complex_vars->real_half[entry->col_ind] == 0)	//c
 					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
+						complex_vars->a_LU[2*pos] += value;
+						complex_vars->q_LU[2*pos] += value;
 					}
-					else
+					else												//d
 					{
-						adjusted_constant_current[2] = 0.0;
+						complex_vars->a_LU[2*pos+1] -= value;
+						complex_vars->q_LU[2*pos+1] += value;
 					}
-				}//End deltamode adjustment
-				else	//Normal mode
-				{
-					//Just copy the values in
-					adjusted_constant_current[0] = bus[indexer].I_dy[0];
-					adjusted_constant_current[1] = bus[indexer].I_dy[1];
-					adjusted_constant_current[2] = bus[indexer].I_dy[2];
-					adjusted_constant_current[3] = bus[indexer].I_dy[3];
-					adjusted_constant_current[4] = bus[indexer].I_dy[4];
-					adjusted_constant_current[5] = bus[indexer].I_dy[5];
 				}
+			}
+		}
+	} while (pattern_ok == false);
 
-				//Convert delta-current into a phase current, where appropriate - reuse temp variable
-				//Everything will be accumulated into the "current" field for ease (including differents)
-				//Also handle wye currents in here (was a differently connected child code before)
-				if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
-				{
-					undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+	complex_vars->q_present = false;
+	for (indexer=0; indexer<2*complex_vars->nnz; indexer++)
+	{
+		if (complex_vars->q_LU[indexer] != 0.0)
+		{
+			complex_vars->q_present = true;
+			break;
+		}
+	}
 
-					//Power values
-					undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].S_dy[3]/bus[indexer].V[0]);
+	//Real current mismatch is the real part, imaginary current the imaginary
+	for (indexer=0; indexer<complex_vars->size; indexer++)
+	{
+		complex_vars->rhs_LU[2*indexer] = rhs[complex_vars->col_second[indexer]];
+		complex_vars->rhs_LU[2*indexer+1] = rhs[complex_vars->col_first[indexer]];
+	}
 
-					//Shunt values
-					undeltacurr[0] += bus[indexer].Y_dy[3]*bus[indexer].V[0];
+	return complex_vars;
+}
 
-					//Current values
-					undeltacurr[0] += adjusted_constant_current[3];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[0] = 0.0;
-				}
+//Unfolds the complex solution back into the real/imaginary layout the voltage update expects - eliminated swing entries don't move
+static void solver_nr_complex_unfold(NR_COMPLEX_VARS *complex_vars, double *sol, unsigned int m)
+{
+	unsigned int indexer;
 
-				if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
-				{
-					undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+	memset(sol,0,m*sizeof(double));
 
-					//Power values
-					undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].S_dy[4]/bus[indexer].V[1]);
+	for (indexer=0; indexer<complex_vars->size; indexer++)
+	{
+		sol[complex_vars->col_first[indexer]] = complex_vars->x_LU[2*indexer];
+		sol[complex_vars->col_second[indexer]] = complex_vars->x_LU[2*indexer+1];
+	}
+}
 
-					//Shunt values
-					undeltacurr[1] += bus[indexer].Y_dy[4]*bus[indexer].V[1];
+/* Takes the Newton-Raphson step with the complex formulation - the update lands in matrices_LU.rhs_LU.
+   Returns false, leaving the right-hand side alone, if the complex system couldn't be solved or its
+   conjugate-voltage iterations didn't settle - the real formulation takes that step instead */
+static bool solver_nr_complex_step(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, unsigned int size_diag_update, unsigned int m)
+{
+	NR_COMPLEX_VARS *complex_vars;
+	Y_NR *lists[3];
+	unsigned int counts[3];
+	int info;
+	bool converged;
 
-					//Current values
-					undeltacurr[1] += adjusted_constant_current[4];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[1] = 0.0;
-				}
+	lists[0] = powerflow_values->Y_offdiag_PQ;
+	counts[0] = powerflow_values->size_offdiag_PQ*2;
+	lists[1] = powerflow_values->Y_diag_fixed;
+	counts[1] = powerflow_values->size_diag_fixed*2;
+	lists[2] = powerflow_values->Y_diag_update;
+	counts[2] = size_diag_update;
 
+	complex_vars = solver_nr_complex_assemble(bus_count,bus,powerflow_values,lists,counts,matrices_LU.rhs_LU);
 
-				if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
-				{
-					undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+	//Factor and solve - cleans up after itself
+	info = solver_nr_complex_solve(complex_vars,&converged);
 
-					//Power values
-					undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].S_dy[5]/bus[indexer].V[2]);
+	if ((info != 0) || (converged == false))
+	{
+		NR_complex_fallbacks++;
+		return false;
+	}
 
-					//Shunt values
-					undeltacurr[2] += bus[indexer].Y_dy[5]*bus[indexer].V[2];
+	//Put the update back where the real formulation would have left it
+	solver_nr_complex_unfold(complex_vars,matrices_LU.rhs_LU,m);
 
-					//Current values
-					undeltacurr[2] += adjusted_constant_current[5];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[2] = 0.0;
-				}
+	return true;
+}
 
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
+/** Newton-Raphson solver
+	Solves a power flow problem using the Newton-Raphson method
+	
+	@return n=0 on failure to complete a single iteration, 
+	n>0 to indicate success after n interations, or 
+	n<0 to indicate failure after n iterations
+ **/
+static int64 solver_nr_core(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations, bool complex_system)
+{
+	//Internal iteration counter - just NR limits
+	int64 Iteration;
+
+	//File pointer for debug outputs
+	FILE *FPoutVal;
+
+	//A matrix size variable
+	unsigned int size_Amatrix;
+
+	//Voltage mismatch tracking variable
+	double Maxmismatch;
+
+	//Saturation mismatch tracking variable
+	bool SaturationMismatchPresent;
+	int func_result_val;
+
+	//Phase collapser variable
+	unsigned char phase_worka, phase_workb, phase_workc, phase_workd, phase_worke;
+
+	//Miscellaneous index variable
+	unsigned int indexer, tempa, tempb, jindexer, kindexer;
+	char jindex, kindex;
+	char temp_index, temp_index_b;
+	unsigned int temp_index_c;
+
+	//Working matrix for admittance collapsing/determinations
+	complex tempY[3][3];
+
+	//Working matrix for mesh fault impedance storage, prior to "reconstruction"
+	double temp_z_store[6][6];
+
+	//Miscellaneous flag variables
+	bool Full_Mat_A, Full_Mat_B;
+
+	//Iteration flag
+	bool newiter;
+
+	//Deltamode pass flag - changes how SWING buses are handled
+	//Multiple SWING-bus attached generators may cause issues, but no good way to detect
+	bool swing_is_a_swing;
+
+	//Deltamode initial dynamics run - swing convergence flag (symmetry)
+	bool swing_converged;
+
+	//Deltamode intermediate variables
+	complex temp_complex_0, temp_complex_1, temp_complex_2, temp_complex_3, temp_complex_4, temp_complex_5;
+	complex aval, avalsq;
+
+	//Temporary size variable
+	char temp_size, temp_size_b, temp_size_c;
+
+	//Temporary admittance variables
+	complex Temp_Ad_A[3][3];
+	complex Temp_Ad_B[3][3];
+
+	//DV checking array
+	complex DVConvCheck[3];
+	double CurrConvVal;
+
+	//Miscellaneous counter tracker
+	unsigned int index_count = 0;
+
+	//SuperLU variables
+	SuperMatrix L_LU,U_LU;
+	NCformat *Astore;
+	DNformat *Bstore;
+	int nnz, info;
+	unsigned int m,n;
+	double *sol_LU;
+	bool kept_step, complex_step, real_values_ready;
+
+	//Per-bus assembly loop values
+	NR_ASSEMBLY_DATA assembly_data;
+	complex *bus_V;
+
+	//Spare notation variable - for output
+	SP_E *temp_element;
+
+	//Compressed-column scatter map flag
+	bool scatter_ready;
+
+	//Admittance change tracking
+	NR_ADMIT_STATE *admit;
+	NRADMITUPDATE admit_update;
+	unsigned int delta_index;
+	bool track_delta;
+	
+#ifndef MT
+	superlu_options_t options;	//Additional variables for sequential superLU
+	SuperLUStat_t stat;
+#endif
+
+	//Ensure bad computations flag is set first
+	*bad_computations = false;
+
+	//Determine special circumstances of SWING bus -- do we want it to truly participate right
+	if (powerflow_type != PF_NORMAL)
+	{
+		if (powerflow_type == PF_DYNCALC)	//Parse the list -- anything that is a swing and a generator, deflag it out of principle (and to make it work right)
+		{
+			//Set the master swing flag
+			swing_is_a_swing = false;
+
+			//Check the buses
+			for (indexer=0; indexer<bus_count; indexer++)
+			{
+				//See if we're a swing-flagged bus
+				if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))
+				{
+					//See if we're "generator ready"
+					if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+					{
+						//Deflag us back to "PQ" status
+						bus[indexer].swing_functions_enabled = false;
+					}
+				}
+				//Default else -- normal bus
+			}//End bus traversion loop
+		}//Handle running dynamics differently
+		else	//Must be PF_DYNINIT
+		{
+			//Flag us as true, initially
+			swing_is_a_swing = true;
+		}
+	}//End not normal
+	else	//Must be normal
+	{
+		swing_is_a_swing = true;	//Flag as a swing, even though this shouldn't do anything
+	}
+
+	//Populate aval, if necessary
+	if (powerflow_type == PF_DYNINIT)
+	{
+		//Conversion variables - 1@120-deg
+		aval = complex(-0.5,(sqrt(3.0)/2.0));
+		avalsq = aval*aval;	//squared value is used a couple places too
+	}
+	else	//Zero it, just in case something uses it (what would???)
+	{
+		aval = 0.0;
+		avalsq = 0.0;
+	}
+
+	if (matrix_solver_method==MM_EXTERN)
+	{
+		//Call the initialization routine
+		ext_solver_glob_vars = ((void *(*)(void *))(LUSolverFcns.ext_init))(ext_solver_glob_vars);
+
+		//Make sure it worked (allocation check)
+		if (ext_solver_glob_vars==NULL)
+		{
+			GL_THROW("External LU matrix solver failed to allocate memory properly!");
+			/*  TROUBLESHOOT
+			While attempting to allocate memory for the external LU solver, an error occurred.
+			Please try again.  If the error persists, ensure your external LU solver is behaving correctly
+			and coordinate with their development team as necessary.
+			*/
+		}
+	}
+
+	if (NR_admit_change)	//If an admittance update was detected, fix it
+	{
+		//Build the diagnoal elements of the bus admittance matrix - this should only happen once no matter what
+		if (powerflow_values->BA_diag == NULL)
+		{
+			powerflow_values->BA_diag = (Bus_admit *)gl_malloc(bus_count *sizeof(Bus_admit));   //BA_diag store the location and value of diagonal elements of Bus Admittance matrix
+
+			//Make sure it worked
+			if (powerflow_values->BA_diag == NULL)
+			{
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+				/*  TROUBLESHOOT
+				During the allocation stage of the NR algorithm, one of the matrices failed to be allocated.
+				Please try again and if this bug persists, submit your code and a bug report using the trac
+				website.
+				*/
+			}
+		}
+
+		//See how much of it actually needs rebuilding
+		admit = solver_nr_admit_alloc(powerflow_values,bus_count,branch_count);
+		admit_update = solver_nr_admit_compare(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type);
+
+		//Changes are only tracked entry by entry if the kept factors are going to be corrected for them
+		track_delta = ((admit_update == NRA_VALUES) && (NR_admit_lowrank == true) && (NR_kept.valid == true) && (NR_kept.owner == powerflow_values));
+		admit->delta_count = 0;
+		
+		for (indexer=0; indexer<bus_count; indexer++) // Construct the diagonal elements of Bus admittance matrix.
+		{
+			//Same layout - only the buses on changed branches need their self admittance again
+			if (admit_update != NRA_FULL)
+			{
+				if (admit->bus_touched[indexer] == 0)
+					continue;
+
+				admit->BA_prev[indexer] = powerflow_values->BA_diag[indexer];
+				index_count = bus[indexer].Matrix_Loc;
+			}
+
+			//Determine the size we need
+			if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase
+				powerflow_values->BA_diag[indexer].size = 2;
+			else										//Other cases, figure out how big they are
+			{
+				phase_worka = 0;
+				for (jindex=0; jindex<3; jindex++)		//Accumulate number of phases
+				{
+					phase_worka += ((bus[indexer].phases & (0x01 << jindex)) >> jindex);
+				}
+				powerflow_values->BA_diag[indexer].size = phase_worka;
+			}
+
+			//Ensure the admittance matrix is zeroed
+			for (jindex=0; jindex<3; jindex++)
+			{
+				for (kindex=0; kindex<3; kindex++)
+				{
+					powerflow_values->BA_diag[indexer].Y[jindex][kindex] = 0;
+					tempY[jindex][kindex] = 0;
+				}
+			}
+
+			//If we're in any deltamode, store out self-admittance as well, if it exists
+			if ((powerflow_type!=PF_NORMAL) && (bus[indexer].full_Y != NULL))
+			{
+				//Loop and add
+				for (jindex=0; jindex<3; jindex++)
+				{
+					for (kindex=0; kindex<3; kindex++)
+					{
+						tempY[jindex][kindex] = bus[indexer].full_Y[jindex*3+kindex];	//Adds in any self-admittance terms (generators)
+					}
+				}
+			}
+
+			//Now go through all of the branches to get the self admittance information (hinges on size)
+			for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size);kindexer++)
+			{ 
+				//Assign jindexer as intermediate variable (easier for me this way)
+				jindexer = bus[indexer].Link_Table[kindexer];
+
+				if ((branch[jindexer].from == indexer) || (branch[jindexer].to == indexer))	//Bus is the from or to side of things - not sure how it would be in link table otherwise, but meh
+				{
+					if ((bus[indexer].phases & 0x07) == 0x07)		//Full three phase
+					{
+						for (jindex=0; jindex<3; jindex++)	//Add in all three phase values
+						{
+							//See if this phase is valid
+							phase_workb = 0x04 >> jindex;
+
+							if ((phase_workb & branch[jindexer].phases) == phase_workb)
+							{
+								for (kindex=0; kindex<3; kindex++)
+								{
+									//Check phase
+									phase_workd = 0x04 >> kindex;
+
+									if ((phase_workd & branch[jindexer].phases) == phase_workd)
+									{
+										if (branch[jindexer].from == indexer)	//We're the from version
+										{
+											tempY[jindex][kindex] += branch[jindexer].YSfrom[jindex*3+kindex];
+										}
+										else									//Must be the to version
+										{
+											tempY[jindex][kindex] += branch[jindexer].YSto[jindex*3+kindex];
+										}
+									}//End valid column phase
+								}
+							}//End valid row phase
+						}
+					}
+					else if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase - add in 2x2 element to upper left 2x2
+					{
+						if (branch[jindexer].from == indexer)	//From branch
+						{
+							//End of SPCT transformer requires slightly different Diagonal components (so when it's the To bus of SPCT and from for other triplex
+							if ((bus[indexer].phases & 0x20) == 0x20)	//Special case
+							{
+								//Other triplexes need to be negated to match sign conventions
+								tempY[0][0] -= branch[jindexer].YSfrom[0];
+								tempY[0][1] -= branch[jindexer].YSfrom[1];
+								tempY[1][0] -= branch[jindexer].YSfrom[3];
+								tempY[1][1] -= branch[jindexer].YSfrom[4];
+							}
+							else										//Just a normal to bus
+							{
+								tempY[0][0] += branch[jindexer].YSfrom[0];
+								tempY[0][1] += branch[jindexer].YSfrom[1];
+								tempY[1][0] += branch[jindexer].YSfrom[3];
+								tempY[1][1] += branch[jindexer].YSfrom[4];
+							}
+						}
+						else									//To branch
+						{
+							//Replicate the above for SPCT test, in case people put lines in backwards
+							//End of SPCT transformer requires slightly different Diagonal components (so when it's the To bus of SPCT and from for other triplex
+							if (((bus[indexer].phases & 0x20) == 0x20) && (branch[jindexer].lnk_type == 1))	//Special case, but make sure we're not the transformer
+							{
+								tempY[0][0] -= branch[jindexer].YSto[0];
+								tempY[0][1] -= branch[jindexer].YSto[1];
+								tempY[1][0] -= branch[jindexer].YSto[3];
+								tempY[1][1] -= branch[jindexer].YSto[4];
+							}
+							else	//Normal bus - no funky SPCT nonsense
+							{
+								tempY[0][0] += branch[jindexer].YSto[0];
+								tempY[0][1] += branch[jindexer].YSto[1];
+								tempY[1][0] += branch[jindexer].YSto[3];
+								tempY[1][1] += branch[jindexer].YSto[4];
+							}
+						}
+					}
+					else	//We must be a single or two-phase line - always populate the upper left portion of matrix (easier for later)
+					{
+						switch(bus[indexer].phases & 0x07) {
+							case 0x00:	//No phases (we've been faulted out
+								{
+									break;	//Just get us outta here
+								}
+							case 0x01:	//Only C
+								{
+									if ((branch[jindexer].phases & 0x01) == 0x01)	//Phase C valid on branch
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[8];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[8];
+										}
+									}//End valid phase C
+									break;
+								}
+							case 0x02:	//Only B
+								{
+									if ((branch[jindexer].phases & 0x02) == 0x02)	//Phase B valid on branch
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[4];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[4];
+										}
+									}//End valid phase B
+									break;
+								}
+							case 0x03:	//B & C
+								{
+									phase_worka = (branch[jindexer].phases & 0x03);	//Extract branch phases
+
+									if (phase_worka == 0x03)	//Full B & C
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[4];
+											tempY[0][1] += branch[jindexer].YSfrom[5];
+											tempY[1][0] += branch[jindexer].YSfrom[7];
+											tempY[1][1] += branch[jindexer].YSfrom[8];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[4];
+											tempY[0][1] += branch[jindexer].YSto[5];
+											tempY[1][0] += branch[jindexer].YSto[7];
+											tempY[1][1] += branch[jindexer].YSto[8];
+										}
+									}//End valid B & C
+									else if (phase_worka == 0x01)	//Only C branch
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[1][1] += branch[jindexer].YSfrom[8];
+										}
+										else									//To branch
+										{
+											tempY[1][1] += branch[jindexer].YSto[8];
+										}
+									}//end valid C
+									else if (phase_worka == 0x02)	//Only B branch
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[4];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[4];
+										}
+									}//end valid B
+									else	//Must be nothing then - all phases must be faulted, or something
+										;
+									break;
+								}
+							case 0x04:	//Only A
+								{
+									if ((branch[jindexer].phases & 0x04) == 0x04)	//Phase A is valid
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[0];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[0];
+										}
+									}//end valid phase A
+									break;
+								}
+							case 0x05:	//A & C
+								{
+									phase_worka = branch[jindexer].phases & 0x05;	//Extract phases
+
+									if (phase_worka == 0x05)	//Both A & C valid
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[0];
+											tempY[0][1] += branch[jindexer].YSfrom[2];
+											tempY[1][0] += branch[jindexer].YSfrom[6];
+											tempY[1][1] += branch[jindexer].YSfrom[8];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[0];
+											tempY[0][1] += branch[jindexer].YSto[2];
+											tempY[1][0] += branch[jindexer].YSto[6];
+											tempY[1][1] += branch[jindexer].YSto[8];
+										}
+									}//End A & C valid
+									else if (phase_worka == 0x04)	//Only A valid
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[0];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[0];
+										}
+									}//end only A valid
+									else if (phase_worka == 0x01)	//Only C valid
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[1][1] += branch[jindexer].YSfrom[8];
+										}
+										else									//To branch
+										{
+											tempY[1][1] += branch[jindexer].YSto[8];
+										}
+									}//end only C valid
+									else	//No connection - must be faulted
+										;
+									break;
+								}
+							case 0x06:	//A & B
+								{
+									phase_worka = branch[jindexer].phases & 0x06;	//Extract phases
+
+									if (phase_worka == 0x06)	//Valid A & B phase
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[0];
+											tempY[0][1] += branch[jindexer].YSfrom[1];
+											tempY[1][0] += branch[jindexer].YSfrom[3];
+											tempY[1][1] += branch[jindexer].YSfrom[4];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[0];
+											tempY[0][1] += branch[jindexer].YSto[1];
+											tempY[1][0] += branch[jindexer].YSto[3];
+											tempY[1][1] += branch[jindexer].YSto[4];
+										}
+									}//End valid A & B
+									else if (phase_worka == 0x04)	//Only valid A
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[0][0] += branch[jindexer].YSfrom[0];
+										}
+										else									//To branch
+										{
+											tempY[0][0] += branch[jindexer].YSto[0];
+										}
+									}//end valid A
+									else if (phase_worka == 0x02)	//Only valid B
+									{
+										if (branch[jindexer].from == indexer)	//From branch
+										{
+											tempY[1][1] += branch[jindexer].YSfrom[4];
+										}
+										else									//To branch
+										{
+											tempY[1][1] += branch[jindexer].YSto[4];
+										}
+									}//end valid B
+									else	//Default - must be already handled
+										;
+									break;
+								}
+							default:	//How'd we get here?
+								{
+									GL_THROW("Unknown phase connection in NR self admittance diagonal");
+									/*  TROUBLESHOOT
+									An unknown phase condition was encountered in the NR solver when constructing
+									the self admittance diagonal.  Please report this bug and submit your code to 
+									the trac system.
+									*/
+								break;
+								}
+						}	//switch end
+					}	//1 or 2 phase end
+				}	//phase accumulation end
+				else		//It's nothing (no connnection)
+					;
+			}//branch traversion end
+
+			//Store the self admittance into BA_diag.  Also update the indices for possible use later
+			powerflow_values->BA_diag[indexer].col_ind = powerflow_values->BA_diag[indexer].row_ind = index_count;	// Store the row and column starting information (square matrices)
+			bus[indexer].Matrix_Loc = index_count;								//Store our location so we know where we go
+			index_count += powerflow_values->BA_diag[indexer].size;				// Update the index for this matrix's size, so next one is in appropriate place
+
+
+			//Store the admittance values into the BA_diag matrix structure
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)			//Store values - assume square matrix - don't bother parsing what doesn't exist.
+				{
+					powerflow_values->BA_diag[indexer].Y[jindex][kindex] = tempY[jindex][kindex];// Store the self admittance terms.
+				}
+			}
+
+			//Copy values into node-specific link (if needed)
+			if (bus[indexer].full_Y_all != NULL)
+			{
+				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+				{
+					for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)			//Store values - assume square matrix - don't bother parsing what doesn't exist.
+					{
+						bus[indexer].full_Y_all[jindex*3+kindex] = tempY[jindex][kindex];// Store the self admittance terms.
+					}
+				}
+			}//End self-admittance update
+		}//End diagonal construction
+
+		//Partial updates leave the layout where it was
+		if (admit_update != NRA_FULL)
+			index_count = powerflow_values->total_variables;
+
+		//In-place updates need the touched buses' fixed entries to stay where they are too
+		for (indexer=0; (indexer<bus_count) && (admit_update == NRA_VALUES); indexer++)
+		{
+			if (admit->bus_touched[indexer] == 0)
+				continue;
+
+			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+			{
+				for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)
+				{
+					if ((jindex != kindex) && (solver_nr_admit_same_pattern(&powerflow_values->BA_diag[indexer].Y[jindex][kindex],&admit->BA_prev[indexer].Y[jindex][kindex]) == false))
+						admit_update = NRA_BUSES;
+				}
+			}
+
+			if (track_delta == true)
+				solver_nr_admit_delta_diag(admit,&bus[indexer],&powerflow_values->BA_diag[indexer],&admit->BA_prev[indexer]);
+		}
+
+		//Pattern moved after all - the kept factors can't be corrected for it
+		if (admit_update != NRA_VALUES)
+			track_delta = false;
+
+		//Store the size of the diagonal, since it represents how many variables we are solving (useful later)
+		powerflow_values->total_variables=index_count;
+
+		//Check to see if we've exceeded our max.  If so, reallocate!
+		if (powerflow_values->total_variables > powerflow_values->max_total_variables)
+			powerflow_values->NR_realloc_needed = true;
+
+		/// Build the off_diagonal_PQ bus elements of 6n*6n Y_NR matrix.Equation (12). All the value in this part will not be updated at each iteration.
+		//Constructed using sparse methodology, non-zero elements are the only thing considered (and non-PV)
+		//No longer necessarily 6n*6n any more either,
+		powerflow_values->size_offdiag_PQ = 0;
+		for (jindexer=0; jindexer<branch_count;jindexer++)	//Parse all of the branches
+		{
+			tempa  = branch[jindexer].from;
+			tempb  = branch[jindexer].to;
+
+			//Preliminary check to make sure we weren't missed in the initialization
+			if ((bus[tempa].Matrix_Loc == -1) || (bus[tempb].Matrix_Loc == -1))
+			{
+				GL_THROW("An element in NR line:%d was not properly localized");
+				/*  TROUBLESHOOT
+				When parsing the bus list, the Newton-Raphson solver found a bus that did not
+				appear to have a location within the overall admittance/Jacobian matrix.  Please
+				submit this as a bug with your code on the Trac site.
+				*/
+			}
+
+			if (((branch[jindexer].phases & 0x80) == 0x80) && (branch[jindexer].v_ratio==1.0))	//Triplex, but not SPCT
+			{
+				for (jindex=0; jindex<2; jindex++)			//rows
+				{
+					for (kindex=0; kindex<2; kindex++)		//columns
+					{
+						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
+							powerflow_values->size_offdiag_PQ += 1; 
+
+						if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
+							powerflow_values->size_offdiag_PQ += 1; 
+
+						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+							powerflow_values->size_offdiag_PQ += 1; 
+
+						if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+							powerflow_values->size_offdiag_PQ += 1; 
+					}//end columns of split phase
+				}//end rows of split phase
+			}//end traversion of split-phase
+			else											//Three phase or some variety
+			{
+				//Make sure we aren't SPCT, otherwise things get jacked
+				if ((branch[jindexer].phases & 0x80) != 0x80)	//SPCT, but v_ratio not = 1
+				{
+					for (jindex=0; jindex<3; jindex++)			//rows
+					{
+						//See if this phase is valid
+						phase_workb = 0x04 >> jindex;
+
+						if ((phase_workb & branch[jindexer].phases) == phase_workb)	//Row check
+						{
+							for (kindex=0; kindex<3; kindex++)		//columns
+							{
+								//Check this phase as well
+								phase_workd = 0x04 >> kindex;
+
+								if ((phase_workd & branch[jindexer].phases) == phase_workd)	//Column validity check
+								{
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
+										powerflow_values->size_offdiag_PQ += 1; 
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
+										powerflow_values->size_offdiag_PQ += 1; 
+
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+										powerflow_values->size_offdiag_PQ += 1; 
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+										powerflow_values->size_offdiag_PQ += 1; 
+								}//end column validity check
+							}//end columns of 3 phase
+						}//End row validity check
+					}//end rows of 3 phase
+				}//end not SPCT
+				else	//SPCT inmplementation
+				{
+					for (jindex=0; jindex<3; jindex++)			//rows
+					{
+						//See if this phase is valid
+						phase_workb = 0x04 >> jindex;
+
+						if ((phase_workb & branch[jindexer].phases) == phase_workb)	//Row check
+						{
+							for (kindex=0; kindex<3; kindex++)		//Row valid, traverse all columns for SPCT Yfrom
+							{
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))
+									powerflow_values->size_offdiag_PQ += 1; 
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+									powerflow_values->size_offdiag_PQ += 1; 
+							}//end columns traverse
+
+							//If row is valid, now traverse the rows of that column for Yto
+							for (kindex=0; kindex<3; kindex++)
+							{
+								if (((branch[jindexer].Yto[kindex*3+jindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))  
+									powerflow_values->size_offdiag_PQ += 1; 
+
+								if (((branch[jindexer].Yto[kindex*3+jindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1)) 
+									powerflow_values->size_offdiag_PQ += 1; 
+							}//end rows traverse
+						}//End row validity check
+					}//end rows of 3 phase
+				}//End SPCT
+			}//end three phase
+		}//end line traversion
+
+		//Allocate the space - double the number found (each element goes in two places)
+		if (powerflow_values->Y_offdiag_PQ == NULL)
+		{
+			powerflow_values->Y_offdiag_PQ = (Y_NR *)gl_malloc((powerflow_values->size_offdiag_PQ*2) *sizeof(Y_NR));   //powerflow_values->Y_offdiag_PQ store the row,column and value of off_diagonal elements of Bus Admittance matrix in which all the buses are not PV buses. 
+
+			//Make sure it worked
+			if (powerflow_values->Y_offdiag_PQ == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+
+			//Save our size
+			powerflow_values->max_size_offdiag_PQ = powerflow_values->size_offdiag_PQ;	//Don't care about the 2x, since we'll be comparing it against itself
+		}
+		else if (powerflow_values->size_offdiag_PQ > powerflow_values->max_size_offdiag_PQ)	//Something changed and we are bigger!!
+		{
+			//Destroy us!
+			gl_free(powerflow_values->Y_offdiag_PQ);
+
+			//Rebuild us, we have the technology
+			powerflow_values->Y_offdiag_PQ = (Y_NR *)gl_malloc((powerflow_values->size_offdiag_PQ*2) *sizeof(Y_NR));
+
+			//Make sure it worked
+			if (powerflow_values->Y_offdiag_PQ == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+
+			//Store the new size
+			powerflow_values->max_size_offdiag_PQ = powerflow_values->size_offdiag_PQ;
+
+			//Flag for a reallocation
+			powerflow_values->NR_realloc_needed = true;
+		}
+
+		//Keep the entries changed branches had, to see what they changed by
+		delta_index = admit->delta_count;
+		for (jindexer=0; (jindexer<branch_count) && (track_delta == true); jindexer++)
+		{
+			if (admit->branch_changed[jindexer] == 1)
+			{
+				for (indexer=admit->offdiag_start[jindexer]; indexer<admit->offdiag_start[jindexer+1]; indexer++)
+					solver_nr_admit_delta_add(admit,powerflow_values->Y_offdiag_PQ[indexer].row_ind,powerflow_values->Y_offdiag_PQ[indexer].col_ind,-powerflow_values->Y_offdiag_PQ[indexer].Y_value);
+			}
+		}
+
+		indexer = 0;
+		for (jindexer=0; jindexer<branch_count;jindexer++)	//Parse through all of the branches
+		{
+			//Same pattern - only the changed branches are redone, in place
+			if (admit_update == NRA_VALUES)
+			{
+				if (admit->branch_changed[jindexer] == 0)
+					continue;
+
+				indexer = admit->offdiag_start[jindexer];
+			}
+			else
+				admit->offdiag_start[jindexer] = indexer;
+
+			//Extract both ends
+			tempa  = branch[jindexer].from;
+			tempb  = branch[jindexer].to;
+
+			phase_worka = 0;
+			phase_workb = 0;
+			for (jindex=0; jindex<3; jindex++)		//Accumulate number of phases
+			{
+				phase_worka += ((bus[tempa].phases & (0x01 << jindex)) >> jindex);
+				phase_workb += ((bus[tempb].phases & (0x01 << jindex)) >> jindex);
+			}
+
+			if ((phase_worka==3) && (phase_workb==3))	//Both ends are full three phase, normal operations
+			{
+				for (jindex=0; jindex<3; jindex++)		//Loop through rows of admittance matrices				
+				{
+					//See if this row is valid for this branch
+					phase_workd = 0x04 >> jindex;
+
+					if ((branch[jindexer].phases & phase_workd) == phase_workd)	//Validity check
+					{
+						for (kindex=0; kindex<3; kindex++)	//Loop through columns of admittance matrices
+						{
+							//Extract column information
+							phase_worke = 0x04 >> kindex;
+
+							if ((branch[jindexer].phases & phase_worke) == phase_worke)	//Valid column too!
+							{
+								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+									indexer += 1;
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
+									indexer += 1;
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 3;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+							}//End valid column
+						}//column end
+					}//End valid row
+				}//row end
+			}//if all 3 end
+			else if (((bus[tempa].phases & 0x80) == 0x80) || ((bus[tempb].phases & 0x80) == 0x80))	//Someone's a triplex
+			{
+				if (((bus[tempa].phases & 0x80) == 0x80) && ((bus[tempb].phases & 0x80) == 0x80))	//Both are triplex, easy case
+				{
+					for (jindex=0; jindex<2; jindex++)		//Loop through rows of admittance matrices (only 2x2)
+					{
+						for (kindex=0; kindex<2; kindex++)	//Loop through columns of admittance matrices (only 2x2)
+						{
+							//Make sure one end of us isn't a SPCT transformer To node (they are different)
+							if (((bus[tempa].phases & 0x20) & (bus[tempb].phases & 0x20)) == 0x20)	//Both ends are SPCT tos
+							{
+								GL_THROW("NR: SPCT to SPCT via triplex connections are unsupported at this time.");
+								/*  TROUBLESHOOT
+								The Newton-Raphson solve does not currently support running a triplex line between the low-voltage
+								side of two different split-phase center tapped transformers.  This functionality may be added if needed
+								in the future.
+								*/
+							}//end both ends SPCT to
+							else if ((bus[tempa].phases & 0x20) == 0x20)	//From end is a SPCT to
+							{
+								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+							}//end From end SPCT to
+							else if ((bus[tempb].phases & 0x20) == 0x20)	//To end is a SPCT to
+							{
+								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+
+								//Make sure we aren't the transformer
+								if (branch[jindexer].lnk_type == 1)	//We're not, we're a line - proceed
+								{
+
+									//Indices counted out from Self admittance above.  needs doubling due to complex separation
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Im());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yto[jindex*3+kindex]).Im();
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
+										indexer += 1;
+									}
+								}//End SPCT TO bus and we're a line
+								else	//Transformer to - don't do things weird
+								{
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Im());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(branch[jindexer].Yto[jindex*3+kindex]).Im();
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+										indexer += 1;
+									}
+
+									if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
+									{
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
+										indexer += 1;
+
+										powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+										powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+										powerflow_values->Y_offdiag_PQ[indexer].Y_value = ((branch[jindexer].Yto[jindex*3+kindex]).Re());
+										indexer += 1;
+									}
+								}//End SPCT TO and we're the transformer
+							}//end To end SPCT to
+							else											//Plain old ugly line
+							{
+								//Indices counted out from Self admittance above.  needs doubling due to complex separation
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Im());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[jindex*3+kindex]).Im();
+									indexer += 1;
+								}
+
+								if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+
+								if (((branch[jindexer].Yto[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1 && bus[tempb].type != 1))	//To reals
+								{
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;
+									
+									powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + jindex;
+									powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + kindex + 2;
+									powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[jindex*3+kindex]).Re());
+									indexer += 1;	
+								}
+							}//end Normal triplex branch
+						}//column end
+					}//row end
+				}//end both triplexy
+				else if ((bus[tempa].phases & 0x80) == 0x80)	//From is the triplex - this implies transformer with or something, we don't support this
+				{
+					GL_THROW("NR does not support triplex to 3-phase connections.");
+					/*  TROUBLESHOOT
+					The Newton-Raphson solver does not have any implementation elements
+					to support the connection of a split-phase or triplex node to a three-phase
+					node.  The opposite (3-phase to triplex) is available as the split-phase-center-
+					tapped transformer model.  See if that will work for your implementation.
+					*/
+				}//end from triplexy
+				else	//Only option left is the to must be the triplex - implies SPCT xformer - so only one phase on the three-phase side (we just need to figure out where)
+				{
+					//Extract the line phase
+					phase_workc = (branch[jindexer].phases & 0x07);
+
+					//Reset temp_index and size, just in case
+					temp_index = -1;
+					temp_size = -1;
+
+					//Figure out what the offset on the from side is (how many phases and which one we are)
+					switch(bus[tempa].phases & 0x07)
+					{
+						case 0x01:	//C
+							{
+								temp_size = 1;	//Single phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+								{
+									//Only C in the node, so no offset
+									temp_index = 0;
+								}
+								else if (phase_workc==0x02)	//Line is phase B
+								{
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+									/*  TROUBLESHOOT
+									A split-phase, center-tapped transformer in the Newton-Raphson solver is somehow attached
+									to a node that is missing the required phase of the transformer.  This should have been caught.
+									Please submit your code and a bug report using the trac website.
+									*/
+								}
+								else					//Has to be phase A
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+
+								break;
+							}
+						case 0x02:	//B
+							{
+								temp_size = 1;	//Single phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								else if (phase_workc==0x02)	//Line is phase B
+								{
+									//Only B in the node, so no offset
+									temp_index = 0;
+								}
+								else					//Has to be phase A
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+
+								break;
+							}
+						case 0x03:	//BC
+							{
+								temp_size = 2;	//Two phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+								{
+									//BC in the node, so offset by 1
+									temp_index = 1;
+								}
+								else if (phase_workc==0x02)	//Line is phase B
+								{
+									//BC in the node, so offset by 0
+									temp_index = 0;
+								}
+								else					//Has to be phase A
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+
+								break;
+							}
+						case 0x04:	//A
+							{
+								temp_size = 1;	//Single phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								else if (phase_workc==0x02)	//Line is phase B
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								else					//Has to be phase A
+								{
+									//Only A in the node, so no offset
+									temp_index = 0;
+								}
+
+								break;
+							}
+						case 0x05:	//AC
+							{
+								temp_size = 2;	//Two phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+								{
+									//AC in the node, so offset by 1
+									temp_index = 1;
+								}
+								else if (phase_workc==0x02)	//Line is phase B
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								else					//Has to be phase A
+								{
+									//AC in the node, so offset by 0
+									temp_index = 0;
+								}
+
+								break;
+							}
+						case 0x06:	//AB
+							{
+								temp_size = 2;	//Two phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+									GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+								else if (phase_workc==0x02)	//Line is phase B
+								{
+									//BC in the node, so offset by 1
+									temp_index = 1;
+								}
+								else					//Has to be phase A
+								{
+									//AB in the node, so offset by 0
+									temp_index = 0;
+								}
+
+								break;
+							}
+						case 0x07:	//ABC
+							{
+								temp_size = 3;	//Three phase matrix
+
+								if (phase_workc==0x01)	//Line is phase C
+								{
+									//ABC in the node, so offset by 2
+									temp_index = 2;
+								}
+								else if (phase_workc==0x02)	//Line is phase B
+								{
+									//ABC in the node, so offset by 1
+									temp_index = 1;
+								}
+								else					//Has to be phase A
+								{
+									//ABC in the node, so offset by 0
+									temp_index = 0;
+								}
+
+								break;
+							}
+						default:
+							GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+							break;
+					}//end switch
+					if ((temp_index==-1) || (temp_size==-1))	//Should never get here
+						GL_THROW("NR: A center-tapped transformer has an invalid phase matching");
+
+					//Determine first index
+					if (phase_workc==0x01)	//Line is phase C
+					{
+						jindex=2;
+					}//end line C if
+					else if (phase_workc==0x02)	//Line is phase B
+					{
+						jindex=1;
+					}//end line B if
+					else						//Line has to be phase A
+					{
+						jindex=0;
+					}//End line A if
+
+
+					//Indices counted out from Self admittance above.  needs doubling due to complex separation
+					for (kindex=0; kindex<2; kindex++)	//Loop through columns of admittance matrices (only 2x2)
+					{
+
+						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+						{
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Im());
+							indexer += 1;
+							
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yfrom[jindex*3+kindex]).Im();
+							indexer += 1;
+						}
+
+						if (((branch[jindexer].Yto[kindex*3+jindex]).Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+						{
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Im());
+							indexer += 1;
+							
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = (branch[jindexer].Yto[kindex*3+jindex]).Im();
+							indexer += 1;
+						}
+
+						if (((branch[jindexer].Yfrom[jindex*3+kindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+						{
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+							indexer += 1;
+							
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yfrom[jindex*3+kindex]).Re());
+							indexer += 1;	
+						}
+
+						if (((branch[jindexer].Yto[kindex*3+jindex]).Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
+						{
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex + 2;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Re());
+							indexer += 1;
+							
+							powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + kindex;
+							powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + temp_size;
+							powerflow_values->Y_offdiag_PQ[indexer].Y_value = -((branch[jindexer].Yto[kindex*3+jindex]).Re());
+							indexer += 1;	
+						}
+					}//secondary index end
+
+				}//end to triplexy
+			}//end triplex in here
+			else					//Some combination of not-3 phase
+			{
+				//Clear working variables, just in case
+				temp_index = temp_index_b = -1;
+				temp_size = temp_size_b = temp_size_c = -1;
+				Full_Mat_A = Full_Mat_B = false;
+
+				//Intermediate store the admittance matrices so they can be directly indexed later
+				switch(branch[jindexer].phases & 0x07) {
+					case 0x00:	//No phases (open switch or reliability excluded item)
+						{
+							temp_size_c = -99;	//Arbitrary flag
+							break;
+						}
+					case 0x01:	//C only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[8];
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[8];
+							temp_size_c = 1;
+							break;
+						}
+					case 0x02:	//B only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[4];
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[4];
+							temp_size_c = 1;
+							break;
+						}
+					case 0x03:	//BC only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[4];
+							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[5];
+							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[7];
+							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[8];
+							
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[4];
+							Temp_Ad_B[0][1] = branch[jindexer].Yto[5];
+							Temp_Ad_B[1][0] = branch[jindexer].Yto[7];
+							Temp_Ad_B[1][1] = branch[jindexer].Yto[8];
+
+							temp_size_c = 2;
+							break;
+						}
+					case 0x04:	//A only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
+							temp_size_c = 1;
+							break;
+						}
+					case 0x05:	//AC only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
+							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[2];
+							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[6];
+							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[8];
+							
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
+							Temp_Ad_B[0][1] = branch[jindexer].Yto[2];
+							Temp_Ad_B[1][0] = branch[jindexer].Yto[6];
+							Temp_Ad_B[1][1] = branch[jindexer].Yto[8];
+
+							temp_size_c = 2;
+							break;
+						}
+					case 0x06:	//AB only
+						{
+							Temp_Ad_A[0][0] = branch[jindexer].Yfrom[0];
+							Temp_Ad_A[0][1] = branch[jindexer].Yfrom[1];
+							Temp_Ad_A[1][0] = branch[jindexer].Yfrom[3];
+							Temp_Ad_A[1][1] = branch[jindexer].Yfrom[4];
+							
+							Temp_Ad_B[0][0] = branch[jindexer].Yto[0];
+							Temp_Ad_B[0][1] = branch[jindexer].Yto[1];
+							Temp_Ad_B[1][0] = branch[jindexer].Yto[3];
+							Temp_Ad_B[1][1] = branch[jindexer].Yto[4];
+
+							temp_size_c = 2;
+							break;
+						}
+					default:
+						{
+							break;
+						}
+				}//end line switch/case
+
+				if (temp_size_c==-99)
+				{
+					continue;	//Next iteration of branch loop
+				}
+
+				if (temp_size_c==-1)	//Make sure it is right
+				{
+					GL_THROW("NR: A line's phase was flagged as not full three-phase, but wasn't");
+					/*  TROUBLESHOOT
+					A line inside the powerflow model was flagged as not being full three-phase or
+					triplex in any form.  It failed the other cases though, so it must have been.
+					Please submit your code and a bug report to the trac website.
+					*/
+				}
+
+				//Check the from side and get all appropriate offsets
+				switch(bus[tempa].phases & 0x07) {
+					case 0x01:	//C
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_size = 1;		//Single size
+								temp_index = 0;		//No offset (only 1 big)
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+								/*  TROUBLESHOOT
+								One of the lines in the powerflow model has an invalid phase in
+								reference to its to and from ends.  This should have been caught
+								earlier, so submit your code and a bug report using the trac website.
+								*/
+							}
+							break;
+						}//end 0x01
+					case 0x02:	//B
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_size = 1;		//Single size
+								temp_index = 0;		//No offset (only 1 big)
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x02
+					case 0x03:	//BC
+						{
+							temp_size = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_index = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_index = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
+							{
+								temp_index = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x03
+					case 0x04:	//A
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_size = 1;		//Single size
+								temp_index = 0;		//No offset (only 1 big)
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x04
+					case 0x05:	//AC
+						{
+							temp_size = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_index = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							{
+								temp_index = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x05
+					case 0x06:	//AB
+						{
+							temp_size = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_index = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							{
+								temp_index = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x06
+					case 0x07:	//ABC
+						{
+							temp_size = 3;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_index = 2;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_index = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
+							{
+								temp_index = 1;
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							{
+								temp_index = 0;
+								Full_Mat_A = true;		//Flag so we know C needs to be gapped
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							{
+								temp_index = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x07
+					default:
+						{
+							break;
+						}
+				}//End switch/case for from
+
+				//Check the to side and get all appropriate offsets
+				switch(bus[tempb].phases & 0x07) {
+					case 0x01:	//C
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_size_b = 1;		//Single size
+								temp_index_b = 0;		//No offset (only 1 big)
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+								/*  TROUBLESHOOT
+								One of the lines in the powerflow model has an invalid phase in
+								reference to its to and from ends.  This should have been caught
+								earlier, so submit your code and a bug report using the trac website.
+								*/
+							}
+							break;
+						}//end 0x01
+					case 0x02:	//B
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_size_b = 1;		//Single size
+								temp_index_b = 0;		//No offset (only 1 big)
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x02
+					case 0x03:	//BC
+						{
+							temp_size_b = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
 							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
+								temp_index_b = 1;		//offset
 							}
-						case 0x02:	//B
+							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
 							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
+								temp_index_b = 0;		//offset
 							}
-						case 0x03:	//BC
+							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
 							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
+								temp_index_b = 0;
 							}
-						case 0x04:	//A
+							else
 							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
+								GL_THROW("NR: One of the lines has invalid phase parameters");
 							}
-						case 0x05:	//AC
+							break;
+						}//end 0x03
+					case 0x04:	//A
+						{
+							if ((branch[jindexer].phases & 0x07) == 0x04)	//A
 							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
+								temp_size_b = 1;		//Single size
+								temp_index_b = 0;		//No offset (only 1 big)
 							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
+							else
 							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
+								GL_THROW("NR: One of the lines has invalid phase parameters");
 							}
-						default:
 							break;
-					}//end case
-
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						//Defined below
-					}
-
-					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
-
-					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
-						
-				}//End phase traversion
-			}//End delta/wye explicit load update
-		}//end bus traversion for power update
-	
-		// Calculate the mismatch of three phase current injection at each bus (deltaI), 
-		//and store the deltaI in terms of real and reactive value in array powerflow_values->deltaI_NR    
-		if (powerflow_values->deltaI_NR==NULL)
-		{
-			powerflow_values->deltaI_NR = (double *)gl_malloc((2*powerflow_values->total_variables) *sizeof(double));   // left_hand side of equation (11)
-
-			//Make sure it worked
-			if (powerflow_values->deltaI_NR == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
-
-			//Update the max size
-			powerflow_values->max_total_variables = powerflow_values->total_variables;
-		}
-		else if (powerflow_values->NR_realloc_needed)		//Bigger sized (this was checked above)
-		{
-			//Decimate the existing value
-			gl_free(powerflow_values->deltaI_NR);
-
-			//Reallocate it...bigger...faster...stronger!
-			powerflow_values->deltaI_NR = (double *)gl_malloc((2*powerflow_values->total_variables) *sizeof(double));
-
-			//Make sure it worked
-			if (powerflow_values->deltaI_NR == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
-
-			//Store the updated value
-			powerflow_values->max_total_variables = powerflow_values->total_variables;
-		}
-
-		//If we're in PF_DYNINIT mode, initialize the balancing convergence
-		if (powerflow_type == PF_DYNINIT)
-		{
-			swing_converged = true;	//init it to yes, fail by exception, not default
-		}
+						}//end 0x04
+					case 0x05:	//AC
+						{
+							temp_size_b = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_index_b = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index_b = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							{
+								temp_index_b = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x05
+					case 0x06:	//AB
+						{
+							temp_size_b = 2;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_index_b = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index_b = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							{
+								temp_index_b = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x06
+					case 0x07:	//ABC
+						{
+							temp_size_b = 3;	//Size of this matrix's admittance
+							if ((branch[jindexer].phases & 0x07) == 0x01)	//C
+							{
+								temp_index_b = 2;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x02)	//B
+							{
+								temp_index_b = 1;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x03)	//BC
+							{
+								temp_index_b = 1;
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x04)	//A
+							{
+								temp_index_b = 0;		//offset
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x05)	//AC
+							{
+								temp_index_b = 0;
+								Full_Mat_B = true;		//Flag so we know C needs to be gapped
+							}
+							else if ((branch[jindexer].phases & 0x07) == 0x06)	//AB
+							{
+								temp_index_b = 0;
+							}
+							else
+							{
+								GL_THROW("NR: One of the lines has invalid phase parameters");
+							}
+							break;
+						}//end 0x07
+					default:
+						{
+							break;
+						}
+				}//End switch/case for to
 
-		//Compute the calculated loads (not specified) at each bus
-		for (indexer=0; indexer<bus_count; indexer++) //for specific bus k
-		{
-			//Update for generator symmetry - only in static dynamic mode and when SWING is a SWING
-			if ((powerflow_type == PF_DYNINIT) && (swing_is_a_swing==true))
-			{
-				//Secondary check - see if it is even needed - basically built around 3-phase right now
-				if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+				//Make sure everything was set before proceeding
+				if ((temp_index==-1) || (temp_index_b==-1) || (temp_size==-1) || (temp_size_b==-1) || (temp_size_c==-1))
 				{
-					//Form denominator term of Ii, since it won't change
-					temp_complex_1 = (~bus[indexer].V[0]) + (~bus[indexer].V[1])*avalsq + (~bus[indexer].V[2])*aval;
-					
-					//Form up numerator portion that doesn't change (Q and admittance)
-					//Do in parts, just for readability
-					temp_complex_2 = ~bus[indexer].V[0];	//conj(Va)
-					
-					//Row 1 of admittance mult
-					temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2]);
-
-					// Row 1 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus 
-					temp_complex_5 = bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2];
-					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 = bus[indexer].V[0]*temp_complex_4;
-
-					//conj(Vb)
-					temp_complex_2 = ~bus[indexer].V[1];
-
-					//Row 2 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2]);
-					
-					// Row 2 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2];
-					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[1]*temp_complex_4;
-
-					//conj(Vc)
-					temp_complex_2 = ~bus[indexer].V[2];
-
-					//Row 3 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2]);
+					GL_THROW("NR: Failure to construct single/double phase line indices");
+					/*  TROUBLESHOOT
+					A single or double phase line (e.g., just A or AB) has failed to properly initialize all of the indices
+					necessary to form the admittance matrix.  Please submit a bug report, with your code, to the trac site.
+					*/
+				}
 
-					// Row 3 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2];
-					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[2]*temp_complex_4;					
+				if (Full_Mat_A)	//From side is a full ABC and we have AC
+				{
+					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
+					{
+						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
+						{
+							//Indices counted out from Self admittance above.  needs doubling due to complex separation
+							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2 + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
+							}
 
-					//numerator done, except PT portion (add in below - SWING bus is different
+							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2 + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
+								indexer += 1;
+							}
 
-					//On that note, if we are a SWING, zero our PT portion and QT for accumulation
-					if ((bus[indexer].type == 2) && (Iteration>0))
-					{
-						*bus[indexer].PGenTotal = complex(0.0,0.0);
-					}
-				}
-				else	//Not enabled or not "full-Y-ed" - set to zero
-				{
-					temp_complex_0 = 0.0;
-					temp_complex_1 = 0.0;	//Basically a flag to ignore it
-				}
-			}//End PF_DYNINIT and SWING is still the same
+							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2 + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;	
+							}
 
-			for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++) // rows - for specific phase that exists
-			{
-				tempIcalcReal = tempIcalcImag = 0;   
+							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex*2 + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;	
+							}
+						}//column end
+					}//row end
+				}//end full ABC for from AC
 
-				if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase - triplex bus
+				if (Full_Mat_B)	//To side is a full ABC and we have AC
 				{
-					//Two states of triplex bus - To node of SPCT transformer needs to be different
-					//First different - Delta-I and diagonal contributions
-					if ((bus[indexer].phases & 0x20) == 0x20)	//We're the To bus
-					{
-						//Pre-negated due to the nature of how it's calculated (V1 compared to I1)
-						tempPbus =  bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  bus[indexer].QL[jindex];	
-					}
-					else	//We're just a normal triplex bus
-					{
-						//This one isn't negated (normal operations)
-						tempPbus =  -bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  -bus[indexer].QL[jindex];	
-					}//end normal triplex bus
-
-					//Get diagonal contributions - only (& always) 2
-					//Column 1
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Re();// equation (8), the diag elements of bus admittance matrix 
-
-					//Column 2
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Re();// equation (8), the diag elements of bus admittance matrix 
-
-					//Now off diagonals
-					for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)
+					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
 					{
-						//Apply proper index to jindexer (easier to implement this way)
-						jindexer=bus[indexer].Link_Table[kindexer];
-
-						if (branch[jindexer].from == indexer)	//We're the from bus
+						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
 						{
-							if ((bus[indexer].phases & 0x20) == 0x20)	//SPCT from bus - needs different signage
+							//Indices counted out from Self admittance above.  needs doubling due to complex separation
+							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
 							{
-								work_vals_char_0 = jindex*3;
-
-								//This situation can only be a normal line (triplex will never be the from for another type)
-								//Again only, & always 2 columns (just do them explicitly)
-								//Column 1
-								tempIcalcReal += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-
-								//Column2
-								tempIcalcReal += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2 + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
+							}
 
-							}//End SPCT To bus - from diagonal contributions
-							else		//Normal line connection to normal triplex
+							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
 							{
-								work_vals_char_0 = jindex*3;
-								//This situation can only be a normal line (triplex will never be the from for another type)
-								//Again only, & always 2 columns (just do them explicitly)
-								//Column 1
-								tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-
-								//Column2
-								tempIcalcReal += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2 + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
+								indexer += 1;
+							}
 
-							}//end normal triplex from
-						}//end from bus
-						else if (branch[jindexer].to == indexer)	//We're the to bus
-						{
-							if (branch[jindexer].v_ratio != 1.0)	//Transformer
+							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
 							{
-								//Only a single contributor on the from side - figure out how to get to it
-								if ((branch[jindexer].phases & 0x01) == 0x01)	//C
-								{
-									temp_index=2;
-								}
-								else if ((branch[jindexer].phases & 0x02) == 0x02)	//B
-								{
-									temp_index=1;
-								}
-								else if ((branch[jindexer].phases & 0x04) == 0x04)	//A
-								{
-									temp_index=0;
-								}
-								else	//How'd we get here!?!
-								{
-									GL_THROW("NR: A split-phase transformer appears to have an invalid phase");
-								}
-
-								work_vals_char_0 = jindex*3+temp_index;
-
-								//Perform the update, it only happens for one column (nature of the transformer)
-								tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex*2 + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;	
+							}
 
-							}//end transformer
-							else									//Must be a normal line then
+							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
 							{
-								if ((bus[indexer].phases & 0x20) == 0x20)	//SPCT from bus - needs different signage
-								{
-									work_vals_char_0 = jindex*3;
-									//This case should never really exist, but if someone reverses a secondary or is doing meshed secondaries, it might
-									//Again only, & always 2 columns (just do them explicitly)
-									//Column 1
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-
-									//Column2
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								}//End SPCT To bus - from diagonal contributions
-								else		//Normal line connection to normal triplex
-								{
-									work_vals_char_0 = jindex*3;
-									//Again only, & always 2 columns (just do them explicitly)
-									//Column 1
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-
-									//Column2
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								}//End normal triplex connection
-							}//end normal line
-						}//end to bus
-						else	//We're nothing
-							;
-
-					}//End branch traversion
-
-					//Determine how we are posting this update
-					if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))	//SWING bus is different (when it really is a SWING bus)
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2 + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex*2;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;	
+							}
+						}//column end
+					}//row end
+				}//end full ABC for to AC
+
+				if ((!Full_Mat_A) && (!Full_Mat_B))	//Neither is a full ABC, or we aren't doing AC, so we don't care
+				{
+					for (jindex=0; jindex<temp_size_c; jindex++)		//Loop through rows of admittance matrices				
 					{
-						if ((powerflow_type == PF_DYNINIT) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+						for (kindex=0; kindex<temp_size_c; kindex++)	//Loop through columns of admittance matrices
 						{
-							//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-							work_vals_double_3 = tempPbus - tempIcalcReal;
-							work_vals_double_4 = tempQbus - tempIcalcImag;
-
-							//Form a magnitude vector
-							work_vals_double_0 = sqrt((work_vals_double_3*work_vals_double_3+work_vals_double_4*work_vals_double_4));
-							
-							if (work_vals_double_0 > bus[indexer].max_volt_error)	//Failure check (defaults to voltage convergence for now)
+							//Indices counted out from Self admittance above.  needs doubling due to complex separation
+							if ((Temp_Ad_A[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From imags
 							{
-								swing_converged=false;
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = (Temp_Ad_A[jindex][kindex].Im());
+								indexer += 1;
 							}
-						}//End PF_DYNINIT SWING traversion
 
-						//Must be normal run, since DYNRUN should have swing capabilities deflagged
-						//Normal run - zero it - should already be zerod, but let's be paranoid for now
-						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
-						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
-					}//End SWING bus cases
-					else	//PQ bus or SWING masquerading as a PQ
-					{
-						//It's I.  Just a direct conversion (P changed above to I as well)
-						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = tempPbus - tempIcalcReal;
-						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = tempQbus - tempIcalcImag;
-					}//End Normal PQ bus
-				}//End split-phase present
-				else	//Three phase or some variant thereof
-				{
-					tempPbus =  - bus[indexer].PL[jindex];	//Copy load amounts in
-					tempQbus =  - bus[indexer].QL[jindex];	
+							if ((Temp_Ad_B[jindex][kindex].Im() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To imags
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Im());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = Temp_Ad_B[jindex][kindex].Im();
+								indexer += 1;
+							}
 
-					for (kindex=0; kindex<powerflow_values->BA_diag[indexer].size; kindex++)		//cols - Still only for specified phases
-					{
-						//Determine our indices, based on phase information
-						temp_index = -1;
-						switch(bus[indexer].phases & 0x07) {
-							case 0x01:	//C
-								{
-									temp_index=2;
-									break;
-								}//end 0x01
-							case 0x02:	//B
-								{
-									temp_index=1;
-									break;
-								}//end 0x02
-							case 0x03:	//BC
-								{
-									if (kindex==0)	//B
-										temp_index=1;
-									else	//C
-										temp_index=2;
-									break;
-								}//end 0x03
-							case 0x04:	//A
-								{
-									temp_index=0;
-									break;
-								}//end 0x04
-							case 0x05:	//AC
-								{
-									if (kindex==0)	//A
-										temp_index=0;
-									else			//C
-										temp_index=2;
-									break;
-								}//end 0x05
-							case 0x06:	//AB
-								{
-									if (kindex==0)	//A
-										temp_index=0;
-									else			//B
-										temp_index=1;
-									break;
-								}//end 0x06
-							case 0x07:	//ABC
-								{
-									temp_index = kindex;	//Will loop all 3
-									break;
-								}//end 0x07
-						}//End switch/case
+							if ((Temp_Ad_A[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//From reals
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempa].Matrix_Loc + temp_index + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + kindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_A[jindex][kindex].Re());
+								indexer += 1;	
+							}
 
-						if (temp_index==-1)	//Error check
-						{
-							GL_THROW("NR: A voltage index failed to be found.");
-							/*  TROUBLESHOOT
-							While attempting to compute the calculated power current, a voltage index failed to be
-							resolved.  Please submit your code and a bug report via the trac website.
-							*/
-						}
+							if ((Temp_Ad_B[jindex][kindex].Re() != 0) && (bus[tempa].type != 1) && (bus[tempb].type != 1))	//To reals
+							{
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex + temp_size_b;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;
+								
+								powerflow_values->Y_offdiag_PQ[indexer].row_ind = 2*bus[tempb].Matrix_Loc + temp_index_b + jindex;
+								powerflow_values->Y_offdiag_PQ[indexer].col_ind = 2*bus[tempa].Matrix_Loc + temp_index + kindex + temp_size;
+								powerflow_values->Y_offdiag_PQ[indexer].Y_value = -(Temp_Ad_B[jindex][kindex].Re());
+								indexer += 1;	
+							}
+						}//column end
+					}//row end
+				}//end not full ABC with AC on either side case
+			}//end all others else
+		}//end branch for
 
-						//Normal diagonal contributions
-						tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-						tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+		if (admit_update != NRA_VALUES)
+			admit->offdiag_start[branch_count] = indexer;
 
-						//In-rush load contributions (if any) - only along explicit diagonal
-						if ((bus[indexer].full_Y_load != NULL) && (jindex==kindex))
-						{
-							tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-							tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
-						}
+		//Finish the changes - same entries, same order
+		for (jindexer=0; (jindexer<branch_count) && (track_delta == true); jindexer++)
+		{
+			if (admit->branch_changed[jindexer] == 1)
+			{
+				for (indexer=admit->offdiag_start[jindexer]; indexer<admit->offdiag_start[jindexer+1]; indexer++)
+				{
+					admit->delta[delta_index].Y_value += powerflow_values->Y_offdiag_PQ[indexer].Y_value;
+					delta_index++;
+				}
+			}
+		}
 
-						//Off diagonal contributions
-						//Need another variable to handle the rows
-						temp_index_b = -1;
-						switch(bus[indexer].phases & 0x07) {
-							case 0x01:	//C
-								{
-									temp_index_b=2;
-									break;
-								}//end 0x01
-							case 0x02:	//B
-								{
-									temp_index_b=1;
-									break;
-								}//end 0x02
-							case 0x03:	//BC
-								{
-									if (jindex==0)	//B
-										temp_index_b=1;
-									else	//C
-										temp_index_b=2;
-									break;
-								}//end 0x03
-							case 0x04:	//A
-								{
-									temp_index_b=0;
-									break;
-								}//end 0x04
-							case 0x05:	//AC
-								{
-									if (jindex==0)	//A
-										temp_index_b=0;
-									else			//C
-										temp_index_b=2;
-									break;
-								}//end 0x05
-							case 0x06:	//AB
-								{
-									if (jindex==0)	//A
-										temp_index_b=0;
-									else			//B
-										temp_index_b=1;
-									break;
-								}//end 0x06
-							case 0x07:	//ABC
-								{
-									temp_index_b = jindex;	//Will loop all 3
-									break;
-								}//end 0x07
-						}//End switch/case
+		//Build the fixed part of the diagonal PQ bus elements of 6n*6n Y_NR matrix. This part will not be updated at each iteration. 
+		powerflow_values->size_diag_fixed = 0;
+		for (jindexer=0; jindexer<bus_count;jindexer++) 
+		{
+			for (jindex=0; jindex<3; jindex++)
+			{
+				for (kindex=0; kindex<3; kindex++)
+				{		 
+				  if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)  
+					  powerflow_values->size_diag_fixed += 1; 
+				  if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex) 
+					  powerflow_values->size_diag_fixed += 1; 
+				  else {}
+				 }
+			}
+		}
+		if (powerflow_values->Y_diag_fixed == NULL)
+		{
+			powerflow_values->Y_diag_fixed = (Y_NR *)gl_malloc((powerflow_values->size_diag_fixed*2) *sizeof(Y_NR));   //powerflow_values->Y_diag_fixed store the row,column and value of the fixed part of the diagonal PQ bus elements of 6n*6n Y_NR matrix.
 
-						if (temp_index_b==-1)	//Error check
-						{
-							GL_THROW("NR: A voltage index failed to be found.");
-						}
+			//Make sure it worked
+			if (powerflow_values->Y_diag_fixed == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-						for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)	//Parse through the branch list
-						{
-							//Apply proper index to jindexer (easier to implement this way)
-							jindexer=bus[indexer].Link_Table[kindexer];
+			//Update the max size
+			powerflow_values->max_size_diag_fixed = powerflow_values->size_diag_fixed;
+		}
+		else if (powerflow_values->size_diag_fixed > powerflow_values->max_size_diag_fixed)		//Something changed and we are bigger!!
+		{
+			//Destroy us!
+			gl_free(powerflow_values->Y_diag_fixed);
 
-							if (branch[jindexer].from == indexer) 
-							{
-								//See if we're a triplex transformer (will only occur on the from side)
-								if ((branch[jindexer].phases & 0x80) == 0x80)	//Triplexy
-								{
-									proceed_flag = false;
-									phase_worka = branch[jindexer].phases & 0x07;
+			//Rebuild us, we have the technology
+			powerflow_values->Y_diag_fixed = (Y_NR *)gl_malloc((powerflow_values->size_diag_fixed*2) *sizeof(Y_NR));
 
-									if (kindex==0)	//All of this will only occur the first column iteration
-									{
-										switch (bus[indexer].phases & 0x07)	{
-											case 0x01:	//C
-												{
-													if (phase_worka==0x01)
-														proceed_flag=true;
-													break;
-												}//end 0x01
-											case 0x02:	//B
-												{
-													if (phase_worka==0x02)
-														proceed_flag=true;
-													break;
-												}//end 0x02
-											case 0x03:	//BC
-												{
-													if ((jindex==0) && (phase_worka==0x02))	//First row and is a B
-														proceed_flag=true;
-													else if ((jindex==1) && (phase_worka==0x01))	//Second row and is a C
-														proceed_flag=true;
-													else
-														;
-													break;
-												}//end 0x03
-											case 0x04:	//A
-												{
-													if (phase_worka==0x04)
-														proceed_flag=true;
-													break;
-												}//end 0x04
-											case 0x05:	//AC
-												{
-													if ((jindex==0) && (phase_worka==0x04))	//First row and is a A
-														proceed_flag=true;
-													else if ((jindex==1) && (phase_worka==0x01))	//Second row and is a C
-														proceed_flag=true;
-													else
-														;
-													break;
-												}//end 0x05
-											case 0x06:	//AB - shares with ABC
-											case 0x07:	//ABC 
-												{
-													if ((jindex==0) && (phase_worka==0x04))	//A & first row
-														proceed_flag=true;
-													else if ((jindex==1) && (phase_worka==0x02))	//B & second row
-														proceed_flag=true;
-													else if ((jindex==2) && (phase_worka==0x01))	//C & third row
-														proceed_flag=true;
-													else;
-													break;
-												}//end 0x07
-										}//end switch
-									}//End if kindex==0
-
-									if (proceed_flag)
-									{
-										work_vals_char_0 = temp_index_b*3;
-										//Do columns individually
-										//1
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+			//Make sure it worked
+			if (powerflow_values->Y_diag_fixed == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-										//2
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+			//Store the new size
+			powerflow_values->max_size_diag_fixed = powerflow_values->size_diag_fixed;
 
-									}
-								}//end SPCT transformer
-								else	///Must be a standard line
-								{
-									work_vals_char_0 = temp_index_b*3+temp_index;
-									work_vals_double_0 = (-branch[jindexer].Yfrom[work_vals_char_0]).Re();
-									work_vals_double_1 = (-branch[jindexer].Yfrom[work_vals_char_0]).Im();
-									work_vals_double_2 = (bus[branch[jindexer].to].V[temp_index]).Re();
-									work_vals_double_3 = (bus[branch[jindexer].to].V[temp_index]).Im();
+			//Flag for a reallocation
+			powerflow_values->NR_realloc_needed = true;
+		}
 
-									tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+		//Keep the entries touched buses had, to see what they changed by
+		delta_index = admit->delta_count;
+		for (jindexer=0; (jindexer<bus_count) && (track_delta == true); jindexer++)
+		{
+			if (admit->bus_touched[jindexer] == 1)
+			{
+				for (indexer=admit->diag_fixed_start[jindexer]; indexer<admit->diag_fixed_start[jindexer+1]; indexer++)
+					solver_nr_admit_delta_add(admit,powerflow_values->Y_diag_fixed[indexer].row_ind,powerflow_values->Y_diag_fixed[indexer].col_ind,-powerflow_values->Y_diag_fixed[indexer].Y_value);
+			}
+		}
 
-								}//end standard line
-							}	
-							if  (branch[jindexer].to == indexer)
-							{
-								work_vals_char_0 = temp_index_b*3+temp_index;
-								work_vals_double_0 = (-branch[jindexer].Yto[work_vals_char_0]).Re();
-								work_vals_double_1 = (-branch[jindexer].Yto[work_vals_char_0]).Im();
-								work_vals_double_2 = (bus[branch[jindexer].from].V[temp_index]).Re();
-								work_vals_double_3 = (bus[branch[jindexer].from].V[temp_index]).Im();
+		indexer = 0;
+		for (jindexer=0; jindexer<bus_count;jindexer++)	//Parse through bus list
+		{ 
+			//Same pattern - only the touched buses are redone, in place
+			if (admit_update == NRA_VALUES)
+			{
+				if (admit->bus_touched[jindexer] == 0)
+					continue;
 
-								tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-							}
-							else;
-						}
-					}//end intermediate current for each phase column
+				indexer = admit->diag_fixed_start[jindexer];
+			}
+			else
+				admit->diag_fixed_start[jindexer] = indexer;
 
-					//Determine how we are posting this update
-					if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))	//SWING bus is different (when it really is a SWING bus)
+			for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
+			{
+				for (kindex=0; kindex<powerflow_values->BA_diag[jindexer].size; kindex++)
+				{					
+					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
 					{
-						if ((powerflow_type == PF_DYNINIT) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
-						{
-							//Compute our "power generated" value for this phase - conjugated in formation
-							temp_complex_2 = bus[indexer].V[jindex] * complex(tempIcalcReal,-tempIcalcImag);
+						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
+						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
+						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
+						indexer += 1;
 
-							if (Iteration>0)	//Only update SWING on subsequent passes
-							{
-								//Now add it into the "generation total" for the SWING
-								(*bus[indexer].PGenTotal) += temp_complex_2 - temp_complex_3/3.0; // both PT and QT = Ssource-Sysource = v conj(I) - v conj(ysource v)
-							}
-								
-							//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-							work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
+						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
+						powerflow_values->Y_diag_fixed[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Im();
+						indexer += 1;
+					}
 
-							if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
-							{
-								work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-								work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
-								work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
-								work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
+					if ((powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re() != 0 && bus[jindexer].type != 1 && jindex!=kindex)
+					{
+						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex;
+						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex +powerflow_values->BA_diag[jindexer].size;
+						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
+						indexer += 1;
+						
+						powerflow_values->Y_diag_fixed[indexer].row_ind = 2*powerflow_values->BA_diag[jindexer].row_ind + jindex +powerflow_values->BA_diag[jindexer].size;
+						powerflow_values->Y_diag_fixed[indexer].col_ind = 2*powerflow_values->BA_diag[jindexer].col_ind + kindex;
+						powerflow_values->Y_diag_fixed[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][kindex]).Re();
+						indexer += 1;
+					}
+				}
+			}
+		}//End bus parse for fixed diagonal
 
-								//Form a magnitude value - put in work_vals_double_0, since we're done with it
-								work_vals_double_0 = sqrt((work_vals_double_3*work_vals_double_3+work_vals_double_4*work_vals_double_4));
-							}
-							else	//Would give us a NAN, so it must be out of service or something (case from below - really shouldn't apply to SWING)
-							{
-           						work_vals_double_0 = 0.0;	//Assumes "converged"
-							}
-							
-							if (work_vals_double_0 > bus[indexer].max_volt_error)	//Failure check (defaults to voltage convergence for now)
-							{
-								swing_converged=false;
-							}
-						}//End PF_DYNINIT SWING traversion
+		if (admit_update != NRA_VALUES)
+			admit->diag_fixed_start[bus_count] = indexer;
 
-						//Effectively Zero out the components, regardless of normal run or not
-						//Should already be zerod, but do it again for paranoia sake
-						if (NR_busdata[indexer].BusHistTerm != NULL)	//See if we're "delta-capable"
-						{
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Re();
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Im();
-						}
-						else
-						{
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
-						}
+		//Finish the changes - same entries, same order
+		for (jindexer=0; (jindexer<bus_count) && (track_delta == true); jindexer++)
+		{
+			if (admit->bus_touched[jindexer] == 1)
+			{
+				for (indexer=admit->diag_fixed_start[jindexer]; indexer<admit->diag_fixed_start[jindexer+1]; indexer++)
+				{
+					admit->delta[delta_index].Y_value += powerflow_values->Y_diag_fixed[indexer].Y_value;
+					delta_index++;
+				}
+			}
+		}
 
-						//Saturation skipped for "swing is a swing" case, since it doesn't affect the admittance (no need to offset)
-					}//End SWING bus cases
-					else	//PQ bus or SWING masquerading as a PQ
-					{
-						work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+		//Kept factors either take the changes as a low-rank correction, or describe an admittance that's gone
+		if ((NR_kept.valid == true) && (NR_kept.owner == powerflow_values))
+		{
+			if ((track_delta == false) || (admit_update != NRA_VALUES) || (solver_nr_kept_lowrank_add(admit->delta,admit->delta_count) == false))
+				solver_nr_kept_release();
+			else
+				NR_admit_lowrank_updates++;
+		}
 
-						if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
-						{
-							work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-							work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+		solver_nr_admit_snapshot(bus_count,bus,branch_count,branch,admit,powerflow_type,admit_update);
 
-							//See if deltamode needs to include extra term
-							if (NR_busdata[indexer].BusHistTerm != NULL)
-							{
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) + NR_busdata[indexer].BusHistTerm[jindex].Re() - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) + NR_busdata[indexer].BusHistTerm[jindex].Im() - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
-							}
-							else	//Nope
-							{
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal ; // equation(7), Real part of deltaI, left hand side of equation (11)
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
-							}
+		if (admit_update != NRA_FULL)
+			NR_admit_partial_updates++;
+	}//End admittance update
 
-							//Accumulate in any saturation current values as well, while we're here
-							if (NR_busdata[indexer].BusSatTerm != NULL)
-							{
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Re();
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Im();
-							}
-						}
-						else
-						{
-							if (NR_busdata[indexer].BusHistTerm != NULL)	//See if extra deltamode term needs to be included
-							{
-           						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Re();
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = NR_busdata[indexer].BusHistTerm[jindex].Im();
-							}
-							else
-							{
-           						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + jindex] = 0.0;
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] = 0.0;
-							}
+	//Reset saturation checks
+	SaturationMismatchPresent = false;
 
-							//Accumulate in any saturation current values as well, while we're here
-							if (NR_busdata[indexer].BusSatTerm != NULL)
-							{
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+ powerflow_values->BA_diag[indexer].size + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Re();
-								powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + jindex] -= NR_busdata[indexer].BusSatTerm[jindex].Im();
-							}
-						}
-					}//End normal bus handling
-				}//End three-phase or variant thereof
-			}//End delta_I for each phase row
+	//Split the buses into the ranges the per-bus assembly loops work on
+	assembly_data.bus = bus;
+	assembly_data.branch = branch;
+	assembly_data.powerflow_values = powerflow_values;
+	assembly_data.powerflow_type = powerflow_type;
+	assembly_data.aval = aval;
+	assembly_data.avalsq = avalsq;
+	assembly_data.packed = ((powerflow_values->packed != NULL) && (powerflow_values->packed->active == true)) ? powerflow_values->packed : NULL;
+	solver_nr_assembly_setup(bus_count,&assembly_data);
 
-			//Add in generator current amounts, if relevant
-			if (powerflow_type != PF_NORMAL)
-			{
-				//Secondary check - see if it is even needed - basically built around 3-phase right now (checks)
-				if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
-				{
-					if ((bus[indexer].phases & 0x07) == 0x07)	//Make sure is three-phase
-					{
-						//Only update in particular mode - SWING bus values should still be treated as such
-						if ((swing_is_a_swing == true) && (powerflow_type == PF_DYNINIT))	//Really only true for PF_DYNINIT anyways
-						{
-							//Power should be all updated, now update current values
-							temp_complex_0 += complex((*bus[indexer].PGenTotal).Re(),-(*bus[indexer].PGenTotal).Im()); // total generated power injected congugated
+	//Calculate the system load - this is the specified power of the system
+	for (Iteration=0; Iteration<NR_iteration_limit; Iteration++)
+	{
+		//Update the per-iteration assembly values
+		assembly_data.Iteration = Iteration;
+		assembly_data.swing_is_a_swing = swing_is_a_swing;
 
-							//Compute Ii
-							if (temp_complex_1.Mag() > 0.0)	//Non zero
-							{
-								temp_complex_2 = temp_complex_0/temp_complex_1;	//Forms Ii
+		//Only set when this iteration is solved with the kept factorization or the complex formulation
+		kept_step = false;
+		complex_step = false;
 
-								//Now convert Ii to the individual phase amounts
-								bus[indexer].DynCurrent[0] = temp_complex_2;
-								bus[indexer].DynCurrent[1] = temp_complex_2*avalsq;
-								bus[indexer].DynCurrent[2] = temp_complex_2*aval;
-							}
-							else	//Must make zero
-							{
-								bus[indexer].DynCurrent[0] = complex(0.0,0.0);
-								bus[indexer].DynCurrent[1] = complex(0.0,0.0);
-								bus[indexer].DynCurrent[2] = complex(0.0,0.0);
-							}
-						}//End SWING is still swing, otherwise should just accumulate what it had
+		//System load at each bus is represented by second order polynomial equations
+		solver_nr_assembly_run(solver_nr_load_range);
 
-						//Don't get added in as part of "normal swing" routine
-						if ((bus[indexer].type == 0) || ((bus[indexer].type>1) && (bus[indexer].swing_functions_enabled == false)))
-						{
-							//Add these into the system - added because "generation"
-       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size] += bus[indexer].DynCurrent[0].Re();		//Phase A
-       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + 1] += bus[indexer].DynCurrent[1].Re();	//Phase B
-       						powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size + 2] += bus[indexer].DynCurrent[2].Re();	//Phase C
+		// Calculate the mismatch of three phase current injection at each bus (deltaI), 
+		//and store the deltaI in terms of real and reactive value in array powerflow_values->deltaI_NR    
+		if (powerflow_values->deltaI_NR==NULL)
+		{
+			powerflow_values->deltaI_NR = (double *)gl_malloc((2*powerflow_values->total_variables) *sizeof(double));   // left_hand side of equation (11)
 
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc] += bus[indexer].DynCurrent[0].Im();		//Phase A
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + 1] += bus[indexer].DynCurrent[1].Im();	//Phase B
-							powerflow_values->deltaI_NR[2*bus[indexer].Matrix_Loc + 2] += bus[indexer].DynCurrent[2].Im();	//Phase C
-						}
-						//Defaulted else - leave as they were
-					}//End three-phase
-					else	//Not three-phase athe moment
-					{
-						//See if we ever were (reliability call)
-						if ((bus[indexer].origphases & 0x07) == 0x07)
-						{
-							//Just zero it
-							bus[indexer].DynCurrent[0] = complex(0.0,0.0);
-							bus[indexer].DynCurrent[1] = complex(0.0,0.0);
-							bus[indexer].DynCurrent[2] = complex(0.0,0.0);
-						}
-						else	//Never was, just fail out
-						{
-							GL_THROW("NR_solver: bus:%s has tried updating deltamode dyanmics, but is not three-phase!",bus[indexer].name);
-							/*  TROUBLESHOOT
-							The NR_solver routine tried update a three-phase current value for a bus that is not
-							three phase.  At this time, the deltamode system only supports three-phase buses for
-							generator attachment.
-							*/
-						}
-					}
-				}//End extra current adds
-			}//End dynamic (generator postings)
-		}//End delta_I for each bus
+			//Make sure it worked
+			if (powerflow_values->deltaI_NR == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-		// Calculate the elements of a,b,c,d in equations(14),(15),(16),(17). These elements are used to update the Jacobian matrix.	
-		for (indexer=0; indexer<bus_count; indexer++)
+			//Update the max size
+			powerflow_values->max_total_variables = powerflow_values->total_variables;
+		}
+		else if (powerflow_values->NR_realloc_needed)		//Bigger sized (this was checked above)
 		{
-			if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
-			{
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
-
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+			//Decimate the existing value
+			gl_free(powerflow_values->deltaI_NR);
 
-					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+			//Reallocate it...bigger...faster...stronger!
+			powerflow_values->deltaI_NR = (double *)gl_malloc((2*powerflow_values->total_variables) *sizeof(double));
 
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+			//Make sure it worked
+			if (powerflow_values->deltaI_NR == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-					//Start adjustments - AB
-					if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
+			//Store the updated value
+			powerflow_values->max_total_variables = powerflow_values->total_variables;
+		}
 
-					//Start adjustments - BC
-					if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[1] = 0.0;
-					}
+		//If we're in PF_DYNINIT mode, initialize the balancing convergence
+		if (powerflow_type == PF_DYNINIT)
+		{
+			swing_converged = true;	//init it to yes, fail by exception, not default
+		}
 
-					//Start adjustments - CA
-					if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[2] = 0.0;
-					}
+		//Compute the calculated loads (not specified) at each bus
+		solver_nr_assembly_run(solver_nr_mismatch_range);
 
-					//See if we have any "different children"
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Create nominal magnitudes
-						adjust_nominal_voltage_val = bus[indexer].volt_base;
+		//Collect the balancing convergence of each range
+		if (powerflow_type == PF_DYNINIT)
+		{
+			for (kindexer=0; kindexer<NR_assembly_chunk_count; kindexer++)
+			{
+				if (NR_assembly_chunks[kindexer].swing_converged == false)
+					swing_converged = false;
+			}
+		}
 
-						//Create the nominal voltage vectors
-						adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-						adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-						adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
+		// Calculate the elements of a,b,c,d in equations(14),(15),(16),(17). These elements are used to update the Jacobian matrix.	
+		solver_nr_assembly_run(solver_nr_jacobian_range);
 
-						//Get magnitudes of all
-						adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-						adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-						adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+		//Build the dynamic diagnal elements of 6n*6n Y matrix. All the elements in this part will be updated at each iteration.
+		unsigned int size_diag_update = 0;
+		kindexer = 0;	//Assembly range tracker
+		for (jindexer=0; jindexer<bus_count;jindexer++) 
+		{
+			//Note where each assembly range starts in Y_diag_update
+			if ((kindexer < NR_assembly_chunk_count) && (jindexer == NR_assembly_chunks[kindexer].bus_start))
+			{
+				NR_assembly_chunks[kindexer].diag_update_start = 4*size_diag_update;
+				kindexer++;
+			}
 
-						//Start adjustments - A
-						if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[3] = 0.0;
-						}
+			if  (bus[jindexer].type != 1)	//PV bus ignored (for now?)
+				size_diag_update += powerflow_values->BA_diag[jindexer].size; 
+			//Defaulted else - PV bus ignored
+		}
+		
+		if (powerflow_values->Y_diag_update == NULL)
+		{
+			powerflow_values->Y_diag_update = (Y_NR *)gl_malloc((4*size_diag_update) *sizeof(Y_NR));   //powerflow_values->Y_diag_update store the row,column and value of the dynamic part of the diagonal PQ bus elements of 6n*6n Y_NR matrix.
 
-						//Start adjustments - B
-						if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[4] = 0.0;
-						}
+			//Make sure it worked
+			if (powerflow_values->Y_diag_update == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-						//Start adjustments - C
-						if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[5] = 0.0;
-						}
-					}
-					else	//Nope
-					{
-						//Set to zero, just cause
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}
-				else	//"Normal" modes -- handle traditionally
-				{
-					adjusted_constant_current[0] = bus[indexer].I[0];
-					adjusted_constant_current[1] = bus[indexer].I[1];
-					adjusted_constant_current[2] = bus[indexer].I[2];
+			//Update maximum size
+			powerflow_values->max_size_diag_update = size_diag_update;
+		}
+		else if (size_diag_update > powerflow_values->max_size_diag_update)	//We've exceeded our limits
+		{
+			//Disappear the old one
+			gl_free(powerflow_values->Y_diag_update);
 
-					//See if we have different children too
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Store them too
-						adjusted_constant_current[3] = bus[indexer].extra_var[6];
-						adjusted_constant_current[4] = bus[indexer].extra_var[7];
-						adjusted_constant_current[5] = bus[indexer].extra_var[8];
-					}
-					else	//Nope, just zero this for now
-					{
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}//End adjustment code
+			//Make a new one in its image
+			powerflow_values->Y_diag_update = (Y_NR *)gl_malloc((4*size_diag_update) *sizeof(Y_NR));
 
-				//Delta components - populate according to what is there
-				if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
-				{
-					//Voltage calculations
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+			//Make sure it worked
+			if (powerflow_values->Y_diag_update == NULL)
+				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S[0]/voltageDel[0]);
+			//Update the size
+			powerflow_values->max_size_diag_update = size_diag_update;
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[0] += voltageDel[0] * (bus[indexer].Y[0]);
+			//Flag for a realloc
+			powerflow_values->NR_realloc_needed = true;
+		}
 
-				}
-				else
-				{
-					//Zero values - they shouldn't be used anyhow
-					voltageDel[0] = 0.0;
-					delta_current[0] = 0.0;
-				}
+		//Each range fills its own entries, starting at the positions noted above
+		solver_nr_assembly_run(solver_nr_diag_update_range);
 
-				if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
-				{
-					//Voltage calculations
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+		// Build the Amatrix, Amatrix includes all the elements of Y_offdiag_PQ, Y_diag_fixed and Y_diag_update.
+		size_Amatrix = powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2 + 4*size_diag_update;
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S[1]/voltageDel[1]);
+		//Test to make sure it isn't an empty matrix - reliability induced 3-phase fault
+		if (size_Amatrix==0)
+		{
+			gl_warning("Empty powerflow connectivity matrix, your system is empty!");
+			/*  TROUBLESHOOT
+			Newton-Raphson has an empty admittance matrix that it is trying to solve.  Either the whole system
+			faulted, or something is not properly defined.  Please try again.  If the problem persists, please
+			submit your code and a bug report via the trac website.
+			*/
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[1] += voltageDel[1] * (bus[indexer].Y[1]);
+			*bad_computations = false;	//Ensure output is flagged ok
+			return 0;					//Just return some arbitrary value - not technically bad
+		}
 
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[1] = 0.0;
-					delta_current[1] = 0.0;
-				}
+		//Reuse the compressed-column pattern of the last build when nothing structural could have changed - the
+		//triplets are still checked against it below.  The matrix dump and external solvers need the full build
+		scatter_ready = ((matrix_solver_method==MM_SUPERLU) && (NRMatDumpMethod == MD_NONE) && (powerflow_values->NR_realloc_needed == false) && (powerflow_values->size_Amatrix_scatter == size_Amatrix));
 
-				if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
-				{
-					//Voltage calculations
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+		if (scatter_ready == false)
+			solver_nr_sparse_build(powerflow_values,size_Amatrix);
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S[2]/voltageDel[2]);
+		//See if we want to dump out the matrix values
+		if (NRMatDumpMethod != MD_NONE)
+		{
+			//Code to export the sparse matrix values - useful for debugging issues
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[2] += voltageDel[2] * (bus[indexer].Y[2]);
+			//Check our frequency
+			if ((NRMatDumpMethod == MD_ALL) || ((NRMatDumpMethod != MD_ALL) && (Iteration == 0)))
+			{
+				//Open the text file - append now
+				FPoutVal=fopen(MDFileName,"at");
 
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[2] = 0.0;
-					delta_current[2] = 0.0;
-				}
-				
-				//Convert delta-current into a phase current, where appropriate - reuse temp variable
-				//Everything will be accumulated into the "current" field for ease (including differents)
-				if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+				//See if we wanted references - Only do this once per call, regardless (keeps file size down)
+				if ((NRMatReferences == true) && (Iteration == 0))
 				{
-					undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+					//Print the index information
+					fprintf(FPoutVal,"Matrix Index information for this call - start,stop,name\n");
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+					for (indexer=0; indexer<bus_count; indexer++)
 					{
-						//Power values
-						undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus[indexer].V[0]);
-
-						//Shunt values
-						undeltacurr[0] += bus[indexer].extra_var[3]*bus[indexer].V[0];
+						//Extract the start/stop indices
+						jindexer = 2*bus[indexer].Matrix_Loc;
+						kindexer = jindexer + 2*powerflow_values->BA_diag[indexer].size - 1;
 
-						//Current values
-						undeltacurr[0] += adjusted_constant_current[3];
+						//Print them out
+						fprintf(FPoutVal,"%d,%d,%s\n",jindexer,kindexer,bus[indexer].name);
 					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[0] = 0.0;
-				}
-
-				if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
-				{
-					undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
-					{
-						//Power values
-						undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus[indexer].V[1]);
+					//Add in a blank line so it looks pretty
+					fprintf(FPoutVal,"\n");
+				}//End print the references
 
-						//Shunt values
-						undeltacurr[1] += bus[indexer].extra_var[4]*bus[indexer].V[1];
+				//Print the simulation time and iteration number
+				fprintf(FPoutVal,"Timestamp: %lld - Iteration %lld\n",gl_globalclock,Iteration);
 
-						//Current values
-						undeltacurr[1] += adjusted_constant_current[4];
-					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[1] = 0.0;
-				}
+				//Print size - for parsing ease
+				fprintf(FPoutVal,"Matrix Information - non-zero element count = %d\n",size_Amatrix);
+				
+				//Print the values - printed as "row index, column index, value"
+				//This particular output is after they have been column sorted for the algorithm
+				//Header
+				fprintf(FPoutVal,"Matrix Information - row, column, value\n");
 
+				//Null temp variable
+				temp_element = NULL;
 
-				if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+				//Loop through the columns, extracting starting point each time
+				for (jindexer=0; jindexer<powerflow_values->Y_Amatrix->ncols; jindexer++)
 				{
-					undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+					//Extract the column starting point
+					temp_element = powerflow_values->Y_Amatrix->cols[jindexer];
 
-					//Check for "different" children and apply them, as well
-					if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
+					//Check for nulling
+					if (temp_element != NULL)
 					{
-						//Power values
-						undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus[indexer].V[2]);
+						//Print this value
+						fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
 
-						//Shunt values
-						undeltacurr[2] += bus[indexer].extra_var[5]*bus[indexer].V[2];
+						//Loop
+						while (temp_element->next != NULL)
+						{
+							//Get next element
+							temp_element = temp_element->next;
 
-						//Current values
-						undeltacurr[2] += adjusted_constant_current[5];
+							//Repeat the print
+							fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
+						}
 					}
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[2] = 0.0;
-				}
+					//If it is null, go next.  Implies we have an invalid matrix size, but that may be what we're looking for
+				}//End sparse matrix traversion for dump
 
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+				//Print an extra line, so it looks nice for ALL/PERCALL
+				fprintf(FPoutVal,"\n");
 
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
-					}
+				//Close the file, we're done with it
+				fclose(FPoutVal);
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] = -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] =((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
-					}
-					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
-					{
-						bus[indexer].Jacob_A[temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] = -1e-4;
-						bus[indexer].Jacob_C[temp_index] = -1e-4;
-						bus[indexer].Jacob_D[temp_index] = -1e-4;
-					}
-				}//End phase traversion
-			}//end delta-connected load
-			else if	((bus[indexer].phases & 0x80) == 0x80)	//Split phase computations
-			{
-				//Convert it all back to current (easiest to handle)
-				//Get V12 first
-				voltageDel[0] = bus[indexer].V[0] + bus[indexer].V[1];
-
-				//Start with the currents (just put them in)
-				temp_current[0] = bus[indexer].I[0];
-				temp_current[1] = bus[indexer].I[1];
-				temp_current[2] = *bus[indexer].extra_var; //current12 is not part of the standard current array
-
-				//Add in deltamode unrotated, if necessary
-				if ((bus[indexer].prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
-					temp_current[2] += bus[indexer].prerot_I[2];
-
-				//Now add in power contributions
-				temp_current[0] += bus[indexer].V[0] == 0.0 ? 0.0 : ~(bus[indexer].S[0]/bus[indexer].V[0]);
-				temp_current[1] += bus[indexer].V[1] == 0.0 ? 0.0 : ~(bus[indexer].S[1]/bus[indexer].V[1]);
-				temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus[indexer].S[2]/voltageDel[0]);
-
-				//Last, but not least, admittance/impedance contributions
-				temp_current[0] += bus[indexer].Y[0]*bus[indexer].V[0];
-				temp_current[1] += bus[indexer].Y[1]*bus[indexer].V[1];
-				temp_current[2] += bus[indexer].Y[2]*voltageDel[0];
-
-				//See if we are a house-connected node, if so, adjust and add in those values as well
-				if ((bus[indexer].phases & 0x40) == 0x40)
-				{
-					//Update phase adjustments
-					temp_store[0].SetPolar(1.0,bus[indexer].V[0].Arg());	//Pull phase of V1
-					temp_store[1].SetPolar(1.0,bus[indexer].V[1].Arg());	//Pull phase of V2
-					temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
-
-					//Update these current contributions (use delta current variable, it isn't used in here anyways)
-					delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
-					delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
-					delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
-
-					//Now add it into the current contributions
-					temp_current[0] += delta_current[0];
-					temp_current[1] += delta_current[1];
-					temp_current[2] += delta_current[2];
-				}//End house-attached splitphase
-
-				//Convert 'em to line currents - they need to be negated (due to the convention from earlier)
-				temp_store[0] = -(temp_current[0] + temp_current[2]);
-				temp_store[1] = -(-temp_current[1] - temp_current[2]);
-
-				for (jindex=0; jindex<2; jindex++)
-				{
-					if ((bus[indexer].V[jindex]).Mag()!=0)	//Only current
-					{
-						bus[indexer].Jacob_A[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(37)
-						bus[indexer].Jacob_B[jindex] = -((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(38)
-						bus[indexer].Jacob_C[jindex] =((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(39)
-						bus[indexer].Jacob_D[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(40)
-					}
-					else
-					{
-						bus[indexer].Jacob_A[jindex]=  -1e-4;	//Put very small to avoid singularity issues
-						bus[indexer].Jacob_B[jindex]=  -1e-4;
-						bus[indexer].Jacob_C[jindex]=  -1e-4;
-						bus[indexer].Jacob_D[jindex]=  -1e-4;
-					}
+				//See if we were a "ONCE" - if so, deflag us
+				if (NRMatDumpMethod == MD_ONCE)
+				{
+					NRMatDumpMethod = MD_NONE;	//Flag to do no more
 				}
+			}//End Actual output
+		}//End matrix dump desired
 
-				//Zero the last elements, just to be safe (shouldn't be an issue, but who knows)
-				bus[indexer].Jacob_A[2] = 0.0;
-				bus[indexer].Jacob_B[2] = 0.0;
-				bus[indexer].Jacob_C[2] = 0.0;
-				bus[indexer].Jacob_D[2] = 0.0;
+		///* Initialize parameters. */
+		m = 2*powerflow_values->total_variables;
+		n = 2*powerflow_values->total_variables;
+		nnz = size_Amatrix;
 
-			}//end split-phase connected
-			else	//Wye-connected system/load
+		if (matrices_LU.a_LU == NULL)	//First run
+		{
+			/* Set aside space for the arrays. */
+			matrices_LU.a_LU = (double *) gl_malloc(nnz *sizeof(double));
+			if (matrices_LU.a_LU==NULL)
 			{
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base;
-
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-					adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
-
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
-
-					//Start adjustments - A
-					if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
-
-					//Start adjustments - B
-					if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[1] = 0.0;
-					}
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+				/*  TROUBLESHOOT
+				While attempting to allocate the memory for one of the SuperLU working matrices,
+				an error was encountered and it was not allocated.  Please try again.  If it fails
+				again, please submit your code and a bug report using the trac website.
+				*/
+			}
+			
+			matrices_LU.rows_LU = (int *) gl_malloc(nnz *sizeof(int));
+			if (matrices_LU.rows_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					//Start adjustments - C
-					if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[2] = 0.0;
-					}
+			matrices_LU.cols_LU = (int *) gl_malloc((n+1) *sizeof(int));
+			if (matrices_LU.cols_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					if (bus[indexer].prerot_I[0] != 0.0)
-						adjusted_constant_current[0] += bus[indexer].prerot_I[0];
+			/* Create the right-hand side matrix B. */
+			matrices_LU.rhs_LU = (double *) gl_malloc(m *sizeof(double));
+			if (matrices_LU.rhs_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					if (bus[indexer].prerot_I[1] != 0.0)
-						adjusted_constant_current[1] += bus[indexer].prerot_I[1];
+			if (matrix_solver_method==MM_SUPERLU)
+			{
+				///* Set up the arrays for the permutations. */
+				perm_r = (int *) gl_malloc(m *sizeof(int));
+				if (perm_r == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					if (bus[indexer].prerot_I[2] != 0.0)
-						adjusted_constant_current[2] += bus[indexer].prerot_I[2];
+				perm_c = (int *) gl_malloc(n *sizeof(int));
+				if (perm_c == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					//See if we have any "different children"
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Create nominal magnitudes
-						adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
-
-						//Create the nominal voltage vectors
-						adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-						adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-						adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
-
-						//Compute delta voltages
-						voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-						voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-						voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
-
-						//Get magnitudes of all
-						adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-						adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-						adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-
-						//Start adjustments - AB
-						if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[3] = 0.0;
-						}
+				//Set up storage pointers - single element, but need to be malloced for some reason
+				A_LU.Store = (void *)gl_malloc(sizeof(NCformat));
+				if (A_LU.Store == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-						//Start adjustments - BC
-						if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[4] = 0.0;
-						}
+				B_LU.Store = (void *)gl_malloc(sizeof(DNformat));
+				if (B_LU.Store == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-						//Start adjustments - CA
-						if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-						{
-							//calculate new value
-							adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
-						}
-						else
-						{
-							adjusted_constant_current[5] = 0.0;
-						}
-					}
-					else	//Nope
-					{
-						//Set to zero, just cause
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}
-				else	//"Normal" modes -- handle traditionally
-				{
-					adjusted_constant_current[0] = bus[indexer].I[0];
-					adjusted_constant_current[1] = bus[indexer].I[1];
-					adjusted_constant_current[2] = bus[indexer].I[2];
+				//Populate these structures - A_LU matrix
+				A_LU.Stype = SLU_NC;
+				A_LU.Dtype = SLU_D;
+				A_LU.Mtype = SLU_GE;
+				A_LU.nrow = n;
+				A_LU.ncol = m;
 
-					//See if we have different children too
-					if ((bus[indexer].phases & 0x10) == 0x10)
-					{
-						//Store them too
-						adjusted_constant_current[3] = bus[indexer].extra_var[6];
-						adjusted_constant_current[4] = bus[indexer].extra_var[7];
-						adjusted_constant_current[5] = bus[indexer].extra_var[8];
-					}
-					else	//Nope, just zero this for now
-					{
-						adjusted_constant_current[3] = 0.0;
-						adjusted_constant_current[4] = 0.0;
-						adjusted_constant_current[5] = 0.0;
-					}
-				}//End adjustment code
+				//Populate these structures - B_LU matrix
+				B_LU.Stype = SLU_DN;
+				B_LU.Dtype = SLU_D;
+				B_LU.Mtype = SLU_GE;
+				B_LU.nrow = m;
+				B_LU.ncol = 1;
+			}
+			else if (matrix_solver_method == MM_EXTERN)	//External routine
+			{
+				//Run allocation routine
+				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
+			}
+			else
+			{
+				GL_THROW("Invalid matrix solution method specified for NR solver!");
+				//Defined elsewhere
+			}
 
-				//For Wye-connected, only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
-				{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
-					//Make sure phase combinations exist
-					if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
-					{
-					//Delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+			//Update tracking variable
+			powerflow_values->prev_m = m;
+		}
+		else if (powerflow_values->NR_realloc_needed)	//Something changed, we'll just destroy everything and start over
+		{
+			//Get rid of all of them first
+			gl_free(matrices_LU.a_LU);
+			gl_free(matrices_LU.rows_LU);
+			gl_free(matrices_LU.cols_LU);
+			gl_free(matrices_LU.rhs_LU);
 
-						//Power - put into a current value (iterates less this way)
-						delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
+			if (matrix_solver_method==MM_SUPERLU)
+			{
+				//Free up superLU matrices
+				gl_free(perm_r);
+				gl_free(perm_c);
+			}
+			//Default else - don't care - destructions are presumed to be handled inside external LU's alloc function
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						voltageDel[0] = 0.0;
-						delta_current[0] = 0.0;
-					}
+			/* Set aside space for the arrays. - Copied from above */
+			matrices_LU.a_LU = (double *) gl_malloc(nnz *sizeof(double));
+			if (matrices_LU.a_LU==NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+			
+			matrices_LU.rows_LU = (int *) gl_malloc(nnz *sizeof(int));
+			if (matrices_LU.rows_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					//Check for BC
-					if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
-					{
-						//Delta voltages
-						voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+			matrices_LU.cols_LU = (int *) gl_malloc((n+1) *sizeof(int));
+			if (matrices_LU.cols_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-						//Power - put into a current value (iterates less this way)
-						delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
+			/* Create the right-hand side matrix B. */
+			matrices_LU.rhs_LU = (double *) gl_malloc(m *sizeof(double));
+			if (matrices_LU.rhs_LU == NULL)
+				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						voltageDel[1] = 0.0;
-						delta_current[1] = 0.0;
-					}
+			if (matrix_solver_method==MM_SUPERLU)
+			{
+				///* Set up the arrays for the permutations. */
+				perm_r = (int *) gl_malloc(m *sizeof(int));
+				if (perm_r == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-					//Check for CA
-					if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
-					{
-						//Delta voltages
-						voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				perm_c = (int *) gl_malloc(n *sizeof(int));
+				if (perm_c == NULL)
+					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
 
-						//Power - put into a current value (iterates less this way)
-						delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
+				//Update structures - A_LU matrix
+				A_LU.Stype = SLU_NC;
+				A_LU.Dtype = SLU_D;
+				A_LU.Mtype = SLU_GE;
+				A_LU.nrow = n;
+				A_LU.ncol = m;
 
-						//Convert delta connected load to appropriate Wye 
-						delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
-					}
-					else
-					{
-						//Zero it, for good measure
-						voltageDel[2] = 0.0;
-						delta_current[2] = 0.0;
-					}
+				//Update structures - B_LU matrix
+				B_LU.Stype = SLU_DN;
+				B_LU.Dtype = SLU_D;
+				B_LU.Mtype = SLU_GE;
+				B_LU.nrow = m;
+				B_LU.ncol = 1;
+			}
+			else if (matrix_solver_method == MM_EXTERN)	//External routine
+			{
+				//Run allocation routine
+				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
+			}
+			else
+			{
+				GL_THROW("Invalid matrix solution method specified for NR solver!");
+				//Defined elsewhere
+			}
 
-					//Convert delta-current into a phase current - reuse temp variable
-					undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
-					undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
-					undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
-				}
-				else	//zero the variable so we don't have excessive ifs
-				{
-					undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = 0.0;	//Zero it
-				}
+			//Update tracking variable
+			powerflow_values->prev_m = m;
+		}
+		else if (powerflow_values->prev_m != m)	//Non-reallocing size change occurred
+		{
+			if (matrix_solver_method==MM_SUPERLU)
+			{
+				//Update relevant portions
+				A_LU.nrow = n;
+				A_LU.ncol = m;
 
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+				B_LU.nrow = m;
+			}
+			else if (matrix_solver_method == MM_EXTERN)	//External routine - call full reallocation, just in case
+			{
+				//Run allocation routine
+				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
+			}
+			else
+			{
+				GL_THROW("Invalid matrix solution method specified for NR solver!");
+				//Defined elsewhere
+			}
 
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						/*  TROUBLESHOOT
-						While attempting to calculate the "dynamic" portions of the
-						Jacobian matrix that encompass attached loads, an update failed to process correctly.
-						Submit you code and a bug report using the trac website.
-						*/
-					}
+			//Update tracking variable
+			powerflow_values->prev_m = m;
+		}
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) + (bus[indexer].Y[temp_index_b]).Im();// second part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
-						
-						bus[indexer].Jacob_B[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) + 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
-						
-						bus[indexer].Jacob_C[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Im(),2) - pow((bus[indexer].V[temp_index_b]).Re(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
-						
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Im();// second part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
-					
-					}
-					else
-					{
-						bus[indexer].Jacob_A[temp_index]= (bus[indexer].Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
-						bus[indexer].Jacob_B[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index]= -(bus[indexer].Y[temp_index_b]).Im() - 1e-4;
-					}
-				}//End phase traversion - Wye
-			}//End wye-connected load
+#ifndef MT
+		if (matrix_solver_method==MM_SUPERLU)
+		{
+			/* superLU sequential options*/
+			set_default_options ( &options );
+		}
+		//Default else - not superLU
+#endif
+		
+		//The complex formulation assembles its own system from the triplets - the real values are only needed
+		//here if the pattern changed, or later if the complex step can't be taken
+		if ((complex_system == false) || (scatter_ready == false))
+		{
+			solver_nr_real_fill(powerflow_values,size_Amatrix,4*size_diag_update,scatter_ready);
+			real_values_ready = true;
+		}
+		else
+			real_values_ready = false;
 
-			//Perform delta/wye explicit load updates -- no triplex
-			if ((bus[indexer].phases & 0x80) != 0x80)	//Not triplex
-			{
-				//Delta components - populate according to what is there
-				if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
-				{
-					//Voltage calculations
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+		matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+
+		//Determine how to populate the rhs vector
+		if (mesh_imped_vals == NULL)	//Normal powerflow, copy in the values
+		{
+			for (temp_index_c=0;temp_index_c<m;temp_index_c++)
+			{ 
+				matrices_LU.rhs_LU[temp_index_c] = powerflow_values->deltaI_NR[temp_index_c];
+			}
+		}
+		//Default else -- it is NULL - zero it and "populate it" below
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S_dy[0]/voltageDel[0]);
+		if (matrix_solver_method==MM_SUPERLU)
+		{
+			////* Create Matrix A in the format expected by Super LU.*/
+			//Populate the matrix values (temporary value)
+			Astore = (NCformat*)A_LU.Store;
+			Astore->nnz = nnz;
+			Astore->nzval = matrices_LU.a_LU;
+			Astore->rowind = matrices_LU.rows_LU;
+			Astore->colptr = matrices_LU.cols_LU;
+		    
+			// Create right-hand side matrix B in format expected by Super LU
+			//Populate the matrix (temporary values)
+			Bstore = (DNformat*)B_LU.Store;
+			Bstore->lda = m;
+			Bstore->nzval = matrices_LU.rhs_LU;
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[0] += voltageDel[0] * (bus[indexer].Y_dy[0]);
+			//See how to call the function - if normal mode or not
+			if (mesh_imped_vals != NULL)
+			{
+				//Start with "failure" option on the structure
+				mesh_imped_vals->return_code = 0;
 
+				//Determine the base index (error check)
+				if (mesh_imped_vals->NodeRefNum > 0)
+				{
+					tempa = 2*bus[mesh_imped_vals->NodeRefNum].Matrix_Loc;	//These are already separated into real/imag, so the base is 2x
 				}
-				else
+				else	//Error
 				{
-					//Zero values - they shouldn't be used anyhow
-					voltageDel[0] = 0.0;
-					delta_current[0] = 0.0;
+					gl_error("solver_nr: Node reference for mesh fault calculation was invalid -- it may be a child");
+					/*  TROUBLESHOOT
+					While attempting to compute the equivalent impedance at a mesh faulted node, an invalid node reference
+					was found.  This is likely an internal error to the code -- submit your code and a bug report via the
+					tracking website.
+					*/
+
+					//Set the flags
+					mesh_imped_vals->return_code = 0;
+					*bad_computations = true;
+
+					//Return a 0 to flag
+					return 0;
 				}
 
-				if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+				//Determine our phasing size - what entries to pull - double for the complex notation
+				temp_size = 2*powerflow_values->BA_diag[mesh_imped_vals->NodeRefNum].size;
+
+				//Check for error - size of zero
+				if (temp_size == 0)
 				{
-					//Voltage calculations
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+					gl_error("solver_nr: Mesh fault impedance extract failed - invalid node");
+					/*  TROUBLESHOOT
+					While attempting to extract the mesh fault impedance value, a node with either
+					invalid phasing or no phases (already removed) was somehow flagged.  Please check
+					your file and try again.  If the error persists, please submit your code
+					and a bug report via the ticketing system.
+					*/
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S_dy[1]/voltageDel[1]);
+					//Flags
+					*bad_computations = true;
+					mesh_imped_vals->return_code = 0;
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[1] += voltageDel[1] * (bus[indexer].Y_dy[1]);
+					//Exit
+					return 0;
+				}
+				//Default else -- okay
 
+				//Clear out the output matrix first -- assumes it is 3x3, regardless
+				for (jindex=0; jindex<9; jindex++)
+				{
+					mesh_imped_vals->z_matrix[jindex] = complex(0.0,0.0);
 				}
-				else
+
+				//Zero the double matrix - the big storage (6x6 - re & im split)
+				for (jindex=0; jindex<6; jindex++)
 				{
-					//Zero unused
-					voltageDel[1] = 0.0;
-					delta_current[1] = 0.0;
+					for (kindex=0; kindex<6; kindex++)
+					{
+						temp_z_store[jindex][kindex] = 0.0;
+					}
 				}
 
-				if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+				//Overall loop - for number of phases
+				for (kindex=0; kindex<temp_size; kindex++)
 				{
-					//Voltage calculations
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
 
-					//Power - convert to a current (uses less iterations this way)
-					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S_dy[2]/voltageDel[2]);
+					//Start by zeroing the "solution" vector
+					for (temp_index_c=0;temp_index_c<m;temp_index_c++)
+					{ 
+						matrices_LU.rhs_LU[temp_index_c] = 0.0;
+					}
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[2] += voltageDel[2] * (bus[indexer].Y_dy[2]);
+					//"Identity"-ize the real part of the current index
+					matrices_LU.rhs_LU[tempa + kindex] = 1.0;
 
-				}
-				else
-				{
-					//Zero unused
-					voltageDel[2] = 0.0;
-					delta_current[2] = 0.0;
-				}
+					//Do a solution to get this entry (copied from below - includes "destructors"
+#ifdef MT
+					//superLU_MT commands
 
-				//Populate the values for constant current -- deltamode different right now (all same in future?)
-				if (*bus[indexer].dynamics_enabled == true)
-				{
-					//Create line-line nominal magnitude
-					adjust_nominal_voltage_val = bus[indexer].volt_base;
-					adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
+					//Populate perm_c
+					get_perm_c(1, &A_LU, perm_c);
 
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
-					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
-					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
-					adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
-					adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
-					adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
+					//Solve the system 
+					pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
 
-					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
+					//superLU_MT commands
+					Destroy_SuperNode_SCP(&L_LU);
+					Destroy_CompCol_NCP(&U_LU);
+#else
+					//sequential superLU
 
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+					StatInit ( &stat );
 
-					//Start adjustments - A
-					if ((bus[indexer].I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+					// solve the system
+					dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+
+					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
+					//sequential superLU commands
+					Destroy_SuperNode_Matrix( &L_LU );
+					Destroy_CompCol_Matrix( &U_LU );
+					StatFree ( &stat );
+#endif
+					//Crude superLU checks - see if it is mission accomplished or not
+					if (info != 0)	//Failed inversion, for various reasons
 					{
-						//calculate new value
-						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I_dy[3] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
+						gl_error("solver_nr: superLU failed mesh fault matrix inversion with code %d",info);
+						/*  TROUBLESHOOT
+						superLU failed to invert the equivalent impedance matrix for the mesh fault calculation
+						method.  Please try again and make sure your system is valid.  If the error persists, please
+						submit your code and a bug report via the ticketing system.
+						*/
+
+						//Flag as bad
+						*bad_computations = true;
+						mesh_imped_vals->return_code = 0;
+
+						//Exit
+						return 0;
 					}
-					else
+					//Default else, must have converged!
+
+					//Map up the solution vector
+					sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
+
+					//Extract out this column into the temporary matrix
+					for (jindex=0; jindex<temp_size; jindex++)
 					{
-						adjusted_constant_current[3] = 0.0;
+						temp_z_store[jindex][kindex] = sol_LU[tempa+jindex];
 					}
+				}//End "phase loop" - impedance components are ready
+
+				//Extract the values - do with a massive case/switch, just because
+				switch(bus[mesh_imped_vals->NodeRefNum].phases & 0x07) {
+					case 0x01:	//C
+						{
+							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[1][0],temp_z_store[1][1]);
+							break;
+						}
+					case 0x02:	//B
+						{
+							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[1][0],temp_z_store[1][1]);
+							break;
+						}
+					case 0x03:	//BC
+						{
+							//BB and BC portion
+							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[2][0],temp_z_store[2][2]);
+							mesh_imped_vals->z_matrix[5] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+
+							//CB and CC portion
+							mesh_imped_vals->z_matrix[7] = complex(temp_z_store[3][0],temp_z_store[3][2]);
+							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[3][1],temp_z_store[3][3]);
+							break;
+						}
+					case 0x04:	//A
+						{
+							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[1][0],temp_z_store[1][1]);
+							break;
+						}
+					case 0x05:	//AC
+						{
+							//AA and AC portion
+							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[2][0],temp_z_store[2][2]);
+							mesh_imped_vals->z_matrix[2] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+
+							//CA and CC portion
+							mesh_imped_vals->z_matrix[6] = complex(temp_z_store[3][0],temp_z_store[3][2]);
+							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[3][1],temp_z_store[3][3]);
+							break;
+						}
+					case 0x06:	//AB
+						{
+							//AA and AB portion
+							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[2][0],temp_z_store[2][2]);
+							mesh_imped_vals->z_matrix[1] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+
+							//BA and BB portion
+							mesh_imped_vals->z_matrix[3] = complex(temp_z_store[3][0],temp_z_store[3][2]);
+							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[3][1],temp_z_store[3][3]);
+							break;
+						}
+					case 0x07:	//ABC
+						{
+							//A row
+							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[3][0],temp_z_store[3][3]);
+							mesh_imped_vals->z_matrix[1] = complex(temp_z_store[3][1],temp_z_store[3][4]);
+							mesh_imped_vals->z_matrix[2] = complex(temp_z_store[3][2],temp_z_store[3][5]);
+
+							//B row
+							mesh_imped_vals->z_matrix[3] = complex(temp_z_store[4][0],temp_z_store[4][3]);
+							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[4][1],temp_z_store[4][4]);
+							mesh_imped_vals->z_matrix[5] = complex(temp_z_store[4][2],temp_z_store[4][5]);
+
+							//C row
+							mesh_imped_vals->z_matrix[6] = complex(temp_z_store[5][0],temp_z_store[5][3]);
+							mesh_imped_vals->z_matrix[7] = complex(temp_z_store[5][1],temp_z_store[5][4]);
+							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[5][2],temp_z_store[5][5]);
+							break;
+						}
+					default:	//Not sure how we got here
+						{
+							gl_error("solver_nr: Mesh fault impedance extract failed - invalid node");
+							//Defined above, same message
 
-					//Start adjustments - B
-					if ((bus[indexer].I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I_dy[4] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[4] = 0.0;
-					}
+							//Flags
+							*bad_computations = true;
+							mesh_imped_vals->return_code = 0;
 
-					//Start adjustments - C
-					if ((bus[indexer].I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I_dy[5] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[5] = 0.0;
-					}
+							//Exit
+							return 0;
+						}
+				}//end phase switch/case
 
-					//Start adjustments - AB
-					if ((bus[indexer].I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
-					}
-					else
-					{
-						adjusted_constant_current[0] = 0.0;
-					}
+				//Flag as success
+				*bad_computations = false;
+				mesh_imped_vals->return_code = 1;
 
-					//Start adjustments - BC
-					if ((bus[indexer].I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
-					}
-					else
-					{
-						adjusted_constant_current[1] = 0.0;
-					}
+				//Exit
+				return 1;	//Non-zero, so success (manual checks outside though)
+			}//End "just mesh impedance calculations"
+			else if ((complex_system == true) && (solver_nr_complex_step(bus_count,bus,powerflow_values,4*size_diag_update,m) == true))
+			{
+				//Complex formulation took the step - cleans up after itself
+				info = 0;
+				complex_step = true;
 
-					//Start adjustments - CA
-					if ((bus[indexer].I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
-					}
-					else
-					{
-						adjusted_constant_current[2] = 0.0;
-					}
-				}//End deltamode adjustment
-				else	//Normal mode
+				sol_LU = matrices_LU.rhs_LU;
+			}
+			else if ((complex_system == false) && (NR_kept_first_step == true) && ((Iteration == 0) || ((NR_kept_chord == true) && (Iteration < NR_CHORD_LIMIT))) && (NR_kept.valid == true) && (NR_kept.owner == powerflow_values) && (NR_kept.size == m))
+			{
+				//Predicted start or fast path - reuses the last converged factorization, which picks up the load changes too
+				info = solver_nr_kept_solve(matrices_LU.rhs_LU,m);
+				kept_step = true;
+
+				sol_LU = matrices_LU.rhs_LU;
+			}
+			else	//Nulled, "normal" powerflow
+			{
+				//Complex formulation handed the step back - its values weren't scattered yet
+				if (real_values_ready == false)
 				{
-					//Just copy the values in
-					adjusted_constant_current[0] = bus[indexer].I_dy[0];
-					adjusted_constant_current[1] = bus[indexer].I_dy[1];
-					adjusted_constant_current[2] = bus[indexer].I_dy[2];
-					adjusted_constant_current[3] = bus[indexer].I_dy[3];
-					adjusted_constant_current[4] = bus[indexer].I_dy[4];
-					adjusted_constant_current[5] = bus[indexer].I_dy[5];
+					solver_nr_real_fill(powerflow_values,size_Amatrix,4*size_diag_update,true);
+					real_values_ready = true;
 				}
 
-				//Convert delta-current into a phase current, where appropriate - reuse temp variable
-				//Everything will be accumulated into the "current" field for ease (including differents)
-				if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
-				{
-					undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+#ifdef MT
+				//superLU_MT commands
 
-					//Apply wye-connected loads
+				//Populate perm_c
+				get_perm_c(1, &A_LU, perm_c);
 
-					//Power values
-					undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].S_dy[3]/bus[indexer].V[0]);
+				//Solve the system
+				pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
+#else
+				//sequential superLU
 
-					//Shunt values
-					undeltacurr[0] += bus[indexer].Y_dy[3]*bus[indexer].V[0];
+				StatInit ( &stat );
 
-					//Current values
-					undeltacurr[0] += adjusted_constant_current[3];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[0] = 0.0;
-				}
+				// solve the system
+				dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+#endif
 
-				if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
-				{
-					undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+				sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
+			}
+		}
+		else if (matrix_solver_method==MM_EXTERN)
+		{
+			//General error check right now -- mesh fault current may not work properly
+			if (mesh_imped_vals != NULL)
+			{
+				gl_error("solver_nr: Mesh impedance attempted from unsupported LU solver");
+				/* TROUBLESHOOT
+				The mesh fault current impedance "pull" was selected, but for the external LU
+				solver.  This is unsupported at this time.  To use the mesh fault current capabilities,
+				please use the superLU solver.
+				*/
 
-					//Apply wye-connected loads
+				//Set return code
+				mesh_imped_vals->return_code = 2;
 
-					//Power values
-					undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].S_dy[4]/bus[indexer].V[1]);
+				//Perform the clean up - external LU destructor routing
+				((void (*)(void *, bool))(LUSolverFcns.ext_destroy))(ext_solver_glob_vars,newiter);
 
-					//Shunt values
-					undeltacurr[1] += bus[indexer].Y_dy[4]*bus[indexer].V[1];
+				//Flag bad computations, just because
+				*bad_computations = true;
 
-					//Current values
-					undeltacurr[1] += adjusted_constant_current[4];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[1] = 0.0;
-				}
+				//Exit
+				return 0;
+			}
+			//Default else -- not mesh fault mode, so go like normal
 
-				if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
-				{
-					undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+			//Call the solver
+			info = ((int (*)(void *,NR_SOLVER_VARS *, unsigned int, unsigned int))(LUSolverFcns.ext_solve))(ext_solver_glob_vars,&matrices_LU,n,1);
 
-					//Apply wye-connected loads
+			//Point the solution to the proper place
+			sol_LU = matrices_LU.rhs_LU;
+		}
+		else
+		{
+			GL_THROW("Invalid matrix solution method specified for NR solver!");
+			/*  TROUBLESHOOT
+			An invalid matrix solution method was selected for the Newton-Raphson solver method.
+			Valid options are the superLU solver or an external solver.  Please select one of these methods.
+			*/
+		}
 
-					//Power values
-					undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].S_dy[5]/bus[indexer].V[2]);
+		//Update bus voltages - check convergence while we're here
+		Maxmismatch = 0;
 
-					//Shunt values
-					undeltacurr[2] += bus[indexer].Y_dy[5]*bus[indexer].V[2];
+		temp_index = -1;
+		temp_index_b = -1;
+		newiter = false;	//Reset iteration requester flag - defaults to not needing another
 
-					//Current values
-					undeltacurr[2] += adjusted_constant_current[5];
-				}
-				else
-				{
-					//Zero it, just in case
-					undeltacurr[2] = 0.0;
-				}
+		for (indexer=0; indexer<bus_count; indexer++)
+		{
+			//Avoid swing bus updates on normal runs
+			if ((bus[indexer].type == 0) || ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == false)))
+			{
+				bus_V = (assembly_data.packed != NULL) ? &assembly_data.packed->V[3*indexer] : bus[indexer].V;
 
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+				//Figure out the offset we need to be for each phase
+				if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase
 				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
-
-					if ((temp_index==-1) || (temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
-					}
+					//Pull the two updates (assume split-phase is always 2)
+					DVConvCheck[0]=complex(sol_LU[2*bus[indexer].Matrix_Loc],sol_LU[(2*bus[indexer].Matrix_Loc+2)]);
+					DVConvCheck[1]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+1)],sol_LU[(2*bus[indexer].Matrix_Loc+3)]);
+					bus_V[0] += DVConvCheck[0];
+					bus_V[1] += DVConvCheck[1];	//Negative due to convention
+					
+					//Pull off the magnitude (no sense calculating it twice)
+					CurrConvVal=DVConvCheck[0].Mag();
+					if (CurrConvVal > Maxmismatch)	//Update our convergence check if it is bigger
+						Maxmismatch=CurrConvVal;
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						//Apply as an accumulation, in case any "normal" connections are present too
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
-					}
-					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
-					{
-						bus[indexer].Jacob_A[temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
-					}
+					if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
+						newiter=true;								//Flag that a new iteration must occur
 
-				}//End phase traversion
-			}//End delta/wye explicit loads
+					CurrConvVal=DVConvCheck[1].Mag();
+					if (CurrConvVal > Maxmismatch)	//Update our convergence check if it is bigger
+						Maxmismatch=CurrConvVal;
 
-			//Delta load components  get added to the Jacobian values too -- mostly because this is the most convenient place to do it
-			//See if we're even needed first
-			if (bus[indexer].full_Y_load != NULL)
-			{
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
-				
-				for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)
+					if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
+						newiter=true;								//Flag that a new iteration must occur
+				}//end split phase update
+				else										//Not split phase
 				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
+					for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)	//parse through the phases
+					{
+						switch(bus[indexer].phases & 0x07) {
+							case 0x01:	//C
+								{
+									temp_index=0;
+									temp_index_b=2;
+									break;
+								}
+							case 0x02:	//B
 								{
 									temp_index=0;
 									temp_index_b=1;
+									break;
 								}
-								else			//C
+							case 0x03:	//BC
 								{
-									temp_index=1;
-									temp_index_b=2;
+									if (jindex==0)	//B
+									{
+										temp_index=0;
+										temp_index_b=1;
+									}
+									else			//C
+									{
+										temp_index=1;
+										temp_index_b=2;
+									}
+
+									break;
 								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
+							case 0x04:	//A
 								{
 									temp_index=0;
 									temp_index_b=0;
+									break;
 								}
-								else			//C
+							case 0x05:	//AC
 								{
-									temp_index=1;
-									temp_index_b=2;
+									if (jindex==0)	//A
+									{
+										temp_index=0;
+										temp_index_b=0;
+									}
+									else			//C
+									{
+										temp_index=1;
+										temp_index_b=2;
+									}
+									break;
 								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+							case 0x06:	//AB
+							case 0x07:	//ABC
+								{
+									temp_index = jindex;
+									temp_index_b = jindex;
+									break;
+								}
+						}//end phase switch/case
+
+						if ((temp_index==-1) || (temp_index_b==-1))
+						{
+							GL_THROW("NR: An error occurred indexing voltage updates");
+							/*  TROUBLESHOOT
+							While attempting to create the voltage update indices for the
+							Newton-Raphson solver, an error was encountered.  Please submit
+							your code and a bug report using the trac website.
+							*/
+						}
+
+						DVConvCheck[jindex]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+temp_index)],sol_LU[(2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size+temp_index)]);
+						bus_V[temp_index_b] += DVConvCheck[jindex];
+						
+						//Pull off the magnitude (no sense calculating it twice)
+						CurrConvVal=DVConvCheck[jindex].Mag();
+						if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
+							newiter=true;								//Flag that a new iteration must occur
+
+						if (CurrConvVal > Maxmismatch)	//See if the current differential is the largest found so far or not
+							Maxmismatch = CurrConvVal;	//It is, store it
+
+					}//End For loop for phase traversion
+				}//End not split phase update
+			}//end if not swing
+			else	//So this must be the swing and in a valid interval
+			{
+				temp_index +=2*powerflow_values->BA_diag[indexer].size;	//Increment us for what this bus would have been had it not been a swing
+			}
+		}//End bus traversion
+
+		//Perform saturation current update/convergence check
+		//******************** FIGURE OUT HOW TO DO THIS BETTER - This is very inefficient!***********************//
+		if ((enable_inrush_calculations == true) && (deltatimestep_running > 0))	//Don't even both with this if inrush not on
+		{
+			//Start out assuming the convergence is true (reiter is false)
+			SaturationMismatchPresent = false;
+
+			//Loop through all branches -- inefficient, but meh
+			for (indexer=0; indexer<branch_count; indexer++)
+			{
+				//See if the function exists
+				if (branch[indexer].ExtraDeltaModeFunc != NULL)
+				{
+					//Call the function
+					func_result_val = ((int (*)(OBJECT *,bool *))(*branch[indexer].ExtraDeltaModeFunc))(branch[indexer].obj,&SaturationMismatchPresent);
 
-					if ((temp_index==-1) || (temp_index_b==-1))
+					//Make sure it worked
+					if (func_result_val != 1)
 					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
+						GL_THROW("Extra delta update failed for device %s",branch[indexer].name ? branch[indexer].name : "Unnamed");
+						/*  TROUBLESHOOT
+						While attempting to perform the extra deltamode update, something failed.  Please try again.
+						If the error persists, please submit your code and a bug report via the ticketing system.
+						*/
 					}
+					//Default else -- it worked, keep going
+				}
+				//Default else - is NULL
+			}//End inefficient branch traversion
+		}//End in-rush and deltamode running
 
-					//Accumulate the values
-					bus[indexer].Jacob_A[temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
-					bus[indexer].Jacob_B[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_C[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_D[temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
-				}//End phase traversion
-			}//End deltamode-enabled in-rush loads updates
-		}//end bus traversion for a,b,c, d value computation
+		//Further debug stuff
 
-		//Build the dynamic diagnal elements of 6n*6n Y matrix. All the elements in this part will be updated at each iteration.
-		unsigned int size_diag_update = 0;
-		for (jindexer=0; jindexer<bus_count;jindexer++) 
-		{
-			if  (bus[jindexer].type != 1)	//PV bus ignored (for now?)
-				size_diag_update += powerflow_values->BA_diag[jindexer].size; 
-			//Defaulted else - PV bus ignored
-		}
-		
-		if (powerflow_values->Y_diag_update == NULL)
+		//Additional checks for special modes - only needs to happen in first dynamics powerflow
+		if (powerflow_type == PF_DYNINIT)
 		{
-			powerflow_values->Y_diag_update = (Y_NR *)gl_malloc((4*size_diag_update) *sizeof(Y_NR));   //powerflow_values->Y_diag_update store the row,column and value of the dynamic part of the diagonal PQ bus elements of 6n*6n Y_NR matrix.
+			//See what "mode" we're in
+			if (!newiter)	//Overall powerflow has converged
+			{
+				if (!swing_converged)	//See if deltaI_sym is being met
+				{
+					//Give a verbose message, just cause
+					gl_verbose("NR_Solver: swing bus failed balancing criteria - making it a PQ for future dynamics");
 
-			//Make sure it worked
-			if (powerflow_values->Y_diag_update == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+					//See if we're still swing_is_a_swing mode
+					if (swing_is_a_swing == true)
+					{
+						//Deflag us
+						swing_is_a_swing = false;
 
-			//Update maximum size
-			powerflow_values->max_size_diag_update = size_diag_update;
-		}
-		else if (size_diag_update > powerflow_values->max_size_diag_update)	//We've exceeded our limits
+						//Loop through and deflag appropriate swing buses
+						for (indexer=0; indexer<bus_count; indexer++)
+						{
+							//See if we're a swing-flagged bus
+							if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))
+							{
+								//See if we're "generator ready"
+								if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
+								{
+									//Deflag us back to "PQ" status
+									bus[indexer].swing_functions_enabled = false;
+
+									//Force a reiteration
+									newiter=true;
+								}
+							}
+							//Default else -- normal bus
+						}//End bus traversion loop
+					}
+					//Default else - if we're out of symmetry bounds, but already hit close, good enough
+				}
+				//Defaulted else - we're converged on all fronts, huzzah!
+			}
+			//Default else - still need to iterate
+		}//End special convergence criterion
+
+		//Check Saturation mismatch 
+		if (SaturationMismatchPresent == true)
 		{
-			//Disappear the old one
-			gl_free(powerflow_values->Y_diag_update);
+			//Force a reiter
+			newiter = true;
+		}
+		//Default else -- either no saturation, or it has converged - leave it be
 
-			//Make a new one in its image
-			powerflow_values->Y_diag_update = (Y_NR *)gl_malloc((4*size_diag_update) *sizeof(Y_NR));
+		//Turn off reallocation flag no matter what
+		powerflow_values->NR_realloc_needed = false;
 
-			//Make sure it worked
-			if (powerflow_values->Y_diag_update == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+		if (matrix_solver_method==MM_SUPERLU)
+		{
+			if ((complex_step == false) && (kept_step == false))
+			{
+				//Converged factorizations are kept for the predictor's next first step, the fast path's linear update, or a batch's scenarios
+				if ((complex_system == false) && (newiter == false) && (info == 0) && (powerflow_type == PF_NORMAL) && (NR_kept_hold == false) && ((NR_kept_force == true) || ((NR_predictor != NRP_NONE) && (NR_predictor_correction == true)) || (NR_qsts_fastpath == NRQ_LINEAR)))
+				{
+					solver_nr_kept_store(powerflow_values,&L_LU,&U_LU,m);
+#ifndef MT
+					StatFree ( &stat );
+#endif
+				}
+				else
+				{
+					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
+#ifdef MT
+					//superLU_MT commands
+					Destroy_SuperNode_SCP(&L_LU);
+					Destroy_CompCol_NCP(&U_LU);
+#else
+					//sequential superLU commands
+					Destroy_SuperNode_Matrix( &L_LU );
+					Destroy_CompCol_Matrix( &U_LU );
+					StatFree ( &stat );
+#endif
+				}
+			}
+			//Default else - the complex and kept-factor solves have nothing to destroy
+		}
+		else if (matrix_solver_method==MM_EXTERN)
+		{
+			//Call destruction routine
+			((void (*)(void *, bool))(LUSolverFcns.ext_destroy))(ext_solver_glob_vars,newiter);
+		}
+		else	//Not sure how we get here
+		{
+			GL_THROW("Invalid matrix solution method specified for NR solver!");
+			//Defined above
+		}
 
-			//Update the size
-			powerflow_values->max_size_diag_update = size_diag_update;
+		//Break us out if we are done or are singular		
+		if (( newiter == false ) || (info!=0))
+		{
+			if (newiter == false)
+			{
+				gl_verbose("Power flow calculation converges at Iteration %d \n",Iteration+1);
+			}
+			break;
+		}
+	}	//End iteration loop
 
-			//Flag for a realloc
-			powerflow_values->NR_realloc_needed = true;
+	//Check to see how we are ending
+	if ((Iteration==NR_iteration_limit) && (newiter==true)) //Reached the limit
+	{
+		gl_verbose("Max solver mismatch of failed solution %f\n",Maxmismatch);
+		return -Iteration;
+	}
+	else if (info!=0)	//failure of computations (singular matrix, etc.)
+	{
+		//For superLU - 2 = singular matrix it appears - positive values = process errors (singular, etc), negative values = input argument/syntax error
+		if (matrix_solver_method==MM_SUPERLU)
+		{
+			gl_verbose("superLU failed out with return value %d",info);
 		}
-
-		indexer = 0;	//Rest positional counter
-
-		for (jindexer=0; jindexer<bus_count; jindexer++)	//Parse through bus list
+		else if (matrix_solver_method==MM_EXTERN)
 		{
-			if ((bus[jindexer].type > 1) && (bus[jindexer].swing_functions_enabled == true))	//Swing bus - and we aren't ignoring it
-			{
-				for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-				{
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
-					indexer += 1;
+			gl_verbose("External LU solver failed out with return value %d",info);
+		}
+		//Defaulted else - shouldn't exist (or make it this far), but if it does, we're failing anyways
 
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
-					indexer += 1;
+		*bad_computations = true;	//Flag our output as bad
+		return 0;					//Just return some arbitrary value
+	}
+	else	//Must have converged 
+		return Iteration;
+}
 
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind - powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re();	//Normal admittance portion
-					indexer += 1;
+//Gathers a fixed-size block of values into packed storage - NULL sources (unused terms) are packed as zero
+static void solver_nr_gather(complex *dest, complex *src, unsigned int count)
+{
+	unsigned int index;
 
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = 1e10; // swing bus gets large admittance
-					indexer += 1;
-				}//End swing bus traversion
-			}//End swing bus
+	if (src == NULL)
+	{
+		for (index=0; index<count; index++)
+			dest[index] = 0.0;
+	}
+	else
+	{
+		for (index=0; index<count; index++)
+			dest[index] = src[index];
+	}
+}
 
-			if ((bus[jindexer].type == 0) || ((bus[jindexer].type > 1) && bus[jindexer].swing_functions_enabled == false))	//Only do on PQ (or SWING masquerading as PQ)
-			{
-				for (jindex=0; jindex<powerflow_values->BA_diag[jindexer].size; jindex++)
-				{
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_A[jindex]; // Equation(14)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_B[jindex]; // Equation(15)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_C[jindex]; // Equation(16)
-					indexer += 1;
-					
-					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_D[jindex]; // Equation(17)
-					indexer += 1;
-				}//end PQ phase traversion
-			}//End PQ bus
-		}//End bus parse list
+//Allocates (or grows) the packed bus and branch arrays
+static NR_PACKED_STORAGE *solver_nr_packed_alloc(NR_SOLVER_STRUCT *powerflow_values, unsigned int bus_count, unsigned int branch_count)
+{
+	NR_PACKED_STORAGE *packed = powerflow_values->packed;
 
-		// Build the Amatrix, Amatrix includes all the elements of Y_offdiag_PQ, Y_diag_fixed and Y_diag_update.
-		size_Amatrix = powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2 + 4*size_diag_update;
+	if (packed == NULL)
+	{
+		packed = (NR_PACKED_STORAGE *)gl_malloc(sizeof(NR_PACKED_STORAGE));
 
-		//Test to make sure it isn't an empty matrix - reliability induced 3-phase fault
-		if (size_Amatrix==0)
+		if (packed == NULL)
 		{
-			gl_warning("Empty powerflow connectivity matrix, your system is empty!");
-			/*  TROUBLESHOOT
-			Newton-Raphson has an empty admittance matrix that it is trying to solve.  Either the whole system
-			faulted, or something is not properly defined.  Please try again.  If the problem persists, please
-			submit your code and a bug report via the trac website.
-			*/
-
-			*bad_computations = false;	//Ensure output is flagged ok
-			return 0;					//Just return some arbitrary value - not technically bad
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
 		}
 
-		if (powerflow_values->Y_Amatrix == NULL)
-		{
-			powerflow_values->Y_Amatrix = (SPARSE*) gl_malloc(sizeof(SPARSE));
-
-			//Make sure it worked
-			if (powerflow_values->Y_Amatrix == NULL)
-				GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+		memset(packed,0,sizeof(NR_PACKED_STORAGE));
+		powerflow_values->packed = packed;
+	}
 
-			//Initiliaze it
-			sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
-		}
-		else if (powerflow_values->NR_realloc_needed)	//If one of the above changed, we changed too
+	if (bus_count > packed->max_bus_count)
+	{
+		if (packed->bus_values != NULL)
 		{
-			//Destroy the old version
-			sparse_clear(powerflow_values->Y_Amatrix);
-
-			//Create a new 
-			sparse_init(powerflow_values->Y_Amatrix, size_Amatrix, 6*NR_bus_count);
+			gl_free(packed->bus_values);
+			gl_free(packed->bus_pointers);
 		}
-		else
+
+		//3 each of V, S, Y, I and 6 each of S_dy, Y_dy, I_dy
+		packed->bus_values = (complex *)gl_malloc(30*bus_count*sizeof(complex));
+		packed->bus_pointers = (complex **)gl_malloc(7*bus_count*sizeof(complex *));
+
+		if ((packed->bus_values == NULL) || (packed->bus_pointers == NULL))
 		{
-			//Just clear it out
-			sparse_reset(powerflow_values->Y_Amatrix, 6*NR_bus_count);
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
 		}
 
-		//integrate off diagonal components
-		for (indexer=0; indexer<powerflow_values->size_offdiag_PQ*2; indexer++)
+		packed->V = packed->bus_values;
+		packed->S = packed->V + 3*bus_count;
+		packed->Y = packed->S + 3*bus_count;
+		packed->I = packed->Y + 3*bus_count;
+		packed->S_dy = packed->I + 3*bus_count;
+		packed->Y_dy = packed->S_dy + 6*bus_count;
+		packed->I_dy = packed->Y_dy + 6*bus_count;
+		packed->max_bus_count = bus_count;
+	}
+
+	if (branch_count > packed->max_branch_count)
+	{
+		if (packed->branch_values != NULL)
 		{
-			row = powerflow_values->Y_offdiag_PQ[indexer].row_ind;
-			col = powerflow_values->Y_offdiag_PQ[indexer].col_ind;
-			value = powerflow_values->Y_offdiag_PQ[indexer].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			gl_free(packed->branch_values);
+			gl_free(packed->branch_pointers);
 		}
 
-		//Integrate fixed portions of diagonal components
-		for (indexer=powerflow_values->size_offdiag_PQ*2; indexer< (powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2); indexer++)
+		//Full 3x3 of each of Yfrom, Yto, YSfrom, YSto
+		packed->branch_values = (complex *)gl_malloc(36*branch_count*sizeof(complex));
+		packed->branch_pointers = (complex **)gl_malloc(4*branch_count*sizeof(complex *));
+
+		if ((packed->branch_values == NULL) || (packed->branch_pointers == NULL))
 		{
-			row = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].row_ind;
-			col = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].col_ind;
-			value = powerflow_values->Y_diag_fixed[indexer - powerflow_values->size_offdiag_PQ*2 ].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
 		}
 
-		//Integrate the variable portions of the diagonal components
-		for (indexer=powerflow_values->size_offdiag_PQ*2 + powerflow_values->size_diag_fixed*2; indexer< size_Amatrix; indexer++)
+		packed->Yfrom = packed->branch_values;
+		packed->Yto = packed->Yfrom + 9*branch_count;
+		packed->YSfrom = packed->Yto + 9*branch_count;
+		packed->YSto = packed->YSfrom + 9*branch_count;
+		packed->max_branch_count = branch_count;
+	}
+
+	return packed;
+}
+
+//Copies the object values into the packed arrays and points the solver data at them
+static void solver_nr_packed_gather(NR_PACKED_STORAGE *packed, unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch)
+{
+	unsigned int indexer;
+	complex **saved;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		saved = &packed->bus_pointers[7*indexer];
+		saved[0] = bus[indexer].V;
+		saved[1] = bus[indexer].S;
+		saved[2] = bus[indexer].Y;
+		saved[3] = bus[indexer].I;
+		saved[4] = bus[indexer].S_dy;
+		saved[5] = bus[indexer].Y_dy;
+		saved[6] = bus[indexer].I_dy;
+
+		solver_nr_gather(&packed->V[3*indexer],saved[0],3);
+		solver_nr_gather(&packed->S[3*indexer],saved[1],3);
+		solver_nr_gather(&packed->Y[3*indexer],saved[2],3);
+		solver_nr_gather(&packed->I[3*indexer],saved[3],3);
+		solver_nr_gather(&packed->S_dy[6*indexer],saved[4],6);
+		solver_nr_gather(&packed->Y_dy[6*indexer],saved[5],6);
+		solver_nr_gather(&packed->I_dy[6*indexer],saved[6],6);
+
+		//Leave unused terms NULL so the solver still sees them as absent
+		bus[indexer].V = (saved[0] == NULL) ? NULL : &packed->V[3*indexer];
+		bus[indexer].S = (saved[1] == NULL) ? NULL : &packed->S[3*indexer];
+		bus[indexer].Y = (saved[2] == NULL) ? NULL : &packed->Y[3*indexer];
+		bus[indexer].I = (saved[3] == NULL) ? NULL : &packed->I[3*indexer];
+		bus[indexer].S_dy = (saved[4] == NULL) ? NULL : &packed->S_dy[6*indexer];
+		bus[indexer].Y_dy = (saved[5] == NULL) ? NULL : &packed->Y_dy[6*indexer];
+		bus[indexer].I_dy = (saved[6] == NULL) ? NULL : &packed->I_dy[6*indexer];
+	}
+
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		saved = &packed->branch_pointers[4*indexer];
+		saved[0] = branch[indexer].Yfrom;
+		saved[1] = branch[indexer].Yto;
+		saved[2] = branch[indexer].YSfrom;
+		saved[3] = branch[indexer].YSto;
+
+		solver_nr_gather(&packed->Yfrom[9*indexer],saved[0],9);
+		solver_nr_gather(&packed->Yto[9*indexer],saved[1],9);
+		solver_nr_gather(&packed->YSfrom[9*indexer],saved[2],9);
+		solver_nr_gather(&packed->YSto[9*indexer],saved[3],9);
+
+		branch[indexer].Yfrom = (saved[0] == NULL) ? NULL : &packed->Yfrom[9*indexer];
+		branch[indexer].Yto = (saved[1] == NULL) ? NULL : &packed->Yto[9*indexer];
+		branch[indexer].YSfrom = (saved[2] == NULL) ? NULL : &packed->YSfrom[9*indexer];
+		branch[indexer].YSto = (saved[3] == NULL) ? NULL : &packed->YSto[9*indexer];
+	}
+}
+
+//Writes the solved voltages back to the objects and restores the original pointers
+//Voltages are the only values the solver updates, so nothing else needs scattering
+static void solver_nr_packed_scatter(NR_PACKED_STORAGE *packed, unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch)
+{
+	unsigned int indexer;
+	complex **saved;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		saved = &packed->bus_pointers[7*indexer];
+
+		if (saved[0] != NULL)
 		{
-			row = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].row_ind;
-			col = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].col_ind;
-			value = powerflow_values->Y_diag_update[indexer - powerflow_values->size_offdiag_PQ*2 - powerflow_values->size_diag_fixed*2].Y_value;
-			sparse_add(powerflow_values->Y_Amatrix, row, col, value);
+			saved[0][0] = packed->V[3*indexer];
+			saved[0][1] = packed->V[3*indexer+1];
+			saved[0][2] = packed->V[3*indexer+2];
 		}
 
-		//See if we want to dump out the matrix values
-		if (NRMatDumpMethod != MD_NONE)
-		{
-			//Code to export the sparse matrix values - useful for debugging issues
+		bus[indexer].V = saved[0];
+		bus[indexer].S = saved[1];
+		bus[indexer].Y = saved[2];
+		bus[indexer].I = saved[3];
+		bus[indexer].S_dy = saved[4];
+		bus[indexer].Y_dy = saved[5];
+		bus[indexer].I_dy = saved[6];
+	}
 
-			//Check our frequency
-			if ((NRMatDumpMethod == MD_ALL) || ((NRMatDumpMethod != MD_ALL) && (Iteration == 0)))
-			{
-				//Open the text file - append now
-				FPoutVal=fopen(MDFileName,"at");
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		saved = &packed->branch_pointers[4*indexer];
+		branch[indexer].Yfrom = saved[0];
+		branch[indexer].Yto = saved[1];
+		branch[indexer].YSfrom = saved[2];
+		branch[indexer].YSto = saved[3];
+	}
+}
 
-				//See if we wanted references - Only do this once per call, regardless (keeps file size down)
-				if ((NRMatReferences == true) && (Iteration == 0))
-				{
-					//Print the index information
-					fprintf(FPoutVal,"Matrix Index information for this call - start,stop,name\n");
+/** Newton-Raphson solver entry point
+	When NR_packed_storage is set, the voltages, load components and branch admittances are
+	gathered into contiguous solver-owned arrays before the solve and the voltages are scattered
+	back to the objects afterwards.  The load, mismatch and Jacobian ranges and the voltage update
+	index the packed arrays directly instead of following the per-bus and per-branch pointers.
+	In-rush saturation updates read the node voltages directly, so those solves stay unpacked.
 
-					for (indexer=0; indexer<bus_count; indexer++)
-					{
-						//Extract the start/stop indices
-						jindexer = 2*bus[indexer].Matrix_Loc;
-						kindexer = jindexer + 2*powerflow_values->BA_diag[indexer].size - 1;
+	@return see solver_nr_core
+ **/
+//Runs one solve, gathering into the packed storage first if it is enabled
+static int64 solver_nr_run(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations, bool complex_system)
+{
+	NR_PACKED_STORAGE *packed;
+	int64 result;
 
-						//Print them out
-						fprintf(FPoutVal,"%d,%d,%s\n",jindexer,kindexer,bus[indexer].name);
-					}
+	if ((NR_packed_storage == false) || ((enable_inrush_calculations == true) && (deltatimestep_running > 0)))
+		return solver_nr_core(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,mesh_imped_vals,bad_computations,complex_system);
 
-					//Add in a blank line so it looks pretty
-					fprintf(FPoutVal,"\n");
-				}//End print the references
+	packed = solver_nr_packed_alloc(powerflow_values,bus_count,branch_count);
+	solver_nr_packed_gather(packed,bus_count,bus,branch_count,branch);
+	packed->active = true;
 
-				//Print the simulation time and iteration number
-				fprintf(FPoutVal,"Timestamp: %lld - Iteration %lld\n",gl_globalclock,Iteration);
+	try {
+		result = solver_nr_core(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,mesh_imped_vals,bad_computations,complex_system);
+	}
+	catch (...)
+	{
+		packed->active = false;
+		solver_nr_packed_scatter(packed,bus_count,bus,branch_count,branch);
+		throw;
+	}
 
-				//Print size - for parsing ease
-				fprintf(FPoutVal,"Matrix Information - non-zero element count = %d\n",size_Amatrix);
-				
-				//Print the values - printed as "row index, column index, value"
-				//This particular output is after they have been column sorted for the algorithm
-				//Header
-				fprintf(FPoutVal,"Matrix Information - row, column, value\n");
+	packed->active = false;
+	solver_nr_packed_scatter(packed,bus_count,bus,branch_count,branch);
 
-				//Null temp variable
-				temp_element = NULL;
+	return result;
+}
 
-				//Loop through the columns, extracting starting point each time
-				for (jindexer=0; jindexer<powerflow_values->Y_Amatrix->ncols; jindexer++)
-				{
-					//Extract the column starting point
-					temp_element = powerflow_values->Y_Amatrix->cols[jindexer];
+//Solves with the complex formulation, then again with the real one from the same starting voltages, and compares the two
+static int64 solver_nr_validate(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type, bool *bad_computations)
+{
+	NR_COMPLEX_VARS *complex_vars;
+	unsigned int indexer, worst_bus;
+	int jindex;
+	int64 complex_result, result;
+	bool complex_bad;
+	double diff_val, worst_ratio, worst_diff;
 
-					//Check for nulling
-					if (temp_element != NULL)
-					{
-						//Print this value
-						fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
+	complex_vars = solver_nr_complex_alloc(powerflow_values,0,0);
 
-						//Loop
-						while (temp_element->next != NULL)
-						{
-							//Get next element
-							temp_element = temp_element->next;
+	//Room for the starting voltages and the complex answer - 3 each per bus
+	if (bus_count > complex_vars->max_bus_count)
+	{
+		if (complex_vars->V_saved != NULL)
+			gl_free(complex_vars->V_saved);
 
-							//Repeat the print
-							fprintf(FPoutVal,"%d,%d,%f\n",temp_element->row_ind,jindexer,temp_element->value);
-						}
-					}
-					//If it is null, go next.  Implies we have an invalid matrix size, but that may be what we're looking for
-				}//End sparse matrix traversion for dump
+		complex_vars->V_saved = (complex *)gl_malloc(6*bus_count*sizeof(complex));
 
-				//Print an extra line, so it looks nice for ALL/PERCALL
-				fprintf(FPoutVal,"\n");
+		if (complex_vars->V_saved == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-				//Close the file, we're done with it
-				fclose(FPoutVal);
+		complex_vars->max_bus_count = bus_count;
+	}
 
-				//See if we were a "ONCE" - if so, deflag us
-				if (NRMatDumpMethod == MD_ONCE)
-				{
-					NRMatDumpMethod = MD_NONE;	//Flag to do no more
-				}
-			}//End Actual output
-		}//End matrix dump desired
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		for (jindex=0; jindex<3; jindex++)
+			complex_vars->V_saved[6*indexer+jindex] = bus[indexer].V[jindex];
+	}
 
-		///* Initialize parameters. */
-		m = 2*powerflow_values->total_variables;
-		n = 2*powerflow_values->total_variables;
-		nnz = size_Amatrix;
+	complex_bad = false;
+	complex_result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,NULL,&complex_bad,true);
 
-		if (matrices_LU.a_LU == NULL)	//First run
+	//Keep the complex answer and put the starting voltages back for the real solve
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		for (jindex=0; jindex<3; jindex++)
 		{
-			/* Set aside space for the arrays. */
-			matrices_LU.a_LU = (double *) gl_malloc(nnz *sizeof(double));
-			if (matrices_LU.a_LU==NULL)
-			{
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
-				/*  TROUBLESHOOT
-				While attempting to allocate the memory for one of the SuperLU working matrices,
-				an error was encountered and it was not allocated.  Please try again.  If it fails
-				again, please submit your code and a bug report using the trac website.
-				*/
-			}
-			
-			matrices_LU.rows_LU = (int *) gl_malloc(nnz *sizeof(int));
-			if (matrices_LU.rows_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+			complex_vars->V_saved[6*indexer+3+jindex] = bus[indexer].V[jindex];
+			bus[indexer].V[jindex] = complex_vars->V_saved[6*indexer+jindex];
+		}
+	}
 
-			matrices_LU.cols_LU = (int *) gl_malloc((n+1) *sizeof(int));
-			if (matrices_LU.cols_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	//The real formulation's answer is the one that is kept
+	result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,NULL,bad_computations,false);
 
-			/* Create the right-hand side matrix B. */
-			matrices_LU.rhs_LU = (double *) gl_malloc(m *sizeof(double));
-			if (matrices_LU.rhs_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	//Real formulation failures are reported as normal - negative returns hit the iteration limit, zero converged on the first pass
+	if ((*bad_computations == true) || (result < 0))
+		return result;
 
-			if (matrix_solver_method==MM_SUPERLU)
+	if ((complex_bad == true) || (complex_result < 0))
+	{
+		gl_warning("NR: complex formulation failed to solve where the real formulation converged at iteration %d",(int)result+1);
+		/*  TROUBLESHOOT
+		With NR_formulation set to VALIDATE, the complex form of the Newton-Raphson system did not converge
+		or could not be factored, but the real formulation converged and its answer is kept.  Both formulations
+		take the same Newton-Raphson steps, so this points to a poorly conditioned system.  If the error persists,
+		please submit your code and a bug report via the ticketing system.
+		*/
+	}
+	else
+	{
+		worst_bus = 0;
+		worst_ratio = 0.0;
+		worst_diff = 0.0;
+
+		//Compare against each bus's own convergence limit
+		for (indexer=0; indexer<bus_count; indexer++)
+		{
+			for (jindex=0; jindex<3; jindex++)
 			{
-				///* Set up the arrays for the permutations. */
-				perm_r = (int *) gl_malloc(m *sizeof(int));
-				if (perm_r == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+				diff_val = (bus[indexer].V[jindex] - complex_vars->V_saved[6*indexer+3+jindex]).Mag();
 
-				perm_c = (int *) gl_malloc(n *sizeof(int));
-				if (perm_c == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+				if ((bus[indexer].max_volt_error > 0.0) && ((diff_val / bus[indexer].max_volt_error) > worst_ratio))
+				{
+					worst_ratio = diff_val / bus[indexer].max_volt_error;
+					worst_diff = diff_val;
+					worst_bus = indexer;
+				}
+			}
+		}
 
-				//Set up storage pointers - single element, but need to be malloced for some reason
-				A_LU.Store = (void *)gl_malloc(sizeof(NCformat));
-				if (A_LU.Store == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+		if (worst_ratio > NR_VALIDATE_TOLERANCE)
+		{
+			gl_warning("NR: complex and real formulations differ by %g V at %s, %.1f times its convergence limit",worst_diff,bus[worst_bus].name ? bus[worst_bus].name : "Unnamed",worst_ratio);
+			/*  TROUBLESHOOT
+			With NR_formulation set to VALIDATE, the voltages from the complex form of the Newton-Raphson system
+			were compared against the real formulation, and at least one bus differed by more than its convergence
+			tolerance allows.  The real formulation's voltages are kept.  If the difference is large, please submit
+			your code and a bug report via the ticketing system.
+			*/
+		}
+		else
+		{
+			gl_verbose("NR: complex and real formulations agree to within %g V (%d and %d iterations)",worst_diff,(int)complex_result+1,(int)result+1);
+		}
+	}
 
-				B_LU.Store = (void *)gl_malloc(sizeof(DNformat));
-				if (B_LU.Store == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	return result;
+}
 
-				//Populate these structures - A_LU matrix
-				A_LU.Stype = SLU_NC;
-				A_LU.Dtype = SLU_D;
-				A_LU.Mtype = SLU_GE;
-				A_LU.nrow = n;
-				A_LU.ncol = m;
+//Allocates (or grows) the predictor's voltage history
+static NR_PREDICTOR_HISTORY *solver_nr_predictor_alloc(NR_SOLVER_STRUCT *powerflow_values, unsigned int bus_count)
+{
+	NR_PREDICTOR_HISTORY *history = powerflow_values->predictor;
+	int kindex;
 
-				//Populate these structures - B_LU matrix
-				B_LU.Stype = SLU_DN;
-				B_LU.Dtype = SLU_D;
-				B_LU.Mtype = SLU_GE;
-				B_LU.nrow = m;
-				B_LU.ncol = 1;
-			}
-			else if (matrix_solver_method == MM_EXTERN)	//External routine
-			{
-				//Run allocation routine
-				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
-			}
-			else
-			{
-				GL_THROW("Invalid matrix solution method specified for NR solver!");
-				//Defined elsewhere
-			}
+	if (history == NULL)
+	{
+		history = (NR_PREDICTOR_HISTORY *)gl_malloc(sizeof(NR_PREDICTOR_HISTORY));
 
-			//Update tracking variable
-			powerflow_values->prev_m = m;
+		if (history == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
 		}
-		else if (powerflow_values->NR_realloc_needed)	//Something changed, we'll just destroy everything and start over
+
+		memset(history,0,sizeof(NR_PREDICTOR_HISTORY));
+		history->predicted_time = TS_NEVER;
+		powerflow_values->predictor = history;
+	}
+
+	if (bus_count > history->max_bus_count)
+	{
+		if (history->values != NULL)
+			gl_free(history->values);
+
+		history->values = (complex *)gl_malloc(9*bus_count*sizeof(complex));
+
+		if (history->values == NULL)
 		{
-			//Get rid of all of them first
-			gl_free(matrices_LU.a_LU);
-			gl_free(matrices_LU.rows_LU);
-			gl_free(matrices_LU.cols_LU);
-			gl_free(matrices_LU.rhs_LU);
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-			if (matrix_solver_method==MM_SUPERLU)
-			{
-				//Free up superLU matrices
-				gl_free(perm_r);
-				gl_free(perm_c);
-			}
-			//Default else - don't care - destructions are presumed to be handled inside external LU's alloc function
+		for (kindex=0; kindex<3; kindex++)
+			history->V[kindex] = &history->values[3*bus_count*kindex];
 
-			/* Set aside space for the arrays. - Copied from above */
-			matrices_LU.a_LU = (double *) gl_malloc(nnz *sizeof(double));
-			if (matrices_LU.a_LU==NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
-			
-			matrices_LU.rows_LU = (int *) gl_malloc(nnz *sizeof(int));
-			if (matrices_LU.rows_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+		history->max_bus_count = bus_count;
+		history->count = 0;
+	}
 
-			matrices_LU.cols_LU = (int *) gl_malloc((n+1) *sizeof(int));
-			if (matrices_LU.cols_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	return history;
+}
 
-			/* Create the right-hand side matrix B. */
-			matrices_LU.rhs_LU = (double *) gl_malloc(m *sizeof(double));
-			if (matrices_LU.rhs_LU == NULL)
-				GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+/* Seeds the first solve of a new timestep by extrapolating the voltages of the last converged timesteps.
+   Returns true if the bus voltages were replaced with a prediction */
+static bool solver_nr_predict(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values)
+{
+	NR_PREDICTOR_HISTORY *history = powerflow_values->predictor;
+	TIMESTAMP t_now = gl_globalclock;
+	double weight[3];
+	unsigned int indexer;
+	int order, first, kindex, pindex, jindex;
 
-			if (matrix_solver_method==MM_SUPERLU)
-			{
-				///* Set up the arrays for the permutations. */
-				perm_r = (int *) gl_malloc(m *sizeof(int));
-				if (perm_r == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	if ((history == NULL) || (history->count == 0))
+		return false;
 
-				perm_c = (int *) gl_malloc(n *sizeof(int));
-				if (perm_c == NULL)
-					GL_THROW("NR: One of the SuperLU solver matrices failed to allocate");
+	//Topology changes make the old voltages a poor guide
+	if ((NR_admit_change == true) || (history->bus_count != bus_count))
+	{
+		history->count = 0;
+		return false;
+	}
 
-				//Update structures - A_LU matrix
-				A_LU.Stype = SLU_NC;
-				A_LU.Dtype = SLU_D;
-				A_LU.Mtype = SLU_GE;
-				A_LU.nrow = n;
-				A_LU.ncol = m;
+	//Only the first solve of a new timestep is seeded - later passes start from a converged answer anyway
+	if ((t_now <= history->time[history->count-1]) || (t_now == history->predicted_time))
+		return false;
 
-				//Update structures - B_LU matrix
-				B_LU.Stype = SLU_DN;
-				B_LU.Dtype = SLU_D;
-				B_LU.Mtype = SLU_GE;
-				B_LU.nrow = m;
-				B_LU.ncol = 1;
-			}
-			else if (matrix_solver_method == MM_EXTERN)	//External routine
-			{
-				//Run allocation routine
-				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
-			}
-			else
-			{
-				GL_THROW("Invalid matrix solution method specified for NR solver!");
-				//Defined elsewhere
-			}
+	history->predicted_time = t_now;
 
-			//Update tracking variable
-			powerflow_values->prev_m = m;
-		}
-		else if (powerflow_values->prev_m != m)	//Non-reallocing size change occurred
-		{
-			if (matrix_solver_method==MM_SUPERLU)
-			{
-				//Update relevant portions
-				A_LU.nrow = n;
-				A_LU.ncol = m;
+	order = (NR_predictor == NRP_QUADRATIC) ? 3 : 2;
+	if (history->count < order)
+		order = history->count;
 
-				B_LU.nrow = m;
-			}
-			else if (matrix_solver_method == MM_EXTERN)	//External routine - call full reallocation, just in case
-			{
-				//Run allocation routine
-				((void (*)(void *,unsigned int, unsigned int, bool))(LUSolverFcns.ext_alloc))(ext_solver_glob_vars,n,n,NR_admit_change);
-			}
-			else
-			{
-				GL_THROW("Invalid matrix solution method specified for NR solver!");
-				//Defined elsewhere
-			}
+	//Need at least two points to extrapolate
+	if (order < 2)
+		return false;
 
-			//Update tracking variable
-			powerflow_values->prev_m = m;
-		}
+	first = history->count - order;
 
-#ifndef MT
-		if (matrix_solver_method==MM_SUPERLU)
+	//Don't reach further ahead than the points span - irregular steps (like the first step after a long idle) extrapolate badly
+	if ((t_now - history->time[history->count-1]) > (history->time[history->count-1] - history->time[first]))
+		return false;
+
+	//Lagrange weights of each point at the new time
+	for (kindex=first; kindex<history->count; kindex++)
+	{
+		weight[kindex] = 1.0;
+
+		for (pindex=first; pindex<history->count; pindex++)
 		{
-			/* superLU sequential options*/
-			set_default_options ( &options );
+			if (pindex != kindex)
+				weight[kindex] *= (double)(t_now - history->time[pindex]) / (double)(history->time[kindex] - history->time[pindex]);
 		}
-		//Default else - not superLU
-#endif
-		
-		sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU);
-		matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+	}
 
-		//Determine how to populate the rhs vector
-		if (mesh_imped_vals == NULL)	//Normal powerflow, copy in the values
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		//Swing voltages are set by the swing itself
+		if ((bus[indexer].type == 0) || ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == false)))
 		{
-			for (temp_index_c=0;temp_index_c<m;temp_index_c++)
-			{ 
-				matrices_LU.rhs_LU[temp_index_c] = powerflow_values->deltaI_NR[temp_index_c];
+			for (jindex=0; jindex<3; jindex++)
+			{
+				bus[indexer].V[jindex] = 0.0;
+
+				for (kindex=first; kindex<history->count; kindex++)
+					bus[indexer].V[jindex] += history->V[kindex][3*indexer+jindex] * weight[kindex];
 			}
 		}
-		//Default else -- it is NULL - zero it and "populate it" below
+	}
 
-		if (matrix_solver_method==MM_SUPERLU)
-		{
-			////* Create Matrix A in the format expected by Super LU.*/
-			//Populate the matrix values (temporary value)
-			Astore = (NCformat*)A_LU.Store;
-			Astore->nnz = nnz;
-			Astore->nzval = matrices_LU.a_LU;
-			Astore->rowind = matrices_LU.rows_LU;
-			Astore->colptr = matrices_LU.cols_LU;
-		    
-			// Create right-hand side matrix B in format expected by Super LU
-			//Populate the matrix (temporary values)
-			Bstore = (DNformat*)B_LU.Store;
-			Bstore->lda = m;
-			Bstore->nzval = matrices_LU.rhs_LU;
+	return true;
+}
 
-			//See how to call the function - if normal mode or not
-			if (mesh_imped_vals != NULL)
-			{
-				//Start with "failure" option on the structure
-				mesh_imped_vals->return_code = 0;
+//Records the converged voltages of a solve into the predictor history and updates the predictor counters
+static void solver_nr_predictor_record(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, int64 result, bool bad_computations, bool predicted)
+{
+	NR_PREDICTOR_HISTORY *history;
+	TIMESTAMP t_now = gl_globalclock;
+	complex *oldest;
+	unsigned int indexer;
+	int slot, jindex;
+	bool first_solve;
 
-				//Determine the base index (error check)
-				if (mesh_imped_vals->NodeRefNum > 0)
-				{
-					tempa = 2*bus[mesh_imped_vals->NodeRefNum].Matrix_Loc;	//These are already separated into real/imag, so the base is 2x
-				}
-				else	//Error
-				{
-					gl_error("solver_nr: Node reference for mesh fault calculation was invalid -- it may be a child");
-					/*  TROUBLESHOOT
-					While attempting to compute the equivalent impedance at a mesh faulted node, an invalid node reference
-					was found.  This is likely an internal error to the code -- submit your code and a bug report via the
-					tracking website.
-					*/
+	history = solver_nr_predictor_alloc(powerflow_values,bus_count);
 
-					//Set the flags
-					mesh_imped_vals->return_code = 0;
-					*bad_computations = true;
+	//Don't learn from failed solves
+	if ((bad_computations == true) || (result < 0))
+	{
+		history->count = 0;
+		return;
+	}
 
-					//Return a 0 to flag
-					return 0;
-				}
+	//Topology changed - this solve starts a new history
+	if ((NR_admit_change == true) || (history->bus_count != bus_count))
+	{
+		history->count = 0;
+		history->bus_count = bus_count;
+	}
 
-				//Determine our phasing size - what entries to pull - double for the complex notation
-				temp_size = 2*powerflow_values->BA_diag[mesh_imped_vals->NodeRefNum].size;
+	first_solve = ((history->count == 0) || (t_now > history->time[history->count-1]));
 
-				//Check for error - size of zero
-				if (temp_size == 0)
-				{
-					gl_error("solver_nr: Mesh fault impedance extract failed - invalid node");
-					/*  TROUBLESHOOT
-					While attempting to extract the mesh fault impedance value, a node with either
-					invalid phasing or no phases (already removed) was somehow flagged.  Please check
-					your file and try again.  If the error persists, please submit your code
-					and a bug report via the ticketing system.
-					*/
+	//Savings are estimated against the average first solve of a timestep that wasn't seeded (flat starts excluded)
+	if (first_solve == true)
+	{
+		if (predicted == true)
+		{
+			NR_predictor_solves++;
+			NR_predictor_iterations += result + 1;
 
-					//Flags
-					*bad_computations = true;
-					mesh_imped_vals->return_code = 0;
+			if (history->baseline_solves > 0)
+				NR_predictor_iterations_saved += history->baseline_iterations / (double)history->baseline_solves - (double)(result + 1);
+		}
+		else if (history->count > 0)
+		{
+			history->baseline_iterations += (double)(result + 1);
+			history->baseline_solves++;
+		}
+	}
 
-					//Exit
-					return 0;
-				}
-				//Default else -- okay
+	if (first_solve == false)	//Later pass of the same timestep replaces its entry
+	{
+		slot = history->count - 1;
+	}
+	else if (history->count < 3)
+	{
+		slot = history->count;
+		history->count++;
+	}
+	else	//Drop the oldest
+	{
+		oldest = history->V[0];
+		history->V[0] = history->V[1];
+		history->V[1] = history->V[2];
+		history->V[2] = oldest;
+		history->time[0] = history->time[1];
+		history->time[1] = history->time[2];
+		slot = 2;
+	}
 
-				//Clear out the output matrix first -- assumes it is 3x3, regardless
-				for (jindex=0; jindex<9; jindex++)
-				{
-					mesh_imped_vals->z_matrix[jindex] = complex(0.0,0.0);
-				}
+	history->time[slot] = t_now;
 
-				//Zero the double matrix - the big storage (6x6 - re & im split)
-				for (jindex=0; jindex<6; jindex++)
-				{
-					for (kindex=0; kindex<6; kindex++)
-					{
-						temp_z_store[jindex][kindex] = 0.0;
-					}
-				}
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		for (jindex=0; jindex<3; jindex++)
+			history->V[slot][3*indexer+jindex] = bus[indexer].V[jindex];
+	}
+}
 
-				//Overall loop - for number of phases
-				for (kindex=0; kindex<temp_size; kindex++)
-				{
+//Load components the fast path compares per bus - S, Y, I, the explicit delta/wye sets, then extra_var (power, admittance, current) and house_var
+#define NR_QSTS_LOAD_COUNT 39
 
-					//Start by zeroing the "solution" vector
-					for (temp_index_c=0;temp_index_c<m;temp_index_c++)
-					{ 
-						matrices_LU.rhs_LU[temp_index_c] = 0.0;
-					}
+//What each load component is - 0 = power, 1 = current, 2 = admittance - so it can be weighed in VA
+static const char NR_qsts_load_kind[NR_QSTS_LOAD_COUNT] = {
+	0,0,0, 2,2,2, 1,1,1,
+	0,0,0,0,0,0, 2,2,2,2,2,2, 1,1,1,1,1,1,
+	0,0,0, 2,2,2, 1,1,1,
+	1,1,1};
 
-					//"Identity"-ize the real part of the current index
-					matrices_LU.rhs_LU[tempa + kindex] = 1.0;
+//Copies the load components of one bus, zero where the bus doesn't carry them
+static void solver_nr_qsts_loads(BUSDATA *bus, complex *loads)
+{
+	int jindex;
 
-					//Do a solution to get this entry (copied from below - includes "destructors"
-#ifdef MT
-					//superLU_MT commands
+	for (jindex=0; jindex<NR_QSTS_LOAD_COUNT; jindex++)
+		loads[jindex] = 0.0;
 
-					//Populate perm_c
-					get_perm_c(1, &A_LU, perm_c);
+	for (jindex=0; jindex<3; jindex++)
+	{
+		loads[jindex] = bus->S[jindex];
+		loads[3+jindex] = bus->Y[jindex];
+		loads[6+jindex] = bus->I[jindex];
+	}
 
-					//Solve the system 
-					pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
+	if (bus->S_dy != NULL)
+	{
+		for (jindex=0; jindex<6; jindex++)
+		{
+			loads[9+jindex] = bus->S_dy[jindex];
+			loads[15+jindex] = bus->Y_dy[jindex];
+			loads[21+jindex] = bus->I_dy[jindex];
+		}
+	}
 
-					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
-					//superLU_MT commands
-					Destroy_SuperNode_SCP(&L_LU);
-					Destroy_CompCol_NCP(&U_LU);
-#else
-					//sequential superLU
+	//extra_var and house_var are only populated for the buses their phase flags mark
+	if ((bus->phases & 0x80) == 0x80)	//Triplex - current12
+	{
+		loads[33] = *bus->extra_var;
 
-					StatInit ( &stat );
+		if ((bus->phases & 0x40) == 0x40)	//House attached
+		{
+			for (jindex=0; jindex<3; jindex++)
+				loads[36+jindex] = bus->house_var[jindex];
+		}
+	}
+	else if ((bus->phases & 0x10) == 0x10)	//Differently connected children - power, admittance, current
+	{
+		for (jindex=0; jindex<9; jindex++)
+			loads[27+jindex] = bus->extra_var[jindex];
+	}
+}
 
-					// solve the system
-					dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+//Writes the load components of one bus back - the inverse of solver_nr_qsts_loads
+static void solver_nr_qsts_loads_set(BUSDATA *bus, complex *loads)
+{
+	int jindex;
 
-					/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
-					//sequential superLU commands
-					Destroy_SuperNode_Matrix( &L_LU );
-					Destroy_CompCol_Matrix( &U_LU );
-					StatFree ( &stat );
-#endif
-					//Crude superLU checks - see if it is mission accomplished or not
-					if (info != 0)	//Failed inversion, for various reasons
-					{
-						gl_error("solver_nr: superLU failed mesh fault matrix inversion with code %d",info);
-						/*  TROUBLESHOOT
-						superLU failed to invert the equivalent impedance matrix for the mesh fault calculation
-						method.  Please try again and make sure your system is valid.  If the error persists, please
-						submit your code and a bug report via the ticketing system.
-						*/
+	for (jindex=0; jindex<3; jindex++)
+	{
+		bus->S[jindex] = loads[jindex];
+		bus->Y[jindex] = loads[3+jindex];
+		bus->I[jindex] = loads[6+jindex];
+	}
 
-						//Flag as bad
-						*bad_computations = true;
-						mesh_imped_vals->return_code = 0;
+	if (bus->S_dy != NULL)
+	{
+		for (jindex=0; jindex<6; jindex++)
+		{
+			bus->S_dy[jindex] = loads[9+jindex];
+			bus->Y_dy[jindex] = loads[15+jindex];
+			bus->I_dy[jindex] = loads[21+jindex];
+		}
+	}
 
-						//Exit
-						return 0;
-					}
-					//Default else, must have converged!
+	if ((bus->phases & 0x80) == 0x80)	//Triplex - current12
+	{
+		*bus->extra_var = loads[33];
 
-					//Map up the solution vector
-					sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
+		if ((bus->phases & 0x40) == 0x40)	//House attached
+		{
+			for (jindex=0; jindex<3; jindex++)
+				bus->house_var[jindex] = loads[36+jindex];
+		}
+	}
+	else if ((bus->phases & 0x10) == 0x10)	//Differently connected children - power, admittance, current
+	{
+		for (jindex=0; jindex<9; jindex++)
+			bus->extra_var[jindex] = loads[27+jindex];
+	}
+}
 
-					//Extract out this column into the temporary matrix
-					for (jindex=0; jindex<temp_size; jindex++)
-					{
-						temp_z_store[jindex][kindex] = sol_LU[tempa+jindex];
-					}
-				}//End "phase loop" - impedance components are ready
+//Takes the load snapshot the fast path compares against - done after every successful full solve
+static void solver_nr_qsts_snapshot(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values)
+{
+	NR_QSTS_STATE *qsts = powerflow_values->qsts;
+	complex *loads;
+	double weight[3];
+	unsigned int indexer;
+	int jindex;
 
-				//Extract the values - do with a massive case/switch, just because
-				switch(bus[mesh_imped_vals->NodeRefNum].phases & 0x07) {
-					case 0x01:	//C
-						{
-							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[1][0],temp_z_store[1][1]);
-							break;
-						}
-					case 0x02:	//B
-						{
-							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[1][0],temp_z_store[1][1]);
-							break;
-						}
-					case 0x03:	//BC
-						{
-							//BB and BC portion
-							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[2][0],temp_z_store[2][2]);
-							mesh_imped_vals->z_matrix[5] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+	if (qsts == NULL)
+	{
+		qsts = (NR_QSTS_STATE *)gl_malloc(sizeof(NR_QSTS_STATE));
 
-							//CB and CC portion
-							mesh_imped_vals->z_matrix[7] = complex(temp_z_store[3][0],temp_z_store[3][2]);
-							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[3][1],temp_z_store[3][3]);
-							break;
-						}
-					case 0x04:	//A
-						{
-							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[1][0],temp_z_store[1][1]);
-							break;
-						}
-					case 0x05:	//AC
-						{
-							//AA and AC portion
-							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[2][0],temp_z_store[2][2]);
-							mesh_imped_vals->z_matrix[2] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+		if (qsts == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-							//CA and CC portion
-							mesh_imped_vals->z_matrix[6] = complex(temp_z_store[3][0],temp_z_store[3][2]);
-							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[3][1],temp_z_store[3][3]);
-							break;
-						}
-					case 0x06:	//AB
-						{
-							//AA and AB portion
-							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[2][0],temp_z_store[2][2]);
-							mesh_imped_vals->z_matrix[1] = complex(temp_z_store[2][1],temp_z_store[2][3]);
+		memset(qsts,0,sizeof(NR_QSTS_STATE));
+		powerflow_values->qsts = qsts;
+	}
 
-							//BA and BB portion
-							mesh_imped_vals->z_matrix[3] = complex(temp_z_store[3][0],temp_z_store[3][2]);
-							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[3][1],temp_z_store[3][3]);
-							break;
-						}
-					case 0x07:	//ABC
-						{
-							//A row
-							mesh_imped_vals->z_matrix[0] = complex(temp_z_store[3][0],temp_z_store[3][3]);
-							mesh_imped_vals->z_matrix[1] = complex(temp_z_store[3][1],temp_z_store[3][4]);
-							mesh_imped_vals->z_matrix[2] = complex(temp_z_store[3][2],temp_z_store[3][5]);
+	if (bus_count > qsts->max_bus_count)
+	{
+		if (qsts->load_ref != NULL)
+			gl_free(qsts->load_ref);
 
-							//B row
-							mesh_imped_vals->z_matrix[3] = complex(temp_z_store[4][0],temp_z_store[4][3]);
-							mesh_imped_vals->z_matrix[4] = complex(temp_z_store[4][1],temp_z_store[4][4]);
-							mesh_imped_vals->z_matrix[5] = complex(temp_z_store[4][2],temp_z_store[4][5]);
+		qsts->load_ref = (complex *)gl_malloc(NR_QSTS_LOAD_COUNT*bus_count*sizeof(complex));
 
-							//C row
-							mesh_imped_vals->z_matrix[6] = complex(temp_z_store[5][0],temp_z_store[5][3]);
-							mesh_imped_vals->z_matrix[7] = complex(temp_z_store[5][1],temp_z_store[5][4]);
-							mesh_imped_vals->z_matrix[8] = complex(temp_z_store[5][2],temp_z_store[5][5]);
-							break;
-						}
-					default:	//Not sure how we got here
-						{
-							gl_error("solver_nr: Mesh fault impedance extract failed - invalid node");
-							//Defined above, same message
+		if (qsts->load_ref == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
+		}
 
-							//Flags
-							*bad_computations = true;
-							mesh_imped_vals->return_code = 0;
+		qsts->max_bus_count = bus_count;
+	}
 
-							//Exit
-							return 0;
-						}
-				}//end phase switch/case
+	qsts->load_total = 0.0;
 
-				//Flag as success
-				*bad_computations = false;
-				mesh_imped_vals->return_code = 1;
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		loads = &qsts->load_ref[NR_QSTS_LOAD_COUNT*indexer];
+		solver_nr_qsts_loads(&bus[indexer],loads);
 
-				//Exit
-				return 1;	//Non-zero, so success (manual checks outside though)
-			}//End "just mesh impedance calculations"
-			else	//Nulled, "normal" powerflow
-			{
-#ifdef MT
-				//superLU_MT commands
+		weight[0] = 1.0;
+		weight[1] = bus[indexer].volt_base;
+		weight[2] = bus[indexer].volt_base * bus[indexer].volt_base;
 
-				//Populate perm_c
-				get_perm_c(1, &A_LU, perm_c);
+		for (jindex=0; jindex<NR_QSTS_LOAD_COUNT; jindex++)
+			qsts->load_total += loads[jindex].Mag() * weight[NR_qsts_load_kind[jindex]];
+	}
 
-				//Solve the system
-				pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
-#else
-				//sequential superLU
+	qsts->bus_count = bus_count;
+	qsts->step_time = gl_globalclock;
+	qsts->fast_steps = 0;
+	qsts->valid = true;
+}
 
-				StatInit ( &stat );
+/* Aggregate load change since the snapshot, relative to the snapshot's total load.  Currents and
+   admittances are weighed at each bus's nominal voltage so every component counts in VA */
+static double solver_nr_qsts_change(unsigned int bus_count, BUSDATA *bus, NR_QSTS_STATE *qsts)
+{
+	complex loads[NR_QSTS_LOAD_COUNT];
+	complex *loads_ref;
+	double weight[3], change;
+	unsigned int indexer;
+	int jindex;
 
-				// solve the system
-				dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
-#endif
+	change = 0.0;
 
-				sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
-			}
-		}
-		else if (matrix_solver_method==MM_EXTERN)
-		{
-			//General error check right now -- mesh fault current may not work properly
-			if (mesh_imped_vals != NULL)
-			{
-				gl_error("solver_nr: Mesh impedance attempted from unsupported LU solver");
-				/* TROUBLESHOOT
-				The mesh fault current impedance "pull" was selected, but for the external LU
-				solver.  This is unsupported at this time.  To use the mesh fault current capabilities,
-				please use the superLU solver.
-				*/
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		loads_ref = &qsts->load_ref[NR_QSTS_LOAD_COUNT*indexer];
+		solver_nr_qsts_loads(&bus[indexer],loads);
 
-				//Set return code
-				mesh_imped_vals->return_code = 2;
+		weight[0] = 1.0;
+		weight[1] = bus[indexer].volt_base;
+		weight[2] = bus[indexer].volt_base * bus[indexer].volt_base;
 
-				//Perform the clean up - external LU destructor routing
-				((void (*)(void *, bool))(LUSolverFcns.ext_destroy))(ext_solver_glob_vars,newiter);
+		for (jindex=0; jindex<NR_QSTS_LOAD_COUNT; jindex++)
+			change += (loads[jindex] - loads_ref[jindex]).Mag() * weight[NR_qsts_load_kind[jindex]];
+	}
 
-				//Flag bad computations, just because
-				*bad_computations = true;
+	//Unloaded system - any load showing up is a big change
+	if (qsts->load_total <= 0.0)
+		return ((change > 0.0) ? 1.0 : 0.0);
 
-				//Exit
-				return 0;
-			}
-			//Default else -- not mesh fault mode, so go like normal
+	return change / qsts->load_total;
+}
 
-			//Call the solver
-			info = ((int (*)(void *,NR_SOLVER_VARS *, unsigned int, unsigned int))(LUSolverFcns.ext_solve))(ext_solver_glob_vars,&matrices_LU,n,1);
+/* Decides if this solve can take the fast path - the topology is unchanged, the loads barely moved
+   since the last full solve, and the full-solve cadence isn't due yet */
+static bool solver_nr_qsts_check(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values)
+{
+	NR_QSTS_STATE *qsts = powerflow_values->qsts;
+	TIMESTAMP t_now = gl_globalclock;
+	bool new_step;
 
-			//Point the solution to the proper place
-			sol_LU = matrices_LU.rhs_LU;
-		}
-		else
-		{
-			GL_THROW("Invalid matrix solution method specified for NR solver!");
-			/*  TROUBLESHOOT
-			An invalid matrix solution method was selected for the Newton-Raphson solver method.
-			Valid options are the superLU solver or an external solver.  Please select one of these methods.
-			*/
-		}
+	if ((qsts == NULL) || (qsts->valid == false) || (qsts->bus_count != bus_count))
+		return false;
 
-		//Update bus voltages - check convergence while we're here
-		Maxmismatch = 0;
+	//Admittance changes can only be taken if the kept factors survived them - they'll be corrected for
+	if ((NR_admit_change == true) && ((NR_qsts_fastpath != NRQ_LINEAR) || (NR_kept.valid == false)))
+		return false;
 
-		temp_index = -1;
-		temp_index_b = -1;
-		newiter = false;	//Reset iteration requester flag - defaults to not needing another
+	//Linear updates need the factors of the last full solve
+	if ((NR_qsts_fastpath == NRQ_LINEAR) && ((matrix_solver_method != MM_SUPERLU) || (NR_kept.valid == false) || (NR_kept.owner != powerflow_values)))
+		return false;
 
-		for (indexer=0; indexer<bus_count; indexer++)
-		{
-			//Avoid swing bus updates on normal runs
-			if ((bus[indexer].type == 0) || ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == false)))
-			{
-				//Figure out the offset we need to be for each phase
-				if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase
-				{
-					//Pull the two updates (assume split-phase is always 2)
-					DVConvCheck[0]=complex(sol_LU[2*bus[indexer].Matrix_Loc],sol_LU[(2*bus[indexer].Matrix_Loc+2)]);
-					DVConvCheck[1]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+1)],sol_LU[(2*bus[indexer].Matrix_Loc+3)]);
-					bus[indexer].V[0] += DVConvCheck[0];
-					bus[indexer].V[1] += DVConvCheck[1];	//Negative due to convention
-					
-					//Pull off the magnitude (no sense calculating it twice)
-					CurrConvVal=DVConvCheck[0].Mag();
-					if (CurrConvVal > Maxmismatch)	//Update our convergence check if it is bigger
-						Maxmismatch=CurrConvVal;
+	//Later passes of a timestep don't count against the cadence
+	new_step = (t_now != qsts->step_time);
 
-					if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
-						newiter=true;								//Flag that a new iteration must occur
+	if ((new_step == true) && (qsts->fast_steps >= NR_qsts_full_interval))
+		return false;
 
-					CurrConvVal=DVConvCheck[1].Mag();
-					if (CurrConvVal > Maxmismatch)	//Update our convergence check if it is bigger
-						Maxmismatch=CurrConvVal;
+	if (solver_nr_qsts_change(bus_count,bus,qsts) > NR_qsts_load_threshold)
+		return false;
 
-					if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
-						newiter=true;								//Flag that a new iteration must occur
-				}//end split phase update
-				else										//Not split phase
-				{
-					for (jindex=0; jindex<powerflow_values->BA_diag[indexer].size; jindex++)	//parse through the phases
-					{
-						switch(bus[indexer].phases & 0x07) {
-							case 0x01:	//C
-								{
-									temp_index=0;
-									temp_index_b=2;
-									break;
-								}
-							case 0x02:	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-									break;
-								}
-							case 0x03:	//BC
-								{
-									if (jindex==0)	//B
-									{
-										temp_index=0;
-										temp_index_b=1;
-									}
-									else			//C
-									{
-										temp_index=1;
-										temp_index_b=2;
-									}
+	if (new_step == true)
+	{
+		qsts->step_time = t_now;
+		qsts->fast_steps++;
+		NR_qsts_fast_solves++;
+	}
 
-									break;
-								}
-							case 0x04:	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-									break;
-								}
-							case 0x05:	//AC
-								{
-									if (jindex==0)	//A
-									{
-										temp_index=0;
-										temp_index_b=0;
-									}
-									else			//C
-									{
-										temp_index=1;
-										temp_index_b=2;
-									}
-									break;
-								}
-							case 0x06:	//AB
-							case 0x07:	//ABC
-								{
-									temp_index = jindex;
-									temp_index_b = jindex;
-									break;
-								}
-						}//end phase switch/case
+	return true;
+}
 
-						if ((temp_index==-1) || (temp_index_b==-1))
-						{
-							GL_THROW("NR: An error occurred indexing voltage updates");
-							/*  TROUBLESHOOT
-							While attempting to create the voltage update indices for the
-							Newton-Raphson solver, an error was encountered.  Please submit
-							your code and a bug report using the trac website.
-							*/
-						}
+int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations)
+{
+	bool use_predictor, predicted, use_qsts;
+	int64 result;
 
-						DVConvCheck[jindex]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+temp_index)],sol_LU[(2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size+temp_index)]);
-						bus[indexer].V[temp_index_b] += DVConvCheck[jindex];
-						
-						//Pull off the magnitude (no sense calculating it twice)
-						CurrConvVal=DVConvCheck[jindex].Mag();
-						if (CurrConvVal > bus[indexer].max_volt_error)	//Check for convergence
-							newiter=true;								//Flag that a new iteration must occur
+	//Kept factors describe the old admittance - value-only changes (e.g., regulator taps) can be corrected for instead, once the core has updated it
+	if ((NR_admit_change == true) && ((NR_admit_lowrank == false) || (powerflow_type != PF_NORMAL) || (mesh_imped_vals != NULL) || (solver_nr_admit_compare(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type) != NRA_VALUES)))
+		solver_nr_kept_release();
 
-						if (CurrConvVal > Maxmismatch)	//See if the current differential is the largest found so far or not
-							Maxmismatch = CurrConvVal;	//It is, store it
+	//Fast path only follows the normal timestep solves too
+	use_qsts = ((NR_qsts_fastpath != NRQ_NONE) && (powerflow_type == PF_NORMAL) && (mesh_imped_vals == NULL));
 
-					}//End For loop for phase traversion
-				}//End not split phase update
-			}//end if not swing
-			else	//So this must be the swing and in a valid interval
-			{
-				temp_index +=2*powerflow_values->BA_diag[indexer].size;	//Increment us for what this bus would have been had it not been a swing
-			}
-		}//End bus traversion
+	if ((use_qsts == true) && (solver_nr_qsts_check(bus_count,bus,powerflow_values) == true))
+	{
+		if (NR_qsts_fastpath == NRQ_SKIP)	//Keep the last solution - converged on the first pass as far as the caller knows
+			return 0;
 
-		//Perform saturation current update/convergence check
-		//******************** FIGURE OUT HOW TO DO THIS BETTER - This is very inefficient!***********************//
-		if ((enable_inrush_calculations == true) && (deltatimestep_running > 0))	//Don't even both with this if inrush not on
+		//Linear updates with the last full solve's factors (real formulation) - refactors if they haven't converged by NR_CHORD_LIMIT
+		NR_kept_first_step = true;
+		NR_kept_chord = true;
+
+		result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,mesh_imped_vals,bad_computations,false);
+
+		NR_kept_first_step = false;
+		NR_kept_chord = false;
+
+		if (*bad_computations == false)
 		{
-			//Start out assuming the convergence is true (reiter is false)
-			SaturationMismatchPresent = false;
+			if (result >= 0)
+				NR_iteration_count += result + 1;
 
-			//Loop through all branches -- inefficient, but meh
-			for (indexer=0; indexer<branch_count; indexer++)
-			{
-				//See if the function exists
-				if (branch[indexer].ExtraDeltaModeFunc != NULL)
-				{
-					//Call the function
-					func_result_val = ((int (*)(OBJECT *,bool *))(*branch[indexer].ExtraDeltaModeFunc))(branch[indexer].obj,&SaturationMismatchPresent);
+			return result;
+		}
 
-					//Make sure it worked
-					if (func_result_val != 1)
-					{
-						GL_THROW("Extra delta update failed for device %s",branch[indexer].name ? branch[indexer].name : "Unnamed");
-						/*  TROUBLESHOOT
-						While attempting to perform the extra deltamode update, something failed.  Please try again.
-						If the error persists, please submit your code and a bug report via the ticketing system.
-						*/
-					}
-					//Default else -- it worked, keep going
-				}
-				//Default else - is NULL
-			}//End inefficient branch traversion
-		}//End in-rush and deltamode running
+		//Kept factors couldn't take the update - fall back on a full solve
+		*bad_computations = false;
+		solver_nr_kept_release();
+	}
 
-		//Further debug stuff
+	//Predictor only follows the normal timestep solves
+	use_predictor = ((NR_predictor != NRP_NONE) && (powerflow_type == PF_NORMAL) && (mesh_imped_vals == NULL));
 
-		//Additional checks for special modes - only needs to happen in first dynamics powerflow
-		if (powerflow_type == PF_DYNINIT)
-		{
-			//See what "mode" we're in
-			if (!newiter)	//Overall powerflow has converged
-			{
-				if (!swing_converged)	//See if deltaI_sym is being met
-				{
-					//Give a verbose message, just cause
-					gl_verbose("NR_Solver: swing bus failed balancing criteria - making it a PQ for future dynamics");
+	if (use_predictor == true)
+		predicted = solver_nr_predict(bus_count,bus,powerflow_values);
+	else
+		predicted = false;
 
-					//See if we're still swing_is_a_swing mode
-					if (swing_is_a_swing == true)
-					{
-						//Deflag us
-						swing_is_a_swing = false;
+	NR_kept_first_step = (predicted && NR_predictor_correction);
 
-						//Loop through and deflag appropriate swing buses
-						for (indexer=0; indexer<bus_count; indexer++)
-						{
-							//See if we're a swing-flagged bus
-							if ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == true))
-							{
-								//See if we're "generator ready"
-								if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
-								{
-									//Deflag us back to "PQ" status
-									bus[indexer].swing_functions_enabled = false;
+	//Complex formulation covers the normal superLU solve - mesh fault impedance pulls and the external solver stay real
+	if ((NR_formulation == NRF_REAL) || (matrix_solver_method != MM_SUPERLU) || (mesh_imped_vals != NULL))
+		result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,mesh_imped_vals,bad_computations,false);
+	else if ((NR_formulation == NRF_VALIDATE) && (powerflow_type == PF_NORMAL))	//Validation solves twice, so leave the deltamode passes (and their swing handling) to the real formulation
+		result = solver_nr_validate(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,bad_computations);
+	else
+		result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,powerflow_type,mesh_imped_vals,bad_computations,(NR_formulation == NRF_COMPLEX));
 
-									//Force a reiteration
-									newiter=true;
-								}
-							}
-							//Default else -- normal bus
-						}//End bus traversion loop
-					}
-					//Default else - if we're out of symmetry bounds, but already hit close, good enough
-				}
-				//Defaulted else - we're converged on all fronts, huzzah!
-			}
-			//Default else - still need to iterate
-		}//End special convergence criterion
+	NR_kept_first_step = false;
 
-		//Check Saturation mismatch 
-		if (SaturationMismatchPresent == true)
+	if ((*bad_computations == false) && (result >= 0))
+		NR_iteration_count += result + 1;
+
+	if (use_predictor == true)
+		solver_nr_predictor_record(bus_count,bus,powerflow_values,result,*bad_computations,predicted);
+
+	//Full solves refresh the fast path's load snapshot - failed ones leave nothing to compare against
+	if (use_qsts == true)
+	{
+		if ((*bad_computations == false) && (result >= 0))
+			solver_nr_qsts_snapshot(bus_count,bus,powerflow_values);
+		else if (powerflow_values->qsts != NULL)
+			powerflow_values->qsts->valid = false;
+	}
+
+	return result;
+}
+
+//Loads of the last converged timestep solve while scenario batches wait on it - NR_QSTS_LOAD_COUNT per bus
+static complex *NR_batch_loads = NULL;
+static unsigned int NR_batch_max_bus_count = 0;
+static unsigned int NR_batch_bus_count = 0;		//0 until a solve has been captured
+
+/* Keeps the loads of a converged timestep solve while scenario batches wait on it.  The batches are solved
+   once the timestep is over, and by then the child nodes have taken their loads back off their parents */
+void solver_nr_batch_capture(unsigned int bus_count, BUSDATA *bus)
+{
+	unsigned int indexer;
+
+	if (NR_batch_pending == false)
+		return;
+
+	if (bus_count > NR_batch_max_bus_count)
+	{
+		if (NR_batch_loads != NULL)
+			gl_free(NR_batch_loads);
+
+		NR_batch_loads = (complex *)gl_malloc(NR_QSTS_LOAD_COUNT*bus_count*sizeof(complex));
+
+		if (NR_batch_loads == NULL)
 		{
-			//Force a reiter
-			newiter = true;
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			//Defined above
 		}
-		//Default else -- either no saturation, or it has converged - leave it be
 
-		//Turn off reallocation flag no matter what
-		powerflow_values->NR_realloc_needed = false;
+		NR_batch_max_bus_count = bus_count;
+	}
 
-		if (matrix_solver_method==MM_SUPERLU)
+	for (indexer=0; indexer<bus_count; indexer++)
+		solver_nr_qsts_loads(&bus[indexer],&NR_batch_loads[NR_QSTS_LOAD_COUNT*indexer]);
+
+	NR_batch_bus_count = bus_count;
+}
+
+//Checks a converged solve of the current system has been captured for the batches
+bool solver_nr_batch_captured(unsigned int bus_count)
+{
+	return ((NR_batch_bus_count != 0) && (NR_batch_bus_count == bus_count));
+}
+
+//Drops the captured loads once the waiting batches are solved
+void solver_nr_batch_clear(void)
+{
+	NR_batch_bus_count = 0;
+}
+
+/* Solves every scenario of a batch against the same admittance structure.  The base case is solved first
+   and its converged factors kept; each scenario then starts from the base voltages with its injections
+   added to the base loads and iterates with those factors, only refactoring if NR_CHORD_LIMIT iterations
+   don't converge it.  The base loads are the ones solver_nr_batch_capture kept, when it kept any for this
+   system.  The model's loads and voltages are put back afterwards.
+   Returns the number of scenarios that converged, or -1 if the base case didn't */
+int solver_nr_batch(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NR_BATCH *batch)
+{
+	complex *V_base, *S_base, *live_loads;
+	unsigned int indexer, sindex, eindex;
+	int jindex, converged;
+	int64 result;
+	bool bad_computations, base_saved, captured;
+
+	V_base = (complex *)gl_malloc((6+NR_QSTS_LOAD_COUNT)*bus_count*sizeof(complex));
+
+	if (V_base == NULL)
+	{
+		GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+		//Defined above
+	}
+
+	S_base = &V_base[3*bus_count];
+	live_loads = &V_base[6*bus_count];
+	base_saved = false;
+	converged = 0;
+
+	//Solve against the captured loads - the live ones go back at the end
+	captured = solver_nr_batch_captured(bus_count);
+
+	if (captured == true)
+	{
+		for (indexer=0; indexer<bus_count; indexer++)
 		{
-			/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
-#ifdef MT
-			//superLU_MT commands
-			Destroy_SuperNode_SCP(&L_LU);
-			Destroy_CompCol_NCP(&U_LU);
-#else
-			//sequential superLU commands
-			Destroy_SuperNode_Matrix( &L_LU );
-			Destroy_CompCol_Matrix( &U_LU );
-			StatFree ( &stat );
-#endif
+			solver_nr_qsts_loads(&bus[indexer],&live_loads[NR_QSTS_LOAD_COUNT*indexer]);
+			solver_nr_qsts_loads_set(&bus[indexer],&NR_batch_loads[NR_QSTS_LOAD_COUNT*indexer]);
 		}
-		else if (matrix_solver_method==MM_EXTERN)
+	}
+
+	try {
+		//Base case - its converged factors are the ones every scenario shares
+		bad_computations = false;
+		NR_kept_force = true;
+
+		result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,PF_NORMAL,NULL,&bad_computations,false);
+
+		NR_kept_force = false;
+
+		if ((bad_computations == true) || (result < 0))
 		{
-			//Call destruction routine
-			((void (*)(void *, bool))(LUSolverFcns.ext_destroy))(ext_solver_glob_vars,newiter);
+			if (captured == true)
+			{
+				for (indexer=0; indexer<bus_count; indexer++)
+					solver_nr_qsts_loads_set(&bus[indexer],&live_loads[NR_QSTS_LOAD_COUNT*indexer]);
+			}
+
+			gl_free(V_base);
+			return -1;
 		}
-		else	//Not sure how we get here
+
+		//Base solve rebuilt the admittance if it needed to - the scenarios share it
+		NR_admit_change = false;
+
+		for (indexer=0; indexer<bus_count; indexer++)
 		{
-			GL_THROW("Invalid matrix solution method specified for NR solver!");
-			//Defined above
+			for (jindex=0; jindex<3; jindex++)
+			{
+				V_base[3*indexer+jindex] = bus[indexer].V[jindex];
+				S_base[3*indexer+jindex] = bus[indexer].S[jindex];
+			}
 		}
+		base_saved = true;
 
-		//Break us out if we are done or are singular		
-		if (( newiter == false ) || (info!=0))
+		NR_kept_hold = true;
+
+		for (sindex=0; sindex<batch->scenario_count; sindex++)
 		{
-			if (newiter == false)
+			//Scenario's injections go on top of the base loads
+			for (eindex=0; eindex<batch->entry_count; eindex++)
 			{
-				gl_verbose("Power flow calculation converges at Iteration %d \n",Iteration+1);
+				if (batch->entry_scenario[eindex] == sindex)
+				{
+					for (jindex=0; jindex<3; jindex++)
+						bus[batch->entry_bus[eindex]].S[jindex] += batch->entry_power[3*eindex+jindex];
+				}
 			}
-			break;
-		}
-	}	//End iteration loop
 
-	//Check to see how we are ending
-	if ((Iteration==NR_iteration_limit) && (newiter==true)) //Reached the limit
-	{
-		gl_verbose("Max solver mismatch of failed solution %f\n",Maxmismatch);
-		return -Iteration;
+			bad_computations = false;
+			NR_kept_first_step = true;
+			NR_kept_chord = true;
+
+			result = solver_nr_run(bus_count,bus,branch_count,branch,powerflow_values,PF_NORMAL,NULL,&bad_computations,false);
+
+			NR_kept_first_step = false;
+			NR_kept_chord = false;
+
+			batch->converged[sindex] = ((bad_computations == false) && (result >= 0));
+			batch->iterations[sindex] = (bad_computations == true) ? 0 : ((result < 0) ? -result : (result + 1));
+
+			if (batch->converged[sindex] == true)
+				converged++;
+
+			//Keep the answer, then put the base case back for the next scenario
+			for (indexer=0; indexer<bus_count; indexer++)
+			{
+				for (jindex=0; jindex<3; jindex++)
+				{
+					batch->V_out[3*(bus_count*sindex+indexer)+jindex] = bus[indexer].V[jindex];
+					bus[indexer].V[jindex] = V_base[3*indexer+jindex];
+					bus[indexer].S[jindex] = S_base[3*indexer+jindex];
+				}
+			}
+		}
 	}
-	else if (info!=0)	//failure of computations (singular matrix, etc.)
+	catch (...)
 	{
-		//For superLU - 2 = singular matrix it appears - positive values = process errors (singular, etc), negative values = input argument/syntax error
-		if (matrix_solver_method==MM_SUPERLU)
+		//Kept-factor flags would otherwise stick to every later solve, and a scenario's injections to the loads
+		NR_kept_force = false;
+		NR_kept_hold = false;
+		NR_kept_first_step = false;
+		NR_kept_chord = false;
+
+		if (base_saved == true)
 		{
-			gl_verbose("superLU failed out with return value %d",info);
+			for (indexer=0; indexer<bus_count; indexer++)
+			{
+				for (jindex=0; jindex<3; jindex++)
+				{
+					bus[indexer].V[jindex] = V_base[3*indexer+jindex];
+					bus[indexer].S[jindex] = S_base[3*indexer+jindex];
+				}
+			}
 		}
-		else if (matrix_solver_method==MM_EXTERN)
+
+		if (captured == true)
 		{
-			gl_verbose("External LU solver failed out with return value %d",info);
+			for (indexer=0; indexer<bus_count; indexer++)
+				solver_nr_qsts_loads_set(&bus[indexer],&live_loads[NR_QSTS_LOAD_COUNT*indexer]);
 		}
-		//Defaulted else - shouldn't exist (or make it this far), but if it does, we're failing anyways
 
-		*bad_computations = true;	//Flag our output as bad
-		return 0;					//Just return some arbitrary value
+		gl_free(V_base);
+		throw;
 	}
-	else	//Must have converged 
-		return Iteration;
+
+	NR_kept_hold = false;
+
+	if (captured == true)
+	{
+		for (indexer=0; indexer<bus_count; indexer++)
+			solver_nr_qsts_loads_set(&bus[indexer],&live_loads[NR_QSTS_LOAD_COUNT*indexer]);
+	}
+
+	gl_free(V_base);
+
+	return converged;
 }
@@ -104,6 +104,13 @@ typedef struct SP_E {
 } SP_E;
 
 // Sparse matrix
+// Position of one Y_NR triplet in the compressed-column A matrix
+typedef struct {
+	int row_ind;	///< row of the triplet when the position was recorded
+	int col_ind;	///< column of the triplet when the position was recorded
+	int csc_ind;	///< index of the entry in the compressed-column value array
+} SP_SCATTER;
+
 typedef struct {
 	SP_E** cols;
 	SP_E* llheap;
@@ -111,6 +118,105 @@ typedef struct {
 	unsigned int ncols;
 } SPARSE;
 
+// Packed structure-of-arrays copy of the bus and branch values the solver streams over
+typedef struct {
+	unsigned int max_bus_count;			///Maximum allocated space for buses
+	unsigned int max_branch_count;		///Maximum allocated space for branches
+	bool active;						///The arrays hold the values of the solve in progress
+	complex *bus_values;				///Single allocation holding every packed bus array
+	complex *branch_values;				///Single allocation holding every packed branch array
+	complex *V;							///Bus voltages - 3 per bus
+	complex *S;							///Constant power loads - 3 per bus
+	complex *Y;							///Constant admittance loads - 3 per bus
+	complex *I;							///Constant current loads - 3 per bus
+	complex *S_dy;						///Explicit delta/wye constant power - 6 per bus
+	complex *Y_dy;						///Explicit delta/wye constant admittance - 6 per bus
+	complex *I_dy;						///Explicit delta/wye constant current - 6 per bus
+	complex *Yfrom;						///Branch from admittances - 9 per branch
+	complex *Yto;						///Branch to admittances - 9 per branch
+	complex *YSfrom;					///Branch from self admittances - 9 per branch
+	complex *YSto;						///Branch to self admittances - 9 per branch
+	complex **bus_pointers;				///Original object pointers of each bus (V,S,Y,I,S_dy,Y_dy,I_dy) - restored after the solve
+	complex **branch_pointers;			///Original object pointers of each branch (Yfrom,Yto,YSfrom,YSto) - restored after the solve
+} NR_PACKED_STORAGE;
+
+// Complex form of the linear system - one unknown per phase instead of a real/imaginary pair
+typedef struct {
+	unsigned int max_size;				///Maximum allocated space for complex unknowns
+	unsigned int max_triplets;			///Maximum allocated space for the scatter map and the complex non-zero elements
+	unsigned int max_bus_count;			///Maximum allocated space for the saved validation voltages
+	unsigned int size;					///Number of complex unknowns - active swing buses are eliminated
+	unsigned int nnz;					///Number of complex non-zero elements
+	unsigned int triplets;				///Number of real triplets the scatter map describes - 0 when it needs rebuilding
+	bool q_present;						///The conjugate-voltage part of the Jacobian has non-zero entries
+	int *real_map;						///Complex unknown each real row/column belongs to - -1 for active swing buses
+	char *real_half;					///Which half of the 2x2 block each real row/column is - 0 = imaginary current/real voltage, 1 = real current/imaginary voltage
+	int *col_first;						///First-half real column of each complex unknown
+	int *col_second;					///Second-half real column of each complex unknown
+	int *marker;						///Workspace - last complex column each row was seen in
+	int *position;						///Workspace - position of each row in the current complex column
+	int *bucket;						///Workspace - start of each complex column's triplets in order
+	int *order;							///Workspace - triplet indices sorted by complex column
+	SP_SCATTER *scatter;				///Position of each real triplet in the complex compressed-column arrays - csc_ind is -1 for eliminated entries
+	int *perm_c;						///Column permutation for the complex factorization
+	int *perm_r;						///Row permutation for the complex factorization
+	double *a_LU;						///Jacobian with respect to the complex voltage (P) - compressed-column, real/imaginary interleaved
+	double *q_LU;						///Jacobian with respect to the conjugate voltage (Q) - same pattern as a_LU
+	int *rows_LU;						///Complex compressed-column row indices
+	int *cols_LU;						///Complex compressed-column column pointers
+	double *rhs_LU;						///Complex right-hand side - real/imaginary interleaved
+	double *x_LU;						///Complex solution - real/imaginary interleaved
+	double *w_LU;						///Workspace - right-hand side of each inner iteration
+	int inner_iterations;				///Triangular solves the last step took after its factorization
+	complex *V_saved;					///Voltages saved between formulations in validation mode - 3 per bus
+} NR_COMPLEX_VARS;
+
+// Voltages of the last converged timesteps, used to seed the first solve of the next one
+typedef struct {
+	unsigned int max_bus_count;			///Maximum allocated space for buses
+	unsigned int bus_count;				///Number of buses the history was recorded with
+	int count;							///Number of valid entries (up to 3) - oldest first
+	TIMESTAMP time[3];					///Timestep each entry was recorded at
+	complex *V[3];						///Voltages of each entry - 3 per bus
+	complex *values;					///Single allocation holding every entry
+	TIMESTAMP predicted_time;			///Last timestep a prediction was made for - only the first solve of a timestep is seeded
+	double baseline_iterations;			///Total iterations of unseeded timestep solves - baseline for the savings estimate
+	unsigned int baseline_solves;		///Number of unseeded timestep solves in the baseline
+} NR_PREDICTOR_HISTORY;
+
+// Load snapshot of the last full solve, used to decide when a timestep can take the fast path
+typedef struct {
+	unsigned int max_bus_count;			///Maximum allocated space for buses
+	unsigned int bus_count;				///Number of buses the snapshot was taken with
+	bool valid;							///Flags a usable snapshot - cleared by failed solves
+	complex *load_ref;					///Load components of each bus at the last full solve
+	double load_total;					///Aggregate load of the snapshot, in VA-equivalent terms
+	TIMESTAMP step_time;				///Timestep of the last solve, fast or full - later passes of a timestep aren't counted again
+	int fast_steps;						///Timesteps handled by the fast path since the last full solve
+} NR_QSTS_STATE;
+
+// Admittance inputs of the last build, so an admittance change only rebuilds the entries it touched
+typedef struct {
+	unsigned int max_bus_count;			///Maximum allocated space for buses
+	unsigned int max_branch_count;		///Maximum allocated space for branches
+	unsigned int bus_count;				///Number of buses the snapshot was taken with
+	unsigned int branch_count;			///Number of branches the snapshot was taken with
+	bool valid;							///Flags a usable snapshot - only normal powerflow builds are recorded
+	unsigned char *bus_phases;			///Phases of each bus
+	int *bus_type;						///Type of each bus
+	unsigned char *branch_phases;		///Phases of each branch
+	double *branch_v_ratio;				///Voltage ratio of each branch
+	complex *branch_Y;					///Yfrom, Yto, YSfrom and YSto of each branch - 36 per branch
+	unsigned int *offdiag_start;		///First Y_offdiag_PQ entry of each branch - branch_count+1 entries
+	unsigned int *diag_fixed_start;		///First Y_diag_fixed entry of each bus - bus_count+1 entries
+	char *branch_changed;				///Flags the branches that changed since the snapshot
+	char *bus_touched;					///Flags the buses at either end of a changed branch
+	Bus_admit *BA_prev;					///Self admittance of each touched bus before the update
+	Y_NR *delta;						///Matrix entry changes of the last in-place update - for the kept-factor correction
+	unsigned int delta_count;			///Number of entries in delta
+	unsigned int max_delta_count;		///Maximum allocated space for delta
+} NR_ADMIT_STATE;
+
 typedef struct {
 	double *deltaI_NR;					/// Storage array for current injection
 	unsigned int size_offdiag_PQ;		/// Number of fixed off-diagonal matrix elements
@@ -127,6 +233,14 @@ typedef struct {
 	Y_NR *Y_diag_fixed;					///Y_diag_fixed store the row,column and value of fixed diagonal elements of 6n*6n Y_NR matrix. No PV bus is included.
 	Y_NR *Y_diag_update;				///Y_diag_update store the row,column and value of updated diagonal elements of 6n*6n Y_NR matrix at each iteration. No PV bus is included.
 	SPARSE *Y_Amatrix;					///Y_Amatrix store all the elements of Amatrix in equation AX=B;
+	SP_SCATTER *Amatrix_scatter;		///Amatrix_scatter maps each Y_offdiag_PQ, Y_diag_fixed and Y_diag_update triplet (in that order) straight to its place in the compressed-column matrix
+	unsigned int size_Amatrix_scatter;	///Number of triplets Amatrix_scatter describes - 0 when it needs rebuilding
+	unsigned int max_size_Amatrix_scatter;	///Maximum allocated space for Amatrix_scatter
+	NR_PACKED_STORAGE *packed;			///Solver-owned contiguous bus/branch arrays - only used when NR_packed_storage is set
+	NR_COMPLEX_VARS *complex_vars;		///Complex form of the system - only used when NR_formulation is not REAL
+	NR_PREDICTOR_HISTORY *predictor;	///Converged voltage history - only used when NR_predictor is not NONE
+	NR_QSTS_STATE *qsts;				///Load snapshot for the fast path - only used when NR_qsts_fastpath is not NONE
+	NR_ADMIT_STATE *admit;				///Admittance snapshot - lets admittance changes rebuild only what they touched
 } NR_SOLVER_STRUCT;
 
 //Mesh-fault-related structure - passing information
@@ -142,6 +256,28 @@ typedef struct {
 //int ext_solver_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
 //void ext_solver_destroy(void *ext_array, bool new_iteration);
 
+//Injection scenarios solved as one batch by solver_nr_batch
+typedef struct {
+	unsigned int scenario_count;		///Number of scenarios
+	unsigned int entry_count;			///Number of injection entries, over all scenarios
+	unsigned int *entry_scenario;		///Scenario each entry belongs to
+	int *entry_bus;						///Bus each entry's injection is added to
+	complex *entry_power;				///Constant power each entry adds to its bus - 3 per entry
+	complex *V_out;						///Converged voltages - 3 per bus, bus_count per scenario
+	int64 *iterations;					///Iterations each scenario took - 0 if its matrices couldn't be solved
+	bool *converged;					///Flags the scenarios that converged
+} NR_BATCH;
+
+//Complex sparse LU solve of the complex formulation (solver_nr_complex.cpp)
+int solver_nr_complex_solve(NR_COMPLEX_VARS *complex_vars, bool *converged);
+
+//Stops the NR assembly helper threads (solver_nr.cpp)
+void solver_nr_assembly_stop(void);
+
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations);
+int solver_nr_batch(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NR_BATCH *batch);
+void solver_nr_batch_capture(unsigned int bus_count, BUSDATA *bus);
+bool solver_nr_batch_captured(unsigned int bus_count);
+void solver_nr_batch_clear(void);
 
 #endif
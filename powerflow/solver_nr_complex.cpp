@@ -0,0 +1,171 @@
+/* $Id
+ * Newton-Raphson solver - complex sparse LU solve for the complex formulation
+ *
+ * Kept apart from solver_nr.cpp since the double and complex superLU
+ * headers can't be included in the same translation unit.
+ */
+
+#include "solver_nr.h"
+
+#define MT // this enables multithreaded SuperLU
+
+#ifdef MT
+#include <pzsp_defs.h>	//superLU_MT
+#else
+#include <slu_zdefs.h>	//Sequential superLU (other platforms)
+#endif
+
+#include "powerflow.h"
+
+//Relative change of the complex solution below which the conjugate-voltage iterations stop
+#define NR_COMPLEX_INNER_TOLERANCE 1e-10
+
+//Most triangular solves a step may take before it is handed back to the real formulation
+#define NR_COMPLEX_INNER_LIMIT 30
+
+/* Solves P*x + Q*conj(x) = rhs for the complex step held in complex_vars - x ends up in x_LU.
+   P is factored once, then x is refined with x = P^-1 (rhs - Q*conj(x)) using only triangular solves.
+   Q only comes from the constant power loads, so without them the first solve is the exact step.
+   converged is false if the refinement didn't settle within NR_COMPLEX_INNER_LIMIT solves.
+   Returns the superLU info code (0 = success) */
+int solver_nr_complex_solve(NR_COMPLEX_VARS *complex_vars, bool *converged)
+{
+	SuperMatrix A_LU, B_LU, L_LU, U_LU;
+	NCformat Astore;
+	DNformat Bstore;
+	int info, col, kindex, row;
+	unsigned int size = complex_vars->size;
+	unsigned int indexer;
+	double x_re, x_im, q_re, q_im, change, total;
+#ifdef MT
+	Gstat_t Gstat;
+#else
+	superlu_options_t options;
+	SuperLUStat_t stat;
+#endif
+
+	complex_vars->inner_iterations = 0;
+	*converged = true;
+
+	//Nothing but swing buses - nothing to update
+	if (size == 0)
+		return 0;
+
+	//Populate the matrix structure - values are already in compressed-column form
+	Astore.nnz = complex_vars->nnz;
+	Astore.nzval = complex_vars->a_LU;
+	Astore.rowind = complex_vars->rows_LU;
+	Astore.colptr = complex_vars->cols_LU;
+
+	A_LU.Stype = SLU_NC;
+	A_LU.Dtype = SLU_Z;
+	A_LU.Mtype = SLU_GE;
+	A_LU.nrow = size;
+	A_LU.ncol = size;
+	A_LU.Store = &Astore;
+
+	//Right-hand side - single column, solved in place
+	memcpy(complex_vars->x_LU,complex_vars->rhs_LU,2*size*sizeof(double));
+
+	Bstore.lda = size;
+	Bstore.nzval = complex_vars->x_LU;
+
+	B_LU.Stype = SLU_DN;
+	B_LU.Dtype = SLU_Z;
+	B_LU.Mtype = SLU_GE;
+	B_LU.nrow = size;
+	B_LU.ncol = 1;
+	B_LU.Store = &Bstore;
+
+#ifdef MT
+	//superLU_MT commands
+
+	//Populate perm_c
+	get_perm_c(1, &A_LU, complex_vars->perm_c);
+
+	//Factor and solve the system
+	pzgssv(NR_superLU_procs, &A_LU, complex_vars->perm_c, complex_vars->perm_r, &L_LU, &U_LU, &B_LU, &info);
+
+	if ((info == 0) && (complex_vars->q_present == true))
+	{
+		StatAlloc(size, 1, sp_ienv(1), sp_ienv(2), &Gstat);
+		StatInit(size, 1, &Gstat);
+	}
+#else
+	//sequential superLU
+	set_default_options ( &options );
+
+	StatInit ( &stat );
+
+	//Factor and solve the system
+	zgssv(&options, &A_LU, complex_vars->perm_c, complex_vars->perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+#endif
+
+	//Refine against the conjugate-voltage part with the same factors
+	if ((info == 0) && (complex_vars->q_present == true))
+	{
+		*converged = false;
+		Bstore.nzval = complex_vars->w_LU;
+
+		while ((*converged == false) && (complex_vars->inner_iterations < NR_COMPLEX_INNER_LIMIT))
+		{
+			memcpy(complex_vars->w_LU,complex_vars->rhs_LU,2*size*sizeof(double));
+
+			//w = rhs - Q*conj(x)
+			for (col=0; col<(int)size; col++)
+			{
+				x_re = complex_vars->x_LU[2*col];
+				x_im = -complex_vars->x_LU[2*col+1];
+
+				for (kindex=complex_vars->cols_LU[col]; kindex<complex_vars->cols_LU[col+1]; kindex++)
+				{
+					q_re = complex_vars->q_LU[2*kindex];
+					q_im = complex_vars->q_LU[2*kindex+1];
+					row = complex_vars->rows_LU[kindex];
+
+					complex_vars->w_LU[2*row] -= q_re*x_re - q_im*x_im;
+					complex_vars->w_LU[2*row+1] -= q_re*x_im + q_im*x_re;
+				}
+			}
+
+#ifdef MT
+			zgstrs(NOTRANS, &L_LU, &U_LU, complex_vars->perm_r, complex_vars->perm_c, &B_LU, &Gstat, &info);
+#else
+			zgstrs(NOTRANS, &L_LU, &U_LU, complex_vars->perm_c, complex_vars->perm_r, &B_LU, &stat, &info);
+#endif
+			complex_vars->inner_iterations++;
+
+			if (info != 0)
+				break;
+
+			//See how far the solution moved
+			change = 0.0;
+			total = 0.0;
+			for (indexer=0; indexer<2*size; indexer++)
+			{
+				change += (complex_vars->w_LU[indexer] - complex_vars->x_LU[indexer])*(complex_vars->w_LU[indexer] - complex_vars->x_LU[indexer]);
+				total += complex_vars->w_LU[indexer]*complex_vars->w_LU[indexer];
+			}
+
+			memcpy(complex_vars->x_LU,complex_vars->w_LU,2*size*sizeof(double));
+
+			*converged = (change <= NR_COMPLEX_INNER_TOLERANCE*NR_COMPLEX_INNER_TOLERANCE*total);
+		}
+
+#ifdef MT
+		StatFree(&Gstat);
+#endif
+	}
+
+	/* De-allocate storage - superLU matrix types must be destroyed at every iteration */
+#ifdef MT
+	Destroy_SuperNode_SCP(&L_LU);
+	Destroy_CompCol_NCP(&U_LU);
+#else
+	Destroy_SuperNode_Matrix( &L_LU );
+	Destroy_CompCol_Matrix( &U_LU );
+	StatFree ( &stat );
+#endif
+
+	return info;
+}
@@ -0,0 +1,187 @@
+/* $Id
+ * Compressed-row adjacency of the Newton-Raphson bus/branch topology
+ *
+ * Flattens the per-bus Link_Table lists into one contiguous index, with the
+ * far-end bus of every entry resolved up front, so topology searches (fault_check)
+ * walk flat arrays instead of dereferencing the branch table for every step.
+ * Connectivity (from/to of every branch) is fixed once powerflow is initialized,
+ * so the index is built once and only the phase/status state is read per search.
+ *
+ * The same index holds restoration's working graphs (built from their adjacency
+ * chains with topology_csr_alloc) for its breadth-first searches.  The queue and
+ * flags a search works in are kept apart (TOPOLOGY_SEARCH), so each searching
+ * object has its own and the shared index is only read.
+ */
+
+#include "powerflow.h"
+#include "topology_csr.h"
+
+/* Allocates an empty adjacency of bus_count buses and entry_count entries - the caller fills it */
+void topology_csr_alloc(TOPOLOGY_CSR *topo, unsigned int bus_count, unsigned int entry_count)
+{
+	//Clear anything from a previous build
+	topology_csr_free(topo);
+
+	topo->adj_start = (unsigned int *)gl_malloc((bus_count+1)*sizeof(unsigned int));
+	topo->adj_branch = (int *)gl_malloc((entry_count > 0 ? entry_count : 1)*sizeof(int));
+	topo->adj_bus = (int *)gl_malloc((entry_count > 0 ? entry_count : 1)*sizeof(int));
+
+	if ((topo->adj_start == NULL) || (topo->adj_branch == NULL) || (topo->adj_bus == NULL))
+	{
+		GL_THROW("NR: Failed to allocate the topology adjacency index");
+		/*  TROUBLESHOOT
+		While attempting to allocate the compressed adjacency of the powerflow topology used by the
+		connectivity searches, an error occurred.  Please try again.  If the error persists, please
+		submit your code and a bug report via the ticketing system.
+		*/
+	}
+
+	topo->adj_start[bus_count] = 0;
+	topo->bus_count = bus_count;
+	topo->branch_count = 0;
+}
+
+/* Builds (or rebuilds) the adjacency from the bus link tables */
+void topology_csr_build(TOPOLOGY_CSR *topo, BUSDATA *bus, unsigned int bus_count, BRANCHDATA *branch, unsigned int branch_count)
+{
+	unsigned int indexbus, indexlink, entry_count, entry;
+	int branch_val;
+
+	//Count the entries - every branch shows up in the table of both of its ends
+	entry_count = 0;
+	for (indexbus=0; indexbus<bus_count; indexbus++)
+	{
+		entry_count += bus[indexbus].Link_Table_Size;
+	}
+
+	topology_csr_alloc(topo,bus_count,entry_count);
+
+	//Populate - keep the Link_Table order, so searches visit branches in the same order as before
+	entry = 0;
+	for (indexbus=0; indexbus<bus_count; indexbus++)
+	{
+		topo->adj_start[indexbus] = entry;
+
+		for (indexlink=0; indexlink<bus[indexbus].Link_Table_Size; indexlink++)
+		{
+			branch_val = bus[indexbus].Link_Table[indexlink];
+
+			topo->adj_branch[entry] = branch_val;
+
+			//Resolve the far end
+			if (branch[branch_val].from == (int)indexbus)
+				topo->adj_bus[entry] = branch[branch_val].to;
+			else
+				topo->adj_bus[entry] = branch[branch_val].from;
+
+			entry++;
+		}
+	}
+	topo->adj_start[bus_count] = entry;
+
+	topo->branch_count = branch_count;
+}
+
+/* Releases the adjacency - leaves it flagged as not built */
+void topology_csr_free(TOPOLOGY_CSR *topo)
+{
+	if (topo->adj_start != NULL)
+		gl_free(topo->adj_start);
+	if (topo->adj_branch != NULL)
+		gl_free(topo->adj_branch);
+	if (topo->adj_bus != NULL)
+		gl_free(topo->adj_bus);
+
+	topo->adj_start = NULL;
+	topo->adj_branch = NULL;
+	topo->adj_bus = NULL;
+	topo->bus_count = 0;
+	topo->branch_count = 0;
+}
+
+/* Checks if the adjacency was built for the current bus/branch set */
+bool topology_csr_current(TOPOLOGY_CSR *topo, unsigned int bus_count, unsigned int branch_count)
+{
+	return ((topo->adj_start != NULL) && (topo->bus_count == bus_count) && (topo->branch_count == branch_count));
+}
+
+/* Breadth-first search from source over every entry - parent is -1 and dist INFINITY for buses it can't reach.
+   Every bus is queued at most once, so the queue is walked by index rather than circularly */
+void topology_csr_bfs(TOPOLOGY_CSR *topo, TOPOLOGY_SEARCH *search, int source, int *parent, double *dist)
+{
+	unsigned int index, entry, head, tail;
+	int bus_val, far_val;
+
+	for (index=0; index<topo->bus_count; index++)
+	{
+		search->queued[index] = 0;
+		parent[index] = -1;
+		dist[index] = INFINITY;
+	}
+
+	head = 0;
+	tail = 0;
+	search->queue[tail++] = source;
+	search->queued[source] = 1;
+	dist[source] = 0.0;
+
+	while (head < tail)
+	{
+		bus_val = search->queue[head++];
+
+		for (entry=topo->adj_start[bus_val]; entry<topo->adj_start[bus_val+1]; entry++)
+		{
+			far_val = topo->adj_bus[entry];
+
+			if (search->queued[far_val] == 0)	//Not discovered yet
+			{
+				search->queued[far_val] = 1;
+				dist[far_val] = dist[bus_val] + 1.0;
+				parent[far_val] = bus_val;
+				search->queue[tail++] = far_val;
+			}
+		}
+	}
+}
+
+/* Allocates (or resizes) a search workspace for bus_count buses */
+void topology_search_alloc(TOPOLOGY_SEARCH *search, unsigned int bus_count)
+{
+	unsigned int index;
+
+	if ((search->queue != NULL) && (search->size == bus_count))
+		return;
+
+	topology_search_free(search);
+
+	search->queue = (int *)gl_malloc((bus_count > 0 ? bus_count : 1)*sizeof(int));
+	search->stack_pos = (unsigned int *)gl_malloc((bus_count > 0 ? bus_count : 1)*sizeof(unsigned int));
+	search->queued = (char *)gl_malloc((bus_count > 0 ? bus_count : 1)*sizeof(char));
+
+	if ((search->queue == NULL) || (search->stack_pos == NULL) || (search->queued == NULL))
+	{
+		GL_THROW("NR: Failed to allocate the topology adjacency index");
+		//Defined above
+	}
+
+	for (index=0; index<bus_count; index++)
+		search->queued[index] = 0;
+
+	search->size = bus_count;
+}
+
+/* Releases a search workspace */
+void topology_search_free(TOPOLOGY_SEARCH *search)
+{
+	if (search->queue != NULL)
+		gl_free(search->queue);
+	if (search->stack_pos != NULL)
+		gl_free(search->stack_pos);
+	if (search->queued != NULL)
+		gl_free(search->queued);
+
+	search->queue = NULL;
+	search->stack_pos = NULL;
+	search->queued = NULL;
+	search->size = 0;
+}
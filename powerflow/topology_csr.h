@@ -0,0 +1,34 @@
+/* $Id
+ * Compressed-row adjacency of the Newton-Raphson bus/branch topology
+ */
+
+#ifndef _TOPOLOGY_CSR
+#define _TOPOLOGY_CSR
+
+#include "solver_nr.h"
+
+typedef struct {
+	unsigned int bus_count;		///< Number of buses (vertices) the adjacency was built for - 0 if never built
+	unsigned int branch_count;	///< Number of branches the adjacency was built for
+	unsigned int *adj_start;	///< Start of each bus's entries in adj_branch/adj_bus - bus_count+1 entries
+	int *adj_branch;			///< Branch of each adjacency entry - per bus, in Link_Table order (-1 for graphs without branches)
+	int *adj_bus;				///< Bus at the far end of each adjacency entry
+} TOPOLOGY_CSR;
+
+typedef struct {
+	unsigned int size;			///< Number of buses the workspace was allocated for
+	int *queue;					///< Buses waiting to be searched - used as a circular queue or a stack
+	unsigned int *stack_pos;	///< Next adjacency entry of each stacked bus (depth-first walks)
+	char *queued;				///< Flags buses currently in the queue
+} TOPOLOGY_SEARCH;
+
+void topology_csr_alloc(TOPOLOGY_CSR *topo, unsigned int bus_count, unsigned int entry_count);
+void topology_csr_build(TOPOLOGY_CSR *topo, BUSDATA *bus, unsigned int bus_count, BRANCHDATA *branch, unsigned int branch_count);
+void topology_csr_free(TOPOLOGY_CSR *topo);
+bool topology_csr_current(TOPOLOGY_CSR *topo, unsigned int bus_count, unsigned int branch_count);
+void topology_csr_bfs(TOPOLOGY_CSR *topo, TOPOLOGY_SEARCH *search, int source, int *parent, double *dist);
+
+void topology_search_alloc(TOPOLOGY_SEARCH *search, unsigned int bus_count);
+void topology_search_free(TOPOLOGY_SEARCH *search);
+
+#endif
@@ -55,7 +55,7 @@ triplex_meter::triplex_meter(MODULE *mod) : triplex_node(mod)
 		pclass = triplex_node::oclass;
 
 		// register the class definition
-		oclass = gl_register_class(mod,"triplex_meter",sizeof(triplex_meter),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK);
+		oclass = gl_register_class(mod,"triplex_meter",sizeof(triplex_meter),PC_PRETOPDOWN|PC_BOTTOMUP|PC_POSTTOPDOWN|PC_UNSAFE_OVERRIDE_OMIT|PC_AUTOLOCK|PC_CONCURRENT_LOAD);
 		if (oclass==NULL)
 			throw "unable to register class triplex_meter";
 		else
@@ -85,8 +85,8 @@ triplex_meter::triplex_meter(MODULE *mod) : triplex_node(mod)
 			PT_complex, "measured_current_1[A]", PADDR(measured_current[0]),PT_DESCRIPTION,"measured current, phase 1",
 			PT_complex, "measured_current_2[A]", PADDR(measured_current[1]),PT_DESCRIPTION,"measured current, phase 2",
 			PT_complex, "measured_current_N[A]", PADDR(measured_current[2]),PT_DESCRIPTION,"measured current, phase N",
-			PT_bool, "customer_interrupted", PADDR(tpmeter_interrupted),PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an interrupted state",
-			PT_bool, "customer_interrupted_secondary", PADDR(tpmeter_interrupted_secondary),PT_DESCRIPTION,"Reliability flag - goes active if the customer is in a secondary interrupted state - i.e., momentary",
+			PT_bool, "customer_interrupted", PADDR(tpmeter_interrupted),PT_HAS_NOTIFY,PT_DESCRIPTION,"Reliability flag - goes active if the customer is in an interrupted state",
+			PT_bool, "customer_interrupted_secondary", PADDR(tpmeter_interrupted_secondary),PT_HAS_NOTIFY,PT_DESCRIPTION,"Reliability flag - goes active if the customer is in a secondary interrupted state - i.e., momentary",
 #ifdef SUPPORT_OUTAGES
 			PT_int16, "sustained_count", PADDR(sustained_count),PT_DESCRIPTION,"reliability sustained event counter",
 			PT_int16, "momentary_count", PADDR(momentary_count),PT_DESCRIPTION,"reliability momentary event counter",
@@ -128,6 +128,10 @@ triplex_meter::triplex_meter(MODULE *mod) : triplex_node(mod)
 			if (gl_publish_function(oclass,	"delta_freq_pwr_object", (FUNCTIONADDR)delta_frequency_node)==NULL)
 				GL_THROW("Unable to publish triplex_meter deltamode function");
 
+			//Reliability functions
+			if (gl_publish_function(oclass,	"attach_interruption_counter", (FUNCTIONADDR)attach_interruption_counter_node)==NULL)
+				GL_THROW("Unable to publish triplex_meter reliability counter function");
+
                         // market price name
                         gl_global_create("powerflow::market_price_name",PT_char1024,&market_price_name,NULL);
 		}
@@ -249,7 +253,7 @@ TIMESTAMP triplex_meter::presync(TIMESTAMP t0)
 
 	//Reliability addition - clear momentary flag if set
 	if (tpmeter_interrupted_secondary == true)
-		tpmeter_interrupted_secondary = false;
+		set_interruption_flag(&tpmeter_interrupted_secondary,false,true);
 
     // Capturing first timestamp of simulation for use in delta energy measurements.
     if (t0 != 0 && start_timestamp == 0)
@@ -277,15 +281,15 @@ TIMESTAMP triplex_meter::sync(TIMESTAMP t0)
 
 		if ((NR_busdata[TempNodeRef].origphases & NR_busdata[TempNodeRef].phases) != NR_busdata[TempNodeRef].origphases)	//We have a phase mismatch - something has been lost
 		{
-			tpmeter_interrupted = true;	//Someone is out of service, they just may not know it
+			set_interruption_flag(&tpmeter_interrupted,true,false);	//Someone is out of service, they just may not know it
 
 			//See if we were "momentary" as well - if so, clear us.
 			if (tpmeter_interrupted_secondary == true)
-				tpmeter_interrupted_secondary = false;
+				set_interruption_flag(&tpmeter_interrupted_secondary,false,true);
 		}
 		else
 		{
-			tpmeter_interrupted = false;	//All is well
+			set_interruption_flag(&tpmeter_interrupted,false,false);	//All is well
 		}
 	}
 
@@ -509,7 +513,7 @@ SIMULATIONMODE triplex_meter::inter_deltaupdate_triplex_meter(unsigned int64 del
 
 			//Reliability addition - clear momentary flag if set
 			if (tpmeter_interrupted_secondary == true)
-				tpmeter_interrupted_secondary = false;
+				set_interruption_flag(&tpmeter_interrupted_secondary,false,true);
 
 		//Call triplex-specific call
 		BOTH_triplex_node_presync_fxn();
@@ -533,15 +537,15 @@ SIMULATIONMODE triplex_meter::inter_deltaupdate_triplex_meter(unsigned int64 del
 
 				if ((NR_busdata[TempNodeRef].origphases & NR_busdata[TempNodeRef].phases) != NR_busdata[TempNodeRef].origphases)	//We have a phase mismatch - something has been lost
 				{
-					tpmeter_interrupted = true;	//Someone is out of service, they just may not know it
+					set_interruption_flag(&tpmeter_interrupted,true,false);	//Someone is out of service, they just may not know it
 
 					//See if we were "momentary" as well - if so, clear us.
 					if (tpmeter_interrupted_secondary == true)
-						tpmeter_interrupted_secondary = false;
+						set_interruption_flag(&tpmeter_interrupted_secondary,false,true);
 				}
 				else
 				{
-					tpmeter_interrupted = false;	//All is well
+					set_interruption_flag(&tpmeter_interrupted,false,false);	//All is well
 				}
 			}
 
@@ -687,6 +691,19 @@ EXPORT int notify_triplex_meter(OBJECT *obj, int update_mode, PROPERTY *prop, ch
 }
 
 //Deltamode export
+//Property notifiers - customer interruption flags go through the node, so reliability counters see every change
+EXPORT int notify_triplex_meter_customer_interrupted(OBJECT *obj, char *value)
+{
+	triplex_meter *my = OBJECTDATA(obj,triplex_meter);
+	return my->set_interruption_flag_value("customer_interrupted",&my->tpmeter_interrupted,value,false);
+}
+
+EXPORT int notify_triplex_meter_customer_interrupted_secondary(OBJECT *obj, char *value)
+{
+	triplex_meter *my = OBJECTDATA(obj,triplex_meter);
+	return my->set_interruption_flag_value("customer_interrupted_secondary",&my->tpmeter_interrupted_secondary,value,true);
+}
+
 EXPORT SIMULATIONMODE interupdate_triplex_meter(OBJECT *obj, unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val, bool interupdate_pos)
 {
 	triplex_meter *my = OBJECTDATA(obj,triplex_meter);
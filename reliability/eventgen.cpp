@@ -116,6 +116,15 @@ int eventgen::create(void)
 	UnreliableObjs = NULL;
 	UnreliableObjCount = 0;
 
+	//Event calendar gets allocated once the object list is known
+	event_heap = NULL;
+	event_heap_pos = NULL;
+	event_heap_size = 0;
+	due_events = NULL;
+	pending_count_events = NULL;
+	pending_count_size = 0;
+	objs_in_fault = 0;
+
 	metrics_obj = NULL;
 	metrics_obj_hdr = NULL;
 
@@ -552,25 +561,13 @@ int eventgen::init(OBJECT *parent)
 			UnreliableObjs[index].rest_time_ns = 0;
 			UnreliableObjs[index].rest_time_dbl = TSNVRDBL;
 
-			//Populate the initial lengths though - could do later, but meh
-			gen_random_time(failure_dist,fail_dist_params[0],fail_dist_params[1],&UnreliableObjs[index].fail_length,&UnreliableObjs[index].fail_length_ns,&UnreliableObjs[index].fail_length_dbl);
-
-			//Find restoration time
-			gen_random_time(restore_dist,rest_dist_params[0],rest_dist_params[1],&temp_time_A,&temp_time_A_nano,&temp_time_A_dbl);
-
-			//If over max outage length, cap it - side note - minimum timestep issues handled inside gen_random_time
-			if (temp_time_A_dbl > max_outage_length_dbl)
-			{
-				UnreliableObjs[index].rest_length = max_outage_length;
-				UnreliableObjs[index].rest_length_ns = 0;
-				UnreliableObjs[index].rest_length_dbl = max_outage_length_dbl;
-			}
-			else
-			{
-				UnreliableObjs[index].rest_length = temp_time_A;
-				UnreliableObjs[index].rest_length_ns = temp_time_A_nano;
-				UnreliableObjs[index].rest_length_dbl = temp_time_A_dbl;
-			}
+			//Initial lengths are drawn on the first presync, after any replication has reseeded the random state
+			UnreliableObjs[index].fail_length = 0;
+			UnreliableObjs[index].fail_length_ns = 0;
+			UnreliableObjs[index].fail_length_dbl = 0.0;
+			UnreliableObjs[index].rest_length = 0;
+			UnreliableObjs[index].rest_length_ns = 0;
+			UnreliableObjs[index].rest_length_dbl = 0.0;
 
 			//Assume all start not in the fault state
 			UnreliableObjs[index].in_fault = false;
@@ -597,6 +594,32 @@ int eventgen::init(OBJECT *parent)
 		curr_rest_dist = restore_dist;
 	}	//End randomized fault mode
 
+	//Allocate the event calendar - one slot per unreliable object, along with its scratch lists
+	event_heap = (int*)gl_malloc(UnreliableObjCount * sizeof(int));
+	event_heap_pos = (int*)gl_malloc(UnreliableObjCount * sizeof(int));
+	due_events = (int*)gl_malloc(UnreliableObjCount * sizeof(int));
+	pending_count_events = (int*)gl_malloc(UnreliableObjCount * sizeof(int));
+
+	//Make sure it worked
+	if ((event_heap == NULL) || (event_heap_pos == NULL) || (due_events == NULL) || (pending_count_events == NULL))
+	{
+		GL_THROW("Failed to allocate memory for event calendar in %s",hdr->name);
+		/*  TROUBLESHOOT
+		The event_gen object failed to allocate memory for the calendar used to order failure and
+		restoration times.  Please try again.  If the error persists, submit your code and a bug report using
+		the trac website.
+		*/
+	}
+
+	//Calendar starts empty - it is populated on the first presync, once failure times are known
+	for (index=0; index<UnreliableObjCount; index++)
+	{
+		event_heap_pos[index] = -1;
+	}
+	event_heap_size = 0;
+	pending_count_size = 0;
+	objs_in_fault = 0;
+
 	//Check simultaneous fault value
 	if (((max_simult_faults == -1) || (max_simult_faults > 1)) && (metrics_obj != NULL))	//infinite or more than 1 - and metrics are on, so we care
 	{
@@ -645,6 +668,9 @@ TIMESTAMP eventgen::presync(TIMESTAMP t0, TIMESTAMP t1)
 	int index;
 	double t1_dbl;
 	double gld_stoptime;
+	TIMESTAMP temp_time_A;
+	unsigned int temp_time_A_nano;
+	double temp_time_A_dbl;
 
 	//Cast time for any "deltamode-needed" calculations
 	t1_dbl = (double)t1;
@@ -671,16 +697,32 @@ TIMESTAMP eventgen::presync(TIMESTAMP t0, TIMESTAMP t1)
 	//Check if first run, if so, do some additional work
 	if (next_event_time==0)
 	{
-		//Make next_event_time REALLY big
-		next_event_time = TS_NEVER;
-		next_event_time_dbl = TSNVRDBL;
-		
 		//Loop through and update timevalues
 		for (index=0; index<UnreliableObjCount; index++)
 		{
 			//Failure time - only needs to be computed if "random" mode
 			if (fault_implement_mode == false)
 			{
+				//Draw the initial lengths here rather than in init, so replications forked after init each start from their own random state
+				gen_random_time(failure_dist,fail_dist_params[0],fail_dist_params[1],&UnreliableObjs[index].fail_length,&UnreliableObjs[index].fail_length_ns,&UnreliableObjs[index].fail_length_dbl);
+
+				//Find restoration time
+				gen_random_time(restore_dist,rest_dist_params[0],rest_dist_params[1],&temp_time_A,&temp_time_A_nano,&temp_time_A_dbl);
+
+				//If over max outage length, cap it - side note - minimum timestep issues handled inside gen_random_time
+				if (temp_time_A_dbl > max_outage_length_dbl)
+				{
+					UnreliableObjs[index].rest_length = max_outage_length;
+					UnreliableObjs[index].rest_length_ns = 0;
+					UnreliableObjs[index].rest_length_dbl = max_outage_length_dbl;
+				}
+				else
+				{
+					UnreliableObjs[index].rest_length = temp_time_A;
+					UnreliableObjs[index].rest_length_ns = temp_time_A_nano;
+					UnreliableObjs[index].rest_length_dbl = temp_time_A_dbl;
+				}
+
 				//Deltamode check - handle times "traditionally" or not
 				if (deltamode_inclusive == true)
 				{
@@ -694,15 +736,14 @@ TIMESTAMP eventgen::presync(TIMESTAMP t0, TIMESTAMP t1)
 				}
 			}
 
-			//See if it is a new minimum - don't need to check fault state - first run assumes all are good
-			if (UnreliableObjs[index].fail_time < next_event_time)
-			{
-				next_event_time = UnreliableObjs[index].fail_time;
-				if (deltamode_inclusive == true)
-					next_event_time_dbl = UnreliableObjs[index].fail_time_dbl;
-			}
 		}
 
+		//Populate the event calendar - first run assumes all are good, so everything is keyed on failure times
+		event_heap_build();
+
+		//Pull the earliest event out of it
+		event_heap_next_time();
+
 		//Linked list is ignored on this first run - it will get caught as part of the normal routine
 		if (deltamode_inclusive && enable_subsecond_models)	//We want deltamode - see if it's populated yet
 		{
@@ -822,7 +863,7 @@ TIMESTAMP eventgen::presync(TIMESTAMP t0, TIMESTAMP t1)
 
 TIMESTAMP eventgen::postsync(TIMESTAMP t0, TIMESTAMP t1)
 {
-	int after_count, after_count_sec, differential_count, differential_count_sec, index;
+	int after_count, after_count_sec, differential_count, differential_count_sec, index, pend_index;
 	RELEVANTSTRUCT *temp_struct;
 
 	//See if we need a "post-fault" count - assumes all customers will determine their outage state by either presync or sync (or before this in postsync)
@@ -868,9 +909,11 @@ TIMESTAMP eventgen::postsync(TIMESTAMP t0, TIMESTAMP t1)
 				differential_count_sec = after_count_sec;
 			}
 
-			//Apply the update to objects needing it
-			for (index=0; index<UnreliableObjCount; index++)
+			//Apply the update to objects needing it - only the ones faulted since the last count can
+			for (pend_index=0; pend_index<pending_count_size; pend_index++)
 			{
+				index = pending_count_events[pend_index];
+
 				if (UnreliableObjs[index].customers_affected == -1)	//We need it
 					UnreliableObjs[index].customers_affected = differential_count;
 
@@ -878,6 +921,9 @@ TIMESTAMP eventgen::postsync(TIMESTAMP t0, TIMESTAMP t1)
 					UnreliableObjs[index].customers_affected_sec = differential_count_sec;
 			}
 
+			//All caught up
+			pending_count_size = 0;
+
 			//Check the linked list as well
 			if (Unhandled_Events.next != NULL)	//Something is in there!
 			{
@@ -913,13 +959,18 @@ TIMESTAMP eventgen::postsync(TIMESTAMP t0, TIMESTAMP t1)
 				differential_count = after_count;
 			}
 
-			//Apply the update to objects needing it
-			for (index=0; index<UnreliableObjCount; index++)
+			//Apply the update to objects needing it - only the ones faulted since the last count can
+			for (pend_index=0; pend_index<pending_count_size; pend_index++)
 			{
+				index = pending_count_events[pend_index];
+
 				if (UnreliableObjs[index].customers_affected == -1)	//We need it
 					UnreliableObjs[index].customers_affected = differential_count;
 			}
 
+			//All caught up
+			pending_count_size = 0;
+
 			//Check the linked list as well
 			if (Unhandled_Events.next != NULL)	//Something is in there!
 			{
@@ -1302,11 +1353,6 @@ void eventgen::regen_events(TIMESTAMP t1_ts, double t1_dbl){
 		gl_verbose("Distribution parameters changed for %s",hdr->name);
 		
 		//Loop through the objects and handle appropriately
-		
-		//Reset event timer as well, since it may be invalid now
-		next_event_time = TS_NEVER;
-		next_event_time_dbl = TSNVRDBL;
-
 		for (index=0; index<UnreliableObjCount; index++)
 		{
 			if (UnreliableObjs[index].in_fault == false)	//Not faulting, so we don't care if we are now a fault or if we have one upcoming
@@ -1344,21 +1390,6 @@ void eventgen::regen_events(TIMESTAMP t1_ts, double t1_dbl){
 					UnreliableObjs[index].fail_time = t1_ts + UnreliableObjs[index].fail_length;
 				}
 
-				//Check progression - supersecond
-				if (UnreliableObjs[index].fail_time < next_event_time)
-				{
-					next_event_time = UnreliableObjs[index].fail_time;
-				}
-
-				//Check progression - subsecond
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].fail_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].fail_time_dbl;
-					}
-				}
-
 				//Flag restoration time
 				UnreliableObjs[index].rest_time = TS_NEVER;
 				UnreliableObjs[index].rest_time_ns = 0;
@@ -1368,27 +1399,180 @@ void eventgen::regen_events(TIMESTAMP t1_ts, double t1_dbl){
 				UnreliableObjs[index].in_fault = false;
 
 			}//End non-faulted object update
-			else	//Implies it is in a fault - update next_event_time (if it is done, it will be handled below)
-			{
-				//Check supersecond
-				if (UnreliableObjs[index].rest_time < next_event_time)
-				{
-					next_event_time = UnreliableObjs[index].rest_time;
-				}
-
-				//Check subsecond
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].rest_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].rest_time_dbl;
-					}
-				}
-			}
+			//Defaulted else - in a fault, so it keeps its restoration time (if it is done, it will be handled below)
 		}//End failed objects traversion
+
+		//Nearly every key changed, so rebuild the calendar rather than updating it entry by entry
+		event_heap_build();
+
+		//Reset event timer as well, since it may be invalid now
+		event_heap_next_time();
 	}//end distribution parameter change
 }
 
+//Comparison function for qsort - orders calendar entries by object index
+static int compare_event_index(const void *index_a, const void *index_b)
+{
+	return (*(const int *)index_a) - (*(const int *)index_b);
+}
+
+//Function to extract the next event time of an object - restoration if in a fault, failure otherwise
+void eventgen::event_key(int index, TIMESTAMP *key_ts, double *key_dbl)
+{
+	if (UnreliableObjs[index].in_fault == true)
+	{
+		*key_ts = UnreliableObjs[index].rest_time;
+		*key_dbl = UnreliableObjs[index].rest_time_dbl;
+	}
+	else
+	{
+		*key_ts = UnreliableObjs[index].fail_time;
+		*key_dbl = UnreliableObjs[index].fail_time_dbl;
+	}
+}
+
+//Function to order two objects in the event calendar
+//Whole seconds first, then the double-precision time (deltamode only), then object order to keep ties deterministic
+bool eventgen::event_before(int index_a, int index_b)
+{
+	TIMESTAMP ts_a, ts_b;
+	double dbl_a, dbl_b;
+
+	event_key(index_a,&ts_a,&dbl_a);
+	event_key(index_b,&ts_b,&dbl_b);
+
+	if (ts_a != ts_b)
+		return (ts_a < ts_b);
+
+	if ((deltamode_inclusive == true) && (dbl_a != dbl_b))
+		return (dbl_a < dbl_b);
+
+	return (index_a < index_b);
+}
+
+//Function to exchange two calendar entries, keeping the position index current
+void eventgen::event_heap_swap(int pos_a, int pos_b)
+{
+	int temp_index;
+
+	temp_index = event_heap[pos_a];
+	event_heap[pos_a] = event_heap[pos_b];
+	event_heap[pos_b] = temp_index;
+
+	event_heap_pos[event_heap[pos_a]] = pos_a;
+	event_heap_pos[event_heap[pos_b]] = pos_b;
+}
+
+//Function to move a calendar entry up until its parent is earlier
+void eventgen::event_heap_sift_up(int pos)
+{
+	int parent_pos;
+
+	while (pos > 0)
+	{
+		parent_pos = (pos - 1) >> 1;
+
+		if (event_before(event_heap[pos],event_heap[parent_pos]) == false)
+			break;
+
+		event_heap_swap(pos,parent_pos);
+		pos = parent_pos;
+	}
+}
+
+//Function to move a calendar entry down until both children are later
+void eventgen::event_heap_sift_down(int pos)
+{
+	int child_pos, best_pos;
+
+	while (true)
+	{
+		best_pos = pos;
+		child_pos = (pos << 1) + 1;
+
+		if ((child_pos < event_heap_size) && (event_before(event_heap[child_pos],event_heap[best_pos]) == true))
+			best_pos = child_pos;
+
+		child_pos++;
+
+		if ((child_pos < event_heap_size) && (event_before(event_heap[child_pos],event_heap[best_pos]) == true))
+			best_pos = child_pos;
+
+		if (best_pos == pos)
+			break;
+
+		event_heap_swap(pos,best_pos);
+		pos = best_pos;
+	}
+}
+
+//Function to queue an object in the calendar - keyed on its current next event time
+void eventgen::event_heap_push(int index)
+{
+	event_heap[event_heap_size] = index;
+	event_heap_pos[index] = event_heap_size;
+	event_heap_size++;
+
+	event_heap_sift_up(event_heap_size - 1);
+}
+
+//Function to remove the earliest object from the calendar
+int eventgen::event_heap_pop(void)
+{
+	int index;
+
+	index = event_heap[0];
+	event_heap_pos[index] = -1;
+	event_heap_size--;
+
+	if (event_heap_size > 0)
+	{
+		event_heap[0] = event_heap[event_heap_size];
+		event_heap_pos[event_heap[0]] = 0;
+		event_heap_sift_down(0);
+	}
+
+	return index;
+}
+
+//Function to rebuild the calendar from every object - bottom-up heap construction, so linear in the object count
+void eventgen::event_heap_build(void)
+{
+	int index;
+
+	for (index=0; index<UnreliableObjCount; index++)
+	{
+		event_heap[index] = index;
+		event_heap_pos[index] = index;
+	}
+	event_heap_size = UnreliableObjCount;
+
+	for (index=(event_heap_size >> 1)-1; index>=0; index--)
+	{
+		event_heap_sift_down(index);
+	}
+}
+
+//Function to set next_event_time from the head of the calendar
+void eventgen::event_heap_next_time(void)
+{
+	TIMESTAMP key_ts;
+	double key_dbl;
+
+	next_event_time = TS_NEVER;
+	next_event_time_dbl = TSNVRDBL;
+
+	if (event_heap_size > 0)
+	{
+		event_key(event_heap[0],&key_ts,&key_dbl);
+
+		next_event_time = key_ts;
+
+		if (deltamode_inclusive == true)
+			next_event_time_dbl = key_dbl;
+	}
+}
+
 //Functionalized version of old presync code
 //Performs actual event status changes on the system
 void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
@@ -1399,23 +1583,46 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 	unsigned int temp_time_A_nano;
 	TIMESTAMP mean_repair_time;
 	FUNCTIONADDR funadd = NULL;
-	int returnval, index;
+	int returnval, index, due_index, due_count;
 	char impl_fault[257];
 	RELEVANTSTRUCT *temp_struct, *temp_struct_b;
 	void *Extra_Data;
+	TIMESTAMP key_ts;
+	double key_dbl;
 
 	//Initialize
 	Extra_Data = NULL;
 	
-	//Reset next event time - we'll find the new one in here
-	next_event_time = TS_NEVER;
-	next_event_time_dbl = TSNVRDBL;
+	//Pull every calendar entry whose event time has arrived
+	due_count = 0;
+	while (event_heap_size > 0)
+	{
+		event_key(event_heap[0],&key_ts,&key_dbl);
 
-	//Loop through and find events that are next
-	for (index=0; index<UnreliableObjCount; index++)
+		if (((key_ts <= t1_ts) && (entry_type == false)) || ((key_dbl <= t1_dbl) && (entry_type == true)))
+		{
+			due_events[due_count] = event_heap_pop();
+			due_count++;
+		}
+		else	//Calendar is ordered, so nothing else is due
+		{
+			break;
+		}
+	}
+
+	//Handle them in object order - fault limits and random draws then progress exactly as a full sweep of the list would
+	if (due_count > 1)
+	{
+		qsort(due_events,due_count,sizeof(int),compare_event_index);
+	}
+
+	//Loop through the events that are next
+	for (due_index=0; due_index<due_count; due_index++)
 	{
+		index = due_events[due_index];
+
 		//Check failure time
-		if ((((UnreliableObjs[index].fail_time <= t1_ts) && (entry_type == false)) || ((UnreliableObjs[index].fail_time_dbl <= t1_dbl) && (entry_type == true))) && (UnreliableObjs[index].in_fault == false))	//Failure!
+		if (UnreliableObjs[index].in_fault == false)	//Failure!
 		{
 			//See if we're allowed to fault
 			if ((faults_in_prog < max_simult_faults) || (max_simult_faults == -1))	//Room to fault or infinite amount
@@ -1491,23 +1698,16 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 					UnreliableObjs[index].rest_time_dbl += (double)mean_repair_time;
 				}
 
-				//See if this is the new update -- supersecond
-				if (UnreliableObjs[index].rest_time < next_event_time)
-				{
-					next_event_time = UnreliableObjs[index].rest_time;
-				}
-
-				//Subsecond update
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].rest_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].rest_time_dbl;
-					}
-				}				
-
 				//Flag outage time so it won't trip things
 				UnreliableObjs[index].in_fault = true;
+				objs_in_fault++;
+
+				//Queue us for the post-fault customer count, if we aren't already waiting on one
+				if (UnreliableObjs[index].customers_affected != -1)
+				{
+					pending_count_events[pending_count_size] = index;
+					pending_count_size++;
+				}
 
 				//Flag customer count to know we need to populate this value
 				UnreliableObjs[index].customers_affected = -1;
@@ -1537,21 +1737,6 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 					{
 						UnreliableObjs[index].fail_time = t1_ts + UnreliableObjs[index].fail_length;
 					}
-
-					//Check progression -- super second
-					if (UnreliableObjs[index].fail_time < next_event_time)
-					{
-						next_event_time = UnreliableObjs[index].fail_time;
-					}
-
-					//Check progression -- subsecond
-					if (deltamode_inclusive == true)
-					{
-						if (UnreliableObjs[index].fail_time_dbl < next_event_time_dbl)
-						{
-							next_event_time_dbl = UnreliableObjs[index].fail_time_dbl;
-						}
-					}
 				}
 				else	//Deterministic mode - if this happens, a parameter was set wrong.  Flag this as already occurred and move on
 				{
@@ -1573,7 +1758,7 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 				}
 			}
 		}
-		else if (((UnreliableObjs[index].rest_time <= t1_ts) && (entry_type == false)) || ((UnreliableObjs[index].rest_time_dbl <= t1_dbl) && (entry_type == true)))	//Restoration time!
+		else	//Restoration time!
 		{
 			//Call the object back into service
 			funadd = (FUNCTIONADDR)(gl_get_function(UnreliableObjs[index].obj_of_int,"fix_fault"));
@@ -1659,19 +1844,6 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 					UnreliableObjs[index].fail_time = t1_ts + UnreliableObjs[index].fail_length;
 				}
 
-				//Check progression -- super-second
-				if (UnreliableObjs[index].fail_time < next_event_time)
-					next_event_time = UnreliableObjs[index].fail_time;
-
-				//Check progression -- subsecond
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].fail_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].fail_time_dbl;
-					}
-				}
-
 				//Flag restoration time
 				UnreliableObjs[index].rest_time = TS_NEVER;
 				UnreliableObjs[index].rest_time_ns = 0;
@@ -1691,50 +1863,18 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 
 			//De-flag the update
 			UnreliableObjs[index].in_fault = false;
+			objs_in_fault--;
 
 			//Decrement us out of the simultaneous fault count (allows possibility of later object in list to fault before count updated)
 			faults_in_prog--;
 		}
-		else	//Not either - see where we sit against the max
-		{
-			//Failure mode?
-			if (UnreliableObjs[index].in_fault == false)
-			{
-				//Super second check
-				if (UnreliableObjs[index].fail_time < next_event_time)
-				{
-					next_event_time = UnreliableObjs[index].fail_time;
-				}
 
-				//Subsecond check
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].fail_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].fail_time_dbl;
-					}
-				}
-			}
-			else //Restoration
-			{
-				//Super-second
-				if (UnreliableObjs[index].rest_time < next_event_time)
-				{
-					next_event_time = UnreliableObjs[index].rest_time;
-				}
+		//Put us back into the calendar with our new event time
+		event_heap_push(index);
+	}//End due event traversion
 
-				//Sub-second
-				if (deltamode_inclusive == true)
-				{
-					if (UnreliableObjs[index].rest_time_dbl < next_event_time_dbl)
-					{
-						next_event_time_dbl = UnreliableObjs[index].rest_time_dbl;
-					}
-				}
-			}
-			//Defaulted else - we're bigger than the current min
-		}
-	}//End object loop traversion
+	//Earliest remaining calendar entry is the next event - linked list items are checked against it below
+	event_heap_next_time();
 
 	//Traverse the linked list - if anything is in it
 	if (Unhandled_Events.next != NULL)	//Something is in there!
@@ -1960,14 +2100,8 @@ void eventgen::do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type)
 	}//end unhandled events linked list
 
 	//Reset and update our current fault counter (just to ensure things are accurate)
-	faults_in_prog = 0;
-	
-	//Loop through objects and increment as necessary
-	for (index=0; index<UnreliableObjCount;index++)
-	{
-		if (UnreliableObjs[index].in_fault == true)
-			faults_in_prog++;
-	}
+	//Object faults are tracked as they transition, so only the linked list needs a count
+	faults_in_prog = objs_in_fault;
 
 	//Loop through the linked-list and do the same
 	if (Unhandled_Events.next != NULL)	//Something is in there!
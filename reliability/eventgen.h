@@ -87,6 +87,23 @@ private:
 	void do_event(TIMESTAMP t1_ts, double t1_dbl, bool entry_type);	/**< Function to execute a status change on objects driven by event_gen */
 	void regen_events(TIMESTAMP t1_ts, double t1_dbl);				/**< Function to update time to next event on the system */
 
+	int *event_heap;				/**< Indexed min-heap of UnreliableObjs entries, ordered by their next failure/restoration time */
+	int *event_heap_pos;			/**< Position of each UnreliableObjs entry inside event_heap (-1 if not queued) */
+	int event_heap_size;			/**< Number of entries currently in event_heap */
+	int *due_events;				/**< Scratch list of UnreliableObjs entries whose event time has arrived */
+	int *pending_count_events;		/**< UnreliableObjs entries waiting on a post-fault customer count */
+	int pending_count_size;			/**< Number of entries in pending_count_events */
+	int objs_in_fault;				/**< Number of UnreliableObjs entries currently in a fault condition */
+	void event_key(int index, TIMESTAMP *key_ts, double *key_dbl);	/**< Function to extract the next event time of an UnreliableObjs entry */
+	bool event_before(int index_a, int index_b);					/**< Function to order two UnreliableObjs entries in the calendar */
+	void event_heap_swap(int pos_a, int pos_b);						/**< Function to exchange two calendar entries */
+	void event_heap_sift_up(int pos);								/**< Function to move a calendar entry towards the root */
+	void event_heap_sift_down(int pos);								/**< Function to move a calendar entry towards the leaves */
+	void event_heap_push(int index);								/**< Function to queue an UnreliableObjs entry in the calendar */
+	int event_heap_pop(void);										/**< Function to remove the earliest entry from the calendar */
+	void event_heap_build(void);									/**< Function to (re)build the calendar from all UnreliableObjs entries */
+	void event_heap_next_time(void);								/**< Function to seed next_event_time from the head of the calendar */
+
 public:
 	RELEVANTSTRUCT Unhandled_Events;	/**< unhandled event linked list */
 	enumeration failure_dist;		/**< failure distribution */
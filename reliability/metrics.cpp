@@ -62,6 +62,10 @@ int metrics::create(void)
 	report_interval = 0;
 	CustomerCount = 0;
 	Customers = NULL;
+	incremental_counts = false;
+	interrupted_count = 0;
+	interrupted_count_sec = 0;
+	interrupted_count_lock = 0;
 	curr_time = TS_NEVER;	//Flagging value
 	metric_interval_event_count = 0;
 	annual_interval_event_count = 0;
@@ -487,6 +491,9 @@ int metrics::init(OBJECT *parent)
 	//Free up list
 	gl_free(CandidateObjs);
 
+	//See if the customers can keep the interrupted counts up to date for us
+	attach_interruption_counters();
+
 	//Write the customer count and header information to the file we have going
 	fprintf(FPVal,"Number of customers = %d\n\n",CustomerCount);
 
@@ -805,11 +812,90 @@ void metrics::event_ended_sec(OBJECT *event_obj, OBJECT *fault_obj, OBJECT *faul
 	}
 }
 
+//Function to link the interrupted counters into the customers
+//Customers that publish attach_interruption_counter adjust the counts whenever their interrupted flags change, so
+//events don't need to poll every customer.  If any customer can't, the counts are found by scanning the list instead.
+void metrics::attach_interruption_counters(void)
+{
+	OBJECT *hdr = OBJECTHDR(this);
+	FUNCTIONADDR *attach_funcs;
+	int index, returnval;
+
+	//Map everyone's function first - all or nothing
+	attach_funcs = (FUNCTIONADDR*)gl_malloc(CustomerCount*sizeof(FUNCTIONADDR));
+
+	//Make sure it worked
+	if (attach_funcs == NULL)
+	{
+		GL_THROW("Failure to allocate customer counter memory in metrics:%s",hdr->name);
+		/*  TROUBLESHOOT
+		While allocating the memory used to link customers to the interruption counters, GridLAB-D encountered a problem.
+		Please try again.  If the error persists, please submit your code and a bug report via the
+		trac website.
+		*/
+	}
+
+	for (index=0; index<CustomerCount; index++)
+	{
+		attach_funcs[index] = (FUNCTIONADDR)(gl_get_function(Customers[index].CustomerObj,"attach_interruption_counter"));
+
+		//If one is missing, stay with scanning
+		if (attach_funcs[index] == NULL)
+		{
+			gl_verbose("metrics:%s - customer %s does not maintain interruption counts, customers will be scanned on each event",hdr->name,Customers[index].CustomerObj->name?Customers[index].CustomerObj->name:"unnamed");
+			gl_free(attach_funcs);
+			return;
+		}
+	}
+
+	//Start the counts from where the customers are now
+	interrupted_count = 0;
+	interrupted_count_sec = 0;
+
+	for (index=0; index<CustomerCount; index++)
+	{
+		if (*Customers[index].CustInterrupted == true)
+			interrupted_count++;
+
+		if ((secondary_interruptions_count == true) && (*Customers[index].CustInterrupted_Secondary == true))
+			interrupted_count_sec++;
+
+		//Hand the counters over
+		returnval = ((int (*)(OBJECT *, int *, int *, unsigned int *))(*attach_funcs[index]))(Customers[index].CustomerObj,&interrupted_count,&interrupted_count_sec,&interrupted_count_lock);
+
+		//Make sure it worked
+		if (returnval == 0)
+		{
+			GL_THROW("Failed to attach interruption counters to customer %s in metrics:%s",Customers[index].CustomerObj->name,hdr->name);
+			/*  TROUBLESHOOT
+			While linking the interruption counters into a customer object, an error occurred.  Please try again.
+			If the error persists, please submit your code and a bug report via the trac website.
+			*/
+		}
+	}
+
+	//Free up the mapping
+	gl_free(attach_funcs);
+
+	//Counts are now live
+	incremental_counts = true;
+}
+
 //Function to obtain number of customers experiencing outage condition
 int metrics::get_interrupted_count(void)
 {
 	int index, in_outage;
 
+	//See if the customers are keeping count for us
+	if (incremental_counts == true)
+	{
+		::rlock(&interrupted_count_lock);
+		in_outage = interrupted_count;
+		::runlock(&interrupted_count_lock);
+
+		return in_outage;
+	}
+
 	//Reset counter
 	in_outage = 0;
 
@@ -829,6 +915,17 @@ void metrics::get_interrupted_count_secondary(int *in_outage, int *in_outage_sec
 {
 	int index, in_outage_temp, in_outage_temp_sec;
 
+	//See if the customers are keeping count for us
+	if (incremental_counts == true)
+	{
+		::rlock(&interrupted_count_lock);
+		*in_outage = interrupted_count;
+		*in_outage_secondary = interrupted_count_sec;
+		::runlock(&interrupted_count_lock);
+
+		return;
+	}
+
 	//Reset counter
 	in_outage_temp = 0;
 	in_outage_temp_sec = 0;
@@ -41,6 +41,10 @@ private:
 	bool metric_equal_annual;			//Flag to see if annual and "metric interval" are the same length
 	int CustomerCount;		//Number of candidate objects (customers) found
 	CUSTARRAY *Customers;	//Array of candidate objects (customers)
+	bool incremental_counts;		//Flag to indicate customers report interruption transitions, so the counts below are live
+	int interrupted_count;			//Number of customers currently interrupted - maintained by the customers themselves
+	int interrupted_count_sec;		//Number of customers currently secondarily interrupted - maintained by the customers themselves
+	unsigned int interrupted_count_lock;	//Lock for the interrupted counters
 	FUNCTIONADDR reset_interval_func;	//Pointer to metric "interval" reset
 	FUNCTIONADDR reset_annual_func;		//Pointer to metric annual reset
 	FUNCTIONADDR compute_metrics;		//Pointer to metric computation function
@@ -49,6 +53,7 @@ private:
 	
 	double *get_metric(OBJECT *obj, char *name);	//Function to extract address of double value (metric)
 	bool *get_outage_flag(OBJECT *obj, char *name);	//Function to extract address of outage flag
+	void attach_interruption_counters(void);		//Function to hand the interrupted counters to customers that can maintain them
 public:
 	static bool report_event_log;
 
@@ -17,6 +17,8 @@ residential_residential_la_SOURCES += residential/dishwasher.cpp
 residential_residential_la_SOURCES += residential/dishwasher.h
 residential_residential_la_SOURCES += residential/dryer.cpp
 residential_residential_la_SOURCES += residential/dryer.h
+residential_residential_la_SOURCES += residential/enduse_batch.cpp
+residential_residential_la_SOURCES += residential/enduse_batch.h
 residential_residential_la_SOURCES += residential/evcharger.cpp
 residential_residential_la_SOURCES += residential/evcharger_det.cpp
 residential_residential_la_SOURCES += residential/evcharger_det.h
@@ -55,3 +57,7 @@ residential_residential_la_SOURCES += residential/zipload.cpp
 residential_residential_la_SOURCES += residential/zipload.h
 residential_residential_la_SOURCES += residential/elcap1990.h
 residential_residential_la_SOURCES += residential/elcap2010.h
+
+if ENABLE_BENCHMARKS
+residential_residential_la_SOURCES += residential/enduse_batch_bench.cpp
+endif
@@ -0,0 +1,199 @@
+/** $Id: enduse_batch.cpp
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file enduse_batch.cpp
+	@addtogroup residential_enduse
+	@ingroup residential
+
+	Batched exponential updates for enduses (see enduse_batch.h)
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "enduse_batch.h"
+
+#ifdef ENDUSE_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+enduse_batch::enduse_batch(ENDUSEBATCHFINISH fn, ENDUSEBATCHMODE m)
+{
+	mode = m;
+	finish = fn;
+	n_members = max_members = 0;
+	member = NULL;
+	exponent = NULL;
+	pending = NULL;
+	x = y = NULL;
+	slot = NULL;
+	n_queued = 0;
+	lock = 0;
+}
+
+enduse_batch::~enduse_batch(void)
+{
+	free(member);
+	free(exponent);
+	free(pending);
+	free(x);
+	free(y);
+	free(slot);
+}
+
+/** Adds an object to the batch
+	@return the object's slot
+ **/
+unsigned int enduse_batch::add(void *obj)
+{
+	unsigned int n;
+	wlock(&lock);
+	if ( n_members==max_members )
+	{
+		unsigned int size = max_members>0 ? max_members*2 : 64;
+		member = (void**)realloc(member,sizeof(void*)*size);
+		exponent = (double*)realloc(exponent,sizeof(double)*size);
+		pending = (unsigned char*)realloc(pending,sizeof(unsigned char)*size);
+		x = (double*)realloc(x,sizeof(double)*size);
+		y = (double*)realloc(y,sizeof(double)*size);
+		slot = (unsigned int*)realloc(slot,sizeof(unsigned int)*size);
+		if ( member==NULL || exponent==NULL || pending==NULL || x==NULL || y==NULL || slot==NULL )
+		{
+			wunlock(&lock);
+			GL_THROW("enduse_batch::add(): unable to allocate space for %u objects", size);
+			/*	TROUBLESHOOT
+				The batch of enduse objects that update together could not be grown.  The system
+				is probably out of memory.  Set the module's batch global to NONE to run without
+				batching, or reduce the size of the model.
+			 */
+		}
+		max_members = size;
+	}
+	n = n_members++;
+	member[n] = obj;
+	exponent[n] = 0.0;
+	pending[n] = 0;
+	wunlock(&lock);
+	return n;
+}
+
+/** Queues the exponent of an object's update, to be applied at the next flush
+ **/
+void enduse_batch::queue(unsigned int n, double value)
+{
+	exponent[n] = value;
+	pending[n] = 1;
+	n_queued = 1;
+}
+
+/** Applies all queued updates
+	The first caller does the work, anyone arriving while it does waits for it to finish
+ **/
+void enduse_batch::flush(void)
+{
+	unsigned int n, count;
+
+	wlock(&lock);
+	if ( n_queued!=0 )
+	{
+		// gather the queued exponents
+		for ( n=0, count=0 ; n<n_members ; n++ )
+		{
+			if ( pending[n] )
+			{
+				x[count] = exponent[n];
+				slot[count] = n;
+				pending[n] = 0;
+				count++;
+			}
+		}
+		n_queued = 0;
+
+		enduse_vexp(y,x,count,mode);
+
+		for ( n=0 ; n<count ; n++ )
+			(*finish)(member[slot[n]],y[n]);
+	}
+	wunlock(&lock);
+}
+
+#ifdef ENDUSE_BATCH_SSE2
+
+#define VEXP_BITS	8		// 2^(j/256) table
+#define VEXP_SIZE	(1<<VEXP_BITS)
+#define VEXP_SCALE	(VEXP_SIZE/0.69314718055994530942)
+#define VEXP_LN2HI	(6.93147180369123816490e-01/VEXP_SIZE)	// high bits of ln(2)/256, n*VEXP_LN2HI is exact for |n|<2^21
+#define VEXP_LN2LO	(1.90821492927058770002e-10/VEXP_SIZE)
+#define VEXP_LIMIT	708.0	// beyond this 2^k is not a normal double, such exponents go to the C library
+
+static double vexp_table[VEXP_SIZE];
+
+/* the table is filled when the module is loaded, before any thread can call enduse_vexp() */
+static struct vexp_init {
+	vexp_init(void)
+	{
+		int j;
+		for ( j=0 ; j<VEXP_SIZE ; j++ )
+			vexp_table[j] = pow(2.0,(double)j/VEXP_SIZE);
+	}
+} vexp_table_init;
+
+/* exp(x) = 2^k * 2^(j/256) * exp(r), with n = 256k + j = round(x*256/ln2), |r| <= ln2/512
+   exp(r) is the Taylor series to r^5, whose truncation error is below 1e-19 relative */
+static inline __m128d vexp_pd(__m128d vx)
+{
+	const __m128d one = _mm_set1_pd(1.0);
+	__m128i ni = _mm_cvtpd_epi32(_mm_mul_pd(vx,_mm_set1_pd(VEXP_SCALE)));	// round to nearest
+	__m128d vn = _mm_cvtepi32_pd(ni);
+	__m128d r = _mm_sub_pd(_mm_sub_pd(vx,_mm_mul_pd(vn,_mm_set1_pd(VEXP_LN2HI))),_mm_mul_pd(vn,_mm_set1_pd(VEXP_LN2LO)));
+	__m128d p = _mm_set1_pd(1.0/120.0);
+	p = _mm_add_pd(_mm_mul_pd(p,r),_mm_set1_pd(1.0/24.0));
+	p = _mm_add_pd(_mm_mul_pd(p,r),_mm_set1_pd(1.0/6.0));
+	p = _mm_add_pd(_mm_mul_pd(p,r),_mm_set1_pd(0.5));
+	p = _mm_add_pd(_mm_mul_pd(p,r),one);
+	p = _mm_add_pd(_mm_mul_pd(p,r),one);
+
+	// 2^(j/256) from the table, with k added to its exponent bits
+	__m128i ji = _mm_and_si128(ni,_mm_set1_epi32(VEXP_SIZE-1));
+	__m128d t = _mm_loadh_pd(_mm_load_sd(vexp_table+_mm_cvtsi128_si32(ji)),vexp_table+_mm_cvtsi128_si32(_mm_srli_si128(ji,4)));
+	__m128i ki = _mm_srai_epi32(ni,VEXP_BITS);
+	__m128i scale = _mm_slli_epi64(_mm_unpacklo_epi32(ki,_mm_srai_epi32(ki,31)),52);
+	t = _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(t),scale));
+	return _mm_mul_pd(p,t);
+}
+
+#endif
+
+/** Computes y[i] = exp(x[i]) for n values
+	EB_FAST uses the vector exp() where it is available, the other modes use the C library
+ **/
+void enduse_vexp(double *y, const double *x, unsigned int n, ENDUSEBATCHMODE mode)
+{
+	unsigned int i = 0;
+#ifdef ENDUSE_BATCH_SSE2
+	if ( mode==EB_FAST )
+	{
+		const __m128d limit = _mm_set1_pd(VEXP_LIMIT);
+		const __m128d sign = _mm_set1_pd(-0.0);
+		for ( ; i+1<n ; i+=2 )
+		{
+			// NaN fails the comparison and goes to the C library as well
+			__m128d vx = _mm_loadu_pd(x+i);
+			if ( _mm_movemask_pd(_mm_cmple_pd(_mm_andnot_pd(sign,vx),limit))==3 )
+				_mm_storeu_pd(y+i,vexp_pd(vx));
+			else
+			{
+				y[i] = exp(x[i]);
+				y[i+1] = exp(x[i+1]);
+			}
+		}
+	}
+#endif
+	for ( ; i<n ; i++ )
+		y[i] = exp(x[i]);
+}
+
+/**@}**/
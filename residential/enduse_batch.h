@@ -0,0 +1,72 @@
+/** $Id: enduse_batch.h
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file enduse_batch.h
+	@addtogroup residential_enduse
+	@ingroup residential
+
+	Batched state updates for enduses with exponential state equations.
+
+	The enduses that solve their state analytically (waterheater, and in the same
+	way refrigerator, freezer and evcharger_det) spend most of an update in one
+	exp() per object.  An enduse class that uses a batch gives each of its objects
+	a slot at init.  In presync, an object works out its coefficients and queues
+	the exponent instead of calling exp() itself.  The first object of the class to
+	reach the bottom-up pass flushes the batch: the queued exponents are gathered
+	into one array, exp() is taken over the array, and each object's finish call
+	applies its result.  All presyncs complete before the first bottom-up sync, so
+	every object sees its own update before it is used, just as it did before.
+
+	The mode is set by a module global:
+	- NONE does not batch, each object calls exp() as it goes
+	- REFERENCE batches, using the C library exp() so results are bit-for-bit the
+	  same as NONE
+	- FAST batches, using the vector exp() below (SSE2, two values at a time)
+	  whose results are within a few units in the last place of the C library's
+
+ @{
+ **/
+
+#ifndef _ENDUSE_BATCH_H
+#define _ENDUSE_BATCH_H
+
+#include "residential.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ENDUSE_BATCH_SSE2
+#endif
+
+typedef enum {
+	EB_NONE=0,		///< objects update themselves, no batching
+	EB_REFERENCE=1,	///< batched, C library exp() (same results as EB_NONE)
+	EB_FAST=2,		///< batched, vector exp()
+} ENDUSEBATCHMODE;
+
+typedef void (*ENDUSEBATCHFINISH)(void *member, double value);	///< applies exp() of the queued exponent to a member
+
+class enduse_batch {
+private:
+	ENDUSEBATCHMODE mode;
+	ENDUSEBATCHFINISH finish;
+	unsigned int n_members, max_members;
+	void **member;				///< member objects, by slot
+	double *exponent;			///< queued exponent, by slot
+	unsigned char *pending;		///< exponent queued and not yet applied, by slot
+	double *x, *y;				///< gathered exponents and their exp() at flush
+	unsigned int *slot;			///< slot of each gathered exponent
+	volatile unsigned int n_queued;	///< nonzero when anything is pending
+	unsigned int lock;
+public:
+	enduse_batch(ENDUSEBATCHFINISH fn, ENDUSEBATCHMODE m);
+	~enduse_batch(void);
+	inline ENDUSEBATCHMODE get_mode(void) { return mode; };
+	inline unsigned int get_count(void) { return n_members; };
+	unsigned int add(void *obj);
+	void queue(unsigned int n, double value);
+	void flush(void);
+};
+
+void enduse_vexp(double *y, const double *x, unsigned int n, ENDUSEBATCHMODE mode);
+
+#endif
+
+/**@}**/
@@ -0,0 +1,125 @@
+/** $Id: enduse_batch_bench.cpp
+	Copyright (C) 2008 Battelle Memorial Institute
+	@file enduse_batch_bench.cpp
+	@addtogroup residential_enduse
+	@ingroup residential
+
+	Speed and accuracy of the batched exp() used for enduse updates (the residential
+	module's --modtest, see bench.h).
+
+	For each batch size, the exponents are taken over the batch three ways:
+	one C library exp() call per value (what each object does on its own),
+	enduse_vexp() in REFERENCE mode, and enduse_vexp() in FAST mode.  The largest
+	relative difference of the FAST results from the C library is reported for
+	exponents in the range waterheater updates produce and over the whole range
+	exp() handles.
+
+ @{
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "enduse_batch.h"
+#include "bench.h"
+
+#define BENCH_VALUES 4096		///< Largest batch
+#define BENCH_TOTAL 8388608		///< Values computed per timing, whatever the batch size
+
+typedef struct s_bench_data {
+	double *x, *y;
+	unsigned int count;		///< batch size
+	int mode;				///< ENDUSEBATCHMODE, or <0 for one exp() call per value
+} BENCHDATA;
+
+//Deterministic inputs in [lo,hi) - no need to touch the simulation random streams
+static void bench_fill(double *x, unsigned int count, double lo, double hi, unsigned int *seed)
+{
+	unsigned int index;
+
+	for (index=0; index<count; index++)
+	{
+		*seed = *seed * 1103515245 + 12345;
+		x[index] = lo + (hi - lo) * (double)((*seed >> 8) & 0xFFFFFF) / 16777216.0;
+	}
+}
+
+static double bench_maxerror(double lo, double hi)
+{
+	static double x[BENCH_VALUES], y[BENCH_VALUES];
+	unsigned int seed = 1, index, pass;
+	double err, maxerr = 0.0;
+
+	for (pass=0; pass<64; pass++)
+	{
+		bench_fill(x,BENCH_VALUES,lo,hi,&seed);
+		enduse_vexp(y,x,BENCH_VALUES,EB_FAST);
+		for (index=0; index<BENCH_VALUES; index++)
+		{
+			double ref = exp(x[index]);
+			err = fabs(y[index] - ref) / ref;
+			if (err > maxerr)
+				maxerr = err;
+		}
+	}
+	return maxerr;
+}
+
+/* Takes exp() over the batch, once per pass */
+static void bench_batch(void *data, unsigned int passes)
+{
+	BENCHDATA *bd = (BENCHDATA *)data;
+	unsigned int pass, index;
+
+	for (pass=0; pass<passes; pass++)
+	{
+		if (bd->mode < 0)
+		{
+			for (index=0; index<bd->count; index++)
+				bd->y[index] = exp(bd->x[index]);
+		}
+		else
+			enduse_vexp(bd->y,bd->x,bd->count,(ENDUSEBATCHMODE)bd->mode);
+		bench_keep(bd->y[pass%bd->count]);
+	}
+}
+
+/* Returns the best time in ns per value, mode<0 is one exp() call per value */
+static double bench_time(double *x, double *y, unsigned int count, int mode)
+{
+	BENCHDATA bd = {x,y,count,mode};
+	unsigned int passes = BENCH_TOTAL/count;
+
+	return bench_best(bench_batch,&bd,passes) * 1e9 / ((double)passes * count);
+}
+
+EXPORT void test(int argc, char *argv[])
+{
+	static unsigned int counts[] = {16, 256, BENCH_VALUES};
+	static double x[BENCH_VALUES], y[BENCH_VALUES];
+	unsigned int seed = 7, n;
+
+#ifndef ENDUSE_BATCH_SSE2
+	gl_testmsg("enduse batch exp: built without SSE2, FAST uses the C library");
+#endif
+	gl_testmsg("enduse batch exp, largest relative difference of FAST from the C library");
+	gl_testmsg("  waterheater range [-50,1):    %.3g", bench_maxerror(-50.0,1.0));
+	gl_testmsg("  full range [-708,708):        %.3g", bench_maxerror(-708.0,708.0));
+
+	// exponents like the ones waterheater updates queue, -c1*dt for a 1-node tank and cb*dt for a 2-zone tank
+	bench_fill(x,BENCH_VALUES,-50.0,1.0,&seed);
+
+	gl_testmsg("enduse batch exp, ns per value (best of %d)", BENCH_REPEATS);
+	gl_testmsg("  %6s   %10s   %10s   %10s   %7s", "batch", "per object", "REFERENCE", "FAST", "speedup");
+	for (n=0; n<sizeof(counts)/sizeof(counts[0]); n++)
+	{
+		double single = bench_time(x,y,counts[n],-1);
+		double reference = bench_time(x,y,counts[n],EB_REFERENCE);
+		double fast = bench_time(x,y,counts[n],EB_FAST);
+
+		gl_testmsg("  %6u   %10.2f   %10.2f   %10.2f   %6.2fx", counts[n], single, reference, fast, (fast > 0.0 ? single/fast : 0.0));
+	}
+}
+
+/**@}**/
@@ -237,14 +237,14 @@ house_e::house_e(MODULE *mod) : residential_enduse(mod)
 			PT_bool,"use_latent_heat",PADDR(use_latent_heat),PT_DESCRIPTION,"Boolean for using the heat latency of the air to the humidity when cooling.",
 			PT_bool,"include_fan_heatgain",PADDR(include_fan_heatgain),PT_DESCRIPTION,"Boolean to choose whether to include the heat generated by the fan in the ETP model.",
 
-			PT_double,"thermostat_deadband[degF]",PADDR(thermostat_deadband),PT_DESCRIPTION,"deadband of thermostat control",
+			PT_double,"thermostat_deadband[degF]",PADDR(thermostat_deadband),PT_FLAGS,PF_ACTIVATE,PT_DESCRIPTION,"deadband of thermostat control",
 			PT_double,"dlc_offset[degF]",PADDR(dlc_offset),PT_DESCRIPTION,"used as a cap to offset the thermostat deadband for direct load control applications",
 			PT_int16,"thermostat_cycle_time",PADDR(thermostat_cycle_time),PT_DESCRIPTION,"minimum time in seconds between thermostat updates",
 			PT_int16,"thermostat_off_cycle_time",PADDR(thermostat_off_cycle_time),PT_DESCRIPTION,"the minimum amount of time the thermostat cycle must stay in the off state",
 			PT_int16,"thermostat_on_cycle_time",PADDR(thermostat_on_cycle_time),PT_DESCRIPTION,"the minimum amount of time the thermostat cycle must stay in the on state",
 			PT_timestamp,"thermostat_last_cycle_time",PADDR(thermostat_last_cycle_time),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"last time the thermostat changed state",
-			PT_double,"heating_setpoint[degF]",PADDR(heating_setpoint),PT_DESCRIPTION,"thermostat heating setpoint",
-			PT_double,"cooling_setpoint[degF]",PADDR(cooling_setpoint),PT_DESCRIPTION,"thermostat cooling setpoint",
+			PT_double,"heating_setpoint[degF]",PADDR(heating_setpoint),PT_FLAGS,PF_ACTIVATE,PT_DESCRIPTION,"thermostat heating setpoint",
+			PT_double,"cooling_setpoint[degF]",PADDR(cooling_setpoint),PT_FLAGS,PF_ACTIVATE,PT_DESCRIPTION,"thermostat cooling setpoint",
 			PT_double,"design_heating_setpoint[degF]",PADDR(design_heating_setpoint),PT_DESCRIPTION,"system design heating setpoint",
 			PT_double,"design_cooling_setpoint[degF]",PADDR(design_cooling_setpoint),PT_DESCRIPTION,"system design cooling setpoint",
 			PT_double,"over_sizing_factor",PADDR(over_sizing_factor),PT_DESCRIPTION,"over sizes the heating and cooling system from standard specifications (0.2 ='s 120% sizing)",
@@ -1206,6 +1206,7 @@ int house_e::init(OBJECT *parent)
 	hdr->flags |= OF_SKIPSAFE;
 
 	heat_start = false;
+	panel_valid = false;
 
 	// local object name,	meter object name
 	struct {
@@ -1682,6 +1683,10 @@ CIRCUIT *house_e::attach(OBJECT *obj, ///< object to attach
 	// close breaker
 	c->status = BRK_CLOSED;
 
+	// not evaluated yet
+	c->evaluated = false;
+	c->included = false;
+
 	// set breaker lifetime (at average of 3.5 ops/year, 100 seems reasonable)
 	// @todo get data on residential breaker lifetimes (residential, low priority)
 	c->tripsleft = 100;
@@ -2819,21 +2824,97 @@ TIMESTAMP house_e::sync_thermostat(TIMESTAMP t0, TIMESTAMP t1)
 	return TS_NEVER;
 }
 
+/** Checks whether a circuit's last evaluation still holds
+	It does until the enduse's horizon (the next time the enduse said it would change, or
+	its loadshape's next transition) passes, the enduse's load changes, or the circuit
+	voltage moves by more than residential::panel_voltage_tolerance (pu).
+ **/
+bool house_e::circuit_is_current(CIRCUIT *c, TIMESTAMP t1)
+{
+	extern double panel_voltage_tolerance;
+	enduse *e = c->pLoad;
+
+	if (!c->evaluated || t1>=c->valid_to)
+		return false;
+
+	// any change to the load, whoever made it
+	if (e->admittance.Re()!=c->load[0].Re() || e->admittance.Im()!=c->load[0].Im()
+		|| e->current.Re()!=c->load[1].Re() || e->current.Im()!=c->load[1].Im()
+		|| e->power.Re()!=c->load[2].Re() || e->power.Im()!=c->load[2].Im()
+		|| e->total.Re()!=c->load[3].Re() || e->total.Im()!=c->load[3].Im()
+		|| e->voltage_factor!=c->voltage_factor)
+		return false;
+
+	// the same voltage, or close enough to a nonzero one
+	if (c->pV->Re()==c->V.Re() && c->pV->Im()==c->V.Im())
+		return true;
+	if (c->Vmag==0 || panel_voltage_tolerance<=0 || panel_voltage_tolerance>=1)
+		return false;
+	double dVr = c->pV->Re()-c->V.Re(), dVi = c->pV->Im()-c->V.Im();
+	double dVmax = c->Vmag * panel_voltage_tolerance;
+	return dVr*dVr + dVi*dVi <= dVmax*dVmax;
+}
+
+/** Computes a circuit's current and the load it posts to the meter
+ **/
+void house_e::evaluate_circuit(CIRCUIT *c)
+{
+	OBJECT *obj = OBJECTHDR(this);
+	OBJECT *source = c->pLoad->end_obj;
+	loadshape *shape = c->pLoad->shape;
+
+	c->V = *(c->pV);
+	c->Vmag = c->V.Mag();
+	c->load[0] = c->pLoad->admittance;
+	c->load[1] = c->pLoad->current;
+	c->load[2] = c->pLoad->power;
+	c->load[3] = c->pLoad->total;
+	c->voltage_factor = c->pLoad->voltage_factor;
+
+	//Current flow is based on the actual load, not nominal load
+	if (c->Vmag != 0)
+	{
+		complex actual_power = c->pLoad->power + (c->pLoad->current + c->pLoad->admittance * c->pLoad->voltage_factor)* c->pLoad->voltage_factor;
+		complex current = ~(actual_power*1000 / *(c->pV)); 
+		c->amps = current.Mag();
+	}
+	else
+		c->amps = 0;
+
+	//Convert values appropriately - assume nominal voltages of 240 and 120 (0 degrees)
+	//All values are given in kW, so convert to normal
+	double V = (c->type==X12) ? 240.0 : 120.0;
+	c->posted[0] = c->pLoad->power * 1000.0;
+	c->posted[1] = ~(c->pLoad->current * 1000.0 / V);
+	c->posted[2] = ~(c->pLoad->admittance * 1000.0 / (V * V));
+
+	// the enduse object publishes its horizon through its sync time, implicit enduses through their loadshape
+	if (source!=NULL && source!=obj)
+		c->valid_to = (source->valid_to<0) ? -source->valid_to : source->valid_to; // soft events are negative
+	else if (shape!=NULL && shape->type!=MT_UNKNOWN)
+		c->valid_to = shape->t2;
+	else
+		c->valid_to = TS_NEVER;
+	c->evaluated = true;
+}
+
 TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 {
 	TIMESTAMP t2 = TS_NEVER;
 	OBJECT *obj = OBJECTHDR(this);
+	bool changed = !panel_valid;
 
 	// clear accumulator
 	if((t0 >= simulation_beginning_time && t1 > t0) || (!heat_start)){
 		total.heatgain = 0;
 	}
-	total.total = total.power = total.current = total.admittance = complex(0,0);
 
 	// gather load power and compute current for each circuit
 	CIRCUIT *c;
 	for (c=panel.circuits; c!=NULL; c=c->next)
 	{
+		bool included = false;
+
 		// get circuit type
 		int n = (int)c->type;
 		if (n<0 || n>2)
@@ -2851,8 +2932,15 @@ TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 		// if breaker is closed
 		if (c->status==BRK_CLOSED)
 		{
+			// only circuits whose load or voltage changed are evaluated again
+			if (!circuit_is_current(c,t1))
+			{
+				evaluate_circuit(c);
+				changed = true;
+			}
+
 			// compute circuit current
-			if (((c->pV)->Mag() == 0) || (*pMeterStatus==0))	//Meter offline or voltage 0
+			if ((c->Vmag == 0) || (*pMeterStatus==0))	//Meter offline or voltage 0
 			{
 				gl_debug("house_e:%d circuit %d (enduse %s) voltage is zero", obj->id, c->id, c->pLoad->name);
 
@@ -2862,15 +2950,16 @@ TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 						total.heatgain += c->pLoad->heatgain;
 					}
 				}
+				if (c->included)
+				{
+					c->included = false;
+					changed = true;
+				}
 				continue;
 			}
-			
-			//Current flow is based on the actual load, not nominal load
-			complex actual_power = c->pLoad->power + (c->pLoad->current + c->pLoad->admittance * c->pLoad->voltage_factor)* c->pLoad->voltage_factor;
-			complex current = ~(actual_power*1000 / *(c->pV)); 
 
 			// check breaker
-			if (current.Mag()>c->max_amps)
+			if (c->amps>c->max_amps)
 			{
 				// probability of breaker failure increases over time
 				if (c->tripsleft>0 && gl_random_bernoulli(RNGSTATE,1/(c->tripsleft--))==0)
@@ -2881,7 +2970,7 @@ TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 					// average five minutes before reclosing, exponentially distributed
 					c->reclose = t1 + (TIMESTAMP)(gl_random_exponential(RNGSTATE,1/300.0)*TS_SECOND); 
 					gl_debug("house_e:%d circuit breaker %d tripped - enduse %s overload at %.0f A", obj->id, c->id,
-						c->pLoad->name, current.Mag());
+						c->pLoad->name, c->amps);
 				}
 
 				// breaker fails from too frequent operation
@@ -2899,36 +2988,7 @@ TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 			// add to panel current
 			else
 			{
-				//Convert values appropriately - assume nominal voltages of 240 and 120 (0 degrees)
-				//All values are given in kW, so convert to normal
-
-				if (n==0)	//1-2 240 V load
-				{
-					load_values[0][2] += c->pLoad->power * 1000.0;
-					load_values[1][2] += ~(c->pLoad->current * 1000.0 / 240.0);
-					load_values[2][2] += ~(c->pLoad->admittance * 1000.0 / (240.0 * 240.0));
-				}
-				else if (n==1)	//2-N 120 V load
-				{
-					load_values[0][1] += c->pLoad->power * 1000.0;
-					load_values[1][1] += ~(c->pLoad->current * 1000.0 / 120.0);
-					load_values[2][1] += ~(c->pLoad->admittance * 1000.0 / (120.0 * 120.0));
-				}
-				else	//n has to equal 2 here (checked above) - 1-N 120 V load
-				{
-					load_values[0][0] += c->pLoad->power * 1000.0;
-					load_values[1][0] += ~(c->pLoad->current * 1000.0 / 120.0);
-					load_values[2][0] += ~(c->pLoad->admittance * 1000.0 / (120.0 * 120.0));
-				}
-
-				//load_values[0][1] += c->pLoad->power * 1000.0;
-				//load_values[1][1] += ~(c->pLoad->current * 1000.0 / V);
-				//load_values[2][1] += ~(c->pLoad->admittance * 1000.0 / (V*V));
-
-				total.total += c->pLoad->total;
-				total.power += c->pLoad->power;
-				total.current += c->pLoad->current;
-				total.admittance += c->pLoad->admittance;
+				included = true;
 				if((t0 != 0 && t1 > t0) || (!heat_start)){
 					total.heatgain += c->pLoad->heatgain;
 				}
@@ -2936,10 +2996,54 @@ TIMESTAMP house_e::sync_panel(TIMESTAMP t0, TIMESTAMP t1)
 			}
 		}
 
+		if (included != c->included)
+		{
+			c->included = included;
+			changed = true;
+		}
+
 		// sync time
 		if (t2 > c->reclose)
 			t2 = c->reclose;
 	}
+
+	// sum the circuits only when one of them changed
+	if (changed)
+	{
+		int n, m;
+		for (n=0; n<3; n++)
+			for (m=0; m<3; m++)
+				panel_posted[n][m] = complex(0,0);
+		panel_total[0] = panel_total[1] = panel_total[2] = panel_total[3] = complex(0,0);
+
+		for (c=panel.circuits; c!=NULL; c=c->next)
+		{
+			if (!c->included)
+				continue;
+
+			//1-2 240 V load, 2-N 120 V load, 1-N 120 V load
+			n = (c->type==X12) ? 2 : ((c->type==X23) ? 1 : 0);
+			panel_posted[0][n] += c->posted[0];
+			panel_posted[1][n] += c->posted[1];
+			panel_posted[2][n] += c->posted[2];
+
+			panel_total[0] += c->load[3];
+			panel_total[1] += c->load[2];
+			panel_total[2] += c->load[1];
+			panel_total[3] += c->load[0];
+		}
+		panel_valid = true;
+	}
+
+	// load_values is cleared in presync
+	load_values[0][0] += panel_posted[0][0]; load_values[0][1] += panel_posted[0][1]; load_values[0][2] += panel_posted[0][2];
+	load_values[1][0] += panel_posted[1][0]; load_values[1][1] += panel_posted[1][1]; load_values[1][2] += panel_posted[1][2];
+	load_values[2][0] += panel_posted[2][0]; load_values[2][1] += panel_posted[2][1]; load_values[2][2] += panel_posted[2][2];
+	total.total = panel_total[0];
+	total.power = panel_total[1];
+	total.current = panel_total[2];
+	total.admittance = panel_total[3];
+
 	/* using an enduse structure for the total is more a matter of having all the values add up for the house,
 	 * and it should not sync the struct! ~MH */
 	//TIMESTAMP t = gl_enduse_sync(&total,t1); if (t<t2) t2 = t;
@@ -425,6 +425,11 @@ private:
 	bool heat_start;
 
 	complex load_values[3][3];	//Power, Current, and impedance (admittance) load accumulators for
+	complex panel_posted[3][3];	//Sum of the circuits' posted load, reused by sync_panel while no circuit changes
+	complex panel_total[4];		//Sum of the circuits' enduse total, power, current and admittance
+	bool panel_valid;			//panel_posted and panel_total are set
+	bool circuit_is_current(CIRCUIT *c, TIMESTAMP t1);
+	void evaluate_circuit(CIRCUIT *c);
 
 public:
 	int error_flag;
@@ -43,6 +43,8 @@ double default_outdoor_temperature = 74.0;
 double default_humidity = 75.0;
 double default_solar[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 int64 default_etp_iterations = 100;
+ENDUSEBATCHMODE waterheater_batch = EB_NONE;
+double panel_voltage_tolerance = 0.001;
 
 EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 {
@@ -59,6 +61,13 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("residential::default_solar",PT_double,&default_solar,PT_SIZE,9,PT_UNITS,"Btu/sf",PT_DESCRIPTION,"solar gains when no climate data is found",NULL);
 	gl_global_create("residential::default_etp_iterations",PT_int64,&default_etp_iterations,PT_DESCRIPTION,"number of iterations ETP solver will run",NULL);
 	gl_global_create("residential::ANSI_voltage_check",PT_bool,&ANSI_voltage_check,PT_DESCRIPTION,"enable or disable messages about ANSI voltage limit violations in the house",NULL);
+	gl_global_create("residential::waterheater_batch",PT_enumeration,&waterheater_batch,
+		PT_KEYWORD,"NONE",EB_NONE,
+		PT_KEYWORD,"REFERENCE",EB_REFERENCE,
+		PT_KEYWORD,"FAST",EB_FAST,
+		PT_DESCRIPTION,"Batching of waterheater temperature updates - none, batched with the same results, or batched with a vector exp()",
+		NULL);
+	gl_global_create("residential::panel_voltage_tolerance",PT_double,&panel_voltage_tolerance,PT_UNITS,"pu",PT_DESCRIPTION,"change in circuit voltage below which a house panel reuses the circuit current it last computed (0 to recompute on any change)",NULL);
 
 	new residential_enduse(module);
 	new appliance(module);
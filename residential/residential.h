@@ -52,6 +52,17 @@ typedef struct s_circuit {
 	unsigned short tripsleft; ///< the number of trips left before breaker faults
 	struct s_circuit *next; ///< next circuit in list
 	// DPC: commented this out until the rest of house_e is updated
+
+	// last evaluation of the circuit, reused by house_e::sync_panel() until the load or voltage changes
+	bool evaluated; ///< the values below are set
+	TIMESTAMP valid_to; ///< horizon of the enduse load when it was evaluated
+	complex load[4]; ///< enduse admittance, current, power and total (kW) when it was evaluated
+	double voltage_factor; ///< enduse voltage factor when it was evaluated
+	complex V; ///< circuit voltage when it was evaluated
+	double Vmag; ///< magnitude of V
+	double amps; ///< circuit current (A)
+	complex posted[3]; ///< power (VA), current (A) and shunt (S) posted to the meter
+	bool included; ///< the circuit's load was added to the panel on the last pass
 } CIRCUIT; ///< circuit definition
 
 typedef struct s_panel {
@@ -82,6 +82,7 @@ void RUN_WH_FC (
 //////////////////////////////////////////////////////////////////////////
 CLASS* waterheater::oclass = NULL;
 CLASS* waterheater::pclass = NULL;
+enduse_batch *waterheater::batch = NULL;
 
 /**  Register the class and publish water heater object properties
  **/
@@ -177,6 +178,8 @@ int waterheater::create()
 	tank_setpoint = 0.0;
 	thermostat_deadband = 0.0;
 	is_waterheater_on = 0;
+	batch_slot = (unsigned int)-1;
+	update_pending = false;
 //	power_kw = complex(0,0);
 	Tw = 0.0;
 
@@ -606,6 +609,14 @@ int waterheater::init(OBJECT *parent)
 			GL_THROW("Invalide tank volume for the fortran water heater_model. Valid volumes are 40 or 80 gallons.");
 		}
 	}
+
+	// join the waterheaters whose updates are batched
+	if ( waterheater_batch!=EB_NONE && current_model!=FORTRAN && batch_slot==(unsigned int)-1 )
+	{
+		if ( batch==NULL )
+			batch = new enduse_batch(finish_update,waterheater_batch);
+		batch_slot = batch->add(this);
+	}
 	return residential_enduse::init(parent);
 }
 
@@ -659,7 +670,6 @@ void waterheater::thermostat(TIMESTAMP t0, TIMESTAMP t1){
 TIMESTAMP waterheater::presync(TIMESTAMP t0, TIMESTAMP t1){
 	/* time has passed ~ calculate internal gains, height change, temperature change */
 	double nHours = (gl_tohours(t1) - gl_tohours(t0))/TS_SECOND;
-	OBJECT *my = OBJECTHDR(this);
 
 	DATETIME t_next;
 	gl_localtime(t1,&t_next);
@@ -670,18 +680,12 @@ TIMESTAMP waterheater::presync(TIMESTAMP t0, TIMESTAMP t1){
 		}
 	}
 	if(current_model != FORTRAN){
-		// update temperature and height
+		// update temperature and height (a batched update finishes when the batch is flushed)
 		update_T_and_or_h(nHours);
 	}
 
-	if(Tw > 212.0){
-		//GL_THROW("the waterheater is boiling!");
-		gl_warning("waterheater:%i is boiling", my->id);
-		/*	TROUBLESHOOT
-			The temperature model for the waterheater has broken, or the environment around the
-			waterheater has burst into flames.  Please post this with your model and dump files
-			attached to the bug report.
-		 */
+	if(!update_pending){
+		check_boiling();
 	}
 	
 	/* determine loadshape effects */
@@ -760,6 +764,10 @@ TIMESTAMP waterheater::sync(TIMESTAMP t0, TIMESTAMP t1)
 	double nHours = (gl_tohours(t1) - gl_tohours(t0))/TS_SECOND;
 	double Tamb = get_Tambient(location);
 	int i = 0;
+
+	// finish the batched temperature and height updates
+	flush_updates();
+
 	// use re_override to control heat_needed state
 	// runs after thermostat() but before "the usual" calculations
 	if(current_model != FORTRAN){
@@ -935,6 +943,7 @@ TIMESTAMP waterheater::postsync(TIMESTAMP t0, TIMESTAMP t1){
 }
 
 TIMESTAMP waterheater::commit(){
+	flush_updates();
 	Tw_old = Tw;
 	Tupper_old = /*Tupper*/ Tw;
 	Tlower_old = Tlower;
@@ -1212,7 +1221,12 @@ void waterheater::update_T_and_or_h(double nHours)
 		If not, we should find ourselves in the same state again.  But
 		this routine doesn't try to figure that out...it just calculates
 		the new T/h.
+
+		When the waterheaters are batched, the exponential part of the
+		update is queued and the rest is done by apply_update() when the
+		batch is flushed.
 	*/
+	double x;
 
 	// set the model and load state
 	switch (current_model) 
@@ -1221,9 +1235,19 @@ void waterheater::update_T_and_or_h(double nHours)
 			// Handy that the 1-node model doesn't care which way
 			// things are moving (RECOVERING vs DEPLETING)...
 SingleZone:
-			Tw = new_temp_1node(Tw, nHours);
-			/*Tupper*/ Tw = Tw;
-			Tlower = Tinlet;
+			if (batch_slot != (unsigned int)-1)
+			{
+				update_terms[1] = Tw;
+				if (temp_1node_terms(Tw, nHours, &update_terms[0], &x))
+				{
+					update_pending = true;
+					batch->queue(batch_slot, x);
+					return;
+				}
+				Tw = update_terms[0];
+			}
+			else
+				Tw = new_temp_1node(Tw, nHours);
 			break;
 
 		case TWONODE:
@@ -1239,7 +1263,18 @@ SingleZone:
 					// Fall through...
 				case RECOVERING:
 					try {
-						h = new_h_2zone(h, nHours);
+						if (batch_slot != (unsigned int)-1)
+						{
+							update_terms[2] = h;
+							if (h_2zone_terms(h, nHours, &h, &update_terms[0], &update_terms[1], &x))
+							{
+								update_pending = true;
+								batch->queue(batch_slot, x);
+								return;
+							}
+						}
+						else
+							h = new_h_2zone(h, nHours);
 					} catch (WRONGMODEL m)
 					{
 						if (m==MODEL_NOT_2ZONE)
@@ -1252,7 +1287,28 @@ SingleZone:
 					}
 					break;
 			}
+			break;
+
+		default:
+			break;
+	}
+
+	correct_T_and_or_h();
+	return;
+}
+
+/** Finishes a temperature/height update once the new Tw or h is known
+ **/
+void waterheater::correct_T_and_or_h(void)
+{
+	switch (current_model) 
+	{
+		case ONENODE:
+			/*Tupper*/ Tw = Tw;
+			Tlower = Tinlet;
+			break;
 
+		case TWONODE:
 			// Correct h if it overshot...
 			if (h < ROUNDOFF) 
 			{
@@ -1297,6 +1353,37 @@ SingleZone:
 	return;
 }
 
+/** Applies a batched update, value is exp() of the queued exponent
+ **/
+void waterheater::apply_update(double value)
+{
+	update_pending = false;
+	if (current_model == ONENODE)
+		Tw = update_terms[0] - (update_terms[0] - update_terms[1]) * value;	// new_temp_1node()
+	else
+		h = ((value * (update_terms[0] + update_terms[1] * update_terms[2])) - update_terms[0]) / update_terms[1];	// new_h_2zone()
+	correct_T_and_or_h();
+	check_boiling();
+}
+
+void waterheater::finish_update(void *member, double value)
+{
+	((waterheater*)member)->apply_update(value);
+}
+
+void waterheater::check_boiling(void)
+{
+	if(Tw > 212.0){
+		//GL_THROW("the waterheater is boiling!");
+		gl_warning("waterheater:%i is boiling", OBJECTHDR(this)->id);
+		/*	TROUBLESHOOT
+			The temperature model for the waterheater has broken, or the environment around the
+			waterheater has burst into flames.  Please post this with your model and dump files
+			attached to the bug report.
+		 */
+	}
+}
+
 /* the key to picking the equations apart is that the goal is to calculate the temperature differences relative to the
  *	temperature of the lower node (or inlet temp, if 1node).
  * cA is the volume change from water draw, heating element, and thermal jacket given a uniformly cold tank
@@ -1394,13 +1481,29 @@ inline double waterheater::new_time_1node(double T0, double T1)
 }
 
 inline double waterheater::new_temp_1node(double T0, double delta_t)
+{
+	double c2, x;
+
+	if (!temp_1node_terms(T0, delta_t, &c2, &x))
+		return c2;
+
+	return  c2 - (c2 - T0) * exp(x);	// [F]
+}
+
+/** Calculates the new temperature as c2 - (c2 - T0) * exp(x)
+	@return false if the temperature does not change, with the new temperature in c2
+ **/
+bool waterheater::temp_1node_terms(double T0, double delta_t, double *c2_out, double *x)
 {
 	// old because this happens in presync and needs previously used demand
 	const double mdot_Cp = Cp * water_demand_old * 60 * RHOWATER / GALPCF;
 	// Btu / degF.lb * gal/hr * lb/cf * cf/gal = Btu / degF.hr
 
     if (Cw <= ROUNDOFF || (tank_UA+mdot_Cp) <= ROUNDOFF)
-        return T0;
+	{
+		*c2_out = T0;
+        return false;
+	}
 
 	const double c1 = (tank_UA + mdot_Cp) / Cw;
 	double c2;
@@ -1413,7 +1516,9 @@ inline double waterheater::new_temp_1node(double T0, double delta_t)
 	}
 
 //	return  c2 - (c2 + T0) * exp(c1 * delta_t);	// [F]
-	return  c2 - (c2 - T0) * exp(-c1 * delta_t);	// [F]
+	*c2_out = c2;
+	*x = -c1 * delta_t;
+	return true;
 }
 
 
@@ -1436,9 +1541,25 @@ inline double waterheater::new_time_2zone(double h0, double h1)
 }
 
 inline double waterheater::new_h_2zone(double h0, double delta_t)
+{
+	double h1, cA, cb, x;
+
+	if (!h_2zone_terms(h0, delta_t, &h1, &cA, &cb, &x))
+		return h1;
+
+	return ((exp(x) * (cA + cb * h0)) - cA) / cb;	// [ft]
+}
+
+/** Calculates the new height as ((exp(x) * (cA + cb * h0)) - cA) / cb
+	@return false if the height is found without it, with the new height in h1
+ **/
+bool waterheater::h_2zone_terms(double h0, double delta_t, double *h1, double *cA_out, double *cb_out, double *x)
 {
 	if (delta_t <= ROUNDOFF)
-		return h0;
+	{
+		*h1 = h0;
+		return false;
+	}
 
 	// old because this happens in presync and needs previously used demand
 	const double mdot = water_demand_old * 60 * RHOWATER / GALPCF;		// lbm/hr...
@@ -1446,7 +1567,10 @@ inline double waterheater::new_h_2zone(double h0, double delta_t)
 
 	// check c1 before division
 	if (fabs(c1) <= ROUNDOFF)
-        return height;      // if /*Tupper*/ Tw and Tlower are real close, then the new height is the same as tank height
+	{
+		*h1 = height;
+        return false;      // if /*Tupper*/ Tw and Tlower are real close, then the new height is the same as tank height
+	}
 //		throw MODEL_NOT_2ZONE;
 		
 //	#define CWATER		(0.9994)		// BTU/lb/F
@@ -1462,9 +1586,15 @@ inline double waterheater::new_h_2zone(double h0, double delta_t)
 	const double cb = (tank_UA / height) * (/*Tupper*/ Tw - Tlower) / c1;
 
     if (fabs(cb) <= ROUNDOFF)
-        return height;
+	{
+		*h1 = height;
+        return false;
+	}
 
-	return ((exp(cb * delta_t) * (cA + cb * h0)) - cA) / cb;	// [ft]
+	*cA_out = cA;
+	*cb_out = cb;
+	*x = cb * delta_t;
+	return true;
 }
 
 double waterheater::get_Tambient(enumeration loc)
@@ -1575,6 +1705,7 @@ EXPORT TIMESTAMP plc_waterheater(OBJECT *obj, TIMESTAMP t0)
 		obj->clock = t0;  //set the clock if it has not been set yet
 
 	waterheater *my = OBJECTDATA(obj,waterheater);
+	waterheater::flush_updates();
 	my->thermostat(obj->clock, t0);
 	
 	// no changes to timestamp will be made by the internal water heater thermostat
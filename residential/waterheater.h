@@ -12,6 +12,9 @@
 
 #include "residential.h"
 #include "residential_enduse.h"
+#include "enduse_batch.h"
+
+extern ENDUSEBATCHMODE waterheater_batch;
 
 class waterheater : public residential_enduse {
 private:
@@ -152,6 +155,19 @@ public:
 
 	TIMESTAMP fwh_sim_time;
 
+private:
+	// Batched temperature/height updates (see enduse_batch.h)
+	static enduse_batch *batch;
+	unsigned int batch_slot;			///< slot in the batch, -1 if not a member
+	bool update_pending;				///< temperature/height update queued in the batch
+	double update_terms[3];				///< terms of the queued update besides exp()
+	static void finish_update(void *member, double value);
+	void apply_update(double value);
+	void correct_T_and_or_h(void);
+	void check_boiling(void);
+public:
+	static inline void flush_updates(void) { if ( batch!=NULL ) batch->flush(); };
+
 public:
 	static CLASS *oclass, *pclass;
 	static waterheater *defaults;
@@ -181,8 +197,10 @@ public:
 	double actual_kW(void);								// Actual heat from heating element...
 	double new_time_1node(double T0, double T1);		// Calcs time to transition...
 	double new_temp_1node(double T0, double delta_t);	// Calcs temp after transition...
+	bool temp_1node_terms(double T0, double delta_t, double *c2, double *x);	// Calcs the terms of new_temp_1node...
 	double new_time_2zone(double h0, double h1);		// Calcs time to transition...
 	double new_h_2zone(double h0, double delta_t);      // Calcs h after transition...
+	bool h_2zone_terms(double h0, double delta_t, double *h1, double *cA, double *cb, double *x);	// Calcs the terms of new_h_2zone...
 
 	double get_Tambient(enumeration water_heater_location);		// ambient T [F] -- either an indoor house temperature or a garage temperature, probably...
 	typedef enum {MODEL_NOT_1ZONE=0, MODEL_NOT_2ZONE=1} WRONGMODEL;
@@ -167,6 +167,9 @@ int group_recorder::init(OBJECT *obj){
 		}
 	}
 
+	// read all the values at once when the objects allow it
+	link_view();
+
 	// check if we should expunge the units from our copied PROP structs
 	if(!print_units){
 		quickobjlist *itr = obj_list;
@@ -376,11 +379,51 @@ int group_recorder::write_header(){
 	return 1;
 }
 
+/**
+	Makes a property view of the recorded property when every object in the group is of
+	the same class, so that read_line() copies the values of all the objects at once.
+	@return 1 if the view is made, 0 if the values are read one object at a time
+ **/
+int group_recorder::link_view(){
+	quickobjlist *curr = 0;
+	PROPERTY *vp = 0;
+	CLASS *vclass = obj_list->obj->oclass;
+	int n = 0;
+
+	vp = gl_find_property(vclass, property_name.get_string());
+	if(vp == 0 || !gld_propview::can_view(vp)){
+		return 0;
+	}
+	for(curr = obj_list; curr != 0; curr = curr->next){
+		if(curr->obj->oclass != vclass || curr->prop.addr != vp->addr){
+			return 0;
+		}
+	}
+	view = new gld_propview(vclass, property_name.get_string());
+	member = new OBJECT*[obj_count];
+	column = malloc(view->get_width(0) * obj_count);
+	if(0 == column){
+		gl_warning("group_recorder::link_view(): malloc failure, values will be read one object at a time");
+		/* TROUBLESHOOT
+			Memory allocation failure.
+		*/
+		delete view;
+		delete [] member;
+		view = 0;
+		member = 0;
+		return 0;
+	}
+	for(curr = obj_list; curr != 0; curr = curr->next){
+		member[n++] = curr->obj;
+	}
+	return 1;
+}
+
 /**
 	@return 0 on failure, 1 on success
  **/
 int group_recorder::read_line(){
-	size_t index = 0, offset = 0, unit_len = 0;
+	size_t index = 0, offset = 0, unit_len = 0, n = 0;
 	quickobjlist *curr = 0;
 	char *swap_ptr = 0;
 	char buffer[128];
@@ -425,13 +468,21 @@ int group_recorder::read_line(){
 		line_buffer = swap_ptr;
 	}
 	memset(line_buffer, 0, line_size);
-	for(curr = obj_list; curr != 0; curr = curr->next){
-		// GETADDR is a macro defined in object.h
+	if(view != 0 && view->gather(member, obj_count, &column, 1) != (size_t)obj_count){
+		gl_error("group_recorder::read_line(): unable to read property '%s' from every object in the group", property_name.get_string());
+		/* TROUBLESHOOT
+			An object in the group could not be read through the property view.
+		 */
+		return 0;
+	}
+	for(curr = obj_list, n = 0; curr != 0; curr = curr->next, n++){
+		// GETADDR is a macro defined in object.h; values read through the view are in its column
+		void *addr = (view != 0) ? (void*)((char*)column + n * view->get_width(0)) : GETADDR(curr->obj, &(curr->prop));
 		if(curr->prop.ptype == PT_complex && complex_part != NONE){
 			double part_value = 0.0;
 			complex *cptr = 0;
 			// get value as a complex
-			cptr = gl_get_complex(curr->obj, &(curr->prop));
+			cptr = (view != 0) ? (complex*)addr : gl_get_complex(curr->obj, &(curr->prop));
 			if(0 == cptr){
 				gl_error("group_recorder::read_line(): unable to get complex property '%s' from object '%s'", curr->prop.name, gl_name(curr->obj, objname, 127));
 				/* TROUBLESHOOT
@@ -464,7 +515,7 @@ int group_recorder::read_line(){
 			sprintf(buffer, "%f", part_value);
 			offset = strlen(buffer);
 		} else {
-			offset = gl_get_value(curr->obj, GETADDR(curr->obj, &(curr->prop)), buffer, 127, &(curr->prop));
+			offset = gl_get_value(curr->obj, addr, buffer, 127, &(curr->prop));
 			if(0 == offset){
 				gl_error("group_recorder::read_line(): unable to get value for '%s' in object '%s'", curr->prop.name, curr->obj->name);
 				/* TROUBLESHOOT
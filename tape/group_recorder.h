@@ -49,10 +49,14 @@ private:
 	int write_line(TIMESTAMP);
 	int flush_line();
 	int write_footer();
+	int link_view();
 private:
 	FILE *rec_file;
 	FINDLIST *items;
 	quickobjlist *obj_list;
+	gld_propview *view; // view of the property in every object of the group, 0 if it cannot be viewed
+	OBJECT **member; // objects of the group in obj_list order, for the view
+	void *column; // values read through the view, one per object
 	PROPERTY *prop_ptr;
 	int obj_count;
 	int write_count;
@@ -96,6 +96,8 @@ EXPORT int create_recorder(OBJECT **obj, OBJECT *parent)
 		my->format = 0;
 		strcpy(my->plotcommands,"");
 		my->target = gl_get_property(*obj,my->property,NULL);
+		my->view = NULL;
+		my->column = NULL;
 		my->header_units = HU_DEFAULT;
 		my->line_units = LU_DEFAULT;
 		my->flush = -1; /* -1 (default): flush when buffer full, 0 flush each line, >0 flush seconds */
@@ -556,6 +558,52 @@ PROPERTY *link_properties(struct recorder *rec, OBJECT *obj, char *property_list
 	return first;
 }
 
+/* make a view of the target properties of the parent, so that each sample copies them 
+   all at once while the parent is locked; targets that are parts of a complex property 
+   are read from the view of the whole property */
+static void link_view(struct recorder *rec, OBJECT *obj)
+{
+	PROPERTY *p, *vp;
+	char1024 list = "";
+	unsigned int n = 0;
+
+	for (p=rec->target; p!=NULL; p=p->next)
+	{
+		vp = gl_find_property(obj->oclass,p->name);
+		if (vp==NULL || !callback->propview.can_view(vp) || strlen(list)+strlen(p->name)+2>=sizeof(list))
+			return; /* read the values from the parent instead */
+		if (n++>0) strcat(list,",");
+		strcat(list,p->name);
+	}
+	if (n==0 || (rec->view=callback->propview.create(obj->oclass,list))==NULL)
+		return;
+
+	/* each target must lie within the value of the property viewed */
+	for (n=0, p=rec->target; p!=NULL; n++, p=p->next)
+	{
+		vp = rec->view->prop[n];
+		if ((size_t)p->addr<(size_t)vp->addr || (size_t)p->addr>=(size_t)vp->addr+rec->view->width[n])
+			break;
+	}
+	rec->column = (p==NULL ? (void**)calloc(n,sizeof(void*)) : NULL);
+	if (rec->column!=NULL)
+	{
+		for (n=0; n<rec->view->n_props; n++)
+		{
+			if ((rec->column[n]=malloc(rec->view->width[n]))==NULL)
+				break;
+		}
+		if (n==rec->view->n_props)
+			return;
+		while (n-->0)
+			free(rec->column[n]);
+		free(rec->column);
+		rec->column = NULL;
+	}
+	callback->propview.destroy(rec->view);
+	rec->view = NULL;
+}
+
 int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char *buffer, int size)
 {
 	PROPERTY *p;
@@ -564,22 +612,31 @@ int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char *buff
 	int offset=0;
 	int count=0;
 	double value;
+	void *addr;
+	unsigned int n;
 	memset(&fake, 0, sizeof(PROPERTY));
 	fake.ptype = PT_double;
 	fake.unit = 0;
-	for (p=prop; p!=NULL && offset<size-33; p=p->next)
+	if (my->view!=NULL && callback->propview.gather(my->view,&obj,1,my->column,1)!=1)
+		return 0;
+	for (n=0, p=prop; p!=NULL && offset<size-33; n++, p=p->next)
 	{
+		/* values read through the view are in its columns */
+		if (my->view!=NULL)
+			addr = (char*)my->column[n] + ((size_t)p->addr - (size_t)my->view->prop[n]->addr);
+		else
+			addr = GETADDR(obj,p);
 		if (offset>0) strcpy(buffer+offset++,",");
 		if(p->ptype == PT_double){
 			switch(my->line_units){
 				case LU_ALL:
 					// cascade into 'default', as prop->unit should've been set, if there's a unit available.
 				case LU_DEFAULT:
-					offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */
+					offset+=gl_get_value(obj,addr,buffer+offset,size-offset-1,p); /* pointer => int64 */
 					break;
 				case LU_NONE:
 					// copy value into local value, use fake PROP, feed into gl_get_vaule
-					value = *gl_get_double(obj, p);
+					value = *(double*)addr;
 					p2 = gl_get_property(obj, p->name,NULL);
 					if(p2 == 0){
 						gl_error("unable to locate %s.%s for LU_NONE", obj, p->name);
@@ -592,14 +649,14 @@ int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char *buff
 							offset+=gl_get_value(obj,&value,buffer+offset,size-offset-1,&fake); /* pointer => int64 */;
 						}
 					} else {
-						offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */;
+						offset+=gl_get_value(obj,addr,buffer+offset,size-offset-1,p); /* pointer => int64 */;
 					}
 					break;
 				default:
 					break;
 			}
 		} else {
-			offset+=gl_get_value(obj,GETADDR(obj,p),buffer+offset,size-offset-1,p); /* pointer => int64 */
+			offset+=gl_get_value(obj,addr,buffer+offset,size-offset-1,p); /* pointer => int64 */
 		}
 		buffer[offset]='\0';
 		count++;
@@ -637,6 +694,8 @@ EXPORT TIMESTAMP sync_recorder(OBJECT *obj, TIMESTAMP t0, PASSCONFIG pass)
 	/* connect to property */
 	if (my->target==NULL){
 		my->target = link_properties(my, obj->parent, my->property);
+		if (my->target!=NULL)
+			link_view(my, obj->parent);
 	}
 	if (my->target==NULL)
 	{
@@ -179,6 +179,8 @@ struct recorder {
 	} last;
 	int32 samples;
 	PROPERTY *target;
+	struct s_propview *view; /* view of the target properties of the parent, NULL if they cannot be viewed */
+	void **column; /* the last values read through the view, one per target */
 };
 /** @}
 	@addtogroup collector
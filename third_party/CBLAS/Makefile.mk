@@ -11,6 +11,7 @@ third_party_CBLAS_libblas_la_LIBADD = -lm
 third_party_CBLAS_libblas_la_SOURCES =
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dasum.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/daxpy.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dcabs1.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dcopy.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/ddot.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dgemv.c
@@ -21,7 +22,19 @@ third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dscal.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dsymv.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dsyr2.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dtrsv.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dzasum.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/dznrm2.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/f2c.h
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/idamax.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/izamax.c
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/slu_Cnames.h
 third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/superlu_f2c.h
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zaxpy.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zcopy.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zdotc.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zgemv.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zgerc.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zhemv.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zher2.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/zscal.c
+third_party_CBLAS_libblas_la_SOURCES += third_party/CBLAS/ztrsv.c
@@ -19,6 +19,7 @@ third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/await.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/colamd.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/colamd.h
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dclock.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dcomplex.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dgscon.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dgsequ.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dgsrfs.c
@@ -33,8 +34,10 @@ third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dpivotgro
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dreadhb.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dsp_blas2.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dsp_blas3.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/dzsum1.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/get_perm_c.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/heap_relax_snode.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/izmax1.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/lsame.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/mmd.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pdgssv.c
@@ -69,6 +72,28 @@ third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pxgstrf_s
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pxgstrf_super_bnd_dfs.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pxgstrf_synch.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pxgstrf_synch.h
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgssv.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgssvx.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_bmod1D.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_bmod1D_mv2.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_bmod2D.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_bmod2D_mv2.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_column_bmod.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_column_dfs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_copy_to_ucol.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_factor_snode.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_init.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_panel_bmod.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_panel_dfs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_pivotL.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_snode_bmod.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_snode_dfs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_thread.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_thread_finalize.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzgstrf_thread_init.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzmemory.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/pzutil.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/qrnzcnt.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/slu_mt_Cnames.h
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/slu_mt_machines.h
@@ -80,4 +105,17 @@ third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/superlu_t
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/supermatrix.h
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/util.c
 third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/xerbla.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zgscon.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zgsequ.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zgsrfs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zgstrs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zlacon.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zlangs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zlaqgs.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zmatgen.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zmyblas2.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zpivotgrowth.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zreadhb.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zsp_blas2.c
+third_party_superLU_MT_libsuperlu_la_SOURCES += third_party/superLU_MT/zsp_blas3.c
 
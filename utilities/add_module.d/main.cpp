@@ -70,6 +70,7 @@ CDECL int dllinit()
 
 CDECL int dllkill() {
 	do_kill(NULL);
+	return 0;
 }
 
 #endif // !WIN32